@@ -11,6 +11,7 @@
  */
 
 #include <frdmmcxa153.h>
+#include "register_io_i2c.h"
 
 // I2C0 Pin Handles
 gpioHandleKSDK_t D18 = {.base = GPIO1, .pinNumber = 8, .mask = 1 << (8), .clockName = kCLOCK_GateGPIO1, .portNumber = 1};
@@ -30,6 +31,8 @@ gpioHandleKSDK_t D10 = {.base = GPIO2, .pinNumber = 6, .mask = 1 << (6), .clockN
 
 //GPIO Pin Handles
 gpioHandleKSDK_t INTA_PIN = {.base = GPIO3, .pinNumber = 15, .mask = 1 << (15), .irq = GPIO3_IRQn , .clockName = kCLOCK_GateGPIO3, .portNumber = 3};
+/* PCF2131 CLKOUT, wire the shield CLKOUT to Arduino D2 for clock calibration */
+gpioHandleKSDK_t CLKOUT_PIN = {.base = GPIO2, .pinNumber = 4, .mask = 1 << (4), .clockName = kCLOCK_GateGPIO2, .portNumber = 2};
 
 // LPCXpresso55s69 Internal Peripheral Pin Definitions
 gpioHandleKSDK_t RED_LED = {
@@ -95,6 +98,49 @@ uint32_t LPI2C0_GetFreq(void)
     return CLOCK_GetLpi2cClkFreq();
 }
 
+/*! @brief       Recovers the shield I2C bus.
+ *  @details     The bus recovery required by register_io_i2c.c, as the LPI2C CMSIS driver does not support
+ *               ARM_I2C_BUS_CLEAR. Clocks SCL until the slave releases SDA (at most 9 pulses), issues a STOP
+ *               and hands the pins back to LPI2C0.
+ *  @param[in]   deviceInstance The I2C device number.
+ *  @Constraints None
+ *  @Reentrant   No
+ *  @return      void
+ */
+void BOARD_I2C_BusClear(uint8_t deviceInstance)
+{
+    GENERIC_DRIVER_GPIO *pGpioDriver = &Driver_GPIO_KSDK;
+    uint32_t pulse;
+
+    if (deviceInstance != I2C_S1_DEVICE_INDEX)
+    {
+        return;
+    }
+
+    LPI2C0_DeinitPins();
+    pGpioDriver->pin_init(&D18, GPIO_DIRECTION_IN, NULL, NULL, NULL);
+    pGpioDriver->pin_init(&D19, GPIO_DIRECTION_OUT, NULL, NULL, NULL);
+    for (pulse = 0; (pulse < 9) && !pGpioDriver->read_pin(&D18); pulse++)
+    {
+        pGpioDriver->clr_pin(&D19);
+        SDK_DelayAtLeastUs(5, SystemCoreClock);
+        pGpioDriver->set_pin(&D19);
+        SDK_DelayAtLeastUs(5, SystemCoreClock);
+    }
+
+    /* STOP: SDA rises while SCL is high. */
+    pGpioDriver->clr_pin(&D19);
+    pGpioDriver->pin_init(&D18, GPIO_DIRECTION_OUT, NULL, NULL, NULL);
+    pGpioDriver->clr_pin(&D18);
+    SDK_DelayAtLeastUs(5, SystemCoreClock);
+    pGpioDriver->set_pin(&D19);
+    SDK_DelayAtLeastUs(5, SystemCoreClock);
+    pGpioDriver->set_pin(&D18);
+    SDK_DelayAtLeastUs(5, SystemCoreClock);
+
+    LPI2C0_InitPins();
+}
+
 /*! @brief       Determines the Clock Frequency feature.
  *  @details     The Clock Frequecny computation API required by fsl_spi_cmsis.c.
  *  @param[in]   void
@@ -30,6 +30,23 @@ extern gpioHandleKSDK_t D10;
 
 //GPIO Handle
 extern gpioHandleKSDK_t INTA_PIN;
+extern gpioHandleKSDK_t CLKOUT_PIN;
+
+// CTIMER match output clocking CLKOUT in external clock test mode (ctimer_utils.h). The CLKOUT pin has no
+// CTIMER function, wire P3_12 (CT1_MAT2, also the red LED) to CLKOUT for the test.
+#define BOARD_EXT_CLK_CTIMER       CTIMER1
+#define BOARD_EXT_CLK_CTIMER_MATCH 2U
+#define BOARD_EXT_CLK_CTIMER_FREQ  CLOCK_GetCTimerClkFreq(1U)
+#define BOARD_EXT_CLK_CTIMER_INIT()                            \
+    do                                                         \
+    {                                                          \
+        CLOCK_SetClockDiv(kCLOCK_DivCTIMER1, 1U);              \
+        CLOCK_AttachClk(kFRO_HF_to_CTIMER1);                   \
+        CLOCK_EnableClock(kCLOCK_GateCTIMER1);                 \
+        RESET_ReleasePeripheralReset(kCTIMER1_RST_SHIFT_RSTn); \
+        PORT_SetPinMux(PORT3, 12U, kPORT_MuxAlt4);             \
+    } while (0)
+#define BOARD_EXT_CLK_CTIMER_DEINIT() PORT_SetPinMux(PORT3, 12U, kPORT_PinDisabledOrAnalog)
 
 
 // UART0 Handle
@@ -82,6 +99,8 @@ extern gpioHandleKSDK_t BLUE_LED;
 status_t SMC_SetPowerModeWait(void *arg);
 /* @brief Kinetis style Wrapper API for Power Mode VLPR (Wait for Interrupt). */
 status_t SMC_SetPowerModeVlpr(void *arg);
+/* @brief Shield I2C bus recovery (clocks out SCL), used on transfer timeout by register_io_i2c.c. */
+void BOARD_I2C_BusClear(uint8_t deviceInstance);
 /* @brief Kinetis style Wrapper API for handling all Clock related configurations. */
 void BOARD_BootClockRUN(void);
 #endif /* FRDM_MCXA153_H_ */
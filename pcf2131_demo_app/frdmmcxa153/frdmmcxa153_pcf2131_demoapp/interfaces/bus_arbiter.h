@@ -0,0 +1,163 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file bus_arbiter.h
+ * @brief The bus_arbiter.h file declares the arbiter sharing one SPI/I2C bus between several device handles.
+ */
+
+#ifndef __BUS_ARBITER_H__
+#define __BUS_ARBITER_H__
+
+#include "sensor_drv.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/* Default time Bus_Arbiter_Acquire() waits for another device to give the bus back, one 128 byte block at 100 kHz. */
+#define BUS_ARBITER_TIMEOUT_US (20000)
+
+/*******************************************************************************
+ * Types
+ ******************************************************************************/
+/*! @brief The bus types handled by the arbiter. */
+typedef enum
+{
+    BUS_ARBITER_SPI = 0, /* ARM_DRIVER_SPI, speed is the baud rate. */
+    BUS_ARBITER_I2C = 1, /* ARM_DRIVER_I2C, speed is an ARM_I2C_BUS_SPEED_x value. */
+} busArbiterType_t;
+
+typedef struct _busArbiter busArbiter_t;
+
+/*!
+ * @brief This structure defines a device sharing an arbitrated bus.
+ *        Point registerDeviceInfo_t pArbDevice at it to arbitrate the register I/O of the device.
+ */
+typedef struct _busArbiterDevice
+{
+    busArbiter_t *pArbiter; /* The bus the device sits on. */
+    uint32_t busSpeed;      /* The bus speed of the device, 0 keeps the current speed. */
+} busArbiterDevice_t;
+
+/*! @brief The queued job type, it runs with the bus held by the device of the request. */
+typedef void (*busArbiterJob_t)(void *pUserData);
+
+/*!
+ * @brief This structure defines a queued bus request, owned by the arbiter until its job starts.
+ */
+typedef struct _busArbiterRequest
+{
+    busArbiterDevice_t *pDevice;     /* The device the job talks to. */
+    busArbiterJob_t job;             /* The transaction to run. */
+    void *pUserData;                 /* The job parameter. */
+    uint8_t priority;                /* Higher runs first, FIFO among equal priorities. */
+    uint64_t submitTicks;            /* Systick count at submission. */
+    struct _busArbiterRequest *pNext;
+} busArbiterRequest_t;
+
+/*!
+ * @brief This structure defines the arbiter state of one bus.
+ */
+struct _busArbiter
+{
+    void *pBus;                   /* The CMSIS SPI or I2C driver. */
+    busArbiterType_t type;        /* The bus type. */
+    uint32_t busSpeed;            /* The speed currently programmed, 0 if unknown. */
+    busArbiterDevice_t *pOwner;   /* The device holding the bus, NULL when free. */
+    uint8_t depth;                /* Nested acquisitions of the owner. */
+    uint32_t timeout_us;          /* Longest wait for the bus in Bus_Arbiter_Acquire(), 0 does not wait. */
+    registeridlefunction_t idleFunction; /* Called while waiting, e.g. to finish a transfer started without waiting. */
+    void *pIdleData;              /* The idle function parameter. */
+    busArbiterRequest_t *pQueue;  /* Pending requests, highest priority first. */
+    uint32_t grants;              /* Queued requests started. */
+    uint32_t maxWait_us;          /* Longest queue wait. */
+    uint64_t totalWait_us;        /* Sum of all queue waits. */
+};
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+/*!
+ * @brief The interface function to initialize a bus arbiter.
+ *
+ * @param busArbiter_t *pArbiter - The arbiter.
+ * @param void *pBus - The CMSIS SPI or I2C driver, already initialized and powered.
+ * @param busArbiterType_t type - The bus type.
+ */
+void Bus_Arbiter_Init(busArbiter_t *pArbiter, void *pBus, busArbiterType_t type);
+
+/*!
+ * @brief The interface function to set how Bus_Arbiter_Acquire() waits for a bus held by another device.
+ *        On a bare metal superloop the owner is a transfer started without waiting, so pass the function
+ *        that polls it to completion; under an RTOS the owner is another task and NULL is enough.
+ *
+ * @param busArbiter_t *pArbiter - The arbiter.
+ * @param uint32_t timeout_us - Longest wait, 0 to fail at once (required when acquiring from an interrupt).
+ * @param registeridlefunction_t idleFunction - Called while waiting, NULL to spin.
+ * @param void *pIdleData - The idle function parameter.
+ */
+void Bus_Arbiter_SetWait(busArbiter_t *pArbiter, uint32_t timeout_us, registeridlefunction_t idleFunction, void *pIdleData);
+
+/*!
+ * @brief The interface function to take the bus for a transaction.
+ *        The bus speed of the device is programmed when it differs from the current one.
+ *        The owner may acquire again (nested), another device waits up to the arbiter timeout for the bus.
+ *        Running out of time is reported as ARM_DRIVER_ERROR_BUSY, an arbitration loss and not a bus error.
+ *
+ * @param busArbiterDevice_t *pDevice - The device, NULL for a device owning its bus (always succeeds).
+ *
+ * @return ARM_DRIVER_OK, ARM_DRIVER_ERROR_BUSY or the status of the bus speed change.
+ */
+int32_t Bus_Arbiter_Acquire(busArbiterDevice_t *pDevice);
+
+/*!
+ * @brief The interface function to give the bus back after a transaction.
+ *
+ * @param busArbiterDevice_t *pDevice - The device, NULL for a device owning its bus.
+ */
+void Bus_Arbiter_Release(busArbiterDevice_t *pDevice);
+
+/*!
+ * @brief The interface function to change the bus speed of a device.
+ *        The new speed is programmed right away if the bus is free or held by the device.
+ *
+ * @param busArbiterDevice_t *pDevice - The device.
+ * @param uint32_t busSpeed - The new bus speed.
+ *
+ * @return ARM_DRIVER_OK, ARM_DRIVER_ERROR_BUSY or the status of the bus speed change.
+ */
+int32_t Bus_Arbiter_SetSpeed(busArbiterDevice_t *pDevice, uint32_t busSpeed);
+
+/*!
+ * @brief The interface function to queue a bus request.
+ *        Safe to call from interrupt context, the job runs from Bus_Arbiter_Service().
+ *
+ * @param busArbiterRequest_t *pRequest - The request, it must stay valid until its job starts.
+ */
+void Bus_Arbiter_Submit(busArbiterRequest_t *pRequest);
+
+/*!
+ * @brief The interface function to run the highest priority queued job.
+ *        Call it from the main loop. Each job is one transaction, so a high priority request
+ *        queued meanwhile overtakes the remaining lower priority (bulk) requests at the next call.
+ *
+ * @param busArbiter_t *pArbiter - The arbiter.
+ *
+ * @return true if a job ran, false if the queue was empty or the bus was held.
+ */
+bool Bus_Arbiter_Service(busArbiter_t *pArbiter);
+
+/*!
+ * @brief The interface function to get the average queue wait.
+ *
+ * @param busArbiter_t *pArbiter - The arbiter.
+ *
+ * @return The average wait in micro seconds from submission to job start, 0 if no job ran.
+ */
+uint32_t Bus_Arbiter_GetAvgWait_us(busArbiter_t *pArbiter);
+
+#endif // __BUS_ARBITER_H__
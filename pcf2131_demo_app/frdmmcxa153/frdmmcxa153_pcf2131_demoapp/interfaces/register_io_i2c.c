@@ -17,13 +17,39 @@
 
 /* ISSDK Includes */
 #include "issdk_hal.h"
+#include "systick_utils.h"
 #include "register_io_i2c.h"
+#include "bus_arbiter.h"
+#include "register_io_os.h"
+#include "register_io_trace.h"
 
 /*******************************************************************************
  * Types
  ******************************************************************************/
 #define I2C_COUNT (sizeof(i2cBases) / sizeof(void *))
 
+/* The state of a transfer started without waiting. */
+typedef struct
+{
+    uint64_t startTicks;  /* Systick count at the start, the deadline covers both phases of a read. */
+    uint8_t *pOutBuffer;  /* Read destination, or the payload of a write. */
+    uint16_t slaveAddress;
+    uint8_t offset;       /* Register address sent in the address phase of a read. */
+    uint8_t length;       /* Number of bytes to read or write. */
+    bool addressPhase;    /* The register address of a read is being sent. */
+    bool write;           /* Block write, a read otherwise. */
+} registerI2cAsync_t;
+
+#if defined(CPU_MCXN947VDF_cm33_core0) || defined(CPU_MCXN547VDF_cm33_core0) || defined(CPU_MCXA153VLH_cm33_nodsp)
+/* LPI2C master FIFO commands (MTDR[CMD]). */
+#define I2C_LPI2C_CMD_STOP  LPI2C_MTDR_CMD(0x2U)
+#define I2C_LPI2C_CMD_START LPI2C_MTDR_CMD(0x4U)
+/* Status polls for the STOP of an error recovery, a STOP takes a few SCL periods. */
+#define I2C_LPI2C_STOP_POLLS (10000U)
+/* Deadline of a FIFO block write on a device without a timeout, well past the longest write at standard mode. */
+#define I2C_LPI2C_WRITE_TIMEOUT_US (100000U)
+#endif
+
 /*******************************************************************************
  * Variables
  ******************************************************************************/
@@ -34,6 +60,10 @@ I2C_Type *const i2cBases[] = I2C_BASE_PTRS;
 #endif
 volatile bool b_I2C_CompletionFlag[I2C_COUNT] = {false};
 volatile uint32_t g_I2C_ErrorEvent[I2C_COUNT] = {ARM_I2C_EVENT_TRANSFER_DONE};
+uint32_t g_I2C_Latency[I2C_COUNT][REGISTER_IO_LATENCY_BINS] = {0};
+registerIoCount_t g_I2C_Count[I2C_COUNT];
+registerOsBus_t g_I2C_Os[I2C_COUNT];
+registerI2cAsync_t g_I2C_Async[I2C_COUNT];
 
 /*******************************************************************************
  * Code
@@ -48,6 +78,7 @@ void I2C0_SignalEvent_t(uint32_t event)
         g_I2C_ErrorEvent[0] = event;
     }
     b_I2C_CompletionFlag[0] = true;
+    Register_OS_Signal(&g_I2C_Os[0]);
 }
 #endif
 
@@ -60,6 +91,7 @@ void I2C1_SignalEvent_t(uint32_t event)
         g_I2C_ErrorEvent[1] = event;
     }
     b_I2C_CompletionFlag[1] = true;
+    Register_OS_Signal(&g_I2C_Os[1]);
 }
 #endif
 
@@ -72,6 +104,7 @@ void I2C2_SignalEvent_t(uint32_t event)
         g_I2C_ErrorEvent[2] = event;
     }
     b_I2C_CompletionFlag[2] = true;
+    Register_OS_Signal(&g_I2C_Os[2]);
 }
 #endif
 
@@ -84,6 +117,7 @@ void I2C3_SignalEvent_t(uint32_t event)
         g_I2C_ErrorEvent[3] = event;
     }
     b_I2C_CompletionFlag[3] = true;
+    Register_OS_Signal(&g_I2C_Os[3]);
 }
 #endif
 
@@ -96,6 +130,7 @@ void I2C4_SignalEvent_t(uint32_t event)
         g_I2C_ErrorEvent[4] = event;
     }
     b_I2C_CompletionFlag[4] = true;
+    Register_OS_Signal(&g_I2C_Os[4]);
 }
 #endif
 
@@ -108,6 +143,7 @@ void I2C5_SignalEvent_t(uint32_t event)
         g_I2C_ErrorEvent[5] = event;
     }
     b_I2C_CompletionFlag[5] = true;
+    Register_OS_Signal(&g_I2C_Os[5]);
 }
 #endif
 
@@ -120,6 +156,7 @@ void I2C6_SignalEvent_t(uint32_t event)
         g_I2C_ErrorEvent[6] = event;
     }
     b_I2C_CompletionFlag[6] = true;
+    Register_OS_Signal(&g_I2C_Os[6]);
 }
 #endif
 
@@ -132,6 +169,7 @@ void I2C7_SignalEvent_t(uint32_t event)
         g_I2C_ErrorEvent[7] = event;
     }
     b_I2C_CompletionFlag[7] = true;
+    Register_OS_Signal(&g_I2C_Os[7]);
 }
 #endif
 
@@ -145,32 +183,55 @@ void I2C11_SignalEvent_t(uint32_t event)
         g_I2C_ErrorEvent[11] = event;
     }
     b_I2C_CompletionFlag[11] = true;
+    Register_OS_Signal(&g_I2C_Os[11]);
 }
 #endif
 #endif
 
-/*! The interface function to block write sensor registers. */
-int32_t Register_I2C_BlockWrite(ARM_DRIVER_I2C *pCommDrv,
-                                registerDeviceInfo_t *devInfo,
-                                uint16_t slaveAddress,
-                                uint8_t offset,
-                                const uint8_t *pBuffer,
-                                uint8_t bytesToWrite)
+/* Count a started transfer and its bytes. */
+static void register_i2c_count(uint8_t deviceInstance, uint32_t bytes)
 {
-    int32_t status;
-    uint8_t buffer[SENSOR_MAX_REGISTER_COUNT];
+    g_I2C_Count[deviceInstance].transfers++;
+    g_I2C_Count[deviceInstance].bytes += bytes;
+}
 
-    buffer[0] = offset;
-    memcpy(buffer + 1, pBuffer, bytesToWrite);
+/* Count a transfer wait in its power of two latency bin. */
+static void register_i2c_latency(uint8_t deviceInstance, uint32_t latency_us)
+{
+    uint8_t bin = 0;
 
-    b_I2C_CompletionFlag[devInfo->deviceInstance] = false;
-    g_I2C_ErrorEvent[devInfo->deviceInstance] = ARM_I2C_EVENT_TRANSFER_DONE;
-    status = pCommDrv->MasterTransmit(slaveAddress, buffer, bytesToWrite + 1, false);
-    if (ARM_DRIVER_OK == status)
+    while ((latency_us >> bin) && (bin < REGISTER_IO_LATENCY_BINS - 1))
     {
-        /* Wait for completion */
+        bin++;
+    }
+    g_I2C_Latency[deviceInstance][bin]++;
+}
+
+/* Wait for the transfer completion until the device deadline expires.
+ * On expiry the transfer is aborted and the bus is recovered, a slave holding SDA low is
+ * released by clocking out SCL (ARM_I2C_BUS_CLEAR or the board fallback). */
+static int32_t register_i2c_wait(ARM_DRIVER_I2C *pCommDrv, registerDeviceInfo_t *devInfo)
+{
+    int32_t status;
+    uint32_t coreFreq = BOARD_SystickGetCoreFreq();
+    uint64_t deadline = USEC_TO_COUNT(devInfo->timeout_us, coreFreq);
+    uint64_t start = BOARD_SystickGetTicks();
+    uint64_t elapsed;
+
+    /* A task blocks on the completion semaphore, bare-metal code spins with the idle function. */
+    status = Register_OS_Wait(&g_I2C_Os[devInfo->deviceInstance], &b_I2C_CompletionFlag[devInfo->deviceInstance],
+                              devInfo->timeout_us);
+    if (ARM_DRIVER_ERROR_UNSUPPORTED == status)
+    {
+        status = ARM_DRIVER_OK;
         while (!b_I2C_CompletionFlag[devInfo->deviceInstance])
         {
+            elapsed = BOARD_SystickGetTicks() - start;
+            if (devInfo->timeout_us && (elapsed > deadline))
+            {
+                status = ARM_DRIVER_ERROR_TIMEOUT;
+                break;
+            }
             if (devInfo->idleFunction)
             {
                 devInfo->idleFunction(devInfo->functionParam);
@@ -180,6 +241,20 @@ int32_t Register_I2C_BlockWrite(ARM_DRIVER_I2C *pCommDrv,
                 __NOP();
             }
         }
+    }
+    if (ARM_DRIVER_ERROR_TIMEOUT == status)
+    {
+        pCommDrv->Control(ARM_I2C_ABORT_TRANSFER, 0);
+        if (ARM_DRIVER_OK != pCommDrv->Control(ARM_I2C_BUS_CLEAR, 0))
+        {
+            BOARD_I2C_BusClear(devInfo->deviceInstance);
+        }
+    }
+    elapsed = BOARD_SystickGetTicks() - start;
+    register_i2c_latency(devInfo->deviceInstance, (uint32_t)COUNT_TO_USEC(elapsed, coreFreq));
+
+    if (ARM_DRIVER_OK == status)
+    {
         if (g_I2C_ErrorEvent[devInfo->deviceInstance] == ARM_I2C_EVENT_TRANSFER_INCOMPLETE)
         {
             pCommDrv->Control(ARM_I2C_ABORT_TRANSFER, 0);
@@ -193,80 +268,360 @@ int32_t Register_I2C_BlockWrite(ARM_DRIVER_I2C *pCommDrv,
     return status;
 }
 
-/*! The interface function to write a sensor register. */
-int32_t Register_I2C_Write(ARM_DRIVER_I2C *pCommDrv,
-                           registerDeviceInfo_t *devInfo,
-                           uint16_t slaveAddress,
-                           uint8_t offset,
-                           uint8_t value,
-                           uint8_t mask,
-                           bool repeatedStart)
+/*! The interface function to get the bus traffic counters. */
+void Register_I2C_GetCount(uint8_t deviceInstance, registerIoCount_t *pCount)
 {
-    int32_t status;
-    uint8_t config[] = {offset, 0x00};
+    *pCount = g_I2C_Count[deviceInstance];
+}
 
-    /*! Set the register based on the values in the register value pair configuration.*/
-    if (mask)
+/*! The interface function to clear the bus traffic counters. */
+void Register_I2C_ClearCount(uint8_t deviceInstance)
+{
+    memset(&g_I2C_Count[deviceInstance], 0, sizeof(g_I2C_Count[deviceInstance]));
+}
+
+/*! The interface function to get a transfer latency percentile. */
+uint32_t Register_I2C_GetLatency_us(uint8_t deviceInstance, uint8_t percentile)
+{
+    uint32_t total = 0, count = 0;
+    uint8_t bin;
+
+    for (bin = 0; bin < REGISTER_IO_LATENCY_BINS; bin++)
     {
-        b_I2C_CompletionFlag[devInfo->deviceInstance] = false;
-        g_I2C_ErrorEvent[devInfo->deviceInstance] = ARM_I2C_EVENT_TRANSFER_DONE;
-        /*! Send the register address to read from.*/
-        status = pCommDrv->MasterTransmit(slaveAddress, &config[0], 1, true);
-        if (ARM_DRIVER_OK == status)
+        total += g_I2C_Latency[deviceInstance][bin];
+    }
+    if ((0 == total) || (percentile > 100))
+    {
+        return 0;
+    }
+    for (bin = 0; bin < REGISTER_IO_LATENCY_BINS - 1; bin++)
+    {
+        count += g_I2C_Latency[deviceInstance][bin];
+        if ((uint64_t)count * 100 >= (uint64_t)total * percentile)
         {
-            /* Wait for completion without calling idle function */
-            while (!b_I2C_CompletionFlag[devInfo->deviceInstance])
-            {
-                if (devInfo->idleFunction)
-                {
-                    devInfo->idleFunction(devInfo->functionParam);
-                }
-                else
-                {
-                    __NOP();
-                }
-            };
-            if (g_I2C_ErrorEvent[devInfo->deviceInstance] == ARM_I2C_EVENT_TRANSFER_INCOMPLETE)
+            break;
+        }
+    }
+
+    return 1u << bin;
+}
+
+/*! The interface function to clear the transfer latency histogram. */
+void Register_I2C_ClearLatency(uint8_t deviceInstance)
+{
+    memset(g_I2C_Latency[deviceInstance], 0, sizeof(g_I2C_Latency[deviceInstance]));
+}
+
+#if defined(CPU_MCXN947VDF_cm33_core0) || defined(CPU_MCXN547VDF_cm33_core0) || defined(CPU_MCXA153VLH_cm33_nodsp)
+/* Wait for room in the LPI2C transmit FIFO, checking bus errors and the write deadline. */
+static int32_t register_i2c_fifo_ready(LPI2C_Type *base, uint64_t start, uint64_t deadline)
+{
+    size_t txCount;
+
+    do
+    {
+        if (kStatus_Success != LPI2C_MasterCheckAndClearError(base, LPI2C_MasterGetStatusFlags(base)))
+        {
+            return ARM_DRIVER_ERROR;
+        }
+        if ((BOARD_SystickGetTicks() - start) > deadline)
+        {
+            return ARM_DRIVER_ERROR_TIMEOUT;
+        }
+        LPI2C_MasterGetFifoCounts(base, NULL, &txCount);
+    } while (txCount >= (size_t)FSL_FEATURE_LPI2C_FIFO_SIZEn(base));
+
+    return ARM_DRIVER_OK;
+}
+
+/* Bring the master back to idle after a failed FIFO write: drop the queued words, clear the status
+ * flags, end the transfer with a STOP while the master still owns the bus, then release a slave
+ * holding SDA low. This is what the CMSIS driver does on its own error paths. */
+static void register_i2c_fifo_recover(LPI2C_Type *base, registerDeviceInfo_t *devInfo)
+{
+    uint32_t polls;
+
+    base->MCR |= LPI2C_MCR_RRF_MASK | LPI2C_MCR_RTF_MASK;
+    LPI2C_MasterClearStatusFlags(base, (uint32_t)kLPI2C_MasterClearFlags);
+    if (LPI2C_MasterGetStatusFlags(base) & (uint32_t)kLPI2C_MasterBusyFlag)
+    {
+        base->MTDR = I2C_LPI2C_CMD_STOP;
+        for (polls = 0; polls < I2C_LPI2C_STOP_POLLS; polls++)
+        {
+            if (LPI2C_MasterGetStatusFlags(base) & ((uint32_t)kLPI2C_MasterStopDetectFlag | (uint32_t)kLPI2C_MasterErrorFlags))
             {
-                pCommDrv->Control(ARM_I2C_ABORT_TRANSFER, 0);
+                break;
             }
-            if (g_I2C_ErrorEvent[devInfo->deviceInstance] != ARM_I2C_EVENT_TRANSFER_DONE)
+        }
+        base->MCR |= LPI2C_MCR_RRF_MASK | LPI2C_MCR_RTF_MASK;
+        LPI2C_MasterClearStatusFlags(base, (uint32_t)kLPI2C_MasterClearFlags);
+    }
+    BOARD_I2C_BusClear(devInfo->deviceInstance);
+}
+
+/* Check that the FIFO write may take the LPI2C master from behind the CMSIS driver: the master is enabled,
+ * the driver has no transfer running, neither this master nor another one is on the bus, and no error of an
+ * earlier transfer is pending. Such an error belongs to the owner of that transfer and is left for it to
+ * clear, the CMSIS driver does so when it starts its next transfer. */
+static int32_t register_i2c_fifo_owned(ARM_DRIVER_I2C *pCommDrv, LPI2C_Type *base)
+{
+    uint32_t flags;
+
+    if (0U == (base->MCR & LPI2C_MCR_MEN_MASK))
+    {
+        return ARM_DRIVER_ERROR;
+    }
+    if (pCommDrv->GetStatus().busy)
+    {
+        return ARM_DRIVER_ERROR_BUSY;
+    }
+    flags = LPI2C_MasterGetStatusFlags(base);
+    if (flags & ((uint32_t)kLPI2C_MasterBusyFlag | (uint32_t)kLPI2C_MasterBusBusyFlag |
+                 (uint32_t)kLPI2C_MasterErrorFlags))
+    {
+        return ARM_DRIVER_ERROR_BUSY;
+    }
+
+    return ARM_DRIVER_OK;
+}
+
+/* Send the offset byte and the caller payload as two chained segments through the LPI2C transmit FIFO.
+ * The FIFO is fed from caller memory, so there is neither a bounce buffer nor a copy.
+ * Every wait is bounded, by the device deadline or without one by I2C_LPI2C_WRITE_TIMEOUT_US, so a STOP
+ * that never shows up on a stuck bus ends in the recovery instead of a hang. */
+static int32_t register_i2c_fifo_send(LPI2C_Type *base,
+                                      registerDeviceInfo_t *devInfo,
+                                      uint16_t slaveAddress,
+                                      uint8_t offset,
+                                      const uint8_t *pBuffer,
+                                      uint8_t bytesToWrite)
+{
+    int32_t status;
+    uint32_t flags;
+    uint8_t segment, i;
+    const uint8_t *pSegment[] = {&offset, pBuffer};
+    const uint8_t segmentSize[] = {1, bytesToWrite};
+    uint32_t coreFreq = BOARD_SystickGetCoreFreq();
+    uint64_t deadline = USEC_TO_COUNT(devInfo->timeout_us ? devInfo->timeout_us : I2C_LPI2C_WRITE_TIMEOUT_US, coreFreq);
+    uint64_t start = BOARD_SystickGetTicks();
+
+    LPI2C_MasterClearStatusFlags(base, (uint32_t)kLPI2C_MasterClearFlags);
+    register_i2c_count(devInfo->deviceInstance, 1U + bytesToWrite);
+
+    /*! START and slave address. */
+    status = register_i2c_fifo_ready(base, start, deadline);
+    if (ARM_DRIVER_OK == status)
+    {
+        base->MTDR = I2C_LPI2C_CMD_START | ((uint32_t)slaveAddress << 1U);
+    }
+
+    /*! Register offset segment followed by the payload segment. */
+    for (segment = 0; (segment < 2) && (ARM_DRIVER_OK == status); segment++)
+    {
+        for (i = 0; (i < segmentSize[segment]) && (ARM_DRIVER_OK == status); i++)
+        {
+            status = register_i2c_fifo_ready(base, start, deadline);
+            if (ARM_DRIVER_OK == status)
             {
-                return ARM_DRIVER_ERROR;
+                base->MTDR = pSegment[segment][i];
             }
         }
-        else
+    }
+
+    /*! STOP, then wait for it on the bus. */
+    if (ARM_DRIVER_OK == status)
+    {
+        status = register_i2c_fifo_ready(base, start, deadline);
+    }
+    if (ARM_DRIVER_OK == status)
+    {
+        base->MTDR = I2C_LPI2C_CMD_STOP;
+    }
+    while (ARM_DRIVER_OK == status)
+    {
+        flags = LPI2C_MasterGetStatusFlags(base);
+        if (kStatus_Success != LPI2C_MasterCheckAndClearError(base, flags))
         {
-            return status;
+            status = ARM_DRIVER_ERROR;
         }
+        else if (flags & (uint32_t)kLPI2C_MasterStopDetectFlag)
+        {
+            LPI2C_MasterClearStatusFlags(base, (uint32_t)kLPI2C_MasterStopDetectFlag);
+            break;
+        }
+        else if ((BOARD_SystickGetTicks() - start) > deadline)
+        {
+            status = ARM_DRIVER_ERROR_TIMEOUT;
+        }
+    }
+
+    if (ARM_DRIVER_OK != status)
+    {
+        /* NACK, arbitration loss, FIFO error or timeout alike. */
+        register_i2c_fifo_recover(base, devInfo);
+    }
+    register_i2c_latency(devInfo->deviceInstance, (uint32_t)COUNT_TO_USEC(BOARD_SystickGetTicks() - start, coreFreq));
+
+    return status;
+}
+
+/* Block write through the LPI2C transmit FIFO, past the CMSIS driver. The register I/O lock is held across
+ * the ownership check and the write, so no other register I/O call starts a CMSIS transfer in between. */
+static int32_t register_i2c_fifo_write(ARM_DRIVER_I2C *pCommDrv,
+                                       registerDeviceInfo_t *devInfo,
+                                       uint16_t slaveAddress,
+                                       uint8_t offset,
+                                       const uint8_t *pBuffer,
+                                       uint8_t bytesToWrite)
+{
+    int32_t status;
+    LPI2C_Type *base = i2cBases[devInfo->deviceInstance];
+
+    status = Register_OS_Lock(&g_I2C_Os[devInfo->deviceInstance]);
+    if (ARM_DRIVER_OK != status)
+    {
+        return status;
+    }
+    status = register_i2c_fifo_owned(pCommDrv, base);
+    if (ARM_DRIVER_OK == status)
+    {
+        status = register_i2c_fifo_send(base, devInfo, slaveAddress, offset, pBuffer, bytesToWrite);
+    }
+    Register_OS_Unlock(&g_I2C_Os[devInfo->deviceInstance]);
+
+    return status;
+}
+#endif
+
+/* Block writes sensor registers, the caller holds the bus. */
+static int32_t register_i2c_block_write(ARM_DRIVER_I2C *pCommDrv,
+                                        registerDeviceInfo_t *devInfo,
+                                        uint16_t slaveAddress,
+                                        uint8_t offset,
+                                        const uint8_t *pBuffer,
+                                        uint8_t bytesToWrite)
+{
+#if defined(CPU_MCXN947VDF_cm33_core0) || defined(CPU_MCXN547VDF_cm33_core0) || defined(CPU_MCXA153VLH_cm33_nodsp)
+    /* Scatter-gather: the offset and the payload are chained in the transmit FIFO. */
+    return register_i2c_fifo_write(pCommDrv, devInfo, slaveAddress, offset, pBuffer, bytesToWrite);
+#else
+    int32_t status;
+    uint8_t buffer[SENSOR_MAX_REGISTER_COUNT];
+
+    /* The offset takes one byte of the transmit buffer. */
+    if (bytesToWrite >= SENSOR_MAX_REGISTER_COUNT)
+    {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+
+    buffer[0] = offset;
+    memcpy(buffer + 1, pBuffer, bytesToWrite);
+
+    b_I2C_CompletionFlag[devInfo->deviceInstance] = false;
+    g_I2C_ErrorEvent[devInfo->deviceInstance] = ARM_I2C_EVENT_TRANSFER_DONE;
+    register_i2c_count(devInfo->deviceInstance, bytesToWrite + 1U);
+    status = pCommDrv->MasterTransmit(slaveAddress, buffer, bytesToWrite + 1, false);
+    if (ARM_DRIVER_OK == status)
+    {
+        /* Wait for completion */
+        status = register_i2c_wait(pCommDrv, devInfo);
+    }
+
+    return status;
+#endif
+}
+
+/*! The interface function to block write sensor registers. */
+int32_t Register_I2C_BlockWrite(ARM_DRIVER_I2C *pCommDrv,
+                                registerDeviceInfo_t *devInfo,
+                                uint16_t slaveAddress,
+                                uint8_t offset,
+                                const uint8_t *pBuffer,
+                                uint8_t bytesToWrite)
+{
+    int32_t status;
+    uint64_t start;
+
+    /*! Hold the shared bus for the whole transfer. */
+    status = Register_OS_Lock(&g_I2C_Os[devInfo->deviceInstance]);
+    if (ARM_DRIVER_OK != status)
+    {
+        return status;
+    }
+    status = Bus_Arbiter_Acquire(devInfo->pArbDevice);
+    if (ARM_DRIVER_OK == status)
+    {
+        start = BOARD_SystickGetTicks();
+        status = register_i2c_block_write(pCommDrv, devInfo, slaveAddress, offset, pBuffer, bytesToWrite);
+        Register_Trace_Record(REGISTER_TRACE_I2C | REGISTER_TRACE_WRITE | REGISTER_TRACE_INSTANCE(devInfo->deviceInstance),
+                              offset, bytesToWrite, pBuffer, start, status);
+        Bus_Arbiter_Release(devInfo->pArbDevice);
+    }
+    Register_OS_Unlock(&g_I2C_Os[devInfo->deviceInstance]);
+
+    return status;
+}
+
+/* Reads sensor registers, the caller holds the bus. */
+static int32_t register_i2c_read(ARM_DRIVER_I2C *pCommDrv,
+                                 registerDeviceInfo_t *devInfo,
+                                 uint16_t slaveAddress,
+                                 uint8_t offset,
+                                 uint8_t length,
+                                 uint8_t *pOutBuffer)
+{
+    int32_t status;
+    uint64_t start = BOARD_SystickGetTicks();
+
+    b_I2C_CompletionFlag[devInfo->deviceInstance] = false;
+    g_I2C_ErrorEvent[devInfo->deviceInstance] = ARM_I2C_EVENT_TRANSFER_DONE;
+    /*! Send the register address to read from.*/
+    register_i2c_count(devInfo->deviceInstance, 1U);
+    status = pCommDrv->MasterTransmit(slaveAddress, &offset, 1, true);
+    if (ARM_DRIVER_OK == status)
+    {
+        /* Wait for completion */
+        status = register_i2c_wait(pCommDrv, devInfo);
+    }
+
+    if (ARM_DRIVER_OK == status)
+    {
         b_I2C_CompletionFlag[devInfo->deviceInstance] = false;
         g_I2C_ErrorEvent[devInfo->deviceInstance] = ARM_I2C_EVENT_TRANSFER_DONE;
-        /*! Read the value.*/
-        status = pCommDrv->MasterReceive(slaveAddress, &config[1], 1, false);
+        /*! Read and update the value.*/
+        register_i2c_count(devInfo->deviceInstance, length);
+        status = pCommDrv->MasterReceive(slaveAddress, pOutBuffer, length, false);
         if (ARM_DRIVER_OK == status)
         {
             /* Wait for completion */
-            while (!b_I2C_CompletionFlag[devInfo->deviceInstance])
-            {
-                if (devInfo->idleFunction)
-                {
-                    devInfo->idleFunction(devInfo->functionParam);
-                }
-                else
-                {
-                    __NOP();
-                }
-            }
-            if (g_I2C_ErrorEvent[devInfo->deviceInstance] == ARM_I2C_EVENT_TRANSFER_INCOMPLETE)
-            {
-                pCommDrv->Control(ARM_I2C_ABORT_TRANSFER, 0);
-            }
-            if (g_I2C_ErrorEvent[devInfo->deviceInstance] != ARM_I2C_EVENT_TRANSFER_DONE)
-            {
-                return ARM_DRIVER_ERROR;
-            }
+            status = register_i2c_wait(pCommDrv, devInfo);
         }
-        else
+    }
+    Register_Trace_Record(REGISTER_TRACE_I2C | REGISTER_TRACE_INSTANCE(devInfo->deviceInstance), offset, length,
+                          pOutBuffer, start, status);
+
+    return status;
+}
+
+/* Writes a sensor register, the caller holds the bus. */
+static int32_t register_i2c_write(ARM_DRIVER_I2C *pCommDrv,
+                                  registerDeviceInfo_t *devInfo,
+                                  uint16_t slaveAddress,
+                                  uint8_t offset,
+                                  uint8_t value,
+                                  uint8_t mask,
+                                  bool repeatedStart)
+{
+    int32_t status;
+    uint64_t start;
+    uint8_t config[] = {offset, 0x00};
+
+    /*! Set the register based on the values in the register value pair configuration.*/
+    if (mask)
+    {
+        /*! Read the value.*/
+        status = register_i2c_read(pCommDrv, devInfo, slaveAddress, offset, 1, &config[1]);
+        if (ARM_DRIVER_OK != status)
         {
             return status;
         }
@@ -282,30 +637,44 @@ int32_t Register_I2C_Write(ARM_DRIVER_I2C *pCommDrv,
     b_I2C_CompletionFlag[devInfo->deviceInstance] = false;
     g_I2C_ErrorEvent[devInfo->deviceInstance] = ARM_I2C_EVENT_TRANSFER_DONE;
     /*!  Write the updated value. */
+    start = BOARD_SystickGetTicks();
+    register_i2c_count(devInfo->deviceInstance, sizeof(config));
     status = pCommDrv->MasterTransmit(slaveAddress, config, sizeof(config), repeatedStart);
     if (ARM_DRIVER_OK == status)
     {
         /* Wait for completion */
-        while (!b_I2C_CompletionFlag[devInfo->deviceInstance])
-        {
-            if (devInfo->idleFunction)
-            {
-                devInfo->idleFunction(devInfo->functionParam);
-            }
-            else
-            {
-                __NOP();
-            }
-        }
-        if (g_I2C_ErrorEvent[devInfo->deviceInstance] == ARM_I2C_EVENT_TRANSFER_INCOMPLETE)
-        {
-            pCommDrv->Control(ARM_I2C_ABORT_TRANSFER, 0);
-        }
-        if (g_I2C_ErrorEvent[devInfo->deviceInstance] != ARM_I2C_EVENT_TRANSFER_DONE)
-        {
-            status = ARM_DRIVER_ERROR;
-        }
+        status = register_i2c_wait(pCommDrv, devInfo);
     }
+    Register_Trace_Record(REGISTER_TRACE_I2C | REGISTER_TRACE_WRITE | REGISTER_TRACE_INSTANCE(devInfo->deviceInstance),
+                          offset, 1, &config[1], start, status);
+
+    return status;
+}
+
+/*! The interface function to write a sensor register. */
+int32_t Register_I2C_Write(ARM_DRIVER_I2C *pCommDrv,
+                           registerDeviceInfo_t *devInfo,
+                           uint16_t slaveAddress,
+                           uint8_t offset,
+                           uint8_t value,
+                           uint8_t mask,
+                           bool repeatedStart)
+{
+    int32_t status;
+
+    /*! Hold the shared bus for the whole transfer. */
+    status = Register_OS_Lock(&g_I2C_Os[devInfo->deviceInstance]);
+    if (ARM_DRIVER_OK != status)
+    {
+        return status;
+    }
+    status = Bus_Arbiter_Acquire(devInfo->pArbDevice);
+    if (ARM_DRIVER_OK == status)
+    {
+        status = register_i2c_write(pCommDrv, devInfo, slaveAddress, offset, value, mask, repeatedStart);
+        Bus_Arbiter_Release(devInfo->pArbDevice);
+    }
+    Register_OS_Unlock(&g_I2C_Os[devInfo->deviceInstance]);
 
     return status;
 }
@@ -320,64 +689,174 @@ int32_t Register_I2C_Read(ARM_DRIVER_I2C *pCommDrv,
 {
     int32_t status;
 
-    b_I2C_CompletionFlag[devInfo->deviceInstance] = false;
-    g_I2C_ErrorEvent[devInfo->deviceInstance] = ARM_I2C_EVENT_TRANSFER_DONE;
-    status = pCommDrv->MasterTransmit(slaveAddress, &offset, 1, true);
+    /*! Hold the shared bus for the whole transfer. */
+    status = Register_OS_Lock(&g_I2C_Os[devInfo->deviceInstance]);
+    if (ARM_DRIVER_OK != status)
+    {
+        return status;
+    }
+    status = Bus_Arbiter_Acquire(devInfo->pArbDevice);
     if (ARM_DRIVER_OK == status)
     {
-        /* Wait for completion without calling idle function. */
-        while (!b_I2C_CompletionFlag[devInfo->deviceInstance])
-        {
-            if (devInfo->idleFunction)
-            {
-                devInfo->idleFunction(devInfo->functionParam);
-            }
-            else
-            {
-                __NOP();
-            }
-        };
-        if (g_I2C_ErrorEvent[devInfo->deviceInstance] == ARM_I2C_EVENT_TRANSFER_INCOMPLETE)
-        {
-            pCommDrv->Control(ARM_I2C_ABORT_TRANSFER, 0);
-        }
-        if (g_I2C_ErrorEvent[devInfo->deviceInstance] != ARM_I2C_EVENT_TRANSFER_DONE)
-        {
-            return ARM_DRIVER_ERROR;
-        }
+        status = register_i2c_read(pCommDrv, devInfo, slaveAddress, offset, length, pOutBuffer);
+        Bus_Arbiter_Release(devInfo->pArbDevice);
     }
-    else
+    Register_OS_Unlock(&g_I2C_Os[devInfo->deviceInstance]);
+
+    return status;
+}
+
+/* Take the bus for a transfer started without waiting. */
+static int32_t register_i2c_take(registerDeviceInfo_t *devInfo)
+{
+    int32_t status;
+
+    status = Register_OS_Lock(&g_I2C_Os[devInfo->deviceInstance]);
+    if (ARM_DRIVER_OK != status)
+    {
+        return status;
+    }
+    status = Bus_Arbiter_Acquire(devInfo->pArbDevice);
+    if (ARM_DRIVER_OK != status)
     {
+        Register_OS_Unlock(&g_I2C_Os[devInfo->deviceInstance]);
         return status;
     }
 
     b_I2C_CompletionFlag[devInfo->deviceInstance] = false;
     g_I2C_ErrorEvent[devInfo->deviceInstance] = ARM_I2C_EVENT_TRANSFER_DONE;
-    /*! Read and update the value.*/
-    status = pCommDrv->MasterReceive(slaveAddress, pOutBuffer, length, false);
-    if (ARM_DRIVER_OK == status)
+    g_I2C_Async[devInfo->deviceInstance].startTicks = BOARD_SystickGetTicks();
+
+    return ARM_DRIVER_OK;
+}
+
+/* Give the bus back after a transfer started without waiting. */
+static int32_t register_i2c_give(registerDeviceInfo_t *devInfo, int32_t status)
+{
+    registerI2cAsync_t *pAsync = &g_I2C_Async[devInfo->deviceInstance];
+    uint64_t elapsed = BOARD_SystickGetTicks() - pAsync->startTicks;
+
+    register_i2c_latency(devInfo->deviceInstance, (uint32_t)COUNT_TO_USEC(elapsed, BOARD_SystickGetCoreFreq()));
+    Register_Trace_Record(REGISTER_TRACE_I2C | REGISTER_TRACE_INSTANCE(devInfo->deviceInstance) |
+                              (pAsync->write ? REGISTER_TRACE_WRITE : 0),
+                          pAsync->offset, pAsync->length, pAsync->pOutBuffer, pAsync->startTicks, status);
+    Bus_Arbiter_Release(devInfo->pArbDevice);
+    Register_OS_Unlock(&g_I2C_Os[devInfo->deviceInstance]);
+
+    return status;
+}
+
+/*! The interface function to start reading sensor registers, without waiting. */
+int32_t Register_I2C_StartRead(ARM_DRIVER_I2C *pCommDrv,
+                               registerDeviceInfo_t *devInfo,
+                               uint16_t slaveAddress,
+                               uint8_t offset,
+                               uint8_t length,
+                               uint8_t *pOutBuffer)
+{
+    int32_t status;
+    registerI2cAsync_t *pAsync = &g_I2C_Async[devInfo->deviceInstance];
+
+    status = register_i2c_take(devInfo);
+    if (ARM_DRIVER_OK != status)
     {
-        /* Wait for completion */
-        while (!b_I2C_CompletionFlag[devInfo->deviceInstance])
+        return status;
+    }
+
+    pAsync->pOutBuffer = pOutBuffer;
+    pAsync->slaveAddress = slaveAddress;
+    pAsync->offset = offset;
+    pAsync->length = length;
+    pAsync->addressPhase = true;
+    pAsync->write = false;
+    /*! Send the register address, Register_I2C_Poll() follows with the data phase. */
+    register_i2c_count(devInfo->deviceInstance, 1U);
+    status = pCommDrv->MasterTransmit(slaveAddress, &pAsync->offset, 1, true);
+    if (ARM_DRIVER_OK != status)
+    {
+        return register_i2c_give(devInfo, status);
+    }
+
+    return ARM_DRIVER_OK;
+}
+
+/*! The interface function to start block writing sensor registers in place, without waiting. */
+int32_t Register_I2C_StartBlockWriteInPlace(ARM_DRIVER_I2C *pCommDrv,
+                                            registerDeviceInfo_t *devInfo,
+                                            uint16_t slaveAddress,
+                                            uint8_t offset,
+                                            uint8_t *pBuffer,
+                                            uint8_t bytesToWrite)
+{
+    int32_t status;
+    registerI2cAsync_t *pAsync = &g_I2C_Async[devInfo->deviceInstance];
+
+    status = register_i2c_take(devInfo);
+    if (ARM_DRIVER_OK != status)
+    {
+        return status;
+    }
+
+    pAsync->addressPhase = false;
+    pAsync->write = true;
+    pAsync->pOutBuffer = pBuffer + 1;
+    pAsync->offset = offset;
+    pAsync->length = bytesToWrite;
+    /*! The register address goes into the headroom, the payload is sent from the caller buffer. */
+    pBuffer[0] = offset;
+    register_i2c_count(devInfo->deviceInstance, bytesToWrite + 1U);
+    status = pCommDrv->MasterTransmit(slaveAddress, pBuffer, bytesToWrite + 1, false);
+    if (ARM_DRIVER_OK != status)
+    {
+        return register_i2c_give(devInfo, status);
+    }
+
+    return ARM_DRIVER_OK;
+}
+
+/*! The interface function to poll a started transfer. */
+int32_t Register_I2C_Poll(ARM_DRIVER_I2C *pCommDrv, registerDeviceInfo_t *devInfo)
+{
+    int32_t status = ARM_DRIVER_OK;
+    registerI2cAsync_t *pAsync = &g_I2C_Async[devInfo->deviceInstance];
+    uint64_t deadline;
+
+    if (!b_I2C_CompletionFlag[devInfo->deviceInstance])
+    {
+        deadline = USEC_TO_COUNT(devInfo->timeout_us, BOARD_SystickGetCoreFreq());
+        if (!devInfo->timeout_us || ((BOARD_SystickGetTicks() - pAsync->startTicks) <= deadline))
         {
-            if (devInfo->idleFunction)
-            {
-                devInfo->idleFunction(devInfo->functionParam);
-            }
-            else
-            {
-                __NOP();
-            }
+            return ARM_DRIVER_ERROR_BUSY;
         }
-        if (g_I2C_ErrorEvent[devInfo->deviceInstance] == ARM_I2C_EVENT_TRANSFER_INCOMPLETE)
+        pCommDrv->Control(ARM_I2C_ABORT_TRANSFER, 0);
+        if (ARM_DRIVER_OK != pCommDrv->Control(ARM_I2C_BUS_CLEAR, 0))
         {
-            pCommDrv->Control(ARM_I2C_ABORT_TRANSFER, 0);
+            BOARD_I2C_BusClear(devInfo->deviceInstance);
         }
-        if (g_I2C_ErrorEvent[devInfo->deviceInstance] != ARM_I2C_EVENT_TRANSFER_DONE)
+        return register_i2c_give(devInfo, ARM_DRIVER_ERROR_TIMEOUT);
+    }
+
+    if (g_I2C_ErrorEvent[devInfo->deviceInstance] == ARM_I2C_EVENT_TRANSFER_INCOMPLETE)
+    {
+        pCommDrv->Control(ARM_I2C_ABORT_TRANSFER, 0);
+    }
+    if (g_I2C_ErrorEvent[devInfo->deviceInstance] != ARM_I2C_EVENT_TRANSFER_DONE)
+    {
+        return register_i2c_give(devInfo, ARM_DRIVER_ERROR);
+    }
+
+    if (pAsync->addressPhase)
+    {
+        /*! Address sent, read the data behind a repeated start. */
+        pAsync->addressPhase = false;
+        b_I2C_CompletionFlag[devInfo->deviceInstance] = false;
+        register_i2c_count(devInfo->deviceInstance, pAsync->length);
+        status = pCommDrv->MasterReceive(pAsync->slaveAddress, pAsync->pOutBuffer, pAsync->length, false);
+        if (ARM_DRIVER_OK == status)
         {
-            status = ARM_DRIVER_ERROR;
+            return ARM_DRIVER_ERROR_BUSY;
         }
     }
 
-    return status;
+    return register_i2c_give(devInfo, status);
 }
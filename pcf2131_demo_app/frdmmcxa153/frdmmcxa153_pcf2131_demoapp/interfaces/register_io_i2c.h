@@ -147,7 +147,10 @@ void I2C11_SignalEvent_t(uint32_t event);
 #endif
 
 /*!
- * @brief The interface function to write a sensor register.
+ * @brief The interface function to block write sensor registers.
+ *
+ * On LPI2C the offset and the payload are fed to the transmit FIFO as two segments straight from
+ * the caller buffer, without a stack bounce buffer or copy (polled, the I2C signal event is not raised).
  *
  * @param ARM_DRIVER_I2C *pCommDrv - The I2C driver to use.
  * @param registerDeviceInfo_t *devInfo - The I2C device number and idle function.
@@ -156,7 +159,8 @@ void I2C11_SignalEvent_t(uint32_t event);
  * @param uint8_t *pBuffer - The buffer containing bytes to write.
  * @param uint8_t bytesToWrite - A number of bytes to write.
  *
- * @return ARM_DRIVER_OK if success or ARM_DRIVER_ERROR if error.
+ * @return ARM_DRIVER_OK if success, ARM_DRIVER_ERROR_TIMEOUT if the transfer missed the device deadline
+ *         or ARM_DRIVER_ERROR if error.
  */
 int32_t Register_I2C_BlockWrite(ARM_DRIVER_I2C *pCommDrv,
                                 registerDeviceInfo_t *devInfo,
@@ -178,7 +182,8 @@ int32_t Register_I2C_BlockWrite(ARM_DRIVER_I2C *pCommDrv,
  *                       where only the bits set in the mask will be updated according to the value param.
  * @param bool repeatedStart - Indicates whether to send STOP or REPEATED_START bit after the write
  *
- * @return ARM_DRIVER_OK if success or ARM_DRIVER_ERROR if error.
+ * @return ARM_DRIVER_OK if success, ARM_DRIVER_ERROR_TIMEOUT if the transfer missed the device deadline
+ *         or ARM_DRIVER_ERROR if error.
  */
 int32_t Register_I2C_Write(ARM_DRIVER_I2C *pCommDrv,
                            registerDeviceInfo_t *devInfo,
@@ -198,7 +203,8 @@ int32_t Register_I2C_Write(ARM_DRIVER_I2C *pCommDrv,
  * @param uint8_t length - The number of bytes to read
  * @param uint8_t *pOutBuffer - The pointer to the buffer to store the register value read.
  *
- * @return ARM_DRIVER_OK if success or ARM_DRIVER_ERROR if error.
+ * @return ARM_DRIVER_OK if success, ARM_DRIVER_ERROR_TIMEOUT if the transfer missed the device deadline
+ *         or ARM_DRIVER_ERROR if error.
  */
 int32_t Register_I2C_Read(ARM_DRIVER_I2C *pCommDrv,
                           registerDeviceInfo_t *devInfo,
@@ -207,4 +213,96 @@ int32_t Register_I2C_Read(ARM_DRIVER_I2C *pCommDrv,
                           uint8_t length,
                           uint8_t *pOutBuffer);
 
+/*!
+ * @brief The interface function to start reading sensor registers, without waiting.
+ *
+ * The bus is held until Register_I2C_Poll() reports the end of the transfer, the output buffer
+ * must stay valid until then.
+ *
+ * @param ARM_DRIVER_I2C *pCommDrv - The I2C driver to use.
+ * @param registerDeviceInfo_t *devInfo - The I2C device number and idle function.
+ * @param uint16_t slaveAddress - the sensor's I2C slave address.
+ * @param uint8_t offset - The register/offset to read from
+ * @param uint8_t length - The number of bytes to read
+ * @param uint8_t *pOutBuffer - The pointer to the buffer to store the register values read.
+ *
+ * @return ARM_DRIVER_OK if the transfer started, the bus is not held on error.
+ */
+int32_t Register_I2C_StartRead(ARM_DRIVER_I2C *pCommDrv,
+                               registerDeviceInfo_t *devInfo,
+                               uint16_t slaveAddress,
+                               uint8_t offset,
+                               uint8_t length,
+                               uint8_t *pOutBuffer);
+
+/*!
+ * @brief The interface function to start block writing sensor registers in place, without waiting.
+ *
+ * The register address is stored in the one byte headroom and the buffer is sent as is.
+ * The bus is held until Register_I2C_Poll() reports the end of the transfer, the buffer
+ * must stay valid until then.
+ *
+ * @param ARM_DRIVER_I2C *pCommDrv - The I2C driver to use.
+ * @param registerDeviceInfo_t *devInfo - The I2C device number and idle function.
+ * @param uint16_t slaveAddress - the sensor's I2C slave address.
+ * @param uint8_t offset - The register/offset to write to
+ * @param uint8_t *pBuffer - The buffer of one byte headroom followed by the bytes to write.
+ * @param uint8_t bytesToWrite - A number of bytes to write (excluding the headroom).
+ *
+ * @return ARM_DRIVER_OK if the transfer started, the bus is not held on error.
+ */
+int32_t Register_I2C_StartBlockWriteInPlace(ARM_DRIVER_I2C *pCommDrv,
+                                            registerDeviceInfo_t *devInfo,
+                                            uint16_t slaveAddress,
+                                            uint8_t offset,
+                                            uint8_t *pBuffer,
+                                            uint8_t bytesToWrite);
+
+/*!
+ * @brief The interface function to poll a started transfer, it never waits.
+ *
+ * A read moves from its address phase to its data phase here.
+ *
+ * @param ARM_DRIVER_I2C *pCommDrv - The I2C driver to use.
+ * @param registerDeviceInfo_t *devInfo - The I2C device number and idle function.
+ *
+ * @return ARM_DRIVER_ERROR_BUSY while the transfer runs, else the transfer status as for
+ *         Register_I2C_Read(), the bus is given back.
+ */
+int32_t Register_I2C_Poll(ARM_DRIVER_I2C *pCommDrv, registerDeviceInfo_t *devInfo);
+
+/*!
+ * @brief The interface function to get a transfer latency percentile.
+ *
+ * @param uint8_t deviceInstance - The I2C device number.
+ * @param uint8_t percentile - The percentile (0 - 100) of the recorded transfer completion waits.
+ *
+ * @return The upper bound of the latency bin in micro seconds, 0 if no transfer was recorded.
+ *         Use it to size registerDeviceInfo_t timeout_us.
+ */
+uint32_t Register_I2C_GetLatency_us(uint8_t deviceInstance, uint8_t percentile);
+
+/*!
+ * @brief The interface function to clear the transfer latency histogram.
+ *
+ * @param uint8_t deviceInstance - The I2C device number.
+ */
+void Register_I2C_ClearLatency(uint8_t deviceInstance);
+
+/*!
+ * @brief The interface function to get the bus traffic counters.
+ *        Every START and repeated START is a transfer, counted with the bytes behind the slave address.
+ *
+ * @param uint8_t deviceInstance - The I2C device number.
+ * @param registerIoCount_t *pCount - The counters since the last clear.
+ */
+void Register_I2C_GetCount(uint8_t deviceInstance, registerIoCount_t *pCount);
+
+/*!
+ * @brief The interface function to clear the bus traffic counters.
+ *
+ * @param uint8_t deviceInstance - The I2C device number.
+ */
+void Register_I2C_ClearCount(uint8_t deviceInstance);
+
 #endif // __REGISTER_IO_I2C_H__
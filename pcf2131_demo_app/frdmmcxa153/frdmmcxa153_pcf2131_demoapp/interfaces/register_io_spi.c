@@ -18,13 +18,26 @@
 /* ISSDK Includes */
 #include "issdk_hal.h"
 #include "gpio_driver.h"
+#include "systick_utils.h"
 #include "register_io_spi.h"
+#include "bus_arbiter.h"
+#include "register_io_os.h"
+#include "register_io_trace.h"
 
 /*******************************************************************************
  * Types
  ******************************************************************************/
 #define SPI_COUNT (sizeof(spiBases) / sizeof(void *))
 
+/* The register transaction of a started transfer, recorded into the trace when it ends. */
+typedef struct
+{
+    const uint8_t *pPayload; /* Register values behind the command. */
+    uint8_t flags;           /* REGISTER_TRACE_x flags and instance. */
+    uint8_t offset;          /* First register. */
+    uint8_t length;          /* Number of registers. */
+} registerSpiTrace_t;
+
 /*******************************************************************************
  * Variables
  ******************************************************************************/
@@ -36,6 +49,11 @@ SPI_Type *const spiBases[] = SPI_BASE_PTRS;
 #endif
 volatile bool b_SPI_CompletionFlag[SPI_COUNT] = {false};
 volatile uint32_t g_SPI_ErrorEvent[SPI_COUNT] = {ARM_SPI_EVENT_TRANSFER_COMPLETE};
+uint32_t g_SPI_Latency[SPI_COUNT][REGISTER_IO_LATENCY_BINS] = {0};
+registerIoCount_t g_SPI_Count[SPI_COUNT];
+registerOsBus_t g_SPI_Os[SPI_COUNT];
+uint64_t g_SPI_StartTicks[SPI_COUNT];
+registerSpiTrace_t g_SPI_Trace[SPI_COUNT];
 
 /*******************************************************************************
  * Code
@@ -49,6 +67,7 @@ void SPI0_SignalEvent_t(uint32_t event)
         g_SPI_ErrorEvent[0] = event;
     }
     b_SPI_CompletionFlag[0] = true;
+    Register_OS_Signal(&g_SPI_Os[0]);
 }
 #endif
 
@@ -61,6 +80,7 @@ void SPI1_SignalEvent_t(uint32_t event)
         g_SPI_ErrorEvent[1] = event;
     }
     b_SPI_CompletionFlag[1] = true;
+    Register_OS_Signal(&g_SPI_Os[1]);
 }
 #endif
 
@@ -73,6 +93,7 @@ void SPI2_SignalEvent_t(uint32_t event)
         g_SPI_ErrorEvent[2] = event;
     }
     b_SPI_CompletionFlag[2] = true;
+    Register_OS_Signal(&g_SPI_Os[2]);
 }
 #endif
 
@@ -85,6 +106,7 @@ void SPI3_SignalEvent_t(uint32_t event)
         g_SPI_ErrorEvent[3] = event;
     }
     b_SPI_CompletionFlag[3] = true;
+    Register_OS_Signal(&g_SPI_Os[3]);
 }
 #endif
 
@@ -97,6 +119,7 @@ void SPI4_SignalEvent_t(uint32_t event)
         g_SPI_ErrorEvent[4] = event;
     }
     b_SPI_CompletionFlag[4] = true;
+    Register_OS_Signal(&g_SPI_Os[4]);
 }
 #endif
 
@@ -109,6 +132,7 @@ void SPI5_SignalEvent_t(uint32_t event)
         g_SPI_ErrorEvent[5] = event;
     }
     b_SPI_CompletionFlag[5] = true;
+    Register_OS_Signal(&g_SPI_Os[5]);
 }
 #endif
 
@@ -121,6 +145,7 @@ void SPI6_SignalEvent_t(uint32_t event)
         g_SPI_ErrorEvent[6] = event;
     }
     b_SPI_CompletionFlag[6] = true;
+    Register_OS_Signal(&g_SPI_Os[6]);
 }
 #endif
 
@@ -134,6 +159,7 @@ void SPI7_SignalEvent_t(uint32_t event)
         g_SPI_ErrorEvent[7] = event;
     }
     b_SPI_CompletionFlag[7] = true;
+    Register_OS_Signal(&g_SPI_Os[7]);
 }
 #endif
 #if defined(SPI8)
@@ -145,6 +171,7 @@ void SPI8_SignalEvent_t(uint32_t event)
         g_SPI_ErrorEvent[8] = event;
     }
     b_SPI_CompletionFlag[8] = true;
+    Register_OS_Signal(&g_SPI_Os[8]);
 }
 #endif
 #endif
@@ -162,40 +189,38 @@ void register_spi_control(spiControlParams_t *ssControl)
     }
 }
 
-/*! The interface function to block write sensor registers. */
-int32_t Register_SPI_BlockWrite(ARM_DRIVER_SPI *pCommDrv,
-                                registerDeviceInfo_t *devInfo,
-                                void *pWriteParams,
-                                uint8_t offset,
-                                const uint8_t *pBuffer,
-                                uint8_t bytesToWrite)
+/* Count a transfer wait in its power of two latency bin. */
+static void register_spi_latency(uint8_t deviceInstance, uint32_t latency_us)
 {
-    int32_t status;
-    spiCmdParams_t slaveWriteCmd;
-    spiSlaveSpecificParams_t *pSlaveParams = pWriteParams;
+    uint8_t bin = 0;
 
-    spiControlParams_t ss_en_cmd = {
-        .cmdCode = ARM_SPI_SS_ACTIVE,
-        .activeValue = pSlaveParams->ssActiveValue,
-        .pTargetSlavePinID = pSlaveParams->pTargetSlavePinID,
-    };
-    spiControlParams_t ss_dis_cmd = {
-        .cmdCode = ARM_SPI_SS_INACTIVE,
-        .activeValue = pSlaveParams->ssActiveValue,
-        .pTargetSlavePinID = pSlaveParams->pTargetSlavePinID,
-    };
+    while ((latency_us >> bin) && (bin < REGISTER_IO_LATENCY_BINS - 1))
+    {
+        bin++;
+    }
+    g_SPI_Latency[deviceInstance][bin]++;
+}
 
-    pSlaveParams->pWritePreprocessFN(&slaveWriteCmd, offset, bytesToWrite, (void *)pBuffer);
-    b_SPI_CompletionFlag[devInfo->deviceInstance] = false;
-    g_SPI_ErrorEvent[devInfo->deviceInstance] = ARM_SPI_EVENT_TRANSFER_COMPLETE;
-    /*! Write and the value.*/
-    register_spi_control(&ss_en_cmd);
-    status = pCommDrv->Transfer(slaveWriteCmd.pWriteBuffer, slaveWriteCmd.pReadBuffer, slaveWriteCmd.size);
-    if (ARM_DRIVER_OK == status)
+/* Wait for the transfer completion until the device deadline expires, abort the transfer on expiry. */
+static int32_t register_spi_wait(ARM_DRIVER_SPI *pCommDrv, registerDeviceInfo_t *devInfo)
+{
+    int32_t status;
+    uint64_t deadline = USEC_TO_COUNT(devInfo->timeout_us, BOARD_SystickGetCoreFreq());
+
+    /* A task blocks on the completion semaphore, bare-metal code spins with the idle function. */
+    status = Register_OS_Wait(&g_SPI_Os[devInfo->deviceInstance], &b_SPI_CompletionFlag[devInfo->deviceInstance],
+                              devInfo->timeout_us);
+    if (ARM_DRIVER_ERROR_UNSUPPORTED == status)
     {
-        /* Wait for completion */
+        status = ARM_DRIVER_OK;
         while (!b_SPI_CompletionFlag[devInfo->deviceInstance])
         {
+            if (devInfo->timeout_us &&
+                ((BOARD_SystickGetTicks() - g_SPI_StartTicks[devInfo->deviceInstance]) > deadline))
+            {
+                status = ARM_DRIVER_ERROR_TIMEOUT;
+                break;
+            }
             if (devInfo->idleFunction)
             {
                 devInfo->idleFunction(devInfo->functionParam);
@@ -205,15 +230,328 @@ int32_t Register_SPI_BlockWrite(ARM_DRIVER_SPI *pCommDrv,
                 __NOP();
             }
         }
-        if (g_SPI_ErrorEvent[devInfo->deviceInstance] != ARM_SPI_EVENT_TRANSFER_COMPLETE)
+    }
+    if (ARM_DRIVER_ERROR_TIMEOUT == status)
+    {
+        pCommDrv->Control(ARM_SPI_ABORT_TRANSFER, 0);
+    }
+
+    return status;
+}
+
+/* Drive the slave select of the device. */
+static void register_spi_select(spiSlaveSpecificParams_t *pSlaveParams, uint8_t cmdCode)
+{
+    spiControlParams_t ssCmd = {
+        .cmdCode = cmdCode,
+        .activeValue = pSlaveParams->ssActiveValue,
+        .pTargetSlavePinID = pSlaveParams->pTargetSlavePinID,
+    };
+
+    register_spi_control(&ssCmd);
+}
+
+/* Take the bus, select the slave and start the formatted transfer, on failure the bus is given back.
+ * A command without read buffer is sent only, nothing is clocked in. */
+static int32_t register_spi_start(ARM_DRIVER_SPI *pCommDrv,
+                                  registerDeviceInfo_t *devInfo,
+                                  spiSlaveSpecificParams_t *pSlaveParams,
+                                  spiCmdParams_t *pCmd,
+                                  uint8_t offset,
+                                  uint8_t length)
+{
+    int32_t status;
+    registerSpiTrace_t *pTrace = &g_SPI_Trace[devInfo->deviceInstance];
+
+    /*! Hold the shared bus for the whole transfer. */
+    status = Register_OS_Lock(&g_SPI_Os[devInfo->deviceInstance]);
+    if (ARM_DRIVER_OK != status)
+    {
+        return status;
+    }
+    status = Bus_Arbiter_Acquire(devInfo->pArbDevice);
+    if (ARM_DRIVER_OK != status)
+    {
+        Register_OS_Unlock(&g_SPI_Os[devInfo->deviceInstance]);
+        return status;
+    }
+
+    b_SPI_CompletionFlag[devInfo->deviceInstance] = false;
+    g_SPI_ErrorEvent[devInfo->deviceInstance] = ARM_SPI_EVENT_TRANSFER_COMPLETE;
+    g_SPI_StartTicks[devInfo->deviceInstance] = BOARD_SystickGetTicks();
+    g_SPI_Count[devInfo->deviceInstance].transfers++;
+    g_SPI_Count[devInfo->deviceInstance].bytes += pCmd->size;
+    pTrace->pPayload = pCmd->pWriteBuffer + pSlaveParams->spiCmdLen;
+    pTrace->flags = REGISTER_TRACE_INSTANCE(devInfo->deviceInstance) | (pCmd->pReadBuffer ? 0 : REGISTER_TRACE_WRITE);
+    pTrace->offset = offset;
+    pTrace->length = length;
+    register_spi_select(pSlaveParams, ARM_SPI_SS_ACTIVE);
+    if (pCmd->pReadBuffer)
+    {
+        status = pCommDrv->Transfer(pCmd->pWriteBuffer, pCmd->pReadBuffer, pCmd->size);
+    }
+    else
+    {
+        status = pCommDrv->Send(pCmd->pWriteBuffer, pCmd->size);
+    }
+    if (ARM_DRIVER_OK != status)
+    {
+        register_spi_select(pSlaveParams, ARM_SPI_SS_INACTIVE);
+        Bus_Arbiter_Release(devInfo->pArbDevice);
+        Register_OS_Unlock(&g_SPI_Os[devInfo->deviceInstance]);
+    }
+
+    return status;
+}
+
+/* Check the outcome of the ended transfer, deselect the slave and give the bus back. */
+static int32_t register_spi_finish(ARM_DRIVER_SPI *pCommDrv,
+                                   registerDeviceInfo_t *devInfo,
+                                   spiSlaveSpecificParams_t *pSlaveParams,
+                                   int32_t status)
+{
+    uint64_t elapsed = BOARD_SystickGetTicks() - g_SPI_StartTicks[devInfo->deviceInstance];
+    registerSpiTrace_t *pTrace = &g_SPI_Trace[devInfo->deviceInstance];
+
+    register_spi_latency(devInfo->deviceInstance, (uint32_t)COUNT_TO_USEC(elapsed, BOARD_SystickGetCoreFreq()));
+
+    if ((ARM_DRIVER_OK == status) &&
+        (g_SPI_ErrorEvent[devInfo->deviceInstance] != ARM_SPI_EVENT_TRANSFER_COMPLETE))
+    {
+        status = ARM_DRIVER_ERROR;
+        pCommDrv->Control(ARM_SPI_ABORT_TRANSFER, 0);
+    }
+    register_spi_select(pSlaveParams, ARM_SPI_SS_INACTIVE);
+    Register_Trace_Record(pTrace->flags, pTrace->offset, pTrace->length, pTrace->pPayload,
+                          g_SPI_StartTicks[devInfo->deviceInstance], status);
+    Bus_Arbiter_Release(devInfo->pArbDevice);
+    Register_OS_Unlock(&g_SPI_Os[devInfo->deviceInstance]);
+
+    return status;
+}
+
+/* Run a register transaction as two transfers under one slave select: the command from the stack, then the
+ * payload straight in or out of caller memory. Neither a staging buffer nor a copy is needed for a caller
+ * buffer without command headroom. A write is sent from pWriteBuffer, a read is clocked into pReadBuffer. */
+static int32_t register_spi_split(ARM_DRIVER_SPI *pCommDrv,
+                                  registerDeviceInfo_t *devInfo,
+                                  spiSlaveSpecificParams_t *pSlaveParams,
+                                  uint8_t offset,
+                                  uint8_t *pReadBuffer,
+                                  const uint8_t *pWriteBuffer,
+                                  uint8_t length)
+{
+    int32_t status;
+    uint8_t command[SPI_MAX_CMD_LEN];
+    spiCmdParams_t slaveCmd = {
+        .pWriteBuffer = command,
+        .pReadBuffer = NULL,
+    };
+    registerSpiTrace_t *pTrace = &g_SPI_Trace[devInfo->deviceInstance];
+
+    if (pSlaveParams->spiCmdLen > SPI_MAX_CMD_LEN)
+    {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+
+    /*! Format the command alone, no payload follows it in the command buffer. */
+    if (pReadBuffer)
+    {
+        pSlaveParams->pReadPreprocessFN(&slaveCmd, offset, 0);
+    }
+    else
+    {
+        pSlaveParams->pWritePreprocessFN(&slaveCmd, offset, 0, command + pSlaveParams->spiCmdLen);
+    }
+    status = register_spi_start(pCommDrv, devInfo, pSlaveParams, &slaveCmd, offset, length);
+    if (ARM_DRIVER_OK != status)
+    {
+        return status;
+    }
+    pTrace->pPayload = pReadBuffer ? pReadBuffer : pWriteBuffer;
+    pTrace->flags = REGISTER_TRACE_INSTANCE(devInfo->deviceInstance) | (pReadBuffer ? 0 : REGISTER_TRACE_WRITE);
+
+    /*! The payload phase, the slave stays selected and the deadline covers both phases. */
+    status = register_spi_wait(pCommDrv, devInfo);
+    if ((ARM_DRIVER_OK == status) && (length != 0) &&
+        (g_SPI_ErrorEvent[devInfo->deviceInstance] == ARM_SPI_EVENT_TRANSFER_COMPLETE))
+    {
+        b_SPI_CompletionFlag[devInfo->deviceInstance] = false;
+        g_SPI_Count[devInfo->deviceInstance].bytes += length;
+        if (pReadBuffer)
         {
-            status = ARM_DRIVER_ERROR;
-            pCommDrv->Control(ARM_SPI_ABORT_TRANSFER, 0);
+            status = pCommDrv->Receive(pReadBuffer, length);
+        }
+        else
+        {
+            status = pCommDrv->Send(pWriteBuffer, length);
+        }
+        if (ARM_DRIVER_OK == status)
+        {
+            status = register_spi_wait(pCommDrv, devInfo);
         }
     }
-    register_spi_control(&ss_dis_cmd);
 
-    return status;
+    return register_spi_finish(pCommDrv, devInfo, pSlaveParams, status);
+}
+
+/*! The interface function to get a transfer latency percentile. */
+uint32_t Register_SPI_GetLatency_us(uint8_t deviceInstance, uint8_t percentile)
+{
+    uint32_t total = 0, count = 0;
+    uint8_t bin;
+
+    for (bin = 0; bin < REGISTER_IO_LATENCY_BINS; bin++)
+    {
+        total += g_SPI_Latency[deviceInstance][bin];
+    }
+    if ((0 == total) || (percentile > 100))
+    {
+        return 0;
+    }
+    for (bin = 0; bin < REGISTER_IO_LATENCY_BINS - 1; bin++)
+    {
+        count += g_SPI_Latency[deviceInstance][bin];
+        if ((uint64_t)count * 100 >= (uint64_t)total * percentile)
+        {
+            break;
+        }
+    }
+
+    return 1u << bin;
+}
+
+/*! The interface function to clear the transfer latency histogram. */
+void Register_SPI_ClearLatency(uint8_t deviceInstance)
+{
+    memset(g_SPI_Latency[deviceInstance], 0, sizeof(g_SPI_Latency[deviceInstance]));
+}
+
+/*! The interface function to get the bus traffic counters. */
+void Register_SPI_GetCount(uint8_t deviceInstance, registerIoCount_t *pCount)
+{
+    *pCount = g_SPI_Count[deviceInstance];
+}
+
+/*! The interface function to clear the bus traffic counters. */
+void Register_SPI_ClearCount(uint8_t deviceInstance)
+{
+    memset(&g_SPI_Count[deviceInstance], 0, sizeof(g_SPI_Count[deviceInstance]));
+}
+
+/*! The interface function to read sensor registers in place. */
+int32_t Register_SPI_ReadInPlace(ARM_DRIVER_SPI *pCommDrv,
+                                 registerDeviceInfo_t *devInfo,
+                                 void *pReadParams,
+                                 uint8_t offset,
+                                 uint8_t length,
+                                 uint8_t *pBuffer)
+{
+    int32_t status;
+
+    status = Register_SPI_StartReadInPlace(pCommDrv, devInfo, pReadParams, offset, length, pBuffer);
+    if (ARM_DRIVER_OK != status)
+    {
+        return status;
+    }
+
+    /* Wait for completion */
+    status = register_spi_wait(pCommDrv, devInfo);
+
+    return register_spi_finish(pCommDrv, devInfo, pReadParams, status);
+}
+
+/*! The interface function to block write sensor registers in place. */
+int32_t Register_SPI_BlockWriteInPlace(ARM_DRIVER_SPI *pCommDrv,
+                                       registerDeviceInfo_t *devInfo,
+                                       void *pWriteParams,
+                                       uint8_t offset,
+                                       uint8_t *pBuffer,
+                                       uint8_t bytesToWrite)
+{
+    int32_t status;
+
+    status = Register_SPI_StartBlockWriteInPlace(pCommDrv, devInfo, pWriteParams, offset, pBuffer, bytesToWrite);
+    if (ARM_DRIVER_OK != status)
+    {
+        return status;
+    }
+
+    /* Wait for completion */
+    status = register_spi_wait(pCommDrv, devInfo);
+
+    return register_spi_finish(pCommDrv, devInfo, pWriteParams, status);
+}
+
+/*! The interface function to start reading sensor registers in place. */
+int32_t Register_SPI_StartReadInPlace(ARM_DRIVER_SPI *pCommDrv,
+                                      registerDeviceInfo_t *devInfo,
+                                      void *pReadParams,
+                                      uint8_t offset,
+                                      uint8_t length,
+                                      uint8_t *pBuffer)
+{
+    spiSlaveSpecificParams_t *pSlaveParams = pReadParams;
+    spiCmdParams_t slaveReadCmd = {
+        .pWriteBuffer = pBuffer,
+        .pReadBuffer = pBuffer,
+    };
+
+    /* Format the command into the headroom, the payload is clocked in behind it. */
+    pSlaveParams->pReadPreprocessFN(&slaveReadCmd, offset, length);
+
+    return register_spi_start(pCommDrv, devInfo, pSlaveParams, &slaveReadCmd, offset, length);
+}
+
+/*! The interface function to start block writing sensor registers in place. */
+int32_t Register_SPI_StartBlockWriteInPlace(ARM_DRIVER_SPI *pCommDrv,
+                                            registerDeviceInfo_t *devInfo,
+                                            void *pWriteParams,
+                                            uint8_t offset,
+                                            uint8_t *pBuffer,
+                                            uint8_t bytesToWrite)
+{
+    spiSlaveSpecificParams_t *pSlaveParams = pWriteParams;
+    spiCmdParams_t slaveWriteCmd = {
+        .pWriteBuffer = pBuffer,
+        .pReadBuffer = NULL,
+    };
+
+    /* Format the command into the headroom, the payload already follows it. */
+    pSlaveParams->pWritePreprocessFN(&slaveWriteCmd, offset, bytesToWrite, pBuffer + pSlaveParams->spiCmdLen);
+
+    return register_spi_start(pCommDrv, devInfo, pSlaveParams, &slaveWriteCmd, offset, bytesToWrite);
+}
+
+/*! The interface function to poll a started transfer. */
+int32_t Register_SPI_Poll(ARM_DRIVER_SPI *pCommDrv, registerDeviceInfo_t *devInfo, void *pParams)
+{
+    uint64_t deadline;
+
+    if (!b_SPI_CompletionFlag[devInfo->deviceInstance])
+    {
+        deadline = USEC_TO_COUNT(devInfo->timeout_us, BOARD_SystickGetCoreFreq());
+        if (!devInfo->timeout_us || ((BOARD_SystickGetTicks() - g_SPI_StartTicks[devInfo->deviceInstance]) <= deadline))
+        {
+            return ARM_DRIVER_ERROR_BUSY;
+        }
+        pCommDrv->Control(ARM_SPI_ABORT_TRANSFER, 0);
+        return register_spi_finish(pCommDrv, devInfo, pParams, ARM_DRIVER_ERROR_TIMEOUT);
+    }
+
+    return register_spi_finish(pCommDrv, devInfo, pParams, ARM_DRIVER_OK);
+}
+
+/*! The interface function to block write sensor registers. */
+int32_t Register_SPI_BlockWrite(ARM_DRIVER_SPI *pCommDrv,
+                                registerDeviceInfo_t *devInfo,
+                                void *pWriteParams,
+                                uint8_t offset,
+                                const uint8_t *pBuffer,
+                                uint8_t bytesToWrite)
+{
+    /*! The payload is sent from the caller buffer behind the command. */
+    return register_spi_split(pCommDrv, devInfo, pWriteParams, offset, NULL, pBuffer, bytesToWrite);
 }
 
 /*! The interface function to write a sensor register. */
@@ -225,90 +563,45 @@ int32_t Register_SPI_Write(ARM_DRIVER_SPI *pCommDrv,
                            uint8_t mask)
 {
     int32_t status;
-    uint8_t regValue;
-    spiCmdParams_t slaveReadCmd, slaveWriteCmd;
+    uint8_t buffer[SPI_MAX_CMD_LEN + 1];
     spiSlaveSpecificParams_t *pSlaveParams = pWriteParams;
+    uint8_t *pRegValue = buffer + pSlaveParams->spiCmdLen;
 
-    spiControlParams_t ss_en_cmd = {
-        .cmdCode = ARM_SPI_SS_ACTIVE,
-        .activeValue = pSlaveParams->ssActiveValue,
-        .pTargetSlavePinID = pSlaveParams->pTargetSlavePinID,
-    };
-    spiControlParams_t ss_dis_cmd = {
-        .cmdCode = ARM_SPI_SS_INACTIVE,
-        .activeValue = pSlaveParams->ssActiveValue,
-        .pTargetSlavePinID = pSlaveParams->pTargetSlavePinID,
-    };
+    if (pSlaveParams->spiCmdLen > SPI_MAX_CMD_LEN)
+    {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+
+    /*! Keep the bus from the read to the write of a read-modify-write. */
+    status = Register_OS_Lock(&g_SPI_Os[devInfo->deviceInstance]);
+    if (ARM_DRIVER_OK != status)
+    {
+        return status;
+    }
 
     /*! Set the register based on the values in the register value pair configuration.*/
     if (mask)
     {
-        /* Get the formatted SPI Read Command. */
-        pSlaveParams->pReadPreprocessFN(&slaveReadCmd, offset, 1);
-        b_SPI_CompletionFlag[devInfo->deviceInstance] = false;
-        g_SPI_ErrorEvent[devInfo->deviceInstance] = ARM_SPI_EVENT_TRANSFER_COMPLETE;
         /*! Read the register value.*/
-        register_spi_control(&ss_en_cmd);
-        status = pCommDrv->Transfer(slaveReadCmd.pWriteBuffer, slaveReadCmd.pReadBuffer, slaveReadCmd.size);
-        if (ARM_DRIVER_OK == status)
+        status = Register_SPI_ReadInPlace(pCommDrv, devInfo, pWriteParams, offset, 1, buffer);
+        if (ARM_DRIVER_OK != status)
         {
-            /* Wait for completion */
-            while (!b_SPI_CompletionFlag[devInfo->deviceInstance])
-            {
-                if (devInfo->idleFunction)
-                {
-                    devInfo->idleFunction(devInfo->functionParam);
-                }
-                else
-                {
-                    __NOP();
-                }
-            }
-            if (g_SPI_ErrorEvent[devInfo->deviceInstance] != ARM_SPI_EVENT_TRANSFER_COMPLETE)
-            {
-                status = ARM_DRIVER_ERROR;
-                pCommDrv->Control(ARM_SPI_ABORT_TRANSFER, 0);
-            }
+            Register_OS_Unlock(&g_SPI_Os[devInfo->deviceInstance]);
+            return status;
         }
-        register_spi_control(&ss_dis_cmd);
 
         /*! 'OR' in the requested values to the current contents of the register */
-        regValue = *(slaveReadCmd.pReadBuffer + pSlaveParams->spiCmdLen);
-        regValue = (regValue & ~mask) | value;
+        *pRegValue = (*pRegValue & ~mask) | value;
     }
     else
     {
         /*! Overwrite the register with specified value.*/
-        regValue = value;
+        *pRegValue = value;
     }
 
-    pSlaveParams->pWritePreprocessFN(&slaveWriteCmd, offset, 1, &regValue);
-    b_SPI_CompletionFlag[devInfo->deviceInstance] = false;
-    g_SPI_ErrorEvent[devInfo->deviceInstance] = ARM_SPI_EVENT_TRANSFER_COMPLETE;
-    /*! Write and the value.*/
-    register_spi_control(&ss_en_cmd);
-    status = pCommDrv->Transfer(slaveWriteCmd.pWriteBuffer, slaveWriteCmd.pReadBuffer, slaveWriteCmd.size);
-    if (ARM_DRIVER_OK == status)
-    {
-        /* Wait for completion */
-        while (!b_SPI_CompletionFlag[devInfo->deviceInstance])
-        {
-            if (devInfo->idleFunction)
-            {
-                devInfo->idleFunction(devInfo->functionParam);
-            }
-            else
-            {
-                __NOP();
-            }
-        }
-        if (g_SPI_ErrorEvent[devInfo->deviceInstance] != ARM_SPI_EVENT_TRANSFER_COMPLETE)
-        {
-            status = ARM_DRIVER_ERROR;
-            pCommDrv->Control(ARM_SPI_ABORT_TRANSFER, 0);
-        }
-    }
-    register_spi_control(&ss_dis_cmd);
+    /*! Write the value.*/
+    status = Register_SPI_BlockWriteInPlace(pCommDrv, devInfo, pWriteParams, offset, buffer, 1);
+    Register_OS_Unlock(&g_SPI_Os[devInfo->deviceInstance]);
 
     return status;
 }
@@ -321,50 +614,6 @@ int32_t Register_SPI_Read(ARM_DRIVER_SPI *pCommDrv,
                           uint8_t length,
                           uint8_t *pOutBuffer)
 {
-    int32_t status;
-    spiCmdParams_t slaveReadCmd;
-    spiSlaveSpecificParams_t *pSlaveParams = pReadParams;
-
-    spiControlParams_t ss_en_cmd = {
-        .cmdCode = ARM_SPI_SS_ACTIVE,
-        .activeValue = pSlaveParams->ssActiveValue,
-        .pTargetSlavePinID = pSlaveParams->pTargetSlavePinID,
-    };
-    spiControlParams_t ss_dis_cmd = {
-        .cmdCode = ARM_SPI_SS_INACTIVE,
-        .activeValue = pSlaveParams->ssActiveValue,
-        .pTargetSlavePinID = pSlaveParams->pTargetSlavePinID,
-    };
-
-    pSlaveParams->pReadPreprocessFN(&slaveReadCmd, offset, length);
-    b_SPI_CompletionFlag[devInfo->deviceInstance] = false;
-    g_SPI_ErrorEvent[devInfo->deviceInstance] = ARM_SPI_EVENT_TRANSFER_COMPLETE;
-    /*! Read the value.*/
-    register_spi_control(&ss_en_cmd);
-    status = pCommDrv->Transfer(slaveReadCmd.pWriteBuffer, slaveReadCmd.pReadBuffer, slaveReadCmd.size);
-    if (ARM_DRIVER_OK == status)
-    {
-        /* Wait for completion */
-        while (!b_SPI_CompletionFlag[devInfo->deviceInstance])
-        {
-            if (devInfo->idleFunction)
-            {
-                devInfo->idleFunction(devInfo->functionParam);
-            }
-            else
-            {
-                __NOP();
-            }
-        }
-        if (g_SPI_ErrorEvent[devInfo->deviceInstance] != ARM_SPI_EVENT_TRANSFER_COMPLETE)
-        {
-            status = ARM_DRIVER_ERROR;
-            pCommDrv->Control(ARM_SPI_ABORT_TRANSFER, 0);
-        }
-    }
-    register_spi_control(&ss_dis_cmd);
-
-    memcpy(pOutBuffer, slaveReadCmd.pReadBuffer + pSlaveParams->spiCmdLen, length);
-
-    return status;
+    /*! The registers are clocked straight into the caller buffer behind the command. */
+    return register_spi_split(pCommDrv, devInfo, pReadParams, offset, pOutBuffer, NULL, length);
 }
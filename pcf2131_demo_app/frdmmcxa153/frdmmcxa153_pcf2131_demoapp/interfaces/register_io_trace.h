@@ -0,0 +1,88 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file register_io_trace.h
+ * @brief The register_io_trace.h file declares the capture of register transactions into a binary trace.
+ *
+ * Every register read or write finished by the SPI and I2C register I/O layers while a capture runs
+ * is appended as one record:
+ *
+ *   flags      1 byte   bit 0 write, bit 1 I2C, bit 2 failed, bits 3..7 device instance
+ *   offset     1 byte   first register
+ *   length     1 byte   number of registers
+ *   gap        varint   micro seconds from the start of the previous record (of the capture start for the first)
+ *   duration   varint   micro seconds from the start to the end of the transaction
+ *   payload    length bytes, written or read register values, absent for a failed transaction
+ *
+ * A varint is 7 bits per byte, least significant first, bit 7 set on all bytes but the last.
+ * Replaying the read payloads in order answers the driver as the device did during the capture.
+ */
+
+#ifndef __REGISTER_IO_TRACE_H__
+#define __REGISTER_IO_TRACE_H__
+
+#include "sensor_drv.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Record flags. */
+#define REGISTER_TRACE_WRITE       (0x01U) /* Register write, a read otherwise. */
+#define REGISTER_TRACE_I2C         (0x02U) /* I2C bus, SPI otherwise. */
+#define REGISTER_TRACE_FAILED      (0x04U) /* The transaction failed, no payload follows. */
+#define REGISTER_TRACE_INSTANCE(x) ((uint8_t)((x) << 3))
+
+/*! @brief Longest record: flags, offset, length, two 5 byte varints and the largest payload. */
+#define REGISTER_TRACE_MAX_RECORD (3U + 5U + 5U + SENSOR_MAX_REGISTER_COUNT)
+
+/*******************************************************************************
+ * Types
+ ******************************************************************************/
+/*!
+ * @brief This structure defines the capture counters.
+ */
+typedef struct
+{
+    uint32_t length;  /* Trace bytes captured. */
+    uint32_t records; /* Records captured. */
+    uint32_t dropped; /* Records dropped on a full buffer. */
+} registerTraceStats_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+/*!
+ * @brief The interface function to start capturing into a buffer, a running capture is restarted.
+ *
+ * @param uint8_t *pBuffer - The trace buffer, it must stay valid until the capture is stopped.
+ * @param uint32_t size - The buffer size in bytes.
+ */
+void Register_Trace_Start(uint8_t *pBuffer, uint32_t size);
+
+/*!
+ * @brief The interface function to stop capturing, the trace stays in the buffer.
+ *
+ * @param registerTraceStats_t *pStats - The capture counters, NULL if not needed.
+ */
+void Register_Trace_Stop(registerTraceStats_t *pStats);
+
+/*!
+ * @brief The interface function to append a finished transaction, called by the register I/O layers.
+ *        It returns at once when no capture runs.
+ *
+ * @param uint8_t flags - REGISTER_TRACE_x flags and REGISTER_TRACE_INSTANCE(), REGISTER_TRACE_FAILED is set from status.
+ * @param uint8_t offset - The first register.
+ * @param uint8_t length - The number of registers.
+ * @param const uint8_t *pPayload - The register values.
+ * @param uint64_t startTicks - Systick count at the start of the transaction.
+ * @param int32_t status - The transaction status.
+ */
+void Register_Trace_Record(
+    uint8_t flags, uint8_t offset, uint8_t length, const uint8_t *pPayload, uint64_t startTicks, int32_t status);
+
+#endif // __REGISTER_IO_TRACE_H__
@@ -38,14 +38,18 @@ int32_t Sensor_SPI_BlockWrite(ARM_DRIVER_SPI *pCommDrv,
     }
 
     const registercommandlist_t *pCmd = pCommandList;
-    /*! Update register values based on register write list unless the next Cmd is the list terminator */
-    do
+    /*! Update register values based on register write list until the list terminator, an empty list writes nothing */
+    for (; pCmd->writeTo != 0xFFFF; pCmd++)
     { /*! Write the command based on the values in the command and value pair.*/
+        if ((pCmd->writeTo > 0xFF) || (pCmd->pWriteBuffer == NULL))
+        {
+            return SENSOR_ERROR_BAD_ADDRESS;
+        }
         status =
             Register_SPI_BlockWrite(pCommDrv, devInfo, pWriteParams, pCmd->writeTo, pCmd->pWriteBuffer, pCmd->numBytes);
         if (ARM_DRIVER_OK != status)
         {
-            return SENSOR_ERROR_WRITE;
+            return (ARM_DRIVER_ERROR_TIMEOUT == status) ? SENSOR_ERROR_TIMEOUT : SENSOR_ERROR_WRITE;
         }
 
         do
@@ -54,7 +58,7 @@ int32_t Sensor_SPI_BlockWrite(ARM_DRIVER_SPI *pCommDrv,
             status = Register_SPI_Read(pCommDrv, devInfo, pWriteParams, 0, sizeof(cocoBuffer), cocoBuffer);
             if (ARM_DRIVER_OK != status)
             {
-                return SENSOR_ERROR_READ;
+                return (ARM_DRIVER_ERROR_TIMEOUT == status) ? SENSOR_ERROR_TIMEOUT : SENSOR_ERROR_READ;
             }
             commandComplete = cocoBuffer[1] & 0x80;
             if (commandComplete && cocoBuffer[1] & error_mask)
@@ -62,7 +66,7 @@ int32_t Sensor_SPI_BlockWrite(ARM_DRIVER_SPI *pCommDrv,
                 return SENSOR_ERROR_WRITE;
             }
         } while (!commandComplete);
-    } while ((++pCmd)->writeTo != 0xFFFF);
+    }
 
     return SENSOR_ERROR_NONE;
 }
@@ -74,7 +78,6 @@ int32_t Sensor_SPI_Write(ARM_DRIVER_SPI *pCommDrv,
                          const registerwritelist_t *pRegWriteList)
 {
     int32_t status;
-    bool endDataMarkAwaited;
 
     /*! Validate for the correct handle.*/
     if ((pCommDrv == NULL) || (pRegWriteList == NULL))
@@ -84,18 +87,20 @@ int32_t Sensor_SPI_Write(ARM_DRIVER_SPI *pCommDrv,
 
     const registerwritelist_t *pCmd = pRegWriteList;
 
-    /*! Update register values based on register write list unless the next Cmd is the list terminator */
-    do
+    /*! Update register values based on register write list until the list terminator, an empty list writes nothing */
+    for (; pCmd->writeTo != 0xFFFF; pCmd++)
     {
-        endDataMarkAwaited = (pCmd + 1)->writeTo != 0xFFFF;
+        if (pCmd->writeTo > 0xFF)
+        {
+            return SENSOR_ERROR_BAD_ADDRESS;
+        }
         /*! Set the register based on the values in the register value pair.*/
         status = Register_SPI_Write(pCommDrv, devInfo, pWriteParams, pCmd->writeTo, pCmd->value, pCmd->mask);
         if (ARM_DRIVER_OK != status)
         {
-            return SENSOR_ERROR_WRITE;
+            return (ARM_DRIVER_ERROR_TIMEOUT == status) ? SENSOR_ERROR_TIMEOUT : SENSOR_ERROR_WRITE;
         }
-        ++pCmd;
-    } while (endDataMarkAwaited);
+    }
 
     return SENSOR_ERROR_NONE;
 }
@@ -121,10 +126,14 @@ int32_t Sensor_SPI_Read(ARM_DRIVER_SPI *pCommDrv,
     /*! Traverse the read list and read the registers one by one unless the register read list numBytes is zero*/
     for (pBuf = pOutBuffer; pCmd->numBytes != 0; pCmd++)
     {
+        if (pCmd->readFrom > 0xFF)
+        {
+            return SENSOR_ERROR_BAD_ADDRESS;
+        }
         status = Register_SPI_Read(pCommDrv, devInfo, pReadParams, pCmd->readFrom, pCmd->numBytes, pBuf);
         if (ARM_DRIVER_OK != status)
         {
-            return SENSOR_ERROR_READ;
+            return (ARM_DRIVER_ERROR_TIMEOUT == status) ? SENSOR_ERROR_TIMEOUT : SENSOR_ERROR_READ;
         }
         pBuf += pCmd->numBytes;
     }
@@ -16,8 +16,10 @@
 #include <stdint.h>
 #include <stdbool.h>
 
-/* Select 0 for SPI 1 for I2C */
+/* Select 0 for SPI 1 for I2C, a build may preset it */
+#ifndef I2C_ENABLE
 #define  I2C_ENABLE          1
+#endif
 
 /**
  **
@@ -813,6 +815,32 @@ typedef union
 #define PCF2131_SUBSEC_TS_MASK     ((uint8_t)0x1F)
 #define PCF2131_SUBSEC_TS_SHIFT    ((uint8_t)0)
 
+/*--------------------------------
+ ** Register: Aging_offset
+ ** Enum: PCF2131_AGING_OFFSET.
+ ** --
+ ** Offset : 0x30 crystal aging offset register.
+ ** ------------------------------*/
+typedef union
+{
+	struct
+	{
+		uint8_t ao : 4;                /* aging offset 0000- +8 ppm ... 1000- 0 ppm ... 1111- -7 ppm */
+		uint8_t _reserved_1 : 4;       /* Reserved Bit (Unused) */
+	} b;
+	uint8_t w;
+} PCF2131_AGING_OFFSET_REG;
+
+/*
+ ** Aging_offset - Bit field mask definitions
+ */
+#define PCF2131_AGING_OFFSET_AO_MASK    ((uint8_t)0x0F)
+#define PCF2131_AGING_OFFSET_AO_SHIFT   ((uint8_t)0)
+
+#define PCF2131_AGING_OFFSET_ZERO       ((uint8_t)0x08)   /* AO code for 0 ppm correction */
+#define PCF2131_AGING_OFFSET_MAX        ((uint8_t)0x0F)
+#define PCF2131_AGING_PPM_PER_STEP      (1)               /* correction step in ppm, higher code = slower clock */
+
 /*--------------------------------
  ** Register: INT_A/B_MASK_1
  ** Enum: PCF2131_INT_A/B_MASK1.
@@ -905,6 +933,67 @@ typedef union
 #define PCF2131_TS4_DIS_MASK              ((uint8_t)0x01)
 #define PCF2131_TS4_SHIFT                 ((uint8_t)0x00)
 
+/*--------------------------------
+ ** Register: CLKOUT_ctl
+ ** Enum: PCF2131_CLKOUT_CTL.
+ ** --
+ ** Offset : 0x13 CLKOUT control register.
+ ** ------------------------------*/
+typedef union
+{
+	struct
+	{
+		uint8_t cof : 3;               /* CLKOUT frequency 000- 32768 Hz ... 110- 1 Hz 111- CLKOUT disabled (high-Z) */
+		uint8_t _reserved_1 : 2;       /* Reserved Bit (Unused) */
+		uint8_t otpr : 1;              /* 0- no OTP refresh 1- OTP refresh performed */
+		uint8_t tcr : 2;               /* temperature measurement period 00- 32 min 01- 16 min 10- 8 min 11- 4 min */
+	} b;
+	uint8_t w;
+} PCF2131_CLKOUT_CTL_REG;
+
+/*
+ ** CLKOUT_ctl - Bit field mask definitions
+ */
+#define  PCF2131_CLKOUT_TCR_MASK          ((uint8_t)0xC0)
+#define  PCF2131_CLKOUT_TCR_SHIFT         ((uint8_t)6)
+
+#define  PCF2131_CLKOUT_OTPR_MASK         ((uint8_t)0x20)
+#define  PCF2131_CLKOUT_OTPR_SHIFT        ((uint8_t)5)
+
+#define  PCF2131_CLKOUT_COF_MASK          ((uint8_t)0x07)
+#define  PCF2131_CLKOUT_COF_SHIFT         ((uint8_t)0)
+
+/*--------------------------------
+ ** Register: Watchdg_tim_ctl
+ ** Enum: PCF2131_WATCHDOG_TIMER_CTL.
+ ** --
+ ** Offset : 0x35 watchdog timer control register.
+ ** ------------------------------*/
+typedef union
+{
+	struct
+	{
+		uint8_t tf : 2;                /* watchdog timer source clock 00- 64 Hz 01- 4 Hz 10- 1/4 Hz 11- 1/64 Hz */
+		uint8_t _reserved_1 : 3;       /* Reserved Bit (Unused) */
+		uint8_t ti_tp : 1;             /* 0- interrupt pin follows the flags 1- interrupt pin generates a pulse */
+		uint8_t _reserved_2 : 1;       /* Reserved Bit (Unused) */
+		uint8_t wd_cd : 1;             /* 0- watchdog timer disabled 1- watchdog timer enabled */
+	} b;
+	uint8_t w;
+} PCF2131_WATCHDOG_CTL;
+
+/*
+ ** Watchdg_tim_ctl - Bit field mask definitions
+ */
+#define  PCF2131_WD_CTL_WD_CD_MASK        ((uint8_t)0x80)
+#define  PCF2131_WD_CTL_WD_CD_SHIFT       ((uint8_t)7)
+
 #define  PCF2131_WD_TI_TP_MASK            ((uint8_t)0x20)   /* Watchdog TI TP bit */
+#define  PCF2131_WD_TI_TP_SHIFT           ((uint8_t)5)
+
+#define  PCF2131_WD_CTL_TF_MASK           ((uint8_t)0x03)
+#define  PCF2131_WD_CTL_TF_SHIFT          ((uint8_t)0)
+
+#define  PCF2131_WD_SIZE_BYTE             (2)               /* Watchdg_tim_ctl and Watchdg_tim_val */
 
 #endif /* PCF2131_H_ */
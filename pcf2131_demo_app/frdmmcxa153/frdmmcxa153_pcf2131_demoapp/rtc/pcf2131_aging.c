@@ -0,0 +1,197 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file pcf2131_aging.c
+ * @brief The pcf2131_aging.c file implements drift estimation and aging offset trimming for the PCF2131 RTC.
+ */
+
+#include <string.h>
+#include "pcf2131_aging.h"
+
+//-----------------------------------------------------------------------
+// Global Variables
+//-----------------------------------------------------------------------
+/* Days before the start of each month (non leap year). */
+static const uint16_t pcf2131_daysBeforeMonth[12] = {0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334};
+
+//-----------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------
+
+int64_t PCF2131_TimeToMs(const pcf2131_timedata_t *time)
+{
+	uint32_t days;
+	uint32_t hours = time->hours;
+
+	days = (uint32_t)time->years * 365 + (time->years + 3) / 4;
+	/*! Months out of 1..12 wrap instead of indexing outside the table */
+	days += pcf2131_daysBeforeMonth[(time->months + 11) % 12];
+	if ((time->months > 2) && ((time->years % 4) == 0))
+	{
+		days += 1;
+	}
+	days += time->days - 1;
+
+	if (time->ampm != h24)
+	{
+		hours = (hours % 12) + ((time->ampm == PM) ? 12 : 0);
+	}
+
+	return ((((int64_t)days * 24 + hours) * 60 + time->minutes) * 60 + time->second) * 1000 +
+			(int64_t)time->second_100th * 10;
+}
+
+void PCF2131_Drift_Init(pcf2131_drift_t *pDrift, uint32_t windowSec, pcf2131_logfunction_t logFn)
+{
+	memset(pDrift, 0, sizeof(pcf2131_drift_t));
+	pDrift->windowSec = windowSec;
+	pDrift->log = logFn;
+}
+
+int32_t PCF2131_Drift_AddSample(pcf2131_drift_t *pDrift, int64_t ref_ms, const pcf2131_timedata_t *time)
+{
+	double x, y;
+	int64_t rtc_ms;
+
+	/*! Validate for the correct drift structure and time.*/
+	if ((pDrift == NULL) || (time == NULL))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	rtc_ms = PCF2131_TimeToMs(time);
+	if (pDrift->nSamples == 0)
+	{
+		pDrift->refStart_ms = ref_ms;
+		pDrift->rtcStart_ms = rtc_ms;
+	}
+	else if (ref_ms <= pDrift->refLast_ms)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+	pDrift->refLast_ms = ref_ms;
+
+	/*! x: elapsed reference time, y: RTC error accumulated since the first sample */
+	x = (double)(ref_ms - pDrift->refStart_ms);
+	y = (double)((rtc_ms - pDrift->rtcStart_ms) - (ref_ms - pDrift->refStart_ms));
+	pDrift->sx += x;
+	pDrift->sy += y;
+	pDrift->sxx += x * x;
+	pDrift->sxy += x * y;
+	pDrift->nSamples++;
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_Drift_Estimate(pcf2131_drift_t *pDrift, int32_t *pDrift_ppb)
+{
+	double n, denom, slope;
+
+	/*! Validate for the correct drift structure and drift read variable.*/
+	if ((pDrift == NULL) || (pDrift_ppb == NULL) || (pDrift->nSamples < PCF2131_DRIFT_MIN_SAMPLES))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	n = (double)pDrift->nSamples;
+	denom = n * pDrift->sxx - pDrift->sx * pDrift->sx;
+	if (denom <= 0)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! slope of RTC error (ms) per reference ms, scaled to ppb and rounded */
+	slope = (n * pDrift->sxy - pDrift->sx * pDrift->sy) / denom;
+	slope *= 1e9;
+	*pDrift_ppb = (int32_t)((slope >= 0) ? (slope + 0.5) : (slope - 0.5));
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_Drift_Commit(pcf2131_sensorhandle_t *pSensorHandle, pcf2131_drift_t *pDrift, uint8_t *pCode)
+{
+	int32_t status;
+	int32_t drift_ppb, residual_ppb, best_ppb;
+	int32_t code, bestCode;
+	uint8_t curCode;
+
+	/*! Validate for the correct handle, drift structure and code read variable.*/
+	if ((pSensorHandle == NULL) || (pDrift == NULL) || (pCode == NULL))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Refuse to trim until the reference span covers the window */
+	if ((pDrift->refLast_ms - pDrift->refStart_ms) < (int64_t)pDrift->windowSec * 1000)
+	{
+		if (pDrift->log)
+		{
+			pDrift->log("\r\n AGING: window not complete (%d of %d s), no trim\r\n",
+					(int32_t)((pDrift->refLast_ms - pDrift->refStart_ms) / 1000), pDrift->windowSec);
+		}
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	status = PCF2131_Drift_Estimate(pDrift, &drift_ppb);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		if (pDrift->log)
+		{
+			pDrift->log("\r\n AGING: %d samples, fit not possible, no trim\r\n", pDrift->nSamples);
+		}
+		return status;
+	}
+
+	status = PCF2131_AgingOffset_Get(pSensorHandle, &curCode);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
+
+	/*! The measured drift already includes the current code, each code step above it slows the RTC
+	 *  by PCF2131_AGING_PPM_PER_STEP. Pick the code with the smallest residual. */
+	bestCode = curCode;
+	best_ppb = drift_ppb;
+	for (code = 0; code <= PCF2131_AGING_OFFSET_MAX; code++)
+	{
+		residual_ppb = drift_ppb - (code - (int32_t)curCode) * PCF2131_AGING_PPM_PER_STEP * 1000;
+		if (((residual_ppb < 0) ? -residual_ppb : residual_ppb) < ((best_ppb < 0) ? -best_ppb : best_ppb))
+		{
+			best_ppb = residual_ppb;
+			bestCode = code;
+		}
+	}
+
+	if (pDrift->log)
+	{
+		pDrift->log("\r\n AGING: %d samples over %d s, drift %d ppb, code %d -> %d, residual %d ppb\r\n",
+				pDrift->nSamples, (int32_t)((pDrift->refLast_ms - pDrift->refStart_ms) / 1000),
+				drift_ppb, curCode, bestCode, best_ppb);
+	}
+
+	/*! Single write only when the code changes */
+	if (bestCode != curCode)
+	{
+		status = PCF2131_AgingOffset_Set(pSensorHandle, (uint8_t)bestCode);
+		if (SENSOR_ERROR_NONE != status)
+		{
+			if (pDrift->log)
+			{
+				pDrift->log("\r\n AGING: write of code %d failed\r\n", bestCode);
+			}
+			return status;
+		}
+	}
+	else if (pDrift->log)
+	{
+		pDrift->log("\r\n AGING: current code is best, no write\r\n");
+	}
+
+	*pCode = (uint8_t)bestCode;
+
+	return SENSOR_ERROR_NONE;
+}
@@ -25,6 +25,7 @@
 #include "sensor_io_spi.h"
 #include "register_io_spi.h"
 #endif
+#include "bus_arbiter.h"
 
 /*--------------------------------
  ** Enum: IntMask
@@ -187,6 +188,34 @@ typedef enum INTSRC
 	IntB = 0x01,           /* Interrupt from INTB */
 }IntSrc;
 
+/*--------------------------------
+ ** Enum: WdClkSrc
+ ** @brief Watchdog timer source clock
+ ** ------------------------------*/
+typedef enum WDCLKSRC
+{
+	wdClk64Hz = 0x00,       /* Watchdog counts at 64 Hz */
+	wdClk4Hz = 0x01,        /* Watchdog counts at 4 Hz */
+	wdClk1_4Hz = 0x02,      /* Watchdog counts at 1/4 Hz */
+	wdClk1_64Hz = 0x03,     /* Watchdog counts at 1/64 Hz */
+}WdClkSrc;
+
+/*--------------------------------
+ ** Enum: ClkOutFreq
+ ** @brief CLKOUT frequency selection
+ ** ------------------------------*/
+typedef enum CLKOUTFREQ
+{
+	clkout32768Hz = 0x00,   /* CLKOUT 32768 Hz */
+	clkout16384Hz = 0x01,   /* CLKOUT 16384 Hz */
+	clkout8192Hz = 0x02,    /* CLKOUT 8192 Hz */
+	clkout4096Hz = 0x03,    /* CLKOUT 4096 Hz */
+	clkout2048Hz = 0x04,    /* CLKOUT 2048 Hz */
+	clkout1024Hz = 0x05,    /* CLKOUT 1024 Hz */
+	clkout1Hz = 0x06,       /* CLKOUT 1 Hz */
+	clkoutDisable = 0x07,   /* CLKOUT disabled (high-Z) */
+}ClkOutFreq;
+
 /*--------------------------------
  ** Enum: WeekDays
  ** @brief store Weekday
@@ -275,6 +304,18 @@ typedef struct
  *  @brief  The MAX size of SPI message. */
 #define PCF2131_SPI_MAX_MSG_SIZE (64)
 
+/*! @def    PCF2131_BUF_HEADROOM
+ *  @brief  Bytes reserved in front of the payload of PCF2131_ReadInPlace()/PCF2131_WriteInPlace() buffers. */
+#define PCF2131_BUF_HEADROOM    (1)
+
+/*! @def    PCF2131_REG_MAP_SIZE
+ *  @brief  Number of PCF2131 registers (Control_1 to WD_Val). */
+#define PCF2131_REG_MAP_SIZE    (PCF2131_WATCHDOG_TIMER_VAL + 1)
+
+/*! @def    PCF2131_CTRL_TIME_SIZE_BYTE
+ *  @brief  Control_1 to Years, the time block together with the 12/24 hour mode. */
+#define PCF2131_CTRL_TIME_SIZE_BYTE    (PCF2131_YEAR + 1)
+
 /*! @def    PCF2131_SPI_CMD_LEN
  *  @brief  The size of the Sensor specific SPI Header. */
 #define PCF2131_SPI_CMD_LEN (1)
@@ -295,6 +336,47 @@ typedef struct
  *  @brief  Generate a pulsed signal on INTA/B when MSF flag is set. */
 #define PCF2131_WD_TS_TP        (0x20)
 
+/*! @def    PCF2131_CLKOUT_CAL_FREQ
+ *  @brief  CLKOUT frequency (Hz) used while calibrating the MCU core clock. */
+#define PCF2131_CLKOUT_CAL_FREQ        (1024)
+
+/*! @def    PCF2131_CLKOUT_CAL_MAX_EDGES
+ *  @brief  Maximum CLKOUT periods per calibration (8 s), keeps the SysTick count within 31 bits at 150 MHz. */
+#define PCF2131_CLKOUT_CAL_MAX_EDGES   (8192)
+
+/*! @def    PCF2131_EXT_TEST_EDGES_PER_SECOND
+ *  @brief  Rising edges on CLKOUT per second increment in external clock test mode. */
+#define PCF2131_EXT_TEST_EDGES_PER_SECOND   (64)
+
+/*! @def    PCF2131_EXT_TEST_MAX_MULTIPLE
+ *  @brief  Maximum acceleration in external clock test mode, keeps the CLKOUT pulses above 300 ns. */
+#define PCF2131_EXT_TEST_MAX_MULTIPLE       (26000)
+
+/*! @def    PCF2131_BUS_TIMEOUT_US
+ *  @brief  Default deadline (us) for one bus transfer, covers a full 128 byte block at 100 kHz I2C. */
+#define PCF2131_BUS_TIMEOUT_US         (20000)
+
+/*! @def    PCF2131_I2C_SPEED_COUNT
+ *  @brief  Number of I2C bus speeds probed by PCF2131_I2C_Negotiate() (Standard, Fast, Fast-mode Plus). */
+#define PCF2131_I2C_SPEED_COUNT        (3)
+
+/*! @def    PCF2131_I2C_FALLBACK_ERRORS
+ *  @brief  Bus errors at the negotiated I2C speed before stepping down to the next lower speed. */
+#define PCF2131_I2C_FALLBACK_ERRORS    (3)
+
+/*! @def    PCF2131_I2C_DECAY_CLEAN
+ *  @brief  Clean transfers that forgive one counted bus error, so isolated errors never add up to a fallback. */
+#define PCF2131_I2C_DECAY_CLEAN        (64)
+
+/*! @def    PCF2131_I2C_STEPUP_CLEAN
+ *  @brief  Clean transfers after a fallback before probing the next faster speed that was stable at negotiation. */
+#define PCF2131_I2C_STEPUP_CLEAN       (4096)
+
+/*! @def    PCF2131_BUS_STATUS
+ *  @brief  Maps a failed bus transfer to the API status, a missed deadline is reported as SENSOR_ERROR_TIMEOUT. */
+#define PCF2131_BUS_STATUS(status, error) \
+	(((ARM_DRIVER_ERROR_TIMEOUT == (status)) || (SENSOR_ERROR_TIMEOUT == (status))) ? SENSOR_ERROR_TIMEOUT : (error))
+
 /*! @def    PCF2131_SPI_WR_CMD
  *  @brief  write command of PCF2131 SENSOR */
 #define PCF2131_SPI_WR_CMD        (0x7F)
@@ -308,6 +390,47 @@ typedef struct
  * Definitions
  ******************************************************************************/
 
+/*! @brief printf compatible function used to log driver decisions (e.g. DbgConsole_AsyncPrintf).*/
+typedef int (*pcf2131_logfunction_t)(const char *fmt_s, ...);
+
+/*! @brief Timer output clocking CLKOUT in external clock test mode instead of a GPIO pin, see
+ *         PCF2131_ExtTest_Enable() (e.g. the CTIMER match output of ctimer_utils.h).*/
+typedef struct
+{
+	void (*start)(void);                             /*!< Drives the output low.*/
+	int32_t (*clock)(uint32_t freq, uint32_t edges); /*!< Clocks edges rising edges at freq Hz and returns once they
+	                                                      are out: 0, -1 if freq cannot be produced, -2 if edges
+	                                                      may have been lost.*/
+	void (*stop)(void);                              /*!< Stops and releases the output.*/
+} pcf2131_extclk_t;
+
+/*! @brief The operations run by PCF2131_Poll().*/
+typedef enum
+{
+	PCF2131_OP_NONE = 0,
+	PCF2131_OP_SET_TIME,
+	PCF2131_OP_GET_TIME,
+	PCF2131_OP_CONFIGURE,
+	PCF2131_OP_SNAPSHOT,
+} pcf2131_op_t;
+
+/*! @brief This structure holds the state of the polled operation of a handle.*/
+typedef struct
+{
+	pcf2131_op_t op;                   /*!< Operation in progress, PCF2131_OP_NONE when idle.*/
+	uint8_t step;                      /*!< Next step of the operation.*/
+	bool busy;                         /*!< A transfer of the operation is on the bus.*/
+	int32_t error;                     /*!< Status reported if the transfer on the bus fails.*/
+	const registerwritelist_t *pList;  /*!< Next register write of a configure operation.*/
+	registerwritelist_t list[3];       /*!< Register writes of an interrupt enable operation.*/
+	pcf2131_timedata_t *pTime;         /*!< Time read by a get time operation.*/
+	uint8_t *pBuffer;                  /*!< Snapshot buffer, PCF2131_BUF_HEADROOM in front of the registers.*/
+	uint8_t value[PCF2131_TIME_SIZE_BYTE];  /*!< Encoded time of a set time operation.*/
+	uint8_t buf[PCF2131_BUF_HEADROOM + PCF2131_CTRL_TIME_SIZE_BYTE];  /*!< Transfer buffer.*/
+	uint32_t polls;                    /*!< PCF2131_Poll() calls of the operation.*/
+	uint32_t maxPoll_us;               /*!< Longest PCF2131_Poll() call of the operation.*/
+} pcf2131_poll_t;
+
 /*!
  * @brief This defines the sensor specific information for SPI.
  */
@@ -322,17 +445,44 @@ typedef struct
 	bool isInitialized;                   /*!< Whether sensor is intialized or not.*/
 #if (I2C_ENABLE)
 	uint16_t slaveAddress;           /*!< slave address.*/
+	uint8_t busSpeed;                /*!< Negotiated ARM_I2C_BUS_SPEED_x, 0 before PCF2131_I2C_Negotiate().*/
+	uint8_t busErrors;               /*!< Counted bus errors, decays on clean transfers.*/
+	uint16_t busClean;               /*!< Clean transfers since the last bus error or speed change.*/
+	uint32_t busSpeedTime_us[PCF2131_I2C_SPEED_COUNT]; /*!< Time block read time per speed, 0 if not stable.*/
 #else
 	spiSlaveSpecificParams_t slaveParams; /*!< Slave Specific Params.*/
 #endif
+	uint8_t wdCtl;                        /*!< Pre-formatted Watchdg_tim_ctl value (WD_CD excluded).*/
+	uint8_t wdKickValue;                  /*!< Pre-formatted Watchdg_tim_val value written on every kick.*/
+	bool wdPiggyback;                     /*!< Kick the watchdog after every burst read/configure transfer.*/
+	bool inTransaction;                   /*!< Register writes are recorded until PCF2131_Commit().*/
+	uint8_t txnValue[PCF2131_REG_MAP_SIZE];  /*!< Pending register values of the open transaction.*/
+	uint8_t txnMask[PCF2131_REG_MAP_SIZE];   /*!< Dirty bits of the open transaction, 0 for a clean register.*/
+	pcf2131_poll_t poll;                  /*!< Polled operation, see pcf2131_poll.h.*/
+	void *pExtClkPin;                     /*!< GPIO pin driving CLKOUT in external clock test mode, NULL otherwise.*/
+	const pcf2131_extclk_t *pExtClock;    /*!< Timer output driving CLKOUT in external clock test mode, NULL otherwise.*/
 }  pcf2131_sensorhandle_t;
 
 /*******************************************************************************
  * APIs
  ******************************************************************************/
 
+/*! @brief       Converts a decimal value to BCD.
+ *  @param[in]   val  			Decimal value, 0 to 99.
+ *  @reentrant   Yes
+ *  @return      ::DecimaltoBcd() returns the BCD value.
+ */
+uint8_t DecimaltoBcd(uint8_t val);
+
+/*! @brief       Converts a BCD value to decimal.
+ *  @param[in]   val  			BCD value.
+ *  @reentrant   Yes
+ *  @return      ::BcdToDecimal() returns the decimal value.
+ */
+uint8_t BcdToDecimal(uint8_t val);
+
 /*! @brief       Preprocesses a read command for the PCF2131 RTC.
- *  @details     Prepares a read command to be sent to the RTC.
+ *  @details     Formats the read command into the caller supplied pCmdOut->pWriteBuffer.
  *  @param[in]   pCmdOut  		Pointer to the command output buffer.
  *  @param[in]   offset   		Offset for the read command.
  *  @param[in]   size     		Size of the read command.
@@ -343,7 +493,8 @@ typedef struct
 void PCF2131_ReadPreprocess(void *pCmdOut, uint32_t offset, uint32_t size);
 
 /*! @brief       Preprocesses a write command for the PCF2131 RTC.
- *  @details     Prepares a write command to be sent to the RTC.
+ *  @details     Formats the write command into the caller supplied pCmdOut->pWriteBuffer, followed by
+ *               the data (not copied when it is already in place).
  *  @param[in]   pCmdOut  		Pointer to the command output buffer.
  *  @param[in]   offset  		Offset for the write command.
  *  @param[in]   size     		Size of the write command.
@@ -381,6 +532,56 @@ int32_t PCF2131_Initialize(pcf2131_sensorhandle_t *pSensorHandle, ARM_DRIVER_SPI
  */
 void PCF2131_SetIdleTask(pcf2131_sensorhandle_t *pSensorHandle, registeridlefunction_t idleTask, void *userParam);
 
+/*! @brief       Sets the bus transfer deadline for the PCF2131 RTC.
+ *  @details     A transfer that does not complete within the deadline is aborted and the API returns
+ *               SENSOR_ERROR_TIMEOUT. PCF2131_Initialize() sets PCF2131_BUS_TIMEOUT_US. Size the deadline
+ *               with the latency percentiles from Register_SPI_GetLatency_us()/Register_I2C_GetLatency_us().
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @param[in]   timeout_us  		Transfer deadline in micro seconds, 0 waits forever.
+ *  @constraints This can be called any number of times only after PCF2131_Initialize().
+ *				 The deadline is only enforced while the SysTick is enabled (BOARD_SystickEnable()).
+ *  @reentrant   No
+ */
+void PCF2131_SetTimeout(pcf2131_sensorhandle_t *pSensorHandle, uint32_t timeout_us);
+
+/*! @brief       Attaches the PCF2131 RTC to a shared bus arbiter.
+ *  @details     Every register transfer of the RTC then acquires the bus through the arbiter, switching to the
+ *               bus speed of pDevice. PCF2131_Initialize() detaches the RTC (it owns its bus).
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @param[in]   pDevice  			Pointer to arbitrated device of the RTC, NULL to detach.
+ *  @constraints This can be called any number of times only after PCF2131_Initialize().
+ *  @reentrant   No
+ */
+void PCF2131_SetArbiter(pcf2131_sensorhandle_t *pSensorHandle, busArbiterDevice_t *pDevice);
+
+/*! @brief       Changes the bus speed of the PCF2131 link.
+ *  @details     Goes through the arbiter when one is attached, so the speed sticks to the RTC and is
+ *               restored whenever it gets the bus back from another device.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @param[in]   busSpeed  			SPI baud rate, or ARM_I2C_BUS_SPEED_x value for I2C.
+ *  @constraints This can be called any number of times only after PCF2131_Initialize().
+ *  @reentrant   No
+ *  @return      ::PCF2131_SetBusSpeed() returns the status.
+ */
+int32_t PCF2131_SetBusSpeed(pcf2131_sensorhandle_t *pSensorHandle, uint32_t busSpeed);
+
+/*! @brief       Gets the bus traffic counters of the PCF2131 link.
+ *  @details     Transfers and bytes since the last PCF2131_ClearBusCount(), see registerIoCount_t.
+ *               Other devices on the same bus instance are counted too.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @param[out]  pCount  			Pointer to counters.
+ *  @constraints This can be called any number of times only after PCF2131_Initialize().
+ *  @reentrant   No
+ */
+void PCF2131_GetBusCount(pcf2131_sensorhandle_t *pSensorHandle, registerIoCount_t *pCount);
+
+/*! @brief       Clears the bus traffic counters of the PCF2131 link.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @constraints This can be called any number of times only after PCF2131_Initialize().
+ *  @reentrant   No
+ */
+void PCF2131_ClearBusCount(pcf2131_sensorhandle_t *pSensorHandle);
+
 /*! @brief       Configures the PCF2131 RTC.
  *  @details     Initializes the PCF2131 sensor and its handle.
  *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
@@ -392,6 +593,105 @@ void PCF2131_SetIdleTask(pcf2131_sensorhandle_t *pSensorHandle, registeridlefunc
  */
 int32_t PCF2131_Configure(pcf2131_sensorhandle_t *pSensorHandle, const registerwritelist_t *pRegWriteList);
 
+/*! @brief       Reads PCF2131 registers in place.
+ *  @details     The transfer runs directly in and out of the caller buffer, without driver side copy or
+ *               static buffers. Use it for long snapshot reads.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @param[in]   offset  			First register to read.
+ *  @param[in]   length  			Number of registers to read.
+ *  @param[out]  pBuffer  			Buffer of PCF2131_BUF_HEADROOM + length bytes, the register values are
+ *  								returned at pBuffer + PCF2131_BUF_HEADROOM. The headroom is not preserved.
+ *  @constraints This can be called any number of times only after PCF2131_Initialize().
+ *				 The buffer is owned by the driver (CPU or DMA) until the call returns and must not be
+ *				 accessed from another context meanwhile.
+ *  @reentrant   No
+ *  @return      ::PCF2131_ReadInPlace() returns the status.
+ */
+int32_t PCF2131_ReadInPlace(pcf2131_sensorhandle_t *pSensorHandle, uint8_t offset, uint8_t length, uint8_t *pBuffer);
+
+/*! @brief       Writes PCF2131 registers in place.
+ *  @details     The command is formatted into the headroom and the caller buffer is sent as is.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @param[in]   offset  			First register to write.
+ *  @param[in]   length  			Number of registers to write.
+ *  @param[in]   pBuffer  			Buffer of PCF2131_BUF_HEADROOM bytes followed by the register values.
+ *  @constraints This can be called any number of times only after PCF2131_Initialize().
+ *				 The buffer ownership rules of PCF2131_ReadInPlace() apply.
+ *  @reentrant   No
+ *  @return      ::PCF2131_WriteInPlace() returns the status.
+ */
+int32_t PCF2131_WriteInPlace(pcf2131_sensorhandle_t *pSensorHandle, uint8_t offset, uint8_t length, uint8_t *pBuffer);
+
+/*! @brief       Starts reading PCF2131 registers in place, without waiting.
+ *  @details     The building block of the polled operations, see PCF2131_ReadInPlace() for the buffer layout.
+ *               The bus is held until PCF2131_PollTransfer() reports the end of the transfer.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @param[in]   offset  			First register address.
+ *  @param[in]   length  			Number of registers.
+ *  @param[out]  pBuffer  			Buffer of PCF2131_BUF_HEADROOM + length bytes, valid until the transfer ends.
+ *  @constraints This can be called only after PCF2131_Initialize(), with no other transfer of the handle running.
+ *  @reentrant   No
+ *  @return      ::PCF2131_StartReadInPlace() returns the status, SENSOR_ERROR_BUSY if the shared bus is taken.
+ */
+int32_t PCF2131_StartReadInPlace(pcf2131_sensorhandle_t *pSensorHandle, uint8_t offset, uint8_t length, uint8_t *pBuffer);
+
+/*! @brief       Starts writing PCF2131 registers in place, without waiting.
+ *  @details     The building block of the polled operations, see PCF2131_WriteInPlace() for the buffer layout.
+ *               The bus is held until PCF2131_PollTransfer() reports the end of the transfer.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @param[in]   offset  			First register address.
+ *  @param[in]   length  			Number of registers.
+ *  @param[in]   pBuffer  			Buffer of PCF2131_BUF_HEADROOM bytes followed by the register values,
+ *  								valid until the transfer ends.
+ *  @constraints This can be called only after PCF2131_Initialize(), with no other transfer of the handle running.
+ *  @reentrant   No
+ *  @return      ::PCF2131_StartWriteInPlace() returns the status, SENSOR_ERROR_BUSY if the shared bus is taken.
+ */
+int32_t PCF2131_StartWriteInPlace(pcf2131_sensorhandle_t *pSensorHandle, uint8_t offset, uint8_t length, uint8_t *pBuffer);
+
+/*! @brief       Polls the transfer started by PCF2131_StartReadInPlace()/PCF2131_StartWriteInPlace().
+ *  @details     Never waits, a transfer past its deadline is aborted.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @constraints A transfer must have been started.
+ *  @reentrant   No
+ *  @return      ::PCF2131_PollTransfer() returns SENSOR_ERROR_BUSY while the transfer runs, else its status.
+ */
+int32_t PCF2131_PollTransfer(pcf2131_sensorhandle_t *pSensorHandle);
+
+/*! @brief       Opens a register transaction.
+ *  @details     Until PCF2131_Commit(), the register writes of the setter APIs are recorded as value/mask
+ *               pairs in the handle dirty set instead of going to the bus. Reads, PCF2131_Configure(),
+ *               PCF2131_Watchdog_Kick() and PCF2131_Deinit() still access the bus directly, so getters
+ *               return the chip state and not the pending values.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @constraints This can be called any number of times only after PCF2131_Initialize().
+ *				 Application has to ensure that previous instances of these APIs have exited before invocation
+ *  @reentrant   No
+ *  @return      ::PCF2131_Begin() returns the status.
+ */
+int32_t PCF2131_Begin(pcf2131_sensorhandle_t *pSensorHandle);
+
+/*! @brief       Commits the open register transaction.
+ *  @details     Reads once every contiguous dirty range that holds a partially written register, merges
+ *               the pending bits and writes each range back in a single burst. Nothing is written if a
+ *               read fails. The transaction is closed whatever the outcome.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @constraints PCF2131_Begin() must be called first.
+ *				 Application has to ensure that previous instances of these APIs have exited before invocation
+ *  @reentrant   No
+ *  @return      ::PCF2131_Commit() returns the status.
+ */
+int32_t PCF2131_Commit(pcf2131_sensorhandle_t *pSensorHandle);
+
+/*! @brief       Discards the open register transaction.
+ *  @details     The pending writes are dropped, the chip is not accessed.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @constraints This can be called any number of times only after PCF2131_Initialize().
+ *  @reentrant   No
+ *  @return      ::PCF2131_Abort() returns the status.
+ */
+int32_t PCF2131_Abort(pcf2131_sensorhandle_t *pSensorHandle);
+
 /*! @brief       De-initializes the PCF2131 RTC.
  *  @details     De-initializes the PCF2131 sensor and its handle.
  *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
@@ -813,4 +1113,195 @@ int32_t PCF2131_Check_LowBatStatus(pcf2131_sensorhandle_t *pSensorHandle, IntSta
  *  @return      ::PCF2131_LowBatInt() returns the status.
  */
 int32_t PCF2131_LowBatInt(pcf2131_sensorhandle_t *pSensorHandle, LowBatInt is_enabled);
+
+//Watchdog Timer
+
+/*! @brief       Configures the watchdog timer of PCF2131 RTC.
+ *  @details     Writes the source clock to Watchdg_tim_ctl (watchdog left disabled) and stores the period
+ *               that every kick reloads. The interrupt mode bit TI_TP, shared with the minute/second
+ *               interrupt, keeps the value read from the RTC.
+ *               Timeout = period / source clock frequency.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @param[in]   clksrc      		Watchdog timer source clock.
+ *  @param[in]   period      		Watchdog timer period in source clock cycles (1 to 255).
+ *  @constraints This can be called any number of times only after PCF2131_Initialize().
+ *				 Application has to ensure that previous instances of these APIs have exited before invocation
+ *  @reentrant   No
+ *  @return      ::PCF2131_Watchdog_Config() returns the status.
+ */
+int32_t PCF2131_Watchdog_Config(pcf2131_sensorhandle_t *pSensorHandle, WdClkSrc clksrc, uint8_t period);
+
+/*! @brief       Enables the watchdog timer of PCF2131 RTC.
+ *  @details     Sets WD_CD and loads the period in one two-byte burst (Watchdg_tim_ctl, Watchdg_tim_val).
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @constraints This can be called any number of times only after PCF2131_Watchdog_Config().
+ *				 Application has to ensure that previous instances of these APIs have exited before invocation
+ *  @reentrant   No
+ *  @return      ::PCF2131_Watchdog_Enable() returns the status.
+ */
+int32_t PCF2131_Watchdog_Enable(pcf2131_sensorhandle_t *pSensorHandle);
+
+/*! @brief       Disables the watchdog timer of PCF2131 RTC.
+ *  @details     Clears WD_CD with a single write of the pre-formatted Watchdg_tim_ctl value.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @constraints This can be called any number of times only after PCF2131_Initialize().
+ *				 Application has to ensure that previous instances of these APIs have exited before invocation
+ *  @reentrant   No
+ *  @return      ::PCF2131_Watchdog_Disable() returns the status.
+ */
+int32_t PCF2131_Watchdog_Disable(pcf2131_sensorhandle_t *pSensorHandle);
+
+/*! @brief       Kicks the watchdog timer of PCF2131 RTC.
+ *  @details     Reloads Watchdg_tim_val with the pre-formatted period. This is a single
+ *               register write without read-modify-write; it also clears WDTF.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @constraints This can be called any number of times only after PCF2131_Watchdog_Config().
+ *				 Application has to ensure that previous instances of these APIs have exited before invocation
+ *  @reentrant   No
+ *  @return      ::PCF2131_Watchdog_Kick() returns the status.
+ */
+int32_t PCF2131_Watchdog_Kick(pcf2131_sensorhandle_t *pSensorHandle);
+
+/*! @brief       Enables/Disables watchdog kick piggybacking for PCF2131 RTC.
+ *  @details     When enabled, the kick write is issued right after every PCF2131_ReadData()
+ *               and PCF2131_Configure() transfer, so periodic time reads keep the watchdog alive
+ *               without a separate kick from the application.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @param[in]   is_enabled      	true to piggyback the kick, false to kick only explicitly.
+ *  @constraints This can be called any number of times only after PCF2131_Watchdog_Config().
+ *				 Application has to ensure that previous instances of these APIs have exited before invocation
+ *  @reentrant   No
+ *  @return      ::PCF2131_Watchdog_Piggyback() returns the status.
+ */
+int32_t PCF2131_Watchdog_Piggyback(pcf2131_sensorhandle_t *pSensorHandle, bool is_enabled);
+
+/*! @brief       Enables watchdog interrupt for PCF2131 RTC.
+ *  @details     Routes the watchdog timer interrupt (WDTF) to INTA or INTB.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @param[in]   intsrc  			Source of the interrupt to be enabled.
+ *  @constraints This can be called any number of times only after PCF2131_Initialize().
+ *				 Application has to ensure that previous instances of these APIs have exited before invocation
+ *  @reentrant   No
+ *  @return      ::PCF2131_WatchdogInt_Enable() returns the status.
+ */
+int32_t PCF2131_WatchdogInt_Enable(pcf2131_sensorhandle_t *pSensorHandle, IntSrc intsrc);
+
+/*! @brief       Disables watchdog interrupt for PCF2131 RTC.
+ *  @details     Masks the watchdog timer interrupt on both INTA and INTB.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @constraints This can be called any number of times only after PCF2131_Initialize().
+ *				 Application has to ensure that previous instances of these APIs have exited before invocation
+ *  @reentrant   No
+ *  @return      ::PCF2131_WatchdogInt_Disable() returns the status.
+ */
+int32_t PCF2131_WatchdogInt_Disable(pcf2131_sensorhandle_t *pSensorHandle);
+
+/*! @brief       Checks watchdog interrupt for PCF2131 RTC.
+ *  @details     Reads WDTF from Control_2. WDTF is read-only and is cleared by PCF2131_Watchdog_Kick().
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @param[in]   pWdState      		Watchdog Interrupt State.
+ *  @constraints This can be called any number of times only after PCF2131_Initialize().
+ *				 Application has to ensure that previous instances of these APIs have exited before invocation
+ *  @reentrant   No
+ *  @return      ::PCF2131_Check_WatchdogInt() returns the status.
+ */
+int32_t PCF2131_Check_WatchdogInt(pcf2131_sensorhandle_t *pSensorHandle, IntState *pWdState);
+
+//CLKOUT
+
+/*! @brief       Selects the CLKOUT frequency of PCF2131 RTC.
+ *  @details     Selects the temperature compensated CLKOUT frequency or disables the output.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @param[in]   freq      			CLKOUT frequency, clkoutDisable puts CLKOUT in high-Z.
+ *  @constraints This can be called any number of times only after PCF2131_Initialize().
+ *				 Application has to ensure that previous instances of these APIs have exited before invocation
+ *  @reentrant   No
+ *  @return      ::PCF2131_ClkOut_Set() returns the status.
+ */
+int32_t PCF2131_ClkOut_Set(pcf2131_sensorhandle_t *pSensorHandle, ClkOutFreq freq);
+
+/*! @brief       Calibrates the MCU core clock against PCF2131 CLKOUT.
+ *  @details     Switches CLKOUT to PCF2131_CLKOUT_CAL_FREQ, captures the SysTick count over the
+ *               requested number of CLKOUT periods on a GPIO input and restores CLKOUT_ctl.
+ *               The core clock error is applied with BOARD_SystickSetClockCorrection(), so
+ *               BOARD_SystickElapsedTime_us() and BOARD_DELAY_ms() use the corrected frequency.
+ *               CLKOUT_ctl is written directly, also inside an open transaction.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @param[in]   pClkOutPin      	Pointer to the GPIO pin wired to CLKOUT.
+ *  @param[in]   periods      		Number of CLKOUT periods to measure (1 to PCF2131_CLKOUT_CAL_MAX_EDGES).
+ *  @param[out]  pPpmError      	Core clock error in ppm (positive when the MCU clock runs fast).
+ *  @constraints This can be called any number of times only after PCF2131_Initialize() and BOARD_SystickEnable().
+ *				 Interrupt latency during the measurement adds to the capture error.
+ *  @reentrant   No
+ *  @return      ::PCF2131_ClkOut_Calibrate() returns the status.
+ */
+int32_t PCF2131_ClkOut_Calibrate(pcf2131_sensorhandle_t *pSensorHandle, void *pClkOutPin, uint32_t periods, int32_t *pPpmError);
+
+//External Clock Test Mode
+
+/*! @brief       Enters the external clock test mode of PCF2131 RTC.
+ *  @details     Sets EXT_TEST in Control_1, which turns CLKOUT into the clock input of the prescaler,
+ *               then drives the timer output or GPIO pin wired to CLKOUT low. The RTC only counts the
+ *               edges clocked by PCF2131_ExtTest_Clock() until PCF2131_ExtTest_Disable().
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @param[in]   pClkPin      		Pointer to the GPIO pin wired to CLKOUT, used when pClock is NULL.
+ *  @param[in]   pClock      		Timer output wired to CLKOUT, NULL to toggle pClkPin from the CPU.
+ *  @constraints This can be called any number of times only after PCF2131_Initialize().
+ *				 Application has to ensure that previous instances of these APIs have exited before invocation
+ *  @reentrant   No
+ *  @return      ::PCF2131_ExtTest_Enable() returns the status.
+ */
+int32_t PCF2131_ExtTest_Enable(pcf2131_sensorhandle_t *pSensorHandle, void *pClkPin, const pcf2131_extclk_t *pClock);
+
+/*! @brief       Advances PCF2131 RTC in external clock test mode.
+ *  @details     Clocks PCF2131_EXT_TEST_EDGES_PER_SECOND rising edges per RTC second on CLKOUT at the
+ *               requested multiple of real time, so a minute alarm fires after 60 / multiple seconds.
+ *               A timer output produces the rate in hardware and fails when it cannot produce it or
+ *               may have lost edges. A GPIO pin is paced with the SysTick and falls behind when the
+ *               toggling cannot keep up. The achieved multiple is measured over the whole run.
+ *               From a stop condition the first second increments after half the edges of a second.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @param[in]   seconds      		RTC seconds to advance (1 to UINT32_MAX / PCF2131_EXT_TEST_EDGES_PER_SECOND).
+ *  @param[in]   multiple      		Target acceleration (1 to PCF2131_EXT_TEST_MAX_MULTIPLE).
+ *  @param[out]  pAchieved      	Achieved acceleration, NULL if not needed.
+ *  @constraints This can be called any number of times only after PCF2131_ExtTest_Enable() and BOARD_SystickEnable().
+ *  @reentrant   No
+ *  @return      ::PCF2131_ExtTest_Clock() returns the status.
+ */
+int32_t PCF2131_ExtTest_Clock(pcf2131_sensorhandle_t *pSensorHandle, uint32_t seconds, uint32_t multiple, uint32_t *pAchieved);
+
+/*! @brief       Leaves the external clock test mode of PCF2131 RTC.
+ *  @details     Releases the timer output or GPIO pin wired to CLKOUT and clears EXT_TEST in Control_1,
+ *               the RTC counts from its own oscillator again.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @constraints This can be called any number of times only after PCF2131_Initialize().
+ *				 Application has to ensure that previous instances of these APIs have exited before invocation
+ *  @reentrant   No
+ *  @return      ::PCF2131_ExtTest_Disable() returns the status.
+ */
+int32_t PCF2131_ExtTest_Disable(pcf2131_sensorhandle_t *pSensorHandle);
+
+//Aging Offset
+
+/*! @brief       Sets the aging offset of PCF2131 RTC.
+ *  @details     Writes AO[3:0] with a single write (the upper bits of Aging_offset are unused).
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @param[in]   code      			Aging offset code, PCF2131_AGING_OFFSET_ZERO is 0 ppm.
+ *  @constraints This can be called any number of times only after PCF2131_Initialize().
+ *				 Application has to ensure that previous instances of these APIs have exited before invocation
+ *  @reentrant   No
+ *  @return      ::PCF2131_AgingOffset_Set() returns the status.
+ */
+int32_t PCF2131_AgingOffset_Set(pcf2131_sensorhandle_t *pSensorHandle, uint8_t code);
+
+/*! @brief       Gets the aging offset of PCF2131 RTC.
+ *  @details     Reads AO[3:0] from Aging_offset.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @param[out]  pCode      		Aging offset code.
+ *  @constraints This can be called any number of times only after PCF2131_Initialize().
+ *				 Application has to ensure that previous instances of these APIs have exited before invocation
+ *  @reentrant   No
+ *  @return      ::PCF2131_AgingOffset_Get() returns the status.
+ */
+int32_t PCF2131_AgingOffset_Get(pcf2131_sensorhandle_t *pSensorHandle, uint8_t *pCode);
 #endif /* PCF2131_DRV_H_ */
@@ -38,6 +38,103 @@ uint8_t BcdToDecimal(uint8_t val)
 	return (((val) >> 4) * 10 + ((val) & 0x0f)) ;
 }
 
+/*! Maps a failed bus transfer to the API status, stepping the negotiated bus speed down after repeated errors. */
+static int32_t PCF2131_BusError(pcf2131_sensorhandle_t *pSensorHandle, int32_t status, int32_t error)
+{
+	/*! A shared bus held by another device is not an electrical error, leave the speed alone */
+	if (ARM_DRIVER_ERROR_BUSY == status)
+	{
+		return error;
+	}
+
+	pSensorHandle->busClean = 0;
+	if ((pSensorHandle->busSpeed > ARM_I2C_BUS_SPEED_STANDARD) &&
+			(++pSensorHandle->busErrors >= PCF2131_I2C_FALLBACK_ERRORS))
+	{
+		if (SENSOR_ERROR_NONE == PCF2131_SetBusSpeed(pSensorHandle, pSensorHandle->busSpeed - 1))
+		{
+			pSensorHandle->busSpeed--;
+		}
+		pSensorHandle->busErrors = 0;
+	}
+
+	return PCF2131_BUS_STATUS(status, error);
+}
+
+/*! Accounts a clean bus transfer: decays the error count and, after a long clean run below the fastest speed
+ *  that was stable at negotiation, probes one speed up with a time block read and stays there if it succeeds. */
+static void PCF2131_BusOk(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	uint8_t time[PCF2131_TIME_SIZE_BYTE];
+	uint8_t speed = pSensorHandle->busSpeed;
+
+	/*! Not negotiated, nothing to track */
+	if (speed == 0)
+	{
+		return;
+	}
+
+	pSensorHandle->busClean++;
+	if ((pSensorHandle->busErrors != 0) && ((pSensorHandle->busClean % PCF2131_I2C_DECAY_CLEAN) == 0))
+	{
+		pSensorHandle->busErrors--;
+	}
+
+	if ((pSensorHandle->busClean < PCF2131_I2C_STEPUP_CLEAN) || (speed >= PCF2131_I2C_SPEED_COUNT) ||
+			(pSensorHandle->busSpeedTime_us[speed] == 0))
+	{
+		return;
+	}
+
+	pSensorHandle->busClean = 0;
+	if (SENSOR_ERROR_NONE != PCF2131_SetBusSpeed(pSensorHandle, speed + 1))
+	{
+		return;
+	}
+	if (ARM_DRIVER_OK == Register_I2C_Read(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,
+			pSensorHandle->slaveAddress, PCF2131_100TH_SECOND, PCF2131_TIME_SIZE_BYTE, time))
+	{
+		pSensorHandle->busSpeed = speed + 1;
+		pSensorHandle->busErrors = 0;
+	}
+	else
+	{
+		/*! Probe failed, fall back to the speed that was running clean */
+		(void)PCF2131_SetBusSpeed(pSensorHandle, speed);
+	}
+}
+
+/*! Writes a register, or records the write in the dirty set while a transaction is open. */
+static int32_t PCF2131_RegWrite(pcf2131_sensorhandle_t *pSensorHandle, uint8_t offset, uint8_t value, uint8_t mask,
+		bool repeatedStart)
+{
+	/*! A non zero mask does a read-modify-write that also ORs in value bits outside the mask */
+	uint8_t dirty = (mask != 0) ? (mask | value) : 0xFF;
+
+	int32_t status;
+
+	if (!pSensorHandle->inTransaction)
+	{
+		status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
+			offset, value, mask, repeatedStart);
+		if (ARM_DRIVER_OK == status)
+		{
+			PCF2131_BusOk(pSensorHandle);
+		}
+		return status;
+	}
+
+	if (offset >= PCF2131_REG_MAP_SIZE)
+	{
+		return ARM_DRIVER_ERROR_PARAMETER;
+	}
+
+	pSensorHandle->txnValue[offset] = (pSensorHandle->txnValue[offset] & ~dirty) | (value & dirty);
+	pSensorHandle->txnMask[offset] |= dirty;
+
+	return ARM_DRIVER_OK;
+}
+
 
 int32_t PCF2131_Initialize(pcf2131_sensorhandle_t *pSensorHandle, ARM_DRIVER_I2C *pBus, uint8_t index, uint16_t sAddress)
 {
@@ -53,10 +150,24 @@ int32_t PCF2131_Initialize(pcf2131_sensorhandle_t *pSensorHandle, ARM_DRIVER_I2C
 	pSensorHandle->deviceInfo.deviceInstance = index;
 	pSensorHandle->deviceInfo.functionParam = NULL;
 	pSensorHandle->deviceInfo.idleFunction = NULL;
+	pSensorHandle->deviceInfo.timeout_us = PCF2131_BUS_TIMEOUT_US;
+	pSensorHandle->deviceInfo.pArbDevice = NULL;
 
 	/*! Initialize the sensor handle. */
 	pSensorHandle->pCommDrv = pBus;
 	pSensorHandle->slaveAddress = sAddress;
+	pSensorHandle->busSpeed = 0;
+	pSensorHandle->busErrors = 0;
+	pSensorHandle->busClean = 0;
+	memset(pSensorHandle->busSpeedTime_us, 0, sizeof(pSensorHandle->busSpeedTime_us));
+	pSensorHandle->wdCtl = 0;
+	pSensorHandle->wdKickValue = 0;
+	pSensorHandle->wdPiggyback = false;
+	pSensorHandle->inTransaction = false;
+	memset(&pSensorHandle->poll, 0, sizeof(pSensorHandle->poll));
+	pSensorHandle->pExtClkPin = NULL;
+	pSensorHandle->pExtClock = NULL;
+
 	pSensorHandle->isInitialized = true;
 	return SENSOR_ERROR_NONE;
 }
@@ -69,6 +180,65 @@ void PCF2131_SetIdleTask(pcf2131_sensorhandle_t *pSensorHandle,
 	pSensorHandle->deviceInfo.idleFunction = idleTask;
 }
 
+void PCF2131_SetTimeout(pcf2131_sensorhandle_t *pSensorHandle, uint32_t timeout_us)
+{
+	pSensorHandle->deviceInfo.timeout_us = timeout_us;
+}
+
+void PCF2131_SetArbiter(pcf2131_sensorhandle_t *pSensorHandle, busArbiterDevice_t *pDevice)
+{
+	pSensorHandle->deviceInfo.pArbDevice = pDevice;
+}
+
+int32_t PCF2131_SetBusSpeed(pcf2131_sensorhandle_t *pSensorHandle, uint32_t busSpeed)
+{
+	int32_t status;
+
+	/*! On a shared bus the arbiter keeps the speed with the RTC */
+	if (pSensorHandle->deviceInfo.pArbDevice != NULL)
+	{
+		status = Bus_Arbiter_SetSpeed(pSensorHandle->deviceInfo.pArbDevice, busSpeed);
+	}
+	else
+	{
+		status = pSensorHandle->pCommDrv->Control(ARM_I2C_BUS_SPEED, busSpeed);
+	}
+
+	return (ARM_DRIVER_OK == status) ? SENSOR_ERROR_NONE : SENSOR_ERROR_INIT;
+}
+
+void PCF2131_GetBusCount(pcf2131_sensorhandle_t *pSensorHandle, registerIoCount_t *pCount)
+{
+	Register_I2C_GetCount(pSensorHandle->deviceInfo.deviceInstance, pCount);
+}
+
+void PCF2131_ClearBusCount(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	Register_I2C_ClearCount(pSensorHandle->deviceInfo.deviceInstance);
+}
+
+
+/* Checks that a caller read list stays within the register map and fills no more than size bytes. */
+static bool PCF2131_ReadListFits(const registerreadlist_t *pReadList, uint32_t size)
+{
+	uint32_t total = 0;
+
+	if (pReadList == NULL)
+	{
+		return false;
+	}
+
+	for (; pReadList->numBytes != 0; pReadList++)
+	{
+		total += pReadList->numBytes;
+		if ((total > size) || ((pReadList->readFrom + pReadList->numBytes) > PCF2131_REG_MAP_SIZE))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
 
 int32_t PCF2131_ReadData(pcf2131_sensorhandle_t *pSensorHandle,
 		const registerreadlist_t *pReadList,
@@ -93,212 +263,281 @@ int32_t PCF2131_ReadData(pcf2131_sensorhandle_t *pSensorHandle,
 			pReadList, pBuffer);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_READ;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_READ);
+	}
+	PCF2131_BusOk(pSensorHandle);
+
+	/*! Piggyback the watchdog kick on this transfer */
+	if (pSensorHandle->wdPiggyback)
+	{
+		status = PCF2131_Watchdog_Kick(pSensorHandle);
+		if (SENSOR_ERROR_NONE != status)
+		{
+			return status;
+		}
 	}
 
 	return SENSOR_ERROR_NONE;
 }
 
-int32_t PCF2131_WriteData(pcf2131_sensorhandle_t *pSensorHandle, const registerwritelist_t *pRegWriteList)
+int32_t PCF2131_ReadInPlace(pcf2131_sensorhandle_t *pSensorHandle, uint8_t offset, uint8_t length, uint8_t *pBuffer)
 {
 	int32_t status;
 
-	/*! Validate for the correct handle and register write list.*/
-	if ((pSensorHandle == NULL) || (pRegWriteList == NULL))
+	/*! Validate for the correct handle and buffer.*/
+	if ((pSensorHandle == NULL) || (pBuffer == NULL))
 	{
 		return SENSOR_ERROR_INVALID_PARAM;
 	}
 
-	/*! Check whether sensor handle is initialized before applying configuration.*/
+	/*! Check whether sensor handle is initialized before reading sensor data.*/
 	if (pSensorHandle->isInitialized != true)
 	{
 		return SENSOR_ERROR_INIT;
 	}
 
-	/*! Apply the Sensor Configuration based on the Register Write List */
-	status = Sensor_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
-			pRegWriteList);
+	/*! Read directly into the caller buffer behind the headroom. */
+	status = Register_I2C_Read(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
+			offset, length, pBuffer + PCF2131_BUF_HEADROOM);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_READ);
+	}
+	PCF2131_BusOk(pSensorHandle);
+
+	/*! Piggyback the watchdog kick on this transfer */
+	if (pSensorHandle->wdPiggyback)
+	{
+		status = PCF2131_Watchdog_Kick(pSensorHandle);
+		if (SENSOR_ERROR_NONE != status)
+		{
+			return status;
+		}
 	}
 
 	return SENSOR_ERROR_NONE;
 }
 
-int32_t PCF2131_Configure(pcf2131_sensorhandle_t *pSensorHandle, const registerwritelist_t *pRegWriteList)
+int32_t PCF2131_WriteInPlace(pcf2131_sensorhandle_t *pSensorHandle, uint8_t offset, uint8_t length, uint8_t *pBuffer)
 {
 	int32_t status;
 
-	/*! Validate for the correct handle and register write list.*/
-	if ((pSensorHandle == NULL) || (pRegWriteList == NULL))
+	/*! Validate for the correct handle and buffer.*/
+	if ((pSensorHandle == NULL) || (pBuffer == NULL))
 	{
 		return SENSOR_ERROR_INVALID_PARAM;
 	}
 
-	/*! Check whether sensor handle is initialized before applying configuration.*/
+	/*! Check whether sensor handle is initialized before writing sensor data.*/
 	if (pSensorHandle->isInitialized != true)
 	{
 		return SENSOR_ERROR_INIT;
 	}
 
-	/*! Apply the Sensor Configuration based on the Register Write List */
-	status = Sensor_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
-			pRegWriteList);
+	/*! Send the payload behind the headroom. */
+	status = Register_I2C_BlockWrite(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
+			offset, pBuffer + PCF2131_BUF_HEADROOM, length);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 	}
 
 	return SENSOR_ERROR_NONE;
 }
 
-int32_t PCF2131_Rtc_Start(pcf2131_sensorhandle_t *pSensorHandle)
+int32_t PCF2131_StartReadInPlace(pcf2131_sensorhandle_t *pSensorHandle, uint8_t offset, uint8_t length, uint8_t *pBuffer)
 {
 	int32_t status;
 
-	/*! Validate for the correct handle */
-	if (pSensorHandle == NULL)
+	/*! Validate for the correct handle and buffer.*/
+	if ((pSensorHandle == NULL) || (pBuffer == NULL))
 	{
 		return SENSOR_ERROR_INVALID_PARAM;
 	}
 
-	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
+	/*! Check whether sensor handle is initialized before reading sensor data.*/
 	if (pSensorHandle->isInitialized != true)
 	{
 		return SENSOR_ERROR_INIT;
 	}
 
-	/*! Start RTC source clock */
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,PCF2131_CTRL1,
-			(uint8_t)(rtcStart << PCF2131_CTRL1_START_STOP_SHIFT ),PCF2131_CTRL1_START_STOP_MASK,repeatedStart);
+	/*! Start the read directly into the caller buffer behind the headroom. */
+	status = Register_I2C_StartRead(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
+			offset, length, pBuffer + PCF2131_BUF_HEADROOM);
+	/*! A shared bus taken by another device is retried on the next poll */
+	if (ARM_DRIVER_ERROR_BUSY == status)
+	{
+		return SENSOR_ERROR_BUSY;
+	}
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_READ);
 	}
+	pSensorHandle->poll.error = SENSOR_ERROR_READ;
 
 	return SENSOR_ERROR_NONE;
 }
 
-
-int32_t PCF2131_Rtc_Stop(pcf2131_sensorhandle_t *pSensorHandle)
+int32_t PCF2131_StartWriteInPlace(pcf2131_sensorhandle_t *pSensorHandle, uint8_t offset, uint8_t length, uint8_t *pBuffer)
 {
 	int32_t status;
 
-	/*! Validate for the correct handle */
-	if (pSensorHandle == NULL)
+	/*! Validate for the correct handle and buffer.*/
+	if ((pSensorHandle == NULL) || (pBuffer == NULL))
 	{
 		return SENSOR_ERROR_INVALID_PARAM;
 	}
 
-	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
+	/*! Check whether sensor handle is initialized before writing sensor data.*/
 	if (pSensorHandle->isInitialized != true)
 	{
 		return SENSOR_ERROR_INIT;
 	}
 
-	/*! Stop RTC source clock */
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
-			PCF2131_CTRL1,(uint8_t)(rtcStop << PCF2131_CTRL1_START_STOP_SHIFT ),PCF2131_CTRL1_START_STOP_MASK,repeatedStart);
+	/*! Start sending the caller buffer, the register address goes into the headroom. */
+	status = Register_I2C_StartBlockWriteInPlace(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,
+			pSensorHandle->slaveAddress, offset, pBuffer, length);
+	/*! A shared bus taken by another device is retried on the next poll */
+	if (ARM_DRIVER_ERROR_BUSY == status)
+	{
+		return SENSOR_ERROR_BUSY;
+	}
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 	}
+	pSensorHandle->poll.error = SENSOR_ERROR_WRITE;
 
 	return SENSOR_ERROR_NONE;
 }
 
-int32_t PCF2131_SwRst(pcf2131_sensorhandle_t *pSensorHandle, SwRst swrst)
+int32_t PCF2131_PollTransfer(pcf2131_sensorhandle_t *pSensorHandle)
 {
 	int32_t status;
 
-	/*! Validate for the correct handle.*/
-	if (pSensorHandle == NULL)
+	status = Register_I2C_Poll(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo);
+	if (ARM_DRIVER_ERROR_BUSY == status)
 	{
-		return SENSOR_ERROR_INVALID_PARAM;
+		return SENSOR_ERROR_BUSY;
 	}
-
-	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
-	if (pSensorHandle->isInitialized != true)
+	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_INIT;
+		return PCF2131_BusError(pSensorHandle, status, pSensorHandle->poll.error);
 	}
 
-	switch(swrst)
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_Begin(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	/*! Validate for the correct handle */
+	if (pSensorHandle == NULL)
 	{
-	case CPR:  /*! Trigger clear prescaler.*/
-		status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
-				PCF2131_SR_RESET,PCF2131_CPR, PCF2131_RESET_MASK,repeatedStart);
-		break;
-	case CTS:  /*! Trigger clear Time stamp.*/
-		status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
-				PCF2131_SR_RESET, PCF2131_CTS, PCF2131_RESET_MASK,repeatedStart);
-		break;
-	case SR:   /*! Trigger sensor device reset.*/
-		status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
-				PCF2131_SR_RESET, PCF2131_TRIGGER_SW_RESET, PCF2131_RESET_MASK,repeatedStart);
-		break;
-	default:
-		break;
+		return SENSOR_ERROR_INVALID_PARAM;
 	}
-	if (ARM_DRIVER_OK != status)
+
+	/*! Check whether sensor handle is initialized and no transaction is open.*/
+	if ((pSensorHandle->isInitialized != true) || pSensorHandle->inTransaction)
 	{
-		return SENSOR_ERROR_WRITE;
+		return SENSOR_ERROR_INIT;
 	}
 
+	memset(pSensorHandle->txnMask, 0, sizeof(pSensorHandle->txnMask));
+	pSensorHandle->inTransaction = true;
+
 	return SENSOR_ERROR_NONE;
 }
 
-int32_t PCF2131_TimeStamp_On(pcf2131_sensorhandle_t *pSensorHandle, SwTsNum tsnum)
+int32_t PCF2131_Commit(pcf2131_sensorhandle_t *pSensorHandle)
 {
 	int32_t status;
+	uint8_t buffer[PCF2131_BUF_HEADROOM + PCF2131_REG_MAP_SIZE];
+	uint8_t *pReg = &buffer[PCF2131_BUF_HEADROOM];
+	uint8_t *pMask;
+	uint8_t start, end;
+	bool needRead;
 
-	/*! Validate for the correct.*/
+	/*! Validate for the correct handle */
 	if (pSensorHandle == NULL)
 	{
 		return SENSOR_ERROR_INVALID_PARAM;
 	}
 
-	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
-	if (pSensorHandle->isInitialized != true)
+	/*! Check whether sensor handle is initialized and a transaction is open.*/
+	if ((pSensorHandle->isInitialized != true) || !pSensorHandle->inTransaction)
 	{
 		return SENSOR_ERROR_INIT;
 	}
 
-	switch(tsnum)
+	/*! Close the transaction so that the bursts below go to the bus */
+	pSensorHandle->inTransaction = false;
+	pMask = pSensorHandle->txnMask;
+
+	/*! Read every dirty range holding a partially written register before writing anything.
+	 *  Top down, so the headroom of a read only lands on ranges still to be read. */
+	for (end = PCF2131_REG_MAP_SIZE; end > 0; end = start)
 	{
-	case sw1Ts:  /*! Enable SW1 Timestamp.*/
-		status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
-				PCF2131_TIMESTAMP1_CTL, (Ts_On << PCF2131_TSOFF_TS_SHIFT ), PCF2131_TSOFF_TS_MASK,repeatedStart);
-		break;
-	case sw2Ts: /*! Enable SW2 Timestamp.*/
-		status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
-				PCF2131_TIMESTAMP2_CTL, (Ts_On << PCF2131_TSOFF_TS_SHIFT), PCF2131_TSOFF_TS_MASK,repeatedStart);
-		break;
-	case sw3Ts:   /*! Enable SW3 Timestamp.*/
-		status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
-				PCF2131_TIMESTAMP3_CTL, (Ts_On << PCF2131_TSOFF_TS_SHIFT ), PCF2131_TSOFF_TS_MASK,repeatedStart);
-		break;
-	case sw4Ts:  /*! Enable SW4 Timestamp.*/
-		status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
-				PCF2131_TIMESTAMP4_CTL, (Ts_On << PCF2131_TSOFF_TS_SHIFT ), PCF2131_TSOFF_TS_MASK,repeatedStart);
-		break;
-	default:
-		break;
+		needRead = false;
+		for (start = end; (start > 0) && (pMask[start - 1] != 0); start--)
+		{
+			needRead |= (pMask[start - 1] != 0xFF);
+		}
+		if (start == end)
+		{
+			start--;
+		}
+		else if (needRead)
+		{
+			status = PCF2131_ReadInPlace(pSensorHandle, start, end - start, &pReg[start] - PCF2131_BUF_HEADROOM);
+			if (SENSOR_ERROR_NONE != status)
+			{
+				return status;
+			}
+		}
 	}
-	if (ARM_DRIVER_OK != status)
+
+	/*! Merge and write each dirty range in one burst.
+	 *  Bottom up, so the headroom of a write only lands below the ranges already written. */
+	for (start = 0; start < PCF2131_REG_MAP_SIZE; start = end)
+	{
+		for (end = start; (end < PCF2131_REG_MAP_SIZE) && (pMask[end] != 0); end++)
+		{
+			pReg[end] = (pReg[end] & ~pMask[end]) | (pSensorHandle->txnValue[end] & pMask[end]);
+		}
+		if (end == start)
+		{
+			end++;
+			continue;
+		}
+
+		status = PCF2131_WriteInPlace(pSensorHandle, start, end - start, &pReg[start] - PCF2131_BUF_HEADROOM);
+		if (SENSOR_ERROR_NONE != status)
+		{
+			return status;
+		}
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_Abort(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	/*! Validate for the correct handle */
+	if (pSensorHandle == NULL)
 	{
-		return SENSOR_ERROR_WRITE;
+		return SENSOR_ERROR_INVALID_PARAM;
 	}
 
+	pSensorHandle->inTransaction = false;
+
 	return SENSOR_ERROR_NONE;
 }
 
-int32_t PCF2131_TimeStamp_Off(pcf2131_sensorhandle_t *pSensorHandle, SwTsNum tsnum)
+int32_t PCF2131_Deinit(pcf2131_sensorhandle_t *pSensorHandle)
 {
 	int32_t status;
 
-	/*! Validate for the correct handle.*/
+	/*! Validate for the correct handle */
 	if (pSensorHandle == NULL)
 	{
 		return SENSOR_ERROR_INVALID_PARAM;
@@ -310,77 +549,317 @@ int32_t PCF2131_TimeStamp_Off(pcf2131_sensorhandle_t *pSensorHandle, SwTsNum tsn
 		return SENSOR_ERROR_INIT;
 	}
 
-	switch(tsnum)
-	{
-	case sw1Ts:  /*! Disable SW1 Timestamp.*/
-		status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
-				PCF2131_TIMESTAMP1_CTL, (Ts_Off << PCF2131_TSOFF_TS_SHIFT ), PCF2131_TSOFF_TS_MASK,repeatedStart);
-		break;
-	case sw2Ts:  /*! Disable SW2 Timestamp.*/
-		status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
-				PCF2131_TIMESTAMP2_CTL, (Ts_Off << PCF2131_TSOFF_TS_SHIFT ), PCF2131_TSOFF_TS_MASK,repeatedStart);
-		break;
-	case sw3Ts:  /*! Disable SW3 Timestamp.*/
-		status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
-				PCF2131_TIMESTAMP3_CTL, (Ts_Off << PCF2131_TSOFF_TS_SHIFT ), PCF2131_TSOFF_TS_MASK,repeatedStart);
-		break;
-	case sw4Ts:  /*! Disable SW4 Timestamp.*/
-		status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
-				PCF2131_TIMESTAMP4_CTL, (Ts_Off << PCF2131_TSOFF_TS_SHIFT ), PCF2131_TSOFF_TS_MASK,repeatedStart);
-		break;
-	default:
-		break;
-	}
+	/*! Trigger RTC device reset, also inside an open transaction.*/
+	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
+			PCF2131_SR_RESET, PCF2131_TRIGGER_SW_RESET, PCF2131_RESET_MASK, repeatedStart);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 	}
 
+	/*! De-initialize sensor handle. */
+	pSensorHandle->inTransaction = false;
+	pSensorHandle->isInitialized = false;
+
+	/* Wait for MAX of TBOOT ms after soft reset command, to allow the RTC to complete its reset. */
+	BOARD_DELAY_ms(PCF2131_TBOOT_MAX);
+
 	return SENSOR_ERROR_NONE;
 }
-/*! Set 100th Second.*/
 
-int32_t PCF2131_SetTime(pcf2131_sensorhandle_t *pSensorHandle, pcf2131_timedata_t *time)
+int32_t PCF2131_WriteData(pcf2131_sensorhandle_t *pSensorHandle, const registerwritelist_t *pRegWriteList)
 {
 	int32_t status;
-	Mode12h_24h mode12_24;
 
-	/*! Validate for the correct handle and time read variable.*/
-	if ((pSensorHandle == NULL) || (time == NULL))
+	/*! Validate for the correct handle and register write list.*/
+	if ((pSensorHandle == NULL) || (pRegWriteList == NULL))
 	{
 		return SENSOR_ERROR_INVALID_PARAM;
 	}
 
-	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
+	/*! Check whether sensor handle is initialized before applying configuration.*/
 	if (pSensorHandle->isInitialized != true)
 	{
 		return SENSOR_ERROR_INIT;
 	}
 
-	/*! Set 100th Second.*/
-
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
-			PCF2131_100TH_SECOND, DecimaltoBcd(time->second_100th & PCF2131_SECONDS_100TH_MASK), PCF2131_SECONDS_100TH_MASK,repeatedStart);
-
+	/*! Apply the Sensor Configuration based on the Register Write List */
+	status = Sensor_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
+			pRegWriteList);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 	}
 
-	/*! Set Second.*/
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
-			PCF2131_SECOND, DecimaltoBcd(time->second & PCF2131_SECONDS_MASK), PCF2131_SECONDS_MASK,repeatedStart);
-	if (ARM_DRIVER_OK != status)
-	{
-		return SENSOR_ERROR_WRITE;
-	}
+	return SENSOR_ERROR_NONE;
+}
 
-	/*! Set Minutes.*/
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
-			PCF2131_MINUTE, DecimaltoBcd(time->minutes & PCF2131_MINUTES_MASK ), PCF2131_MINUTES_MASK,repeatedStart);
-	if (ARM_DRIVER_OK != status)
+int32_t PCF2131_Configure(pcf2131_sensorhandle_t *pSensorHandle, const registerwritelist_t *pRegWriteList)
+{
+	int32_t status;
+
+	/*! Validate for the correct handle and register write list.*/
+	if ((pSensorHandle == NULL) || (pRegWriteList == NULL))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before applying configuration.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/*! Apply the Sensor Configuration based on the Register Write List */
+	status = Sensor_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
+			pRegWriteList);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
+	}
+	PCF2131_BusOk(pSensorHandle);
+
+	/*! Piggyback the watchdog kick on this transfer */
+	if (pSensorHandle->wdPiggyback)
+	{
+		status = PCF2131_Watchdog_Kick(pSensorHandle);
+		if (SENSOR_ERROR_NONE != status)
+		{
+			return status;
+		}
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_Rtc_Start(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	int32_t status;
+
+	/*! Validate for the correct handle */
+	if (pSensorHandle == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/*! Start RTC source clock */
+	status = PCF2131_RegWrite(pSensorHandle,PCF2131_CTRL1,
+			(uint8_t)(rtcStart << PCF2131_CTRL1_START_STOP_SHIFT ),PCF2131_CTRL1_START_STOP_MASK,repeatedStart);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
+
+int32_t PCF2131_Rtc_Stop(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	int32_t status;
+
+	/*! Validate for the correct handle */
+	if (pSensorHandle == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/*! Stop RTC source clock */
+	status = PCF2131_RegWrite(pSensorHandle,
+			PCF2131_CTRL1,(uint8_t)(rtcStop << PCF2131_CTRL1_START_STOP_SHIFT ),PCF2131_CTRL1_START_STOP_MASK,repeatedStart);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_SwRst(pcf2131_sensorhandle_t *pSensorHandle, SwRst swrst)
+{
+	int32_t status;
+
+	/*! Validate for the correct handle.*/
+	if (pSensorHandle == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	switch(swrst)
+	{
+	case CPR:  /*! Trigger clear prescaler.*/
+		status = PCF2131_RegWrite(pSensorHandle,
+				PCF2131_SR_RESET,PCF2131_CPR, PCF2131_RESET_MASK,repeatedStart);
+		break;
+	case CTS:  /*! Trigger clear Time stamp.*/
+		status = PCF2131_RegWrite(pSensorHandle,
+				PCF2131_SR_RESET, PCF2131_CTS, PCF2131_RESET_MASK,repeatedStart);
+		break;
+	case SR:   /*! Trigger sensor device reset.*/
+		status = PCF2131_RegWrite(pSensorHandle,
+				PCF2131_SR_RESET, PCF2131_TRIGGER_SW_RESET, PCF2131_RESET_MASK,repeatedStart);
+		break;
+	default:
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_TimeStamp_On(pcf2131_sensorhandle_t *pSensorHandle, SwTsNum tsnum)
+{
+	int32_t status;
+
+	/*! Validate for the correct.*/
+	if (pSensorHandle == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	switch(tsnum)
+	{
+	case sw1Ts:  /*! Enable SW1 Timestamp.*/
+		status = PCF2131_RegWrite(pSensorHandle,
+				PCF2131_TIMESTAMP1_CTL, (Ts_On << PCF2131_TSOFF_TS_SHIFT ), PCF2131_TSOFF_TS_MASK,repeatedStart);
+		break;
+	case sw2Ts: /*! Enable SW2 Timestamp.*/
+		status = PCF2131_RegWrite(pSensorHandle,
+				PCF2131_TIMESTAMP2_CTL, (Ts_On << PCF2131_TSOFF_TS_SHIFT), PCF2131_TSOFF_TS_MASK,repeatedStart);
+		break;
+	case sw3Ts:   /*! Enable SW3 Timestamp.*/
+		status = PCF2131_RegWrite(pSensorHandle,
+				PCF2131_TIMESTAMP3_CTL, (Ts_On << PCF2131_TSOFF_TS_SHIFT ), PCF2131_TSOFF_TS_MASK,repeatedStart);
+		break;
+	case sw4Ts:  /*! Enable SW4 Timestamp.*/
+		status = PCF2131_RegWrite(pSensorHandle,
+				PCF2131_TIMESTAMP4_CTL, (Ts_On << PCF2131_TSOFF_TS_SHIFT ), PCF2131_TSOFF_TS_MASK,repeatedStart);
+		break;
+	default:
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_TimeStamp_Off(pcf2131_sensorhandle_t *pSensorHandle, SwTsNum tsnum)
+{
+	int32_t status;
+
+	/*! Validate for the correct handle.*/
+	if (pSensorHandle == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	switch(tsnum)
+	{
+	case sw1Ts:  /*! Disable SW1 Timestamp.*/
+		status = PCF2131_RegWrite(pSensorHandle,
+				PCF2131_TIMESTAMP1_CTL, (Ts_Off << PCF2131_TSOFF_TS_SHIFT ), PCF2131_TSOFF_TS_MASK,repeatedStart);
+		break;
+	case sw2Ts:  /*! Disable SW2 Timestamp.*/
+		status = PCF2131_RegWrite(pSensorHandle,
+				PCF2131_TIMESTAMP2_CTL, (Ts_Off << PCF2131_TSOFF_TS_SHIFT ), PCF2131_TSOFF_TS_MASK,repeatedStart);
+		break;
+	case sw3Ts:  /*! Disable SW3 Timestamp.*/
+		status = PCF2131_RegWrite(pSensorHandle,
+				PCF2131_TIMESTAMP3_CTL, (Ts_Off << PCF2131_TSOFF_TS_SHIFT ), PCF2131_TSOFF_TS_MASK,repeatedStart);
+		break;
+	case sw4Ts:  /*! Disable SW4 Timestamp.*/
+		status = PCF2131_RegWrite(pSensorHandle,
+				PCF2131_TIMESTAMP4_CTL, (Ts_Off << PCF2131_TSOFF_TS_SHIFT ), PCF2131_TSOFF_TS_MASK,repeatedStart);
+		break;
+	default:
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+/*! Set 100th Second.*/
+
+int32_t PCF2131_SetTime(pcf2131_sensorhandle_t *pSensorHandle, pcf2131_timedata_t *time)
+{
+	int32_t status;
+	Mode12h_24h mode12_24;
+
+	/*! Validate for the correct handle and time read variable.*/
+	if ((pSensorHandle == NULL) || (time == NULL))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/*! Set 100th Second.*/
+
+	status = PCF2131_RegWrite(pSensorHandle,
+			PCF2131_100TH_SECOND, DecimaltoBcd(time->second_100th & PCF2131_SECONDS_100TH_MASK), PCF2131_SECONDS_100TH_MASK,repeatedStart);
+
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
+	}
+
+	/*! Set Second.*/
+	status = PCF2131_RegWrite(pSensorHandle,
+			PCF2131_SECOND, DecimaltoBcd(time->second & PCF2131_SECONDS_MASK), PCF2131_SECONDS_MASK,repeatedStart);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
+	}
+
+	/*! Set Minutes.*/
+	status = PCF2131_RegWrite(pSensorHandle,
+			PCF2131_MINUTE, DecimaltoBcd(time->minutes & PCF2131_MINUTES_MASK ), PCF2131_MINUTES_MASK,repeatedStart);
+	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 	}
 
 	/*! Update AM/PM Bit.*/
@@ -398,43 +877,43 @@ int32_t PCF2131_SetTime(pcf2131_sensorhandle_t *pSensorHandle, pcf2131_timedata_
 		time->hours = DecimaltoBcd(time->hours & PCF2131_HOURS_MASK);
 
 	/*! Set Hour.*/
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_HOUR, time->hours , PCF2131_HOURS_MASK,repeatedStart);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 	}
 
 	/*! Set Day.*/
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_DAY, DecimaltoBcd(time->days & PCF2131_DAYS_MASK),PCF2131_DAYS_MASK,repeatedStart);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 	}
 
 	/*! Set WeekDay.*/
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_WEEKEND, DecimaltoBcd(time->weekdays &  PCF2131_WEEKDAYS_MASK ), PCF2131_WEEKDAYS_MASK,repeatedStart);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 	}
 
 	/*! Set Months.*/
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_MONTH, DecimaltoBcd(time->months & PCF2131_MONTHS_MASK),PCF2131_MONTHS_MASK,repeatedStart);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 	}
 
 	/*! Set Year.*/
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_YEAR, DecimaltoBcd(time->years & PCF2131_YEARS_MASK) , PCF2131_YEARS_MASK,repeatedStart);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 	}
 
 	return SENSOR_ERROR_NONE;
@@ -460,11 +939,17 @@ int32_t PCF2131_GetTime(pcf2131_sensorhandle_t *pSensorHandle, const registerrea
 		return SENSOR_ERROR_INIT;
 	}
 
+	/*! The read list must not run past the time structure.*/
+	if (!PCF2131_ReadListFits(pcf2131timedata, PCF2131_TIME_SIZE_BYTE))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
 	/*! Get time.*/
 	status = PCF2131_ReadData(pSensorHandle, pcf2131timedata, ( uint8_t *)time );
-	if (ARM_DRIVER_OK != status)
+	if (SENSOR_ERROR_NONE != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return status;
 	}
 
 	/*! after read convert BCD to Decimal */
@@ -472,7 +957,11 @@ int32_t PCF2131_GetTime(pcf2131_sensorhandle_t *pSensorHandle, const registerrea
 	time->second = BcdToDecimal(time->second & PCF2131_SECONDS_MASK) ;
 	time->minutes = BcdToDecimal(time->minutes & PCF2131_MINUTES_MASK);
 
-	PCF2131_12h_24h_Mode_Get(pSensorHandle, &mode12_24);
+	status = PCF2131_12h_24h_Mode_Get(pSensorHandle, &mode12_24);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
 	if(mode12_24 ==  mode24H)
 	{
 		time->hours = BcdToDecimal(time->hours & PCF2131_HOURS_MASK) ;
@@ -513,6 +1002,12 @@ int32_t PCF2131_GetTs(pcf2131_sensorhandle_t *pSensorHandle, const registerreadl
 		return SENSOR_ERROR_INIT;
 	}
 
+	/*! The read list must not run past the timestamp structure.*/
+	if (!PCF2131_ReadListFits(pcf2131tsdata, PCF2131_TS_SIZE_BYTE))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
 	switch(tsnum)
 	{
 	case sw1Ts:  /*! Get Timestamp SW1 .*/
@@ -528,17 +1023,22 @@ int32_t PCF2131_GetTs(pcf2131_sensorhandle_t *pSensorHandle, const registerreadl
 		status = PCF2131_ReadData(pSensorHandle, pcf2131tsdata, (uint8_t *)timestamp);
 		break;
 	default:
-		break;
+		return SENSOR_ERROR_INVALID_PARAM;
 	}
-	if (ARM_DRIVER_OK != status)
+	if (SENSOR_ERROR_NONE != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return status;
 	}
 
 	/*! after read convert BCD to Decimal */
 	timestamp->second = BcdToDecimal(timestamp->second & PCF2131_SECONDS_TS_MASK) ;
 	timestamp->minutes = BcdToDecimal(timestamp->minutes & PCF2131_MINUTES_TS_MASK) ;
-	PCF2131_12h_24h_Mode_Get(pSensorHandle, &mode12_24); /*! Update AM/PM */
+	/*! Update AM/PM */
+	status = PCF2131_12h_24h_Mode_Get(pSensorHandle, &mode12_24);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
 	if(mode12_24 ==  mode24H)
 	{
 		timestamp->hours = BcdToDecimal(timestamp->hours & PCF2131_HOURS_TS_MASK) ;
@@ -576,11 +1076,11 @@ int32_t PCF2131_12h_24h_Mode_Set(pcf2131_sensorhandle_t *pSensorHandle, Mode12h_
 	}
 
 	/*! Set 12/24 mode */
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_CTRL1, (uint8_t)(((is_mode12h == mode12H) ? mode12H : mode24H )<< PCF2131_CTRL1_12_HOUR_24_HOUR_MODE_SHIFT ), PCF2131_CTRL1_12_HOUR_24_HOUR_MODE_MASK,repeatedStart);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 	}
 
 	return SENSOR_ERROR_NONE;
@@ -608,7 +1108,7 @@ int32_t PCF2131_12h_24h_Mode_Get(pcf2131_sensorhandle_t *pSensorHandle, Mode12h_
 			PCF2131_CTRL1, PCF2131_REG_SIZE_BYTE, (uint8_t *)&Ctrl1_Reg);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_READ;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_READ);
 	}
 	*pmode_12_24 = Ctrl1_Reg.b.mode_12_24;
 
@@ -632,11 +1132,11 @@ int32_t PCF2131_Sec100TH_Mode(pcf2131_sensorhandle_t *pSensorHandle, S100thMode
 	}
 
 	/*! 100th Second mode Enable/Disable */
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_CTRL1, (uint8_t)(((is_s100h == s100thEnable) ? s100thEnable : s100thDisable)<< PCF2131_CTRL1_100TH_S_DIS_SHIFT ), PCF2131_CTRL1_100TH_S_DIS_MASK,repeatedStart);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 	}
 
 	return SENSOR_ERROR_NONE;
@@ -663,7 +1163,7 @@ int32_t PCF2131_Sec100TH_Mode_Get(pcf2131_sensorhandle_t *pSensorHandle, S100thM
 			PCF2131_CTRL1, PCF2131_REG_SIZE_BYTE, (uint8_t *)&Ctrl1_Reg);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_READ);
 	}
 	*s100_mode = Ctrl1_Reg.b.s_dis_100th;
 
@@ -687,27 +1187,29 @@ int32_t PCF2131_SecInt_Enable(pcf2131_sensorhandle_t *pSensorHandle, IntSrc ints
 	}
 
 	/*! Second Interrupt Enable */
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_CTRL1, (uint8_t)(intEnable << PCF2131_CTRL1_SI_SHIFT ), PCF2131_CTRL1_SI_MASK,repeatedStart);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 	}
 
 	if( intsrc == IntA)   /*! clear Second Interrupt Mask on INTA */
 	{
-		status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_INT_A_MASK1,( INT_UNMASK << PCF2131_SI_SHIFT), PCF2131_SI_DIS_MASK,repeatedStart);
 	}
 	else  /*! clear Second Interrupt Mask on INTB */
 	{
-		status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_INT_B_MASK1,( INT_UNMASK << PCF2131_SI_SHIFT), PCF2131_SI_DIS_MASK,repeatedStart);
 	}
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 	}
+
+	return SENSOR_ERROR_NONE;
 }
 
 int32_t PCF2131_SecInt_Disable(pcf2131_sensorhandle_t *pSensorHandle)
@@ -727,25 +1229,25 @@ int32_t PCF2131_SecInt_Disable(pcf2131_sensorhandle_t *pSensorHandle)
 	}
 
 	/*! Second Interrupt Disable */
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_CTRL1,(uint8_t)(intDisable << PCF2131_CTRL1_SI_SHIFT ), PCF2131_CTRL1_SI_MASK,repeatedStart);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_INT_A_MASK1,( INT_MASK << PCF2131_SI_SHIFT), PCF2131_SI_DIS_MASK,repeatedStart);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_INT_B_MASK1, (INT_MASK << PCF2131_SI_SHIFT), PCF2131_SI_DIS_MASK,repeatedStart);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 	}
 
 	return SENSOR_ERROR_NONE;
@@ -774,7 +1276,7 @@ int32_t PCF2131_Check_MinSecInt(pcf2131_sensorhandle_t *pSensorHandle, IntState
 
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_READ;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_READ);
 	}
 	*pIntStatus = Ctrl2_Reg.b.msf ;
 
@@ -798,11 +1300,11 @@ int32_t PCF2131_Clear_MinSecInt(pcf2131_sensorhandle_t *pSensorHandle)
 	}
 
 	/*! clear Minute/Second interrupt flag */
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_CTRL2, (uint8_t)(intClear << PCF2131_CTRL2_MSF_SHIFT), PCF2131_CTRL2_MSF_MASK,repeatedStart);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 	}
 
 	return SENSOR_ERROR_NONE;
@@ -825,26 +1327,26 @@ int32_t PCF2131_MinInt_Enable(pcf2131_sensorhandle_t *pSensorHandle, IntSrc ints
 	}
 
 	/*! Minute Interrupt Enable */
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_CTRL1, (uint8_t)(intEnable << PCF2131_CTRL1_MI_SHIFT ), PCF2131_CTRL1_MI_MASK,repeatedStart);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 	}
 
 	if( intsrc == IntA)   /*! clear Minute Interrupt Mask on INTA */
 	{
-		status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_INT_A_MASK1, PCF2131_MI_ENB_MASK_VALUE, PCF2131_REG_MASK,repeatedStart);
 	}
 	else   /*! clear Minute Interrupt Mask on INTA */
 	{
-		status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_INT_B_MASK1, PCF2131_MI_ENB_MASK_VALUE, PCF2131_REG_MASK,repeatedStart);
 	}
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 	}
 
 	return SENSOR_ERROR_NONE;
@@ -867,11 +1369,11 @@ int32_t PCF2131_MinInt_Disable(pcf2131_sensorhandle_t *pSensorHandle)
 	}
 
 	/*! Minute Interrupt Disable */
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_CTRL1,(uint8_t)(intDisable << PCF2131_CTRL1_MI_SHIFT ), PCF2131_CTRL1_MI_MASK,repeatedStart);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 	}
 
 	return SENSOR_ERROR_NONE;
@@ -896,97 +1398,97 @@ int32_t PCF2131_SW_TsInt_Enable(pcf2131_sensorhandle_t *pSensorHandle, SwTsNum s
 	switch(swtsnum)
 	{
 	case sw1Ts:   /*! SW1 time stamp INT Enable */
-		status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_CTRL5, (uint8_t)(intEnable << PCF2131_CTRL5_TSIE1_SHIFT ), PCF2131_CTRL5_TSIE1_MASK,repeatedStart);
 		if (ARM_DRIVER_OK != status)
 		{
-			return SENSOR_ERROR_WRITE;
+			return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 		}
 
 		if( intsrc == IntA)   /*! Clear SW1 time stamp INTA */
 		{
-			status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
+			status = PCF2131_RegWrite(pSensorHandle,
 					PCF2131_INT_A_MASK2, PCF2131_TS1_ENB_MASK_VALUE, PCF2131_REG_MASK,1);
 		}
 		else  /*! Clear SW1 time stamp INTB */
 		{
-			status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
+			status = PCF2131_RegWrite(pSensorHandle,
 					PCF2131_INT_B_MASK2, PCF2131_TS1_ENB_MASK_VALUE, PCF2131_REG_MASK,repeatedStart);
 		}
 
 		if (ARM_DRIVER_OK != status)
 		{
-			return SENSOR_ERROR_WRITE;
+			return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 		}
 		break;
 	case sw2Ts:  /*! SW2 time stamp INT Enable */
-		status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_CTRL5, (uint8_t)(intEnable << PCF2131_CTRL5_TSIE2_SHIFT ), PCF2131_CTRL5_TSIE2_MASK,repeatedStart);
 		if (ARM_DRIVER_OK != status)
 		{
-			return SENSOR_ERROR_WRITE;
+			return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 		}
 
 		if( intsrc == IntA)   /*! Clear SW2 time stamp INTA */
 		{
-			status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
+			status = PCF2131_RegWrite(pSensorHandle,
 					PCF2131_INT_A_MASK2, PCF2131_TS2_ENB_MASK_VALUE, PCF2131_REG_MASK,repeatedStart);
 		}
 		else  /*! Clear SW2 time stamp INTB */
 		{
-			status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
+			status = PCF2131_RegWrite(pSensorHandle,
 					PCF2131_INT_B_MASK2, PCF2131_TS2_ENB_MASK_VALUE, PCF2131_REG_MASK,repeatedStart);
 		}
 		if (ARM_DRIVER_OK != status)
 		{
-			return SENSOR_ERROR_WRITE;
+			return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 		}
 		break;
 	case sw3Ts:   /*! SW3 time stamp INT Enable */
-		status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_CTRL5, (uint8_t)(intEnable << PCF2131_CTRL5_TSIE3_SHIFT ), PCF2131_CTRL5_TSIE3_MASK,repeatedStart);
 		if (ARM_DRIVER_OK != status)
 		{
-			return SENSOR_ERROR_WRITE;
+			return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 		}
 
 		if( intsrc == IntA)   /*! Clear SW3 time stamp INTA */
 		{
-			status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
+			status = PCF2131_RegWrite(pSensorHandle,
 					PCF2131_INT_A_MASK2, PCF2131_TS3_ENB_MASK_VALUE, PCF2131_REG_MASK,repeatedStart);
 		}
 		else  /*! Clear SW3 time stamp INTB */
 		{
-			status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
+			status = PCF2131_RegWrite(pSensorHandle,
 					PCF2131_INT_B_MASK2, PCF2131_TS3_ENB_MASK_VALUE, PCF2131_REG_MASK,repeatedStart);
 		}
 
 		if (ARM_DRIVER_OK != status)
 		{
-			return SENSOR_ERROR_WRITE;
+			return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 		}
 		break;
 	case sw4Ts:  /*! SW4 time stamp INT Enable */
-		status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_CTRL5, (uint8_t)(intEnable << PCF2131_CTRL5_TSIE4_SHIFT ), PCF2131_CTRL5_TSIE4_MASK,repeatedStart);
 		if (ARM_DRIVER_OK != status)
 		{
-			return SENSOR_ERROR_WRITE;
+			return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 		}
 
 		if( intsrc == IntA)   /*! Clear SW4 time stamp INTA */
 		{
-			status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
+			status = PCF2131_RegWrite(pSensorHandle,
 					PCF2131_INT_A_MASK2, PCF2131_TS4_ENB_MASK_VALUE, PCF2131_REG_MASK,repeatedStart);
 		}
 		else  /*! Clear SW4 time stamp INTB */
 		{
-			status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
+			status = PCF2131_RegWrite(pSensorHandle,
 					PCF2131_INT_B_MASK2, PCF2131_TS4_ENB_MASK_VALUE, PCF2131_REG_MASK,repeatedStart);
 		}
 		if (ARM_DRIVER_OK != status)
 		{
-			return SENSOR_ERROR_WRITE;
+			return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 		}
 		break;
 	default:
@@ -1014,37 +1516,41 @@ int32_t  PCF2131_SW_TsInt_Disable(pcf2131_sensorhandle_t *pSensorHandle, SwTsNum
 	switch(swtsnum)
 	{
 	case sw1Ts:   /*! SW1 time stamp INT Disable */
-		status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_CTRL5, (uint8_t)(intDisable << PCF2131_CTRL5_TSIE1_SHIFT ), PCF2131_CTRL5_TSIE1_MASK,repeatedStart);
 		break;
 	case sw2Ts:  /*! SW2 time stamp INT Disable */
-		status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_CTRL5, (uint8_t)(intDisable << PCF2131_CTRL5_TSIE2_SHIFT), PCF2131_CTRL5_TSIE2_MASK,repeatedStart);
 		break;
 	case sw3Ts:   /*! SW3 time stamp INT Disable */
-		status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_CTRL5, (uint8_t)(intDisable << PCF2131_CTRL5_TSIE3_SHIFT), PCF2131_CTRL5_TSIE3_MASK,repeatedStart);
 		break;
 	case sw4Ts:  /*! SW4 time stamp INT Disable */
-		status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_CTRL5, (uint8_t)(intDisable << PCF2131_CTRL5_TSIE4_SHIFT), PCF2131_CTRL5_TSIE4_MASK,repeatedStart);
 		break;
 	default:
 		return SENSOR_ERROR_INVALID_PARAM;
 	}
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
+	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_INT_A_MASK1,(INT_MASK << swtsnum ), INT_MASK << swtsnum,repeatedStart);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 	}
 
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_INT_B_MASK1, (INT_MASK << swtsnum ), INT_MASK << swtsnum,repeatedStart);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 	}
 
 	return SENSOR_ERROR_NONE;
@@ -1069,27 +1575,27 @@ int32_t PCF2131_Clear_SW_TsInt(pcf2131_sensorhandle_t *pSensorHandle, SwTsNum sw
 	switch (swtsnum)
 	{
 	case sw1Ts: /* Clear SW1 Time Stamp Interrupt */
-		status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_CTRL4, (uint8_t)(intClear << PCF2131_CTRL4_TSF1_SHIFT), PCF2131_CTRL4_TSF1_MASK,repeatedStart);
 		break;
 	case sw2Ts: /* Clear SW2 Time Stamp Interrupt */
-		status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_CTRL4, (uint8_t)(intClear << PCF2131_CTRL4_TSF2_SHIFT), PCF2131_CTRL4_TSF2_MASK,repeatedStart);
 		break;
 	case sw3Ts: /* Clear SW3 Time Stamp Interrupt */
-		status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_CTRL4, (uint8_t)(intClear << PCF2131_CTRL4_TSF3_SHIFT), PCF2131_CTRL4_TSF3_MASK,repeatedStart);
 		break;
 	case sw4Ts: /* Clear SW4 Time Stamp Interrupt */
-		status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_CTRL4, (uint8_t)(intClear << PCF2131_CTRL4_TSF4_SHIFT), PCF2131_CTRL4_TSF4_MASK,repeatedStart);
 		break;
 	default:
-		break;
+		return SENSOR_ERROR_INVALID_PARAM;
 	}
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 	}
 
 	return SENSOR_ERROR_NONE;
@@ -1117,7 +1623,7 @@ int32_t PCF2131_Check_SW_TsInt(pcf2131_sensorhandle_t *pSensorHandle, SwTsNum sw
 			PCF2131_CTRL4, PCF2131_REG_SIZE_BYTE, (uint8_t *)&Ctrl4_Reg);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_READ;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_READ);
 	}
 
 	switch (swtsnum)
@@ -1135,7 +1641,7 @@ int32_t PCF2131_Check_SW_TsInt(pcf2131_sensorhandle_t *pSensorHandle, SwTsNum sw
 		*pSwIntState = Ctrl4_Reg.b.tsf4 ;
 		break;
 	default:
-		break;
+		return SENSOR_ERROR_INVALID_PARAM;
 	}
 	return SENSOR_ERROR_NONE;
 }
@@ -1157,12 +1663,12 @@ int32_t PCF2131_Clear_AlarmInt(pcf2131_sensorhandle_t *pSensorHandle)
 	}
 
 	/*! Clear Alarm flag */
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_CTRL2, (uint8_t)(intClear << PCF2131_CTRL2_AF_SHIFT), PCF2131_CTRL2_AF_MASK,repeatedStart);
 
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 	}
 
 	return SENSOR_ERROR_NONE;
@@ -1191,7 +1697,7 @@ int32_t PCF2131_Check_AlarmInt(pcf2131_sensorhandle_t *pSensorHandle, IntState *
 
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_READ;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_READ);
 	}
 
 	*pAlarmState = Ctrl2_Reg.b.af ;
@@ -1215,81 +1721,555 @@ int32_t PCF2131_AlarmInt_Enable(pcf2131_sensorhandle_t *pSensorHandle, IntSrc in
 		return SENSOR_ERROR_INIT;
 	}
 
-	/*! Enable/Disable Alarm */
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
-			PCF2131_CTRL2, (uint8_t)(intEnable << PCF2131_CTRL2_AIE_SHIFT), PCF2131_CTRL2_AIE_MASK,repeatedStart);
+	/*! Enable/Disable Alarm */
+	status = PCF2131_RegWrite(pSensorHandle,
+			PCF2131_CTRL2, (uint8_t)(intEnable << PCF2131_CTRL2_AIE_SHIFT), PCF2131_CTRL2_AIE_MASK,repeatedStart);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
+	}
+
+	switch(alarmtype)
+	{
+	case A_Seconds:
+		/*! Enable/Disable Second Alarm */
+		status = PCF2131_RegWrite(pSensorHandle,
+				PCF2131_SECOND_ALARM, (uint8_t)( 0 << PCF2131_AE_S_SHIFT), PCF2131_AE_S_MASK,repeatedStart);
+		if (ARM_DRIVER_OK != status)
+		{
+			return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
+		}
+	case A_Minute:
+		/*! Enable/Disable Minute Alarm */
+		status = PCF2131_RegWrite(pSensorHandle,
+				PCF2131_MINUTE_ALARM, (uint8_t)( 0 << PCF2131_AE_M_SHIFT), PCF2131_AE_M_MASK,repeatedStart);
+		if (ARM_DRIVER_OK != status)
+		{
+			return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
+		}
+	case A_Hour:
+		/*! Enable/Disable Hour Alarm */
+		status = PCF2131_RegWrite(pSensorHandle,
+				PCF2131_HOUR_ALARM, (uint8_t)( 0 << PCF2131_AE_H_SHIFT), PCF2131_AE_H_MASK,repeatedStart);
+		if (ARM_DRIVER_OK != status)
+		{
+			return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
+		}
+	case A_Day:
+		/*! Enable/Disable Day Alarm */
+		status = PCF2131_RegWrite(pSensorHandle,
+				PCF2131_DAY_ALARM, (uint8_t)( 0 << PCF2131_AE_D_SHIFT), PCF2131_AE_D_MASK,repeatedStart);
+		if (ARM_DRIVER_OK != status)
+		{
+			return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
+		}
+	case A_Weekday:
+		/*! Enable/Disable WeekDay Alarm */
+		status = PCF2131_RegWrite(pSensorHandle,
+				PCF2131_WEEKDAY_ALARM, (uint8_t)( 0 << PCF2131_AE_W_SHIFT), PCF2131_AE_W_MASK,repeatedStart);
+		if (ARM_DRIVER_OK != status)
+		{
+			return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
+		}
+	}
+
+	if( intsrc == IntA)   /*! clear Second Interrupt Mask on INTA */
+	{
+		status = PCF2131_RegWrite(pSensorHandle,
+				PCF2131_INT_A_MASK1, PCF2131_AIE_ENB_MASK_VALUE, PCF2131_REG_MASK,repeatedStart);
+	}
+	else  /*! clear Second Interrupt Mask on INTB */
+	{
+		status = PCF2131_RegWrite(pSensorHandle,
+				PCF2131_INT_B_MASK1, PCF2131_AIE_ENB_MASK_VALUE, PCF2131_REG_MASK,repeatedStart);
+	}
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_AlarmInt_Disable(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	int32_t status;
+
+	/*! Validate for the correct handle and Interrupt status read variable.*/
+	if (pSensorHandle == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/*! Enable/Disable Alarm */
+	status = PCF2131_RegWrite(pSensorHandle,
+			PCF2131_CTRL2, (uint8_t)(intDisable << PCF2131_CTRL2_AIE_SHIFT), PCF2131_CTRL2_AIE_MASK,repeatedStart);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_GetAlarmTime(pcf2131_sensorhandle_t *pSensorHandle, const registerreadlist_t *pcf2131alarmdata , pcf2131_alarmdata_t *alarmtime)
+{
+	int32_t status;
+	Mode12h_24h mode12_24;
+
+	/*! Validate for the correct handle and Alarm read variable.*/
+	if ((pSensorHandle == NULL) || (alarmtime == NULL))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/*! The read list must not run past the alarm structure.*/
+	if (!PCF2131_ReadListFits(pcf2131alarmdata, PCF2131_ALARM_TIME_SIZE_BYTE))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Get Alarm time.*/
+	status = PCF2131_ReadData(pSensorHandle, pcf2131alarmdata, ( uint8_t *)alarmtime);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
+
+	/*! after read convert BCD to Decimal */
+	alarmtime->second = BcdToDecimal(alarmtime->second & PCF2131_SECONDS_ALARM_MASK) ;
+	alarmtime->minutes = BcdToDecimal(alarmtime->minutes & PCF2131_MINUTES_ALARM_MASK) ;
+	status = PCF2131_12h_24h_Mode_Get(pSensorHandle, &mode12_24);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
+	if(mode12_24 ==  mode24H)
+	{
+		alarmtime->hours = BcdToDecimal(alarmtime->hours & PCF2131_HOURS_ALARM_MASK) ;
+		alarmtime->ampm = h24;
+	}
+	else   /* Set AM/PM */
+	{
+		if( (alarmtime->hours >> 5) & 0x01 )
+			alarmtime->ampm = PM;
+		else
+			alarmtime->ampm = AM;
+		alarmtime->hours =  BcdToDecimal(alarmtime->hours & PCF2131_HOURS_ALARM_MASK_12H);
+	}
+	alarmtime->days = BcdToDecimal(alarmtime->days & PCF2131_DAYS_ALARM_MASK);
+	alarmtime->weekdays = BcdToDecimal(alarmtime->weekdays & PCF2131_WEEKDAYS_ALARM_MASK);
+
+	return SENSOR_ERROR_NONE;
+}
+
+
+int32_t PCF2131_SetAlarmTime(pcf2131_sensorhandle_t *pSensorHandle, pcf2131_alarmdata_t *alarmtime)
+{
+	int32_t status;
+
+
+	/*! Validate for the correct handle and Alarm time read variable.*/
+	if ((pSensorHandle == NULL) || (alarmtime == NULL))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/*! Set Alarm Second.*/
+	status = PCF2131_RegWrite(pSensorHandle,
+			PCF2131_SECOND_ALARM, DecimaltoBcd(alarmtime->second & PCF2131_SECONDS_ALARM_MASK), PCF2131_SECONDS_ALARM_MASK,repeatedStart);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
+	}
+
+	/*! Set Alarm Minute.*/
+	status = PCF2131_RegWrite(pSensorHandle,
+			PCF2131_MINUTE_ALARM, DecimaltoBcd(alarmtime->minutes & PCF2131_MINUTES_ALARM_MASK), PCF2131_MINUTES_ALARM_MASK,repeatedStart);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
+	}
+
+	/*! Update AM/PM Bit.*/
+	if(alarmtime->ampm == AM)
+	{
+		alarmtime->hours = DecimaltoBcd(alarmtime->hours & PCF2131_HOURS_ALARM_MASK_12H);
+		alarmtime->hours = ((alarmtime->hours) & (~(PM << PCF2131_AM_PM_SHIFT)));
+	}
+	else if(alarmtime->ampm == PM)
+	{
+		alarmtime->hours = DecimaltoBcd(alarmtime->hours & PCF2131_HOURS_ALARM_MASK_12H);
+		alarmtime->hours = (alarmtime->hours | (PM << PCF2131_AM_PM_SHIFT));
+	}
+	else
+		alarmtime->hours = DecimaltoBcd(alarmtime->hours & PCF2131_HOURS_MASK);
+
+	/*! Set Alarm Hours.*/
+	status = PCF2131_RegWrite(pSensorHandle,
+			PCF2131_HOUR_ALARM, alarmtime->hours , PCF2131_HOURS_ALARM_MASK,repeatedStart);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
+	}
+
+	/*! Set Alarm Day.*/
+	status = PCF2131_RegWrite(pSensorHandle,
+			PCF2131_DAY_ALARM, DecimaltoBcd(alarmtime->days & PCF2131_DAYS_ALARM_MASK) , PCF2131_DAYS_ALARM_MASK,repeatedStart);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
+	}
+
+	/*! Set Alarm WeekDay.*/
+	status = PCF2131_RegWrite(pSensorHandle,
+			PCF2131_WEEKDAY_ALARM, DecimaltoBcd(alarmtime->weekdays & PCF2131_WEEKDAYS_ALARM_MASK) , PCF2131_WEEKDAYS_ALARM_MASK,repeatedStart);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_Bat_SwitchOverTS(pcf2131_sensorhandle_t *pSensorHandle, BatSoTs is_enabled)
+{
+	int32_t status;
+
+	/*! Validate for the correct handle.*/
+	if (pSensorHandle == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/*! SwitchOver TimeStamp Enable/Disable */
+	status = PCF2131_RegWrite(pSensorHandle,
+			PCF2131_CTRL3, (uint8_t)(((is_enabled == SoTsEnable) ? intEnable : intDisable) << PCF2131_CTRL3_BTSE_SHIFT),
+			PCF2131_CTRL3_BTSE_MASK,repeatedStart);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_Bat_SwitchOverTS_Disable(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	int32_t status;
+
+	/*! Validate for the correct handle.*/
+	if (pSensorHandle == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/*! SwitchOver TimeStamp Enable/Disable */
+	status = PCF2131_RegWrite(pSensorHandle,
+			PCF2131_CTRL3, (uint8_t)(intDisable << PCF2131_CTRL3_BTSE_SHIFT ), PCF2131_CTRL3_BTSE_MASK,repeatedStart);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_Bat_SwitchOverTS_Enable(pcf2131_sensorhandle_t *pSensorHandle,IntSrc intsrc)
+{
+	int32_t status;
+
+	/*! Validate for the correct handle.*/
+	if (pSensorHandle == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/*! SwitchOver TimeStamp Enable/Disable */
+	status = PCF2131_RegWrite(pSensorHandle,
+			PCF2131_CTRL3, (uint8_t)( intEnable << PCF2131_CTRL3_BTSE_SHIFT ), PCF2131_CTRL3_BTSE_MASK,repeatedStart);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+int32_t PCF2131_Clear_SwitchOverInt(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	int32_t status;
+
+	/*! Validate for the correct handle.*/
+	if (pSensorHandle == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/*! clear switchOver flag */
+	status = PCF2131_RegWrite(pSensorHandle,
+			PCF2131_CTRL3, (uint8_t)(intClear << PCF2131_CTRL3_BF_SHIFT), PCF2131_CTRL3_BF_MASK,repeatedStart);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
+	}
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_Check_SwitchOverInt(pcf2131_sensorhandle_t *pSensorHandle, IntStatus *pSoStatus)
+{
+	int32_t status;
+	PCF2131_CTRL_3 Ctrl3_Reg;
+
+	/*! Validate for the correct handle and Switch over status read variable.*/
+	if ((pSensorHandle == NULL) || (pSoStatus == NULL))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/*! Get switchOver flag */
+	status = Register_I2C_Read(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
+			PCF2131_CTRL3, PCF2131_REG_SIZE_BYTE, (uint8_t *)&Ctrl3_Reg);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_READ);
+	}
+
+	*pSoStatus = Ctrl3_Reg.b.bf;
+
+	return SENSOR_ERROR_NONE;
+}
+int32_t PCF2131_Bat_SwitchOverInt(pcf2131_sensorhandle_t *pSensorHandle, IntStatus is_enabled)
+{
+	int32_t status;
+
+	/*! Validate for the correct handle.*/
+	if (pSensorHandle == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/*! SwitchOver Interrupt Enable/Disable */
+	status = PCF2131_RegWrite(pSensorHandle,
+			PCF2131_CTRL3, (uint8_t)(((is_enabled == intEnable) ? intEnable : intDisable ) << PCF2131_CTRL3_BIE_SHIFT ), PCF2131_CTRL3_BIE_MASK,repeatedStart);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+int32_t PCF2131_Check_LowBatStatusEnable(pcf2131_sensorhandle_t *pSensorHandle)
+{
+
+	int32_t status;
+
+	/*! Validate for the correct handle */
+	if (pSensorHandle == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/*!  */
+	status = PCF2131_RegWrite(pSensorHandle,
+			PCF2131_CTRL2, (uint8_t)(0x00 << PCF2131_CTRL3_PWRMNG_SHIFT), PCF2131_CTRL3_PWRMNG_MASK,repeatedStart);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_Check_LowBatStatus(pcf2131_sensorhandle_t *pSensorHandle, IntStatus *pLowBatStatus)
+{
+	int32_t status;
+	PCF2131_CTRL_3 Ctrl3_Reg;
+
+	/*! Validate for the correct handle and Low Battery status read variable.*/
+	if ((pSensorHandle == NULL) || ( pLowBatStatus == NULL))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/*! Get Low battery flag */
+	status = Register_I2C_Read(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
+			PCF2131_CTRL3, PCF2131_REG_SIZE_BYTE, (uint8_t *)&Ctrl3_Reg);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_READ);
+	}
+	*pLowBatStatus = Ctrl3_Reg.b.blf;
+
+	return SENSOR_ERROR_NONE;
+}
+int32_t PCF2131_LowBatInt(pcf2131_sensorhandle_t *pSensorHandle, LowBatInt is_enabled)
+{
+	int32_t status;
+
+	/*! Validate for the correct handle.*/
+	if (pSensorHandle == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/*! Low Bat Interrupt Enable/Disable */
+	status = PCF2131_RegWrite(pSensorHandle,
+			PCF2131_CTRL3, (uint8_t)(((is_enabled == lbIntEnable) ? lbIntEnable : lbIntDisable) << PCF2131_CTRL3_BLIE_SHIFT ), PCF2131_CTRL3_BLIE_MASK,repeatedStart);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_Watchdog_Config(pcf2131_sensorhandle_t *pSensorHandle, WdClkSrc clksrc, uint8_t period)
+{
+	int32_t status;
+	uint8_t wdCtl;
+
+	/*! Validate for the correct handle and watchdog period.*/
+	if ((pSensorHandle == NULL) || (period == 0))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/*! Keep the interrupt mode, it also applies to the minute/second interrupt */
+	status = Register_I2C_Read(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
+			PCF2131_WATCHDOG_TIMER_CTL, PCF2131_REG_SIZE_BYTE, &wdCtl);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_READ);
 	}
 
-	switch(alarmtype)
+	/*! Pre-format the control and kick values once, so enable/disable/kick never read the RTC. */
+	pSensorHandle->wdCtl = (uint8_t)(((clksrc << PCF2131_WD_CTL_TF_SHIFT) & PCF2131_WD_CTL_TF_MASK) | (wdCtl & PCF2131_WD_TI_TP_MASK));
+	pSensorHandle->wdKickValue = period;
+
+	/*! Watchdog source clock, watchdog disabled */
+	status = PCF2131_RegWrite(pSensorHandle,
+			PCF2131_WATCHDOG_TIMER_CTL, pSensorHandle->wdCtl, 0, repeatedStart);
+	if (ARM_DRIVER_OK != status)
 	{
-	case A_Seconds:
-		/*! Enable/Disable Second Alarm */
-		status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
-				PCF2131_SECOND_ALARM, (uint8_t)( 0 << PCF2131_AE_S_SHIFT), PCF2131_AE_S_MASK,repeatedStart);
-		if (ARM_DRIVER_OK != status)
-		{
-			return SENSOR_ERROR_WRITE;
-		}
-	case A_Minute:
-		/*! Enable/Disable Minute Alarm */
-		status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
-				PCF2131_MINUTE_ALARM, (uint8_t)( 0 << PCF2131_AE_M_SHIFT), PCF2131_AE_M_MASK,repeatedStart);
-		if (ARM_DRIVER_OK != status)
-		{
-			return SENSOR_ERROR_WRITE;
-		}
-	case A_Hour:
-		/*! Enable/Disable Hour Alarm */
-		status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
-				PCF2131_HOUR_ALARM, (uint8_t)( 0 << PCF2131_AE_H_SHIFT), PCF2131_AE_H_MASK,repeatedStart);
-		if (ARM_DRIVER_OK != status)
-		{
-			return SENSOR_ERROR_WRITE;
-		}
-	case A_Day:
-		/*! Enable/Disable Day Alarm */
-		status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
-				PCF2131_DAY_ALARM, (uint8_t)( 0 << PCF2131_AE_D_SHIFT), PCF2131_AE_D_MASK,repeatedStart);
-		if (ARM_DRIVER_OK != status)
-		{
-			return SENSOR_ERROR_WRITE;
-		}
-	case A_Weekday:
-		/*! Enable/Disable WeekDay Alarm */
-		status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
-				PCF2131_WEEKDAY_ALARM, (uint8_t)( 0 << PCF2131_AE_W_SHIFT), PCF2131_AE_W_MASK,repeatedStart);
-		if (ARM_DRIVER_OK != status)
-		{
-			return SENSOR_ERROR_WRITE;
-		}
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 	}
 
-	if( intsrc == IntA)   /*! clear Second Interrupt Mask on INTA */
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_Watchdog_Enable(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	int32_t status;
+	uint8_t wdReg[PCF2131_WD_SIZE_BYTE];
+
+	/*! Validate for the correct handle */
+	if (pSensorHandle == NULL)
 	{
-		status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
-				PCF2131_INT_A_MASK1, PCF2131_AIE_ENB_MASK_VALUE, PCF2131_REG_MASK,repeatedStart);
+		return SENSOR_ERROR_INVALID_PARAM;
 	}
-	else  /*! clear Second Interrupt Mask on INTB */
+
+	/*! Check whether sensor handle is initialized and watchdog is configured.*/
+	if ((pSensorHandle->isInitialized != true) || (pSensorHandle->wdKickValue == 0))
 	{
-		status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
-				PCF2131_INT_B_MASK1, PCF2131_AIE_ENB_MASK_VALUE, PCF2131_REG_MASK,repeatedStart);
+		return SENSOR_ERROR_INIT;
 	}
+
+	/*! Set WD_CD and load the period in one burst (0x35, 0x36) */
+	wdReg[0] = pSensorHandle->wdCtl | PCF2131_WD_CTL_WD_CD_MASK;
+	wdReg[1] = pSensorHandle->wdKickValue;
+	status = Register_I2C_BlockWrite(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
+			PCF2131_WATCHDOG_TIMER_CTL, wdReg, PCF2131_WD_SIZE_BYTE);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 	}
 
 	return SENSOR_ERROR_NONE;
 }
 
-int32_t PCF2131_AlarmInt_Disable(pcf2131_sensorhandle_t *pSensorHandle)
+int32_t PCF2131_Watchdog_Disable(pcf2131_sensorhandle_t *pSensorHandle)
 {
 	int32_t status;
 
-	/*! Validate for the correct handle and Interrupt status read variable.*/
+	/*! Validate for the correct handle */
 	if (pSensorHandle == NULL)
 	{
 		return SENSOR_ERROR_INVALID_PARAM;
@@ -1301,72 +2281,69 @@ int32_t PCF2131_AlarmInt_Disable(pcf2131_sensorhandle_t *pSensorHandle)
 		return SENSOR_ERROR_INIT;
 	}
 
-	/*! Enable/Disable Alarm */
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
-			PCF2131_CTRL2, (uint8_t)(intDisable << PCF2131_CTRL2_AIE_SHIFT), PCF2131_CTRL2_AIE_MASK,repeatedStart);
+	/*! Clear WD_CD, keep source clock and interrupt mode */
+	status = PCF2131_RegWrite(pSensorHandle,
+			PCF2131_WATCHDOG_TIMER_CTL, pSensorHandle->wdCtl, 0, repeatedStart);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 	}
 
 	return SENSOR_ERROR_NONE;
 }
 
-int32_t PCF2131_GetAlarmTime(pcf2131_sensorhandle_t *pSensorHandle, const registerreadlist_t *pcf2131alarmdata , pcf2131_alarmdata_t *alarmtime)
+int32_t PCF2131_Watchdog_Kick(pcf2131_sensorhandle_t *pSensorHandle)
 {
 	int32_t status;
-	Mode12h_24h mode12_24;
 
-	/*! Validate for the correct handle and Alarm read variable.*/
-	if ((pSensorHandle == NULL) || (alarmtime == NULL))
+	/*! Validate for the correct handle */
+	if (pSensorHandle == NULL)
 	{
 		return SENSOR_ERROR_INVALID_PARAM;
 	}
 
-	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
-	if (pSensorHandle->isInitialized != true)
+	/*! Check whether sensor handle is initialized and watchdog is configured.*/
+	if ((pSensorHandle->isInitialized != true) || (pSensorHandle->wdKickValue == 0))
 	{
 		return SENSOR_ERROR_INIT;
 	}
 
-	/*! Get Alarm time.*/
-	status = PCF2131_ReadData(pSensorHandle, pcf2131alarmdata, ( uint8_t *)alarmtime);
+	/*! Reload the watchdog period, mask 0 so there is no read-modify-write */
+	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
+			PCF2131_WATCHDOG_TIMER_VAL, pSensorHandle->wdKickValue, 0, repeatedStart);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 	}
 
-	/*! after read convert BCD to Decimal */
-	alarmtime->second = BcdToDecimal(alarmtime->second & PCF2131_SECONDS_ALARM_MASK) ;
-	alarmtime->minutes = BcdToDecimal(alarmtime->minutes & PCF2131_MINUTES_ALARM_MASK) ;
-	PCF2131_12h_24h_Mode_Get(pSensorHandle, &mode12_24);
-	if(mode12_24 ==  mode24H)
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_Watchdog_Piggyback(pcf2131_sensorhandle_t *pSensorHandle, bool is_enabled)
+{
+	/*! Validate for the correct handle */
+	if (pSensorHandle == NULL)
 	{
-		alarmtime->hours = BcdToDecimal(alarmtime->hours & PCF2131_HOURS_ALARM_MASK) ;
-		alarmtime->ampm = h24;
+		return SENSOR_ERROR_INVALID_PARAM;
 	}
-	else   /* Set AM/PM */
+
+	/*! Check whether sensor handle is initialized and watchdog is configured.*/
+	if ((pSensorHandle->isInitialized != true) || (pSensorHandle->wdKickValue == 0))
 	{
-		if( (alarmtime->hours >> 5) & 0x01 )
-			alarmtime->ampm = PM;
-		else
-			alarmtime->ampm = AM;
-		alarmtime->hours =  BcdToDecimal(alarmtime->hours & PCF2131_HOURS_ALARM_MASK_12H);
+		return SENSOR_ERROR_INIT;
 	}
-	alarmtime->days = BcdToDecimal(alarmtime->days & PCF2131_DAYS_ALARM_MASK);
-	alarmtime->weekdays = BcdToDecimal(alarmtime->weekdays & PCF2131_WEEKDAYS_ALARM_MASK);
+
+	pSensorHandle->wdPiggyback = is_enabled;
 
 	return SENSOR_ERROR_NONE;
 }
 
-
-int32_t PCF2131_SetAlarmTime(pcf2131_sensorhandle_t *pSensorHandle, pcf2131_alarmdata_t *alarmtime)
+int32_t PCF2131_WatchdogInt_Enable(pcf2131_sensorhandle_t *pSensorHandle, IntSrc intsrc)
 {
 	int32_t status;
 
-
-	/*! Validate for the correct handle and Alarm time read variable.*/
-	if ((pSensorHandle == NULL) || (alarmtime == NULL))
+	/*! Validate for the correct handle */
+	if (pSensorHandle == NULL)
 	{
 		return SENSOR_ERROR_INVALID_PARAM;
 	}
@@ -1377,68 +2354,64 @@ int32_t PCF2131_SetAlarmTime(pcf2131_sensorhandle_t *pSensorHandle, pcf2131_alar
 		return SENSOR_ERROR_INIT;
 	}
 
-	/*! Set Alarm Second.*/
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
-			PCF2131_SECOND_ALARM, DecimaltoBcd(alarmtime->second & PCF2131_SECONDS_ALARM_MASK), PCF2131_SECONDS_ALARM_MASK,repeatedStart);
-	if (ARM_DRIVER_OK != status)
+	if( intsrc == IntA)   /*! clear Watchdog Interrupt Mask on INTA */
 	{
-		return SENSOR_ERROR_WRITE;
+		status = PCF2131_RegWrite(pSensorHandle,
+				PCF2131_INT_A_MASK1, (INT_UNMASK << PCF2131_WD_CD_SHIFT), PCF2131_WD_CD_DIS_MASK, repeatedStart);
 	}
-
-	/*! Set Alarm Minute.*/
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
-			PCF2131_MINUTE_ALARM, DecimaltoBcd(alarmtime->minutes & PCF2131_MINUTES_ALARM_MASK), PCF2131_MINUTES_ALARM_MASK,repeatedStart);
-	if (ARM_DRIVER_OK != status)
+	else  /*! clear Watchdog Interrupt Mask on INTB */
 	{
-		return SENSOR_ERROR_WRITE;
+		status = PCF2131_RegWrite(pSensorHandle,
+				PCF2131_INT_B_MASK1, (INT_UNMASK << PCF2131_WD_CD_SHIFT), PCF2131_WD_CD_DIS_MASK, repeatedStart);
 	}
-
-	/*! Update AM/PM Bit.*/
-	if(alarmtime->ampm == AM)
+	if (ARM_DRIVER_OK != status)
 	{
-		alarmtime->hours = DecimaltoBcd(alarmtime->hours & PCF2131_HOURS_ALARM_MASK_12H);
-		alarmtime->hours = ((alarmtime->hours) & (~(PM << PCF2131_AM_PM_SHIFT)));
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 	}
-	else if(alarmtime->ampm == PM)
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_WatchdogInt_Disable(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	int32_t status;
+
+	/*! Validate for the correct handle */
+	if (pSensorHandle == NULL)
 	{
-		alarmtime->hours = DecimaltoBcd(alarmtime->hours & PCF2131_HOURS_ALARM_MASK_12H);
-		alarmtime->hours = (alarmtime->hours | (PM << PCF2131_AM_PM_SHIFT));
+		return SENSOR_ERROR_INVALID_PARAM;
 	}
-	else
-		alarmtime->hours = DecimaltoBcd(alarmtime->hours & PCF2131_HOURS_MASK);
 
-	/*! Set Alarm Hours.*/
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
-			PCF2131_HOUR_ALARM, alarmtime->hours , PCF2131_HOURS_ALARM_MASK,repeatedStart);
-	if (ARM_DRIVER_OK != status)
+	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
+	if (pSensorHandle->isInitialized != true)
 	{
-		return SENSOR_ERROR_WRITE;
+		return SENSOR_ERROR_INIT;
 	}
 
-	/*! Set Alarm Day.*/
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
-			PCF2131_DAY_ALARM, DecimaltoBcd(alarmtime->days & PCF2131_DAYS_ALARM_MASK) , PCF2131_DAYS_ALARM_MASK,repeatedStart);
+	status = PCF2131_RegWrite(pSensorHandle,
+			PCF2131_INT_A_MASK1, (INT_MASK << PCF2131_WD_CD_SHIFT), PCF2131_WD_CD_DIS_MASK, repeatedStart);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 	}
 
-	/*! Set Alarm WeekDay.*/
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,pSensorHandle->slaveAddress,
-			PCF2131_WEEKDAY_ALARM, DecimaltoBcd(alarmtime->weekdays & PCF2131_WEEKDAYS_ALARM_MASK) , PCF2131_WEEKDAYS_ALARM_MASK,repeatedStart);
+	status = PCF2131_RegWrite(pSensorHandle,
+			PCF2131_INT_B_MASK1, (INT_MASK << PCF2131_WD_CD_SHIFT), PCF2131_WD_CD_DIS_MASK, repeatedStart);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 	}
 
 	return SENSOR_ERROR_NONE;
 }
-int32_t PCF2131_Bat_SwitchOverTS_Disable(pcf2131_sensorhandle_t *pSensorHandle)
+
+int32_t PCF2131_Check_WatchdogInt(pcf2131_sensorhandle_t *pSensorHandle, IntState *pWdState)
 {
 	int32_t status;
+	PCF2131_CTRL_2 Ctrl2_Reg;
 
-	/*! Validate for the correct handle.*/
-	if (pSensorHandle == NULL)
+	/*! Validate for the correct handle and Watchdog status read variable.*/
+	if ((pSensorHandle == NULL) || (pWdState == NULL))
 	{
 		return SENSOR_ERROR_INVALID_PARAM;
 	}
@@ -1449,22 +2422,24 @@ int32_t PCF2131_Bat_SwitchOverTS_Disable(pcf2131_sensorhandle_t *pSensorHandle)
 		return SENSOR_ERROR_INIT;
 	}
 
-	/*! SwitchOver TimeStamp Enable/Disable */
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
-			PCF2131_CTRL3, (uint8_t)(intDisable << PCF2131_CTRL3_BTSE_SHIFT ), PCF2131_CTRL3_BTSE_MASK,repeatedStart);
+	/*! Get Watchdog flag */
+	status = Register_I2C_Read(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
+			PCF2131_CTRL2, PCF2131_REG_SIZE_BYTE, (uint8_t *)&Ctrl2_Reg);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_READ);
 	}
 
+	*pWdState = Ctrl2_Reg.b.wdtf;
+
 	return SENSOR_ERROR_NONE;
 }
 
-int32_t PCF2131_Bat_SwitchOverTS_Enable(pcf2131_sensorhandle_t *pSensorHandle,IntSrc intsrc)
+int32_t PCF2131_ClkOut_Set(pcf2131_sensorhandle_t *pSensorHandle, ClkOutFreq freq)
 {
 	int32_t status;
 
-	/*! Validate for the correct handle.*/
+	/*! Validate for the correct handle */
 	if (pSensorHandle == NULL)
 	{
 		return SENSOR_ERROR_INVALID_PARAM;
@@ -1476,22 +2451,53 @@ int32_t PCF2131_Bat_SwitchOverTS_Enable(pcf2131_sensorhandle_t *pSensorHandle,In
 		return SENSOR_ERROR_INIT;
 	}
 
-	/*! SwitchOver TimeStamp Enable/Disable */
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
-			PCF2131_CTRL3, (uint8_t)( intEnable << PCF2131_CTRL3_BTSE_SHIFT ), PCF2131_CTRL3_BTSE_MASK,repeatedStart);
+	/*! Select CLKOUT frequency, keep temperature measurement period */
+	status = PCF2131_RegWrite(pSensorHandle,
+			PCF2131_CLKOUT_CTL, (uint8_t)(freq << PCF2131_CLKOUT_COF_SHIFT), PCF2131_CLKOUT_COF_MASK, repeatedStart);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 	}
 
 	return SENSOR_ERROR_NONE;
 }
-int32_t PCF2131_Clear_SwitchOverInt(pcf2131_sensorhandle_t *pSensorHandle)
+
+/* Wait for the next rising edge on CLKOUT, a missing CLKOUT fails after maxPolls pin reads. */
+static int32_t PCF2131_WaitClkOutEdge(GENERIC_DRIVER_GPIO *pGPIODriver, void *pClkOutPin, uint32_t maxPolls)
 {
-	int32_t status;
+	uint32_t polls = 0;
 
-	/*! Validate for the correct handle.*/
-	if (pSensorHandle == NULL)
+	while (pGPIODriver->read_pin(pClkOutPin))
+	{
+		if (++polls > maxPolls)
+		{
+			return SENSOR_ERROR_READ;
+		}
+	}
+	while (!pGPIODriver->read_pin(pClkOutPin))
+	{
+		if (++polls > maxPolls)
+		{
+			return SENSOR_ERROR_READ;
+		}
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_ClkOut_Calibrate(pcf2131_sensorhandle_t *pSensorHandle, void *pClkOutPin, uint32_t periods, int32_t *pPpmError)
+{
+	int32_t status, restore;
+	int32_t start;
+	uint32_t edge;
+	uint32_t maxPolls;
+	int64_t measured = 0, expected;
+	uint8_t clkoutCtl;
+	GENERIC_DRIVER_GPIO *pGPIODriver = &Driver_GPIO_KSDK;
+
+	/*! Validate for the correct handle, CLKOUT pin, period count and error read variable.*/
+	if ((pSensorHandle == NULL) || (pClkOutPin == NULL) || (pPpmError == NULL) ||
+			(periods == 0) || (periods > PCF2131_CLKOUT_CAL_MAX_EDGES))
 	{
 		return SENSOR_ERROR_INVALID_PARAM;
 	}
@@ -1502,23 +2508,62 @@ int32_t PCF2131_Clear_SwitchOverInt(pcf2131_sensorhandle_t *pSensorHandle)
 		return SENSOR_ERROR_INIT;
 	}
 
-	/*! clear switchOver flag */
+	/*! Save CLKOUT_ctl and switch CLKOUT to the calibration frequency, bypassing an open transaction */
+	status = Register_I2C_Read(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
+			PCF2131_CLKOUT_CTL, PCF2131_REG_SIZE_BYTE, &clkoutCtl);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_READ);
+	}
 	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
-			PCF2131_CTRL3, (uint8_t)(intClear << PCF2131_CTRL3_BF_SHIFT), PCF2131_CTRL3_BF_MASK,repeatedStart);
+			PCF2131_CLKOUT_CTL, (uint8_t)((clkoutCtl & ~PCF2131_CLKOUT_COF_MASK) | (clkout1024Hz << PCF2131_CLKOUT_COF_SHIFT)), 0, repeatedStart);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
+	}
+
+	pGPIODriver->pin_init(pClkOutPin, GPIO_DIRECTION_IN, NULL, NULL, NULL);
+	maxPolls = CLOCK_GetFreq(kCLOCK_CoreSysClk) / PCF2131_CLKOUT_CAL_FREQ;
+
+	/*! The first rising edge starts the capture, every following one closes a period */
+	status = PCF2131_WaitClkOutEdge(pGPIODriver, pClkOutPin, maxPolls);
+	if (SENSOR_ERROR_NONE == status)
+	{
+		BOARD_SystickStart(&start);
+		for (edge = 0; (edge < periods) && (SENSOR_ERROR_NONE == status); edge++)
+		{
+			status = PCF2131_WaitClkOutEdge(pGPIODriver, pClkOutPin, maxPolls);
+		}
+		measured = BOARD_SystickElapsedTicks(&start);
+	}
+
+	/*! Restore CLKOUT_ctl, a failure counts as any other bus error */
+	restore = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
+			PCF2131_CLKOUT_CTL, clkoutCtl, 0, repeatedStart);
+	if (ARM_DRIVER_OK != restore)
+	{
+		return PCF2131_BusError(pSensorHandle, restore, SENSOR_ERROR_WRITE);
+	}
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
 	}
+
+	/*! ppm error of the core clock against the TCXO, feed it to the SysTick conversions */
+	expected = ((int64_t)CLOCK_GetFreq(kCLOCK_CoreSysClk) * periods) / PCF2131_CLKOUT_CAL_FREQ;
+	*pPpmError = (int32_t)(((measured - expected) * 1000000) / expected);
+	BOARD_SystickSetClockCorrection(*pPpmError);
+
 	return SENSOR_ERROR_NONE;
 }
 
-int32_t PCF2131_Check_SwitchOverInt(pcf2131_sensorhandle_t *pSensorHandle, IntStatus *pSoStatus)
+int32_t PCF2131_ExtTest_Enable(pcf2131_sensorhandle_t *pSensorHandle, void *pClkPin, const pcf2131_extclk_t *pClock)
 {
 	int32_t status;
-	PCF2131_CTRL_3 Ctrl3_Reg;
+	GENERIC_DRIVER_GPIO *pGPIODriver = &Driver_GPIO_KSDK;
 
-	/*! Validate for the correct handle and Switch over status read variable.*/
-	if ((pSensorHandle == NULL) || (pSoStatus == NULL))
+	/*! Validate for the correct handle and clock output.*/
+	if ((pSensorHandle == NULL) || ((pClkPin == NULL) && (pClock == NULL)))
 	{
 		return SENSOR_ERROR_INVALID_PARAM;
 	}
@@ -1529,48 +2574,94 @@ int32_t PCF2131_Check_SwitchOverInt(pcf2131_sensorhandle_t *pSensorHandle, IntSt
 		return SENSOR_ERROR_INIT;
 	}
 
-	/*! Get switchOver flag */
-	status = Register_I2C_Read(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
-			PCF2131_CTRL3, PCF2131_REG_SIZE_BYTE, (uint8_t *)&Ctrl3_Reg);
+	/*! CLKOUT turns into an input first, so the pin is never driven from both sides */
+	status = PCF2131_RegWrite(pSensorHandle,
+			PCF2131_CTRL1, PCF2131_CTRL1_EXT_TEST_MASK, PCF2131_CTRL1_EXT_TEST_MASK, repeatedStart);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_READ;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 	}
 
-	*pSoStatus = Ctrl3_Reg.b.bf;
+	if (pClock != NULL)
+	{
+		pClock->start();
+		pSensorHandle->pExtClock = pClock;
+		return SENSOR_ERROR_NONE;
+	}
+	pGPIODriver->pin_init(pClkPin, GPIO_DIRECTION_OUT, NULL, NULL, NULL);
+	pGPIODriver->clr_pin(pClkPin);
+	pSensorHandle->pExtClkPin = pClkPin;
 
 	return SENSOR_ERROR_NONE;
 }
-int32_t PCF2131_Bat_SwitchOverInt(pcf2131_sensorhandle_t *pSensorHandle, IntStatus is_enabled)
+
+int32_t PCF2131_ExtTest_Clock(pcf2131_sensorhandle_t *pSensorHandle, uint32_t seconds, uint32_t multiple, uint32_t *pAchieved)
 {
-	int32_t status;
+	uint64_t start, next, halfPeriod, elapsed;
+	uint64_t edges = (uint64_t)seconds * PCF2131_EXT_TEST_EDGES_PER_SECOND;
+	uint64_t edge;
+	uint32_t coreFreq = BOARD_SystickGetCoreFreq();
+	int32_t result = 0;
+	GENERIC_DRIVER_GPIO *pGPIODriver = &Driver_GPIO_KSDK;
 
-	/*! Validate for the correct handle.*/
-	if (pSensorHandle == NULL)
+	/*! Validate for the correct handle, second count and acceleration.*/
+	if ((pSensorHandle == NULL) || (seconds == 0) || (seconds > UINT32_MAX / PCF2131_EXT_TEST_EDGES_PER_SECOND) ||
+			(multiple == 0) || (multiple > PCF2131_EXT_TEST_MAX_MULTIPLE))
 	{
 		return SENSOR_ERROR_INVALID_PARAM;
 	}
 
-	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
-	if (pSensorHandle->isInitialized != true)
+	/*! Check whether sensor handle is initialized and in external clock test mode.*/
+	if ((pSensorHandle->isInitialized != true) ||
+			((pSensorHandle->pExtClkPin == NULL) && (pSensorHandle->pExtClock == NULL)))
 	{
 		return SENSOR_ERROR_INIT;
 	}
 
-	/*! SwitchOver Interrupt Enable/Disable */
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
-			PCF2131_CTRL3, (uint8_t)(((is_enabled == intEnable) ? intEnable : intDisable ) << PCF2131_CTRL3_BIE_SHIFT ), PCF2131_CTRL3_BIE_MASK,repeatedStart);
-	if (ARM_DRIVER_OK != status)
+	/*! Half a CLKOUT period at the target rate, in SysTick counts */
+	halfPeriod = (uint64_t)coreFreq / (2U * PCF2131_EXT_TEST_EDGES_PER_SECOND * multiple);
+	start = BOARD_SystickGetTicks();
+	next = start;
+	if (pSensorHandle->pExtClock != NULL)
+	{
+		/*! The timer paces the edges in hardware */
+		result = pSensorHandle->pExtClock->clock(PCF2131_EXT_TEST_EDGES_PER_SECOND * multiple, (uint32_t)edges);
+	}
+	else
+	{
+		for (edge = 0; edge < edges; edge++)
+		{
+			next += halfPeriod;
+			while (BOARD_SystickGetTicks() < next)
+			{
+			}
+			pGPIODriver->set_pin(pSensorHandle->pExtClkPin);
+			next += halfPeriod;
+			while (BOARD_SystickGetTicks() < next)
+			{
+			}
+			pGPIODriver->clr_pin(pSensorHandle->pExtClkPin);
+		}
+	}
+	elapsed = BOARD_SystickGetTicks() - start;
+	if (result != 0)
+	{
+		return (result == -1) ? SENSOR_ERROR_INVALID_PARAM : SENSOR_ERROR_WRITE;
+	}
+
+	if (pAchieved)
 	{
-		return SENSOR_ERROR_WRITE;
+		/*! RTC time clocked over real time taken */
+		*pAchieved = elapsed ? (uint32_t)(((uint64_t)seconds * coreFreq + elapsed / 2) / elapsed) : multiple;
 	}
 
 	return SENSOR_ERROR_NONE;
 }
-int32_t PCF2131_Check_LowBatStatusEnable(pcf2131_sensorhandle_t *pSensorHandle)
-{
 
+int32_t PCF2131_ExtTest_Disable(pcf2131_sensorhandle_t *pSensorHandle)
+{
 	int32_t status;
+	GENERIC_DRIVER_GPIO *pGPIODriver = &Driver_GPIO_KSDK;
 
 	/*! Validate for the correct handle */
 	if (pSensorHandle == NULL)
@@ -1584,24 +2675,34 @@ int32_t PCF2131_Check_LowBatStatusEnable(pcf2131_sensorhandle_t *pSensorHandle)
 		return SENSOR_ERROR_INIT;
 	}
 
-	/*!  */
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
-			PCF2131_CTRL2, (uint8_t)(0x00 << PCF2131_CTRL3_PWRMNG_SHIFT), PCF2131_CTRL3_PWRMNG_MASK,repeatedStart);
+	/*! Release the output before CLKOUT can turn back into an output */
+	if (pSensorHandle->pExtClock)
+	{
+		pSensorHandle->pExtClock->stop();
+		pSensorHandle->pExtClock = NULL;
+	}
+	if (pSensorHandle->pExtClkPin)
+	{
+		pGPIODriver->pin_init(pSensorHandle->pExtClkPin, GPIO_DIRECTION_IN, NULL, NULL, NULL);
+		pSensorHandle->pExtClkPin = NULL;
+	}
+
+	status = PCF2131_RegWrite(pSensorHandle,
+			PCF2131_CTRL1, 0, PCF2131_CTRL1_EXT_TEST_MASK, repeatedStart);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 	}
 
 	return SENSOR_ERROR_NONE;
 }
 
-int32_t PCF2131_Check_LowBatStatus(pcf2131_sensorhandle_t *pSensorHandle, IntStatus *pLowBatStatus)
+int32_t PCF2131_AgingOffset_Set(pcf2131_sensorhandle_t *pSensorHandle, uint8_t code)
 {
 	int32_t status;
-	PCF2131_CTRL_3 Ctrl3_Reg;
 
-	/*! Validate for the correct handle and Low Battery status read variable.*/
-	if ((pSensorHandle == NULL) || ( pLowBatStatus == NULL))
+	/*! Validate for the correct handle and aging offset code.*/
+	if ((pSensorHandle == NULL) || (code > PCF2131_AGING_OFFSET_MAX))
 	{
 		return SENSOR_ERROR_INVALID_PARAM;
 	}
@@ -1612,23 +2713,24 @@ int32_t PCF2131_Check_LowBatStatus(pcf2131_sensorhandle_t *pSensorHandle, IntSta
 		return SENSOR_ERROR_INIT;
 	}
 
-	/*! Get Low battery flag */
-	status = Register_I2C_Read(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
-			PCF2131_CTRL3, PCF2131_REG_SIZE_BYTE, (uint8_t *)&Ctrl3_Reg);
+	/*! Write aging offset, mask 0 so there is no read-modify-write */
+	status = PCF2131_RegWrite(pSensorHandle,
+			PCF2131_AGING_OFFSET, (uint8_t)(code << PCF2131_AGING_OFFSET_AO_SHIFT), 0, repeatedStart);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_READ;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_WRITE);
 	}
-	*pLowBatStatus = Ctrl3_Reg.b.blf;
 
 	return SENSOR_ERROR_NONE;
 }
-int32_t PCF2131_LowBatInt(pcf2131_sensorhandle_t *pSensorHandle, LowBatInt is_enabled)
+
+int32_t PCF2131_AgingOffset_Get(pcf2131_sensorhandle_t *pSensorHandle, uint8_t *pCode)
 {
 	int32_t status;
+	PCF2131_AGING_OFFSET_REG agingReg;
 
-	/*! Validate for the correct handle.*/
-	if (pSensorHandle == NULL)
+	/*! Validate for the correct handle and aging offset read variable.*/
+	if ((pSensorHandle == NULL) || (pCode == NULL))
 	{
 		return SENSOR_ERROR_INVALID_PARAM;
 	}
@@ -1639,14 +2741,16 @@ int32_t PCF2131_LowBatInt(pcf2131_sensorhandle_t *pSensorHandle, LowBatInt is_en
 		return SENSOR_ERROR_INIT;
 	}
 
-	/*! Low Bat Interrupt Enable/Disable */
-	status = Register_I2C_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
-			PCF2131_CTRL3, (uint8_t)(((is_enabled == lbIntEnable) ? lbIntEnable : lbIntDisable) << PCF2131_CTRL3_BLIE_SHIFT ), PCF2131_CTRL3_BLIE_MASK,repeatedStart);
+	/*! Get aging offset */
+	status = Register_I2C_Read(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
+			PCF2131_AGING_OFFSET, PCF2131_REG_SIZE_BYTE, (uint8_t *)&agingReg);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BusError(pSensorHandle, status, SENSOR_ERROR_READ);
 	}
 
+	*pCode = agingReg.b.ao;
+
 	return SENSOR_ERROR_NONE;
 }
 
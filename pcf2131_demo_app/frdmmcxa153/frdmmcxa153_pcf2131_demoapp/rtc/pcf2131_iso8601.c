@@ -0,0 +1,241 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file pcf2131_iso8601.c
+ * @brief The pcf2131_iso8601.c file implements the PCF2131 ISO-8601 / RFC-3339 time formatter and parser.
+ */
+
+#include "pcf2131_iso8601.h"
+
+//-----------------------------------------------------------------------
+// Global Variables
+//-----------------------------------------------------------------------
+/* Two characters for each value from 00 to 99. */
+static const char pcf2131_isoDigits[200] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+/* Days in each month of a non leap year. */
+static const uint8_t pcf2131_isoMonthDays[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+/* Days of the year before each month of a non leap year. */
+static const uint16_t pcf2131_isoDaysBefore[12] = {0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334};
+
+//-----------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------
+
+/* Writes a value from 0 to 99 as two digits. */
+static inline void PCF2131_IsoPut2(char *pBuf, uint8_t val)
+{
+	const char *pDigits = &pcf2131_isoDigits[2 * (val % 100)];
+
+	pBuf[0] = pDigits[0];
+	pBuf[1] = pDigits[1];
+}
+
+/* Reads two digits, returns -1 if either is not a digit. The second character is read only after
+ * the first one is a digit, so a terminator in front of it ends the read. */
+static inline int32_t PCF2131_IsoGet2(const char *pStr)
+{
+	uint8_t hi = (uint8_t)(pStr[0] - '0');
+	uint8_t lo;
+
+	if (hi > 9)
+	{
+		return -1;
+	}
+	lo = (uint8_t)(pStr[1] - '0');
+
+	return (lo > 9) ? -1 : (int32_t)(hi * 10 + lo);
+}
+
+uint8_t PCF2131_Iso_Hours24(uint8_t hours, AmPm ampm)
+{
+	return (ampm == h24) ? hours : (uint8_t)((hours % 12) + ((ampm == PM) ? 12 : 0));
+}
+
+/* Days from 2000-01-01 to the date, years 0 to 99 of the century. */
+static uint32_t PCF2131_IsoDayCount(uint32_t years, uint32_t months, uint32_t days)
+{
+	uint32_t dayCount = years * 365 + (years + 3) / 4 + pcf2131_isoDaysBefore[months - 1] + days - 1;
+
+	return dayCount + (((months > 2) && ((years % 4) == 0)) ? 1 : 0);
+}
+
+/* Reads the UTC offset at the end of the string: nothing, Z, +hh:mm or -hh:mm, then the terminator.
+ * Returns false for anything else. */
+static bool PCF2131_IsoGetOffset(const char *pStr, int32_t *pOffsetMinutes)
+{
+	int32_t hours, minutes;
+
+	*pOffsetMinutes = 0;
+	if (pStr[0] == '\0')
+	{
+		return true;
+	}
+	if (pStr[0] == 'Z')
+	{
+		return pStr[1] == '\0';
+	}
+	if (((pStr[0] != '+') && (pStr[0] != '-')) || ((hours = PCF2131_IsoGet2(&pStr[1])) < 0) || (hours > 23) ||
+			(pStr[3] != ':') || ((minutes = PCF2131_IsoGet2(&pStr[4])) < 0) || (minutes > 59) || (pStr[6] != '\0'))
+	{
+		return false;
+	}
+	*pOffsetMinutes = ((pStr[0] == '-') ? -1 : 1) * (hours * 60 + minutes);
+
+	return true;
+}
+
+/* Writes 20YY-MM-DDThh:mm:ss, the common part of both formats. */
+static void PCF2131_IsoPutDateTime(char *pBuf, uint8_t years, uint8_t months, uint8_t days, uint8_t hours,
+		uint8_t minutes, uint8_t second)
+{
+	pBuf[0] = '2';
+	pBuf[1] = '0';
+	PCF2131_IsoPut2(&pBuf[2], years);
+	pBuf[4] = '-';
+	PCF2131_IsoPut2(&pBuf[5], months);
+	pBuf[7] = '-';
+	PCF2131_IsoPut2(&pBuf[8], days);
+	pBuf[10] = 'T';
+	PCF2131_IsoPut2(&pBuf[11], hours);
+	pBuf[13] = ':';
+	PCF2131_IsoPut2(&pBuf[14], minutes);
+	pBuf[16] = ':';
+	PCF2131_IsoPut2(&pBuf[17], second);
+}
+
+uint8_t PCF2131_Iso_FormatTime(const pcf2131_timedata_t *time, char *pBuf)
+{
+	PCF2131_IsoPutDateTime(pBuf, time->years, time->months, time->days, PCF2131_Iso_Hours24(time->hours, time->ampm),
+			time->minutes, time->second);
+	pBuf[19] = '.';
+	PCF2131_IsoPut2(&pBuf[20], time->second_100th);
+	pBuf[PCF2131_ISO_TIME_LEN] = '\0';
+
+	return PCF2131_ISO_TIME_LEN;
+}
+
+uint8_t PCF2131_Iso_FormatTimeStamp(const pcf2131_timestamp_t *timestamp, char *pBuf)
+{
+	PCF2131_IsoPutDateTime(pBuf, timestamp->years, timestamp->months, timestamp->days,
+			PCF2131_Iso_Hours24(timestamp->hours, timestamp->ampm), timestamp->minutes, timestamp->second);
+	pBuf[PCF2131_ISO_TIMESTAMP_LEN] = '\0';
+
+	return PCF2131_ISO_TIMESTAMP_LEN;
+}
+
+int32_t PCF2131_Iso_ParseTime(const char *pStr, Mode12h_24h mode, pcf2131_timedata_t *time)
+{
+	int32_t century, years, months, days, hours, minutes, second, second_100th = 0, offset;
+	int32_t dayCount, dayMinutes;
+	uint32_t pos = 19;
+
+	/*! Validate for the correct string and time variable.*/
+	if ((pStr == NULL) || (time == NULL))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Fixed positions, the terminator fails the digit or separator check before any read past it */
+	century = PCF2131_IsoGet2(&pStr[0]);
+	if ((century != 20) || ((years = PCF2131_IsoGet2(&pStr[2])) < 0) || (pStr[4] != '-') ||
+			((months = PCF2131_IsoGet2(&pStr[5])) < 1) || (months > 12) || (pStr[7] != '-') ||
+			((days = PCF2131_IsoGet2(&pStr[8])) < 1) || ((pStr[10] != 'T') && (pStr[10] != ' ')) ||
+			((hours = PCF2131_IsoGet2(&pStr[11])) < 0) || (hours > 23) || (pStr[13] != ':') ||
+			((minutes = PCF2131_IsoGet2(&pStr[14])) < 0) || (minutes > 59) || (pStr[16] != ':') ||
+			((second = PCF2131_IsoGet2(&pStr[17])) < 0) || (second > 59))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+	if (days > (pcf2131_isoMonthDays[months - 1] + (((months == 2) && ((years % 4) == 0)) ? 1 : 0)))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Optional fraction of one or more digits, hundredths kept, a single digit is tenths */
+	if (pStr[pos] == '.')
+	{
+		pos++;
+		if ((uint8_t)(pStr[pos] - '0') > 9)
+		{
+			return SENSOR_ERROR_INVALID_PARAM;
+		}
+		second_100th = (pStr[pos++] - '0') * 10;
+		if ((uint8_t)(pStr[pos] - '0') <= 9)
+		{
+			second_100th += pStr[pos++] - '0';
+		}
+		while ((uint8_t)(pStr[pos] - '0') <= 9)
+		{
+			pos++;
+		}
+	}
+
+	/*! Then only a UTC offset and the end of the string */
+	if (!PCF2131_IsoGetOffset(&pStr[pos], &offset))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Apply the offset, the RTC is set to UTC, the result must stay within 2000 to 2099 */
+	dayCount = (int32_t)PCF2131_IsoDayCount((uint32_t)years, (uint32_t)months, (uint32_t)days);
+	dayMinutes = hours * 60 + minutes - offset;
+	dayCount += (dayMinutes < 0) ? -1 : (dayMinutes / 1440);
+	dayMinutes = (dayMinutes + 1440) % 1440;
+	if ((dayCount < 0) || ((uint32_t)dayCount >= PCF2131_IsoDayCount(99, 12, 31) + 1))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+	if (offset != 0)
+	{
+		for (years = 0; PCF2131_IsoDayCount((uint32_t)years + 1, 1, 1) <= (uint32_t)dayCount; years++)
+		{
+		}
+		for (months = 1; months < 12; months++)
+		{
+			if (PCF2131_IsoDayCount((uint32_t)years, (uint32_t)months + 1, 1) > (uint32_t)dayCount)
+			{
+				break;
+			}
+		}
+		days = dayCount - (int32_t)PCF2131_IsoDayCount((uint32_t)years, (uint32_t)months, 1) + 1;
+		hours = dayMinutes / 60;
+		minutes = dayMinutes % 60;
+	}
+
+	time->second_100th = (uint8_t)second_100th;
+	time->second = (uint8_t)second;
+	time->minutes = (uint8_t)minutes;
+	time->days = (uint8_t)days;
+	/*! 2000-01-01 was a Saturday */
+	time->weekdays = (uint8_t)((dayCount + 6) % 7);
+	time->months = (uint8_t)months;
+	time->years = (uint8_t)years;
+	if (mode == mode12H)
+	{
+		time->ampm = (hours >= 12) ? PM : AM;
+		time->hours = (uint8_t)(((hours % 12) == 0) ? 12 : (hours % 12));
+	}
+	else
+	{
+		time->ampm = h24;
+		time->hours = (uint8_t)hours;
+	}
+
+	return SENSOR_ERROR_NONE;
+}
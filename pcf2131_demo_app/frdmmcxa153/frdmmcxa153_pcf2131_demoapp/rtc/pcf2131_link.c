@@ -0,0 +1,269 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file pcf2131_link.c
+ * @brief The pcf2131_link.c file implements bus link tuning for the PCF2131 RTC.
+ */
+
+#include <string.h>
+#include "pcf2131_link.h"
+#include "systick_utils.h"
+
+#if !(I2C_ENABLE)
+//-----------------------------------------------------------------------
+// Global Variables
+//-----------------------------------------------------------------------
+/* Pattern bits of the alarm registers, the AE_x bits are always written set. */
+static const uint8_t pcf2131_linkTestMask[PCF2131_ALARM_TIME_SIZE_BYTE] = {
+	PCF2131_SECONDS_ALARM_MASK, PCF2131_MINUTES_ALARM_MASK, PCF2131_HOURS_ALARM_MASK,
+	PCF2131_DAYS_ALARM_MASK, PCF2131_WEEKDAYS_ALARM_MASK};
+
+//-----------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------
+
+/* Runs the read-only then the pattern test at the current rate, returns the number of failed transfers.
+ * pExpected holds the alarm register contents, the last pattern read back is left in it. */
+static uint16_t PCF2131_LinkTest(pcf2131_sensorhandle_t *pSensorHandle, uint8_t *pExpected, uint16_t trials,
+		uint16_t maxErrors, uint32_t *pBytes)
+{
+	uint8_t buffer[PCF2131_BUF_HEADROOM + PCF2131_ALARM_TIME_SIZE_BYTE];
+	uint8_t pattern[PCF2131_ALARM_TIME_SIZE_BYTE];
+	uint16_t t, errors = 0;
+	uint8_t j;
+
+	/*! Read-only pass first, nothing is written at a rate that cannot read back the saved contents */
+	for (t = 0; (t < trials) && (errors <= maxErrors); t++)
+	{
+		if ((SENSOR_ERROR_NONE != PCF2131_ReadInPlace(pSensorHandle, PCF2131_SECOND_ALARM,
+				PCF2131_ALARM_TIME_SIZE_BYTE, buffer)) ||
+				memcmp(&buffer[PCF2131_BUF_HEADROOM], pExpected, PCF2131_ALARM_TIME_SIZE_BYTE))
+		{
+			errors++;
+		}
+		*pBytes += PCF2131_SPI_CMD_LEN + PCF2131_ALARM_TIME_SIZE_BYTE;
+	}
+
+	/*! Alternating pattern write and read-back */
+	for (t = 0; (t < trials) && (errors <= maxErrors); t++)
+	{
+		for (j = 0; j < PCF2131_ALARM_TIME_SIZE_BYTE; j++)
+		{
+			pattern[j] = ((((t + j) & 1) ? 0x55 : 0x2A) & pcf2131_linkTestMask[j]) | PCF2131_AE_S_MASK;
+			buffer[PCF2131_BUF_HEADROOM + j] = pattern[j];
+		}
+		if ((SENSOR_ERROR_NONE != PCF2131_WriteInPlace(pSensorHandle, PCF2131_SECOND_ALARM,
+				PCF2131_ALARM_TIME_SIZE_BYTE, buffer)) ||
+				(SENSOR_ERROR_NONE != PCF2131_ReadInPlace(pSensorHandle, PCF2131_SECOND_ALARM,
+				PCF2131_ALARM_TIME_SIZE_BYTE, buffer)) ||
+				memcmp(&buffer[PCF2131_BUF_HEADROOM], pattern, PCF2131_ALARM_TIME_SIZE_BYTE))
+		{
+			errors++;
+		}
+		else
+		{
+			memcpy(pExpected, pattern, PCF2131_ALARM_TIME_SIZE_BYTE);
+		}
+		*pBytes += 2 * (PCF2131_SPI_CMD_LEN + PCF2131_ALARM_TIME_SIZE_BYTE);
+	}
+
+	return errors;
+}
+
+int32_t PCF2131_SPI_Tune(pcf2131_sensorhandle_t *pSensorHandle, const pcf2131_spitune_t *pTune, uint32_t *pBaud)
+{
+	int32_t status;
+	uint8_t saved[PCF2131_BUF_HEADROOM + PCF2131_ALARM_TIME_SIZE_BYTE];
+	uint8_t expected[PCF2131_ALARM_TIME_SIZE_BYTE];
+	uint64_t start;
+	uint32_t bytes, elapsed_us, rate;
+	uint16_t errors;
+	uint8_t i;
+	bool passed = false;
+
+	/*! Validate for the correct handle, tuning parameters and baud rate read variable.*/
+	if ((pSensorHandle == NULL) || (pTune == NULL) || (pTune->pRates == NULL) || (pTune->nRates == 0) ||
+			(pBaud == NULL))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Save the alarm registers at the known good rate */
+	status = PCF2131_ReadInPlace(pSensorHandle, PCF2131_SECOND_ALARM, PCF2131_ALARM_TIME_SIZE_BYTE, saved);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
+	memcpy(expected, &saved[PCF2131_BUF_HEADROOM], PCF2131_ALARM_TIME_SIZE_BYTE);
+	rate = pTune->pRates[0];
+
+	for (i = 0; i < pTune->nRates; i++)
+	{
+		if (SENSOR_ERROR_NONE != PCF2131_SetBusSpeed(pSensorHandle, pTune->pRates[i]))
+		{
+			if (pTune->log)
+			{
+				pTune->log("\r\n SPI TUNE: %d Hz not supported\r\n", pTune->pRates[i]);
+			}
+			break;
+		}
+
+		bytes = 0;
+		start = BOARD_SystickGetTicks();
+		errors = PCF2131_LinkTest(pSensorHandle, expected, pTune->trials, pTune->maxErrors, &bytes);
+		elapsed_us = (uint32_t)((BOARD_SystickGetTicks() - start) * 1000000 / BOARD_SystickGetCoreFreq());
+
+		if (pTune->log)
+		{
+			pTune->log("\r\n SPI TUNE: %d Hz, %d errors, %d bytes in %d us, %d kB/s\r\n", pTune->pRates[i], errors,
+					bytes, elapsed_us, elapsed_us ? (bytes * 1000 / elapsed_us) : 0);
+		}
+		if (errors > pTune->maxErrors)
+		{
+			break;
+		}
+		rate = pTune->pRates[i];
+		passed = true;
+	}
+
+	/*! Settle on the fastest passing rate (the first candidate if none passed) and restore the alarm */
+	if (SENSOR_ERROR_NONE != PCF2131_SetBusSpeed(pSensorHandle, rate))
+	{
+		return SENSOR_ERROR_INIT;
+	}
+	status = PCF2131_WriteInPlace(pSensorHandle, PCF2131_SECOND_ALARM, PCF2131_ALARM_TIME_SIZE_BYTE, saved);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
+
+	if (pTune->log)
+	{
+		pTune->log("\r\n SPI TUNE: %s %d Hz\r\n", passed ? "selected" : "no rate passed, back to", rate);
+	}
+	if (!passed)
+	{
+		return SENSOR_ERROR_READ;
+	}
+
+	*pBaud = rate;
+
+	return SENSOR_ERROR_NONE;
+}
+#else
+//-----------------------------------------------------------------------
+// Global Variables
+//-----------------------------------------------------------------------
+/* Value bits of the time block registers, from 100th_Seconds to Years. */
+static const uint8_t pcf2131_timeMask[PCF2131_TIME_SIZE_BYTE] = {
+	PCF2131_SECONDS_100TH_MASK, PCF2131_SECONDS_MASK, PCF2131_MINUTES_MASK, PCF2131_HOURS_MASK,
+	PCF2131_DAYS_MASK, PCF2131_WEEKDAYS_MASK, PCF2131_MONTHS_MASK, PCF2131_YEARS_MASK};
+
+/* Bus speed of each ARM_I2C_BUS_SPEED_x from Standard, for logging. */
+static const uint16_t pcf2131_speed_kHz[PCF2131_I2C_SPEED_COUNT] = {100, 400, 1000};
+
+//-----------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------
+
+/* Checks a raw time block for valid BCD in every field and in range seconds, minutes and months. */
+static bool PCF2131_TimeIsValid(const uint8_t *pTime)
+{
+	uint8_t i, val;
+
+	for (i = 0; i < PCF2131_TIME_SIZE_BYTE; i++)
+	{
+		val = pTime[i] & pcf2131_timeMask[i];
+		if (((val & 0x0F) > 9) || ((val >> 4) > 9))
+		{
+			return false;
+		}
+	}
+
+	return ((pTime[1] & PCF2131_SECONDS_MASK) <= 0x59) && ((pTime[2] & PCF2131_MINUTES_MASK) <= 0x59) &&
+			((pTime[6] & PCF2131_MONTHS_MASK) >= 0x01) && ((pTime[6] & PCF2131_MONTHS_MASK) <= 0x12);
+}
+
+int32_t PCF2131_I2C_Negotiate(pcf2131_sensorhandle_t *pSensorHandle, uint16_t trials, pcf2131_logfunction_t logFn)
+{
+	int32_t status;
+	uint8_t time[PCF2131_TIME_SIZE_BYTE];
+	uint64_t start;
+	uint32_t elapsed_us;
+	uint16_t t, errors;
+	uint8_t speed, best = 0;
+
+	/*! Validate for the correct handle and trial count.*/
+	if ((pSensorHandle == NULL) || (trials == 0))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before probing.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/*! Probe from the slowest speed up, stop at the first one with an error */
+	memset(pSensorHandle->busSpeedTime_us, 0, sizeof(pSensorHandle->busSpeedTime_us));
+	for (speed = ARM_I2C_BUS_SPEED_STANDARD; speed <= ARM_I2C_BUS_SPEED_FAST_PLUS; speed++)
+	{
+		if (SENSOR_ERROR_NONE != PCF2131_SetBusSpeed(pSensorHandle, speed))
+		{
+			if (logFn)
+			{
+				logFn("\r\n I2C SPEED: %d kHz not supported\r\n", pcf2131_speed_kHz[speed - 1]);
+			}
+			break;
+		}
+
+		errors = 0;
+		start = BOARD_SystickGetTicks();
+		for (t = 0; t < trials; t++)
+		{
+			status = Register_I2C_Read(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, pSensorHandle->slaveAddress,
+					PCF2131_100TH_SECOND, PCF2131_TIME_SIZE_BYTE, time);
+			if ((ARM_DRIVER_OK != status) || !PCF2131_TimeIsValid(time))
+			{
+				errors++;
+			}
+		}
+		elapsed_us = (uint32_t)((BOARD_SystickGetTicks() - start) * 1000000 / BOARD_SystickGetCoreFreq());
+
+		if (logFn)
+		{
+			logFn("\r\n I2C SPEED: %d kHz, %d errors in %d time reads, %d us per read\r\n",
+					pcf2131_speed_kHz[speed - 1], errors, trials, elapsed_us / trials);
+		}
+		if (errors)
+		{
+			break;
+		}
+		pSensorHandle->busSpeedTime_us[speed - 1] = elapsed_us / trials;
+		best = speed;
+	}
+
+	/*! Settle on the fastest stable speed, Standard if none was stable */
+	speed = best ? best : ARM_I2C_BUS_SPEED_STANDARD;
+	if (SENSOR_ERROR_NONE != PCF2131_SetBusSpeed(pSensorHandle, speed))
+	{
+		return SENSOR_ERROR_INIT;
+	}
+	pSensorHandle->busSpeed = speed;
+	pSensorHandle->busErrors = 0;
+	pSensorHandle->busClean = 0;
+
+	if (logFn)
+	{
+		logFn("\r\n I2C SPEED: %s %d kHz\r\n", best ? "selected" : "no speed stable, back to",
+				pcf2131_speed_kHz[speed - 1]);
+	}
+
+	return best ? SENSOR_ERROR_NONE : SENSOR_ERROR_READ;
+}
+#endif
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file pcf2131_link.h
+ * @brief The pcf2131_link.h file describes the PCF2131 bus link tuning interface.
+ */
+
+#ifndef PCF2131_LINK_H_
+#define PCF2131_LINK_H_
+
+/* Standard C Includes */
+#include <stdint.h>
+
+#include "pcf2131_drv.h"
+
+#if !(I2C_ENABLE)
+/*! @brief This structure holds the SPI baud rate tuning parameters.*/
+typedef struct
+{
+	const uint32_t *pRates;            /*!< Candidate baud rates in ascending order, the first one must be known good.*/
+	uint8_t nRates;                    /*!< Number of candidate baud rates.*/
+	uint16_t trials;                   /*!< Read-only and pattern transfers per rate.*/
+	uint16_t maxErrors;                /*!< Mismatching transfers tolerated per rate.*/
+	pcf2131_logfunction_t log;         /*!< Step logger, NULL for silent operation.*/
+} pcf2131_spitune_t;
+#endif
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+#if !(I2C_ENABLE)
+/*! @brief       Tunes the SPI baud rate of the PCF2131 link.
+ *  @details     Steps up through the candidate rates. At each rate the alarm registers are first read back
+ *               against their saved contents, then written with test patterns (AE_x bits kept set, so the
+ *               alarm stays off) and read back. Stepping stops at the first rate exceeding the error margin
+ *               or not supported by the LPSPI divider. The link is left at the fastest passing rate and the
+ *               alarm registers are restored. Throughput is logged for every step.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @param[in]   pTune  			Pointer to tuning parameters.
+ *  @param[out]  pBaud  			Selected baud rate.
+ *  @constraints This can be called only after PCF2131_Initialize(), with the link running at pTune->pRates[0].
+ *				 Application has to ensure that previous instances of these APIs have exited before invocation
+ *  @reentrant   No
+ *  @return      ::PCF2131_SPI_Tune() returns the status.
+ */
+int32_t PCF2131_SPI_Tune(pcf2131_sensorhandle_t *pSensorHandle, const pcf2131_spitune_t *pTune, uint32_t *pBaud);
+#else
+/*! @brief       Negotiates the I2C bus speed of the PCF2131 link.
+ *  @details     Probes Standard, Fast and Fast-mode Plus in turn with burst reads of the time block, each
+ *               read checked for bus errors and BCD plausibility. The link is left at the fastest speed
+ *               with no error, recorded in pSensorHandle->busSpeed together with the average time block read
+ *               time per speed in pSensorHandle->busSpeedTime_us. At runtime the driver steps down one speed
+ *               after PCF2131_I2C_FALLBACK_ERRORS bus errors, each PCF2131_I2C_DECAY_CLEAN clean transfers
+ *               forgive one error, and after PCF2131_I2C_STEPUP_CLEAN clean transfers it probes the next
+ *               speed that was stable here. A bus held by another arbiter device does not count as an error.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @param[in]   trials  			Time block reads per speed.
+ *  @param[in]   logFn  			Step logger, NULL for silent operation.
+ *  @constraints This can be called any number of times only after PCF2131_Initialize().
+ *				 Application has to ensure that previous instances of these APIs have exited before invocation
+ *  @reentrant   No
+ *  @return      ::PCF2131_I2C_Negotiate() returns the status.
+ */
+int32_t PCF2131_I2C_Negotiate(pcf2131_sensorhandle_t *pSensorHandle, uint16_t trials, pcf2131_logfunction_t logFn);
+#endif
+
+#endif /* PCF2131_LINK_H_ */
@@ -0,0 +1,350 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file pcf2131_poll.c
+ * @brief The pcf2131_poll.c file implements the PCF2131 polled operations, resumable state machines
+ *        advanced one non-blocking step per PCF2131_Poll() call.
+ */
+
+#include <string.h>
+#include "pcf2131_poll.h"
+#include "systick_utils.h"
+
+//-----------------------------------------------------------------------
+// Global Variables
+//-----------------------------------------------------------------------
+/* Register masks of the time block from 100th_Seconds to Years, as written by PCF2131_SetTime(). */
+static const uint8_t pcf2131_setTimeMask[PCF2131_TIME_SIZE_BYTE] = {
+	PCF2131_SECONDS_100TH_MASK, PCF2131_SECONDS_MASK, PCF2131_MINUTES_MASK, PCF2131_HOURS_MASK,
+	PCF2131_DAYS_MASK, PCF2131_WEEKDAYS_MASK, PCF2131_MONTHS_MASK, PCF2131_YEARS_MASK};
+
+//-----------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------
+
+/* Claims the handle for a new operation. */
+static int32_t PCF2131_PollBegin(pcf2131_sensorhandle_t *pSensorHandle, pcf2131_op_t op)
+{
+	/*! Check whether sensor handle is initialized before starting the operation.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+	if (pSensorHandle->poll.op != PCF2131_OP_NONE)
+	{
+		return SENSOR_ERROR_BUSY;
+	}
+
+	pSensorHandle->poll.op = op;
+	pSensorHandle->poll.step = 0;
+	pSensorHandle->poll.busy = false;
+	pSensorHandle->poll.polls = 0;
+	pSensorHandle->poll.maxPoll_us = 0;
+
+	return SENSOR_ERROR_NONE;
+}
+
+/* Decodes Control_1 and the time block read by a get time operation. */
+static void PCF2131_PollDecodeTime(const uint8_t *pRegs, pcf2131_timedata_t *time)
+{
+	const uint8_t *pTime = &pRegs[PCF2131_100TH_SECOND];
+
+	time->second_100th = BcdToDecimal(pTime[0]);
+	time->second = BcdToDecimal(pTime[1] & PCF2131_SECONDS_MASK);
+	time->minutes = BcdToDecimal(pTime[2] & PCF2131_MINUTES_MASK);
+	if (0 == (pRegs[PCF2131_CTRL1] & PCF2131_CTRL1_12_HOUR_24_HOUR_MODE_MASK))
+	{
+		time->hours = BcdToDecimal(pTime[3] & PCF2131_HOURS_MASK);
+		time->ampm = h24;
+	}
+	else   /* Set AM/PM */
+	{
+		time->ampm = ((pTime[3] >> PCF2131_AM_PM_SHIFT) & 0x01) ? PM : AM;
+		time->hours = BcdToDecimal(pTime[3] & PCF2131_HOURS_MASK_12H);
+	}
+	time->days = BcdToDecimal(pTime[4] & PCF2131_DAYS_MASK);
+	time->weekdays = BcdToDecimal(pTime[5] & PCF2131_WEEKDAYS_MASK);
+	time->months = BcdToDecimal(pTime[6] & PCF2131_MONTHS_MASK);
+	time->years = BcdToDecimal(pTime[7]);
+}
+
+/* Runs the CPU work of the next step and starts its transfer.
+ * Returns SENSOR_ERROR_BUSY with a transfer started or the shared bus taken, else the final status. */
+static int32_t PCF2131_PollStep(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	pcf2131_poll_t *pPoll = &pSensorHandle->poll;
+	uint8_t *pReg = &pPoll->buf[PCF2131_BUF_HEADROOM];
+	int32_t status = SENSOR_ERROR_NONE;
+	uint8_t i;
+
+	switch (pPoll->op)
+	{
+	case PCF2131_OP_SET_TIME:
+		if (pPoll->step == 0)
+		{
+			status = PCF2131_StartReadInPlace(pSensorHandle, PCF2131_100TH_SECOND, PCF2131_TIME_SIZE_BYTE, pPoll->buf);
+		}
+		else if (pPoll->step == 1)
+		{
+			/*! Keep the bits outside the masks, as the read-modify-writes of PCF2131_SetTime() do */
+			for (i = 0; i < PCF2131_TIME_SIZE_BYTE; i++)
+			{
+				pReg[i] = (pReg[i] & ~pcf2131_setTimeMask[i]) | pPoll->value[i];
+			}
+			status = PCF2131_StartWriteInPlace(pSensorHandle, PCF2131_100TH_SECOND, PCF2131_TIME_SIZE_BYTE, pPoll->buf);
+		}
+		else
+		{
+			return SENSOR_ERROR_NONE;
+		}
+		break;
+
+	case PCF2131_OP_GET_TIME:
+		if (pPoll->step == 0)
+		{
+			status = PCF2131_StartReadInPlace(pSensorHandle, PCF2131_CTRL1, PCF2131_CTRL_TIME_SIZE_BYTE, pPoll->buf);
+		}
+		else
+		{
+			PCF2131_PollDecodeTime(pReg, pPoll->pTime);
+			return SENSOR_ERROR_NONE;
+		}
+		break;
+
+	case PCF2131_OP_CONFIGURE:
+		/*! Step 0 reads the register of an entry with a mask, step 1 writes it, then the next entry follows */
+		if (pPoll->step == 2)
+		{
+			pPoll->pList++;
+			pPoll->step = 0;
+		}
+		if (pPoll->pList->writeTo == 0xFFFF)
+		{
+			return SENSOR_ERROR_NONE;
+		}
+		if ((pPoll->step == 0) && pPoll->pList->mask)
+		{
+			status = PCF2131_StartReadInPlace(pSensorHandle, (uint8_t)pPoll->pList->writeTo, 1, pPoll->buf);
+		}
+		else
+		{
+			pReg[0] = pPoll->pList->mask ? ((pReg[0] & ~pPoll->pList->mask) | pPoll->pList->value) : pPoll->pList->value;
+			pPoll->step = 1;
+			status = PCF2131_StartWriteInPlace(pSensorHandle, (uint8_t)pPoll->pList->writeTo, 1, pPoll->buf);
+		}
+		break;
+
+	case PCF2131_OP_SNAPSHOT:
+		if (pPoll->step == 0)
+		{
+			status = PCF2131_StartReadInPlace(pSensorHandle, PCF2131_CTRL1, PCF2131_REG_MAP_SIZE, pPoll->pBuffer);
+		}
+		else
+		{
+			return SENSOR_ERROR_NONE;
+		}
+		break;
+
+	default:
+		return SENSOR_ERROR_NONE;
+	}
+
+	/*! The step only advances once its transfer is on the bus */
+	if (SENSOR_ERROR_NONE == status)
+	{
+		pPoll->busy = true;
+		pPoll->step++;
+		return SENSOR_ERROR_BUSY;
+	}
+
+	return status;
+}
+
+int32_t PCF2131_Start_SetTime(pcf2131_sensorhandle_t *pSensorHandle, const pcf2131_timedata_t *time)
+{
+	int32_t status;
+	uint8_t *pValue;
+
+	/*! Validate for the correct handle and time variable.*/
+	if ((pSensorHandle == NULL) || (time == NULL))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	status = PCF2131_PollBegin(pSensorHandle, PCF2131_OP_SET_TIME);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
+
+	/*! Encode as PCF2131_SetTime() does */
+	pValue = pSensorHandle->poll.value;
+	pValue[0] = DecimaltoBcd(time->second_100th & PCF2131_SECONDS_100TH_MASK);
+	pValue[1] = DecimaltoBcd(time->second & PCF2131_SECONDS_MASK);
+	pValue[2] = DecimaltoBcd(time->minutes & PCF2131_MINUTES_MASK);
+	if (time->ampm == AM)
+	{
+		pValue[3] = DecimaltoBcd(time->hours & PCF2131_HOURS_MASK_12H) & ~(PM << PCF2131_AM_PM_SHIFT);
+	}
+	else if (time->ampm == PM)
+	{
+		pValue[3] = DecimaltoBcd(time->hours & PCF2131_HOURS_MASK_12H) | (PM << PCF2131_AM_PM_SHIFT);
+	}
+	else
+	{
+		pValue[3] = DecimaltoBcd(time->hours & PCF2131_HOURS_MASK);
+	}
+	pValue[4] = DecimaltoBcd(time->days & PCF2131_DAYS_MASK);
+	pValue[5] = DecimaltoBcd(time->weekdays & PCF2131_WEEKDAYS_MASK);
+	pValue[6] = DecimaltoBcd(time->months & PCF2131_MONTHS_MASK);
+	pValue[7] = DecimaltoBcd(time->years & PCF2131_YEARS_MASK);
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_Start_GetTime(pcf2131_sensorhandle_t *pSensorHandle, pcf2131_timedata_t *time)
+{
+	int32_t status;
+
+	/*! Validate for the correct handle and time read variable.*/
+	if ((pSensorHandle == NULL) || (time == NULL))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	status = PCF2131_PollBegin(pSensorHandle, PCF2131_OP_GET_TIME);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
+	pSensorHandle->poll.pTime = time;
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_Start_Configure(pcf2131_sensorhandle_t *pSensorHandle, const registerwritelist_t *pRegWriteList)
+{
+	int32_t status;
+
+	/*! Validate for the correct handle and register write list.*/
+	if ((pSensorHandle == NULL) || (pRegWriteList == NULL))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	status = PCF2131_PollBegin(pSensorHandle, PCF2131_OP_CONFIGURE);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
+	pSensorHandle->poll.pList = pRegWriteList;
+
+	return SENSOR_ERROR_NONE;
+}
+
+/* Builds the interrupt enable and pin unmask writes in the handle and starts them. */
+static int32_t PCF2131_Start_IntEnable(pcf2131_sensorhandle_t *pSensorHandle, uint8_t ctrl1Mask, uint8_t ctrl1Shift,
+		uint8_t pinMask, uint8_t pinShift, IntSrc intsrc)
+{
+	registerwritelist_t *pList;
+
+	/*! Validate for the correct handle */
+	if (pSensorHandle == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+	if (pSensorHandle->poll.op != PCF2131_OP_NONE)
+	{
+		return SENSOR_ERROR_BUSY;
+	}
+
+	pList = pSensorHandle->poll.list;
+	pList[0].writeTo = PCF2131_CTRL1;
+	pList[0].value = (uint8_t)(intEnable << ctrl1Shift);
+	pList[0].mask = ctrl1Mask;
+	pList[1].writeTo = (intsrc == IntA) ? PCF2131_INT_A_MASK1 : PCF2131_INT_B_MASK1;
+	pList[1].value = (uint8_t)(INT_UNMASK << pinShift);
+	pList[1].mask = pinMask;
+	pList[2].writeTo = 0xFFFF;
+	pList[2].value = 0;
+	pList[2].mask = 0;
+
+	return PCF2131_Start_Configure(pSensorHandle, pList);
+}
+
+int32_t PCF2131_Start_SecInt_Enable(pcf2131_sensorhandle_t *pSensorHandle, IntSrc intsrc)
+{
+	return PCF2131_Start_IntEnable(pSensorHandle, PCF2131_CTRL1_SI_MASK, PCF2131_CTRL1_SI_SHIFT,
+			PCF2131_SI_DIS_MASK, PCF2131_SI_SHIFT, intsrc);
+}
+
+int32_t PCF2131_Start_MinInt_Enable(pcf2131_sensorhandle_t *pSensorHandle, IntSrc intsrc)
+{
+	return PCF2131_Start_IntEnable(pSensorHandle, PCF2131_CTRL1_MI_MASK, PCF2131_CTRL1_MI_SHIFT,
+			PCF2131_MI_DIS_MASK, PCF2131_MI_SHIFT, intsrc);
+}
+
+int32_t PCF2131_Start_Snapshot(pcf2131_sensorhandle_t *pSensorHandle, pcf2131_snapshot_t *pSnapshot)
+{
+	int32_t status;
+
+	/*! Validate for the correct handle and snapshot.*/
+	if ((pSensorHandle == NULL) || (pSnapshot == NULL))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	status = PCF2131_PollBegin(pSensorHandle, PCF2131_OP_SNAPSHOT);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
+	pSensorHandle->poll.pBuffer = pSnapshot->headroom;
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_Poll(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	pcf2131_poll_t *pPoll;
+	uint64_t start = BOARD_SystickGetTicks();
+	uint32_t elapsed_us;
+	int32_t status;
+
+	/*! Validate for the correct handle */
+	if (pSensorHandle == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+	pPoll = &pSensorHandle->poll;
+	if (pPoll->op == PCF2131_OP_NONE)
+	{
+		return SENSOR_ERROR_NONE;
+	}
+
+	/*! Either the transfer on the bus is still running, or the next step starts */
+	status = pPoll->busy ? PCF2131_PollTransfer(pSensorHandle) : SENSOR_ERROR_NONE;
+	if (SENSOR_ERROR_NONE == status)
+	{
+		pPoll->busy = false;
+		status = PCF2131_PollStep(pSensorHandle);
+	}
+	if (SENSOR_ERROR_BUSY != status)
+	{
+		pPoll->busy = false;
+		pPoll->op = PCF2131_OP_NONE;
+	}
+
+	elapsed_us = (uint32_t)((BOARD_SystickGetTicks() - start) * 1000000 / BOARD_SystickGetCoreFreq());
+	pPoll->polls++;
+	if (elapsed_us > pPoll->maxPoll_us)
+	{
+		pPoll->maxPoll_us = elapsed_us;
+	}
+
+	return status;
+}
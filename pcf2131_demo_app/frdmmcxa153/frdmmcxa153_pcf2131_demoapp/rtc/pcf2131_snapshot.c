@@ -0,0 +1,123 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file pcf2131_snapshot.c
+ * @brief The pcf2131_snapshot.c file implements the PCF2131 register map snapshot and diff-based restore.
+ */
+
+#include "pcf2131.h"
+#include "pcf2131_snapshot.h"
+
+//-----------------------------------------------------------------------
+// Global Variables
+//-----------------------------------------------------------------------
+/* Restorable bits of each register, the others keep their live value. */
+static const uint8_t pcf2131_restoreMask[PCF2131_REG_MAP_SIZE] = {
+	[PCF2131_CTRL1] = 0xFF,
+	[PCF2131_CTRL2] = PCF2131_CTRL2_AIE_MASK,
+	[PCF2131_CTRL3] = PCF2131_CTRL3_PWRMNG_MASK | PCF2131_CTRL3_BTSE_MASK | PCF2131_CTRL3_BIE_MASK |
+			PCF2131_CTRL3_BLIE_MASK,
+	[PCF2131_CTRL4] = 0x00,
+	[PCF2131_CTRL5] = PCF2131_CTRL5_TSIE1_MASK | PCF2131_CTRL5_TSIE2_MASK | PCF2131_CTRL5_TSIE3_MASK |
+			PCF2131_CTRL5_TSIE4_MASK,
+	[PCF2131_SECOND_ALARM] = 0xFF,
+	[PCF2131_MINUTE_ALARM] = 0xFF,
+	[PCF2131_HOUR_ALARM] = 0xFF,
+	[PCF2131_DAY_ALARM] = 0xFF,
+	[PCF2131_WEEKDAY_ALARM] = 0xFF,
+	[PCF2131_CLKOUT_CTL] = PCF2131_CLKOUT_TCR_MASK | PCF2131_CLKOUT_COF_MASK,
+	[PCF2131_TIMESTAMP1_CTL] = PCF2131_TSM_TS_MASK | PCF2131_TSOFF_TS_MASK,
+	[PCF2131_TIMESTAMP2_CTL] = PCF2131_TSM_TS_MASK | PCF2131_TSOFF_TS_MASK,
+	[PCF2131_TIMESTAMP3_CTL] = PCF2131_TSM_TS_MASK | PCF2131_TSOFF_TS_MASK,
+	[PCF2131_TIMESTAMP4_CTL] = PCF2131_TSM_TS_MASK | PCF2131_TSOFF_TS_MASK,
+	[PCF2131_AGING_OFFSET] = PCF2131_AGING_OFFSET_AO_MASK,
+	[PCF2131_INT_A_MASK1] = 0xFF,
+	[PCF2131_INT_A_MASK2] = 0xFF,
+	[PCF2131_INT_B_MASK1] = 0xFF,
+	[PCF2131_INT_B_MASK2] = 0xFF,
+	[PCF2131_WATCHDOG_TIMER_CTL] = PCF2131_WD_CTL_WD_CD_MASK | PCF2131_WD_TI_TP_MASK | PCF2131_WD_CTL_TF_MASK,
+};
+
+//-----------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------
+
+int32_t PCF2131_Snapshot(pcf2131_sensorhandle_t *pSensorHandle, pcf2131_snapshot_t *pSnapshot)
+{
+	/*! Validate for the correct snapshot, the handle is checked by the driver.*/
+	if (pSnapshot == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! One auto-increment burst over the whole register map */
+	return PCF2131_ReadInPlace(pSensorHandle, PCF2131_CTRL1, PCF2131_REG_MAP_SIZE, pSnapshot->headroom);
+}
+
+int32_t PCF2131_Restore(pcf2131_sensorhandle_t *pSensorHandle, const pcf2131_snapshot_t *pTarget, uint8_t *pBursts)
+{
+	int32_t status;
+	pcf2131_snapshot_t live;
+	uint8_t start, end, gap, reg, bursts = 0;
+
+	/*! Validate for the correct target snapshot.*/
+	if (pTarget == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	status = PCF2131_Snapshot(pSensorHandle, &live);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
+
+	for (start = 0; start < PCF2131_REG_MAP_SIZE; start = end)
+	{
+		/*! Merge the restorable bits of the target into the live value, skip unchanged registers */
+		reg = (live.reg[start] & ~pcf2131_restoreMask[start]) | (pTarget->reg[start] & pcf2131_restoreMask[start]);
+		end = start + 1;
+		if (reg == live.reg[start])
+		{
+			continue;
+		}
+		live.reg[start] = reg;
+
+		/*! Grow the burst over further changes, bridging short runs of unchanged restorable registers
+		 *  since rewriting their live value is cheaper than starting a new transfer */
+		for (gap = 0; (end < PCF2131_REG_MAP_SIZE) && (pcf2131_restoreMask[end] != 0) &&
+				(gap <= PCF2131_RESTORE_MAX_GAP); end++)
+		{
+			reg = (live.reg[end] & ~pcf2131_restoreMask[end]) | (pTarget->reg[end] & pcf2131_restoreMask[end]);
+			if (reg != live.reg[end])
+			{
+				live.reg[end] = reg;
+				gap = 0;
+			}
+			else
+			{
+				gap++;
+			}
+		}
+		end -= gap;
+
+		/*! The headroom in front of the burst overlaps registers already handled */
+		status = PCF2131_WriteInPlace(pSensorHandle, start, end - start, &live.reg[start] - PCF2131_BUF_HEADROOM);
+		if (SENSOR_ERROR_NONE != status)
+		{
+			return status;
+		}
+		bursts++;
+	}
+
+	if (pBursts != NULL)
+	{
+		*pBursts = bursts;
+	}
+
+	return SENSOR_ERROR_NONE;
+}
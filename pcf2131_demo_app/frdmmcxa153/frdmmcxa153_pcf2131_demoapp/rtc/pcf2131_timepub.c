@@ -0,0 +1,98 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file pcf2131_timepub.c
+ * @brief The pcf2131_timepub.c file implements the PCF2131 published time, a sequence lock in RAM.
+ */
+
+#include <string.h>
+#include "fsl_common.h"
+#include "pcf2131_timepub.h"
+#include "pcf2131_aging.h"
+
+//-----------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------
+
+void PCF2131_TimePub_Init(pcf2131_timepub_t *pPub)
+{
+	memset(pPub, 0, sizeof(pcf2131_timepub_t));
+}
+
+void PCF2131_TimePub_Publish(pcf2131_timepub_t *pPub, const pcf2131_timedata_t *time)
+{
+	int64_t epoch_ms = PCF2131_TimeToMs(time);
+	uint32_t regPrimask;
+
+	regPrimask = DisableGlobalIRQ();
+	pPub->seq++;
+	/*! The odd count must be visible before the data changes */
+	__DMB();
+	pPub->time = *time;
+	pPub->epoch_ms = epoch_ms;
+	__DMB();
+	pPub->seq++;
+	EnableGlobalIRQ(regPrimask);
+}
+
+int32_t PCF2131_TimePub_Update(pcf2131_sensorhandle_t *pSensorHandle, const registerreadlist_t *pcf2131timedata,
+		pcf2131_timepub_t *pPub)
+{
+	int32_t status;
+	pcf2131_timedata_t time;
+
+	/*! Validate for the correct handle and time publication.*/
+	if ((pSensorHandle == NULL) || (pPub == NULL))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Only the bus read is slow, readers are held off for the copy alone */
+	status = PCF2131_GetTime(pSensorHandle, pcf2131timedata, &time);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
+	PCF2131_TimePub_Publish(pPub, &time);
+
+	return SENSOR_ERROR_NONE;
+}
+
+bool PCF2131_TimePub_Read(const pcf2131_timepub_t *pPub, pcf2131_timedata_t *time, int64_t *pEpoch_ms)
+{
+	pcf2131_timedata_t copy;
+	int64_t epoch_ms;
+	uint32_t seq;
+
+	do
+	{
+		/*! Wait out an update in progress on another core */
+		do
+		{
+			seq = pPub->seq;
+		} while (seq & 1);
+		__DMB();
+		copy = pPub->time;
+		epoch_ms = pPub->epoch_ms;
+		__DMB();
+	} while (seq != pPub->seq);
+
+	if (seq == 0)
+	{
+		return false;
+	}
+	if (time)
+	{
+		*time = copy;
+	}
+	if (pEpoch_ms)
+	{
+		*pEpoch_ms = epoch_ms;
+	}
+
+	return true;
+}
@@ -0,0 +1,391 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file pcf2131_proto.c
+ * @brief The pcf2131_proto.c file implements the framed binary command protocol of the PCF2131 demo.
+ */
+
+#include <string.h>
+#include "debug_console_async.h"
+#include "pcf2131_proto.h"
+#include "pcf2131_iso8601.h"
+
+//-----------------------------------------------------------------------
+// Macros
+//-----------------------------------------------------------------------
+/* Response header: sequence number, operation index, opcode, status. */
+#define PCF2131_PROTO_RSP_HEADER   (4)
+#define PCF2131_PROTO_BAD_FRAME    (0xFF)
+
+//-----------------------------------------------------------------------
+// Global Variables
+//-----------------------------------------------------------------------
+/* CRC-16/CCITT-FALSE, one nibble per step. */
+static const uint16_t pcf2131_protoCrcTable[16] = {
+	0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+	0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF};
+
+static const registerreadlist_t pcf2131_protoTimeData[] = {
+	{.readFrom = PCF2131_100TH_SECOND, .numBytes = PCF2131_TIME_SIZE_BYTE}, __END_READ_DATA__};
+
+static const registerreadlist_t pcf2131_protoAlarmData[] = {
+	{.readFrom = PCF2131_SECOND_ALARM, .numBytes = PCF2131_ALARM_TIME_SIZE_BYTE}, __END_READ_DATA__};
+
+static const registerreadlist_t pcf2131_protoTsData[4][2] = {
+	{{.readFrom = PCF2131_TIMESTAMP1_SECONDS, .numBytes = PCF2131_TS_SIZE_BYTE}, __END_READ_DATA__},
+	{{.readFrom = PCF2131_TIMESTAMP2_SECONDS, .numBytes = PCF2131_TS_SIZE_BYTE}, __END_READ_DATA__},
+	{{.readFrom = PCF2131_TIMESTAMP3_SECONDS, .numBytes = PCF2131_TS_SIZE_BYTE}, __END_READ_DATA__},
+	{{.readFrom = PCF2131_TIMESTAMP4_SECONDS, .numBytes = PCF2131_TS_SIZE_BYTE}, __END_READ_DATA__}};
+
+//-----------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------
+
+static uint16_t PCF2131_ProtoCrc(uint16_t crc, const uint8_t *pData, uint32_t length)
+{
+	while (length--)
+	{
+		crc = (crc << 4) ^ pcf2131_protoCrcTable[(crc >> 12) ^ (*pData >> 4)];
+		crc = (crc << 4) ^ pcf2131_protoCrcTable[(crc >> 12) ^ (*pData & 0x0F)];
+		pData++;
+	}
+
+	return crc;
+}
+
+void PCF2131_Proto_SendFrame(uint8_t sof, const uint8_t *pPayload, uint8_t length)
+{
+	uint16_t crc = PCF2131_ProtoCrc(0xFFFF, &length, 1);
+	uint8_t i;
+
+	crc = PCF2131_ProtoCrc(crc, pPayload, length);
+	PUTCHAR(sof);
+	PUTCHAR(length);
+	for (i = 0; i < length; i++)
+	{
+		PUTCHAR(pPayload[i]);
+	}
+	PUTCHAR(crc & 0xFF);
+	PUTCHAR(crc >> 8);
+}
+
+/* Receives one request frame, returns false on a CRC error. */
+static bool PCF2131_ProtoReceive(uint8_t *pPayload, uint8_t *pLength)
+{
+	uint16_t crc;
+	uint8_t i;
+
+	/*! Resynchronize on the start byte */
+	while (GETCHAR() != PCF2131_PROTO_SOF_REQ)
+	{
+	}
+	*pLength = (uint8_t)GETCHAR();
+	for (i = 0; i < *pLength; i++)
+	{
+		pPayload[i] = (uint8_t)GETCHAR();
+	}
+	crc = (uint8_t)GETCHAR();
+	crc |= (uint16_t)((uint8_t)GETCHAR()) << 8;
+
+	return crc == PCF2131_ProtoCrc(PCF2131_ProtoCrc(0xFFFF, pLength, 1), pPayload, *pLength);
+}
+
+static void PCF2131_ProtoPackTime(uint8_t *pOut, const pcf2131_timedata_t *time)
+{
+	pOut[0] = time->second_100th;
+	pOut[1] = time->second;
+	pOut[2] = time->minutes;
+	pOut[3] = time->hours;
+	pOut[4] = time->days;
+	pOut[5] = time->weekdays;
+	pOut[6] = time->months;
+	pOut[7] = time->years;
+	pOut[8] = (uint8_t)time->ampm;
+}
+
+static void PCF2131_ProtoUnpackTime(pcf2131_timedata_t *time, const uint8_t *pIn)
+{
+	time->second_100th = pIn[0];
+	time->second = pIn[1];
+	time->minutes = pIn[2];
+	time->hours = pIn[3];
+	time->days = pIn[4];
+	time->weekdays = pIn[5];
+	time->months = pIn[6];
+	time->years = pIn[7];
+	time->ampm = (AmPm)pIn[8];
+}
+
+/* Reads the interrupt flags in PCF2131_PROTO_INT_x layout. */
+static int32_t PCF2131_ProtoCheckInt(pcf2131_sensorhandle_t *pSensorHandle, uint8_t *pFlags)
+{
+	int32_t status;
+	IntState state;
+	uint8_t sw;
+
+	*pFlags = 0;
+	status = PCF2131_Check_MinSecInt(pSensorHandle, &state);
+	*pFlags |= (intOccurred == state) ? PCF2131_PROTO_INT_MSF : 0;
+	if (SENSOR_ERROR_NONE == status)
+	{
+		status = PCF2131_Check_AlarmInt(pSensorHandle, &state);
+		*pFlags |= (intOccurred == state) ? PCF2131_PROTO_INT_ALARM : 0;
+	}
+	for (sw = sw1Ts; (sw <= sw4Ts) && (SENSOR_ERROR_NONE == status); sw++)
+	{
+		status = PCF2131_Check_SW_TsInt(pSensorHandle, (SwTsNum)sw, &state);
+		*pFlags |= (intOccurred == state) ? (PCF2131_PROTO_INT_TS1 << sw) : 0;
+	}
+
+	return status;
+}
+
+/* Clears the interrupt flags given in PCF2131_PROTO_INT_x layout. */
+static int32_t PCF2131_ProtoClearInt(pcf2131_sensorhandle_t *pSensorHandle, uint8_t flags)
+{
+	int32_t status = SENSOR_ERROR_NONE;
+	uint8_t sw;
+
+	if (flags & PCF2131_PROTO_INT_MSF)
+	{
+		status = PCF2131_Clear_MinSecInt(pSensorHandle);
+	}
+	if ((flags & PCF2131_PROTO_INT_ALARM) && (SENSOR_ERROR_NONE == status))
+	{
+		status = PCF2131_Clear_AlarmInt(pSensorHandle);
+	}
+	for (sw = sw1Ts; (sw <= sw4Ts) && (SENSOR_ERROR_NONE == status); sw++)
+	{
+		if (flags & (PCF2131_PROTO_INT_TS1 << sw))
+		{
+			status = PCF2131_Clear_SW_TsInt(pSensorHandle, (SwTsNum)sw);
+		}
+	}
+
+	return status;
+}
+
+/* Runs one operation, fills the response data and returns the status. */
+static int32_t PCF2131_ProtoExecute(pcf2131_sensorhandle_t *pSensorHandle, uint8_t op, const uint8_t *pArg,
+		uint8_t argLen, uint8_t *pData, uint8_t *pDataLen)
+{
+	uint8_t buffer[PCF2131_BUF_HEADROOM + PCF2131_REG_MAP_SIZE];
+	pcf2131_timedata_t time;
+	pcf2131_alarmdata_t alarm;
+	pcf2131_timestamp_t ts;
+	Mode12h_24h mode;
+	char iso[PCF2131_ISO_INPUT_MAX_LEN + 1];
+	int32_t status;
+
+	/*! Argument lengths are checked per opcode, a short argument never reads past the frame */
+	*pDataLen = 0;
+	switch (op)
+	{
+	case PCF2131_PROTO_PING:
+	case PCF2131_PROTO_EXIT:
+		return SENSOR_ERROR_NONE;
+
+	case PCF2131_PROTO_READ_REG:
+		if ((argLen != 2) || (pArg[1] == 0) || ((pArg[0] + pArg[1]) > PCF2131_REG_MAP_SIZE))
+		{
+			return SENSOR_ERROR_INVALID_PARAM;
+		}
+		status = PCF2131_ReadInPlace(pSensorHandle, pArg[0], pArg[1], buffer);
+		if (SENSOR_ERROR_NONE == status)
+		{
+			memcpy(pData, &buffer[PCF2131_BUF_HEADROOM], pArg[1]);
+			*pDataLen = pArg[1];
+		}
+		return status;
+
+	case PCF2131_PROTO_WRITE_REG:
+		if ((argLen < 2) || ((pArg[0] + argLen - 1) > PCF2131_REG_MAP_SIZE))
+		{
+			return SENSOR_ERROR_INVALID_PARAM;
+		}
+		memcpy(&buffer[PCF2131_BUF_HEADROOM], &pArg[1], argLen - 1);
+		return PCF2131_WriteInPlace(pSensorHandle, pArg[0], argLen - 1, buffer);
+
+	case PCF2131_PROTO_GET_TIME:
+		status = PCF2131_GetTime(pSensorHandle, pcf2131_protoTimeData, &time);
+		if (SENSOR_ERROR_NONE == status)
+		{
+			PCF2131_ProtoPackTime(pData, &time);
+			*pDataLen = 9;
+		}
+		return status;
+
+	case PCF2131_PROTO_SET_TIME:
+		if (argLen != 9)
+		{
+			return SENSOR_ERROR_INVALID_PARAM;
+		}
+		PCF2131_ProtoUnpackTime(&time, pArg);
+		return PCF2131_SetTime(pSensorHandle, &time);
+
+	case PCF2131_PROTO_GET_TIME_ISO:
+		status = PCF2131_GetTime(pSensorHandle, pcf2131_protoTimeData, &time);
+		if (SENSOR_ERROR_NONE == status)
+		{
+			*pDataLen = PCF2131_Iso_FormatTime(&time, iso);
+			memcpy(pData, iso, PCF2131_ISO_TIME_LEN);
+		}
+		return status;
+
+	case PCF2131_PROTO_SET_TIME_ISO:
+		if ((argLen < PCF2131_ISO_TIMESTAMP_LEN) || (argLen > PCF2131_ISO_INPUT_MAX_LEN))
+		{
+			return SENSOR_ERROR_INVALID_PARAM;
+		}
+		/*! The argument is not terminated, the parser gets a terminated copy */
+		memcpy(iso, pArg, argLen);
+		iso[argLen] = '\0';
+		status = PCF2131_12h_24h_Mode_Get(pSensorHandle, &mode);
+		if (SENSOR_ERROR_NONE == status)
+		{
+			status = PCF2131_Iso_ParseTime(iso, mode, &time);
+		}
+		return (SENSOR_ERROR_NONE == status) ? PCF2131_SetTime(pSensorHandle, &time) : status;
+
+	case PCF2131_PROTO_GET_ALARM:
+		status = PCF2131_GetAlarmTime(pSensorHandle, pcf2131_protoAlarmData, &alarm);
+		if (SENSOR_ERROR_NONE == status)
+		{
+			pData[0] = alarm.second;
+			pData[1] = alarm.minutes;
+			pData[2] = alarm.hours;
+			pData[3] = alarm.days;
+			pData[4] = alarm.weekdays;
+			pData[5] = (uint8_t)alarm.ampm;
+			*pDataLen = 6;
+		}
+		return status;
+
+	case PCF2131_PROTO_SET_ALARM:
+		if (argLen != 6)
+		{
+			return SENSOR_ERROR_INVALID_PARAM;
+		}
+		alarm.second = pArg[0];
+		alarm.minutes = pArg[1];
+		alarm.hours = pArg[2];
+		alarm.days = pArg[3];
+		alarm.weekdays = pArg[4];
+		alarm.ampm = (AmPm)pArg[5];
+		return PCF2131_SetAlarmTime(pSensorHandle, &alarm);
+
+	case PCF2131_PROTO_GET_TS:
+		if ((argLen != 1) || (pArg[0] > sw4Ts))
+		{
+			return SENSOR_ERROR_INVALID_PARAM;
+		}
+		status = PCF2131_GetTs(pSensorHandle, pcf2131_protoTsData[pArg[0]], (SwTsNum)pArg[0], &ts);
+		if (SENSOR_ERROR_NONE == status)
+		{
+			pData[0] = ts.second;
+			pData[1] = ts.minutes;
+			pData[2] = ts.hours;
+			pData[3] = ts.days;
+			pData[4] = ts.months;
+			pData[5] = ts.years;
+			pData[6] = (uint8_t)ts.ampm;
+			*pDataLen = 7;
+		}
+		return status;
+
+	case PCF2131_PROTO_SET_MODE:
+		return (argLen != 1) ? SENSOR_ERROR_INVALID_PARAM :
+				PCF2131_12h_24h_Mode_Set(pSensorHandle, (Mode12h_24h)pArg[0]);
+
+	case PCF2131_PROTO_SW_RESET:
+		return ((argLen != 1) || (pArg[0] > SR)) ? SENSOR_ERROR_INVALID_PARAM :
+				PCF2131_SwRst(pSensorHandle, (SwRst)pArg[0]);
+
+	case PCF2131_PROTO_SEC_INT:
+		if (argLen != 2)
+		{
+			return SENSOR_ERROR_INVALID_PARAM;
+		}
+		return pArg[0] ? PCF2131_SecInt_Enable(pSensorHandle, (IntSrc)pArg[1]) : PCF2131_SecInt_Disable(pSensorHandle);
+
+	case PCF2131_PROTO_MIN_INT:
+		if (argLen != 2)
+		{
+			return SENSOR_ERROR_INVALID_PARAM;
+		}
+		return pArg[0] ? PCF2131_MinInt_Enable(pSensorHandle, (IntSrc)pArg[1]) : PCF2131_MinInt_Disable(pSensorHandle);
+
+	case PCF2131_PROTO_ALARM_INT:
+		if (argLen != 3)
+		{
+			return SENSOR_ERROR_INVALID_PARAM;
+		}
+		return pArg[0] ? PCF2131_AlarmInt_Enable(pSensorHandle, (IntSrc)pArg[1], (AlarmType)pArg[2]) :
+				PCF2131_AlarmInt_Disable(pSensorHandle);
+
+	case PCF2131_PROTO_TS_INT:
+		if ((argLen != 3) || (pArg[0] > sw4Ts))
+		{
+			return SENSOR_ERROR_INVALID_PARAM;
+		}
+		return pArg[1] ? PCF2131_SW_TsInt_Enable(pSensorHandle, (SwTsNum)pArg[0], (IntSrc)pArg[2]) :
+				PCF2131_SW_TsInt_Disable(pSensorHandle, (SwTsNum)pArg[0]);
+
+	case PCF2131_PROTO_CHECK_INT:
+		status = PCF2131_ProtoCheckInt(pSensorHandle, pData);
+		*pDataLen = (SENSOR_ERROR_NONE == status) ? 1 : 0;
+		return status;
+
+	case PCF2131_PROTO_CLEAR_INT:
+		return (argLen != 1) ? SENSOR_ERROR_INVALID_PARAM : PCF2131_ProtoClearInt(pSensorHandle, pArg[0]);
+
+	default:
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+}
+
+void PCF2131_Proto_Run(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	uint8_t request[255];
+	uint8_t response[PCF2131_PROTO_RSP_HEADER + PCF2131_PROTO_MAX_DATA];
+	uint8_t length, pos, argLen, dataLen, index;
+	bool exit = false;
+
+	while (!exit)
+	{
+		if (!PCF2131_ProtoReceive(request, &length) || (length == 0))
+		{
+			response[0] = length ? request[0] : 0;
+			response[1] = PCF2131_PROTO_BAD_FRAME;
+			response[2] = 0;
+			response[3] = (uint8_t)SENSOR_ERROR_INVALID_PARAM;
+			PCF2131_Proto_SendFrame(PCF2131_PROTO_SOF_RSP, response, PCF2131_PROTO_RSP_HEADER);
+			continue;
+		}
+
+		/*! Run the batch in order, answering each operation as soon as it is done */
+		response[0] = request[0];
+		for (pos = 1, index = 0; pos < length; pos += 2 + argLen, index++)
+		{
+			argLen = ((pos + 1) < length) ? request[pos + 1] : 0;
+			if (((pos + 1) >= length) || ((uint16_t)(pos + 2 + argLen) > length))
+			{
+				response[1] = PCF2131_PROTO_BAD_FRAME;
+				response[2] = 0;
+				response[3] = (uint8_t)SENSOR_ERROR_INVALID_PARAM;
+				PCF2131_Proto_SendFrame(PCF2131_PROTO_SOF_RSP, response, PCF2131_PROTO_RSP_HEADER);
+				break;
+			}
+			response[1] = index;
+			response[2] = request[pos];
+			response[3] = (uint8_t)PCF2131_ProtoExecute(pSensorHandle, request[pos], &request[pos + 2], argLen,
+					&response[PCF2131_PROTO_RSP_HEADER], &dataLen);
+			PCF2131_Proto_SendFrame(PCF2131_PROTO_SOF_RSP, response, PCF2131_PROTO_RSP_HEADER + dataLen);
+			exit |= (PCF2131_PROTO_EXIT == request[pos]);
+		}
+	}
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file pcf2131_proto.h
+ * @brief The pcf2131_proto.h file describes the framed binary command protocol of the PCF2131 demo,
+ *        served over the debug console for test rigs and fleet tooling.
+ *
+ * Request frame:  0xA5, len, payload[len], crc16 (little endian)
+ * Response frame: 0x5A, len, payload[len], crc16 (little endian)
+ *
+ * The CRC is CRC-16/CCITT-FALSE (0x1021, init 0xFFFF) over len and payload. A request payload is a
+ * sequence number followed by a batch of operations, each one opcode, argument length, arguments.
+ * Every operation is answered by its own response frame as soon as it has run, with the payload
+ * sequence number, operation index, opcode, status (int8_t SENSOR_ERROR_*) and the result data.
+ * A request with a bad CRC or a malformed batch is answered with opcode 0 and index 0xFF.
+ *
+ * Times are sent as decimal fields in pcf2131_timedata_t order (9 bytes), alarms in
+ * pcf2131_alarmdata_t order (6 bytes) and timestamps in pcf2131_timestamp_t order (7 bytes).
+ * Operations with no opcode of their own are reached through PCF2131_PROTO_READ_REG and
+ * PCF2131_PROTO_WRITE_REG.
+ */
+
+#ifndef PCF2131_PROTO_H_
+#define PCF2131_PROTO_H_
+
+/* Standard C Includes */
+#include <stdint.h>
+
+#include "pcf2131_drv.h"
+
+/*! @brief Frame start bytes. */
+#define PCF2131_PROTO_SOF_REQ    (0xA5)
+#define PCF2131_PROTO_SOF_RSP    (0x5A)
+#define PCF2131_PROTO_SOF_TLM    (0x5B)   /* Telemetry record, see pcf2131_stream.h. */
+#define PCF2131_PROTO_SOF_TRACE  (0x5C)   /* Bus trace chunk, see register_io_trace.h. */
+
+/*! @brief Longest response data, a read of the whole register map. */
+#define PCF2131_PROTO_MAX_DATA   (PCF2131_REG_MAP_SIZE)
+
+/*! @brief Interrupt flag bits of PCF2131_PROTO_CHECK_INT and PCF2131_PROTO_CLEAR_INT. */
+#define PCF2131_PROTO_INT_MSF    (0x01)   /* Minute/second flag. */
+#define PCF2131_PROTO_INT_ALARM  (0x02)   /* Alarm flag. */
+#define PCF2131_PROTO_INT_TS1    (0x04)   /* Timestamp 1 flag, TS2 to TS4 follow. */
+
+/*! @brief The protocol opcodes, arguments -> response data. */
+typedef enum
+{
+	PCF2131_PROTO_PING = 0x01,         /* - -> - */
+	PCF2131_PROTO_READ_REG = 0x02,     /* offset, length -> registers */
+	PCF2131_PROTO_WRITE_REG = 0x03,    /* offset, values -> - */
+	PCF2131_PROTO_GET_TIME = 0x10,     /* - -> time */
+	PCF2131_PROTO_SET_TIME = 0x11,     /* time -> - */
+	PCF2131_PROTO_GET_ALARM = 0x12,    /* - -> alarm */
+	PCF2131_PROTO_SET_ALARM = 0x13,    /* alarm -> - */
+	PCF2131_PROTO_GET_TS = 0x14,       /* switch (0-3) -> timestamp */
+	PCF2131_PROTO_SET_MODE = 0x15,     /* Mode12h_24h -> - */
+	PCF2131_PROTO_SW_RESET = 0x16,     /* SwRst -> - */
+	PCF2131_PROTO_GET_TIME_ISO = 0x17, /* - -> YYYY-MM-DDThh:mm:ss.cc */
+	PCF2131_PROTO_SET_TIME_ISO = 0x18, /* YYYY-MM-DDThh:mm:ss[.cc][Z|+hh:mm|-hh:mm] -> - */
+	PCF2131_PROTO_SEC_INT = 0x20,      /* enable, IntSrc -> - */
+	PCF2131_PROTO_MIN_INT = 0x21,      /* enable, IntSrc -> - */
+	PCF2131_PROTO_ALARM_INT = 0x22,    /* enable, IntSrc, AlarmType -> - */
+	PCF2131_PROTO_TS_INT = 0x23,       /* switch (0-3), enable, IntSrc -> - */
+	PCF2131_PROTO_CHECK_INT = 0x24,    /* - -> interrupt flags */
+	PCF2131_PROTO_CLEAR_INT = 0x25,    /* interrupt flags -> - */
+	PCF2131_PROTO_EXIT = 0x7F,         /* - -> -, back to the menu after the batch */
+} pcf2131_protoop_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*! @brief       Serves protocol requests from the debug console.
+ *  @details     Returns once a batch with PCF2131_PROTO_EXIT has run.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @constraints This can be called only after PCF2131_Initialize().
+ *  @reentrant   No
+ */
+void PCF2131_Proto_Run(pcf2131_sensorhandle_t *pSensorHandle);
+
+/*! @brief       Sends one frame on the debug console.
+ *  @param[in]   sof  				Frame start byte.
+ *  @param[in]   pPayload  			Payload.
+ *  @param[in]   length  			Payload length.
+ *  @constraints None
+ *  @reentrant   No
+ */
+void PCF2131_Proto_SendFrame(uint8_t sof, const uint8_t *pPayload, uint8_t length);
+
+#endif /* PCF2131_PROTO_H_ */
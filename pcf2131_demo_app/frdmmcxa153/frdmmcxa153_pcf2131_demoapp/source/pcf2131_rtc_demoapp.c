@@ -18,6 +18,8 @@
 #include "clock_config.h"
 #include "board.h"
 #include "fsl_debug_console.h"
+#include "debug_console_async.h"
+#include "log_token.h"
 
 //-----------------------------------------------------------------------
 // ISSDK Includes
@@ -26,12 +28,21 @@
 #include "issdk_hal.h"
 #include "gpio_driver.h"
 #include "systick_utils.h"
+#include "ctimer_utils.h"
 
 //-----------------------------------------------------------------------
 // CMSIS Includes
 //-----------------------------------------------------------------------
 #include "pcf2131.h"
 #include "pcf2131_drv.h"
+#include "pcf2131_aging.h"
+#include "pcf2131_snapshot.h"
+#include "pcf2131_link.h"
+#include "pcf2131_poll.h"
+#include "pcf2131_proto.h"
+#include "pcf2131_iso8601.h"
+#include "pcf2131_stream.h"
+#include "register_io_trace.h"
 #include "Driver_GPIO.h"
 
 /*******************************************************************************
@@ -63,6 +74,34 @@ const registerwritelist_t pcf2131ConfigDefault[] = {
 		/* generate a pulsed signal on MSF flag. */
 		__END_WRITE_DATA__};
 
+#if !(I2C_ENABLE)
+/*! @brief SPI baud rate candidates, from the board default up to the PCF2131 SPI maximum. */
+const uint32_t pcf2131SpiRates[] = {SPI_S_BAUDRATE, 1000000U, 2000000U, 4000000U, 6500000U};
+
+/*! @brief SPI baud rate tuning parameters. */
+const pcf2131_spitune_t pcf2131SpiTune = {
+		.pRates = pcf2131SpiRates,
+		.nRates = sizeof(pcf2131SpiRates) / sizeof(pcf2131SpiRates[0]),
+		.trials = 64,
+		.maxErrors = 0,
+		.log = DbgConsole_AsyncPrintf};
+#endif
+
+/*! @brief Bus trace capture buffer size and the trace bytes per protocol frame. */
+#define PCF2131_TRACE_BUFFER_SIZE    (2048)
+#define PCF2131_TRACE_CHUNK_SIZE     (128)
+
+/*! @brief Output clocking CLKOUT in external clock test mode: the board's CTIMER match output, wired to
+ *         CLKOUT (see the board header), or else the CLKOUT GPIO pin toggled by the CPU. */
+#if defined(BOARD_EXT_CLK_CTIMER) && (I2C_ENABLE || !defined(BOARD_EXT_CLK_CTIMER_ON_SPI_S))
+static const pcf2131_extclk_t extTestClock = {BOARD_CtimerClockStart, BOARD_CtimerClockRun, BOARD_CtimerClockStop};
+#define PCF2131_EXT_TEST_CLOCK  (&extTestClock)
+#define PCF2131_EXT_TEST_OUTPUT "the CTIMER match output wired to CLKOUT"
+#else
+#define PCF2131_EXT_TEST_CLOCK  NULL
+#define PCF2131_EXT_TEST_OUTPUT "the CLKOUT GPIO pin"
+#endif
+
 /*! @brief Address of Second Register for Time. */
 const registerreadlist_t pcf2131timedata[] = {{.readFrom = PCF2131_100TH_SECOND, .numBytes = PCF2131_TIME_SIZE_BYTE}, __END_READ_DATA__};
 
@@ -78,17 +117,38 @@ const registerreadlist_t pcf2131TsSw4data[] = {{.readFrom = PCF2131_TIMESTAMP4_S
 //-----------------------------------------------------------------------
 // Global Variables
 //-----------------------------------------------------------------------
+static uint8_t busTraceBuffer[PCF2131_TRACE_BUFFER_SIZE];
+
+/*! The RTC bus goes through an arbiter, so queued jobs wait for transfers started without waiting. */
+static busArbiter_t rtcBusArbiter;
+static busArbiterDevice_t rtcBusDevice = {.pArbiter = &rtcBusArbiter, .busSpeed = 0};
+
+/*! A get time queued on the RTC bus arbiter. */
+typedef struct
+{
+	pcf2131_sensorhandle_t *pDriver;
+	pcf2131_timedata_t time;
+	int32_t status;
+	bool done;
+} queuedGetTime_t;
 
 GENERIC_DRIVER_GPIO *pGpioDriver = &Driver_GPIO_KSDK;
 static gpioConfigKSDK_t gpioConfigDefault = {
 		.pinConfig = {kGPIO_DigitalInput, 1}, .portPinConfig = {0}, .interruptMode = kGPIO_InterruptFallingEdge};
 
+/* Names indexed by the weekday register and by AmPm, string literals so LOG_TOKEN() can send their address. */
+static const char *const weekdayName[7] = {"SUNDAY", "MONDAY", "TUESDAY", "WEDNESDAY", "THURSDAY", "FRIDAY", "SATURDAY"};
+static const char *const ampmName[3] = {" AM", " PM", ""};
+
 
 void PCF2131_INTA_ISR(void)
 {
 	/* Clear external interrupt flag. */
 	GPIO_GpioClearInterruptFlags(INTA_PIN.base, 1U << INTA_PIN.pinNumber);
-	PRINTF("\r\n Interrupt Occurred on INTA Pin....Please Clear the interrupt\r\n");
+	if (!PCF2131_Stream_Notify())
+	{
+		LOG_TOKEN("\r\n Interrupt Occurred on INTA Pin....Please Clear the interrupt\r\n");
+	}
 
 	SDK_ISR_EXIT_BARRIER;
 }
@@ -116,43 +176,9 @@ void init_pcf2131_wakeup_intA(void)
  */
 void printAlarmTime(pcf2131_alarmdata_t timeAlarm)
 {
-	PRINTF("\r\n TIME :- %d:%d:%d", timeAlarm.hours, timeAlarm.minutes, timeAlarm.second);
-
-	if(timeAlarm.ampm == AM)
-		PRINTF(" AM \r\n");
-	else if(timeAlarm.ampm == PM)
-		PRINTF(" PM \r\n");
-	else
-		PRINTF(" 24H Mode \r\n");
-
-	PRINTF("\r\n DATE :- %d \r\n",timeAlarm.days);
-
-	switch(timeAlarm.weekdays)
-	{
-	case 0:
-		PRINTF("\r\n SUNDAY\r\n");
-		break;
-	case 1:
-		PRINTF("\r\n MONDAY\r\n");
-		break;
-	case 2:
-		PRINTF("\r\n TUESDAY\r\n");
-		break;
-	case 3:
-		PRINTF("\r\n WEDNESDAY\r\n");
-		break;
-	case 4:
-		PRINTF("\r\n THURSDAY\r\n");
-		break;
-	case 5:
-		PRINTF("\r\n FRIDAY\r\n");
-		break;
-	case 6:
-		PRINTF("\r\n SATURDAY\r\n");
-		break;
-	default:
-		break;
-	}
+	LOG_TOKEN("\r\n TIME :- %02d:%02d:%02d%s, DATE :- %02d, %s\r\n", timeAlarm.hours, timeAlarm.minutes,
+			timeAlarm.second, (uint32_t)ampmName[timeAlarm.ampm % 3], timeAlarm.days,
+			(uint32_t)weekdayName[timeAlarm.weekdays % 7]);
 }
 
 /*!@brief        Print Time.
@@ -165,43 +191,10 @@ void printAlarmTime(pcf2131_alarmdata_t timeAlarm)
  */
 void printTime(pcf2131_timedata_t timeData)
 {
-	PRINTF("\r\n TIME :- %02d:%02d:%02d:%02d", timeData.hours, timeData.minutes, timeData.second, timeData.second_100th );
-
-	if(timeData.ampm == AM)
-		PRINTF(" AM\r\n");
-	else if(timeData.ampm == PM)
-		PRINTF(" PM\r\n");
-	else
-		PRINTF(" 24H Mode\r\n");
-
-	PRINTF("\r\n DATE [DD/MM/YY]:- %02d/%02d/%02d\r\n",timeData.days, timeData.months, timeData.years );
-
-	switch(timeData.weekdays)
-	{
-	case 0:
-		PRINTF("\r\n SUNDAY\r\n");
-		break;
-	case 1:
-		PRINTF("\r\n MONDAY\r\n");
-		break;
-	case 2:
-		PRINTF("\r\n TUESDAY\r\n");
-		break;
-	case 3:
-		PRINTF("\r\n WEDNESDAY\r\n");
-		break;
-	case 4:
-		PRINTF("\r\n THURSDAY\r\n");
-		break;
-	case 5:
-		PRINTF("\r\n FRIDAY\r\n");
-		break;
-	case 6:
-		PRINTF("\r\n SATURDAY\r\n");
-		break;
-	default:
-		break;
-	}
+	/*! ISO-8601 layout as PCF2131_Iso_FormatTime(), two records to stay within LOG_TOKEN_MAX_ARGS */
+	LOG_TOKEN("\r\n TIME :- 20%02d-%02d-%02d", timeData.years, timeData.months, timeData.days);
+	LOG_TOKEN("T%02d:%02d:%02d.%02d %s\r\n", PCF2131_Iso_Hours24(timeData.hours, timeData.ampm), timeData.minutes,
+			timeData.second, timeData.second_100th, (uint32_t)weekdayName[timeData.weekdays % 7]);
 }
 
 /*!@brief        Print time stamp data.
@@ -214,15 +207,8 @@ void printTime(pcf2131_timedata_t timeData)
  */
 void printTimeStamp(pcf2131_timestamp_t timeStamp)
 {
-	PRINTF("\r\n TIME :- %02d:%02d:%02d",timeStamp.hours, timeStamp.minutes, timeStamp.second);
-	if(timeStamp.ampm == AM)
-		PRINTF(" AM\r\n");
-	else if(timeStamp.ampm == PM)
-		PRINTF(" PM\r\n");
-	else
-		PRINTF(" 24H Mode\r\n");
-
-	PRINTF("\r\n DATE [DD/MM/YY] :- %02d/%02d/%02d\r\n",timeStamp.days, timeStamp.months, timeStamp.years );
+	LOG_TOKEN("\r\n TIME :- 20%02d-%02d-%02dT%02d:%02d:%02d\r\n", timeStamp.years, timeStamp.months, timeStamp.days,
+			PCF2131_Iso_Hours24(timeStamp.hours, timeStamp.ampm), timeStamp.minutes, timeStamp.second);
 }
 
 /*!@brief       Get Switch Number.
@@ -310,7 +296,7 @@ int32_t getAlarmType(void)
 
 /*!@brief        Clear interrupts.
  *  @details     Clear interrupts (Seconds, Minute,
- *  			 Timestamps,Alarm).
+ *  			 Timestamps,Alarm,Watchdog).
  *  @param[in]   pcf2131Driver   Pointer to spi sensor handle structure.
  *  @constraints None
  *
@@ -437,6 +423,26 @@ int32_t clearInterrupts(pcf2131_sensorhandle_t *pcf2131Driver)
 		else
 			PRINTF("\r\n Alarm Interrupt cleared\r\n");
 	}
+
+	status = PCF2131_Check_WatchdogInt(pcf2131Driver, &intstate );
+	if (SENSOR_ERROR_NONE != status)
+	{
+		PRINTF("\r\n Check Watchdog Interrupt Failed\r\n");
+		return ERROR;
+	}
+	if(intstate == 0x01)
+	{
+		PRINTF("\r\n Watchdog Interrupt occurred: %x \r\n", intstate);
+		/*! WDTF is read-only, reloading the watchdog clears it. */
+		status = PCF2131_Watchdog_Kick(pcf2131Driver);
+		if (SENSOR_ERROR_NONE != status)
+		{
+			PRINTF("\r\n Watchdog Interrupt clear Failed\r\n");
+			return ERROR;
+		}
+		else
+			PRINTF("\r\n Watchdog Interrupt cleared\r\n");
+	}
 }
 
 /*!@brief        Set Alarm Time.
@@ -1334,6 +1340,8 @@ int32_t alarmInterrupt(pcf2131_sensorhandle_t *pcf2131Driver)
 		else
 			PRINTF("\r\n Interrupt PIN B Selected\r\n");
 
+		/*! Clear, route and enable in a single transaction */
+		PCF2131_Begin(pcf2131Driver);
 		status = PCF2131_Clear_AlarmInt(pcf2131Driver);
 		if (SENSOR_ERROR_NONE != status)
 		{
@@ -1343,6 +1351,10 @@ int32_t alarmInterrupt(pcf2131_sensorhandle_t *pcf2131Driver)
 			status = PCF2131_AlarmInt_Enable(pcf2131Driver, IntA, alarmtypeInp);
 		else
 			status = PCF2131_AlarmInt_Enable(pcf2131Driver, IntB, alarmtypeInp);
+		if (SENSOR_ERROR_NONE == status)
+			status = PCF2131_Commit(pcf2131Driver);
+		else
+			PCF2131_Abort(pcf2131Driver);
 		if (SENSOR_ERROR_NONE != status)
 		{
 			PRINTF("\r\n Alarm Interrupt Enable Failed\r\n");
@@ -1370,6 +1382,595 @@ int32_t alarmInterrupt(pcf2131_sensorhandle_t *pcf2131Driver)
 		break;
 	}
 }
+/*!@brief        Watchdog Timer.
+ *  @details     Configure, enable, disable and kick the RTC watchdog timer.
+ *  @param[in]   pcf2131Driver   Pointer to sensor handle structure.
+ *  @constraints None
+ *  @reentrant   No
+ *  @return      No
+ */
+void watchdogTimer(pcf2131_sensorhandle_t *pcf2131Driver)
+{
+	uint8_t temp;
+	uint8_t period;
+	IntSrc intsrc;
+	int32_t status;
+
+	PRINTF("\r\n 1.Enable Watchdog Timer\r\n");
+	PRINTF("\r\n 2.Disable Watchdog Timer\r\n");
+	PRINTF("\r\n 3.Kick Watchdog Timer\r\n");
+	PRINTF("\r\n 4.Kick Watchdog Timer on every Time Read\r\n");
+
+	PRINTF("\r\n Enter your choice :- ");
+	do{
+		SCANF("%d",&temp);
+		PRINTF("%d\r\n",temp);
+		if(temp < 1 || temp > 4)
+			PRINTF("\r\n Invalid Value, Please enter correct value\r\n");
+	}
+	while(temp < 1 || temp > 4);
+
+	switch(temp)
+	{
+	case 1: /*! Enable Watchdog Timer. */
+		PRINTF("\r\n Enter Watchdog Period in seconds (1 to 63) :- ");
+		do{
+			SCANF("%d",&period);
+			PRINTF("%d\r\n",period);
+			if(period < 1 || period > 63)
+				PRINTF("\r\n Invalid Value, Please enter correct value\r\n");
+		}
+		while(period < 1 || period > 63);
+
+		intsrc = getIntSrc();
+		if (intsrc == 1)
+			PRINTF("\r\n Interrupt PIN A Selected\r\n");
+		else
+			PRINTF("\r\n Interrupt PIN B Selected\r\n");
+
+		/*! 4 Hz source clock, 4 counts per second. */
+		status = PCF2131_Watchdog_Config(pcf2131Driver, wdClk4Hz, (uint8_t)(period * 4));
+		if (SENSOR_ERROR_NONE != status)
+		{
+			PRINTF("\r\n Watchdog Timer Configuration Failed\r\n");
+			break;
+		}
+		if (intsrc == 1)
+			status = PCF2131_WatchdogInt_Enable(pcf2131Driver, IntA);
+		else
+			status = PCF2131_WatchdogInt_Enable(pcf2131Driver, IntB);
+		if (SENSOR_ERROR_NONE != status)
+		{
+			PRINTF("\r\n Watchdog Interrupt Enable Failed\r\n");
+			break;
+		}
+		status = PCF2131_Watchdog_Enable(pcf2131Driver);
+		if (SENSOR_ERROR_NONE != status)
+		{
+			PRINTF("\r\n Watchdog Timer Enable Failed\r\n");
+		}
+		else
+			PRINTF("\r\n Watchdog Timer Enabled\r\n");
+		break;
+	case 2: /*! Disable Watchdog Timer. */
+		status = PCF2131_Watchdog_Disable(pcf2131Driver);
+		if (SENSOR_ERROR_NONE != status)
+		{
+			PRINTF("\r\n Watchdog Timer Disable Failed\r\n");
+		}
+		status = PCF2131_WatchdogInt_Disable(pcf2131Driver);
+		if (SENSOR_ERROR_NONE != status)
+		{
+			PRINTF("\r\n Watchdog Interrupt Disable Failed\r\n");
+		}
+		else
+			PRINTF("\r\n Watchdog Timer Disabled\r\n");
+		break;
+	case 3: /*! Kick Watchdog Timer. */
+		status = PCF2131_Watchdog_Kick(pcf2131Driver);
+		if (SENSOR_ERROR_NONE != status)
+		{
+			PRINTF("\r\n Watchdog Timer Kick Failed (Enable it first)\r\n");
+		}
+		else
+			PRINTF("\r\n Watchdog Timer Kicked\r\n");
+		break;
+	case 4: /*! Piggyback kick on time reads. */
+		status = PCF2131_Watchdog_Piggyback(pcf2131Driver, true);
+		if (SENSOR_ERROR_NONE != status)
+		{
+			PRINTF("\r\n Watchdog Piggyback Failed (Enable it first)\r\n");
+		}
+		else
+			PRINTF("\r\n Watchdog Timer is kicked on every Get Time\r\n");
+		break;
+	default:
+		PRINTF("\r\nInvalid Number\r\n");
+		break;
+	}
+}
+
+/*!@brief        CLKOUT.
+ *  @details     Select the CLKOUT frequency, calibrate the MCU core clock against CLKOUT or
+ *  			 advance the RTC from CLKOUT_PIN in external clock test mode.
+ *  @param[in]   pcf2131Driver   Pointer to sensor handle structure.
+ *  @constraints CLKOUT has to be wired to CLKOUT_PIN for calibration and external clock test mode.
+ *  @reentrant   No
+ *  @return      No
+ */
+void clkOut(pcf2131_sensorhandle_t *pcf2131Driver)
+{
+	uint8_t temp;
+	uint8_t freq;
+	int32_t ppmError;
+	int32_t status;
+	int32_t seconds, multiple;
+	uint32_t achieved;
+	pcf2131_timedata_t before, after;
+
+	PRINTF("\r\n 1.Select CLKOUT Frequency\r\n");
+	PRINTF("\r\n 2.Calibrate MCU Clock against CLKOUT\r\n");
+	PRINTF("\r\n 3.External Clock Test Mode\r\n");
+
+	PRINTF("\r\n Enter your choice :- ");
+	do{
+		SCANF("%d",&temp);
+		PRINTF("%d\r\n",temp);
+		if(temp < 1 || temp > 3)
+			PRINTF("\r\n Invalid Value, Please enter correct value\r\n");
+	}
+	while(temp < 1 || temp > 3);
+
+	switch(temp)
+	{
+	case 1: /*! Select CLKOUT Frequency. */
+		PRINTF("\r\n 0. 32768 Hz\r\n");
+		PRINTF("\r\n 1. 16384 Hz\r\n");
+		PRINTF("\r\n 2. 8192 Hz\r\n");
+		PRINTF("\r\n 3. 4096 Hz\r\n");
+		PRINTF("\r\n 4. 2048 Hz\r\n");
+		PRINTF("\r\n 5. 1024 Hz\r\n");
+		PRINTF("\r\n 6. 1 Hz\r\n");
+		PRINTF("\r\n 7. CLKOUT Disabled\r\n");
+		PRINTF("\r\n Enter your choice :- ");
+		do{
+			SCANF("%d",&freq);
+			PRINTF("%d\r\n",freq);
+			if(freq > clkoutDisable)
+				PRINTF("\r\n Invalid Value, Please enter correct value\r\n");
+		}
+		while(freq > clkoutDisable);
+
+		status = PCF2131_ClkOut_Set(pcf2131Driver, (ClkOutFreq)freq);
+		if (SENSOR_ERROR_NONE != status)
+		{
+			PRINTF("\r\n CLKOUT Frequency Set Failed\r\n");
+		}
+		else
+			PRINTF("\r\n CLKOUT Frequency Set\r\n");
+		break;
+	case 2: /*! Calibrate MCU Clock. */
+		PRINTF("\r\n Calibrating for 4 seconds...\r\n");
+		status = PCF2131_ClkOut_Calibrate(pcf2131Driver, &CLKOUT_PIN, 4 * PCF2131_CLKOUT_CAL_FREQ, &ppmError);
+		if (SENSOR_ERROR_NONE != status)
+		{
+			PRINTF("\r\n MCU Clock Calibration Failed (check CLKOUT wiring)\r\n");
+		}
+		else
+		{
+			PRINTF("\r\n MCU Clock Error :- %d ppm\r\n", ppmError);
+			PRINTF("\r\n Corrected Core Clock :- %d Hz\r\n", BOARD_SystickGetCoreFreq());
+		}
+		break;
+	case 3: /*! External Clock Test Mode. */
+		PRINTF("\r\n Enter RTC seconds to advance :- ");
+		SCANF("%d",&seconds);
+		PRINTF("%d\r\n",seconds);
+		PRINTF("\r\n Enter multiple of real time (1 to %d) :- ", PCF2131_EXT_TEST_MAX_MULTIPLE);
+		SCANF("%d",&multiple);
+		PRINTF("%d\r\n",multiple);
+		if ((seconds <= 0) || (multiple <= 0))
+		{
+			PRINTF("\r\n Invalid Value\r\n");
+			break;
+		}
+
+		PRINTF("\r\n Clocking from " PCF2131_EXT_TEST_OUTPUT "\r\n");
+		status = PCF2131_GetTime(pcf2131Driver, pcf2131timedata, &before);
+		if (SENSOR_ERROR_NONE == status)
+		{
+			status = PCF2131_ExtTest_Enable(pcf2131Driver, &CLKOUT_PIN, PCF2131_EXT_TEST_CLOCK);
+		}
+		if (SENSOR_ERROR_NONE == status)
+		{
+			status = PCF2131_ExtTest_Clock(pcf2131Driver, (uint32_t)seconds, (uint32_t)multiple, &achieved);
+			/*! Always hand the clock back to the oscillator */
+			if (SENSOR_ERROR_NONE != PCF2131_ExtTest_Disable(pcf2131Driver))
+			{
+				status = SENSOR_ERROR_WRITE;
+			}
+		}
+		if (SENSOR_ERROR_NONE == status)
+		{
+			status = PCF2131_GetTime(pcf2131Driver, pcf2131timedata, &after);
+		}
+		if (SENSOR_ERROR_NONE != status)
+		{
+			PRINTF("\r\n External Clock Test Failed, Err = %d\r\n", status);
+			break;
+		}
+		PRINTF("\r\n Clocked %d s at x%d (target x%d), RTC advanced %d ms\r\n", seconds, achieved, multiple,
+				(int32_t)(PCF2131_TimeToMs(&after) - PCF2131_TimeToMs(&before)));
+		break;
+	default:
+		PRINTF("\r\nInvalid Number\r\n");
+		break;
+	}
+}
+
+/*!@brief        Aging Offset.
+ *  @details     Show/set the aging offset or trim it from host supplied reference time samples.
+ *  			 For trimming, the host sends its Unix time in seconds exactly on the second boundary,
+ *  			 the RTC time is read right after each sample.
+ *  @param[in]   pcf2131Driver   Pointer to sensor handle structure.
+ *  @constraints None
+ *  @reentrant   No
+ *  @return      No
+ */
+void agingOffset(pcf2131_sensorhandle_t *pcf2131Driver)
+{
+	uint8_t temp;
+	uint8_t code;
+	int32_t window;
+	int32_t refSec;
+	int32_t status;
+	pcf2131_timedata_t timeData;
+	pcf2131_drift_t drift;
+
+	PRINTF("\r\n 1.Get Aging Offset\r\n");
+	PRINTF("\r\n 2.Set Aging Offset\r\n");
+	PRINTF("\r\n 3.Trim Aging Offset from Reference Time\r\n");
+
+	PRINTF("\r\n Enter your choice :- ");
+	do{
+		SCANF("%d",&temp);
+		PRINTF("%d\r\n",temp);
+		if(temp < 1 || temp > 3)
+			PRINTF("\r\n Invalid Value, Please enter correct value\r\n");
+	}
+	while(temp < 1 || temp > 3);
+
+	switch(temp)
+	{
+	case 1: /*! Get Aging Offset. */
+		status = PCF2131_AgingOffset_Get(pcf2131Driver, &code);
+		if (SENSOR_ERROR_NONE != status)
+		{
+			PRINTF("\r\n Aging Offset Get Failed\r\n");
+		}
+		else
+			PRINTF("\r\n Aging Offset code :- %d (%d ppm)\r\n", code,
+					(PCF2131_AGING_OFFSET_ZERO - code) * PCF2131_AGING_PPM_PER_STEP);
+		break;
+	case 2: /*! Set Aging Offset. */
+		PRINTF("\r\n Enter Aging Offset code (0 to 15, 8 = 0 ppm) :- ");
+		do{
+			SCANF("%d",&code);
+			PRINTF("%d\r\n",code);
+			if(code > PCF2131_AGING_OFFSET_MAX)
+				PRINTF("\r\n Invalid Value, Please enter correct value\r\n");
+		}
+		while(code > PCF2131_AGING_OFFSET_MAX);
+
+		status = PCF2131_AgingOffset_Set(pcf2131Driver, code);
+		if (SENSOR_ERROR_NONE != status)
+		{
+			PRINTF("\r\n Aging Offset Set Failed\r\n");
+		}
+		else
+			PRINTF("\r\n Aging Offset Set\r\n");
+		break;
+	case 3: /*! Trim Aging Offset. */
+		PRINTF("\r\n Enter Window in seconds :- ");
+		SCANF("%d",&window);
+		PRINTF("%d\r\n",window);
+		PCF2131_Drift_Init(&drift, (uint32_t)window, DbgConsole_AsyncPrintf);
+
+		do{
+			PRINTF("\r\n Enter Reference Time (Unix seconds, 0 to finish) :- ");
+			SCANF("%d",&refSec);
+			if (refSec == 0)
+				break;
+			status = PCF2131_GetTime(pcf2131Driver, (const registerreadlist_t *)&pcf2131timedata, &timeData);
+			if (SENSOR_ERROR_NONE != status)
+			{
+				PRINTF("\r\n Get Time Failed\r\n");
+				break;
+			}
+			PRINTF("%d\r\n",refSec);
+			if (SENSOR_ERROR_NONE != PCF2131_Drift_AddSample(&drift, (int64_t)refSec * 1000, &timeData))
+				PRINTF("\r\n Sample rejected, Reference Time must increase\r\n");
+		}
+		while(1);
+
+		status = PCF2131_Drift_Commit(pcf2131Driver, &drift, &code);
+		if (SENSOR_ERROR_NONE != status)
+		{
+			PRINTF("\r\n Aging Offset Trim not applied\r\n");
+		}
+		else
+			PRINTF("\r\n Aging Offset code :- %d\r\n", code);
+		break;
+	default:
+		PRINTF("\r\nInvalid Number\r\n");
+		break;
+	}
+}
+
+/*!@brief        Register Snapshot.
+ *  @details     Takes a register map snapshot and prints it, or restores the configuration saved by
+ *  			 the last snapshot.
+ *  @param[in]   pcf2131Driver   Pointer to sensor handle structure.
+ *  @constraints None
+ *  @reentrant   No
+ *  @return      No
+ */
+void registerSnapshot(pcf2131_sensorhandle_t *pcf2131Driver)
+{
+	static pcf2131_snapshot_t savedSnapshot;
+	static bool isSaved = false;
+	uint8_t temp;
+	uint8_t bursts;
+	uint8_t reg;
+	int32_t status;
+
+	PRINTF("\r\n 1.Take Snapshot\r\n");
+	PRINTF("\r\n 2.Restore Snapshot\r\n");
+
+	PRINTF("\r\n Enter your choice :- ");
+	do{
+		SCANF("%d",&temp);
+		PRINTF("%d\r\n",temp);
+		if(temp < 1 || temp > 2)
+			PRINTF("\r\n Invalid Value, Please enter correct value\r\n");
+	}
+	while(temp < 1 || temp > 2);
+
+	switch(temp)
+	{
+	case 1: /*! Take Snapshot. */
+		status = PCF2131_Snapshot(pcf2131Driver, &savedSnapshot);
+		if (SENSOR_ERROR_NONE != status)
+		{
+			PRINTF("\r\n Snapshot Failed\r\n");
+			break;
+		}
+		isSaved = true;
+		for (reg = 0; reg < PCF2131_REG_MAP_SIZE; reg++)
+		{
+			if ((reg % 8) == 0)
+				PRINTF("\r\n 0x%02X :", reg);
+			PRINTF(" %02X", savedSnapshot.reg[reg]);
+		}
+		PRINTF("\r\n");
+		break;
+	case 2: /*! Restore Snapshot. */
+		if (!isSaved)
+		{
+			PRINTF("\r\n No Snapshot taken\r\n");
+			break;
+		}
+		status = PCF2131_Restore(pcf2131Driver, &savedSnapshot, &bursts);
+		if (SENSOR_ERROR_NONE != status)
+		{
+			PRINTF("\r\n Restore Failed\r\n");
+		}
+		else
+			PRINTF("\r\n Snapshot Restored in %d write burst(s)\r\n", bursts);
+		break;
+	default:
+		PRINTF("\r\nInvalid Number\r\n");
+		break;
+	}
+}
+
+/*! Bus arbiter job reading the time, it runs with the RTC bus held. */
+static void queuedGetTimeJob(void *pUserData)
+{
+	queuedGetTime_t *pQueued = (queuedGetTime_t *)pUserData;
+
+	pQueued->status = PCF2131_GetTime(pQueued->pDriver, (const registerreadlist_t *)&pcf2131timedata, &pQueued->time);
+	pQueued->done = true;
+}
+
+/*!@brief        Polled Operations.
+ *  @details     Runs a get time and a register snapshot as polled operations from a superloop,
+ *  			 counting the loop passes left to other work, and prints the per-poll statistics.
+ *  			 Then queues a get time on the bus arbiter while a polled one holds the bus and prints
+ *  			 the queue wait.
+ *  @param[in]   pcf2131Driver   Pointer to sensor handle structure.
+ *  @constraints None
+ *  @reentrant   No
+ *  @return      No
+ */
+void polledOperations(pcf2131_sensorhandle_t *pcf2131Driver)
+{
+	static pcf2131_snapshot_t snapshot;
+	pcf2131_timedata_t timeData;
+	queuedGetTime_t queued;
+	busArbiterRequest_t request;
+	uint32_t otherWork;
+	int32_t status;
+
+	/*! Get time */
+	otherWork = 0;
+	status = PCF2131_Start_GetTime(pcf2131Driver, &timeData);
+	while (SENSOR_ERROR_BUSY == status)
+	{
+		status = PCF2131_Poll(pcf2131Driver);
+		otherWork++;   /* The rest of the superloop runs here. */
+	}
+	if (SENSOR_ERROR_NONE != status)
+	{
+		PRINTF("\r\n Polled Get Time Failed\r\n");
+		return;
+	}
+	printTime(timeData);
+	PRINTF("\r\n Get Time: %d polls, longest poll %d us, %d loop passes\r\n",
+			pcf2131Driver->poll.polls, pcf2131Driver->poll.maxPoll_us, otherWork);
+
+	/*! Register snapshot */
+	otherWork = 0;
+	status = PCF2131_Start_Snapshot(pcf2131Driver, &snapshot);
+	while (SENSOR_ERROR_BUSY == status)
+	{
+		status = PCF2131_Poll(pcf2131Driver);
+		otherWork++;   /* The rest of the superloop runs here. */
+	}
+	if (SENSOR_ERROR_NONE != status)
+	{
+		PRINTF("\r\n Polled Snapshot Failed\r\n");
+		return;
+	}
+	PRINTF("\r\n Snapshot: %d polls, longest poll %d us, %d loop passes\r\n",
+			pcf2131Driver->poll.polls, pcf2131Driver->poll.maxPoll_us, otherWork);
+
+	/*! Queued get time, it waits in the arbiter queue until the polled get time gives the bus back */
+	otherWork = 0;
+	queued.pDriver = pcf2131Driver;
+	queued.done = false;
+	request.pDevice = &rtcBusDevice;
+	request.job = queuedGetTimeJob;
+	request.pUserData = &queued;
+	request.priority = 1;
+	status = PCF2131_Start_GetTime(pcf2131Driver, &timeData);
+	Bus_Arbiter_Submit(&request);
+	while ((SENSOR_ERROR_BUSY == status) || !queued.done)
+	{
+		if (SENSOR_ERROR_BUSY == status)
+		{
+			status = PCF2131_Poll(pcf2131Driver);
+		}
+		Bus_Arbiter_Service(&rtcBusArbiter);
+		otherWork++;   /* The rest of the superloop runs here. */
+	}
+	if ((SENSOR_ERROR_NONE != status) || (SENSOR_ERROR_NONE != queued.status))
+	{
+		PRINTF("\r\n Queued Get Time Failed\r\n");
+		return;
+	}
+	printTime(queued.time);
+	PRINTF("\r\n Queued Get Time: %d loop passes, average queue wait %d us, longest %d us\r\n",
+			otherWork, Bus_Arbiter_GetAvgWait_us(&rtcBusArbiter), rtcBusArbiter.maxWait_us);
+}
+
+/*!@brief        Console Statistics.
+ *  @details     Measures the cycles a PRINTF costs the caller on the blocking and on the asynchronous
+ *  			 transmit path, and prints the asynchronous transmit counters.
+ *  @constraints None
+ *  @reentrant   No
+ *  @return      No
+ */
+void consoleStatistics(void)
+{
+	debug_console_async_stats_t stats;
+	uint64_t start;
+	uint32_t blockingCycles, asyncCycles;
+
+	/*! Blocking: the caller waits for every character to leave the UART. The queue is drained
+	 *  first, the only blocking write of the demo never interleaves with queued lines */
+	DbgConsole_AsyncFlush();
+	start = BOARD_SystickGetTicks();
+	DbgConsole_Printf("\r\n PRINTF cost test line %d\r\n", 12345);
+	blockingCycles = (uint32_t)(BOARD_SystickGetTicks() - start);
+
+	/*! Asynchronous: formatting and the copy into the ring */
+	start = BOARD_SystickGetTicks();
+	DbgConsole_AsyncPrintf("\r\n PRINTF cost test line %d\r\n", 12345);
+	asyncCycles = (uint32_t)(BOARD_SystickGetTicks() - start);
+
+	DbgConsole_AsyncGetStats(&stats);
+	PRINTF("\r\n PRINTF cost: blocking %d cycles, asynchronous %d cycles\r\n", blockingCycles, asyncCycles);
+	PRINTF("\r\n Queued %d bytes, dropped %d bytes in %d messages, ring high water %d of %d bytes\r\n",
+			stats.queued, stats.dropped, stats.drops, stats.highWater, DEBUG_CONSOLE_ASYNC_BUFFER_LEN);
+}
+
+/*!@brief        Telemetry Stream.
+ *  @details     Streams binary telemetry records at a rate entered by the user, or on every
+ *  			 seconds/minutes interrupt on INTA, until a key is pressed, then prints the counters.
+ *  @param[in]   pcf2131Driver   Pointer to sensor handle structure.
+ *  @constraints None
+ *  @reentrant   No
+ *  @return      No
+ */
+void telemetryStream(pcf2131_sensorhandle_t *pcf2131Driver)
+{
+	pcf2131_streamcfg_t config = {.keyframeInterval = 60};
+	pcf2131_streamstats_t stats;
+	int32_t status;
+
+	PRINTF("\r\n Enter record period in ms (0 = on Seconds/Minutes Interrupt on INTA) :- ");
+	SCANF("%d", &config.period_ms);
+	PRINTF("%d\r\n", config.period_ms);
+	PRINTF("\r\n Streaming, press any key to stop\r\n");
+	DbgConsole_AsyncFlush();
+
+	status = PCF2131_Stream_Run(pcf2131Driver, &config, &stats);
+	GETCHAR();
+	if (SENSOR_ERROR_NONE != status)
+	{
+		PRINTF("\r\n Telemetry Stream Failed\r\n");
+		return;
+	}
+	PRINTF("\r\n Sent %d records, %d bytes, %d timestamp captures, %d read errors, %d clear errors\r\n",
+			stats.records, stats.bytes, stats.captures, stats.readErrors, stats.clearErrors);
+}
+
+/*!@brief        Bus Trace.
+ *  @details     Starts capturing the register transactions of the following menu operations, or stops
+ *  			 the capture and sends the trace in protocol frames with start byte PCF2131_PROTO_SOF_TRACE.
+ *  @constraints None
+ *  @reentrant   No
+ *  @return      No
+ */
+void busTrace(void)
+{
+	registerTraceStats_t stats;
+	uint32_t sent, chunk;
+	int32_t character;
+
+	PRINTF("\r\n 1. Start Capture\r\n");
+	PRINTF("\r\n 2. Stop Capture and Send Trace\r\n");
+	PRINTF("\r\n Enter your choice :- ");
+	SCANF("%d", &character);
+	PRINTF("%d\r\n", character);
+
+	switch (character)
+	{
+	case 1:
+		Register_Trace_Start(busTraceBuffer, sizeof(busTraceBuffer));
+		PRINTF("\r\n Capturing register transactions into %d bytes\r\n", PCF2131_TRACE_BUFFER_SIZE);
+		break;
+	case 2:
+		Register_Trace_Stop(&stats);
+		DbgConsole_AsyncFlush();
+		for (sent = 0; sent < stats.length; sent += chunk)
+		{
+			chunk = stats.length - sent;
+			if (chunk > PCF2131_TRACE_CHUNK_SIZE)
+			{
+				chunk = PCF2131_TRACE_CHUNK_SIZE;
+			}
+			PCF2131_Proto_SendFrame(PCF2131_PROTO_SOF_TRACE, &busTraceBuffer[sent], (uint8_t)chunk);
+		}
+		PRINTF("\r\n Sent %d trace bytes, %d records, %d dropped\r\n", stats.length, stats.records, stats.dropped);
+		break;
+	default:
+		PRINTF("\r\n Invalid option\r\n");
+		break;
+	}
+}
+
 /*!@brief        Set mode (12h/24h).
  *  @details     set 12 hour / 24 hour format.
  *  @param[in]   pcf2131Driver   Pointer to sensor handle structure.
@@ -1441,6 +2042,9 @@ int main(void)
 	uint8_t data[PCF2131_DATA_SIZE];
 	char dummy;
 	pcf2131_sensorhandle_t pcf2131Driver;
+#if !(I2C_ENABLE)
+	uint32_t baudRate;
+#endif
 
 	/* Enable EDMA for I2C/SPI */
 #if (RTE_I2C0_DMA_EN || RTE_SPI1_DMA_EN)
@@ -1458,6 +2062,7 @@ int main(void)
 #endif
 
 
+
 	/* Release peripheral RESET */
 	RESET_PeripheralReset(kLPSPI1_RST_SHIFT_RSTn);
 	RESET_PeripheralReset(kLPI2C0_RST_SHIFT_RSTn);
@@ -1466,6 +2071,10 @@ int main(void)
 	BOARD_InitPins();
 	BOARD_InitBootClocks();
 	BOARD_InitDebugConsole();
+#if (DEBUG_CONSOLE_TX_ASYNC)
+	DbgConsole_AsyncInit();
+#endif
+	BOARD_SystickEnable();
 
 	/*! Register ISR for INTA and INTB */
 	init_pcf2131_wakeup_intA();
@@ -1509,9 +2118,9 @@ int main(void)
 
 	/*! Initialize the PCF2131 RTC driver. */
 #if (I2C_ENABLE)
-	status = PCF2131_Initialize(&pcf2131Driver, &I2C_S_DRIVER, I2C_S_DEVICE_INDEX, PCF2131_I2C_ADDR);
+	status = PCF2131_Initialize(&pcf2131Driver, pdriver, I2C_S_DEVICE_INDEX, PCF2131_I2C_ADDR);
 #else
-	status = PCF2131_Initialize(&pcf2131Driver, &SPI_S_DRIVER, SPI_S_DEVICE_INDEX, &PCF2131_CS);
+	status = PCF2131_Initialize(&pcf2131Driver, pdriver, SPI_S_DEVICE_INDEX, &PCF2131_CS);
 #endif
 	if (SENSOR_ERROR_NONE != status)
 	{
@@ -1519,6 +2128,30 @@ int main(void)
 		return -1;
 	}
 
+	/*! Share the RTC bus through the arbiter, the RTC keeps the speed the link settles on. */
+#if (I2C_ENABLE)
+	Bus_Arbiter_Init(&rtcBusArbiter, pdriver, BUS_ARBITER_I2C);
+#else
+	Bus_Arbiter_Init(&rtcBusArbiter, pdriver, BUS_ARBITER_SPI);
+#endif
+	PCF2131_SetArbiter(&pcf2131Driver, &rtcBusDevice);
+
+#if (I2C_ENABLE)
+	/*! Select the fastest stable I2C bus speed. */
+	status = PCF2131_I2C_Negotiate(&pcf2131Driver, 32, DbgConsole_AsyncPrintf);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		PRINTF("\r\n I2C Bus Speed Negotiation Failed, Err = %d\r\n", status);
+	}
+#else
+	/*! Step the SPI link up to the fastest baud rate passing read-back verification. */
+	status = PCF2131_SPI_Tune(&pcf2131Driver, &pcf2131SpiTune, &baudRate);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		PRINTF("\r\n SPI Baud Rate Tuning Failed, Err = %d\r\n", status);
+	}
+#endif
+
 	/*! Configure the PCF2131 RTC driver. */
 	status = PCF2131_Configure(&pcf2131Driver, pcf2131ConfigDefault);
 	if (SENSOR_ERROR_NONE != status)
@@ -1546,7 +2179,16 @@ int main(void)
 		PRINTF("\r\n 11. Set Alarm Time \r\n");
 		PRINTF("\r\n 12. Alarm Interrupt \r\n");
 		PRINTF("\r\n 13. Clear Interrupts\r\n");
-		PRINTF("\r\n 14. Exit \r\n");
+		PRINTF("\r\n 14. Watchdog Timer\r\n");
+		PRINTF("\r\n 15. CLKOUT\r\n");
+		PRINTF("\r\n 16. Aging Offset\r\n");
+		PRINTF("\r\n 17. Register Snapshot\r\n");
+		PRINTF("\r\n 18. Polled Operations\r\n");
+		PRINTF("\r\n 19. Binary Protocol\r\n");
+		PRINTF("\r\n 20. Console Statistics\r\n");
+		PRINTF("\r\n 21. Telemetry Stream\r\n");
+		PRINTF("\r\n 22. Bus Trace\r\n");
+		PRINTF("\r\n 23. Exit \r\n");
 		PRINTF("\r\n");
 
 		PRINTF("\r\n Enter your choice :- ");
@@ -1622,8 +2264,36 @@ int main(void)
 			PRINTF("\r\n Clearing Interrupts!!\r\n");
 			clearInterrupts(&pcf2131Driver);
 			break;
-		case 14:  /* Exit */
+		case 14:  /* Watchdog Timer */
+			watchdogTimer(&pcf2131Driver);
+			break;
+		case 15:  /* CLKOUT */
+			clkOut(&pcf2131Driver);
+			break;
+		case 16:  /* Aging Offset */
+			agingOffset(&pcf2131Driver);
+			break;
+		case 17:  /* Register Snapshot */
+			registerSnapshot(&pcf2131Driver);
+			break;
+		case 18:  /* Polled Operations */
+			polledOperations(&pcf2131Driver);
+			break;
+		case 19:  /* Binary Protocol */
+			PCF2131_Proto_Run(&pcf2131Driver);
+			break;
+		case 20:  /* Console Statistics */
+			consoleStatistics();
+			break;
+		case 21:  /* Telemetry Stream */
+			telemetryStream(&pcf2131Driver);
+			break;
+		case 22:  /* Bus Trace */
+			busTrace();
+			break;
+		case 23:  /* Exit */
 			PRINTF("\r\n .....Bye\r\n");
+			DbgConsole_AsyncFlush();
 			exit(0);
 			break;
 		default:
@@ -0,0 +1,186 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file pcf2131_stream.c
+ * @brief The pcf2131_stream.c file implements the binary telemetry stream of the PCF2131 demo.
+ */
+
+#include <string.h>
+#include "debug_console_async.h"
+#include "systick_utils.h"
+#include "pcf2131_proto.h"
+#include "pcf2131_stream.h"
+
+//-----------------------------------------------------------------------
+// Global Variables
+//-----------------------------------------------------------------------
+static const uint8_t pcf2131_streamTsReg[4] = {
+	PCF2131_TIMESTAMP1_SECONDS, PCF2131_TIMESTAMP2_SECONDS, PCF2131_TIMESTAMP3_SECONDS, PCF2131_TIMESTAMP4_SECONDS};
+
+static const uint8_t pcf2131_streamTsFlag[4] = {
+	PCF2131_CTRL4_TSF1_MASK, PCF2131_CTRL4_TSF2_MASK, PCF2131_CTRL4_TSF3_MASK, PCF2131_CTRL4_TSF4_MASK};
+
+static volatile bool pcf2131_streamActive = false;
+static volatile uint8_t pcf2131_streamPending = 0;
+
+//-----------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------
+
+/* Waits for the next record trigger, returns false once a character is received. */
+static bool PCF2131_StreamWait(const pcf2131_streamcfg_t *pConfig, uint64_t *pNext)
+{
+	while (!DbgConsole_AsyncRxReady())
+	{
+		if (pConfig->period_ms == 0)
+		{
+			if (pcf2131_streamPending)
+			{
+				pcf2131_streamPending = 0;
+				return true;
+			}
+		}
+		else if (BOARD_SystickGetTicks() >= *pNext)
+		{
+			*pNext += (uint64_t)pConfig->period_ms * BOARD_SystickGetCoreFreq() / 1000;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int32_t PCF2131_Stream_Run(pcf2131_sensorhandle_t *pSensorHandle, const pcf2131_streamcfg_t *pConfig,
+		pcf2131_streamstats_t *pStats)
+{
+	uint8_t buffer[PCF2131_BUF_HEADROOM + PCF2131_CTRL_TIME_SIZE_BYTE];
+	uint8_t ts[PCF2131_BUF_HEADROOM + PCF2131_TS_SIZE_BYTE];
+	uint8_t last[PCF2131_CTRL_TIME_SIZE_BYTE];
+	uint8_t record[PCF2131_STREAM_MAX_RECORD];
+	pcf2131_streamstats_t stats;
+	uint64_t next, prev, now;
+	uint16_t seq = 0, mask, sinceKey = 0;
+	uint8_t i, len, tsMask;
+	bool haveLast = false;
+	uint32_t ms;
+
+	/*! Validate for the correct handle and settings.*/
+	if ((pSensorHandle == NULL) || (pConfig == NULL))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before streaming.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	memset(&stats, 0, sizeof(stats));
+	pcf2131_streamPending = 0;
+	pcf2131_streamActive = true;
+	prev = next = BOARD_SystickGetTicks();
+
+	while (PCF2131_StreamWait(pConfig, &next))
+	{
+		now = BOARD_SystickGetTicks();
+		ms = (uint32_t)((now - prev) * 1000 / BOARD_SystickGetCoreFreq());
+		prev = now;
+		len = 7;
+		tsMask = 0;
+
+		/*! Control and time registers in one burst, only the changed ones are sent */
+		if (SENSOR_ERROR_NONE != PCF2131_ReadInPlace(pSensorHandle, PCF2131_CTRL1, PCF2131_CTRL_TIME_SIZE_BYTE, buffer))
+		{
+			mask = PCF2131_STREAM_READ_ERROR;
+			stats.readErrors++;
+		}
+		else
+		{
+			mask = (!haveLast || (sinceKey >= pConfig->keyframeInterval)) ? PCF2131_STREAM_KEYFRAME : 0;
+			for (i = 0; i < PCF2131_CTRL_TIME_SIZE_BYTE; i++)
+			{
+				if ((mask & PCF2131_STREAM_KEYFRAME) || (buffer[PCF2131_BUF_HEADROOM + i] != last[i]))
+				{
+					mask |= (uint16_t)(1U << i);
+					record[len++] = buffer[PCF2131_BUF_HEADROOM + i];
+				}
+			}
+			memcpy(last, &buffer[PCF2131_BUF_HEADROOM], PCF2131_CTRL_TIME_SIZE_BYTE);
+			haveLast = true;
+			sinceKey = (mask & PCF2131_STREAM_KEYFRAME) ? 1 : (uint16_t)(sinceKey + 1);
+
+			/*! Every set timestamp flag is a capture, sent then cleared so the next one sets it again */
+			for (i = 0; i < 4; i++)
+			{
+				if ((last[PCF2131_CTRL4] & pcf2131_streamTsFlag[i]) &&
+						(SENSOR_ERROR_NONE == PCF2131_ReadInPlace(pSensorHandle, pcf2131_streamTsReg[i],
+						PCF2131_TS_SIZE_BYTE, ts)))
+				{
+					tsMask |= (uint8_t)(1U << i);
+					memcpy(&record[len], &ts[PCF2131_BUF_HEADROOM], PCF2131_TS_SIZE_BYTE);
+					len += PCF2131_TS_SIZE_BYTE;
+					stats.captures++;
+				}
+			}
+
+			/*! All sent flags in one write of the Control_4 value just read, as PCF2131_Clear_SW_TsInt()
+			 *  would write it per flag. A flag whose capture could not be read stays set for the next record. */
+			if (tsMask != 0)
+			{
+				ts[PCF2131_BUF_HEADROOM] = last[PCF2131_CTRL4];
+				for (i = 0; i < 4; i++)
+				{
+					if (tsMask & (1U << i))
+					{
+						ts[PCF2131_BUF_HEADROOM] &= (uint8_t)~pcf2131_streamTsFlag[i];
+					}
+				}
+				if (SENSOR_ERROR_NONE != PCF2131_WriteInPlace(pSensorHandle, PCF2131_CTRL4, 1, ts))
+				{
+					stats.clearErrors++;
+				}
+			}
+
+			/*! Rearm a level minute/second interrupt */
+			if ((pConfig->period_ms == 0) && (last[PCF2131_CTRL2] & PCF2131_CTRL2_MSF_MASK))
+			{
+				PCF2131_Clear_MinSecInt(pSensorHandle);
+			}
+		}
+
+		record[0] = (uint8_t)seq;
+		record[1] = (uint8_t)(seq >> 8);
+		record[2] = (uint8_t)((ms > 0xFFFF) ? 0xFF : ms);
+		record[3] = (uint8_t)((ms > 0xFFFF) ? 0xFF : (ms >> 8));
+		record[4] = (uint8_t)mask;
+		record[5] = (uint8_t)(mask >> 8);
+		record[6] = tsMask;
+		PCF2131_Proto_SendFrame(PCF2131_PROTO_SOF_TLM, record, len);
+		seq++;
+		stats.records++;
+		stats.bytes += len;
+	}
+
+	pcf2131_streamActive = false;
+	if (pStats != NULL)
+	{
+		*pStats = stats;
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
+bool PCF2131_Stream_Notify(void)
+{
+	if (pcf2131_streamActive)
+	{
+		pcf2131_streamPending = 1;
+	}
+
+	return pcf2131_streamActive;
+}
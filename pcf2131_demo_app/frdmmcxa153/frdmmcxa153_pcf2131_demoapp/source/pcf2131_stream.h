@@ -0,0 +1,91 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file pcf2131_stream.h
+ * @brief The pcf2131_stream.h file describes the binary telemetry stream of the PCF2131 demo,
+ *        for watching the RTC continuously, e.g. in an environmental chamber.
+ *
+ * Records go out in protocol frames (see pcf2131_proto.h) with start byte PCF2131_PROTO_SOF_TLM.
+ * Record payload:
+ *
+ *   seq[2]     Record sequence number, little endian, a gap means lost records.
+ *   ticks[2]   Milliseconds since the previous record, little endian.
+ *   mask[2]    Little endian. Bits 0 to 13: register 0x00 (Control_1) to 0x0D (Years) follows.
+ *              PCF2131_STREAM_KEYFRAME: all 14 registers follow. PCF2131_STREAM_READ_ERROR: the
+ *              registers could not be read, none follows.
+ *   ts         Bits 0 to 3: timestamp 1 to 4 flag (TSF1 to TSF4) set, its capture follows. The flag is
+ *              cleared after the capture is read, so each set flag is one event. Should the clear fail
+ *              the capture is sent again with the next record.
+ *   registers  The raw values of the registers flagged in mask, in address order.
+ *   captures   The 6 raw registers from Second_timestamp of each timestamp flagged in ts.
+ *
+ * Registers not flagged hold their value from the previous record. The host rebuilds the
+ * register block from the last keyframe, after a sequence gap it waits for the next keyframe.
+ * Control_2 to Control_4 carry the interrupt, battery and timestamp flags.
+ */
+
+#ifndef PCF2131_STREAM_H_
+#define PCF2131_STREAM_H_
+
+/* Standard C Includes */
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "pcf2131_drv.h"
+
+/*! @brief Flags of the record mask. */
+#define PCF2131_STREAM_READ_ERROR    (0x4000)
+#define PCF2131_STREAM_KEYFRAME      (0x8000)
+
+/*! @brief Longest record payload: header, all registers and all four captures. */
+#define PCF2131_STREAM_MAX_RECORD    (7 + PCF2131_CTRL_TIME_SIZE_BYTE + 4 * PCF2131_TS_SIZE_BYTE)
+
+/*! @brief This structure holds the stream settings.*/
+typedef struct
+{
+	uint32_t period_ms;          /*!< Record period, 0 for a record on every PCF2131_Stream_Notify().*/
+	uint16_t keyframeInterval;   /*!< Records between keyframes, 0 for keyframes only.*/
+} pcf2131_streamcfg_t;
+
+/*! @brief This structure holds the stream counters.*/
+typedef struct
+{
+	uint32_t records;            /*!< Records sent.*/
+	uint32_t bytes;              /*!< Payload bytes sent.*/
+	uint32_t readErrors;         /*!< Records with PCF2131_STREAM_READ_ERROR.*/
+	uint32_t captures;           /*!< Timestamp captures sent.*/
+	uint32_t clearErrors;        /*!< Failed clears of sent timestamp flags.*/
+} pcf2131_streamstats_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*! @brief       Streams telemetry records until a character is received on the debug console.
+ *  @details     The first record is a keyframe. In interrupt mode the minute/second flag is cleared after
+ *               each record so that a level interrupt fires again. The character is left unread.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @param[in]   pConfig  			Pointer to stream settings.
+ *  @param[out]  pStats  			Stream counters, NULL if not needed.
+ *  @constraints This can be called only after PCF2131_Initialize(). In interrupt mode the seconds or
+ *               minutes interrupt must be routed to the pin whose handler calls PCF2131_Stream_Notify().
+ *  @reentrant   No
+ *  @return      ::PCF2131_Stream_Run() returns the status.
+ */
+int32_t PCF2131_Stream_Run(pcf2131_sensorhandle_t *pSensorHandle, const pcf2131_streamcfg_t *pConfig,
+		pcf2131_streamstats_t *pStats);
+
+/*! @brief       Triggers a record in interrupt mode.
+ *  @details     Call it from the RTC pin interrupt handler.
+ *  @constraints None
+ *  @reentrant   Yes
+ *  @return      ::PCF2131_Stream_Notify() returns true while a stream is running, the handler
+ *               should then stay silent on the console.
+ */
+bool PCF2131_Stream_Notify(void);
+
+#endif /* PCF2131_STREAM_H_ */
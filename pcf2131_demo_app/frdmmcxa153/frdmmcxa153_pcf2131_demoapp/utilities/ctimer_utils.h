@@ -0,0 +1,55 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file ctimer_utils.h
+ * @brief CTIMER Clock Output Utilities.
+
+    This file provides a counted clock on a CTIMER match output, e.g. for the
+    external clock test mode of the PCF2131 (pcf2131_extclk_t). The board header
+    selects the timer with BOARD_EXT_CLK_CTIMER, the match channel (0 to 2),
+    the timer clock frequency and the clock and pin setup.
+*/
+
+#ifndef __CTIMER_UTILS_H__
+#define __CTIMER_UTILS_H__
+
+#include <stdint.h>
+
+/*! @brief       Function to start the clock output.
+ *  @details     This function clocks the timer, routes the match output to its pin and drives it low.
+ *  @param[in]   void.
+ *  @return      void.
+ *  @constraints This should be the first function to be invoked before other CTIMER clock APIs.
+ *  @reeentrant  No
+ */
+void BOARD_CtimerClockStart(void);
+
+/*! @brief       Function to clock a number of edges.
+ *  @details     This function runs the timer in PWM mode, one rising edge per period, and counts the
+ *               periods with the interrupts masked for at most a millisecond at a time. The timer stops
+ *               with the output low after every millisecond, so the count stays exact when the
+ *               interrupts are served in between.
+ *  @param[in]   freq  The edge rate in Hz, rounded to a whole number of timer clocks per period.
+ *  @param[in]   edges The number of rising edges.
+ *  @return      int32_t 0, -1 if the timer cannot produce freq, -2 if the count ran late by half a period
+ *               and edges may have been lost.
+ *  @constraints This should be invoked after BOARD_CtimerClockStart().
+ *  @reeentrant  No
+ */
+int32_t BOARD_CtimerClockRun(uint32_t freq, uint32_t edges);
+
+/*! @brief       Function to stop the clock output.
+ *  @details     This function stops the timer and releases the pin.
+ *  @param[in]   void.
+ *  @return      void.
+ *  @constraints None.
+ *  @reeentrant  No
+ */
+void BOARD_CtimerClockStop(void);
+
+#endif // __CTIMER_UTILS_H__
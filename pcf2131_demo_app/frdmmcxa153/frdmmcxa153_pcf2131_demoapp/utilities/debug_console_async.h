@@ -0,0 +1,121 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file debug_console_async.h
+ * @brief Asynchronous transmit path of the debug console.
+
+    PRINTF formats into a local buffer and copies the message into a transmit ring, the LPUART
+    TX-empty interrupt drains the ring. Callers return after the copy instead of waiting for the UART.
+    Messages are queued whole. When the ring is full a thread waits for space, an interrupt handler
+    (or code running with interrupts masked) drops the message and counts it.
+*/
+
+#ifndef __DEBUG_CONSOLE_ASYNC_H__
+#define __DEBUG_CONSOLE_ASYNC_H__
+
+#include <stdint.h>
+#include "fsl_debug_console.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Set to 0 to keep PRINTF and PUTCHAR blocking. */
+#ifndef DEBUG_CONSOLE_TX_ASYNC
+#define DEBUG_CONSOLE_TX_ASYNC (1U)
+#endif
+
+/*! @brief Transmit ring size in bytes, a power of two. */
+#ifndef DEBUG_CONSOLE_ASYNC_BUFFER_LEN
+#define DEBUG_CONSOLE_ASYNC_BUFFER_LEN (1024U)
+#endif
+
+/*! @brief Longest message, longer ones are truncated. */
+#ifndef DEBUG_CONSOLE_ASYNC_MAX_LOG_LEN
+#define DEBUG_CONSOLE_ASYNC_MAX_LOG_LEN (128U)
+#endif
+
+/*! @brief Transmit statistics. */
+typedef struct
+{
+    uint32_t queued;    /* Bytes queued. */
+    uint32_t dropped;   /* Bytes dropped on a full ring. */
+    uint32_t drops;     /* Messages dropped on a full ring. */
+    uint32_t highWater; /* Highest ring fill in bytes. */
+} debug_console_async_stats_t;
+
+#if (DEBUG_CONSOLE_TX_ASYNC)
+#undef PRINTF
+#define PRINTF DbgConsole_AsyncPrintf
+#undef PUTCHAR
+#define PUTCHAR DbgConsole_AsyncPutchar
+#endif
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+/*! @brief       Starts the asynchronous transmit path.
+ *  @details     Takes over the LPUART interrupt of the debug console, receive stays polled.
+ *  @param[in]   void.
+ *  @return      kStatus_Success.
+ *  @constraints Call it after BOARD_InitDebugConsole(). Until then the calls below are blocking.
+ *  @reeentrant  No
+ */
+status_t DbgConsole_AsyncInit(void);
+
+/*! @brief       Queues a formatted message.
+ *  @param[in]   fmt_s  Format string, followed by its arguments.
+ *  @return      Number of characters queued, 0 if the message was dropped.
+ *  @constraints None, it can be called from interrupt handlers.
+ *  @reeentrant  Yes
+ */
+int DbgConsole_AsyncPrintf(const char *fmt_s, ...);
+
+/*! @brief       Queues one character.
+ *  @param[in]   ch  Character.
+ *  @return      1, 0 if the character was dropped.
+ *  @constraints None, it can be called from interrupt handlers.
+ *  @reeentrant  Yes
+ */
+int DbgConsole_AsyncPutchar(int ch);
+
+/*! @brief       Queues raw bytes as one message.
+ *  @details     The message is queued whole or, on a full ring, dropped whole.
+ *  @param[in]   pData   Bytes to send.
+ *  @param[in]   length  Number of bytes.
+ *  @return      Number of bytes queued, 0 if the message was dropped.
+ *  @constraints None, it can be called from interrupt handlers.
+ *  @reeentrant  Yes
+ */
+int DbgConsole_AsyncWrite(const uint8_t *pData, uint32_t length);
+
+/*! @brief       Waits until everything queued is on the line.
+ *  @param[in]   void.
+ *  @return      void.
+ *  @constraints Thread context only, call it before a reset or a blocking write.
+ *  @reeentrant  No
+ */
+void DbgConsole_AsyncFlush(void);
+
+/*! @brief       Checks for a received character without reading it.
+ *  @details     Lets a streaming loop stop on a key press, GETCHAR() then reads the character.
+ *  @param[in]   void.
+ *  @return      true if a character is waiting.
+ *  @constraints None.
+ *  @reeentrant  Yes
+ */
+bool DbgConsole_AsyncRxReady(void);
+
+/*! @brief       Gets the transmit statistics.
+ *  @param[out]  pStats  Statistics.
+ *  @return      void.
+ *  @constraints None.
+ *  @reeentrant  Yes
+ */
+void DbgConsole_AsyncGetStats(debug_console_async_stats_t *pStats);
+
+#endif /* __DEBUG_CONSOLE_ASYNC_H__ */
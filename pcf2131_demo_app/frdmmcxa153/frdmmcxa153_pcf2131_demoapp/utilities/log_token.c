@@ -0,0 +1,39 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file log_token.c
+ * @brief Tokenized deferred logging, records queued on the asynchronous debug console.
+ */
+
+#include <string.h>
+#include "log_token.h"
+#include "systick_utils.h"
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+void Log_TokenWrite(uint32_t token, const uint32_t *pArgs, uint32_t nArgs)
+{
+    uint8_t record[2U + (2U + LOG_TOKEN_MAX_ARGS) * sizeof(uint32_t)];
+    uint32_t header[2];
+
+    if (nArgs > LOG_TOKEN_MAX_ARGS)
+    {
+        nArgs = LOG_TOKEN_MAX_ARGS;
+    }
+
+    /* The words are copied as stored, little endian on Cortex-M. */
+    header[0] = token;
+    header[1] = (uint32_t)BOARD_SystickGetTicks();
+    record[0] = LOG_TOKEN_SYNC;
+    record[1] = (uint8_t)(2U + nArgs);
+    (void)memcpy(&record[2], header, sizeof(header));
+    (void)memcpy(&record[2U + sizeof(header)], pArgs, nArgs * sizeof(uint32_t));
+
+    (void)DbgConsole_AsyncWrite(record, 2U + sizeof(header) + nArgs * sizeof(uint32_t));
+}
@@ -26,6 +26,18 @@
  */
 void BOARD_SystickEnable(void);
 
+#ifdef SDK_OS_FREE_RTOS
+/*! @brief       Function to count the systick reloads under FreeRTOS.
+ *  @details     FreeRTOS programs and owns the SysTick, so BOARD_SystickEnable() must not be called.
+ *               Call this function from vApplicationTickHook() to keep BOARD_SystickGetTicks() running.
+ *  @param[in]   void.
+ *  @return      void.
+ *  @constraints configUSE_TICK_HOOK must be set.
+ *  @reeentrant  No
+ */
+void BOARD_SystickTickHook(void);
+#endif
+
 /*! @brief       Function to Record the Start systick.
  *  @details     This function records the current systick count for other APIs to compute difference.
  *  @param[in]   pStart Pointer to the variable to store the current/start systick.
@@ -56,6 +68,37 @@ int32_t BOARD_SystickElapsedTicks(int32_t *pStart);
  */
 uint32_t BOARD_SystickElapsedTime_us(int32_t *pStart);
 
+/*! @brief       Function to read the free running systick count.
+ *  @details     This function returns the number of systicks since BOARD_SystickEnable(), extended to
+ *               64 bits with the overflow counter. Unlike BOARD_SystickStart() it keeps no shared
+ *               state, so it can be used for deadlines inside an ongoing measurement.
+ *  @param[in]   void.
+ *  @return      uint64_t The systick count.
+ *  @constraints The count stops when the systick interrupt is masked for longer than one reload period.
+ *  @reeentrant  Yes
+ */
+uint64_t BOARD_SystickGetTicks(void);
+
+/*! @brief       Function to get the corrected core clock frequency.
+ *  @details     This function returns the core clock frequency with the error stored by
+ *               BOARD_SystickSetClockCorrection() applied. It is used for all tick to time conversions.
+ *  @param[in]   void.
+ *  @return      uint32_t The corrected core clock frequency in Hz.
+ *  @constraints None.
+ *  @reeentrant  Yes
+ */
+uint32_t BOARD_SystickGetCoreFreq(void);
+
+/*! @brief       Function to set the core clock correction.
+ *  @details     This function stores the measured core clock error, e.g. from a calibration
+ *               against an accurate reference clock.
+ *  @param[in]   ppm The core clock error in ppm (positive when the core clock runs fast).
+ *  @return      void.
+ *  @constraints None.
+ *  @reeentrant  No
+ */
+void BOARD_SystickSetClockCorrection(int32_t ppm);
+
 /*! @brief       Function to insert delays.
  *  @details     This function blocks for the specified milli seconds by using the elapsed systicks
  *               to determine time delays.
@@ -10,6 +10,7 @@
  */
 
 #include "frdmmcxn947.h"
+#include "register_io_i2c.h"
 
 // I2C2 Pin Handles
 gpioHandleKSDK_t D14 = {.base = GPIO4, .pinNumber = 0, .mask = 1 << (0), .clockName = kCLOCK_Gpio4, .portNumber = 4};
@@ -32,6 +33,9 @@ gpioHandleKSDK_t INTA_PIN = {.base = GPIO0, .pinNumber = 28, .mask = 1 << (28),
 
 gpioHandleKSDK_t INTB_PIN = {.base = GPIO0, .pinNumber = 10, .mask = 1 << (10), .irq = GPIO01_IRQn , .clockName = kCLOCK_Gpio0, .portNumber = 0};
 
+/* PCF2131 CLKOUT, wire the shield CLKOUT to Arduino D2 for clock calibration */
+gpioHandleKSDK_t CLKOUT_PIN = {.base = GPIO0, .pinNumber = 29, .mask = 1 << (29), .clockName = kCLOCK_Gpio0, .portNumber = 0};
+
 // LPCXpresso55s69 Internal Peripheral Pin Definitions
 gpioHandleKSDK_t RED_LED = {
     .base = GPIO0, .pinNumber = 10, .mask = 1 << (10), .clockName = kCLOCK_Gpio0, .portNumber = 0};
@@ -118,6 +122,49 @@ uint32_t LPI2C2_GetFreq(void)
     return CLOCK_GetLPFlexCommClkFreq(2U);
 }
 
+/*! @brief       Recovers the shield I2C bus.
+ *  @details     The bus recovery required by register_io_i2c.c, as the LPI2C CMSIS driver does not support
+ *               ARM_I2C_BUS_CLEAR. Clocks SCL until the slave releases SDA (at most 9 pulses), issues a STOP
+ *               and hands the pins back to LPI2C2.
+ *  @param[in]   deviceInstance The I2C device number.
+ *  @Constraints None
+ *  @Reentrant   No
+ *  @return      void
+ */
+void BOARD_I2C_BusClear(uint8_t deviceInstance)
+{
+    GENERIC_DRIVER_GPIO *pGpioDriver = &Driver_GPIO_KSDK;
+    uint32_t pulse;
+
+    if (deviceInstance != I2C_S1_DEVICE_INDEX)
+    {
+        return;
+    }
+
+    LPI2C2_DeinitPins();
+    pGpioDriver->pin_init(&D14, GPIO_DIRECTION_IN, NULL, NULL, NULL);
+    pGpioDriver->pin_init(&D15, GPIO_DIRECTION_OUT, NULL, NULL, NULL);
+    for (pulse = 0; (pulse < 9) && !pGpioDriver->read_pin(&D14); pulse++)
+    {
+        pGpioDriver->clr_pin(&D15);
+        SDK_DelayAtLeastUs(5, SystemCoreClock);
+        pGpioDriver->set_pin(&D15);
+        SDK_DelayAtLeastUs(5, SystemCoreClock);
+    }
+
+    /* STOP: SDA rises while SCL is high. */
+    pGpioDriver->clr_pin(&D15);
+    pGpioDriver->pin_init(&D14, GPIO_DIRECTION_OUT, NULL, NULL, NULL);
+    pGpioDriver->clr_pin(&D14);
+    SDK_DelayAtLeastUs(5, SystemCoreClock);
+    pGpioDriver->set_pin(&D15);
+    SDK_DelayAtLeastUs(5, SystemCoreClock);
+    pGpioDriver->set_pin(&D14);
+    SDK_DelayAtLeastUs(5, SystemCoreClock);
+
+    LPI2C2_InitPins();
+}
+
 /*! @brief       Determines the Clock Frequency feature.
  *  @details     The Clock Frequecny computation API required by fsl_spi_cmsis.c.
  *  @param[in]   void
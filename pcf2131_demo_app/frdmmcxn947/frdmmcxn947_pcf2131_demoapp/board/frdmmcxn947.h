@@ -37,6 +37,25 @@ extern gpioHandleKSDK_t D2;
 extern gpioHandleKSDK_t INTA_PIN;
 //GPIO Handle
 extern gpioHandleKSDK_t INTB_PIN;
+extern gpioHandleKSDK_t CLKOUT_PIN;
+
+// CTIMER match output clocking CLKOUT in external clock test mode (ctimer_utils.h). The CLKOUT pin has no
+// CTIMER function, wire P0_26 (CT0_MAT2) to CLKOUT for the test. P0_26 also carries FC1_P2 of the shield
+// LPSPI1 bus, so only I2C builds use the timer.
+#define BOARD_EXT_CLK_CTIMER       CTIMER0
+#define BOARD_EXT_CLK_CTIMER_MATCH 2U
+#define BOARD_EXT_CLK_CTIMER_FREQ  CLOCK_GetCTimerClkFreq(0U)
+#define BOARD_EXT_CLK_CTIMER_ON_SPI_S
+#define BOARD_EXT_CLK_CTIMER_INIT()                            \
+    do                                                         \
+    {                                                          \
+        CLOCK_SetClkDiv(kCLOCK_DivCtimer0Clk, 1U);             \
+        CLOCK_AttachClk(kFRO_HF_to_CTIMER0);                   \
+        CLOCK_EnableClock(kCLOCK_Timer0);                      \
+        RESET_ReleasePeripheralReset(kCTIMER0_RST_SHIFT_RSTn); \
+        PORT_SetPinMux(PORT0, 26U, kPORT_MuxAlt4);             \
+    } while (0)
+#define BOARD_EXT_CLK_CTIMER_DEINIT() PORT_SetPinMux(PORT0, 26U, kPORT_PinDisabledOrAnalog)
 
 // LPCXpresso54114 Internal Peripheral Pin Definitions
 extern gpioHandleKSDK_t RED_LED;
@@ -82,6 +101,8 @@ extern gpioHandleKSDK_t BLUE_LED;
 status_t SMC_SetPowerModeWait(void *arg);
 /* @brief Kinetis style Wrapper API for Power Mode VLPR (Wait for Interrupt). */
 status_t SMC_SetPowerModeVlpr(void *arg);
+/* @brief Shield I2C bus recovery (clocks out SCL), used on transfer timeout by register_io_i2c.c. */
+void BOARD_I2C_BusClear(uint8_t deviceInstance);
 /* @brief Kinetis style Wrapper API for handling all Clock related configurations. */
 void BOARD_BootClockRUN(void);
 #endif /* FRDM_MCXN947_H_ */
@@ -0,0 +1,222 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file bus_arbiter.c
+ * @brief The bus_arbiter.c file contains the arbiter sharing one SPI/I2C bus between several device handles.
+ */
+
+/* Standard C Includes */
+#include <string.h>
+
+/* ISSDK Includes */
+#include "fsl_common.h"
+#include "Driver_SPI.h"
+#include "Driver_I2C.h"
+#include "systick_utils.h"
+#include "bus_arbiter.h"
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/* Programs the speed of the device, the caller holds the bus. */
+static int32_t bus_arbiter_speed(busArbiter_t *pArbiter, busArbiterDevice_t *pDevice)
+{
+    int32_t status;
+
+    if ((pDevice->busSpeed == 0) || (pDevice->busSpeed == pArbiter->busSpeed))
+    {
+        return ARM_DRIVER_OK;
+    }
+
+    if (BUS_ARBITER_SPI == pArbiter->type)
+    {
+        status = ((ARM_DRIVER_SPI *)pArbiter->pBus)->Control(ARM_SPI_SET_BUS_SPEED, pDevice->busSpeed);
+    }
+    else
+    {
+        status = ((ARM_DRIVER_I2C *)pArbiter->pBus)->Control(ARM_I2C_BUS_SPEED, pDevice->busSpeed);
+    }
+
+    pArbiter->busSpeed = (ARM_DRIVER_OK == status) ? pDevice->busSpeed : 0;
+
+    return status;
+}
+
+/*! The interface function to initialize a bus arbiter. */
+void Bus_Arbiter_Init(busArbiter_t *pArbiter, void *pBus, busArbiterType_t type)
+{
+    memset(pArbiter, 0, sizeof(busArbiter_t));
+    pArbiter->pBus = pBus;
+    pArbiter->type = type;
+    pArbiter->timeout_us = BUS_ARBITER_TIMEOUT_US;
+}
+
+/*! The interface function to set how Bus_Arbiter_Acquire() waits for a bus held by another device. */
+void Bus_Arbiter_SetWait(busArbiter_t *pArbiter, uint32_t timeout_us, registeridlefunction_t idleFunction, void *pIdleData)
+{
+    pArbiter->timeout_us = timeout_us;
+    pArbiter->idleFunction = idleFunction;
+    pArbiter->pIdleData = pIdleData;
+}
+
+/*! The interface function to take the bus for a transaction. */
+int32_t Bus_Arbiter_Acquire(busArbiterDevice_t *pDevice)
+{
+    int32_t status;
+    uint32_t regPrimask;
+    uint64_t start = 0;
+    busArbiter_t *pArbiter;
+
+    if (pDevice == NULL)
+    {
+        return ARM_DRIVER_OK;
+    }
+    pArbiter = pDevice->pArbiter;
+
+    regPrimask = DisableGlobalIRQ();
+    if (pArbiter->pOwner == pDevice)
+    {
+        pArbiter->depth++;
+        EnableGlobalIRQ(regPrimask);
+        return ARM_DRIVER_OK;
+    }
+    /*! Wait for the other device to give the bus back, the deadline starts at the first refusal. */
+    while (pArbiter->pOwner != NULL)
+    {
+        EnableGlobalIRQ(regPrimask);
+        if (start == 0)
+        {
+            start = BOARD_SystickGetTicks();
+        }
+        if (COUNT_TO_USEC(BOARD_SystickGetTicks() - start, BOARD_SystickGetCoreFreq()) >= pArbiter->timeout_us)
+        {
+            return ARM_DRIVER_ERROR_BUSY;
+        }
+        if (pArbiter->idleFunction)
+        {
+            pArbiter->idleFunction(pArbiter->pIdleData);
+        }
+        regPrimask = DisableGlobalIRQ();
+    }
+    pArbiter->pOwner = pDevice;
+    pArbiter->depth = 1;
+    EnableGlobalIRQ(regPrimask);
+
+    /*! Switch to the speed of the device, chip selects are per device in the register I/O layer. */
+    status = bus_arbiter_speed(pArbiter, pDevice);
+    if (ARM_DRIVER_OK != status)
+    {
+        Bus_Arbiter_Release(pDevice);
+    }
+
+    return status;
+}
+
+/*! The interface function to give the bus back after a transaction. */
+void Bus_Arbiter_Release(busArbiterDevice_t *pDevice)
+{
+    uint32_t regPrimask;
+    busArbiter_t *pArbiter;
+
+    if (pDevice == NULL)
+    {
+        return;
+    }
+    pArbiter = pDevice->pArbiter;
+
+    regPrimask = DisableGlobalIRQ();
+    if ((pArbiter->pOwner == pDevice) && (--pArbiter->depth == 0))
+    {
+        pArbiter->pOwner = NULL;
+    }
+    EnableGlobalIRQ(regPrimask);
+}
+
+/*! The interface function to change the bus speed of a device. */
+int32_t Bus_Arbiter_SetSpeed(busArbiterDevice_t *pDevice, uint32_t busSpeed)
+{
+    int32_t status;
+
+    pDevice->busSpeed = busSpeed;
+
+    /*! Program it now unless another device holds the bus, a nested owner is switched as well. */
+    status = Bus_Arbiter_Acquire(pDevice);
+    if (ARM_DRIVER_OK == status)
+    {
+        status = bus_arbiter_speed(pDevice->pArbiter, pDevice);
+        Bus_Arbiter_Release(pDevice);
+    }
+
+    return status;
+}
+
+/*! The interface function to queue a bus request. */
+void Bus_Arbiter_Submit(busArbiterRequest_t *pRequest)
+{
+    uint32_t regPrimask;
+    busArbiterRequest_t **ppNext;
+
+    pRequest->submitTicks = BOARD_SystickGetTicks();
+
+    regPrimask = DisableGlobalIRQ();
+    /*! Insert behind all requests of the same or a higher priority. */
+    for (ppNext = &pRequest->pDevice->pArbiter->pQueue; *ppNext != NULL; ppNext = &(*ppNext)->pNext)
+    {
+        if ((*ppNext)->priority < pRequest->priority)
+        {
+            break;
+        }
+    }
+    pRequest->pNext = *ppNext;
+    *ppNext = pRequest;
+    EnableGlobalIRQ(regPrimask);
+}
+
+/*! The interface function to run the highest priority queued job. */
+bool Bus_Arbiter_Service(busArbiter_t *pArbiter)
+{
+    int32_t status;
+    uint32_t regPrimask;
+    uint32_t wait_us;
+    busArbiterRequest_t *pRequest;
+
+    regPrimask = DisableGlobalIRQ();
+    pRequest = pArbiter->pQueue;
+    if ((pRequest == NULL) || (pArbiter->pOwner != NULL))
+    {
+        EnableGlobalIRQ(regPrimask);
+        return false;
+    }
+    pArbiter->pQueue = pRequest->pNext;
+    EnableGlobalIRQ(regPrimask);
+
+    wait_us = (uint32_t)((BOARD_SystickGetTicks() - pRequest->submitTicks) * 1000000 / BOARD_SystickGetCoreFreq());
+    pArbiter->grants++;
+    pArbiter->totalWait_us += wait_us;
+    if (wait_us > pArbiter->maxWait_us)
+    {
+        pArbiter->maxWait_us = wait_us;
+    }
+
+    /*! The job is one transaction, the bus is held across all its register accesses.
+     *  If the speed switch fails the job still runs and its transfers report the error. */
+    status = Bus_Arbiter_Acquire(pRequest->pDevice);
+    pRequest->job(pRequest->pUserData);
+    if (ARM_DRIVER_OK == status)
+    {
+        Bus_Arbiter_Release(pRequest->pDevice);
+    }
+
+    return true;
+}
+
+/*! The interface function to get the average queue wait. */
+uint32_t Bus_Arbiter_GetAvgWait_us(busArbiter_t *pArbiter)
+{
+    return pArbiter->grants ? (uint32_t)(pArbiter->totalWait_us / pArbiter->grants) : 0;
+}
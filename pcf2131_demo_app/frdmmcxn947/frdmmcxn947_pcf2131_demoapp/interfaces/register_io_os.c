@@ -0,0 +1,38 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file register_io_os.c
+ * @brief The register_io_os.c file contains the OS hooks of the register I/O layer.
+ */
+
+#include "register_io_os.h"
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/*! The interface function to take the bus, nothing to do without an OS. */
+int32_t __attribute__((weak)) Register_OS_Lock(registerOsBus_t *pBus)
+{
+    return ARM_DRIVER_OK;
+}
+
+/*! The interface function to give the bus back, nothing to do without an OS. */
+void __attribute__((weak)) Register_OS_Unlock(registerOsBus_t *pBus)
+{
+}
+
+/*! The interface function to block until the transfer completes, the caller polls without an OS. */
+int32_t __attribute__((weak)) Register_OS_Wait(registerOsBus_t *pBus, volatile bool *pDone, uint32_t timeout_us)
+{
+    return ARM_DRIVER_ERROR_UNSUPPORTED;
+}
+
+/*! The interface function to wake the waiting task, nothing to do without an OS. */
+void __attribute__((weak)) Register_OS_Signal(registerOsBus_t *pBus)
+{
+}
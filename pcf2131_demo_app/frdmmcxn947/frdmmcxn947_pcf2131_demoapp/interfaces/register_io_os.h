@@ -0,0 +1,92 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file register_io_os.h
+ * @brief The register_io_os.h file declares the OS hooks of the register I/O layer.
+ *        The bare metal defaults are weak and empty, register I/O then spins on the completion flags.
+ *        With REGISTER_IO_OSA_ENABLE set, register_io_osa.c overrides all four on the SDK OS abstraction
+ *        layer: a recursive mutex per bus, with priority inheritance, and a completion semaphore given from
+ *        the signal event handler. Any other RTOS port overrides them the same way.
+ */
+
+#ifndef __REGISTER_IO_OS_H__
+#define __REGISTER_IO_OS_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "Driver_Common.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Set to 1 to build the hooks on the SDK OS abstraction layer (component/osa), see register_io_osa.c.
+ *         The register I/O then has to be called from tasks, once the scheduler runs. */
+#ifndef REGISTER_IO_OSA_ENABLE
+#define REGISTER_IO_OSA_ENABLE (0U)
+#endif
+
+/*! @brief Bus instances, SPI and I2C together, the OSA hooks have OS objects for. */
+#ifndef REGISTER_IO_OSA_BUS_COUNT
+#define REGISTER_IO_OSA_BUS_COUNT (4U)
+#endif
+
+/*******************************************************************************
+ * Types
+ ******************************************************************************/
+/*!
+ * @brief This structure defines the OS objects of one bus instance, zero initialized, owned by the OS port.
+ */
+typedef struct
+{
+    void *lock; /* Handle of the object serializing the bus, NULL until created. */
+    void *done; /* Handle of the object signalled by the bus signal event handler, NULL until created. */
+} registerOsBus_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+/*!
+ * @brief The interface function to take the bus for the calling task.
+ *        The OS objects are created on first use. Nested calls from the owning task are allowed,
+ *        so a read-modify-write keeps the bus across both transfers.
+ *
+ * @param registerOsBus_t *pBus - The bus.
+ *
+ * @return ARM_DRIVER_OK, or ARM_DRIVER_ERROR if the OS objects could not be created.
+ */
+int32_t Register_OS_Lock(registerOsBus_t *pBus);
+
+/*!
+ * @brief The interface function to give the bus back.
+ *
+ * @param registerOsBus_t *pBus - The bus.
+ */
+void Register_OS_Unlock(registerOsBus_t *pBus);
+
+/*!
+ * @brief The interface function to block the calling task until the transfer completes.
+ *        A give left over from an aborted transfer is absorbed, the completion flag decides.
+ *
+ * @param registerOsBus_t *pBus - The bus.
+ * @param volatile bool *pDone - The completion flag set by the signal event handler.
+ * @param uint32_t timeout_us - Transfer deadline in micro seconds, 0 waits forever.
+ *
+ * @return ARM_DRIVER_OK, ARM_DRIVER_ERROR_TIMEOUT, or ARM_DRIVER_ERROR_UNSUPPORTED when the task
+ *         cannot block (no OS, or scheduler not running) and the caller has to poll pDone.
+ */
+int32_t Register_OS_Wait(registerOsBus_t *pBus, volatile bool *pDone, uint32_t timeout_us);
+
+/*!
+ * @brief The interface function to wake the task waiting on the bus, called from the signal event handler.
+ *        It runs in interrupt context, an RTOS port gives from ISR and yields on exit if a task was woken.
+ *
+ * @param registerOsBus_t *pBus - The bus.
+ */
+void Register_OS_Signal(registerOsBus_t *pBus);
+
+#endif // __REGISTER_IO_OS_H__
@@ -0,0 +1,134 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file register_io_osa.c
+ * @brief The register_io_osa.c file contains the OS hooks of the register I/O layer on the SDK OS abstraction
+ *        layer, built with REGISTER_IO_OSA_ENABLE set to 1. They override the weak bare metal hooks of
+ *        register_io_os.c. An OSA mutex is recursive and, on an RTOS, inherits the priority of the tasks it
+ *        blocks. The completion semaphore is given from the signal event handler, the OSA gives from ISR.
+ */
+
+#include "register_io_os.h"
+
+#if (REGISTER_IO_OSA_ENABLE)
+#include "fsl_os_abstraction.h"
+
+/*******************************************************************************
+ * Types
+ ******************************************************************************/
+/* The OS objects of one bus, statically allocated. */
+typedef struct
+{
+    OSA_MUTEX_HANDLE_DEFINE(mutex);
+    OSA_SEMAPHORE_HANDLE_DEFINE(semaphore);
+} registerOsaBus_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static registerOsaBus_t s_osaBus[REGISTER_IO_OSA_BUS_COUNT];
+static uint8_t s_osaBusUsed;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/* Create the OS objects of a bus on first use, in a critical section so two tasks cannot both create. */
+static int32_t register_osa_create(registerOsBus_t *pBus)
+{
+    int32_t status = ARM_DRIVER_OK;
+    registerOsaBus_t *pObjects;
+    OSA_SR_ALLOC();
+
+    OSA_ENTER_CRITICAL();
+    if ((pBus->lock == NULL) && (s_osaBusUsed >= REGISTER_IO_OSA_BUS_COUNT))
+    {
+        status = ARM_DRIVER_ERROR;
+    }
+    else if (pBus->lock == NULL)
+    {
+        pObjects = &s_osaBus[s_osaBusUsed];
+        if ((KOSA_StatusSuccess == OSA_SemaphoreCreate((osa_semaphore_handle_t)pObjects->semaphore, 0)) &&
+            (KOSA_StatusSuccess == OSA_MutexCreate((osa_mutex_handle_t)pObjects->mutex)))
+        {
+            s_osaBusUsed++;
+            pBus->done = pObjects->semaphore;
+            pBus->lock = pObjects->mutex;
+        }
+        else
+        {
+            status = ARM_DRIVER_ERROR;
+        }
+    }
+    OSA_EXIT_CRITICAL();
+
+    return status;
+}
+
+/*! The interface function to take the bus for the calling task. */
+int32_t Register_OS_Lock(registerOsBus_t *pBus)
+{
+    if ((pBus->lock == NULL) && (ARM_DRIVER_OK != register_osa_create(pBus)))
+    {
+        return ARM_DRIVER_ERROR;
+    }
+
+    return (KOSA_StatusSuccess == OSA_MutexLock((osa_mutex_handle_t)pBus->lock, osaWaitForever_c)) ?
+               ARM_DRIVER_OK :
+               ARM_DRIVER_ERROR;
+}
+
+/*! The interface function to give the bus back. */
+void Register_OS_Unlock(registerOsBus_t *pBus)
+{
+    if (pBus->lock != NULL)
+    {
+        (void)OSA_MutexUnlock((osa_mutex_handle_t)pBus->lock);
+    }
+}
+
+/*! The interface function to block the calling task until the transfer completes. */
+int32_t Register_OS_Wait(registerOsBus_t *pBus, volatile bool *pDone, uint32_t timeout_us)
+{
+    uint32_t start = OSA_TimeGetMsec();
+    uint32_t timeout_ms, elapsed_ms;
+
+    if (pBus->done == NULL)
+    {
+        return ARM_DRIVER_ERROR_UNSUPPORTED;
+    }
+
+    /* Round up, and one more millisecond as the current one is already partly gone. */
+    timeout_ms = timeout_us ? ((timeout_us + 999U) / 1000U) + 1U : osaWaitForever_c;
+    /* A give left over from an aborted transfer ends a wait early, the completion flag decides. */
+    while (!*pDone)
+    {
+        if (osaWaitForever_c == timeout_ms)
+        {
+            (void)OSA_SemaphoreWait((osa_semaphore_handle_t)pBus->done, osaWaitForever_c);
+            continue;
+        }
+        elapsed_ms = OSA_TimeGetMsec() - start;
+        if (elapsed_ms >= timeout_ms)
+        {
+            return ARM_DRIVER_ERROR_TIMEOUT;
+        }
+        (void)OSA_SemaphoreWait((osa_semaphore_handle_t)pBus->done, timeout_ms - elapsed_ms);
+    }
+
+    return ARM_DRIVER_OK;
+}
+
+/*! The interface function to wake the task waiting on the bus, from the signal event handler. */
+void Register_OS_Signal(registerOsBus_t *pBus)
+{
+    if (pBus->done != NULL)
+    {
+        (void)OSA_SemaphorePost((osa_semaphore_handle_t)pBus->done);
+    }
+}
+#endif
@@ -20,9 +20,15 @@
 #define SPI_SS_ACTIVE_LOW (ARM_SPI_SS_INACTIVE)
 #define SPI_SS_ACTIVE_HIGH (ARM_SPI_SS_ACTIVE)
 
-/*! Function pointer for the slave read information*/
+/*! The maximum slave command length (buffer headroom) supported by register I/O. */
+#define SPI_MAX_CMD_LEN (4)
+
+/*! Function pointer for the slave read information.
+ *  Formats the command into the caller supplied pCmdOut->pWriteBuffer and sets the transfer size. */
 typedef void (*fpSpiReadPreprocessFn_t)(void *pCmdOut, uint32_t offset, uint32_t size);
-/*! Function pointer for the slave write information*/
+/*! Function pointer for the slave write information.
+ *  Formats the command into the caller supplied pCmdOut->pWriteBuffer, followed by the payload
+ *  (copied only when pWritebuffer is not already behind the command headroom), and sets the transfer size. */
 typedef void (*fpSpiWritePreprocessFn_t)(void *pCmdOut, uint32_t offset, uint32_t size, void *pWritebuffer);
 
 /*! @brief The SPI Slave Control Command Params SDK2.0 Driver. */
@@ -177,9 +183,116 @@ void SPI7_SignalEvent_t(uint32_t event);
 void SPI8_SignalEvent_t(uint32_t event);
 #endif
 
+/*!
+ * @brief The interface function to read sensor registers in place.
+ *
+ * The transfer runs directly in and out of the caller buffer, there is no driver side copy.
+ * The buffer is owned by the driver (CPU or DMA) until the function returns, it must stay valid and
+ * must not be touched by an interrupt or other context during the call.
+ *
+ * @param ARM_DRIVER_SPI *pCommDrv - The SPI driver to use.
+ * @param registerDeviceInfo_t *devInfo - The SPI device number and idle function.
+ * @param void *pReadParams - the sensor's SPI slave select params.
+ * @param uint8_t offset - The register/offset to read from
+ * @param uint8_t length - The number of bytes to read
+ * @param uint8_t *pBuffer - The buffer of spiCmdLen headroom + length bytes, the register values
+ *                           are returned behind the headroom. The headroom content is not preserved.
+ *
+ * @return ARM_DRIVER_OK if success, ARM_DRIVER_ERROR_TIMEOUT if the transfer missed the device deadline
+ *         or ARM_DRIVER_ERROR if error.
+ */
+int32_t Register_SPI_ReadInPlace(ARM_DRIVER_SPI *pCommDrv,
+                                 registerDeviceInfo_t *devInfo,
+                                 void *pReadParams,
+                                 uint8_t offset,
+                                 uint8_t length,
+                                 uint8_t *pBuffer);
+
+/*!
+ * @brief The interface function to block write sensor registers in place.
+ *
+ * The command is formatted into the headroom and the buffer is sent as is, there is no driver side copy.
+ * The buffer ownership rules of Register_SPI_ReadInPlace() apply.
+ *
+ * @param ARM_DRIVER_SPI *pCommDrv - The SPI driver to use.
+ * @param registerDeviceInfo_t *devInfo - The SPI device number and idle function.
+ * @param void *pWriteParams - the sensor's SPI slave select params.
+ * @param uint8_t offset - The register/offset to write to
+ * @param uint8_t *pBuffer - The buffer of spiCmdLen headroom followed by the bytes to write.
+ * @param uint8_t bytesToWrite - A number of bytes to write (excluding the headroom).
+ *
+ * @return ARM_DRIVER_OK if success, ARM_DRIVER_ERROR_TIMEOUT if the transfer missed the device deadline
+ *         or ARM_DRIVER_ERROR if error.
+ */
+int32_t Register_SPI_BlockWriteInPlace(ARM_DRIVER_SPI *pCommDrv,
+                                       registerDeviceInfo_t *devInfo,
+                                       void *pWriteParams,
+                                       uint8_t offset,
+                                       uint8_t *pBuffer,
+                                       uint8_t bytesToWrite);
+
+/*!
+ * @brief The interface function to start reading sensor registers in place, without waiting.
+ *
+ * The bus and the slave select are held until Register_SPI_Poll() reports the end of the transfer.
+ * The buffer ownership rules of Register_SPI_ReadInPlace() apply until then.
+ *
+ * @param ARM_DRIVER_SPI *pCommDrv - The SPI driver to use.
+ * @param registerDeviceInfo_t *devInfo - The SPI device number and idle function.
+ * @param void *pReadParams - the sensor's SPI slave select params.
+ * @param uint8_t offset - The register/offset to read from
+ * @param uint8_t length - The number of bytes to read
+ * @param uint8_t *pBuffer - The buffer of spiCmdLen headroom + length bytes.
+ *
+ * @return ARM_DRIVER_OK if the transfer started, the bus is not held on error.
+ */
+int32_t Register_SPI_StartReadInPlace(ARM_DRIVER_SPI *pCommDrv,
+                                      registerDeviceInfo_t *devInfo,
+                                      void *pReadParams,
+                                      uint8_t offset,
+                                      uint8_t length,
+                                      uint8_t *pBuffer);
+
+/*!
+ * @brief The interface function to start block writing sensor registers in place, without waiting.
+ *
+ * The bus and the slave select are held until Register_SPI_Poll() reports the end of the transfer.
+ * The buffer ownership rules of Register_SPI_ReadInPlace() apply until then.
+ *
+ * @param ARM_DRIVER_SPI *pCommDrv - The SPI driver to use.
+ * @param registerDeviceInfo_t *devInfo - The SPI device number and idle function.
+ * @param void *pWriteParams - the sensor's SPI slave select params.
+ * @param uint8_t offset - The register/offset to write to
+ * @param uint8_t *pBuffer - The buffer of spiCmdLen headroom followed by the bytes to write.
+ * @param uint8_t bytesToWrite - A number of bytes to write (excluding the headroom).
+ *
+ * @return ARM_DRIVER_OK if the transfer started, the bus is not held on error.
+ */
+int32_t Register_SPI_StartBlockWriteInPlace(ARM_DRIVER_SPI *pCommDrv,
+                                            registerDeviceInfo_t *devInfo,
+                                            void *pWriteParams,
+                                            uint8_t offset,
+                                            uint8_t *pBuffer,
+                                            uint8_t bytesToWrite);
+
+/*!
+ * @brief The interface function to poll a started transfer, it never waits.
+ *
+ * @param ARM_DRIVER_SPI *pCommDrv - The SPI driver to use.
+ * @param registerDeviceInfo_t *devInfo - The SPI device number and idle function.
+ * @param void *pParams - the sensor's SPI slave select params.
+ *
+ * @return ARM_DRIVER_ERROR_BUSY while the transfer runs, else the transfer status as for
+ *         Register_SPI_ReadInPlace(), the bus is given back.
+ */
+int32_t Register_SPI_Poll(ARM_DRIVER_SPI *pCommDrv, registerDeviceInfo_t *devInfo, void *pParams);
+
 /*!
  * @brief The interface function to block write to a sensor register.
  *
+ * The command and the payload are sent as two transfers under one slave select, the payload straight from
+ * the caller buffer. Register_SPI_BlockWriteInPlace() needs one transfer only.
+ *
  * @param ARM_DRIVER_SPI *pCommDrv - The SPI driver to use.
  * @param registerDeviceInfo_t *devInfo - The SPI device number and idle function.
  * @param void *pWriteParams - the sensor's SPI slave select params.
@@ -187,7 +300,8 @@ void SPI8_SignalEvent_t(uint32_t event);
  * @param uint8_t *pBuffer - The buffer containing bytes to write.
  * @param uint8_t bytesToWrite - A number of bytes to write.
  *
- * @return ARM_DRIVER_OK if success or ARM_DRIVER_ERROR if error.
+ * @return ARM_DRIVER_OK if success, ARM_DRIVER_ERROR_TIMEOUT if the transfer missed the device deadline
+ *         or ARM_DRIVER_ERROR if error.
  */
 int32_t Register_SPI_BlockWrite(ARM_DRIVER_SPI *pCommDrv,
                                 registerDeviceInfo_t *devInfo,
@@ -207,7 +321,8 @@ int32_t Register_SPI_BlockWrite(ARM_DRIVER_SPI *pCommDrv,
  * @param uint8_t mask - A mask value to use when writing.
  *                       A non-zero mask indicates that a read-modify-write operation should be used.
  *                       where only the bits set in the mask will be updated according to the value param.
- * @return ARM_DRIVER_OK if success or ARM_DRIVER_ERROR if error.
+ * @return ARM_DRIVER_OK if success, ARM_DRIVER_ERROR_TIMEOUT if the transfer missed the device deadline
+ *         or ARM_DRIVER_ERROR if error.
  */
 int32_t Register_SPI_Write(ARM_DRIVER_SPI *pCommDrv,
                            registerDeviceInfo_t *devInfo,
@@ -219,6 +334,9 @@ int32_t Register_SPI_Write(ARM_DRIVER_SPI *pCommDrv,
 /*!
  * @brief The interface function to read a sensor register.
  *
+ * The command and the payload are two transfers under one slave select, the payload is clocked straight
+ * into the caller buffer. Register_SPI_ReadInPlace() needs one transfer only.
+ *
  * @param ARM_DRIVER_SPI *pCommDrv - The SPI driver to use.
  * @param registerDeviceInfo_t *devInfo - The SPI device number and idle function.
  * @param void *pReadParams - the sensor's SPI slave select params.
@@ -226,7 +344,8 @@ int32_t Register_SPI_Write(ARM_DRIVER_SPI *pCommDrv,
  * @param uint8_t length - The number of bytes to read
  * @param uint8_t *pOutBuffer - The pointer to the buffer to store the register value read.
  *
- * @return ARM_DRIVER_OK if success or ARM_DRIVER_ERROR if error.
+ * @return ARM_DRIVER_OK if success, ARM_DRIVER_ERROR_TIMEOUT if the transfer missed the device deadline
+ *         or ARM_DRIVER_ERROR if error.
  */
 int32_t Register_SPI_Read(ARM_DRIVER_SPI *pCommDrv,
                           registerDeviceInfo_t *devInfo,
@@ -235,4 +354,38 @@ int32_t Register_SPI_Read(ARM_DRIVER_SPI *pCommDrv,
                           uint8_t length,
                           uint8_t *pOutBuffer);
 
+/*!
+ * @brief The interface function to get a transfer latency percentile.
+ *
+ * @param uint8_t deviceInstance - The SPI device number.
+ * @param uint8_t percentile - The percentile (0 - 100) of the recorded transfer completion waits.
+ *
+ * @return The upper bound of the latency bin in micro seconds, 0 if no transfer was recorded.
+ *         Use it to size registerDeviceInfo_t timeout_us.
+ */
+uint32_t Register_SPI_GetLatency_us(uint8_t deviceInstance, uint8_t percentile);
+
+/*!
+ * @brief The interface function to clear the transfer latency histogram.
+ *
+ * @param uint8_t deviceInstance - The SPI device number.
+ */
+void Register_SPI_ClearLatency(uint8_t deviceInstance);
+
+/*!
+ * @brief The interface function to get the bus traffic counters.
+ *        Every transfer started is counted, with its command and data bytes.
+ *
+ * @param uint8_t deviceInstance - The SPI device number.
+ * @param registerIoCount_t *pCount - The counters since the last clear.
+ */
+void Register_SPI_GetCount(uint8_t deviceInstance, registerIoCount_t *pCount);
+
+/*!
+ * @brief The interface function to clear the bus traffic counters.
+ *
+ * @param uint8_t deviceInstance - The SPI device number.
+ */
+void Register_SPI_ClearCount(uint8_t deviceInstance);
+
 #endif // __REGISTER_IO_SPI_H__
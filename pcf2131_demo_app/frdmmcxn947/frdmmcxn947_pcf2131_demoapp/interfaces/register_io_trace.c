@@ -0,0 +1,131 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file register_io_trace.c
+ * @brief The register_io_trace.c file contains the capture of register transactions into a binary trace.
+ */
+
+/* Standard C Includes */
+#include <string.h>
+
+/* ISSDK Includes */
+#include "fsl_common.h"
+#include "Driver_Common.h"
+#include "systick_utils.h"
+#include "register_io_trace.h"
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static uint8_t *s_traceBuffer = NULL;
+static uint32_t s_traceSize = 0;
+static uint64_t s_traceLastTicks;
+static registerTraceStats_t s_traceStats;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/* Append a varint, returns the number of bytes. */
+static uint8_t register_trace_varint(uint8_t *pOut, uint32_t value)
+{
+    uint8_t n = 0;
+
+    while (value >= 0x80)
+    {
+        pOut[n++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    pOut[n++] = (uint8_t)value;
+
+    return n;
+}
+
+/*! The interface function to start capturing into a buffer. */
+void Register_Trace_Start(uint8_t *pBuffer, uint32_t size)
+{
+    uint32_t regPrimask;
+
+    regPrimask = DisableGlobalIRQ();
+    memset(&s_traceStats, 0, sizeof(s_traceStats));
+    s_traceLastTicks = BOARD_SystickGetTicks();
+    s_traceSize = size;
+    s_traceBuffer = pBuffer;
+    EnableGlobalIRQ(regPrimask);
+}
+
+/*! The interface function to stop capturing. */
+void Register_Trace_Stop(registerTraceStats_t *pStats)
+{
+    uint32_t regPrimask;
+
+    regPrimask = DisableGlobalIRQ();
+    s_traceBuffer = NULL;
+    EnableGlobalIRQ(regPrimask);
+
+    if (pStats)
+    {
+        *pStats = s_traceStats;
+    }
+}
+
+/*! The interface function to append a finished transaction. */
+void Register_Trace_Record(
+    uint8_t flags, uint8_t offset, uint8_t length, const uint8_t *pPayload, uint64_t startTicks, int32_t status)
+{
+    uint8_t record[REGISTER_TRACE_MAX_RECORD];
+    uint32_t coreFreq, regPrimask;
+    uint64_t endTicks;
+    uint8_t n = 0;
+
+    if (s_traceBuffer == NULL)
+    {
+        return;
+    }
+
+    endTicks = BOARD_SystickGetTicks();
+    coreFreq = BOARD_SystickGetCoreFreq();
+    if (ARM_DRIVER_OK != status)
+    {
+        flags |= REGISTER_TRACE_FAILED;
+    }
+
+    /*! Format outside the critical section, leaving room for the gap, which depends on the previous record. */
+    record[n++] = flags;
+    record[n++] = offset;
+    record[n++] = length;
+    n += 5;
+    n += register_trace_varint(&record[n], (uint32_t)COUNT_TO_USEC(endTicks - startTicks, coreFreq));
+    if (!(flags & REGISTER_TRACE_FAILED) && (length <= SENSOR_MAX_REGISTER_COUNT))
+    {
+        memcpy(&record[n], pPayload, length);
+        n += length;
+    }
+
+    regPrimask = DisableGlobalIRQ();
+    if (s_traceBuffer != NULL)
+    {
+        uint8_t gap[5];
+        uint8_t gapLength = register_trace_varint(
+            gap, (startTicks > s_traceLastTicks) ? (uint32_t)COUNT_TO_USEC(startTicks - s_traceLastTicks, coreFreq) : 0);
+
+        if ((s_traceStats.length + n - 5 + gapLength) > s_traceSize)
+        {
+            s_traceStats.dropped++;
+        }
+        else
+        {
+            memcpy(&s_traceBuffer[s_traceStats.length], record, 3);
+            memcpy(&s_traceBuffer[s_traceStats.length + 3], gap, gapLength);
+            memcpy(&s_traceBuffer[s_traceStats.length + 3 + gapLength], &record[8], n - 8);
+            s_traceStats.length += n - 5 + gapLength;
+            s_traceStats.records++;
+            s_traceLastTicks = startTicks;
+        }
+    }
+    EnableGlobalIRQ(regPrimask);
+}
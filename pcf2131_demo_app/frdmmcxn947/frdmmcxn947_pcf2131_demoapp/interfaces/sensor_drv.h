@@ -35,8 +35,20 @@ enum ESensorErrors
     SENSOR_ERROR_INIT,
     SENSOR_ERROR_WRITE,
     SENSOR_ERROR_READ,
+    SENSOR_ERROR_TIMEOUT,
+    SENSOR_ERROR_BUSY, /* A polled operation is in progress, poll again. */
 };
 
+/* The number of transfer latency histogram bins, bin n counts waits shorter than 2^n us. */
+#define REGISTER_IO_LATENCY_BINS 16
+
+/* The bus traffic counters of a device instance. */
+typedef struct
+{
+    uint32_t transfers; /* Bus transfers, an I2C repeated START begins a new one. */
+    uint32_t bytes;     /* Bytes clocked after the slave address, SPI command bytes included. */
+} registerIoCount_t;
+
 /* The MAXIMUM number of Sensor Registers possible. */
 #define SENSOR_MAX_REGISTER_COUNT 128 /* As per 7-Bit address. */
 
@@ -103,6 +115,8 @@ typedef struct
     registeridlefunction_t idleFunction;
     void *functionParam;
     uint8_t deviceInstance;
+    uint32_t timeout_us; /* Transfer completion deadline, 0 waits forever. */
+    struct _busArbiterDevice *pArbDevice; /* Shared bus arbitration, NULL when the device owns its bus. */
 } registerDeviceInfo_t;
 
 #endif //_SENSOR_DRV_H
@@ -37,14 +37,18 @@ int32_t Sensor_I2C_BlockWrite(ARM_DRIVER_I2C *pCommDrv,
     }
 
     const registercommandlist_t *pCmd = pCommandList;
-    /*! Update register values based on register write list unless the next Cmd is the list terminator */
-    do
+    /*! Update register values based on register write list until the list terminator, an empty list writes nothing */
+    for (; pCmd->writeTo != 0xFFFF; pCmd++)
     { /*! Write the command based on the values in the command and value pair.*/
+        if ((pCmd->writeTo > 0xFF) || (pCmd->pWriteBuffer == NULL))
+        {
+            return SENSOR_ERROR_BAD_ADDRESS;
+        }
         status =
             Register_I2C_BlockWrite(pCommDrv, devInfo, slaveAddress, pCmd->writeTo, pCmd->pWriteBuffer, pCmd->numBytes);
         if (ARM_DRIVER_OK != status)
         {
-            return SENSOR_ERROR_WRITE;
+            return (ARM_DRIVER_ERROR_TIMEOUT == status) ? SENSOR_ERROR_TIMEOUT : SENSOR_ERROR_WRITE;
         }
 
         do
@@ -53,7 +57,7 @@ int32_t Sensor_I2C_BlockWrite(ARM_DRIVER_I2C *pCommDrv,
             status = Register_I2C_Read(pCommDrv, devInfo, slaveAddress, 0, sizeof(cocoBuffer), cocoBuffer);
             if (ARM_DRIVER_OK != status)
             {
-                return SENSOR_ERROR_READ;
+                return (ARM_DRIVER_ERROR_TIMEOUT == status) ? SENSOR_ERROR_TIMEOUT : SENSOR_ERROR_READ;
             }
             commandComplete = cocoBuffer[1] & 0x80;
             if (commandComplete && cocoBuffer[1] & error_mask)
@@ -61,7 +65,7 @@ int32_t Sensor_I2C_BlockWrite(ARM_DRIVER_I2C *pCommDrv,
                 return SENSOR_ERROR_WRITE;
             }
         } while (!commandComplete);
-    } while ((++pCmd)->writeTo != 0xFFFF);
+    }
 
     return SENSOR_ERROR_NONE;
 }
@@ -83,19 +87,22 @@ int32_t Sensor_I2C_Write(ARM_DRIVER_I2C *pCommDrv,
 
     const registerwritelist_t *pCmd = pRegWriteList;
 
-    /*! Update register values based on register write list unless the next Cmd is the list terminator */
-    do
+    /*! Update register values based on register write list until the list terminator, an empty list writes nothing */
+    for (; pCmd->writeTo != 0xFFFF; pCmd++)
     {
+        if (pCmd->writeTo > 0xFF)
+        {
+            return SENSOR_ERROR_BAD_ADDRESS;
+        }
         repeatedStart = (pCmd + 1)->writeTo != 0xFFFF;
         /*! Set the register based on the values in the register value pair.*/
         status =
             Register_I2C_Write(pCommDrv, devInfo, slaveAddress, pCmd->writeTo, pCmd->value, pCmd->mask, repeatedStart);
         if (ARM_DRIVER_OK != status)
         {
-            return SENSOR_ERROR_WRITE;
+            return (ARM_DRIVER_ERROR_TIMEOUT == status) ? SENSOR_ERROR_TIMEOUT : SENSOR_ERROR_WRITE;
         }
-        ++pCmd;
-    } while (repeatedStart);
+    }
 
     return SENSOR_ERROR_NONE;
 }
@@ -120,10 +127,14 @@ int32_t Sensor_I2C_Read(ARM_DRIVER_I2C *pCommDrv,
     /*! Traverse the read list and read the registers one by one unless the register read list numBytes is zero*/
     for (pBuf = pOutBuffer; pCmd->numBytes != 0; pCmd++)
     {
+        if (pCmd->readFrom > 0xFF)
+        {
+            return SENSOR_ERROR_BAD_ADDRESS;
+        }
         status = Register_I2C_Read(pCommDrv, devInfo, slaveAddress, pCmd->readFrom, pCmd->numBytes, pBuf);
         if (ARM_DRIVER_OK != status)
         {
-            return SENSOR_ERROR_READ;
+            return (ARM_DRIVER_ERROR_TIMEOUT == status) ? SENSOR_ERROR_TIMEOUT : SENSOR_ERROR_READ;
         }
         pBuf += pCmd->numBytes;
     }
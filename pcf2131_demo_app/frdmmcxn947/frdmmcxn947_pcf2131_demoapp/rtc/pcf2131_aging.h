@@ -0,0 +1,94 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file pcf2131_aging.h
+ * @brief The pcf2131_aging.h file describes the PCF2131 drift estimation and aging offset trimming interface.
+ */
+
+#ifndef PCF2131_AGING_H_
+#define PCF2131_AGING_H_
+
+/* Standard C Includes */
+#include <stdint.h>
+
+#include "pcf2131_drv.h"
+
+/*! @def    PCF2131_DRIFT_MIN_SAMPLES
+ *  @brief  Minimum number of samples for a drift fit. */
+#define PCF2131_DRIFT_MIN_SAMPLES    (3)
+
+/*! @brief This structure holds the running least squares sums of RTC error against the reference time.*/
+typedef struct
+{
+	uint32_t windowSec;                /*!< Minimum reference span before a trim is committed.*/
+	uint32_t nSamples;                 /*!< Number of samples in the fit.*/
+	int64_t refStart_ms;               /*!< Reference time of the first sample.*/
+	int64_t rtcStart_ms;               /*!< RTC time of the first sample.*/
+	int64_t refLast_ms;                /*!< Reference time of the last sample.*/
+	double sx, sy, sxx, sxy;           /*!< Sums of x (ref ms), y (RTC error ms), x*x, x*y.*/
+	pcf2131_logfunction_t log;         /*!< Decision logger, NULL for silent operation.*/
+} pcf2131_drift_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*! @brief       Converts a decoded RTC time to milliseconds since 2000-01-01 00:00:00.
+ *  @details     12 hour times are converted with their AM/PM flag, years are taken as 2000 to 2099.
+ *  @param[in]   time  				Pointer to decoded time.
+ *  @constraints None
+ *  @reentrant   Yes
+ *  @return      ::PCF2131_TimeToMs() returns the time in milliseconds.
+ */
+int64_t PCF2131_TimeToMs(const pcf2131_timedata_t *time);
+
+/*! @brief       Initializes a drift estimation window.
+ *  @details     Clears the fit and sets the minimum reference span required before PCF2131_Drift_Commit().
+ *  @param[in]   pDrift  			Pointer to drift estimation structure.
+ *  @param[in]   windowSec  		Minimum reference span in seconds.
+ *  @param[in]   logFn  			Decision logger, NULL for silent operation.
+ *  @constraints None
+ *  @reentrant   No
+ */
+void PCF2131_Drift_Init(pcf2131_drift_t *pDrift, uint32_t windowSec, pcf2131_logfunction_t logFn);
+
+/*! @brief       Adds a reference/RTC time pair to the drift fit.
+ *  @details     The reference is an external time (host epoch over UART, PPS edge count) in milliseconds,
+ *               the RTC time is a decoded PCF2131_GetTime() result read as close as possible to it.
+ *  @param[in]   pDrift  			Pointer to drift estimation structure.
+ *  @param[in]   ref_ms  			Reference time in milliseconds.
+ *  @param[in]   time  				RTC time captured at the reference time.
+ *  @constraints PCF2131_Drift_Init() must be called first. Reference time must increase.
+ *  @reentrant   No
+ *  @return      ::PCF2131_Drift_AddSample() returns the status.
+ */
+int32_t PCF2131_Drift_AddSample(pcf2131_drift_t *pDrift, int64_t ref_ms, const pcf2131_timedata_t *time);
+
+/*! @brief       Estimates the RTC drift.
+ *  @details     Least squares slope of RTC error against reference time.
+ *  @param[in]   pDrift  			Pointer to drift estimation structure.
+ *  @param[out]  pDrift_ppb  		Drift in ppb, positive when the RTC runs fast.
+ *  @constraints At least PCF2131_DRIFT_MIN_SAMPLES samples must have been added.
+ *  @reentrant   No
+ *  @return      ::PCF2131_Drift_Estimate() returns the status.
+ */
+int32_t PCF2131_Drift_Estimate(pcf2131_drift_t *pDrift, int32_t *pDrift_ppb);
+
+/*! @brief       Commits the aging offset that minimizes the residual drift.
+ *  @details     Reads the current aging offset, picks the code whose correction leaves the smallest
+ *               residual drift and writes it with a single write if it differs. Every decision is logged.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @param[in]   pDrift  			Pointer to drift estimation structure.
+ *  @param[out]  pCode  			Aging offset code in use after the commit.
+ *  @constraints The reference span must cover the configured window.
+ *				 Application has to ensure that previous instances of these APIs have exited before invocation
+ *  @reentrant   No
+ *  @return      ::PCF2131_Drift_Commit() returns the status.
+ */
+int32_t PCF2131_Drift_Commit(pcf2131_sensorhandle_t *pSensorHandle, pcf2131_drift_t *pDrift, uint8_t *pCode);
+
+#endif /* PCF2131_AGING_H_ */
@@ -0,0 +1,277 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file pcf2131_ipc.c
+ * @brief The pcf2131_ipc.c file implements the PCF2131 dual-core service, lock free queues in shared RAM
+ *        and the inter-core mailbox doorbell.
+ */
+
+#include <string.h>
+#include "fsl_common.h"
+#include "fsl_clock.h"
+#include "fsl_reset.h"
+#include "pcf2131_ipc.h"
+
+#if (PCF2131_DUAL_CORE)
+//-----------------------------------------------------------------------
+// Macros
+//-----------------------------------------------------------------------
+/* Mailbox interrupt line of each core, the doorbell bit is the same on both. Requests always ring
+ * core 1 and events core 0, the image only decides which line its handler clears. */
+#define PCF2131_IPC_CORE0       (0)
+#define PCF2131_IPC_CORE1       (1)
+#define PCF2131_IPC_DOORBELL    (1U << 0)
+
+#if defined(CPU_MCXN947VDF_cm33_core1)
+#define PCF2131_IPC_SELF        PCF2131_IPC_CORE1
+#else
+#define PCF2131_IPC_SELF        PCF2131_IPC_CORE0
+#endif
+
+//-----------------------------------------------------------------------
+// Global Variables
+//-----------------------------------------------------------------------
+/* Time read list, as used by the application on a single core. */
+static const registerreadlist_t pcf2131_ipcTimeData[] = {
+	{.readFrom = PCF2131_100TH_SECOND, .numBytes = PCF2131_TIME_SIZE_BYTE}, __END_READ_DATA__};
+
+/* Timestamp read list of each switch. */
+static const registerreadlist_t pcf2131_ipcTsData[4][2] = {
+	{{.readFrom = PCF2131_TIMESTAMP1_SECONDS, .numBytes = PCF2131_TS_SIZE_BYTE}, __END_READ_DATA__},
+	{{.readFrom = PCF2131_TIMESTAMP2_SECONDS, .numBytes = PCF2131_TS_SIZE_BYTE}, __END_READ_DATA__},
+	{{.readFrom = PCF2131_TIMESTAMP3_SECONDS, .numBytes = PCF2131_TS_SIZE_BYTE}, __END_READ_DATA__},
+	{{.readFrom = PCF2131_TIMESTAMP4_SECONDS, .numBytes = PCF2131_TS_SIZE_BYTE}, __END_READ_DATA__}};
+
+/* RTC interrupt flagged on core 1, private to the core. */
+static volatile bool pcf2131_ipcRtcPending = false;
+
+//-----------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------
+
+/* Free slots of a queue, as the producer sees them. */
+static uint32_t PCF2131_IPC_Free(const pcf2131_ipcqueue_t *pQueue)
+{
+	return PCF2131_IPC_QUEUE_SIZE - (pQueue->head - pQueue->tail);
+}
+
+/* Pushes a message, producer side, leaving reserve slots free. */
+static bool PCF2131_IPC_Push(pcf2131_ipcqueue_t *pQueue, const pcf2131_ipcmsg_t *pMsg, uint32_t reserve)
+{
+	uint32_t head = pQueue->head;
+
+	if (PCF2131_IPC_Free(pQueue) <= reserve)
+	{
+		pQueue->dropped++;
+		return false;
+	}
+	pQueue->msg[head & (PCF2131_IPC_QUEUE_SIZE - 1)] = *pMsg;
+	/*! The message must be visible before the other core sees the new head */
+	__DMB();
+	pQueue->head = head + 1;
+
+	return true;
+}
+
+/* Reads the next message without taking it, consumer side. */
+static bool PCF2131_IPC_Peek(const pcf2131_ipcqueue_t *pQueue, pcf2131_ipcmsg_t *pMsg)
+{
+	uint32_t tail = pQueue->tail;
+
+	if (tail == pQueue->head)
+	{
+		return false;
+	}
+	__DMB();
+	*pMsg = pQueue->msg[tail & (PCF2131_IPC_QUEUE_SIZE - 1)];
+
+	return true;
+}
+
+/* Releases the slot of the message read, consumer side. */
+static void PCF2131_IPC_Drop(pcf2131_ipcqueue_t *pQueue)
+{
+	/*! The slot is copied out before the producer may reuse it */
+	__DMB();
+	pQueue->tail = pQueue->tail + 1;
+}
+
+/* Pops a message, consumer side. */
+static bool PCF2131_IPC_Pop(pcf2131_ipcqueue_t *pQueue, pcf2131_ipcmsg_t *pMsg)
+{
+	if (!PCF2131_IPC_Peek(pQueue, pMsg))
+	{
+		return false;
+	}
+	PCF2131_IPC_Drop(pQueue);
+
+	return true;
+}
+
+/* Rings the mailbox doorbell of a core. */
+static void PCF2131_IPC_Ring(uint32_t core)
+{
+	__DSB();
+	MAILBOX->MBOXIRQ[core].IRQSET = PCF2131_IPC_DOORBELL;
+}
+
+/* The doorbell only wakes the core, the queues carry the messages. */
+void MAILBOX_IRQHandler(void)
+{
+	MAILBOX->MBOXIRQ[PCF2131_IPC_SELF].IRQCLR = PCF2131_IPC_DOORBELL;
+	SDK_ISR_EXIT_BARRIER;
+}
+
+void PCF2131_IPC_Init(pcf2131_ipc_t *pIpc)
+{
+	memset(pIpc, 0, sizeof(pcf2131_ipc_t));
+	PCF2131_TimePub_Init(&pIpc->timePub);
+
+	CLOCK_EnableClock(kCLOCK_Mailbox);
+	RESET_PeripheralReset(kMAILBOX_RST_SHIFT_RSTn);
+	EnableIRQ(MAILBOX_IRQn);
+}
+
+bool PCF2131_IPC_GetTime(const pcf2131_ipc_t *pIpc, pcf2131_timedata_t *time, int64_t *pEpoch_ms)
+{
+	return PCF2131_TimePub_Read(&pIpc->timePub, time, pEpoch_ms);
+}
+
+bool PCF2131_IPC_Request(pcf2131_ipc_t *pIpc, const pcf2131_ipcmsg_t *pMsg)
+{
+	if (!PCF2131_IPC_Push(&pIpc->request, pMsg, 0))
+	{
+		return false;
+	}
+	PCF2131_IPC_Ring(PCF2131_IPC_CORE1);
+
+	return true;
+}
+
+bool PCF2131_IPC_GetEvent(pcf2131_ipc_t *pIpc, pcf2131_ipcmsg_t *pMsg)
+{
+	if (!PCF2131_IPC_Pop(&pIpc->event, pMsg))
+	{
+		return false;
+	}
+	/*! A request held back for want of a reply slot can run now */
+	if (pIpc->request.head != pIpc->request.tail)
+	{
+		PCF2131_IPC_Ring(PCF2131_IPC_CORE1);
+	}
+
+	return true;
+}
+
+void PCF2131_IPC_ServerStart(pcf2131_ipc_t *pIpc)
+{
+	EnableIRQ(MAILBOX_IRQn);
+	__DMB();
+	pIpc->ready = 1;
+}
+
+void PCF2131_IPC_ServerNotify(void)
+{
+	pcf2131_ipcRtcPending = true;
+}
+
+/* Executes one request, the reply reuses the message. */
+static void PCF2131_IPC_Execute(pcf2131_sensorhandle_t *pSensorHandle, pcf2131_ipcmsg_t *pMsg)
+{
+	switch (pMsg->type)
+	{
+	case PCF2131_IPC_SET_TIME:
+		pMsg->status = PCF2131_SetTime(pSensorHandle, &pMsg->data.time);
+		break;
+	case PCF2131_IPC_SET_ALARM:
+		pMsg->status = PCF2131_SetAlarmTime(pSensorHandle, &pMsg->data.alarm);
+		break;
+	case PCF2131_IPC_ALARM_ENABLE:
+		pMsg->status = PCF2131_AlarmInt_Enable(pSensorHandle, pMsg->data.enable.intSrc, pMsg->data.enable.alarmType);
+		break;
+	case PCF2131_IPC_TS_ENABLE:
+		pMsg->status = PCF2131_SW_TsInt_Enable(pSensorHandle, pMsg->data.enable.tsnum, pMsg->data.enable.intSrc);
+		break;
+	default:
+		pMsg->status = SENSOR_ERROR_INVALID_PARAM;
+		break;
+	}
+	pMsg->type = PCF2131_IPC_REPLY;
+}
+
+/* Dispatches a flagged RTC interrupt, returns the number of events queued. */
+static uint32_t PCF2131_IPC_Dispatch(pcf2131_sensorhandle_t *pSensorHandle, pcf2131_ipc_t *pIpc)
+{
+	pcf2131_ipcmsg_t msg;
+	IntState state;
+	uint32_t events = 0;
+	uint8_t sw;
+
+	/*! Seconds interrupt: publish the time */
+	if ((SENSOR_ERROR_NONE == PCF2131_Check_MinSecInt(pSensorHandle, &state)) && (intOccurred == state))
+	{
+		PCF2131_TimePub_Update(pSensorHandle, pcf2131_ipcTimeData, &pIpc->timePub);
+		PCF2131_Clear_MinSecInt(pSensorHandle);
+	}
+
+	/*! Alarm: journal the time it fired */
+	if ((SENSOR_ERROR_NONE == PCF2131_Check_AlarmInt(pSensorHandle, &state)) && (intOccurred == state))
+	{
+		memset(&msg, 0, sizeof(msg));
+		msg.type = PCF2131_IPC_ALARM;
+		msg.status = PCF2131_GetTime(pSensorHandle, pcf2131_ipcTimeData, &msg.data.time);
+		PCF2131_Clear_AlarmInt(pSensorHandle);
+		events += PCF2131_IPC_Push(&pIpc->event, &msg, PCF2131_IPC_REPLY_SLOTS);
+	}
+
+	/*! Timestamps: journal each one taken */
+	for (sw = sw1Ts; sw <= sw4Ts; sw++)
+	{
+		if ((SENSOR_ERROR_NONE == PCF2131_Check_SW_TsInt(pSensorHandle, (SwTsNum)sw, &state)) && (intOccurred == state))
+		{
+			memset(&msg, 0, sizeof(msg));
+			msg.type = PCF2131_IPC_TIMESTAMP;
+			msg.data.ts.tsnum = (SwTsNum)sw;
+			msg.status = PCF2131_GetTs(pSensorHandle, pcf2131_ipcTsData[sw], (SwTsNum)sw, &msg.data.ts.timestamp);
+			PCF2131_Clear_SW_TsInt(pSensorHandle, (SwTsNum)sw);
+			events += PCF2131_IPC_Push(&pIpc->event, &msg, PCF2131_IPC_REPLY_SLOTS);
+		}
+	}
+
+	return events;
+}
+
+bool PCF2131_IPC_ServerRun(pcf2131_sensorhandle_t *pSensorHandle, pcf2131_ipc_t *pIpc)
+{
+	pcf2131_ipcmsg_t msg;
+	uint32_t events = 0;
+	bool busy = false;
+
+	/*! Requests first, core 0 may be waiting on a reply. One stays queued until its reply fits */
+	while ((PCF2131_IPC_Free(&pIpc->event) > 0) && PCF2131_IPC_Peek(&pIpc->request, &msg))
+	{
+		PCF2131_IPC_Execute(pSensorHandle, &msg);
+		events += PCF2131_IPC_Push(&pIpc->event, &msg, 0);
+		PCF2131_IPC_Drop(&pIpc->request);
+		busy = true;
+	}
+
+	if (pcf2131_ipcRtcPending)
+	{
+		pcf2131_ipcRtcPending = false;
+		events += PCF2131_IPC_Dispatch(pSensorHandle, pIpc);
+		busy = true;
+	}
+
+	if (events)
+	{
+		PCF2131_IPC_Ring(PCF2131_IPC_CORE0);
+	}
+
+	return busy;
+}
+#endif
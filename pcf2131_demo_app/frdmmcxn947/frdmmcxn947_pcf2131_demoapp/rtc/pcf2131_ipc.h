@@ -0,0 +1,181 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file pcf2131_ipc.h
+ * @brief The pcf2131_ipc.h file describes the PCF2131 dual-core service interface.
+ *
+ * With PCF2131_DUAL_CORE set, core 1 owns the RTC: it runs every bus transfer, dispatches the RTC
+ * interrupt, journals timestamps and publishes the time. Core 0 talks to it through a pcf2131_ipc_t
+ * in shared RAM, two single producer single consumer queues and the time publication, each side
+ * waking the other with the inter-core mailbox interrupt. Core 0 never waits for the bus.
+ *
+ * Core 1 takes a request only when the event queue has room for its reply, and the journal leaves
+ * PCF2131_IPC_REPLY_SLOTS free for replies: a journal core 0 does not drain loses journal entries,
+ * never replies. A request waits in its queue until core 0 takes events.
+ *
+ * Core 0: PCF2131_IPC_Init(), boot core 1, then PCF2131_IPC_GetTime(), PCF2131_IPC_Request() and
+ *         PCF2131_IPC_GetEvent().
+ * Core 1: PCF2131_Initialize(), PCF2131_IPC_ServerStart(), PCF2131_IPC_ServerNotify() from the RTC
+ *         interrupt pin handler, and PCF2131_IPC_ServerRun() from the main loop.
+ */
+
+#ifndef PCF2131_IPC_H_
+#define PCF2131_IPC_H_
+
+/* Standard C Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "pcf2131_drv.h"
+#include "pcf2131_timepub.h"
+
+/*! @def    PCF2131_DUAL_CORE
+ *  @brief  Set to 1 to run the PCF2131 service on core 1, on both cores. */
+#ifndef PCF2131_DUAL_CORE
+#define PCF2131_DUAL_CORE    (0)
+#endif
+
+#if (PCF2131_DUAL_CORE)
+/*! @def    PCF2131_IPC_QUEUE_SIZE
+ *  @brief  Messages per queue, a power of two. */
+#define PCF2131_IPC_QUEUE_SIZE    (16)
+
+/*! @def    PCF2131_IPC_REPLY_SLOTS
+ *  @brief  Event queue slots the timestamp and alarm journal leaves to replies. */
+#define PCF2131_IPC_REPLY_SLOTS    (1)
+
+/*! @def    PCF2131_IPC_SECTION
+ *  @brief  Linker section of the shared block, both images define it with __attribute__((section(...)))
+ *          and must place it at the same non-cached address. */
+#ifndef PCF2131_IPC_SECTION
+#define PCF2131_IPC_SECTION    ".pcf2131_ipc"
+#endif
+
+/*! @brief The message types, requests from core 0 then events from core 1.*/
+typedef enum
+{
+	PCF2131_IPC_SET_TIME = 0,          /*!< Request: set the time from data.time.*/
+	PCF2131_IPC_SET_ALARM = 1,         /*!< Request: set the alarm time from data.alarm.*/
+	PCF2131_IPC_ALARM_ENABLE = 2,      /*!< Request: enable alarm data.enable.alarmType on data.enable.intSrc.*/
+	PCF2131_IPC_TS_ENABLE = 3,         /*!< Request: enable timestamp data.enable.tsnum on data.enable.intSrc.*/
+	PCF2131_IPC_REPLY = 0x80,          /*!< Event: a request completed with status.*/
+	PCF2131_IPC_TIMESTAMP = 0x81,      /*!< Event: timestamp data.ts.timestamp taken on switch data.ts.tsnum.*/
+	PCF2131_IPC_ALARM = 0x82,          /*!< Event: the alarm fired at data.time.*/
+} pcf2131_ipctype_t;
+
+/*! @brief This structure holds one queued message.*/
+typedef struct
+{
+	uint8_t type;                      /*!< A pcf2131_ipctype_t.*/
+	uint8_t tag;                       /*!< Set by core 0 on a request, echoed in its reply.*/
+	int32_t status;                    /*!< Status of a reply.*/
+	union
+	{
+		pcf2131_timedata_t time;
+		pcf2131_alarmdata_t alarm;
+		struct
+		{
+			SwTsNum tsnum;
+			pcf2131_timestamp_t timestamp;
+		} ts;
+		struct
+		{
+			AlarmType alarmType;
+			SwTsNum tsnum;
+			IntSrc intSrc;
+		} enable;
+	} data;
+} pcf2131_ipcmsg_t;
+
+/*! @brief This structure holds a single producer single consumer queue.*/
+typedef struct
+{
+	volatile uint32_t head;            /*!< Messages pushed, written by the producer only.*/
+	volatile uint32_t tail;            /*!< Messages popped, written by the consumer only.*/
+	uint32_t dropped;                  /*!< Messages refused by a full queue, written by the producer only.*/
+	pcf2131_ipcmsg_t msg[PCF2131_IPC_QUEUE_SIZE];
+} pcf2131_ipcqueue_t;
+
+/*! @brief This structure holds the block shared by both cores.*/
+typedef struct
+{
+	pcf2131_timepub_t timePub;         /*!< Time published by core 1 on every seconds interrupt.*/
+	pcf2131_ipcqueue_t request;        /*!< Core 0 to core 1.*/
+	pcf2131_ipcqueue_t event;          /*!< Core 1 to core 0, replies and the timestamp and alarm journal.*/
+	volatile uint32_t ready;           /*!< Set by core 1 once it serves requests.*/
+} pcf2131_ipc_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*! @brief       Initializes the shared block and the mailbox, on core 0.
+ *  @param[in]   pIpc  				Pointer to shared block.
+ *  @constraints Call it before core 1 is booted.
+ *  @reentrant   No
+ */
+void PCF2131_IPC_Init(pcf2131_ipc_t *pIpc);
+
+/*! @brief       Gets the time published by core 1.
+ *  @details     No bus access, no wait beyond a concurrent publish.
+ *  @param[in]   pIpc  				Pointer to shared block.
+ *  @param[out]  time  				Decoded time, NULL if not needed.
+ *  @param[out]  pEpoch_ms  		Time in milliseconds since 2000-01-01 00:00:00, NULL if not needed.
+ *  @constraints Core 0 only.
+ *  @reentrant   Yes
+ *  @return      ::PCF2131_IPC_GetTime() returns false if no time was published yet.
+ */
+bool PCF2131_IPC_GetTime(const pcf2131_ipc_t *pIpc, pcf2131_timedata_t *time, int64_t *pEpoch_ms);
+
+/*! @brief       Queues a request to core 1.
+ *  @details     The request completes with a PCF2131_IPC_REPLY event carrying the same tag.
+ *  @param[in]   pIpc  				Pointer to shared block.
+ *  @param[in]   pMsg  				Pointer to request.
+ *  @constraints Core 0 only, from a single context.
+ *  @reentrant   No
+ *  @return      ::PCF2131_IPC_Request() returns false if the request queue is full.
+ */
+bool PCF2131_IPC_Request(pcf2131_ipc_t *pIpc, const pcf2131_ipcmsg_t *pMsg);
+
+/*! @brief       Takes the next event from core 1.
+ *  @details     Wakes core 1 if a request waits for the slot freed.
+ *  @param[in]   pIpc  				Pointer to shared block.
+ *  @param[out]  pMsg  				Pointer to event.
+ *  @constraints Core 0 only, from a single context.
+ *  @reentrant   No
+ *  @return      ::PCF2131_IPC_GetEvent() returns false if no event is pending.
+ */
+bool PCF2131_IPC_GetEvent(pcf2131_ipc_t *pIpc, pcf2131_ipcmsg_t *pMsg);
+
+/*! @brief       Starts serving core 0, on core 1.
+ *  @param[in]   pIpc  				Pointer to shared block.
+ *  @constraints Call it after PCF2131_Initialize() on core 1.
+ *  @reentrant   No
+ */
+void PCF2131_IPC_ServerStart(pcf2131_ipc_t *pIpc);
+
+/*! @brief       Flags an RTC interrupt for the next PCF2131_IPC_ServerRun().
+ *  @constraints Core 1 only, call it from the RTC interrupt pin handler.
+ *  @reentrant   Yes
+ */
+void PCF2131_IPC_ServerNotify(void);
+
+/*! @brief       Runs the pending core 1 work.
+ *  @details     Executes the queued requests whose reply fits the event queue, then on a flagged RTC
+ *               interrupt publishes the time on a seconds interrupt and journals the alarm and timestamps
+ *               as events. Core 0 is woken once per call if events were queued. Sleep (WFI) when it
+ *               returns false, the mailbox and the RTC interrupt both wake core 1.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @param[in]   pIpc  				Pointer to shared block.
+ *  @constraints Core 1 only, after PCF2131_IPC_ServerStart().
+ *  @reentrant   No
+ *  @return      ::PCF2131_IPC_ServerRun() returns true if work was done.
+ */
+bool PCF2131_IPC_ServerRun(pcf2131_sensorhandle_t *pSensorHandle, pcf2131_ipc_t *pIpc);
+#endif
+
+#endif /* PCF2131_IPC_H_ */
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file pcf2131_iso8601.h
+ * @brief The pcf2131_iso8601.h file describes the PCF2131 ISO-8601 / RFC-3339 time formatter and parser.
+ */
+
+#ifndef PCF2131_ISO8601_H_
+#define PCF2131_ISO8601_H_
+
+/* Standard C Includes */
+#include <stdint.h>
+
+#include "pcf2131_drv.h"
+
+/*! @def    PCF2131_ISO_TIME_LEN
+ *  @brief  Length of a formatted time, YYYY-MM-DDThh:mm:ss.cc, without the terminator. */
+#define PCF2131_ISO_TIME_LEN         (22)
+
+/*! @def    PCF2131_ISO_TIMESTAMP_LEN
+ *  @brief  Length of a formatted timestamp, YYYY-MM-DDThh:mm:ss, without the terminator. */
+#define PCF2131_ISO_TIMESTAMP_LEN    (19)
+
+/*! @def    PCF2131_ISO_INPUT_MAX_LEN
+ *  @brief  Longest string PCF2131_Iso_ParseTime() is given by the demo, YYYY-MM-DDThh:mm:ss with a nine digit
+ *          fraction and a +hh:mm offset, without the terminator. */
+#define PCF2131_ISO_INPUT_MAX_LEN    (35)
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*! @brief       Formats a time as ISO-8601.
+ *  @details     Fixed width YYYY-MM-DDThh:mm:ss.cc in 24 hour notation whatever the RTC hour mode,
+ *               built from a two-digit table without printf. The year is 2000 + years.
+ *  @param[in]   time  				Pointer to time.
+ *  @param[out]  pBuf  				Output, at least PCF2131_ISO_TIME_LEN + 1 characters.
+ *  @constraints None
+ *  @reentrant   Yes
+ *  @return      ::PCF2131_Iso_FormatTime() returns PCF2131_ISO_TIME_LEN.
+ */
+uint8_t PCF2131_Iso_FormatTime(const pcf2131_timedata_t *time, char *pBuf);
+
+/*! @brief       Formats a timestamp as ISO-8601.
+ *  @details     Fixed width YYYY-MM-DDThh:mm:ss in 24 hour notation.
+ *  @param[in]   timestamp  		Pointer to timestamp.
+ *  @param[out]  pBuf  				Output, at least PCF2131_ISO_TIMESTAMP_LEN + 1 characters.
+ *  @constraints None
+ *  @reentrant   Yes
+ *  @return      ::PCF2131_Iso_FormatTimeStamp() returns PCF2131_ISO_TIMESTAMP_LEN.
+ */
+uint8_t PCF2131_Iso_FormatTimeStamp(const pcf2131_timestamp_t *timestamp, char *pBuf);
+
+/*! @brief       Converts RTC hours to 24 hour notation.
+ *  @param[in]   hours  			Hours as read, 1 to 12 in 12 hour mode.
+ *  @param[in]   ampm  				AM, PM or h24.
+ *  @constraints None
+ *  @reentrant   Yes
+ *  @return      ::PCF2131_Iso_Hours24() returns the hours from 0 to 23.
+ */
+uint8_t PCF2131_Iso_Hours24(uint8_t hours, AmPm ampm);
+
+/*! @brief       Parses an ISO-8601 / RFC-3339 time.
+ *  @details     Accepts YYYY-MM-DDThh:mm:ss with an optional fraction of one or more digits, then an optional
+ *               Z or +hh:mm / -hh:mm UTC offset and the end of the string, anything else is rejected. A space
+ *               may replace the T. An offset is applied, the result is UTC and must fall in 2000 to 2099.
+ *               The weekday is computed from the date and the hours are converted to the given RTC hour mode,
+ *               ready for PCF2131_SetTime().
+ *  @param[in]   pStr  				Terminated string.
+ *  @param[in]   mode  				Hour mode of the RTC.
+ *  @param[out]  time  				Pointer to parsed time.
+ *  @constraints None
+ *  @reentrant   Yes
+ *  @return      ::PCF2131_Iso_ParseTime() returns the status.
+ */
+int32_t PCF2131_Iso_ParseTime(const char *pStr, Mode12h_24h mode, pcf2131_timedata_t *time);
+
+#endif /* PCF2131_ISO8601_H_ */
@@ -0,0 +1,104 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file pcf2131_poll.h
+ * @brief The pcf2131_poll.h file describes the PCF2131 polled operations for superloop firmware.
+ */
+
+#ifndef PCF2131_POLL_H_
+#define PCF2131_POLL_H_
+
+/* Standard C Includes */
+#include <stdint.h>
+
+#include "pcf2131_drv.h"
+#include "pcf2131_snapshot.h"
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*! @brief       Starts setting the time of the PCF2131 RTC.
+ *  @details     Polled form of PCF2131_SetTime(): one burst read of the time block, then one burst write
+ *               of it with the new time merged in under the register masks. The time is copied, the
+ *               caller structure is not modified.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @param[in]   time  				Time to set.
+ *  @constraints This can be called only after PCF2131_Initialize(), run it with PCF2131_Poll().
+ *  @reentrant   No
+ *  @return      ::PCF2131_Start_SetTime() returns the status, SENSOR_ERROR_BUSY if an operation is running.
+ */
+int32_t PCF2131_Start_SetTime(pcf2131_sensorhandle_t *pSensorHandle, const pcf2131_timedata_t *time);
+
+/*! @brief       Starts getting the time of the PCF2131 RTC.
+ *  @details     Polled form of PCF2131_GetTime(): Control_1 and the time block are read in one burst,
+ *               so the 12/24 hour mode needs no separate read.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @param[out]  time  				Time read, valid once PCF2131_Poll() returned SENSOR_ERROR_NONE.
+ *  @constraints This can be called only after PCF2131_Initialize(), run it with PCF2131_Poll().
+ *  @reentrant   No
+ *  @return      ::PCF2131_Start_GetTime() returns the status, SENSOR_ERROR_BUSY if an operation is running.
+ */
+int32_t PCF2131_Start_GetTime(pcf2131_sensorhandle_t *pSensorHandle, pcf2131_timedata_t *time);
+
+/*! @brief       Starts configuring the PCF2131 RTC.
+ *  @details     Polled form of PCF2131_Configure(), an entry with a mask is a read then a write.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @param[in]   pRegWriteList  	Register writes terminated by __END_WRITE_DATA__, valid until the end.
+ *  @constraints This can be called only after PCF2131_Initialize(), run it with PCF2131_Poll().
+ *  @reentrant   No
+ *  @return      ::PCF2131_Start_Configure() returns the status, SENSOR_ERROR_BUSY if an operation is running.
+ */
+int32_t PCF2131_Start_Configure(pcf2131_sensorhandle_t *pSensorHandle, const registerwritelist_t *pRegWriteList);
+
+/*! @brief       Starts enabling the seconds interrupt of the PCF2131 RTC.
+ *  @details     Polled form of PCF2131_SecInt_Enable(): sets SI and unmasks it on the selected pin.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @param[in]   intsrc  			Interrupt pin.
+ *  @constraints This can be called only after PCF2131_Initialize(), run it with PCF2131_Poll().
+ *  @reentrant   No
+ *  @return      ::PCF2131_Start_SecInt_Enable() returns the status, SENSOR_ERROR_BUSY if an operation is running.
+ */
+int32_t PCF2131_Start_SecInt_Enable(pcf2131_sensorhandle_t *pSensorHandle, IntSrc intsrc);
+
+/*! @brief       Starts enabling the minutes interrupt of the PCF2131 RTC.
+ *  @details     Polled form of PCF2131_MinInt_Enable(): sets MI and unmasks it on the selected pin.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @param[in]   intsrc  			Interrupt pin.
+ *  @constraints This can be called only after PCF2131_Initialize(), run it with PCF2131_Poll().
+ *  @reentrant   No
+ *  @return      ::PCF2131_Start_MinInt_Enable() returns the status, SENSOR_ERROR_BUSY if an operation is running.
+ */
+int32_t PCF2131_Start_MinInt_Enable(pcf2131_sensorhandle_t *pSensorHandle, IntSrc intsrc);
+
+/*! @brief       Starts taking a snapshot of the PCF2131 register map.
+ *  @details     Polled form of PCF2131_Snapshot().
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @param[out]  pSnapshot  		Pointer to snapshot structure, valid once PCF2131_Poll() returned SENSOR_ERROR_NONE.
+ *  @constraints This can be called only after PCF2131_Initialize(), run it with PCF2131_Poll().
+ *  @reentrant   No
+ *  @return      ::PCF2131_Start_Snapshot() returns the status, SENSOR_ERROR_BUSY if an operation is running.
+ */
+int32_t PCF2131_Start_Snapshot(pcf2131_sensorhandle_t *pSensorHandle, pcf2131_snapshot_t *pSnapshot);
+
+/*! @brief       Advances the polled operation of the PCF2131 handle by one step.
+ *  @details     A step is either the check of the transfer on the bus or the CPU work between two transfers
+ *               followed by the start of the next one, a poll never waits for the bus. The worst case poll
+ *               is the decode of a time block or the merge of a register block plus the start of one
+ *               transfer (CMSIS transfer setup, FIFO fill and slave select); the polls and the longest
+ *               poll of the operation are recorded in pSensorHandle->poll.polls and maxPoll_us.
+ *               Open register transactions and the watchdog piggyback do not apply to polled operations.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @constraints Call it from the main loop until it stops returning SENSOR_ERROR_BUSY. Blocking APIs must
+ *				 not be called for the handle while an operation runs.
+ *  @reentrant   No
+ *  @return      ::PCF2131_Poll() returns SENSOR_ERROR_BUSY while the operation runs, then its status once,
+ *               and SENSOR_ERROR_NONE when idle.
+ */
+int32_t PCF2131_Poll(pcf2131_sensorhandle_t *pSensorHandle);
+
+#endif /* PCF2131_POLL_H_ */
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file pcf2131_snapshot.h
+ * @brief The pcf2131_snapshot.h file describes the PCF2131 register map snapshot and restore interface.
+ */
+
+#ifndef PCF2131_SNAPSHOT_H_
+#define PCF2131_SNAPSHOT_H_
+
+/* Standard C Includes */
+#include <stdint.h>
+
+#include "pcf2131_drv.h"
+
+/*! @def    PCF2131_RESTORE_MAX_GAP
+ *  @brief  Longest run of unchanged restorable registers rewritten to merge two bursts. */
+#define PCF2131_RESTORE_MAX_GAP    (2)
+
+/*! @brief This structure holds the full PCF2131 register map, laid out for PCF2131_ReadInPlace().*/
+typedef struct
+{
+	uint8_t headroom[PCF2131_BUF_HEADROOM];  /*!< Command headroom, not part of the snapshot.*/
+	uint8_t reg[PCF2131_REG_MAP_SIZE];       /*!< Register values indexed by register address.*/
+} pcf2131_snapshot_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*! @brief       Takes a snapshot of the PCF2131 register map.
+ *  @details     Reads all registers in a single auto-increment burst.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @param[out]  pSnapshot  		Pointer to snapshot structure.
+ *  @constraints This can be called any number of times only after PCF2131_Initialize().
+ *				 Application has to ensure that previous instances of these APIs have exited before invocation
+ *  @reentrant   No
+ *  @return      ::PCF2131_Snapshot() returns the status.
+ */
+int32_t PCF2131_Snapshot(pcf2131_sensorhandle_t *pSensorHandle, pcf2131_snapshot_t *pSnapshot);
+
+/*! @brief       Restores the PCF2131 configuration from a snapshot.
+ *  @details     Takes a live snapshot and writes only the configuration bits that differ from the target,
+ *               adjacent changes merged into bursts. Time and timestamp counters, the software reset and
+ *               watchdog value registers and all status flags are never restored, flags keep their live value.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @param[in]   pTarget  			Pointer to snapshot to restore.
+ *  @param[out]  pBursts  			Number of write bursts issued, NULL if not needed.
+ *  @constraints This can be called any number of times only after PCF2131_Initialize().
+ *				 Application has to ensure that previous instances of these APIs have exited before invocation
+ *  @reentrant   No
+ *  @return      ::PCF2131_Restore() returns the status.
+ */
+int32_t PCF2131_Restore(pcf2131_sensorhandle_t *pSensorHandle, const pcf2131_snapshot_t *pTarget, uint8_t *pBursts);
+
+#endif /* PCF2131_SNAPSHOT_H_ */
@@ -17,14 +17,6 @@
 #include "systick_utils.h"
 
 #if !(I2C_ENABLE)
-//-----------------------------------------------------------------------
-// Global Variables
-//-----------------------------------------------------------------------
-uint8_t pcf2131_spiRead_CmdBuffer[PCF2131_SPI_MAX_MSG_SIZE] = {0};
-uint8_t pcf2131_spiRead_DataBuffer[PCF2131_SPI_MAX_MSG_SIZE] = {0};
-uint8_t pcf2131_spiWrite_CmdDataBuffer[PCF2131_SPI_MAX_MSG_SIZE] = {0};
-
-
 //-----------------------------------------------------------------------
 // Functions
 //-----------------------------------------------------------------------
@@ -39,40 +31,73 @@ uint8_t BcdToDecimal(uint8_t val)
 	return (((val) >> 4) * 10 + ((val) & 0x0f)) ;
 }
 
+/*! Writes a register, or records the write in the dirty set while a transaction is open. */
+static int32_t PCF2131_RegWrite(pcf2131_sensorhandle_t *pSensorHandle, uint8_t offset, uint8_t value, uint8_t mask)
+{
+	/*! A non zero mask does a read-modify-write that also ORs in value bits outside the mask */
+	uint8_t dirty = (mask != 0) ? (mask | value) : 0xFF;
+
+	if (!pSensorHandle->inTransaction)
+	{
+		return Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+			offset, value, mask);
+	}
+
+	if (offset >= PCF2131_REG_MAP_SIZE)
+	{
+		return ARM_DRIVER_ERROR_PARAMETER;
+	}
+
+	pSensorHandle->txnValue[offset] = (pSensorHandle->txnValue[offset] & ~dirty) | (value & dirty);
+	pSensorHandle->txnMask[offset] |= dirty;
+
+	return ARM_DRIVER_OK;
+}
+
+/*! Reads one register in place, the command goes into the first byte of the stack buffer. */
+static int32_t PCF2131_RegRead(pcf2131_sensorhandle_t *pSensorHandle, uint8_t offset, uint8_t *pValue)
+{
+	int32_t status;
+	uint8_t buffer[PCF2131_SPI_CMD_LEN + PCF2131_REG_SIZE_BYTE];
+
+	status = Register_SPI_ReadInPlace(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+			offset, PCF2131_REG_SIZE_BYTE, buffer);
+	if (ARM_DRIVER_OK == status)
+	{
+		*pValue = buffer[PCF2131_SPI_CMD_LEN];
+	}
+
+	return status;
+}
+
 
 void PCF2131_ReadPreprocess(void *pCmdOut, uint32_t offset, uint32_t size)
 {
 	spiCmdParams_t *pSlaveCmd = pCmdOut;
 
-	uint8_t *pWBuff = pcf2131_spiRead_CmdBuffer;
-	uint8_t *pRBuff = pcf2131_spiRead_DataBuffer;
-
-	/* Formatting for Read command of PCF2131 SENSOR. */
-	*(pWBuff) = offset | PCF2131_SPI_RD_CMD; /* offset is the internal register address of the sensor at which Read performed. */
+	/* Formatting for Read command of PCF2131 SENSOR into the caller supplied buffer. */
+	*(pSlaveCmd->pWriteBuffer) = offset | PCF2131_SPI_RD_CMD; /* offset is the internal register address of the sensor at which Read performed. */
 
 	/* Create the slave read command. */
 	pSlaveCmd->size = size + PCF2131_SPI_CMD_LEN;
-	pSlaveCmd->pWriteBuffer = pWBuff;
-	pSlaveCmd->pReadBuffer = pRBuff;
 }
 
 void PCF2131_WritePreprocess(void *pCmdOut, uint32_t offset, uint32_t size, void *pWritebuffer)
 {
 	spiCmdParams_t *pSlaveCmd = pCmdOut;
+	uint8_t *pWBuff = pSlaveCmd->pWriteBuffer;
 
-	uint8_t *pWBuff = pcf2131_spiWrite_CmdDataBuffer;
-	uint8_t *pRBuff = pcf2131_spiWrite_CmdDataBuffer + size + PCF2131_SPI_CMD_LEN;
-
-	/* Formatting for Write command of PCF2131 RTC. */
+	/* Formatting for Write command of PCF2131 SENSOR into the caller supplied buffer. */
 	*(pWBuff) =   offset & PCF2131_SPI_WR_CMD; /* offset is the internal register address of the sensor at which write is performed. */
 
-	/* Copy the slave write command */
-	memcpy(pWBuff + PCF2131_SPI_CMD_LEN, pWritebuffer, size);
+	/* Copy the slave write data unless it is already in place behind the command */
+	if (pWritebuffer != pWBuff + PCF2131_SPI_CMD_LEN)
+	{
+		memmove(pWBuff + PCF2131_SPI_CMD_LEN, pWritebuffer, size);
+	}
 
 	/* Create the slave command. */
 	pSlaveCmd->size = size + PCF2131_SPI_CMD_LEN;
-	pSlaveCmd->pWriteBuffer = pWBuff;
-	pSlaveCmd->pReadBuffer = pRBuff;
 }
 
 int32_t PCF2131_Initialize(pcf2131_sensorhandle_t *pSensorHandle, ARM_DRIVER_SPI *pBus, uint8_t index, void *pSlaveSelect)
@@ -98,6 +123,16 @@ int32_t PCF2131_Initialize(pcf2131_sensorhandle_t *pSensorHandle, ARM_DRIVER_SPI
 	pSensorHandle->deviceInfo.deviceInstance = index;
 	pSensorHandle->deviceInfo.functionParam = NULL;
 	pSensorHandle->deviceInfo.idleFunction = NULL;
+	pSensorHandle->deviceInfo.timeout_us = PCF2131_BUS_TIMEOUT_US;
+	pSensorHandle->deviceInfo.pArbDevice = NULL;
+
+	pSensorHandle->wdCtl = 0;
+	pSensorHandle->wdKickValue = 0;
+	pSensorHandle->wdPiggyback = false;
+	pSensorHandle->inTransaction = false;
+	memset(&pSensorHandle->poll, 0, sizeof(pSensorHandle->poll));
+	pSensorHandle->pExtClkPin = NULL;
+	pSensorHandle->pExtClock = NULL;
 
 	pSensorHandle->isInitialized = true;
 	return SENSOR_ERROR_NONE;
@@ -111,6 +146,43 @@ void PCF2131_SetIdleTask(pcf2131_sensorhandle_t *pSensorHandle,
 	pSensorHandle->deviceInfo.idleFunction = idleTask;
 }
 
+void PCF2131_SetTimeout(pcf2131_sensorhandle_t *pSensorHandle, uint32_t timeout_us)
+{
+	pSensorHandle->deviceInfo.timeout_us = timeout_us;
+}
+
+void PCF2131_SetArbiter(pcf2131_sensorhandle_t *pSensorHandle, busArbiterDevice_t *pDevice)
+{
+	pSensorHandle->deviceInfo.pArbDevice = pDevice;
+}
+
+int32_t PCF2131_SetBusSpeed(pcf2131_sensorhandle_t *pSensorHandle, uint32_t busSpeed)
+{
+	int32_t status;
+
+	/*! On a shared bus the arbiter keeps the speed with the RTC */
+	if (pSensorHandle->deviceInfo.pArbDevice != NULL)
+	{
+		status = Bus_Arbiter_SetSpeed(pSensorHandle->deviceInfo.pArbDevice, busSpeed);
+	}
+	else
+	{
+		status = pSensorHandle->pCommDrv->Control(ARM_SPI_SET_BUS_SPEED, busSpeed);
+	}
+
+	return (ARM_DRIVER_OK == status) ? SENSOR_ERROR_NONE : SENSOR_ERROR_INIT;
+}
+
+void PCF2131_GetBusCount(pcf2131_sensorhandle_t *pSensorHandle, registerIoCount_t *pCount)
+{
+	Register_SPI_GetCount(pSensorHandle->deviceInfo.deviceInstance, pCount);
+}
+
+void PCF2131_ClearBusCount(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	Register_SPI_ClearCount(pSensorHandle->deviceInfo.deviceInstance);
+}
+
 int32_t PCF2131_Configure(pcf2131_sensorhandle_t *pSensorHandle, const registerwritelist_t *pRegWriteList)
 {
 	int32_t status;
@@ -132,12 +204,44 @@ int32_t PCF2131_Configure(pcf2131_sensorhandle_t *pSensorHandle, const registerw
 			pRegWriteList);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
+	}
+
+	/*! Piggyback the watchdog kick on this transfer */
+	if (pSensorHandle->wdPiggyback)
+	{
+		status = PCF2131_Watchdog_Kick(pSensorHandle);
+		if (SENSOR_ERROR_NONE != status)
+		{
+			return status;
+		}
 	}
 
 	return SENSOR_ERROR_NONE;
 }
 
+/* Checks that a caller read list stays within the register map and fills no more than size bytes. */
+static bool PCF2131_ReadListFits(const registerreadlist_t *pReadList, uint32_t size)
+{
+	uint32_t total = 0;
+
+	if (pReadList == NULL)
+	{
+		return false;
+	}
+
+	for (; pReadList->numBytes != 0; pReadList++)
+	{
+		total += pReadList->numBytes;
+		if ((total > size) || ((pReadList->readFrom + pReadList->numBytes) > PCF2131_REG_MAP_SIZE))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
 int32_t PCF2131_ReadData(pcf2131_sensorhandle_t *pSensorHandle,
 		const registerreadlist_t *pReadList,
 		uint8_t *pBuffer)
@@ -161,9 +265,271 @@ int32_t PCF2131_ReadData(pcf2131_sensorhandle_t *pSensorHandle,
 			pReadList, pBuffer);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_READ;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_READ);
+	}
+
+	/*! Piggyback the watchdog kick on this transfer */
+	if (pSensorHandle->wdPiggyback)
+	{
+		status = PCF2131_Watchdog_Kick(pSensorHandle);
+		if (SENSOR_ERROR_NONE != status)
+		{
+			return status;
+		}
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_ReadInPlace(pcf2131_sensorhandle_t *pSensorHandle, uint8_t offset, uint8_t length, uint8_t *pBuffer)
+{
+	int32_t status;
+
+	/*! Validate for the correct handle and buffer.*/
+	if ((pSensorHandle == NULL) || (pBuffer == NULL))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before reading sensor data.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/*! Read directly into the caller buffer behind the command headroom. */
+	status = Register_SPI_ReadInPlace(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+			offset, length, pBuffer);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_READ);
+	}
+
+	/*! Piggyback the watchdog kick on this transfer */
+	if (pSensorHandle->wdPiggyback)
+	{
+		status = PCF2131_Watchdog_Kick(pSensorHandle);
+		if (SENSOR_ERROR_NONE != status)
+		{
+			return status;
+		}
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_WriteInPlace(pcf2131_sensorhandle_t *pSensorHandle, uint8_t offset, uint8_t length, uint8_t *pBuffer)
+{
+	int32_t status;
+
+	/*! Validate for the correct handle and buffer.*/
+	if ((pSensorHandle == NULL) || (pBuffer == NULL))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before writing sensor data.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/*! Send the caller buffer with the command formatted into its headroom. */
+	status = Register_SPI_BlockWriteInPlace(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+			offset, pBuffer, length);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_StartReadInPlace(pcf2131_sensorhandle_t *pSensorHandle, uint8_t offset, uint8_t length, uint8_t *pBuffer)
+{
+	int32_t status;
+
+	/*! Validate for the correct handle and buffer.*/
+	if ((pSensorHandle == NULL) || (pBuffer == NULL))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before reading sensor data.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/*! Start the read directly into the caller buffer behind the command headroom. */
+	status = Register_SPI_StartReadInPlace(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,
+			&pSensorHandle->slaveParams, offset, length, pBuffer);
+	/*! A shared bus taken by another device is retried on the next poll */
+	if (ARM_DRIVER_ERROR_BUSY == status)
+	{
+		return SENSOR_ERROR_BUSY;
+	}
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_READ);
+	}
+	pSensorHandle->poll.error = SENSOR_ERROR_READ;
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_StartWriteInPlace(pcf2131_sensorhandle_t *pSensorHandle, uint8_t offset, uint8_t length, uint8_t *pBuffer)
+{
+	int32_t status;
+
+	/*! Validate for the correct handle and buffer.*/
+	if ((pSensorHandle == NULL) || (pBuffer == NULL))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before writing sensor data.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/*! Start sending the caller buffer, the command goes into the headroom. */
+	status = Register_SPI_StartBlockWriteInPlace(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,
+			&pSensorHandle->slaveParams, offset, pBuffer, length);
+	/*! A shared bus taken by another device is retried on the next poll */
+	if (ARM_DRIVER_ERROR_BUSY == status)
+	{
+		return SENSOR_ERROR_BUSY;
+	}
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
+	}
+	pSensorHandle->poll.error = SENSOR_ERROR_WRITE;
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_PollTransfer(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	int32_t status;
+
+	status = Register_SPI_Poll(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams);
+	if (ARM_DRIVER_ERROR_BUSY == status)
+	{
+		return SENSOR_ERROR_BUSY;
+	}
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BUS_STATUS(status, pSensorHandle->poll.error);
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_Begin(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	/*! Validate for the correct handle */
+	if (pSensorHandle == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized and no transaction is open.*/
+	if ((pSensorHandle->isInitialized != true) || pSensorHandle->inTransaction)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	memset(pSensorHandle->txnMask, 0, sizeof(pSensorHandle->txnMask));
+	pSensorHandle->inTransaction = true;
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_Commit(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	int32_t status;
+	uint8_t buffer[PCF2131_BUF_HEADROOM + PCF2131_REG_MAP_SIZE];
+	uint8_t *pReg = &buffer[PCF2131_BUF_HEADROOM];
+	uint8_t *pMask;
+	uint8_t start, end;
+	bool needRead;
+
+	/*! Validate for the correct handle */
+	if (pSensorHandle == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized and a transaction is open.*/
+	if ((pSensorHandle->isInitialized != true) || !pSensorHandle->inTransaction)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/*! Close the transaction so that the bursts below go to the bus */
+	pSensorHandle->inTransaction = false;
+	pMask = pSensorHandle->txnMask;
+
+	/*! Read every dirty range holding a partially written register before writing anything.
+	 *  Top down, so the headroom of a read only lands on ranges still to be read. */
+	for (end = PCF2131_REG_MAP_SIZE; end > 0; end = start)
+	{
+		needRead = false;
+		for (start = end; (start > 0) && (pMask[start - 1] != 0); start--)
+		{
+			needRead |= (pMask[start - 1] != 0xFF);
+		}
+		if (start == end)
+		{
+			start--;
+		}
+		else if (needRead)
+		{
+			status = PCF2131_ReadInPlace(pSensorHandle, start, end - start, &pReg[start] - PCF2131_BUF_HEADROOM);
+			if (SENSOR_ERROR_NONE != status)
+			{
+				return status;
+			}
+		}
+	}
+
+	/*! Merge and write each dirty range in one burst.
+	 *  Bottom up, so the headroom of a write only lands below the ranges already written. */
+	for (start = 0; start < PCF2131_REG_MAP_SIZE; start = end)
+	{
+		for (end = start; (end < PCF2131_REG_MAP_SIZE) && (pMask[end] != 0); end++)
+		{
+			pReg[end] = (pReg[end] & ~pMask[end]) | (pSensorHandle->txnValue[end] & pMask[end]);
+		}
+		if (end == start)
+		{
+			end++;
+			continue;
+		}
+
+		status = PCF2131_WriteInPlace(pSensorHandle, start, end - start, &pReg[start] - PCF2131_BUF_HEADROOM);
+		if (SENSOR_ERROR_NONE != status)
+		{
+			return status;
+		}
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_Abort(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	/*! Validate for the correct handle */
+	if (pSensorHandle == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
 	}
 
+	pSensorHandle->inTransaction = false;
+
 	return SENSOR_ERROR_NONE;
 }
 
@@ -188,7 +554,7 @@ int32_t PCF2131_Deinit(pcf2131_sensorhandle_t *pSensorHandle)
 			PCF2131_SR_RESET, PCF2131_TRIGGER_SW_RESET, PCF2131_RESET_MASK);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 	else
 	{
@@ -220,26 +586,26 @@ int32_t PCF2131_SecInt_Enable(pcf2131_sensorhandle_t *pSensorHandle, IntSrc ints
 	}
 
 	/*! Second Interrupt Enable */
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_CTRL1, (uint8_t)(intEnable << PCF2131_CTRL1_SI_SHIFT ), PCF2131_CTRL1_SI_MASK);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
 	if( intsrc == IntA)   /*! clear Second Interrupt Mask on INTA */
 	{
-		status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_INT_A_MASK1,( INT_UNMASK << PCF2131_SI_SHIFT), PCF2131_SI_DIS_MASK);
 	}
 	else  /*! clear Second Interrupt Mask on INTB */
 	{
-		status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_INT_B_MASK1,( INT_UNMASK << PCF2131_SI_SHIFT), PCF2131_SI_DIS_MASK);
 	}
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
 	return SENSOR_ERROR_NONE;
@@ -262,25 +628,25 @@ int32_t PCF2131_SecInt_Disable(pcf2131_sensorhandle_t *pSensorHandle)
 	}
 
 	/*! Second Interrupt Disable */
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_CTRL1,(uint8_t)(intDisable << PCF2131_CTRL1_SI_SHIFT ), PCF2131_CTRL1_SI_MASK);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_INT_A_MASK1,( INT_MASK << PCF2131_SI_SHIFT), PCF2131_SI_DIS_MASK);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_INT_B_MASK1, (INT_MASK << PCF2131_SI_SHIFT), PCF2131_SI_DIS_MASK);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
 	return SENSOR_ERROR_NONE;
@@ -304,26 +670,26 @@ int32_t PCF2131_MinInt_Enable(pcf2131_sensorhandle_t *pSensorHandle, IntSrc ints
 	}
 
 	/*! Minute Interrupt Enable */
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_CTRL1, (uint8_t)(intEnable << PCF2131_CTRL1_MI_SHIFT ), PCF2131_CTRL1_MI_MASK);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
 	if( intsrc == IntA)   /*! clear Second Interrupt Mask on INTA */
 	{
-		status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_INT_A_MASK1,( INT_UNMASK << PCF2131_MI_SHIFT), PCF2131_MI_DIS_MASK);
 	}
 	else  /*! clear Second Interrupt Mask on INTB */
 	{
-		status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_INT_B_MASK1,( INT_UNMASK << PCF2131_MI_SHIFT), PCF2131_MI_DIS_MASK);
 	}
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 	return SENSOR_ERROR_NONE;
 }
@@ -345,25 +711,25 @@ int32_t PCF2131_MinInt_Disable(pcf2131_sensorhandle_t *pSensorHandle)
 	}
 
 	/*! Minute Interrupt Disable */
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_CTRL1,(uint8_t)(intDisable << PCF2131_CTRL1_MI_SHIFT ), PCF2131_CTRL1_MI_MASK);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_INT_A_MASK1,( INT_MASK << PCF2131_MI_SHIFT), PCF2131_MI_DIS_MASK);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_INT_B_MASK1, (INT_MASK << PCF2131_MI_SHIFT), PCF2131_MI_DIS_MASK);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 	return SENSOR_ERROR_NONE;
 }
@@ -385,11 +751,11 @@ int32_t PCF2131_12h_24h_Mode_Set(pcf2131_sensorhandle_t *pSensorHandle, Mode12h_
 	}
 
 	/*! Set 12/24 mode */
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_CTRL1, (uint8_t)(((is_mode12h == mode12H) ? mode12H : mode24H ) << PCF2131_CTRL1_12_HOUR_24_HOUR_MODE_SHIFT ), PCF2131_CTRL1_12_HOUR_24_HOUR_MODE_MASK);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
 	return SENSOR_ERROR_NONE;
@@ -413,11 +779,10 @@ int32_t PCF2131_12h_24h_Mode_Get(pcf2131_sensorhandle_t *pSensorHandle, Mode12h_
 	}
 
 	/*! Get 12/24 mode */
-	status = Register_SPI_Read(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
-			PCF2131_CTRL1, PCF2131_REG_SIZE_BYTE, (uint8_t *)&Ctrl1_Reg);
+	status = PCF2131_RegRead(pSensorHandle, PCF2131_CTRL1, (uint8_t *)&Ctrl1_Reg);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_READ;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_READ);
 	}
 	*pmode_12_24 = Ctrl1_Reg.b.mode_12_24;
 
@@ -443,11 +808,11 @@ int32_t PCF2131_Sec100TH_Mode(pcf2131_sensorhandle_t *pSensorHandle, S100thMode
 	}
 
 	/*! 100th Second mode Enable/Disable */
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_CTRL1, (uint8_t)(((is_s100h == s100thEnable) ? s100thEnable : s100thDisable) << PCF2131_CTRL1_100TH_S_DIS_SHIFT ), PCF2131_CTRL1_100TH_S_DIS_MASK);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
 	return SENSOR_ERROR_NONE;
@@ -471,11 +836,10 @@ int32_t PCF2131_Sec100TH_Mode_Get(pcf2131_sensorhandle_t *pSensorHandle, S100thM
 	}
 
 	/*! Get 100th Second mode */
-	status = Register_SPI_Read(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
-			PCF2131_CTRL1, PCF2131_REG_SIZE_BYTE, (uint8_t *)&Ctrl1_Reg);
+	status = PCF2131_RegRead(pSensorHandle, PCF2131_CTRL1, (uint8_t *)&Ctrl1_Reg);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_READ);
 	}
 	*s100_mode = Ctrl1_Reg.b.s_dis_100th;
 
@@ -499,11 +863,11 @@ int32_t PCF2131_Rtc_Start(pcf2131_sensorhandle_t *pSensorHandle)
 	}
 
 	/*! Start RTC source clock */
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_CTRL1, (uint8_t)(rtcStart << PCF2131_CTRL1_START_STOP_SHIFT ), PCF2131_CTRL1_START_STOP_MASK);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
 	return SENSOR_ERROR_NONE;
@@ -527,11 +891,11 @@ int32_t PCF2131_Rtc_Stop(pcf2131_sensorhandle_t *pSensorHandle)
 	}
 
 	/*! Stop RTC source clock */
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_CTRL1, (uint8_t)(rtcStop << PCF2131_CTRL1_START_STOP_SHIFT), PCF2131_CTRL1_START_STOP_MASK);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
 	return SENSOR_ERROR_NONE;
@@ -554,11 +918,11 @@ int32_t PCF2131_Clear_MinSecInt(pcf2131_sensorhandle_t *pSensorHandle)
 	}
 
 	/*! clear Minute/Second interrupt flag */
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_CTRL2, (uint8_t)(intClear << PCF2131_CTRL2_MSF_SHIFT), PCF2131_CTRL2_MSF_MASK);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
 	return SENSOR_ERROR_NONE;
@@ -582,11 +946,10 @@ int32_t PCF2131_Check_MinSecInt(pcf2131_sensorhandle_t *pSensorHandle, IntState
 	}
 
 	/*! Get Minute/Second interrupt flag */
-	status = Register_SPI_Read(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
-			PCF2131_CTRL2, PCF2131_REG_SIZE_BYTE, (uint8_t *)&Ctrl2_Reg);
+	status = PCF2131_RegRead(pSensorHandle, PCF2131_CTRL2, (uint8_t *)&Ctrl2_Reg);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_READ;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_READ);
 	}
 	*pIntStatus = Ctrl2_Reg.b.msf ;
 
@@ -612,27 +975,27 @@ int32_t PCF2131_Clear_SW_TsInt(pcf2131_sensorhandle_t *pSensorHandle, SwTsNum sw
 	switch (swtsnum)
 	{
 	case sw1Ts: /* Clear SW1 Time Stamp Interrupt */
-		status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_CTRL4, (uint8_t)(intClear << PCF2131_CTRL4_TSF1_SHIFT), PCF2131_CTRL4_TSF1_MASK);
 		break;
 	case sw2Ts: /* Clear SW2 Time Stamp Interrupt */
-		status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_CTRL4, (uint8_t)(intClear << PCF2131_CTRL4_TSF2_SHIFT), PCF2131_CTRL4_TSF2_MASK);
 		break;
 	case sw3Ts: /* Clear SW3 Time Stamp Interrupt */
-		status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_CTRL4, (uint8_t)(intClear << PCF2131_CTRL4_TSF3_SHIFT), PCF2131_CTRL4_TSF3_MASK);
 		break;
 	case sw4Ts: /* Clear SW4 Time Stamp Interrupt */
-		status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_CTRL4, (uint8_t)(intClear << PCF2131_CTRL4_TSF4_SHIFT), PCF2131_CTRL4_TSF4_MASK);;
 		break;
 	default:
-		break;
+		return SENSOR_ERROR_INVALID_PARAM;
 	}
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
 	return SENSOR_ERROR_NONE;
@@ -656,11 +1019,10 @@ int32_t PCF2131_Check_SW_TsInt(pcf2131_sensorhandle_t *pSensorHandle, SwTsNum sw
 	}
 
 	/*! read control Register 4 */
-	status = Register_SPI_Read(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
-			PCF2131_CTRL4, PCF2131_REG_SIZE_BYTE, (uint8_t *)&Ctrl4_Reg);
+	status = PCF2131_RegRead(pSensorHandle, PCF2131_CTRL4, (uint8_t *)&Ctrl4_Reg);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_READ;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_READ);
 	}
 
 	switch (swtsnum)
@@ -678,7 +1040,7 @@ int32_t PCF2131_Check_SW_TsInt(pcf2131_sensorhandle_t *pSensorHandle, SwTsNum sw
 		*pSwIntState = Ctrl4_Reg.b.tsf4 ;
 		break;
 	default:
-		break;
+		return SENSOR_ERROR_INVALID_PARAM;
 	}
 	return SENSOR_ERROR_NONE;
 }
@@ -702,79 +1064,79 @@ int32_t PCF2131_SW_TsInt_Enable(pcf2131_sensorhandle_t *pSensorHandle, SwTsNum s
 	switch(swtsnum)
 	{
 	case sw1Ts:   /*! SW1 time stamp INT Enable */
-		status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_CTRL5, (uint8_t)(intEnable << PCF2131_CTRL5_TSIE1_SHIFT ), PCF2131_CTRL5_TSIE1_MASK);
 		if (ARM_DRIVER_OK != status)
 		{
-			return SENSOR_ERROR_WRITE;
+			return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 		}
 
 		if( intsrc == IntA)   /*! Clear SW1 time stamp INTA */
 		{
-			status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+			status = PCF2131_RegWrite(pSensorHandle,
 					PCF2131_INT_A_MASK2, PCF2131_TS1_ENB_MASK_VALUE, PCF2131_REG_MASK);
 		}
 		else  /*! Clear SW1 time stamp INTB */
 		{
-			status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+			status = PCF2131_RegWrite(pSensorHandle,
 					PCF2131_INT_B_MASK2, PCF2131_TS1_ENB_MASK_VALUE, PCF2131_REG_MASK);
 		}
 		break;
 	case sw2Ts:  /*! SW2 time stamp INT Enable */
-		status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_CTRL5, (uint8_t)(intEnable << PCF2131_CTRL5_TSIE2_SHIFT ), PCF2131_CTRL5_TSIE2_MASK);
 		if (ARM_DRIVER_OK != status)
 		{
-			return SENSOR_ERROR_WRITE;
+			return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 		}
 
 		if( intsrc == IntA)   /*! Clear SW2 time stamp INTA */
 		{
-			status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+			status = PCF2131_RegWrite(pSensorHandle,
 					PCF2131_INT_A_MASK2, PCF2131_TS2_ENB_MASK_VALUE, PCF2131_REG_MASK);
 		}
 		else  /*! Clear SW2 time stamp INTB */
 		{
-			status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+			status = PCF2131_RegWrite(pSensorHandle,
 					PCF2131_INT_B_MASK2, PCF2131_TS2_ENB_MASK_VALUE, PCF2131_REG_MASK);
 		}
 		break;
 	case sw3Ts:   /*! SW3 time stamp INT Enable */
-		status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_CTRL5, (uint8_t)(intEnable << PCF2131_CTRL5_TSIE3_SHIFT ), PCF2131_CTRL5_TSIE3_MASK);
 		if (ARM_DRIVER_OK != status)
 		{
-			return SENSOR_ERROR_WRITE;
+			return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 		}
 
 
 		if( intsrc == IntA)   /*! Clear SW3 time stamp INTA */
 		{
-			status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+			status = PCF2131_RegWrite(pSensorHandle,
 					PCF2131_INT_A_MASK2, PCF2131_TS3_ENB_MASK_VALUE, PCF2131_REG_MASK);
 		}
 		else  /*! Clear SW3 time stamp INTB */
 		{
-			status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+			status = PCF2131_RegWrite(pSensorHandle,
 					PCF2131_INT_B_MASK2, PCF2131_TS3_ENB_MASK_VALUE, PCF2131_REG_MASK);
 		}
 		break;
 	case sw4Ts:  /*! SW4 time stamp INT Enable */
-		status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_CTRL5, (uint8_t)(intEnable << PCF2131_CTRL5_TSIE4_SHIFT ), PCF2131_CTRL5_TSIE4_MASK);
 		if (ARM_DRIVER_OK != status)
 		{
-			return SENSOR_ERROR_WRITE;
+			return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 		}
 
 		if( intsrc == IntA)   /*! Clear SW4 time stamp INTA */
 		{
-			status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+			status = PCF2131_RegWrite(pSensorHandle,
 					PCF2131_INT_A_MASK2, PCF2131_TS4_ENB_MASK_VALUE, PCF2131_REG_MASK);
 		}
 		else  /*! Clear SW4 time stamp INTB */
 		{
-			status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+			status = PCF2131_RegWrite(pSensorHandle,
 					PCF2131_INT_B_MASK2, PCF2131_TS4_ENB_MASK_VALUE, PCF2131_REG_MASK);
 		}
 		break;
@@ -783,7 +1145,7 @@ int32_t PCF2131_SW_TsInt_Enable(pcf2131_sensorhandle_t *pSensorHandle, SwTsNum s
 	}
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 	return SENSOR_ERROR_NONE;
 }
@@ -807,19 +1169,19 @@ int32_t PCF2131_SW_TsInt_Disable(pcf2131_sensorhandle_t *pSensorHandle, SwTsNum
 	switch(swtsnum)
 	{
 	case sw1Ts:   /*! SW1 time stamp INT Disable */
-		status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_CTRL5, (uint8_t)(intDisable << PCF2131_CTRL5_TSIE1_SHIFT ), PCF2131_CTRL5_TSIE1_MASK);
 		break;
 	case sw2Ts:  /*! SW2 time stamp INT Disable */
-		status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_CTRL5, (uint8_t)(intDisable << PCF2131_CTRL5_TSIE2_SHIFT), PCF2131_CTRL5_TSIE2_MASK);
 		break;
 	case sw3Ts:   /*! SW3 time stamp INT Disable */
-		status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_CTRL5, (uint8_t)(intDisable << PCF2131_CTRL5_TSIE3_SHIFT), PCF2131_CTRL5_TSIE3_MASK);
 		break;
 	case sw4Ts:  /*! SW4 time stamp INT Disable */
-		status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_CTRL5, (uint8_t)(intDisable << PCF2131_CTRL5_TSIE4_SHIFT), PCF2131_CTRL5_TSIE4_MASK);
 		break;
 	default:
@@ -827,21 +1189,21 @@ int32_t PCF2131_SW_TsInt_Disable(pcf2131_sensorhandle_t *pSensorHandle, SwTsNum
 	}
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_INT_A_MASK1,(INT_MASK << swtsnum ), INT_MASK << swtsnum);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_INT_B_MASK1, (INT_MASK << swtsnum ), INT_MASK << swtsnum);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
 	return SENSOR_ERROR_NONE;
@@ -866,23 +1228,23 @@ int32_t PCF2131_SwRst(pcf2131_sensorhandle_t *pSensorHandle, SwRst swrst)
 	switch(swrst)
 	{
 	case CPR:  /*! Trigger clear prescaler.*/
-		status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_SR_RESET, PCF2131_CPR, PCF2131_RESET_MASK);
 		break;
 	case CTS:  /*! Trigger clear Time stamp.*/
-		status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_SR_RESET, PCF2131_CTS, PCF2131_RESET_MASK);
 		break;
 	case SR:   /*! Trigger sensor device reset.*/
-		status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_SR_RESET, PCF2131_TRIGGER_SW_RESET, PCF2131_RESET_MASK);
 		break;
 	default:
-		break;
+		return SENSOR_ERROR_INVALID_PARAM;
 	}
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
 	/* Wait for MAX of TBOOT ms after soft reset command,
@@ -911,27 +1273,27 @@ int32_t PCF2131_TimeStamp_On(pcf2131_sensorhandle_t *pSensorHandle, SwTsNum tsnu
 	switch(tsnum)
 	{
 	case sw1Ts:  /*! Enable SW1 Timestamp.*/
-		status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_TIMESTAMP1_CTL, (Ts_On << PCF2131_TSOFF_TS_SHIFT ), PCF2131_TSOFF_TS_MASK);
 		break;
 	case sw2Ts: /*! Enable SW2 Timestamp.*/
-		status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_TIMESTAMP2_CTL, (Ts_On << PCF2131_TSOFF_TS_SHIFT ), PCF2131_TSOFF_TS_MASK);
 		break;
 	case sw3Ts:   /*! Enable SW3 Timestamp.*/
-		status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_TIMESTAMP3_CTL, (Ts_On << PCF2131_TSOFF_TS_SHIFT ), PCF2131_TSOFF_TS_MASK);
 		break;
 	case sw4Ts:  /*! Enable SW4 Timestamp.*/
-		status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_TIMESTAMP4_CTL, (Ts_On << PCF2131_TSOFF_TS_SHIFT ), PCF2131_TSOFF_TS_MASK);
 		break;
 	default:
-		break;
+		return SENSOR_ERROR_INVALID_PARAM;
 	}
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
 	return SENSOR_ERROR_NONE;
@@ -956,27 +1318,27 @@ int32_t PCF2131_TimeStamp_Off(pcf2131_sensorhandle_t *pSensorHandle, SwTsNum tsn
 	switch(tsnum)
 	{
 	case sw1Ts:  /*! Disable SW1 Timestamp.*/
-		status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_TIMESTAMP1_CTL, (Ts_Off << PCF2131_TSOFF_TS_SHIFT ), PCF2131_TSOFF_TS_MASK);
 		break;
 	case sw2Ts:  /*! Disable SW2 Timestamp.*/
-		status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_TIMESTAMP2_CTL, (Ts_Off << PCF2131_TSOFF_TS_SHIFT ), PCF2131_TSOFF_TS_MASK);
 		break;
 	case sw3Ts:  /*! Disable SW3 Timestamp.*/
-		status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_TIMESTAMP3_CTL, (Ts_Off << PCF2131_TSOFF_TS_SHIFT ), PCF2131_TSOFF_TS_MASK);
 		break;
 	case sw4Ts:  /*! Disable SW4 Timestamp.*/
-		status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_TIMESTAMP4_CTL, (Ts_Off << PCF2131_TSOFF_TS_SHIFT ), PCF2131_TSOFF_TS_MASK);
 		break;
 	default:
-		break;
+		return SENSOR_ERROR_INVALID_PARAM;
 	}
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
 	return SENSOR_ERROR_NONE;
@@ -999,6 +1361,12 @@ int32_t PCF2131_GetTs(pcf2131_sensorhandle_t *pSensorHandle, const registerreadl
 		return SENSOR_ERROR_INIT;
 	}
 
+	/*! The read list must not run past the timestamp structure.*/
+	if (!PCF2131_ReadListFits(pcf2131tsdata, PCF2131_TS_SIZE_BYTE))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
 	switch(tsnum)
 	{
 	case sw1Ts:  /*! Get Timestamp SW1 .*/
@@ -1014,17 +1382,22 @@ int32_t PCF2131_GetTs(pcf2131_sensorhandle_t *pSensorHandle, const registerreadl
 		status = PCF2131_ReadData(pSensorHandle, pcf2131tsdata, (uint8_t *)timestamp);
 		break;
 	default:
-		break;
+		return SENSOR_ERROR_INVALID_PARAM;
 	}
-	if (ARM_DRIVER_OK != status)
+	if (SENSOR_ERROR_NONE != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return status;
 	}
 
 	/*! after read convert BCD to Decimal */
 	timestamp->second = BcdToDecimal(timestamp->second & PCF2131_SECONDS_TS_MASK) ;
 	timestamp->minutes = BcdToDecimal(timestamp->minutes & PCF2131_MINUTES_TS_MASK) ;
-	PCF2131_12h_24h_Mode_Get(pSensorHandle, &mode12_24); /*! Update AM/PM */
+	/*! Update AM/PM */
+	status = PCF2131_12h_24h_Mode_Get(pSensorHandle, &mode12_24);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
 	if(mode12_24 ==  mode24H)
 	{
 		timestamp->hours = BcdToDecimal(timestamp->hours & PCF2131_HOURS_TS_MASK) ;
@@ -1062,18 +1435,28 @@ int32_t PCF2131_GetTime(pcf2131_sensorhandle_t *pSensorHandle, const registerrea
 		return SENSOR_ERROR_INIT;
 	}
 
+	/*! The read list must not run past the time structure.*/
+	if (!PCF2131_ReadListFits(pcf2131timedata, PCF2131_TIME_SIZE_BYTE))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
 	/*! Get time.*/
 	status = PCF2131_ReadData(pSensorHandle, pcf2131timedata, ( uint8_t *)time );
-	if (ARM_DRIVER_OK != status)
+	if (SENSOR_ERROR_NONE != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return status;
 	}
 
 	/*! after read convert BCD to Decimal */
 	time->second_100th = BcdToDecimal(time->second_100th);
 	time->second = BcdToDecimal(time->second & PCF2131_SECONDS_MASK) ;
 	time->minutes = BcdToDecimal(time->minutes & PCF2131_MINUTES_MASK) ;
-	PCF2131_12h_24h_Mode_Get(pSensorHandle, &mode12_24);
+	status = PCF2131_12h_24h_Mode_Get(pSensorHandle, &mode12_24);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
 	if(mode12_24 ==  mode24H)
 	{
 		time->hours = BcdToDecimal(time->hours & PCF2131_HOURS_MASK) ;
@@ -1113,27 +1496,27 @@ int32_t PCF2131_SetTime(pcf2131_sensorhandle_t *pSensorHandle, pcf2131_timedata_
 	}
 
 	/*! Set 100th Second.*/
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_100TH_SECOND, DecimaltoBcd(time->second_100th & PCF2131_SECONDS_100TH_MASK), PCF2131_SECONDS_100TH_MASK);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
 	/*! Set Second.*/
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_SECOND, DecimaltoBcd(time->second & PCF2131_SECONDS_MASK), PCF2131_SECONDS_MASK);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
 	/*! Set Minutes.*/
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_MINUTE, DecimaltoBcd(time->minutes & PCF2131_MINUTES_MASK ), PCF2131_MINUTES_MASK );
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
 	/*! Update AM/PM Bit.*/
@@ -1151,43 +1534,43 @@ int32_t PCF2131_SetTime(pcf2131_sensorhandle_t *pSensorHandle, pcf2131_timedata_
 		time->hours = DecimaltoBcd(time->hours & PCF2131_HOURS_MASK);
 
 	/*! Set Hour.*/
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_HOUR, time->hours , PCF2131_HOURS_MASK );
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
 	/*! Set Day.*/
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_DAY, DecimaltoBcd(time->days & PCF2131_DAYS_MASK) , PCF2131_DAYS_MASK);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
 	/*! Set WeekDay.*/
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_WEEKEND, DecimaltoBcd(time->weekdays &  PCF2131_WEEKDAYS_MASK ), PCF2131_WEEKDAYS_MASK);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
 	/*! Set Months.*/
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_MONTH, DecimaltoBcd(time->months & PCF2131_MONTHS_MASK) , PCF2131_MONTHS_MASK );
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
 	/*! Set Year.*/
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_YEAR, DecimaltoBcd(time->years & PCF2131_YEARS_MASK) , PCF2131_YEARS_MASK );
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
 	return SENSOR_ERROR_NONE;
@@ -1211,11 +1594,11 @@ int32_t PCF2131_Clear_AlarmInt(pcf2131_sensorhandle_t *pSensorHandle)
 	}
 
 	/*! Clear Alarm flag */
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_CTRL2, (uint8_t)(intClear << PCF2131_CTRL2_AF_SHIFT), PCF2131_CTRL2_AF_MASK);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
 	return SENSOR_ERROR_NONE;
@@ -1239,11 +1622,10 @@ int32_t PCF2131_Check_AlarmInt(pcf2131_sensorhandle_t *pSensorHandle, IntState *
 	}
 
 	/*! Get Alarm flag */
-	status = Register_SPI_Read(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
-			PCF2131_CTRL2, PCF2131_REG_SIZE_BYTE, (uint8_t *)&Ctrl2_Reg);
+	status = PCF2131_RegRead(pSensorHandle, PCF2131_CTRL2, (uint8_t *)&Ctrl2_Reg);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_READ;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_READ);
 	}
 
 	*pAlarmState = Ctrl2_Reg.b.af ;
@@ -1268,68 +1650,68 @@ int32_t PCF2131_AlarmInt_Enable(pcf2131_sensorhandle_t *pSensorHandle, IntSrc in
 		return SENSOR_ERROR_INIT;
 	}
 	/*! Enable/Disable Alarm */
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_CTRL2, (uint8_t)(intEnable << PCF2131_CTRL2_AIE_SHIFT), PCF2131_CTRL2_AIE_MASK);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 	switch(alarmtype)
 	{
 	case A_Seconds:
 		/*! Enable/Disable Second Alarm */
-		status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_SECOND_ALARM, (uint8_t)( 0 << PCF2131_AE_S_SHIFT), PCF2131_AE_S_MASK);
 		if (ARM_DRIVER_OK != status)
 		{
-			return SENSOR_ERROR_WRITE;
+			return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 		}
 	case A_Minute:
 		/*! Enable/Disable Minute Alarm */
-		status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_MINUTE_ALARM, (uint8_t)( 0 << PCF2131_AE_M_SHIFT), PCF2131_AE_M_MASK);
 		if (ARM_DRIVER_OK != status)
 		{
-			return SENSOR_ERROR_WRITE;
+			return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 		}
 	case A_Hour:
 		/*! Enable/Disable Hour Alarm */
-		status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_HOUR_ALARM, (uint8_t)( 0 << PCF2131_AE_H_SHIFT), PCF2131_AE_H_MASK);
 		if (ARM_DRIVER_OK != status)
 		{
-			return SENSOR_ERROR_WRITE;
+			return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 		}
 	case A_Day:
 		/*! Enable/Disable Day Alarm */
-		status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_DAY_ALARM, (uint8_t)( 0 << PCF2131_AE_D_SHIFT), PCF2131_AE_D_MASK);
 		if (ARM_DRIVER_OK != status)
 		{
-			return SENSOR_ERROR_WRITE;
+			return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 		}
 	case A_Weekday:
 		/*! Enable/Disable WeekDay Alarm */
-		status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_WEEKDAY_ALARM, (uint8_t)( 0 << PCF2131_AE_W_SHIFT), PCF2131_AE_W_MASK);
 		if (ARM_DRIVER_OK != status)
 		{
-			return SENSOR_ERROR_WRITE;
+			return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 		}
 	}
 	if( intsrc == IntA)   /*! clear Second Interrupt Mask on INTA */
 	{
-		status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_INT_A_MASK1,( INT_UNMASK << PCF2131_AIE_SHIFT), PCF2131_AIE_DIS_MASK);
 	}
 	else  /*! clear Second Interrupt Mask on INTB */
 	{
-		status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+		status = PCF2131_RegWrite(pSensorHandle,
 				PCF2131_INT_B_MASK1,( INT_UNMASK << PCF2131_AIE_SHIFT), PCF2131_AIE_DIS_MASK);
 	}
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 	return SENSOR_ERROR_NONE;
 }
@@ -1351,25 +1733,25 @@ int32_t PCF2131_AlarmInt_Disable(pcf2131_sensorhandle_t *pSensorHandle)
 	}
 
 	/*! Enable/Disable Alarm */
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_CTRL2, (uint8_t)(intDisable << PCF2131_CTRL2_AIE_SHIFT), PCF2131_CTRL2_AIE_MASK);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_INT_A_MASK1,( INT_MASK << PCF2131_AIE_SHIFT), PCF2131_AIE_DIS_MASK);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_INT_B_MASK1, (INT_MASK << PCF2131_AIE_SHIFT), PCF2131_AIE_DIS_MASK);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
 
@@ -1395,19 +1777,19 @@ int32_t PCF2131_SetAlarmTime(pcf2131_sensorhandle_t *pSensorHandle, pcf2131_alar
 	}
 
 	/*! Set Alarm Second.*/
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_SECOND_ALARM, DecimaltoBcd(alarmtime->second & PCF2131_SECONDS_ALARM_MASK), PCF2131_SECONDS_ALARM_MASK);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
 	/*! Set Alarm Minute.*/
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_MINUTE_ALARM, DecimaltoBcd(alarmtime->minutes & PCF2131_MINUTES_ALARM_MASK), PCF2131_MINUTES_ALARM_MASK);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
 	/*! Update AM/PM Bit.*/
@@ -1425,27 +1807,27 @@ int32_t PCF2131_SetAlarmTime(pcf2131_sensorhandle_t *pSensorHandle, pcf2131_alar
 		alarmtime->hours = DecimaltoBcd(alarmtime->hours & PCF2131_HOURS_MASK);
 
 	/*! Set Alarm Hours.*/
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_HOUR_ALARM, alarmtime->hours , PCF2131_HOURS_ALARM_MASK );
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
 	/*! Set Alarm Day.*/
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_DAY_ALARM, DecimaltoBcd(alarmtime->days & PCF2131_DAYS_ALARM_MASK) , PCF2131_DAYS_ALARM_MASK );
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
 	/*! Set Alarm WeekDay.*/
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_WEEKDAY_ALARM, DecimaltoBcd(alarmtime->weekdays & PCF2131_WEEKDAYS_ALARM_MASK) , PCF2131_WEEKDAYS_ALARM_MASK);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
 	return SENSOR_ERROR_NONE;
@@ -1468,17 +1850,27 @@ int32_t PCF2131_GetAlarmTime(pcf2131_sensorhandle_t *pSensorHandle, const regist
 		return SENSOR_ERROR_INIT;
 	}
 
+	/*! The read list must not run past the alarm structure.*/
+	if (!PCF2131_ReadListFits(pcf2131alarmdata, PCF2131_ALARM_TIME_SIZE_BYTE))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
 	/*! Get Alarm time.*/
 	status = PCF2131_ReadData(pSensorHandle, pcf2131alarmdata, ( uint8_t *)alarmtime);
-	if (ARM_DRIVER_OK != status)
+	if (SENSOR_ERROR_NONE != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return status;
 	}
 
 	/*! after read convert BCD to Decimal */
 	alarmtime->second = BcdToDecimal(alarmtime->second & PCF2131_SECONDS_ALARM_MASK) ;
 	alarmtime->minutes = BcdToDecimal(alarmtime->minutes & PCF2131_MINUTES_ALARM_MASK) ;
-	PCF2131_12h_24h_Mode_Get(pSensorHandle, &mode12_24);
+	status = PCF2131_12h_24h_Mode_Get(pSensorHandle, &mode12_24);
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
 	if(mode12_24 ==  mode24H)
 	{
 		alarmtime->hours = BcdToDecimal(alarmtime->hours & PCF2131_HOURS_ALARM_MASK) ;
@@ -1516,11 +1908,39 @@ int32_t PCF2131_Bat_SwitchOverTS_Enable(pcf2131_sensorhandle_t *pSensorHandle, I
 	}
 
 	/*! SwitchOver TimeStamp Enable/Disable */
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_CTRL3, (uint8_t)( intEnable << PCF2131_CTRL3_BTSE_SHIFT ), PCF2131_CTRL3_BTSE_MASK);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_Bat_SwitchOverTS(pcf2131_sensorhandle_t *pSensorHandle, BatSoTs is_enabled)
+{
+	int32_t status;
+
+	/*! Validate for the correct handle.*/
+	if (pSensorHandle == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/*! SwitchOver TimeStamp Enable/Disable */
+	status = PCF2131_RegWrite(pSensorHandle,
+			PCF2131_CTRL3, (uint8_t)(((is_enabled == SoTsEnable) ? intEnable : intDisable) << PCF2131_CTRL3_BTSE_SHIFT),
+			PCF2131_CTRL3_BTSE_MASK);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
 	return SENSOR_ERROR_NONE;
@@ -1543,11 +1963,11 @@ int32_t PCF2131_Bat_SwitchOverTS_Disable(pcf2131_sensorhandle_t *pSensorHandle)
 	}
 
 	/*! SwitchOver TimeStamp Enable/Disable */
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_CTRL3, (uint8_t)(intDisable << PCF2131_CTRL3_BTSE_SHIFT ), PCF2131_CTRL3_BTSE_MASK);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
 	return SENSOR_ERROR_NONE;
@@ -1570,11 +1990,11 @@ int32_t PCF2131_Clear_SwitchOverInt(pcf2131_sensorhandle_t *pSensorHandle)
 	}
 
 	/*! clear switchOver flag */
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_CTRL3, (uint8_t)(intClear << PCF2131_CTRL3_BF_SHIFT), PCF2131_CTRL3_BF_MASK);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 	return SENSOR_ERROR_NONE;
 }
@@ -1597,11 +2017,10 @@ int32_t PCF2131_Check_SwitchOverInt(pcf2131_sensorhandle_t *pSensorHandle, IntSt
 	}
 
 	/*! Get switchOver flag */
-	status = Register_SPI_Read(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
-			PCF2131_CTRL3, PCF2131_REG_SIZE_BYTE, (uint8_t *)&Ctrl3_Reg);
+	status = PCF2131_RegRead(pSensorHandle, PCF2131_CTRL3, (uint8_t *)&Ctrl3_Reg);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_READ;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_READ);
 	}
 
 	*pSoStatus = Ctrl3_Reg.b.bf;
@@ -1626,11 +2045,11 @@ int32_t PCF2131_Bat_SwitchOverInt(pcf2131_sensorhandle_t *pSensorHandle, IntStat
 	}
 
 	/*! SwitchOver Interrupt Enable/Disable */
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_CTRL3, (uint8_t)(((is_enabled == intEnable) ? intEnable : intDisable ) << PCF2131_CTRL3_BIE_SHIFT ), PCF2131_CTRL3_BIE_MASK);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
 	return SENSOR_ERROR_NONE;
@@ -1653,11 +2072,11 @@ int32_t PCF2131_Check_LowBatStatusEnable(pcf2131_sensorhandle_t *pSensorHandle)
 	}
 
 	/*!  */
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_CTRL2, (uint8_t)(0x00 << PCF2131_CTRL3_PWRMNG_SHIFT), PCF2131_CTRL3_PWRMNG_MASK);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 
 	return SENSOR_ERROR_NONE;
@@ -1681,11 +2100,10 @@ int32_t PCF2131_Check_LowBatStatus(pcf2131_sensorhandle_t *pSensorHandle, IntSta
 	}
 
 	/*! Get Low battery flag */
-	status = Register_SPI_Read(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
-			PCF2131_CTRL3, PCF2131_REG_SIZE_BYTE, (uint8_t *)&Ctrl3_Reg);
+	status = PCF2131_RegRead(pSensorHandle, PCF2131_CTRL3, (uint8_t *)&Ctrl3_Reg);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_READ;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_READ);
 	}
 	*pLowBatStatus = Ctrl3_Reg.b.blf;
 
@@ -1709,14 +2127,568 @@ int32_t PCF2131_LowBatInt(pcf2131_sensorhandle_t *pSensorHandle, LowBatInt is_en
 	}
 
 	/*! Low Bat Interrupt Enable/Disable */
-	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+	status = PCF2131_RegWrite(pSensorHandle,
 			PCF2131_CTRL3, (uint8_t)(((is_enabled == lbIntEnable) ? lbIntEnable : lbIntDisable) << PCF2131_CTRL3_BLIE_SHIFT ), PCF2131_CTRL3_BLIE_MASK);
 	if (ARM_DRIVER_OK != status)
 	{
-		return SENSOR_ERROR_WRITE;
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
 	}
 	return SENSOR_ERROR_NONE;
 }
 
+int32_t PCF2131_Watchdog_Config(pcf2131_sensorhandle_t *pSensorHandle, WdClkSrc clksrc, uint8_t period)
+{
+	int32_t status;
+	uint8_t wdCtl;
+
+	/*! Validate for the correct handle and watchdog period.*/
+	if ((pSensorHandle == NULL) || (period == 0))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/*! Keep the interrupt mode, it also applies to the minute/second interrupt */
+	status = PCF2131_RegRead(pSensorHandle, PCF2131_WATCHDOG_TIMER_CTL, &wdCtl);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_READ);
+	}
+
+	/*! Pre-format the control and kick values once, so enable/disable/kick never read the RTC. */
+	pSensorHandle->wdCtl = (uint8_t)(((clksrc << PCF2131_WD_CTL_TF_SHIFT) & PCF2131_WD_CTL_TF_MASK) | (wdCtl & PCF2131_WD_TI_TP_MASK));
+	pSensorHandle->wdKickValue = period;
+
+	/*! Watchdog source clock, watchdog disabled */
+	status = PCF2131_RegWrite(pSensorHandle,
+			PCF2131_WATCHDOG_TIMER_CTL, pSensorHandle->wdCtl, 0);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_Watchdog_Enable(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	int32_t status;
+	uint8_t wdReg[PCF2131_SPI_CMD_LEN + PCF2131_WD_SIZE_BYTE];
+
+	/*! Validate for the correct handle */
+	if (pSensorHandle == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized and watchdog is configured.*/
+	if ((pSensorHandle->isInitialized != true) || (pSensorHandle->wdKickValue == 0))
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/*! Set WD_CD and load the period in one burst (0x35, 0x36), sent in place behind the command */
+	wdReg[PCF2131_SPI_CMD_LEN] = pSensorHandle->wdCtl | PCF2131_WD_CTL_WD_CD_MASK;
+	wdReg[PCF2131_SPI_CMD_LEN + 1] = pSensorHandle->wdKickValue;
+	status = Register_SPI_BlockWriteInPlace(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo,
+			&pSensorHandle->slaveParams, PCF2131_WATCHDOG_TIMER_CTL, wdReg, PCF2131_WD_SIZE_BYTE);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_Watchdog_Disable(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	int32_t status;
+
+	/*! Validate for the correct handle */
+	if (pSensorHandle == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/*! Clear WD_CD, keep source clock and interrupt mode */
+	status = PCF2131_RegWrite(pSensorHandle,
+			PCF2131_WATCHDOG_TIMER_CTL, pSensorHandle->wdCtl, 0);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_Watchdog_Kick(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	int32_t status;
+
+	/*! Validate for the correct handle */
+	if (pSensorHandle == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized and watchdog is configured.*/
+	if ((pSensorHandle->isInitialized != true) || (pSensorHandle->wdKickValue == 0))
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/*! Reload the watchdog period, mask 0 so there is no read-modify-write */
+	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+			PCF2131_WATCHDOG_TIMER_VAL, pSensorHandle->wdKickValue, 0);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_Watchdog_Piggyback(pcf2131_sensorhandle_t *pSensorHandle, bool is_enabled)
+{
+	/*! Validate for the correct handle */
+	if (pSensorHandle == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized and watchdog is configured.*/
+	if ((pSensorHandle->isInitialized != true) || (pSensorHandle->wdKickValue == 0))
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	pSensorHandle->wdPiggyback = is_enabled;
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_WatchdogInt_Enable(pcf2131_sensorhandle_t *pSensorHandle, IntSrc intsrc)
+{
+	int32_t status;
+
+	/*! Validate for the correct handle */
+	if (pSensorHandle == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	if( intsrc == IntA)   /*! clear Watchdog Interrupt Mask on INTA */
+	{
+		status = PCF2131_RegWrite(pSensorHandle,
+				PCF2131_INT_A_MASK1, (INT_UNMASK << PCF2131_WD_CD_SHIFT), PCF2131_WD_CD_DIS_MASK);
+	}
+	else  /*! clear Watchdog Interrupt Mask on INTB */
+	{
+		status = PCF2131_RegWrite(pSensorHandle,
+				PCF2131_INT_B_MASK1, (INT_UNMASK << PCF2131_WD_CD_SHIFT), PCF2131_WD_CD_DIS_MASK);
+	}
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_WatchdogInt_Disable(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	int32_t status;
+
+	/*! Validate for the correct handle */
+	if (pSensorHandle == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	status = PCF2131_RegWrite(pSensorHandle,
+			PCF2131_INT_A_MASK1, (INT_MASK << PCF2131_WD_CD_SHIFT), PCF2131_WD_CD_DIS_MASK);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
+	}
+
+	status = PCF2131_RegWrite(pSensorHandle,
+			PCF2131_INT_B_MASK1, (INT_MASK << PCF2131_WD_CD_SHIFT), PCF2131_WD_CD_DIS_MASK);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_Check_WatchdogInt(pcf2131_sensorhandle_t *pSensorHandle, IntState *pWdState)
+{
+	int32_t status;
+	PCF2131_CTRL_2 Ctrl2_Reg;
+
+	/*! Validate for the correct handle and Watchdog status read variable.*/
+	if ((pSensorHandle == NULL) || (pWdState == NULL))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/*! Get Watchdog flag */
+	status = PCF2131_RegRead(pSensorHandle, PCF2131_CTRL2, (uint8_t *)&Ctrl2_Reg);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_READ);
+	}
+
+	*pWdState = Ctrl2_Reg.b.wdtf;
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_ClkOut_Set(pcf2131_sensorhandle_t *pSensorHandle, ClkOutFreq freq)
+{
+	int32_t status;
+
+	/*! Validate for the correct handle */
+	if (pSensorHandle == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/*! Select CLKOUT frequency, keep temperature measurement period */
+	status = PCF2131_RegWrite(pSensorHandle,
+			PCF2131_CLKOUT_CTL, (uint8_t)(freq << PCF2131_CLKOUT_COF_SHIFT), PCF2131_CLKOUT_COF_MASK);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
+/* Wait for the next rising edge on CLKOUT, a missing CLKOUT fails after maxPolls pin reads. */
+static int32_t PCF2131_WaitClkOutEdge(GENERIC_DRIVER_GPIO *pGPIODriver, void *pClkOutPin, uint32_t maxPolls)
+{
+	uint32_t polls = 0;
+
+	while (pGPIODriver->read_pin(pClkOutPin))
+	{
+		if (++polls > maxPolls)
+		{
+			return SENSOR_ERROR_READ;
+		}
+	}
+	while (!pGPIODriver->read_pin(pClkOutPin))
+	{
+		if (++polls > maxPolls)
+		{
+			return SENSOR_ERROR_READ;
+		}
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_ClkOut_Calibrate(pcf2131_sensorhandle_t *pSensorHandle, void *pClkOutPin, uint32_t periods, int32_t *pPpmError)
+{
+	int32_t status, restore;
+	int32_t start;
+	uint32_t edge;
+	uint32_t maxPolls;
+	int64_t measured = 0, expected;
+	uint8_t clkoutCtl;
+	GENERIC_DRIVER_GPIO *pGPIODriver = &Driver_GPIO_KSDK;
+
+	/*! Validate for the correct handle, CLKOUT pin, period count and error read variable.*/
+	if ((pSensorHandle == NULL) || (pClkOutPin == NULL) || (pPpmError == NULL) ||
+			(periods == 0) || (periods > PCF2131_CLKOUT_CAL_MAX_EDGES))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/*! Save CLKOUT_ctl and switch CLKOUT to the calibration frequency, bypassing an open transaction */
+	status = PCF2131_RegRead(pSensorHandle, PCF2131_CLKOUT_CTL, &clkoutCtl);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_READ);
+	}
+	status = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+			PCF2131_CLKOUT_CTL, (uint8_t)((clkoutCtl & ~PCF2131_CLKOUT_COF_MASK) | (clkout1024Hz << PCF2131_CLKOUT_COF_SHIFT)), 0);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
+	}
+
+	pGPIODriver->pin_init(pClkOutPin, GPIO_DIRECTION_IN, NULL, NULL, NULL);
+	maxPolls = CLOCK_GetFreq(kCLOCK_CoreSysClk) / PCF2131_CLKOUT_CAL_FREQ;
+
+	/*! The first rising edge starts the capture, every following one closes a period */
+	status = PCF2131_WaitClkOutEdge(pGPIODriver, pClkOutPin, maxPolls);
+	if (SENSOR_ERROR_NONE == status)
+	{
+		BOARD_SystickStart(&start);
+		for (edge = 0; (edge < periods) && (SENSOR_ERROR_NONE == status); edge++)
+		{
+			status = PCF2131_WaitClkOutEdge(pGPIODriver, pClkOutPin, maxPolls);
+		}
+		measured = BOARD_SystickElapsedTicks(&start);
+	}
+
+	/*! Restore CLKOUT_ctl, a failure counts as any other bus error */
+	restore = Register_SPI_Write(pSensorHandle->pCommDrv, &pSensorHandle->deviceInfo, &pSensorHandle->slaveParams,
+			PCF2131_CLKOUT_CTL, clkoutCtl, 0);
+	if (ARM_DRIVER_OK != restore)
+	{
+		return PCF2131_BUS_STATUS(restore, SENSOR_ERROR_WRITE);
+	}
+	if (SENSOR_ERROR_NONE != status)
+	{
+		return status;
+	}
+
+	/*! ppm error of the core clock against the TCXO, feed it to the SysTick conversions */
+	expected = ((int64_t)CLOCK_GetFreq(kCLOCK_CoreSysClk) * periods) / PCF2131_CLKOUT_CAL_FREQ;
+	*pPpmError = (int32_t)(((measured - expected) * 1000000) / expected);
+	BOARD_SystickSetClockCorrection(*pPpmError);
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_ExtTest_Enable(pcf2131_sensorhandle_t *pSensorHandle, void *pClkPin, const pcf2131_extclk_t *pClock)
+{
+	int32_t status;
+	GENERIC_DRIVER_GPIO *pGPIODriver = &Driver_GPIO_KSDK;
+
+	/*! Validate for the correct handle and clock output.*/
+	if ((pSensorHandle == NULL) || ((pClkPin == NULL) && (pClock == NULL)))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/*! CLKOUT turns into an input first, so the pin is never driven from both sides */
+	status = PCF2131_RegWrite(pSensorHandle,
+			PCF2131_CTRL1, PCF2131_CTRL1_EXT_TEST_MASK, PCF2131_CTRL1_EXT_TEST_MASK);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
+	}
+
+	if (pClock != NULL)
+	{
+		pClock->start();
+		pSensorHandle->pExtClock = pClock;
+		return SENSOR_ERROR_NONE;
+	}
+	pGPIODriver->pin_init(pClkPin, GPIO_DIRECTION_OUT, NULL, NULL, NULL);
+	pGPIODriver->clr_pin(pClkPin);
+	pSensorHandle->pExtClkPin = pClkPin;
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_ExtTest_Clock(pcf2131_sensorhandle_t *pSensorHandle, uint32_t seconds, uint32_t multiple, uint32_t *pAchieved)
+{
+	uint64_t start, next, halfPeriod, elapsed;
+	uint64_t edges = (uint64_t)seconds * PCF2131_EXT_TEST_EDGES_PER_SECOND;
+	uint64_t edge;
+	uint32_t coreFreq = BOARD_SystickGetCoreFreq();
+	int32_t result = 0;
+	GENERIC_DRIVER_GPIO *pGPIODriver = &Driver_GPIO_KSDK;
+
+	/*! Validate for the correct handle, second count and acceleration.*/
+	if ((pSensorHandle == NULL) || (seconds == 0) || (seconds > UINT32_MAX / PCF2131_EXT_TEST_EDGES_PER_SECOND) ||
+			(multiple == 0) || (multiple > PCF2131_EXT_TEST_MAX_MULTIPLE))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized and in external clock test mode.*/
+	if ((pSensorHandle->isInitialized != true) ||
+			((pSensorHandle->pExtClkPin == NULL) && (pSensorHandle->pExtClock == NULL)))
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/*! Half a CLKOUT period at the target rate, in SysTick counts */
+	halfPeriod = (uint64_t)coreFreq / (2U * PCF2131_EXT_TEST_EDGES_PER_SECOND * multiple);
+	start = BOARD_SystickGetTicks();
+	next = start;
+	if (pSensorHandle->pExtClock != NULL)
+	{
+		/*! The timer paces the edges in hardware */
+		result = pSensorHandle->pExtClock->clock(PCF2131_EXT_TEST_EDGES_PER_SECOND * multiple, (uint32_t)edges);
+	}
+	else
+	{
+		for (edge = 0; edge < edges; edge++)
+		{
+			next += halfPeriod;
+			while (BOARD_SystickGetTicks() < next)
+			{
+			}
+			pGPIODriver->set_pin(pSensorHandle->pExtClkPin);
+			next += halfPeriod;
+			while (BOARD_SystickGetTicks() < next)
+			{
+			}
+			pGPIODriver->clr_pin(pSensorHandle->pExtClkPin);
+		}
+	}
+	elapsed = BOARD_SystickGetTicks() - start;
+	if (result != 0)
+	{
+		return (result == -1) ? SENSOR_ERROR_INVALID_PARAM : SENSOR_ERROR_WRITE;
+	}
+
+	if (pAchieved)
+	{
+		/*! RTC time clocked over real time taken */
+		*pAchieved = elapsed ? (uint32_t)(((uint64_t)seconds * coreFreq + elapsed / 2) / elapsed) : multiple;
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_ExtTest_Disable(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	int32_t status;
+	GENERIC_DRIVER_GPIO *pGPIODriver = &Driver_GPIO_KSDK;
+
+	/*! Validate for the correct handle */
+	if (pSensorHandle == NULL)
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/*! Release the output before CLKOUT can turn back into an output */
+	if (pSensorHandle->pExtClock)
+	{
+		pSensorHandle->pExtClock->stop();
+		pSensorHandle->pExtClock = NULL;
+	}
+	if (pSensorHandle->pExtClkPin)
+	{
+		pGPIODriver->pin_init(pSensorHandle->pExtClkPin, GPIO_DIRECTION_IN, NULL, NULL, NULL);
+		pSensorHandle->pExtClkPin = NULL;
+	}
+
+	status = PCF2131_RegWrite(pSensorHandle,
+			PCF2131_CTRL1, 0, PCF2131_CTRL1_EXT_TEST_MASK);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_AgingOffset_Set(pcf2131_sensorhandle_t *pSensorHandle, uint8_t code)
+{
+	int32_t status;
+
+	/*! Validate for the correct handle and aging offset code.*/
+	if ((pSensorHandle == NULL) || (code > PCF2131_AGING_OFFSET_MAX))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/*! Write aging offset, mask 0 so there is no read-modify-write */
+	status = PCF2131_RegWrite(pSensorHandle,
+			PCF2131_AGING_OFFSET, (uint8_t)(code << PCF2131_AGING_OFFSET_AO_SHIFT), 0);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_WRITE);
+	}
+
+	return SENSOR_ERROR_NONE;
+}
+
+int32_t PCF2131_AgingOffset_Get(pcf2131_sensorhandle_t *pSensorHandle, uint8_t *pCode)
+{
+	int32_t status;
+	PCF2131_AGING_OFFSET_REG agingReg;
+
+	/*! Validate for the correct handle and aging offset read variable.*/
+	if ((pSensorHandle == NULL) || (pCode == NULL))
+	{
+		return SENSOR_ERROR_INVALID_PARAM;
+	}
+
+	/*! Check whether sensor handle is initialized before triggering sensor reset.*/
+	if (pSensorHandle->isInitialized != true)
+	{
+		return SENSOR_ERROR_INIT;
+	}
+
+	/*! Get aging offset */
+	status = PCF2131_RegRead(pSensorHandle, PCF2131_AGING_OFFSET, (uint8_t *)&agingReg);
+	if (ARM_DRIVER_OK != status)
+	{
+		return PCF2131_BUS_STATUS(status, SENSOR_ERROR_READ);
+	}
+
+	*pCode = agingReg.b.ao;
+
+	return SENSOR_ERROR_NONE;
+}
 
 #endif
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file pcf2131_timepub.h
+ * @brief The pcf2131_timepub.h file describes the PCF2131 published time interface.
+ */
+
+#ifndef PCF2131_TIMEPUB_H_
+#define PCF2131_TIMEPUB_H_
+
+/* Standard C Includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "pcf2131_drv.h"
+
+/*! @brief This structure holds the last published RTC time, guarded by a sequence count.*/
+typedef struct
+{
+	volatile uint32_t seq;             /*!< Odd while an update is in progress, 0 before the first one.*/
+	pcf2131_timedata_t time;           /*!< Decoded time.*/
+	int64_t epoch_ms;                  /*!< Time in milliseconds since 2000-01-01 00:00:00.*/
+} pcf2131_timepub_t;
+
+/*******************************************************************************
+ * APIs
+ ******************************************************************************/
+
+/*! @brief       Initializes a time publication.
+ *  @details     Readers get no time until the first update.
+ *  @param[in]   pPub  				Pointer to time publication.
+ *  @constraints None
+ *  @reentrant   No
+ */
+void PCF2131_TimePub_Init(pcf2131_timepub_t *pPub);
+
+/*! @brief       Publishes a decoded time.
+ *  @details     For an updater that already holds the time. The copy runs with interrupts masked, so a
+ *               reader interrupting it on the same core never waits, readers on another core retry.
+ *  @param[in]   pPub  				Pointer to time publication.
+ *  @param[in]   time  				Pointer to decoded time.
+ *  @constraints There must be a single updater.
+ *  @reentrant   No
+ */
+void PCF2131_TimePub_Publish(pcf2131_timepub_t *pPub, const pcf2131_timedata_t *time);
+
+/*! @brief       Reads the PCF2131 time and publishes it.
+ *  @details     Call it from the single updater, on the seconds interrupt or periodically.
+ *  @param[in]   pSensorHandle  	Pointer to sensor handle structure.
+ *  @param[in]   pcf2131timedata    Pointer to the list of registers read operations for time data.
+ *  @param[in]   pPub  				Pointer to time publication.
+ *  @constraints This can be called any number of times only after PCF2131_Initialize().
+ *				 Application has to ensure that previous instances of these APIs have exited before invocation
+ *  @reentrant   No
+ *  @return      ::PCF2131_TimePub_Update() returns the status.
+ */
+int32_t PCF2131_TimePub_Update(pcf2131_sensorhandle_t *pSensorHandle, const registerreadlist_t *pcf2131timedata,
+		pcf2131_timepub_t *pPub);
+
+/*! @brief       Reads the published time.
+ *  @details     Lock free and without bus access, a copy torn by a concurrent update is retried.
+ *  @param[in]   pPub  				Pointer to time publication.
+ *  @param[out]  time  				Decoded time, NULL if not needed.
+ *  @param[out]  pEpoch_ms  		Time in milliseconds since 2000-01-01 00:00:00, NULL if not needed.
+ *  @constraints None, it can be called from any task, interrupt or core.
+ *  @reentrant   Yes
+ *  @return      ::PCF2131_TimePub_Read() returns false if no time was published yet.
+ */
+bool PCF2131_TimePub_Read(const pcf2131_timepub_t *pPub, pcf2131_timedata_t *time, int64_t *pEpoch_ms);
+
+#endif /* PCF2131_TIMEPUB_H_ */
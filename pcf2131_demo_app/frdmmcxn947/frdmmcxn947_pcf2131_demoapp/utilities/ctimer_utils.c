@@ -0,0 +1,117 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file  ctimer_utils.c
+ * @brief Clocks a counted number of edges on a CTIMER match output in PWM mode.
+ *         MR3 sets the period and resets the count, the selected match register puts the rising edge
+ *         half way through it. The CPU counts the periods on the MR3 flag and arms stop on MR3 within
+ *         the last period, so the timer itself ends the run.
+*/
+
+#include "issdk_hal.h"
+#include "fsl_clock.h"
+#include "fsl_port.h"
+#include "fsl_reset.h"
+#include "ctimer_utils.h"
+
+#ifdef BOARD_EXT_CLK_CTIMER
+
+// Periods are counted in runs of at most 1 ms with the interrupts masked.
+#define CTIMER_CLOCK_RUNS_PER_S 1000U
+
+// Function to start the clock output.
+void BOARD_CtimerClockStart(void)
+{
+    CTIMER_Type *base = BOARD_EXT_CLK_CTIMER;
+
+    BOARD_EXT_CLK_CTIMER_INIT();
+
+    // Held in reset the PWM output stays low until the first run.
+    base->TCR                            = CTIMER_TCR_CRST_MASK;
+    base->CTCR                           = 0U;
+    base->PR                             = 0U;
+    base->MCR                            = CTIMER_MCR_MR3R_MASK;
+    base->MR[3]                          = 2U;
+    base->MR[BOARD_EXT_CLK_CTIMER_MATCH] = 1U;
+    base->EMR                            = 0U;
+    base->PWMC                           = 1UL << BOARD_EXT_CLK_CTIMER_MATCH;
+    base->IR                             = base->IR;
+}
+
+// Function to clock a number of edges.
+int32_t BOARD_CtimerClockRun(uint32_t freq, uint32_t edges)
+{
+    CTIMER_Type *base = BOARD_EXT_CLK_CTIMER;
+    uint32_t clock    = BOARD_EXT_CLK_CTIMER_FREQ;
+    uint32_t period, run, count, i, primask;
+    int32_t result = 0;
+
+    // A period needs at least one low and one high timer clock.
+    if ((freq == 0U) || (freq > clock / 2U))
+    {
+        return -1;
+    }
+    period                               = (clock + freq / 2U) / freq;
+    base->MR[3]                          = period - 1U;
+    base->MR[BOARD_EXT_CLK_CTIMER_MATCH] = period / 2U;
+    run                                  = (freq + CTIMER_CLOCK_RUNS_PER_S - 1U) / CTIMER_CLOCK_RUNS_PER_S;
+
+    while ((edges > 0U) && (result == 0))
+    {
+        count = (edges < run) ? edges : run;
+        edges -= count;
+
+        primask   = DisableGlobalIRQ();
+        base->IR  = CTIMER_IR_MR3INT_MASK;
+        base->MCR = CTIMER_MCR_MR3R_MASK | ((count == 1U) ? CTIMER_MCR_MR3S_MASK : 0U);
+        base->TCR = CTIMER_TCR_CEN_MASK;
+        for (i = 1U; i <= count; i++)
+        {
+            while ((base->IR & CTIMER_IR_MR3INT_MASK) == 0U)
+            {
+            }
+            base->IR = CTIMER_IR_MR3INT_MASK;
+            if (i == count - 1U)
+            {
+                // The last period has begun, the timer stops at its end.
+                base->MCR |= CTIMER_MCR_MR3S_MASK;
+            }
+            // Half a period late a whole period could pass unseen.
+            if ((i < count) && (base->TC >= period / 2U))
+            {
+                result = -2;
+                break;
+            }
+        }
+        // Still running means the stop was armed too late.
+        if ((base->TCR & CTIMER_TCR_CEN_MASK) != 0U)
+        {
+            result = -2;
+        }
+        // Reset drops the output low for the pause between runs.
+        base->TCR = CTIMER_TCR_CRST_MASK;
+        EnableGlobalIRQ(primask);
+    }
+
+    return result;
+}
+
+// Function to stop the clock output.
+void BOARD_CtimerClockStop(void)
+{
+    CTIMER_Type *base = BOARD_EXT_CLK_CTIMER;
+
+    base->TCR  = CTIMER_TCR_CRST_MASK;
+    base->PWMC = 0U;
+    base->MCR  = 0U;
+    base->IR   = base->IR;
+
+    BOARD_EXT_CLK_CTIMER_DEINIT();
+}
+
+#endif // BOARD_EXT_CLK_CTIMER
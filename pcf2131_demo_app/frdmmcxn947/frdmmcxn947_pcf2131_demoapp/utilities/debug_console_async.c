@@ -0,0 +1,189 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file debug_console_async.c
+ * @brief Asynchronous transmit path of the debug console, a ring drained by the LPUART TX-empty interrupt.
+ */
+
+#include <stdarg.h>
+#include <string.h>
+#include "fsl_common.h"
+#include "fsl_lpuart.h"
+#include "fsl_str.h"
+#include "board.h"
+#include "debug_console_async.h"
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static LPUART_Type *s_asyncBase = NULL;
+static lpuart_handle_t s_asyncHandle;
+static uint8_t s_asyncRing[DEBUG_CONSOLE_ASYNC_BUFFER_LEN];
+static volatile uint32_t s_asyncHead = 0; /* Bytes queued, advanced by the producers. */
+static volatile uint32_t s_asyncTail = 0; /* Bytes sent, advanced by the TX interrupt. */
+static volatile uint32_t s_asyncSending = 0; /* Bytes handed to the LPUART driver. */
+static debug_console_async_stats_t s_asyncStats;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/* Hands the next contiguous run of the ring to the driver, interrupts are masked by the caller. */
+static void DbgConsole_AsyncKick(void)
+{
+    lpuart_transfer_t xfer;
+    uint32_t start, length;
+
+    if ((s_asyncSending != 0U) || (s_asyncHead == s_asyncTail))
+    {
+        return;
+    }
+
+    start  = s_asyncTail & (DEBUG_CONSOLE_ASYNC_BUFFER_LEN - 1U);
+    length = s_asyncHead - s_asyncTail;
+    if ((start + length) > DEBUG_CONSOLE_ASYNC_BUFFER_LEN)
+    {
+        length = DEBUG_CONSOLE_ASYNC_BUFFER_LEN - start;
+    }
+
+    xfer.txData    = &s_asyncRing[start];
+    xfer.dataSize  = length;
+    s_asyncSending = length;
+    if (kStatus_Success != LPUART_TransferSendNonBlocking(s_asyncBase, &s_asyncHandle, &xfer))
+    {
+        s_asyncSending = 0U;
+    }
+}
+
+static void DbgConsole_AsyncCallback(LPUART_Type *base, lpuart_handle_t *handle, status_t status, void *userData)
+{
+    if (kStatus_LPUART_TxIdle == status)
+    {
+        s_asyncTail += s_asyncSending;
+        s_asyncSending = 0U;
+        DbgConsole_AsyncKick();
+    }
+}
+
+int DbgConsole_AsyncWrite(const uint8_t *pData, uint32_t length)
+{
+    uint32_t regPrimask, head, start, first, fill;
+
+    if (s_asyncBase == NULL)
+    {
+        /* Not started yet, fall back to the blocking path. */
+        for (start = 0U; start < length; start++)
+        {
+            (void)DbgConsole_Putchar(pData[start]);
+        }
+        return (int)length;
+    }
+
+    regPrimask = DisableGlobalIRQ();
+    while ((DEBUG_CONSOLE_ASYNC_BUFFER_LEN - (s_asyncHead - s_asyncTail)) < length)
+    {
+        /* Only a thread with interrupts enabled can wait for the TX interrupt to make space. */
+        if ((__get_IPSR() != 0U) || (regPrimask != 0U) || (length > DEBUG_CONSOLE_ASYNC_BUFFER_LEN))
+        {
+            s_asyncStats.dropped += length;
+            s_asyncStats.drops++;
+            EnableGlobalIRQ(regPrimask);
+            return 0;
+        }
+        EnableGlobalIRQ(regPrimask);
+        regPrimask = DisableGlobalIRQ();
+    }
+
+    head  = s_asyncHead;
+    start = head & (DEBUG_CONSOLE_ASYNC_BUFFER_LEN - 1U);
+    first = DEBUG_CONSOLE_ASYNC_BUFFER_LEN - start;
+    if (first > length)
+    {
+        first = length;
+    }
+    (void)memcpy(&s_asyncRing[start], pData, first);
+    (void)memcpy(&s_asyncRing[0], &pData[first], length - first);
+    s_asyncHead = head + length;
+
+    s_asyncStats.queued += length;
+    fill = s_asyncHead - s_asyncTail;
+    if (fill > s_asyncStats.highWater)
+    {
+        s_asyncStats.highWater = fill;
+    }
+    DbgConsole_AsyncKick();
+    EnableGlobalIRQ(regPrimask);
+
+    return (int)length;
+}
+
+/* Collects the formatted characters into the message buffer, truncating at its end. */
+static void DbgConsole_AsyncPrintCallback(char *buf, int32_t *indicator, char dbgVal, int len)
+{
+    while ((len-- > 0) && (*indicator < (int32_t)DEBUG_CONSOLE_ASYNC_MAX_LOG_LEN))
+    {
+        buf[*indicator] = dbgVal;
+        (*indicator)++;
+    }
+}
+
+status_t DbgConsole_AsyncInit(void)
+{
+    (void)memset(&s_asyncStats, 0, sizeof(s_asyncStats));
+    LPUART_TransferCreateHandle((LPUART_Type *)BOARD_DEBUG_UART_BASEADDR, &s_asyncHandle, DbgConsole_AsyncCallback,
+                                NULL);
+    s_asyncBase = (LPUART_Type *)BOARD_DEBUG_UART_BASEADDR;
+
+    return kStatus_Success;
+}
+
+int DbgConsole_AsyncPrintf(const char *fmt_s, ...)
+{
+    char buf[DEBUG_CONSOLE_ASYNC_MAX_LOG_LEN];
+    int32_t length;
+    va_list ap;
+
+    /* Formatting runs on the caller stack, only the copy into the ring is serialized. */
+    va_start(ap, fmt_s);
+    length = StrFormatPrintf(fmt_s, ap, buf, DbgConsole_AsyncPrintCallback);
+    va_end(ap);
+
+    return DbgConsole_AsyncWrite((const uint8_t *)buf, (uint32_t)length);
+}
+
+int DbgConsole_AsyncPutchar(int ch)
+{
+    uint8_t data = (uint8_t)ch;
+
+    return DbgConsole_AsyncWrite(&data, 1U);
+}
+
+void DbgConsole_AsyncFlush(void)
+{
+    while ((s_asyncBase != NULL) && ((s_asyncHead != s_asyncTail) || (s_asyncSending != 0U)))
+    {
+    }
+    if (s_asyncBase != NULL)
+    {
+        while (0U == (LPUART_GetStatusFlags(s_asyncBase) & (uint32_t)kLPUART_TransmissionCompleteFlag))
+        {
+        }
+    }
+}
+
+bool DbgConsole_AsyncRxReady(void)
+{
+    return 0U != (LPUART_GetStatusFlags((LPUART_Type *)BOARD_DEBUG_UART_BASEADDR) & (uint32_t)kLPUART_RxDataRegFullFlag);
+}
+
+void DbgConsole_AsyncGetStats(debug_console_async_stats_t *pStats)
+{
+    uint32_t regPrimask = DisableGlobalIRQ();
+
+    *pStats = s_asyncStats;
+    EnableGlobalIRQ(regPrimask);
+}
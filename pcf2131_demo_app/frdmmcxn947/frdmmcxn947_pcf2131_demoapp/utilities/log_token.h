@@ -0,0 +1,73 @@
+/*
+ * Copyright 2024 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file log_token.h
+ * @brief Tokenized deferred logging.
+
+    LOG_TOKEN() call sites send the address of their format string as a token, a systick time stamp
+    and the raw argument words, the text is rebuilt off target from the ELF. The format strings are
+    collected in the .log_fmt section. Link it as a non-loaded section, for GNU ld
+        .log_fmt (INFO) : { KEEP(*(.log_fmt)) }
+    so the strings stay in the ELF but not in flash, a host decoder maps each token to the string at
+    that address in .log_fmt.
+
+    Record on the wire, words little endian:
+        0xFE, word count, token, time stamp, argument words
+    0xFE never occurs in console text, so records and PRINTF output can share the line.
+
+    Arguments are integer conversions (%d, %u, %x, %c), at most LOG_TOKEN_MAX_ARGS. A %s argument
+    must point into the ELF (a string literal). With LOG_TOKEN_ENABLE at 0, LOG_TOKEN() is PRINTF().
+*/
+
+#ifndef __LOG_TOKEN_H__
+#define __LOG_TOKEN_H__
+
+#include <stdint.h>
+#include "debug_console_async.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Set to 1 to send LOG_TOKEN() records instead of text. */
+#ifndef LOG_TOKEN_ENABLE
+#define LOG_TOKEN_ENABLE (0U)
+#endif
+
+/*! @brief Most argument words per record. */
+#define LOG_TOKEN_MAX_ARGS (6U)
+
+/*! @brief Record start byte. */
+#define LOG_TOKEN_SYNC (0xFEU)
+
+#if (LOG_TOKEN_ENABLE)
+#define LOG_TOKEN(fmt, ...)                                                                                 \
+    do                                                                                                      \
+    {                                                                                                       \
+        static const char s_logTokenFmt[] __attribute__((section(".log_fmt"), used, aligned(4))) = fmt;     \
+        const uint32_t logTokenArgs[] = {0U, ##__VA_ARGS__};                                                \
+        Log_TokenWrite((uint32_t)s_logTokenFmt, &logTokenArgs[1],                                           \
+                       (sizeof(logTokenArgs) / sizeof(logTokenArgs[0])) - 1U);                               \
+    } while (0)
+#else
+#define LOG_TOKEN(fmt, ...) PRINTF(fmt, ##__VA_ARGS__)
+#endif
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+/*! @brief       Queues one record, use LOG_TOKEN() instead.
+ *  @param[in]   token  Address of the format string.
+ *  @param[in]   pArgs  Argument words.
+ *  @param[in]   nArgs  Number of argument words, extra ones are not sent.
+ *  @return      void.
+ *  @constraints None, it can be called from interrupt handlers.
+ *  @reeentrant  Yes
+ */
+void Log_TokenWrite(uint32_t token, const uint32_t *pArgs, uint32_t nArgs);
+
+#endif /* __LOG_TOKEN_H__ */
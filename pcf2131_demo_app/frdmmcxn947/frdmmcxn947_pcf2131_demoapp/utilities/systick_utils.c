@@ -21,6 +21,7 @@
 
 uint32_t g_ovf_stamp;
 volatile uint32_t g_ovf_counter = 0;
+int32_t g_clk_corr_ppm = 0;
 
 #ifndef SDK_OS_FREE_RTOS
 // SDK specific SysTick Interrupt Handler
@@ -28,6 +29,12 @@ void SysTick_Handler(void)
 {
     g_ovf_counter += 1;
 }
+#else
+// FreeRTOS owns the SysTick, count its reloads from the tick hook instead.
+void BOARD_SystickTickHook(void)
+{
+    g_ovf_counter += 1;
+}
 #endif
 
 // ARM-core specific function to enable systicks.
@@ -54,11 +61,49 @@ int32_t BOARD_SystickElapsedTicks(int32_t *pStart)
 
     // Subtract the stored start ticks and check for wraparound down through zero.
     elapsed = *pStart - (SYST_CVR & 0x00FFFFFF);
-    elapsed += SYST_RVR * (g_ovf_counter - g_ovf_stamp);
+    elapsed += (SYST_RVR + 1) * (g_ovf_counter - g_ovf_stamp);
 
     return elapsed;
 }
 
+// ARM-core specific function to read a free running 64 bit systick count.
+uint64_t BOARD_SystickGetTicks(void)
+{
+    uint32_t ovf, ticks;
+    bool pending;
+
+    // Re-read when the overflow interrupt fired between the reads.
+    do
+    {
+        ovf     = g_ovf_counter;
+        ticks   = SYST_CVR & 0x00FFFFFF;
+        pending = (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0;
+    } while (ovf != g_ovf_counter);
+
+    // The counter reloaded but the overflow interrupt is still pending or masked: count the wrap here.
+    // A tick value in the lower half was read before the wrap.
+    if (pending && (ticks > (SYST_RVR >> 1)))
+    {
+        ovf += 1;
+    }
+
+    return (uint64_t)ovf * (SYST_RVR + 1) + (SYST_RVR - ticks);
+}
+
+// Core clock frequency with the measured error applied.
+uint32_t BOARD_SystickGetCoreFreq(void)
+{
+    int64_t systemCoreClock = CLOCK_GetFreq(kCLOCK_CoreSysClk);
+
+    return (uint32_t)(systemCoreClock + (systemCoreClock * g_clk_corr_ppm) / 1000000);
+}
+
+// Store the measured core clock error in ppm.
+void BOARD_SystickSetClockCorrection(int32_t ppm)
+{
+    g_clk_corr_ppm = ppm;
+}
+
 // ARM-core specific function to compute the elapsed time in micro seconds.
 uint32_t BOARD_SystickElapsedTime_us(int32_t *pStart)
 {
@@ -66,7 +111,7 @@ uint32_t BOARD_SystickElapsedTime_us(int32_t *pStart)
     uint32_t systemCoreClock;
 
     elapsed = BOARD_SystickElapsedTicks(pStart);
-    systemCoreClock = CLOCK_GetFreq(kCLOCK_CoreSysClk);
+    systemCoreClock = BOARD_SystickGetCoreFreq();
 
     time_us = COUNT_TO_USEC(elapsed, systemCoreClock);
 
@@ -80,7 +125,7 @@ uint32_t BOARD_SystickElapsedTime_us(int32_t *pStart)
 void BOARD_DELAY_ms(uint32_t delay_ms)
 {
     int32_t start, elapsed;
-    uint32_t systemCoreClock = CLOCK_GetFreq(kCLOCK_CoreSysClk);
+    uint32_t systemCoreClock = BOARD_SystickGetCoreFreq();
 
     BOARD_SystickStart(&start);
     do // Loop for requested number of ms.
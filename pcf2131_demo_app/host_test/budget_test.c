@@ -0,0 +1,180 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file budget_test.c
+ * @brief Host test of the bus transaction budgets (pcf2131_budget.c): every API of the budget table runs on a
+ *        fresh handle over a configured register map, the transfers and bytes reaching the simulated bus must
+ *        be within its budget and match the counters of the register I/O layer. Then a bus error and a stuck bus
+ *        at each transfer of each API in turn: the API must report it and the bus must serve the next read.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mock_bus.h"
+#include "pcf2131.h"
+#include "pcf2131_budget.h"
+
+#define CHECK(cond)                                                              \
+	do                                                                           \
+	{                                                                            \
+		if (!(cond))                                                             \
+		{                                                                        \
+			printf("budget_test: %s:%d: %s\n", __FILE__, __LINE__, #cond);       \
+			s_failures++;                                                        \
+		}                                                                        \
+	} while (0)
+
+static pcf2131_sensorhandle_t s_rtc;
+static uint32_t s_failures;
+
+/* A configured RTC: interrupts routed, an alarm, CLKOUT, timestamp and aging settings, a valid time. */
+static void configure(void)
+{
+	Mock_Bus_Reset();
+	g_Mock_Regs[PCF2131_CTRL1] = PCF2131_CTRL1_SI_MASK;
+	g_Mock_Regs[PCF2131_CTRL2] = PCF2131_CTRL2_AIE_MASK | PCF2131_CTRL2_AF_MASK;
+	g_Mock_Regs[PCF2131_CTRL4] = PCF2131_CTRL4_TSF1_MASK;
+	g_Mock_Regs[PCF2131_CTRL5] = PCF2131_CTRL5_TSIE1_MASK;
+	g_Mock_Regs[PCF2131_SECOND] = 0x45;
+	g_Mock_Regs[PCF2131_MINUTE] = 0x30;
+	g_Mock_Regs[PCF2131_HOUR] = 0x12;
+	g_Mock_Regs[PCF2131_DAY] = 0x15;
+	g_Mock_Regs[PCF2131_WEEKEND] = 0x06;
+	g_Mock_Regs[PCF2131_MONTH] = 0x06;
+	g_Mock_Regs[PCF2131_YEAR] = 0x24;
+	g_Mock_Regs[PCF2131_SECOND_ALARM] = 0x30;
+	g_Mock_Regs[PCF2131_MINUTE_ALARM] = 0x80;
+	g_Mock_Regs[PCF2131_HOUR_ALARM] = 0x80;
+	g_Mock_Regs[PCF2131_DAY_ALARM] = 0x80;
+	g_Mock_Regs[PCF2131_WEEKDAY_ALARM] = 0x80;
+	g_Mock_Regs[PCF2131_CLKOUT_CTL] = clkout4096Hz;
+	g_Mock_Regs[PCF2131_TIMESTAMP2_CTL] = PCF2131_TSOFF_TS_MASK;
+	g_Mock_Regs[PCF2131_AGING_OFFSET] = 0x05;
+	g_Mock_Regs[PCF2131_INT_A_MASK1] = 0x2E;
+	g_Mock_Regs[PCF2131_INT_A_MASK2] = 0x0C;
+	g_Mock_Regs[PCF2131_INT_B_MASK1] = 0x3F;
+	g_Mock_Regs[PCF2131_INT_B_MASK2] = 0x0F;
+}
+
+/* Runs an API on a fresh handle over the configured map, the transfer after `after` others failing with
+ * fault (none for ARM_DRIVER_OK). The bus traffic of the API alone goes to pCount, that of the register I/O
+ * layer to pLayer. */
+static int32_t run_api(const pcf2131_budget_t *pBudget, uint32_t after, int32_t fault, registerIoCount_t *pCount,
+					   registerIoCount_t *pLayer)
+{
+	registerIoCount_t before;
+	int32_t status;
+
+	configure();
+	CHECK(PCF2131_Budget_Init(&s_rtc) == SENSOR_ERROR_NONE);
+	if (pBudget->setup)
+	{
+		CHECK(pBudget->setup(&s_rtc) == SENSOR_ERROR_NONE);
+	}
+	if (ARM_DRIVER_OK != fault)
+	{
+		Mock_Bus_Fail(after, 1, fault);
+	}
+
+	Mock_Bus_GetCount(&before);
+	PCF2131_ClearBusCount(&s_rtc);
+	status = pBudget->run(&s_rtc);
+	Mock_Bus_GetCount(pCount);
+	PCF2131_GetBusCount(&s_rtc, pLayer);
+	pCount->transfers -= before.transfers;
+	pCount->bytes -= before.bytes;
+
+	return status;
+}
+
+static void test_budgets(void)
+{
+	const pcf2131_budget_t *pBudget;
+	registerIoCount_t count, layer;
+	uint32_t i, over = 0, under = 0, failed = 0;
+	int32_t status;
+
+	for (i = 0; i < g_Pcf2131_BudgetCount; i++)
+	{
+		pBudget = &g_Pcf2131_Budgets[i];
+		status = run_api(pBudget, 0, ARM_DRIVER_OK, &count, &layer);
+		if (SENSOR_ERROR_NONE != status)
+		{
+			printf("budget_test: %s: FAILED, status %d\n", pBudget->name, status);
+			failed++;
+		}
+		CHECK((layer.transfers == count.transfers) && (layer.bytes == count.bytes));
+		if ((count.transfers > pBudget->transfers) || (count.bytes > pBudget->bytes))
+		{
+			over++;
+		}
+		else if ((count.transfers < pBudget->transfers) || (count.bytes < pBudget->bytes))
+		{
+			under++;
+		}
+		else
+		{
+			continue;
+		}
+		printf("budget_test: %s: %u/%u transfers, %u/%u bytes %s\n", pBudget->name, count.transfers,
+			   pBudget->transfers, count.bytes, pBudget->bytes,
+			   ((count.transfers > pBudget->transfers) || (count.bytes > pBudget->bytes)) ? "OVER BUDGET" :
+			   "under budget");
+	}
+	CHECK((over == 0) && (failed == 0));
+	printf("budget_test: %u APIs, %u over budget, %u under budget, %u failed\n", g_Pcf2131_BudgetCount, over, under,
+		   failed);
+}
+
+/* A fault at every transfer of every API in turn. The API must return an error and a fresh handle must
+ * read the RTC afterwards: a bus error leaves the bus idle, a stuck bus has to be recovered by the layer. */
+static void test_faults(int32_t fault, const char *pName)
+{
+	const pcf2131_budget_t *pBudget;
+	registerIoCount_t clean, count, layer;
+	uint8_t buffer[PCF2131_BUF_HEADROOM + 1];
+	uint32_t i, after, faults = 0, ignored = 0, unusable = 0;
+
+	for (i = 0; i < g_Pcf2131_BudgetCount; i++)
+	{
+		pBudget = &g_Pcf2131_Budgets[i];
+		run_api(pBudget, 0, ARM_DRIVER_OK, &clean, &layer);
+		for (after = 0; after < clean.transfers; after++, faults++)
+		{
+			if (SENSOR_ERROR_NONE == run_api(pBudget, after, fault, &count, &layer))
+			{
+				printf("budget_test: %s: %s at transfer %u of %u not reported\n", pBudget->name, pName, after + 1,
+					   clean.transfers);
+				ignored++;
+			}
+			CHECK(!Mock_Bus_FaultPending());
+
+			CHECK(PCF2131_Budget_Init(&s_rtc) == SENSOR_ERROR_NONE);
+			if (SENSOR_ERROR_NONE != PCF2131_ReadInPlace(&s_rtc, PCF2131_CTRL1, 1, buffer))
+			{
+				printf("budget_test: %s: %s at transfer %u of %u left the bus unusable\n", pBudget->name, pName,
+					   after + 1, clean.transfers);
+				unusable++;
+			}
+		}
+	}
+	CHECK((ignored == 0) && (unusable == 0));
+	printf("budget_test: %s at each of %u transfers: %u not reported by the API, %u left the bus unusable\n",
+		   pName, faults, ignored, unusable);
+}
+
+int main(void)
+{
+	test_budgets();
+	test_faults(ARM_DRIVER_ERROR, "bus error");
+	test_faults(ARM_DRIVER_ERROR_TIMEOUT, "stuck bus");
+
+	printf("budget_test: %s\n", s_failures ? "FAIL" : "PASS");
+	return s_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,206 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file buserror_test.c
+ * @brief Host test of the bus error reporting of the driver on the simulated register map: a failed read is
+ *        reported as SENSOR_ERROR_READ and counted once towards the I2C speed fallback, so
+ *        PCF2131_I2C_FALLBACK_ERRORS - 1 failed reads leave the negotiated speed alone and one more steps it
+ *        down. A failed CLKOUT restore after a calibration is a counted write error. Selectors out of range
+ *        are refused with SENSOR_ERROR_INVALID_PARAM without a transfer. On I2C the LPI2C FIFO block write is
+ *        refused without a transfer while the master is disabled, busy, the bus is busy or an error is pending.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mock_bus.h"
+#include "pcf2131.h"
+#include "pcf2131_drv.h"
+#include "pcf2131_link.h"
+#include "fsl_lpi2c.h"
+
+#define CHECK(cond)                                                              \
+	do                                                                           \
+	{                                                                            \
+		if (!(cond))                                                             \
+		{                                                                        \
+			printf("buserror_test: %s:%d: %s\n", __FILE__, __LINE__, #cond);     \
+			s_failures++;                                                        \
+		}                                                                        \
+	} while (0)
+
+static pcf2131_sensorhandle_t s_rtc;
+static uint32_t s_failures;
+
+static const registerreadlist_t s_timeList[] = {{.readFrom = PCF2131_100TH_SECOND, .numBytes = 8},
+		__END_READ_DATA__};
+static const registerreadlist_t s_tsList[] = {{.readFrom = PCF2131_TIMESTAMP1_SECONDS, .numBytes = 6},
+		__END_READ_DATA__};
+static const registerreadlist_t s_alarmList[] = {{.readFrom = PCF2131_SECOND_ALARM, .numBytes = 5},
+		__END_READ_DATA__};
+
+/* Fails the first transfer of the next call with a bus error. */
+static void fail_next(void)
+{
+	Mock_Bus_Fail(0, 1, ARM_DRIVER_ERROR);
+}
+
+/* Every reader reports a failed read as a read error. */
+static void test_read_errors(void)
+{
+	pcf2131_timedata_t time;
+	pcf2131_timestamp_t ts;
+	pcf2131_alarmdata_t alarm;
+	S100thMode s100;
+
+	fail_next();
+	CHECK(PCF2131_GetTime(&s_rtc, s_timeList, &time) == SENSOR_ERROR_READ);
+	fail_next();
+	CHECK(PCF2131_GetTs(&s_rtc, s_tsList, sw1Ts, &ts) == SENSOR_ERROR_READ);
+	fail_next();
+	CHECK(PCF2131_GetAlarmTime(&s_rtc, s_alarmList, &alarm) == SENSOR_ERROR_READ);
+	fail_next();
+	CHECK(PCF2131_Sec100TH_Mode_Get(&s_rtc, &s100) == SENSOR_ERROR_READ);
+	CHECK(!Mock_Bus_FaultPending());
+}
+
+#if (I2C_ENABLE)
+/* A failed read counts once: the speed holds below PCF2131_I2C_FALLBACK_ERRORS and steps down at it. */
+static void test_fallback(void)
+{
+	pcf2131_timedata_t time;
+	pcf2131_alarmdata_t alarm;
+	uint8_t speed;
+
+	/* Negotiation needs a plausible time block */
+	g_Mock_Regs[PCF2131_DAY] = 0x01;
+	g_Mock_Regs[PCF2131_MONTH] = 0x01;
+	CHECK(PCF2131_I2C_Negotiate(&s_rtc, 4, NULL) == SENSOR_ERROR_NONE);
+	speed = s_rtc.busSpeed;
+	CHECK(speed > ARM_I2C_BUS_SPEED_STANDARD);
+
+	fail_next();
+	CHECK(PCF2131_GetTime(&s_rtc, s_timeList, &time) == SENSOR_ERROR_READ);
+	fail_next();
+	CHECK(PCF2131_GetAlarmTime(&s_rtc, s_alarmList, &alarm) == SENSOR_ERROR_READ);
+	CHECK(s_rtc.busErrors == PCF2131_I2C_FALLBACK_ERRORS - 1);
+	CHECK(s_rtc.busSpeed == speed);
+
+	fail_next();
+	CHECK(PCF2131_GetTime(&s_rtc, s_timeList, &time) == SENSOR_ERROR_READ);
+	CHECK((s_rtc.busSpeed == speed - 1) && (s_rtc.busErrors == 0));
+}
+#endif
+
+/* The restore of CLKOUT_ctl closes a calibration, its failure is a write error counted like any other. */
+static void test_calibrate(void)
+{
+	static uint32_t clkOutPin;
+	registerIoCount_t count;
+	int32_t ppm;
+
+	Mock_Bus_Reset();
+	g_Mock_Regs[PCF2131_CLKOUT_CTL] = clkout4096Hz;
+	CHECK(PCF2131_ClkOut_Calibrate(&s_rtc, &clkOutPin, 4, &ppm) == SENSOR_ERROR_NONE);
+	Mock_Bus_GetCount(&count);
+
+	Mock_Bus_Reset();
+	g_Mock_Regs[PCF2131_CLKOUT_CTL] = clkout4096Hz;
+	Mock_Bus_Fail(count.transfers - 1, 1, ARM_DRIVER_ERROR);
+#if (I2C_ENABLE)
+	s_rtc.busSpeed = ARM_I2C_BUS_SPEED_FAST;
+	s_rtc.busErrors = 0;
+#endif
+	CHECK(PCF2131_ClkOut_Calibrate(&s_rtc, &clkOutPin, 4, &ppm) == SENSOR_ERROR_WRITE);
+	CHECK(!Mock_Bus_FaultPending());
+#if (I2C_ENABLE)
+	CHECK(s_rtc.busErrors == 1);
+#endif
+}
+
+/* Selectors out of range fail without touching the bus. */
+static void test_invalid(void)
+{
+	registerIoCount_t before, after;
+	IntState state;
+
+	Mock_Bus_GetCount(&before);
+	CHECK(PCF2131_SwRst(&s_rtc, (SwRst)99) == SENSOR_ERROR_INVALID_PARAM);
+	CHECK(PCF2131_TimeStamp_On(&s_rtc, (SwTsNum)99) == SENSOR_ERROR_INVALID_PARAM);
+	CHECK(PCF2131_TimeStamp_Off(&s_rtc, (SwTsNum)99) == SENSOR_ERROR_INVALID_PARAM);
+	CHECK(PCF2131_Clear_SW_TsInt(&s_rtc, (SwTsNum)99) == SENSOR_ERROR_INVALID_PARAM);
+	Mock_Bus_GetCount(&after);
+	CHECK(after.transfers == before.transfers);
+	CHECK(PCF2131_Check_SW_TsInt(&s_rtc, (SwTsNum)99, &state) == SENSOR_ERROR_INVALID_PARAM);
+}
+
+#if (I2C_ENABLE)
+/* The FIFO block write only takes an idle, enabled master without pending errors, and leaves the flags alone. */
+static void test_fifo_owner(void)
+{
+	static const struct
+	{
+		uint32_t mcrClear; /* MCR bits cleared. */
+		uint32_t msrSet;   /* MSR flags set. */
+	} states[] = {
+		{LPI2C_MCR_MEN_MASK, 0},
+		{0, LPI2C_MSR_MBF_MASK},
+		{0, LPI2C_MSR_BBF_MASK},
+		{0, LPI2C_MSR_NDF_MASK},
+		{0, LPI2C_MSR_ALF_MASK},
+		{0, LPI2C_MSR_FEF_MASK},
+		{0, LPI2C_MSR_PLTF_MASK},
+	};
+	uint8_t buffer[PCF2131_BUF_HEADROOM + 1] = {0};
+	registerIoCount_t before, after;
+	uint32_t i;
+
+	for (i = 0; i < sizeof(states) / sizeof(states[0]); i++)
+	{
+		Mock_Bus_Reset();
+		g_Mock_LPI2C0.MCR &= ~states[i].mcrClear;
+		g_Mock_LPI2C0.MSR |= states[i].msrSet;
+		buffer[PCF2131_BUF_HEADROOM] = 0x5A;
+		Mock_Bus_GetCount(&before);
+		CHECK(PCF2131_WriteInPlace(&s_rtc, PCF2131_CTRL1, 1, buffer) != SENSOR_ERROR_NONE);
+		Mock_Bus_GetCount(&after);
+		CHECK(after.transfers == before.transfers);
+		CHECK(g_Mock_Regs[PCF2131_CTRL1] == 0);
+		CHECK((g_Mock_LPI2C0.MSR & states[i].msrSet) == states[i].msrSet);
+	}
+
+	/* Once the owner is done the write goes out */
+	Mock_Bus_Reset();
+	CHECK(PCF2131_WriteInPlace(&s_rtc, PCF2131_CTRL1, 1, buffer) == SENSOR_ERROR_NONE);
+	CHECK(g_Mock_Regs[PCF2131_CTRL1] == 0x5A);
+}
+#endif
+
+int main(void)
+{
+	Mock_Bus_Reset();
+#if (I2C_ENABLE)
+	CHECK(PCF2131_Initialize(&s_rtc, &Mock_I2C_Driver, 0, 0x53) == SENSOR_ERROR_NONE);
+#else
+	static uint32_t slaveSelect;
+	CHECK(PCF2131_Initialize(&s_rtc, &Mock_SPI_Driver, 0, &slaveSelect) == SENSOR_ERROR_NONE);
+#endif
+
+	test_read_errors();
+#if (I2C_ENABLE)
+	test_fallback();
+#endif
+	test_calibrate();
+	test_invalid();
+#if (I2C_ENABLE)
+	test_fifo_owner();
+#endif
+
+	printf("buserror_test: %s\n", s_failures ? "FAIL" : "PASS");
+	return s_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
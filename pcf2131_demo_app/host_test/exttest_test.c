@@ -0,0 +1,141 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file exttest_test.c
+ * @brief Host test of the external clock test mode with a timer output (PCF2131_ExtTest_Enable()) on the
+ *        simulated register map. A stand-in timer records its calls: it must only drive its output while
+ *        EXT_TEST makes CLKOUT an input, get PCF2131_EXT_TEST_EDGES_PER_SECOND edges per RTC second at the
+ *        multiple of their rate, and its failures must reach the caller.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mock_bus.h"
+#include "pcf2131.h"
+#include "pcf2131_drv.h"
+
+#define CHECK(cond)                                                              \
+	do                                                                           \
+	{                                                                            \
+		if (!(cond))                                                             \
+		{                                                                        \
+			printf("exttest_test: %s:%d: %s\n", __FILE__, __LINE__, #cond);      \
+			s_failures++;                                                        \
+		}                                                                        \
+	} while (0)
+
+static pcf2131_sensorhandle_t s_rtc;
+static uint32_t s_failures;
+
+/* Calls of the stand-in timer, with the EXT_TEST bit seen by each. */
+static uint32_t s_starts, s_clocks, s_stops, s_driveErrors;
+static uint32_t s_freq, s_edges;
+static int32_t s_result;
+
+static bool exttest_mode(void)
+{
+	return (g_Mock_Regs[PCF2131_CTRL1] & PCF2131_CTRL1_EXT_TEST_MASK) != 0;
+}
+
+static void timer_start(void)
+{
+	s_starts++;
+	s_driveErrors += !exttest_mode();
+}
+
+static int32_t timer_clock(uint32_t freq, uint32_t edges)
+{
+	s_clocks++;
+	s_driveErrors += !exttest_mode();
+	s_freq = freq;
+	s_edges = edges;
+	return s_result;
+}
+
+static void timer_stop(void)
+{
+	s_stops++;
+	s_driveErrors += !exttest_mode();
+}
+
+static const pcf2131_extclk_t s_timer = {timer_start, timer_clock, timer_stop};
+
+static void test_clock(void)
+{
+	uint32_t achieved = 0;
+
+	CHECK(PCF2131_ExtTest_Enable(&s_rtc, NULL, NULL) == SENSOR_ERROR_INVALID_PARAM);
+	CHECK(PCF2131_ExtTest_Clock(&s_rtc, 1, 1, &achieved) == SENSOR_ERROR_INIT);
+
+	CHECK(PCF2131_ExtTest_Enable(&s_rtc, NULL, &s_timer) == SENSOR_ERROR_NONE);
+	CHECK(exttest_mode() && (s_starts == 1));
+
+	CHECK(PCF2131_ExtTest_Clock(&s_rtc, 3, 100, &achieved) == SENSOR_ERROR_NONE);
+	CHECK((s_clocks == 1) && (s_freq == 100 * PCF2131_EXT_TEST_EDGES_PER_SECOND));
+	CHECK(s_edges == 3 * PCF2131_EXT_TEST_EDGES_PER_SECOND);
+	CHECK(PCF2131_ExtTest_Clock(&s_rtc, 60, PCF2131_EXT_TEST_MAX_MULTIPLE, NULL) == SENSOR_ERROR_NONE);
+	CHECK(s_freq == PCF2131_EXT_TEST_MAX_MULTIPLE * PCF2131_EXT_TEST_EDGES_PER_SECOND);
+
+	/* Out of range arguments never reach the timer */
+	CHECK(PCF2131_ExtTest_Clock(&s_rtc, UINT32_MAX / PCF2131_EXT_TEST_EDGES_PER_SECOND + 1, 1, NULL) ==
+			SENSOR_ERROR_INVALID_PARAM);
+	CHECK(PCF2131_ExtTest_Clock(&s_rtc, 1, PCF2131_EXT_TEST_MAX_MULTIPLE + 1, NULL) == SENSOR_ERROR_INVALID_PARAM);
+	CHECK(s_clocks == 2);
+
+	/* A rate the timer cannot produce, then edges it may have lost */
+	s_result = -1;
+	CHECK(PCF2131_ExtTest_Clock(&s_rtc, 1, 1, &achieved) == SENSOR_ERROR_INVALID_PARAM);
+	s_result = -2;
+	CHECK(PCF2131_ExtTest_Clock(&s_rtc, 1, 1, &achieved) == SENSOR_ERROR_WRITE);
+	s_result = 0;
+
+	CHECK(PCF2131_ExtTest_Disable(&s_rtc) == SENSOR_ERROR_NONE);
+	CHECK(!exttest_mode() && (s_stops == 1));
+	CHECK(PCF2131_ExtTest_Clock(&s_rtc, 1, 1, &achieved) == SENSOR_ERROR_INIT);
+	CHECK(PCF2131_ExtTest_Disable(&s_rtc) == SENSOR_ERROR_NONE);
+	CHECK(s_stops == 1);
+}
+
+static void test_faults(void)
+{
+	uint32_t starts = s_starts;
+
+	/* CLKOUT stays an output when EXT_TEST cannot be set, so the timer must not start */
+	Mock_Bus_Fail(0, 1, ARM_DRIVER_ERROR);
+	CHECK(PCF2131_ExtTest_Enable(&s_rtc, NULL, &s_timer) != SENSOR_ERROR_NONE);
+	CHECK(!exttest_mode() && (s_starts == starts));
+	CHECK(PCF2131_ExtTest_Clock(&s_rtc, 1, 1, NULL) == SENSOR_ERROR_INIT);
+
+	/* The timer is released before clearing EXT_TEST, also when the clear fails */
+	CHECK(PCF2131_ExtTest_Enable(&s_rtc, NULL, &s_timer) == SENSOR_ERROR_NONE);
+	Mock_Bus_Fail(0, 1, ARM_DRIVER_ERROR);
+	CHECK(PCF2131_ExtTest_Disable(&s_rtc) != SENSOR_ERROR_NONE);
+	CHECK(s_stops == 2);
+	CHECK(PCF2131_ExtTest_Disable(&s_rtc) == SENSOR_ERROR_NONE);
+	CHECK(!exttest_mode() && (s_stops == 2));
+}
+
+int main(void)
+{
+	Mock_Bus_Reset();
+#if (I2C_ENABLE)
+	CHECK(PCF2131_Initialize(&s_rtc, &Mock_I2C_Driver, 0, 0x53) == SENSOR_ERROR_NONE);
+#else
+	static uint32_t slaveSelect;
+	CHECK(PCF2131_Initialize(&s_rtc, &Mock_SPI_Driver, 0, &slaveSelect) == SENSOR_ERROR_NONE);
+#endif
+
+	test_clock();
+	test_faults();
+	CHECK(s_driveErrors == 0);
+
+	printf("exttest_test: %u timer starts, %u runs, %u stops\n", s_starts, s_clocks, s_stops);
+	printf("exttest_test: %s\n", s_failures ? "FAIL" : "PASS");
+	return s_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,236 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file faultbench_test.c
+ * @brief Fault recovery benchmark of the driver and its register I/O on the simulated bus: back to back time
+ *        reads under each fault profile of mock_bus.h, reporting the good reads per second and the time from
+ *        the first failed read of an outage to the next good one. Time is systick time, a stuck transfer
+ *        costs its deadline. A read is good when it succeeds and returns the time in the registers, a read
+ *        that succeeds with another time is silent corruption. NACK, abort and stuck faults must all be
+ *        reported and the bus must serve a read after every profile. On I2C a stuck FIFO block write on a
+ *        device without a timeout has to end as well.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fsl_common.h"
+#include "mock_bus.h"
+#include "pcf2131.h"
+#include "pcf2131_drv.h"
+#include "systick_utils.h"
+
+#define CHECK(cond)                                                              \
+	do                                                                           \
+	{                                                                            \
+		if (!(cond))                                                             \
+		{                                                                        \
+			printf("faultbench_test: %s:%d: %s\n", __FILE__, __LINE__, #cond);   \
+			s_failures++;                                                        \
+		}                                                                        \
+	} while (0)
+
+/* Time reads per profile. */
+#define FAULTBENCH_READS (2000U)
+
+typedef struct
+{
+	uint32_t goodOps;       /* Reads returning the time in the registers. */
+	uint32_t silentOps;     /* Reads succeeding with another time. */
+	uint32_t goodOpsPerSec; /* Good reads per second of systick time. */
+	uint32_t outages;       /* Runs of failed reads ended by a good one. */
+	uint32_t avgRecover_us; /* Average time from the first failed read of an outage to the next good one. */
+	uint32_t maxRecover_us; /* Longest outage. */
+} faultbench_result_t;
+
+static const mock_bus_profile_t s_profiles[] = {
+	{"none", {0, 0, 0, 0, 0}},
+	{"nack", {50, 0, 0, 0, 0}},
+	{"abort", {0, 50, 0, 0, 0}},
+	{"stuck", {0, 0, 20, 0, 0}},
+	{"corrupt", {0, 0, 0, 50, 0}},
+	{"spurious", {0, 0, 0, 0, 20}},
+	{"mixed", {10, 10, 5, 10, 5}},
+};
+
+static const char *const s_faultNames[MOCK_BUS_FAULT_COUNT] = {"nack", "abort", "stuck", "corrupt", "spurious"};
+
+static const registerreadlist_t s_timeList[] = {{.readFrom = PCF2131_100TH_SECOND, .numBytes = PCF2131_TIME_SIZE_BYTE},
+		__END_READ_DATA__};
+
+static pcf2131_sensorhandle_t s_rtc;
+static pcf2131_timedata_t s_reference;
+static uint32_t s_failures;
+
+static bool same_time(const pcf2131_timedata_t *pA, const pcf2131_timedata_t *pB)
+{
+	return (pA->second_100th == pB->second_100th) && (pA->second == pB->second) && (pA->minutes == pB->minutes) &&
+		   (pA->hours == pB->hours) && (pA->days == pB->days) && (pA->weekdays == pB->weekdays) &&
+		   (pA->months == pB->months) && (pA->years == pB->years) && (pA->ampm == pB->ampm);
+}
+
+/* A stopped clock, every good read returns the same time. */
+static void configure(void)
+{
+	Mock_Bus_Reset();
+	g_Mock_Regs[PCF2131_100TH_SECOND] = 0x42;
+	g_Mock_Regs[PCF2131_SECOND] = 0x45;
+	g_Mock_Regs[PCF2131_MINUTE] = 0x30;
+	g_Mock_Regs[PCF2131_HOUR] = 0x12;
+	g_Mock_Regs[PCF2131_DAY] = 0x15;
+	g_Mock_Regs[PCF2131_WEEKEND] = 0x06;
+	g_Mock_Regs[PCF2131_MONTH] = 0x06;
+	g_Mock_Regs[PCF2131_YEAR] = 0x24;
+}
+
+static void run_profile(const mock_bus_profile_t *pProfile, uint32_t seed, faultbench_result_t *pResult,
+						mock_bus_stats_t *pStats)
+{
+	pcf2131_timedata_t time;
+	uint32_t coreFreq = BOARD_SystickGetCoreFreq();
+	uint64_t start, now, outageStart = 0, totalRecover_us = 0;
+	uint32_t i, recover_us;
+	int32_t status;
+	bool good, inOutage = false;
+#if (I2C_ENABLE)
+	uint8_t busSpeed = s_rtc.busSpeed;
+#endif
+
+	memset(pResult, 0, sizeof(*pResult));
+	Mock_Bus_SetProfile(pProfile, seed);
+	start = BOARD_SystickGetTicks();
+	for (i = 0; i < FAULTBENCH_READS; i++)
+	{
+		now = BOARD_SystickGetTicks();
+		memset(&time, 0, sizeof(time));
+		status = PCF2131_GetTime(&s_rtc, s_timeList, &time);
+		good = (SENSOR_ERROR_NONE == status) && same_time(&time, &s_reference);
+		if ((SENSOR_ERROR_NONE == status) && !good)
+		{
+			pResult->silentOps++;
+		}
+
+		if (good)
+		{
+			pResult->goodOps++;
+			if (inOutage)
+			{
+				recover_us = (uint32_t)COUNT_TO_USEC(BOARD_SystickGetTicks() - outageStart, coreFreq);
+				totalRecover_us += recover_us;
+				pResult->outages++;
+				if (recover_us > pResult->maxRecover_us)
+				{
+					pResult->maxRecover_us = recover_us;
+				}
+				inOutage = false;
+			}
+		}
+		else if (!inOutage)
+		{
+			outageStart = now;
+			inOutage = true;
+		}
+	}
+	now = BOARD_SystickGetTicks() - start;
+	Mock_Bus_GetStats(pStats);
+	Mock_Bus_SetProfile(NULL, 0);
+
+	pResult->goodOpsPerSec = now ? (uint32_t)((uint64_t)pResult->goodOps * coreFreq / now) : 0;
+	pResult->avgRecover_us = pResult->outages ? (uint32_t)(totalRecover_us / pResult->outages) : 0;
+
+#if (I2C_ENABLE)
+	/* Undo the speed fallback triggered by the injected errors */
+	if ((s_rtc.busSpeed != busSpeed) && (SENSOR_ERROR_NONE == PCF2131_SetBusSpeed(&s_rtc, busSpeed)))
+	{
+		s_rtc.busSpeed = busSpeed;
+		s_rtc.busErrors = 0;
+		s_rtc.busClean = 0;
+	}
+#endif
+}
+
+static void test_profiles(void)
+{
+	faultbench_result_t result;
+	mock_bus_stats_t stats;
+	pcf2131_timedata_t time;
+	uint32_t i;
+	uint8_t fault;
+
+	configure();
+	CHECK(PCF2131_GetTime(&s_rtc, s_timeList, &s_reference) == SENSOR_ERROR_NONE);
+
+	for (i = 0; i < sizeof(s_profiles) / sizeof(s_profiles[0]); i++)
+	{
+		run_profile(&s_profiles[i], i + 1, &result, &stats);
+
+		printf("faultbench_test: %-8s %4u/%u good reads, %8u good reads/s, %3u silent, %3u outages, recovery avg %u us"
+			   " max %u us\n", s_profiles[i].name, result.goodOps, FAULTBENCH_READS, result.goodOpsPerSec,
+			   result.silentOps, result.outages, result.avgRecover_us, result.maxRecover_us);
+		printf("faultbench_test: %-8s %u transfers,", s_profiles[i].name, stats.transfers);
+		for (fault = 0; fault < MOCK_BUS_FAULT_COUNT; fault++)
+		{
+			printf(" %s %u", s_faultNames[fault], stats.injected[fault]);
+			/* Every fault of the profile shows up in the run */
+			CHECK((s_profiles[i].rate[fault] == 0) == (stats.injected[fault] == 0));
+		}
+		printf("\n");
+
+		/* Only a corrupt byte or an early completion may get past the layer unreported */
+		if ((s_profiles[i].rate[MOCK_BUS_FAULT_CORRUPT] == 0) && (s_profiles[i].rate[MOCK_BUS_FAULT_SPURIOUS] == 0))
+		{
+			CHECK(result.silentOps == 0);
+		}
+		if (0 == stats.injected[MOCK_BUS_FAULT_NACK] + stats.injected[MOCK_BUS_FAULT_ABORT] +
+					 stats.injected[MOCK_BUS_FAULT_STUCK] + stats.injected[MOCK_BUS_FAULT_CORRUPT] +
+					 stats.injected[MOCK_BUS_FAULT_SPURIOUS])
+		{
+			CHECK((result.goodOps == FAULTBENCH_READS) && (result.outages == 0));
+		}
+		CHECK(result.goodOps > 0);
+
+		/* The bus serves a read once the faults stop */
+		CHECK(PCF2131_GetTime(&s_rtc, s_timeList, &time) == SENSOR_ERROR_NONE);
+		CHECK(same_time(&time, &s_reference));
+	}
+}
+
+#if (I2C_ENABLE)
+/* A FIFO block write whose STOP never shows up ends even without a device deadline. */
+static void test_untimed_write(void)
+{
+	uint8_t buffer[PCF2131_BUF_HEADROOM + 1] = {0};
+
+	configure();
+	PCF2131_SetTimeout(&s_rtc, 0);
+	Mock_Bus_Fail(0, 1, ARM_DRIVER_ERROR_TIMEOUT);
+	CHECK(PCF2131_WriteInPlace(&s_rtc, PCF2131_CTRL1, 1, buffer) == SENSOR_ERROR_TIMEOUT);
+	CHECK(!Mock_Bus_FaultPending());
+	CHECK(PCF2131_ReadInPlace(&s_rtc, PCF2131_CTRL1, 1, buffer) == SENSOR_ERROR_NONE);
+	PCF2131_SetTimeout(&s_rtc, PCF2131_BUS_TIMEOUT_US);
+}
+#endif
+
+int main(void)
+{
+	Mock_Bus_Reset();
+#if (I2C_ENABLE)
+	CHECK(PCF2131_Initialize(&s_rtc, &Mock_I2C_Driver, 0, 0x53) == SENSOR_ERROR_NONE);
+#else
+	static uint32_t slaveSelect;
+	CHECK(PCF2131_Initialize(&s_rtc, &Mock_SPI_Driver, 0, &slaveSelect) == SENSOR_ERROR_NONE);
+#endif
+
+	test_profiles();
+#if (I2C_ENABLE)
+	test_untimed_write();
+#endif
+
+	printf("faultbench_test: %s\n", s_failures ? "FAIL" : "PASS");
+	return s_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
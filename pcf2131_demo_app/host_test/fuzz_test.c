@@ -0,0 +1,881 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file fuzz_test.c
+ * @brief Fuzz test of the register list walkers (interfaces/sensor_io_i2c.c, sensor_io_spi.c) and of the BCD
+ *        time decode of the driver (PCF2131_GetTime(), PCF2131_GetAlarmTime(), PCF2131_GetTs()) on the
+ *        simulated register map. Lists, buffers, the register contents the device answers with and the bus
+ *        faults are drawn from a byte stream, lists and output buffers are exact size heap blocks and the test
+ *        is built with AddressSanitizer and UndefinedBehaviorSanitizer, so a walker running past a terminator
+ *        or a buffer fails the test. Every result is compared with a reference model.
+ *
+ *        LLVMFuzzerTestOneInput() runs one input: its first byte selects the target, the rest is the stream.
+ *        Built with FUZZ_TEST_LIBFUZZER it is a libFuzzer target, otherwise main() replays the seed corpus
+ *        (fuzz_corpus/) and then runs each target with an xorshift stream:
+ *
+ *        build/fuzz_test [iterations [seed]]    the seed corpus, then the seeded passes
+ *        build/fuzz_test -r file|dir...         replays inputs, libFuzzer crash files included
+ *        build/fuzz_test -w dir [count [seed]]  records count seeded inputs per target as a corpus
+ */
+
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "mock_bus.h"
+#include "pcf2131_aging.h"
+#include "sensor_io_i2c.h"
+#include "sensor_io_spi.h"
+#include "register_io_spi.h"
+
+#define CHECK(cond)                                                                              \
+	do                                                                                           \
+	{                                                                                            \
+		if (!(cond))                                                                             \
+		{                                                                                        \
+			printf("fuzz_test: %s:%d: %s, iteration %u\n", __FILE__, __LINE__, #cond, s_iteration); \
+			s_failures++;                                                                        \
+		}                                                                                        \
+	} while (0)
+
+/* Iterations of each pass when none is given, make check runs this many. */
+#define FUZZ_TEST_ITERATIONS (20000)
+
+/* Longest list and entry the generators make. */
+#define FUZZ_TEST_MAX_ENTRIES (6)
+#define FUZZ_TEST_MAX_BYTES   (16)
+
+/* Block writes wait 1 ms for completion, only every this many iterations runs one. */
+#define FUZZ_TEST_BLOCK_EVERY (16)
+
+/* The checked-in seed corpus, relative to host_test, and the longest input replayed or recorded. */
+#define FUZZ_TEST_CORPUS    "fuzz_corpus"
+#define FUZZ_TEST_MAX_INPUT (4096)
+
+#ifndef FUZZ_TEST_LIBFUZZER
+#define FUZZ_TEST_LIBFUZZER (0)
+#endif
+
+/* Bus transfers of one list entry, see mock_bus.h. */
+#if (I2C_ENABLE)
+#define FUZZ_READ_XFERS        (2)
+#define FUZZ_WRITE_XFERS(mask) ((mask) ? 3 : 1)
+#define FUZZ_BLOCK_XFERS       (1)
+#define FUZZ_POLL_XFERS        (2)
+#else
+#define FUZZ_READ_XFERS        (1)
+#define FUZZ_WRITE_XFERS(mask) ((mask) ? 2 : 1)
+#define FUZZ_BLOCK_XFERS       (1)
+#define FUZZ_POLL_XFERS        (1)
+#endif
+
+/* The register an offset reaches and the registers block writes may use. The SPI command byte carries a
+ * 7 bit register address, higher offsets alias. */
+#if (I2C_ENABLE)
+#define FUZZ_REG(offset) ((uint8_t)(offset))
+#define FUZZ_REG_SPAN    (MOCK_BUS_REG_COUNT)
+#else
+#define FUZZ_REG(offset) ((uint8_t)((offset) & PCF2131_SPI_WR_CMD))
+#define FUZZ_REG_SPAN    (PCF2131_SPI_WR_CMD + 1)
+#endif
+
+/* Seconds from the Unix epoch to 2000-01-01 00:00:00, the RTC epoch. */
+#define FUZZ_TEST_EPOCH_2000 (946684800)
+
+static pcf2131_sensorhandle_t s_rtc;
+/* The lists go through the register I/O layer directly, with the deadline and slave select of the driver. */
+static registerDeviceInfo_t s_devInfo = {.timeout_us = PCF2131_BUS_TIMEOUT_US};
+#if !(I2C_ENABLE)
+static uint32_t s_slaveSelect;
+static spiSlaveSpecificParams_t s_spiParams = {
+	.pReadPreprocessFN = PCF2131_ReadPreprocess,
+	.pWritePreprocessFN = PCF2131_WritePreprocess,
+	.pTargetSlavePinID = &s_slaveSelect,
+	.spiCmdLen = PCF2131_SPI_CMD_LEN,
+	.ssActiveValue = PCF2131_SS_ACTIVE_VALUE,
+};
+#endif
+static uint32_t s_seed;
+/* The input stream, NULL for the xorshift stream, and the recording of the values drawn. */
+static const uint8_t *s_pInput;
+static size_t s_inputLeft;
+static uint8_t *s_pRecord;
+static size_t s_recordLen;
+static uint32_t s_iteration;
+static uint32_t s_failures;
+
+/* Outcome counts per pass, reported so a run that never reaches a path is visible. */
+static uint32_t s_ok, s_badAddress, s_faults, s_rejected;
+
+/* xorshift32, seeded from the command line so a failure can be replayed. */
+static uint32_t xorshift(void)
+{
+	s_seed ^= s_seed << 13;
+	s_seed ^= s_seed >> 17;
+	s_seed ^= s_seed << 5;
+	return s_seed;
+}
+
+/* The next bytes of the input, little endian, zeros once it is used up. */
+static uint32_t input_take(uint32_t bytes)
+{
+	uint32_t value = 0, i;
+
+	for (i = 0; i < bytes; i++)
+	{
+		if (s_inputLeft)
+		{
+			value |= (uint32_t)*s_pInput++ << (8 * i);
+			s_inputLeft--;
+		}
+	}
+	return value;
+}
+
+/* A value drawn, in the bytes the input stream takes for it, so the recording replays the same run. */
+static void record(uint32_t value, uint32_t bytes)
+{
+	uint32_t i;
+
+	for (i = 0; (s_pRecord != NULL) && (i < bytes) && (s_recordLen < FUZZ_TEST_MAX_INPUT); i++)
+	{
+		s_pRecord[s_recordLen++] = (uint8_t)(value >> (8 * i));
+	}
+}
+
+/* The stream of the generators: the input if there is one, the xorshift otherwise. A draw below n takes
+ * only the bytes n needs from the input, keeping inputs short for the fuzzer. */
+static uint32_t rnd(void)
+{
+	uint32_t value = s_pInput ? input_take(4) : xorshift();
+
+	record(value, 4);
+	return value;
+}
+
+static uint32_t rnd_below(uint32_t n)
+{
+	uint32_t bytes = (n <= 0x100) ? 1 : ((n <= 0x10000) ? 2 : 4);
+	uint32_t value = (s_pInput ? input_take(bytes) : xorshift()) % n;
+
+	record(value, bytes);
+	return value;
+}
+
+static uint8_t rnd_byte(void)
+{
+	uint8_t value = (uint8_t)(s_pInput ? input_take(1) : xorshift());
+
+	record(value, 1);
+	return value;
+}
+
+/* A register offset for a list: mostly in the 8-bit range, sometimes past it. */
+static uint16_t rnd_offset(void)
+{
+	uint32_t r = rnd_below(100);
+
+	if (r < 88)
+	{
+		return (uint16_t)rnd_below(0x100);
+	}
+	if (r < 96)
+	{
+		return (uint16_t)(0x100 + rnd_below(0xFEFF));
+	}
+	return 0xFFFF;
+}
+
+static uint8_t bcd(uint8_t val)
+{
+	return (uint8_t)((val >> 4) * 10 + (val & 0x0F));
+}
+
+/* Random register contents, the time registers with valid BCD half of the time. */
+static void randomize_regs(void)
+{
+	uint32_t i;
+
+	for (i = 0; i < MOCK_BUS_REG_COUNT; i++)
+	{
+		g_Mock_Regs[i] = rnd_byte();
+	}
+	if (rnd_below(2))
+	{
+		for (i = PCF2131_100TH_SECOND; i < PCF2131_REG_MAP_SIZE; i++)
+		{
+			g_Mock_Regs[i] = (uint8_t)((rnd_below(10) << 4) | rnd_below(10) | (g_Mock_Regs[i] & 0x80));
+		}
+	}
+}
+
+/* Arms a fault at a random transfer in a third of the runs, returns the transfers allowed before it. */
+static uint32_t arm_fault(uint32_t maxTransfers, int32_t *pStatus)
+{
+	uint32_t after;
+
+	if (rnd_below(3) != 0)
+	{
+		return UINT32_MAX;
+	}
+	after = rnd_below(maxTransfers + 1);
+	*pStatus = rnd_below(2) ? ARM_DRIVER_ERROR_TIMEOUT : ARM_DRIVER_ERROR;
+	Mock_Bus_Fail(after, 1, *pStatus);
+	return after;
+}
+
+static int32_t fault_error(int32_t busStatus, int32_t error)
+{
+	return (ARM_DRIVER_ERROR_TIMEOUT == busStatus) ? SENSOR_ERROR_TIMEOUT : error;
+}
+
+static void count(int32_t status)
+{
+	s_ok += (SENSOR_ERROR_NONE == status);
+	s_badAddress += (SENSOR_ERROR_BAD_ADDRESS == status);
+	s_faults += ((SENSOR_ERROR_TIMEOUT == status) || (SENSOR_ERROR_READ == status) || (SENSOR_ERROR_WRITE == status));
+	s_rejected += (SENSOR_ERROR_INVALID_PARAM == status);
+}
+
+static void report(const char *pName)
+{
+	printf("fuzz_test: %s: %u ok, %u bad address, %u bus faults, %u rejected\n", pName, s_ok, s_badAddress, s_faults,
+		   s_rejected);
+	s_ok = s_badAddress = s_faults = s_rejected = 0;
+}
+
+/*******************************************************************************
+ * Register list walkers
+ ******************************************************************************/
+static int32_t walker_read(const registerreadlist_t *pList, uint8_t *pOut)
+{
+#if (I2C_ENABLE)
+	return Sensor_I2C_Read(&Mock_I2C_Driver, &s_devInfo, 0x53, pList, pOut);
+#else
+	return Sensor_SPI_Read(&Mock_SPI_Driver, &s_devInfo, &s_spiParams, pList, pOut);
+#endif
+}
+
+static int32_t walker_write(const registerwritelist_t *pList)
+{
+#if (I2C_ENABLE)
+	return Sensor_I2C_Write(&Mock_I2C_Driver, &s_devInfo, 0x53, pList);
+#else
+	return Sensor_SPI_Write(&Mock_SPI_Driver, &s_devInfo, &s_spiParams, pList);
+#endif
+}
+
+static int32_t walker_block_write(const registercommandlist_t *pList, uint8_t errorMask)
+{
+#if (I2C_ENABLE)
+	return Sensor_I2C_BlockWrite(&Mock_I2C_Driver, &s_devInfo, 0x53, pList, errorMask);
+#else
+	return Sensor_SPI_BlockWrite(&Mock_SPI_Driver, &s_devInfo, &s_spiParams, pList, errorMask);
+#endif
+}
+
+/* Reads copy exactly the listed registers in order and stop at the first zero length entry, a bad offset
+ * or a fault. The output buffer holds the listed bytes and no more. */
+static void fuzz_read(void)
+{
+	uint32_t n = rnd_below(FUZZ_TEST_MAX_ENTRIES + 1), size = 0, used = 0, transfers = 0, after, i, j;
+	registerreadlist_t *pList = malloc((n + 1) * sizeof(registerreadlist_t));
+	uint8_t *pOut, *pExpect;
+	int32_t status, busStatus = ARM_DRIVER_OK, expect = SENSOR_ERROR_NONE;
+	bool ended = false;
+
+	for (i = 0; i < n; i++)
+	{
+		pList[i].readFrom = rnd_offset();
+		pList[i].numBytes = (uint8_t)((rnd_below(10) == 0) ? 0 : 1 + rnd_below(FUZZ_TEST_MAX_BYTES));
+		ended = ended || (pList[i].numBytes == 0);
+		size += ended ? 0 : pList[i].numBytes;
+	}
+	pList[n].readFrom = 0xFFFF;
+	pList[n].numBytes = 0;
+
+	/*! No room past the listed bytes, any stray write is caught */
+	pOut = malloc(size);
+	pExpect = malloc(size + 1);
+	memset(pOut, 0xA5, size);
+	memset(pExpect, 0xA5, size);
+	randomize_regs();
+	after = arm_fault(n * FUZZ_READ_XFERS, &busStatus);
+
+	for (i = 0; pList[i].numBytes != 0; i++)
+	{
+		if (pList[i].readFrom > 0xFF)
+		{
+			expect = SENSOR_ERROR_BAD_ADDRESS;
+			break;
+		}
+		transfers += FUZZ_READ_XFERS;
+		if (transfers > after)
+		{
+			expect = fault_error(busStatus, SENSOR_ERROR_READ);
+			break;
+		}
+		for (j = 0; j < pList[i].numBytes; j++)
+		{
+			pExpect[used + j] = g_Mock_Regs[(uint8_t)(FUZZ_REG(pList[i].readFrom) + j)];
+		}
+		used += pList[i].numBytes;
+	}
+
+	status = walker_read(pList, pOut);
+	CHECK(status == expect);
+	CHECK(!memcmp(pOut, pExpect, size));
+	count(status);
+
+	Mock_Bus_Fail(0, 0, ARM_DRIVER_OK);
+	free(pExpect);
+	free(pOut);
+	free(pList);
+}
+
+/* Writes apply the listed value/mask pairs in order up to the terminator, a bad offset or a fault, the
+ * rest of the register map is untouched. */
+static void fuzz_write(void)
+{
+	uint32_t n = rnd_below(FUZZ_TEST_MAX_ENTRIES + 1), maxTransfers = 0, transfers = 0, after, i;
+	registerwritelist_t *pList = malloc((n + 1) * sizeof(registerwritelist_t));
+	uint8_t expect[MOCK_BUS_REG_COUNT], value;
+	int32_t status, busStatus = ARM_DRIVER_OK, expectStatus = SENSOR_ERROR_NONE;
+
+	for (i = 0; i < n; i++)
+	{
+		pList[i].writeTo = rnd_offset();
+		pList[i].value = rnd_byte();
+		pList[i].mask = (uint8_t)((rnd_below(3) == 0) ? 0 : rnd_byte());
+		maxTransfers += FUZZ_WRITE_XFERS(pList[i].mask);
+	}
+	pList[n].writeTo = 0xFFFF;
+	pList[n].value = 0;
+	pList[n].mask = 0;
+
+	randomize_regs();
+	memcpy(expect, g_Mock_Regs, sizeof(expect));
+	after = arm_fault(maxTransfers, &busStatus);
+
+	for (i = 0; pList[i].writeTo != 0xFFFF; i++)
+	{
+		if (pList[i].writeTo > 0xFF)
+		{
+			expectStatus = SENSOR_ERROR_BAD_ADDRESS;
+			break;
+		}
+		transfers += FUZZ_WRITE_XFERS(pList[i].mask);
+		if (transfers > after)
+		{
+			expectStatus = fault_error(busStatus, SENSOR_ERROR_WRITE);
+			break;
+		}
+		value = pList[i].value;
+		if (pList[i].mask)
+		{
+			value = (uint8_t)((expect[FUZZ_REG(pList[i].writeTo)] & ~pList[i].mask) | value);
+		}
+		expect[FUZZ_REG(pList[i].writeTo)] = value;
+	}
+
+	status = walker_write(pList);
+	CHECK(status == expectStatus);
+	CHECK(!memcmp(expect, g_Mock_Regs, sizeof(expect)));
+	count(status);
+
+	Mock_Bus_Fail(0, 0, ARM_DRIVER_OK);
+	free(pList);
+}
+
+/* Block writes copy each command buffer, then poll the completion byte (bit 7 of register 1, the error
+ * bits under errorMask). Commands stay clear of registers 0 and 1 so the poll ends. */
+static void fuzz_block_write(void)
+{
+	uint32_t n = rnd_below(4), maxTransfers = 0, transfers = 0, after, i, j;
+	registercommandlist_t *pList = malloc((n + 1) * sizeof(registercommandlist_t));
+	uint8_t expect[MOCK_BUS_REG_COUNT], errorMask = (rnd_below(4) == 0) ? (uint8_t)(rnd_byte() & 0x7F) : 0;
+	int32_t status, busStatus = ARM_DRIVER_OK, expectStatus = SENSOR_ERROR_NONE;
+
+	for (i = 0; i < n; i++)
+	{
+		uint16_t offset = (uint16_t)(2 + rnd_below(FUZZ_REG_SPAN - 2));
+		uint8_t length = (uint8_t)(1 + rnd_below(FUZZ_TEST_MAX_BYTES));
+		uint8_t *pBuffer = NULL;
+
+		if (rnd_below(10) == 0)
+		{
+			offset = (uint16_t)(0x100 + rnd_below(0xFF00));
+		}
+
+		if ((offset < FUZZ_REG_SPAN) && (offset + length > FUZZ_REG_SPAN))
+		{
+			length = (uint8_t)(FUZZ_REG_SPAN - offset);
+		}
+		if (rnd_below(20) != 0)
+		{
+			pBuffer = malloc(length);
+			for (j = 0; j < length; j++)
+			{
+				pBuffer[j] = rnd_byte();
+			}
+		}
+		pList[i].writeTo = offset;
+		pList[i].pWriteBuffer = pBuffer;
+		pList[i].numBytes = length;
+		maxTransfers += FUZZ_BLOCK_XFERS + FUZZ_POLL_XFERS;
+	}
+	pList[n].writeTo = 0xFFFF;
+	pList[n].pWriteBuffer = NULL;
+	pList[n].numBytes = 0;
+
+	randomize_regs();
+	g_Mock_Regs[1] |= 0x80;
+	memcpy(expect, g_Mock_Regs, sizeof(expect));
+	after = arm_fault(maxTransfers, &busStatus);
+
+	for (i = 0; pList[i].writeTo != 0xFFFF; i++)
+	{
+		if ((pList[i].writeTo > 0xFF) || (pList[i].pWriteBuffer == NULL))
+		{
+			expectStatus = SENSOR_ERROR_BAD_ADDRESS;
+			break;
+		}
+		transfers += FUZZ_BLOCK_XFERS;
+		if (transfers > after)
+		{
+			expectStatus = fault_error(busStatus, SENSOR_ERROR_WRITE);
+			break;
+		}
+		memcpy(&expect[pList[i].writeTo], pList[i].pWriteBuffer, pList[i].numBytes);
+		transfers += FUZZ_POLL_XFERS;
+		if (transfers > after)
+		{
+			expectStatus = fault_error(busStatus, SENSOR_ERROR_READ);
+			break;
+		}
+		if (expect[1] & errorMask)
+		{
+			expectStatus = SENSOR_ERROR_WRITE;
+			break;
+		}
+	}
+
+	status = walker_block_write(pList, errorMask);
+	CHECK(status == expectStatus);
+	CHECK(!memcmp(expect, g_Mock_Regs, sizeof(expect)));
+	count(status);
+
+	Mock_Bus_Fail(0, 0, ARM_DRIVER_OK);
+	for (i = 0; i < n; i++)
+	{
+		free((void *)pList[i].pWriteBuffer);
+	}
+	free(pList);
+}
+
+/*******************************************************************************
+ * BCD time decode
+ ******************************************************************************/
+typedef enum
+{
+	fuzzTime,
+	fuzzAlarm,
+	fuzzTs,
+} fuzz_api_t;
+
+/* Bytes each get API decodes, its read list must fit them. */
+static const uint8_t s_apiSize[] = {PCF2131_TIME_SIZE_BYTE, PCF2131_ALARM_TIME_SIZE_BYTE, PCF2131_TS_SIZE_BYTE};
+
+/* The hour register decoded as the driver does, 12 hour mode from Control_1 in the register map. */
+static void decode_hours(uint8_t raw, uint8_t *pHours, AmPm *pAmPm)
+{
+	if (g_Mock_Regs[PCF2131_CTRL1] & PCF2131_CTRL1_12_HOUR_24_HOUR_MODE_MASK)
+	{
+		*pAmPm = ((raw >> PCF2131_AM_PM_SHIFT) & 0x01) ? PM : AM;
+		*pHours = bcd(raw & PCF2131_HOURS_MASK_12H);
+	}
+	else
+	{
+		*pAmPm = h24;
+		*pHours = bcd(raw & PCF2131_HOURS_MASK);
+	}
+}
+
+/* Reference decode of the bytes a read list put in the structure. */
+static void decode(fuzz_api_t api, const uint8_t *pRaw, void *pOut)
+{
+	if (fuzzTime == api)
+	{
+		pcf2131_timedata_t *pTime = pOut;
+
+		pTime->second_100th = bcd(pRaw[0]);
+		pTime->second = bcd(pRaw[1] & PCF2131_SECONDS_MASK);
+		pTime->minutes = bcd(pRaw[2] & PCF2131_MINUTES_MASK);
+		decode_hours(pRaw[3], &pTime->hours, &pTime->ampm);
+		pTime->days = bcd(pRaw[4] & PCF2131_DAYS_MASK);
+		pTime->weekdays = bcd(pRaw[5] & PCF2131_WEEKDAYS_MASK);
+		pTime->months = bcd(pRaw[6] & PCF2131_MONTHS_MASK);
+		pTime->years = bcd(pRaw[7]);
+	}
+	else if (fuzzAlarm == api)
+	{
+		pcf2131_alarmdata_t *pAlarm = pOut;
+
+		pAlarm->second = bcd(pRaw[0] & PCF2131_SECONDS_ALARM_MASK);
+		pAlarm->minutes = bcd(pRaw[1] & PCF2131_MINUTES_ALARM_MASK);
+		decode_hours(pRaw[2], &pAlarm->hours, &pAlarm->ampm);
+		pAlarm->days = bcd(pRaw[3] & PCF2131_DAYS_ALARM_MASK);
+		pAlarm->weekdays = bcd(pRaw[4] & PCF2131_WEEKDAYS_ALARM_MASK);
+	}
+	else
+	{
+		pcf2131_timestamp_t *pTs = pOut;
+
+		pTs->second = bcd(pRaw[0] & PCF2131_SECONDS_TS_MASK);
+		pTs->minutes = bcd(pRaw[1] & PCF2131_MINUTES_TS_MASK);
+		decode_hours(pRaw[2], &pTs->hours, &pTs->ampm);
+		pTs->days = bcd(pRaw[3] & PCF2131_DAYS_TS_MASK);
+		pTs->months = bcd(pRaw[4] & PCF2131_MONTHS_TS_MASK);
+		pTs->years = bcd(pRaw[5]);
+	}
+}
+
+/* A read list for a get API: the driver's own list, or random entries that may not fit. */
+static registerreadlist_t *make_get_list(fuzz_api_t api, uint32_t *pEntries)
+{
+	static const uint16_t first[] = {PCF2131_100TH_SECOND, PCF2131_SECOND_ALARM, PCF2131_TIMESTAMP1_SECONDS};
+	uint32_t n = rnd_below(2) ? 1 : rnd_below(4), i;
+	registerreadlist_t *pList = malloc((n + 1) * sizeof(registerreadlist_t));
+
+	for (i = 0; i < n; i++)
+	{
+		pList[i].readFrom = (rnd_below(20) == 0) ? rnd_offset() : (uint16_t)rnd_below(PCF2131_REG_MAP_SIZE + 8);
+		pList[i].numBytes = (uint8_t)(1 + rnd_below(s_apiSize[api] + 2));
+	}
+	if ((n == 1) && rnd_below(2))
+	{
+		pList[0].readFrom = first[api];
+		pList[0].numBytes = s_apiSize[api];
+	}
+	pList[n].readFrom = 0xFFFF;
+	pList[n].numBytes = 0;
+	*pEntries = n;
+
+	return pList;
+}
+
+/* Any list and register contents: a list that does not fit the structure or the register map is rejected
+ * and nothing is written, otherwise the listed bytes are decoded as the reference does and every bus
+ * fault is reported. */
+static void fuzz_decode(void)
+{
+	fuzz_api_t api = (fuzz_api_t)rnd_below(3);
+	SwTsNum tsnum = (SwTsNum)rnd_below(5);
+	uint32_t n, total = 0, i, j, after;
+	registerreadlist_t *pList = make_get_list(api, &n);
+	union {
+		pcf2131_timedata_t time;
+		pcf2131_alarmdata_t alarm;
+		pcf2131_timestamp_t ts;
+		uint8_t raw[sizeof(pcf2131_timedata_t)];
+	} out, expect;
+	int32_t status, busStatus = ARM_DRIVER_OK, expectStatus = SENSOR_ERROR_NONE;
+	bool fits = true;
+
+	randomize_regs();
+	for (i = 0; i < sizeof(out); i++)
+	{
+		out.raw[i] = rnd_byte();
+	}
+	memcpy(&expect, &out, sizeof(out));
+
+	for (i = 0; i < n; i++)
+	{
+		total += pList[i].numBytes;
+		fits = fits && (total <= s_apiSize[api]) && (pList[i].readFrom + pList[i].numBytes <= PCF2131_REG_MAP_SIZE);
+	}
+	if (!fits || ((fuzzTs == api) && (tsnum > sw4Ts)))
+	{
+		expectStatus = SENSOR_ERROR_INVALID_PARAM;
+	}
+	else
+	{
+		for (i = 0, total = 0; i < n; i++)
+		{
+			for (j = 0; j < pList[i].numBytes; j++)
+			{
+				expect.raw[total++] = g_Mock_Regs[pList[i].readFrom + j];
+			}
+		}
+		decode(api, expect.raw, &expect);
+	}
+
+	/*! The list reads, then Control_1 for the hour mode */
+	after = arm_fault(n * FUZZ_READ_XFERS + FUZZ_READ_XFERS, &busStatus);
+
+	if (fuzzTime == api)
+	{
+		status = PCF2131_GetTime(&s_rtc, pList, &out.time);
+	}
+	else if (fuzzAlarm == api)
+	{
+		status = PCF2131_GetAlarmTime(&s_rtc, pList, &out.alarm);
+	}
+	else
+	{
+		status = PCF2131_GetTs(&s_rtc, pList, tsnum, &out.ts);
+	}
+
+	if ((after != UINT32_MAX) && (SENSOR_ERROR_INVALID_PARAM != expectStatus) && !Mock_Bus_FaultPending())
+	{
+		/*! The fault was hit, the API must say so, the structure content is then undefined */
+		CHECK((SENSOR_ERROR_READ == status) || (SENSOR_ERROR_WRITE == status) || (SENSOR_ERROR_TIMEOUT == status));
+	}
+	else
+	{
+		CHECK(status == expectStatus);
+		CHECK(!memcmp(&out, &expect, sizeof(out)));
+	}
+	count(status);
+
+	Mock_Bus_Fail(0, 0, ARM_DRIVER_OK);
+	free(pList);
+}
+
+/* Any valid time in either hour mode comes back unchanged through SetTime/GetTime, and PCF2131_TimeToMs()
+ * of it matches the C library. */
+static void fuzz_round_trip(void)
+{
+	static const registerreadlist_t timeList[] = {{.readFrom = PCF2131_100TH_SECOND, .numBytes = 8},
+			__END_READ_DATA__};
+	time_t utc = FUZZ_TEST_EPOCH_2000 + (time_t)(((uint64_t)rnd() << 32 | rnd()) % (100ULL * 36524 * 864));
+	Mode12h_24h mode = rnd_below(2) ? mode12H : mode24H;
+	pcf2131_timedata_t time, set, got;
+	struct tm tm;
+
+	gmtime_r(&utc, &tm);
+	time.second_100th = (uint8_t)rnd_below(100);
+	time.second = (uint8_t)tm.tm_sec;
+	time.minutes = (uint8_t)tm.tm_min;
+	time.days = (uint8_t)tm.tm_mday;
+	time.weekdays = (uint8_t)tm.tm_wday;
+	time.months = (uint8_t)(tm.tm_mon + 1);
+	time.years = (uint8_t)(tm.tm_year - 100);
+	if (mode12H == mode)
+	{
+		time.ampm = (tm.tm_hour >= 12) ? PM : AM;
+		time.hours = (uint8_t)((tm.tm_hour % 12) ? (tm.tm_hour % 12) : 12);
+	}
+	else
+	{
+		time.ampm = h24;
+		time.hours = (uint8_t)tm.tm_hour;
+	}
+
+	randomize_regs();
+	set = time;
+	CHECK(PCF2131_12h_24h_Mode_Set(&s_rtc, mode) == SENSOR_ERROR_NONE);
+	CHECK(PCF2131_SetTime(&s_rtc, &set) == SENSOR_ERROR_NONE);
+	CHECK(PCF2131_GetTime(&s_rtc, timeList, &got) == SENSOR_ERROR_NONE);
+	CHECK(!memcmp(&got, &time, sizeof(time)));
+	CHECK(PCF2131_TimeToMs(&got) == (int64_t)(utc - FUZZ_TEST_EPOCH_2000) * 1000 + time.second_100th * 10);
+	s_ok++;
+}
+
+/*******************************************************************************
+ * Entry points
+ ******************************************************************************/
+typedef struct
+{
+	const char *name;   /* Name of the recorded inputs. */
+	const char *pass;   /* Report of the seeded pass. */
+	void (*run)(void);
+	uint32_t every;     /* The seeded pass runs the target every this many iterations. */
+} fuzz_target_t;
+
+static const fuzz_target_t s_targets[] = {
+	{"read", "read lists", fuzz_read, 1},
+	{"write", "write lists", fuzz_write, 1},
+	{"command", "command lists", fuzz_block_write, FUZZ_TEST_BLOCK_EVERY},
+	{"decode", "time decode", fuzz_decode, 1},
+	{"roundtrip", "round trips", fuzz_round_trip, 1},
+};
+
+#define FUZZ_TEST_TARGETS (sizeof(s_targets) / sizeof(s_targets[0]))
+
+/* A fresh handle on a reset bus, so an input runs the same alone as in a corpus. */
+static void setup(void)
+{
+	Mock_Bus_Reset();
+#if (I2C_ENABLE)
+	CHECK(PCF2131_Initialize(&s_rtc, &Mock_I2C_Driver, 0, 0x53) == SENSOR_ERROR_NONE);
+#else
+	static uint32_t slaveSelect;
+	CHECK(PCF2131_Initialize(&s_rtc, &Mock_SPI_Driver, 0, &slaveSelect) == SENSOR_ERROR_NONE);
+#endif
+}
+
+/*! One input: the target in the first byte, the lists, buffers, register contents and bus faults it draws in
+ *  the rest. A violated property aborts for libFuzzer. */
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+	uint32_t failures = s_failures;
+
+	if (size == 0)
+	{
+		return 0;
+	}
+	setup();
+	s_pInput = data + 1;
+	s_inputLeft = size - 1;
+	s_targets[data[0] % FUZZ_TEST_TARGETS].run();
+	s_pInput = NULL;
+	s_inputLeft = 0;
+
+	if (FUZZ_TEST_LIBFUZZER && (s_failures != failures))
+	{
+		abort();
+	}
+	return 0;
+}
+
+#if !(FUZZ_TEST_LIBFUZZER)
+/* Replays a file, or every file of a directory in name order. Returns the inputs replayed. */
+static uint32_t replay(const char *pPath)
+{
+	struct dirent **ppEntries;
+	char path[512];
+	uint8_t *pData;
+	uint32_t failures, replayed = 0;
+	size_t size;
+	FILE *pFile;
+	int n, i;
+
+	n = scandir(pPath, &ppEntries, NULL, alphasort);
+	if (n >= 0)
+	{
+		for (i = 0; i < n; i++)
+		{
+			if (ppEntries[i]->d_name[0] != '.')
+			{
+				snprintf(path, sizeof(path), "%s/%s", pPath, ppEntries[i]->d_name);
+				replayed += replay(path);
+			}
+			free(ppEntries[i]);
+		}
+		free(ppEntries);
+		return replayed;
+	}
+
+	pFile = fopen(pPath, "rb");
+	CHECK(pFile != NULL);
+	if (pFile == NULL)
+	{
+		return 0;
+	}
+	/*! An exact size copy, a harness reading past the input is caught */
+	pData = malloc(FUZZ_TEST_MAX_INPUT);
+	size = fread(pData, 1, FUZZ_TEST_MAX_INPUT, pFile);
+	fclose(pFile);
+	pData = realloc(pData, size ? size : 1);
+
+	failures = s_failures;
+	LLVMFuzzerTestOneInput(pData, size);
+	if (s_failures != failures)
+	{
+		printf("fuzz_test: %s failed\n", pPath);
+	}
+	free(pData);
+	s_iteration++;
+
+	return 1;
+}
+
+/* Records count inputs of each target from the xorshift stream into pDir, named after the target. */
+static void write_corpus(const char *pDir, uint32_t count)
+{
+	uint8_t input[FUZZ_TEST_MAX_INPUT];
+	char path[512];
+	uint32_t target;
+	FILE *pFile;
+
+	for (target = 0; target < FUZZ_TEST_TARGETS; target++)
+	{
+		for (s_iteration = 0; s_iteration < count; s_iteration++)
+		{
+			setup();
+			input[0] = (uint8_t)target;
+			s_pRecord = input;
+			s_recordLen = 1;
+			s_targets[target].run();
+			s_pRecord = NULL;
+
+			snprintf(path, sizeof(path), "%s/%s-%03u", pDir, s_targets[target].name, s_iteration);
+			pFile = fopen(path, "wb");
+			CHECK(pFile != NULL);
+			if (pFile != NULL)
+			{
+				CHECK(fwrite(input, 1, s_recordLen, pFile) == s_recordLen);
+				fclose(pFile);
+			}
+		}
+	}
+	printf("fuzz_test: %u inputs per target written to %s\n", count, pDir);
+}
+
+int main(int argc, char *argv[])
+{
+	uint32_t iterations = FUZZ_TEST_ITERATIONS, seed = 2131, replayed = 0, target;
+	int i;
+
+	if ((argc > 1) && (0 == strcmp(argv[1], "-r")))
+	{
+		for (i = 2; i < argc; i++)
+		{
+			replayed += replay(argv[i]);
+		}
+		printf("fuzz_test: %u inputs replayed\n", replayed);
+		printf("fuzz_test: %s\n", s_failures ? "FAIL" : "PASS");
+		return s_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+	}
+	if ((argc > 2) && (0 == strcmp(argv[1], "-w")))
+	{
+		iterations = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 0) : 8;
+		seed = (argc > 4) ? (uint32_t)strtoul(argv[4], NULL, 0) : seed;
+		s_seed = seed ? seed : 1;
+		write_corpus(argv[2], iterations);
+		return s_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+	}
+	iterations = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : iterations;
+	seed = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : seed;
+
+	/*! The seed corpus first, every input on a fresh handle */
+	replayed = replay(FUZZ_TEST_CORPUS);
+	CHECK(replayed > 0);
+	printf("fuzz_test: %u inputs of %s replayed: %u ok, %u bad address, %u bus faults, %u rejected\n", replayed,
+		   FUZZ_TEST_CORPUS, s_ok, s_badAddress, s_faults, s_rejected);
+	s_ok = s_badAddress = s_faults = s_rejected = 0;
+
+	/*! Then the seeded passes on one handle */
+	s_seed = seed ? seed : 1;
+	setup();
+	printf("fuzz_test: %u iterations per pass, seed %u\n", iterations, seed);
+	for (target = 0; target < FUZZ_TEST_TARGETS; target++)
+	{
+		for (s_iteration = 0; s_iteration < iterations / s_targets[target].every; s_iteration++)
+		{
+			s_targets[target].run();
+		}
+		report(s_targets[target].pass);
+	}
+
+	printf("fuzz_test: %s\n", s_failures ? "FAIL" : "PASS");
+	return s_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+#endif
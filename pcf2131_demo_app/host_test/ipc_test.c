@@ -0,0 +1,352 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file ipc_test.c
+ * @brief Host simulation of the dual-core PCF2131 service (rtc/pcf2131_ipc.c, MCXN947 tree), built with
+ *        PCF2131_DUAL_CORE. A thread plays core 1: it owns the RTC on the simulated bus, raises the RTC
+ *        interrupt on request (seconds, timestamp and alarm flags in the register map) and sleeps on its
+ *        mailbox doorbell when PCF2131_IPC_ServerRun() has nothing to do. The main thread plays core 0:
+ *        requests of every type, replies in order with their tag and status, the published time read while
+ *        core 1 updates it, and the journal. Then core 0 stops taking events until the journal fills the
+ *        event queue, and a queue of requests must still get every reply once it drains.
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "fsl_common.h"
+#include "mock_bus.h"
+#include "pcf2131.h"
+#include "pcf2131_aging.h"
+#include "pcf2131_drv.h"
+#include "pcf2131_ipc.h"
+
+#define CHECK(cond)                                                              \
+	do                                                                           \
+	{                                                                            \
+		if (!(cond))                                                             \
+		{                                                                        \
+			printf("ipc_test: %s:%d: %s\n", __FILE__, __LINE__, #cond);          \
+			s_failures++;                                                        \
+		}                                                                        \
+	} while (0)
+
+/* Requests of the first pass and the most in flight, the event queue then has room for the journal too. */
+#define IPC_TEST_REQUESTS  (400U)
+#define IPC_TEST_IN_FLIGHT (8U)
+/* How long core 0 waits for anything before giving up. */
+#define IPC_TEST_WAIT_MS  (5000U)
+
+/* Simulated core 0 and core 1 mailbox lines. */
+#define IPC_TEST_CORE0 (0)
+#define IPC_TEST_CORE1 (1)
+
+static pcf2131_ipc_t s_ipc;
+static pcf2131_sensorhandle_t s_rtc;
+/* RTC interrupts asked for by core 0 and raised by core 1. */
+static volatile uint32_t s_ticksAsked, s_ticksDone;
+static volatile bool s_stop;
+/* The reply status each tag in flight expects. */
+static int32_t s_expect[256];
+static uint32_t s_failures;
+
+static uint8_t to_bcd(uint32_t value)
+{
+	return (uint8_t)(((value / 10U) << 4) | (value % 10U));
+}
+
+/* Takes the doorbell of a core, as its mailbox interrupt would. */
+static bool take_doorbell(uint32_t core)
+{
+	return __atomic_exchange_n(&MAILBOX->MBOXIRQ[core].IRQSET, 0, __ATOMIC_SEQ_CST) != 0;
+}
+
+/* The RTC on core 1: the time moves on a second, every 4th second switch 1 takes a timestamp, every 8th the
+ * alarm fires. The interrupt pin handler flags it. */
+static void rtc_interrupt(uint32_t tick)
+{
+	g_Mock_Regs[PCF2131_SECOND] = to_bcd(tick % 60U);
+	g_Mock_Regs[PCF2131_MINUTE] = to_bcd((tick / 60U) % 60U);
+	g_Mock_Regs[PCF2131_CTRL2] |= PCF2131_CTRL2_MSF_MASK;
+	if ((tick % 4U) == 0)
+	{
+		g_Mock_Regs[PCF2131_TIMESTAMP1_SECONDS] = to_bcd(tick % 60U);
+		g_Mock_Regs[PCF2131_CTRL4] |= PCF2131_CTRL4_TSF1_MASK;
+	}
+	if ((tick % 8U) == 0)
+	{
+		g_Mock_Regs[PCF2131_CTRL2] |= PCF2131_CTRL2_AF_MASK;
+	}
+	PCF2131_IPC_ServerNotify();
+}
+
+/* Core 1: serves core 0, sleeping on the doorbell (or the RTC interrupt) when idle. */
+static void *core1(void *arg)
+{
+	uint32_t asked;
+#if (I2C_ENABLE)
+	CHECK(PCF2131_Initialize(&s_rtc, &Mock_I2C_Driver, 0, 0x53) == SENSOR_ERROR_NONE);
+#else
+	static uint32_t slaveSelect;
+	CHECK(PCF2131_Initialize(&s_rtc, &Mock_SPI_Driver, 0, &slaveSelect) == SENSOR_ERROR_NONE);
+#endif
+	PCF2131_IPC_ServerStart(&s_ipc);
+
+	while (!s_stop)
+	{
+		asked = __atomic_load_n(&s_ticksAsked, __ATOMIC_ACQUIRE);
+		if (s_ticksDone != asked)
+		{
+			rtc_interrupt(++s_ticksDone);
+		}
+		if (PCF2131_IPC_ServerRun(&s_rtc, &s_ipc))
+		{
+			continue;
+		}
+		/*! WFI, the doorbell latches a ring that came after the queues were looked at */
+		while (!s_stop && !take_doorbell(IPC_TEST_CORE1) &&
+			   (s_ticksDone == __atomic_load_n(&s_ticksAsked, __ATOMIC_ACQUIRE)))
+		{
+			usleep(20);
+		}
+	}
+
+	return NULL;
+}
+
+static uint64_t now_ms(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t)now.tv_sec * 1000U + (uint64_t)now.tv_nsec / 1000000U;
+}
+
+/* Waits until core 1 raised the RTC interrupts asked for. */
+static void wait_ticks(void)
+{
+	uint64_t start = now_ms();
+
+	while ((s_ticksDone != __atomic_load_n(&s_ticksAsked, __ATOMIC_ACQUIRE)) && (now_ms() - start < IPC_TEST_WAIT_MS))
+	{
+		usleep(100);
+	}
+}
+
+/* Core 0 view of the published time: the copy is whole, its epoch is the decoded time. */
+static void check_time(uint32_t *pReads)
+{
+	pcf2131_timedata_t time;
+	int64_t epoch_ms;
+
+	if (PCF2131_IPC_GetTime(&s_ipc, &time, &epoch_ms))
+	{
+		CHECK(PCF2131_TimeToMs(&time) == epoch_ms);
+		(*pReads)++;
+	}
+}
+
+/* A request of each type in turn, an unknown type among them, tagged with i. */
+static void make_request(uint32_t i, pcf2131_ipcmsg_t *pMsg)
+{
+	static const uint8_t types[] = {PCF2131_IPC_SET_TIME, PCF2131_IPC_SET_ALARM, PCF2131_IPC_ALARM_ENABLE,
+			PCF2131_IPC_TS_ENABLE, 0x40};
+
+	memset(pMsg, 0, sizeof(*pMsg));
+	pMsg->type = types[i % sizeof(types)];
+	pMsg->tag = (uint8_t)i;
+	s_expect[pMsg->tag] = (0x40 == pMsg->type) ? SENSOR_ERROR_INVALID_PARAM : SENSOR_ERROR_NONE;
+	switch (pMsg->type)
+	{
+	case PCF2131_IPC_SET_TIME:
+		pMsg->data.time.second = (uint8_t)(i % 60U);
+		pMsg->data.time.minutes = 30;
+		pMsg->data.time.hours = 12;
+		pMsg->data.time.days = 15;
+		pMsg->data.time.weekdays = 6;
+		pMsg->data.time.months = 6;
+		pMsg->data.time.years = 24;
+		pMsg->data.time.ampm = h24;
+		break;
+	case PCF2131_IPC_SET_ALARM:
+		pMsg->data.alarm.second = (uint8_t)(i % 60U);
+		pMsg->data.alarm.minutes = 45;
+		pMsg->data.alarm.hours = 7;
+		pMsg->data.alarm.days = 1;
+		pMsg->data.alarm.weekdays = 1;
+		pMsg->data.alarm.ampm = h24;
+		break;
+	case PCF2131_IPC_ALARM_ENABLE:
+		pMsg->data.enable.intSrc = IntA;
+		pMsg->data.enable.alarmType = (AlarmType)0;
+		break;
+	case PCF2131_IPC_TS_ENABLE:
+		pMsg->data.enable.intSrc = IntB;
+		pMsg->data.enable.tsnum = (SwTsNum)((i / 5U) % 4U);
+		break;
+	default:
+		break;
+	}
+}
+
+typedef struct
+{
+	uint32_t replies;
+	uint32_t timestamps;
+	uint32_t alarms;
+	uint32_t outOfOrder;
+	uint32_t badStatus;
+	uint8_t nextTag;
+} ipc_events_t;
+
+/* Takes the events pending, replies must come in request order with the status of their type. */
+static void take_events(ipc_events_t *pEvents)
+{
+	pcf2131_ipcmsg_t msg;
+
+	while (PCF2131_IPC_GetEvent(&s_ipc, &msg))
+	{
+		if (PCF2131_IPC_REPLY == msg.type)
+		{
+			pEvents->outOfOrder += (msg.tag != pEvents->nextTag);
+			pEvents->badStatus += (msg.status != s_expect[msg.tag]);
+			pEvents->nextTag = (uint8_t)(msg.tag + 1U);
+			pEvents->replies++;
+		}
+		else if (PCF2131_IPC_TIMESTAMP == msg.type)
+		{
+			CHECK((msg.status == SENSOR_ERROR_NONE) && (msg.data.ts.tsnum == sw1Ts));
+			pEvents->timestamps++;
+		}
+		else
+		{
+			CHECK((msg.type == PCF2131_IPC_ALARM) && (msg.status == SENSOR_ERROR_NONE));
+			pEvents->alarms++;
+		}
+	}
+}
+
+/* Requests of every type while core 1 takes RTC interrupts, core 0 reading the time throughout and taking
+ * events as they come: nothing is lost. */
+static void test_requests(void)
+{
+	ipc_events_t events = {0};
+	pcf2131_ipcmsg_t msg;
+	uint32_t sent = 0, reads = 0, full = 0;
+	uint64_t start = now_ms();
+
+	while ((events.replies < IPC_TEST_REQUESTS) && (now_ms() - start < IPC_TEST_WAIT_MS))
+	{
+		if ((sent < IPC_TEST_REQUESTS) && (sent - events.replies < IPC_TEST_IN_FLIGHT))
+		{
+			make_request(sent, &msg);
+			if (PCF2131_IPC_Request(&s_ipc, &msg))
+			{
+				/*! An RTC interrupt every 8 requests */
+				sent++;
+				if ((sent % 8U) == 0)
+				{
+					__atomic_add_fetch(&s_ticksAsked, 1, __ATOMIC_RELEASE);
+				}
+			}
+			else
+			{
+				full++;
+			}
+		}
+		check_time(&reads);
+		take_events(&events);
+	}
+	/*! The journal of the last RTC interrupts */
+	wait_ticks();
+	usleep(10000);
+	take_events(&events);
+
+	printf("ipc_test: %u requests (%u refused by a full queue), %u replies, %u timestamps, %u alarms, %u time reads\n",
+		   sent, full, events.replies, events.timestamps, events.alarms, reads);
+	CHECK(events.replies == IPC_TEST_REQUESTS);
+	CHECK((events.outOfOrder == 0) && (events.badStatus == 0));
+	CHECK((events.timestamps == s_ticksDone / 4U) && (events.alarms == s_ticksDone / 8U));
+	CHECK(s_ipc.event.dropped == 0);
+	CHECK(reads > 0);
+	/*! Core 1 rang core 0 for its events */
+	CHECK(take_doorbell(IPC_TEST_CORE0));
+}
+
+/* Core 0 stops taking events, the journal fills the event queue but for the reply slot, then a queue full of
+ * requests: none of the replies may be lost. */
+static void test_full_journal(void)
+{
+	ipc_events_t events = {0};
+	pcf2131_ipcmsg_t msg;
+	uint32_t i, dropped, sent = 0;
+	uint64_t start;
+
+	/*! Fill the journal, timestamps every 4th interrupt */
+	dropped = s_ipc.event.dropped;
+	start = now_ms();
+	while ((s_ipc.event.dropped == dropped) && (now_ms() - start < IPC_TEST_WAIT_MS))
+	{
+		__atomic_add_fetch(&s_ticksAsked, 4, __ATOMIC_RELEASE);
+		wait_ticks();
+	}
+	CHECK(s_ipc.event.head - s_ipc.event.tail == PCF2131_IPC_QUEUE_SIZE - PCF2131_IPC_REPLY_SLOTS);
+
+	/*! A request per slot of the request queue, the first reply takes the reserved slot, the rest wait */
+	for (i = 0; i < PCF2131_IPC_QUEUE_SIZE; i++)
+	{
+		make_request(i, &msg);
+		sent += PCF2131_IPC_Request(&s_ipc, &msg);
+	}
+	usleep(20000);
+	dropped = s_ipc.event.dropped;
+	CHECK(s_ipc.event.head - s_ipc.event.tail == PCF2131_IPC_QUEUE_SIZE);
+	CHECK(s_ipc.request.head - s_ipc.request.tail == PCF2131_IPC_QUEUE_SIZE - 1U);
+
+	/*! Draining the events lets core 1 run the rest */
+	start = now_ms();
+	while ((events.replies < sent) && (now_ms() - start < IPC_TEST_WAIT_MS))
+	{
+		take_events(&events);
+		usleep(100);
+	}
+
+	printf("ipc_test: full journal: %u journal entries dropped, %u requests, %u replies\n", dropped, sent,
+		   events.replies);
+	CHECK(sent == PCF2131_IPC_QUEUE_SIZE);
+	CHECK((events.replies == sent) && (events.outOfOrder == 0) && (events.badStatus == 0));
+	CHECK(s_ipc.event.dropped == dropped);
+}
+
+int main(void)
+{
+	pthread_t thread;
+	uint64_t start;
+
+	Mock_Bus_Reset();
+	PCF2131_IPC_Init(&s_ipc);
+	CHECK(pthread_create(&thread, NULL, core1, NULL) == 0);
+	start = now_ms();
+	while (!s_ipc.ready && (now_ms() - start < IPC_TEST_WAIT_MS))
+	{
+		usleep(100);
+	}
+	CHECK(s_ipc.ready);
+
+	test_requests();
+	test_full_journal();
+
+	s_stop = true;
+	pthread_join(thread, NULL);
+
+	printf("ipc_test: %s\n", s_failures ? "FAIL" : "PASS");
+	return s_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
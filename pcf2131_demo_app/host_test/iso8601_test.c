@@ -0,0 +1,221 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file iso8601_test.c
+ * @brief Host test of rtc/pcf2131_iso8601.c: format/parse round trips in both hour modes, RFC-3339
+ *        offsets checked against the C library across day, month, year and leap day boundaries,
+ *        rejection of trailing text and out of range fields, and every prefix of a valid string
+ *        parsed from an exact size heap copy so AddressSanitizer catches a read past the terminator.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "pcf2131_iso8601.h"
+
+#define CHECK(cond)                                                          \
+	do                                                                       \
+	{                                                                        \
+		if (!(cond))                                                         \
+		{                                                                    \
+			printf("iso8601_test: %s:%d: %s\n", __FILE__, __LINE__, #cond);  \
+			s_failures++;                                                    \
+		}                                                                    \
+	} while (0)
+
+static uint32_t s_failures;
+
+/* Parses from a heap copy of exactly strlen + 1 bytes. */
+static int32_t parse(const char *pStr, Mode12h_24h mode, pcf2131_timedata_t *time)
+{
+	size_t len = strlen(pStr) + 1;
+	char *pCopy = malloc(len);
+	int32_t status;
+
+	memcpy(pCopy, pStr, len);
+	status = PCF2131_Iso_ParseTime(pCopy, mode, time);
+	free(pCopy);
+
+	return status;
+}
+
+static bool same_utc(const pcf2131_timedata_t *time, time_t utc)
+{
+	struct tm tm;
+
+	gmtime_r(&utc, &tm);
+	return (time->years == tm.tm_year - 100) && (time->months == tm.tm_mon + 1) && (time->days == tm.tm_mday) &&
+			(PCF2131_Iso_Hours24(time->hours, time->ampm) == tm.tm_hour) && (time->minutes == tm.tm_min) &&
+			(time->second == tm.tm_sec) && (time->weekdays == tm.tm_wday);
+}
+
+/* Local time string of utc at the given offset in minutes, as a client would send it. */
+static void make_iso(char *pBuf, time_t utc, int32_t offset)
+{
+	time_t local = utc + (time_t)offset * 60;
+	struct tm tm;
+	int32_t magnitude = (offset < 0) ? -offset : offset;
+
+	gmtime_r(&local, &tm);
+	sprintf(pBuf, "%04d-%02d-%02dT%02d:%02d:%02d%c%02d:%02d", tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday,
+			tm.tm_hour, tm.tm_min, tm.tm_sec, (offset < 0) ? '-' : '+', magnitude / 60, magnitude % 60);
+}
+
+static time_t utc_of(int year, int month, int day, int hour, int minute, int second)
+{
+	struct tm tm = {.tm_year = year - 1900, .tm_mon = month - 1, .tm_mday = day,
+			.tm_hour = hour, .tm_min = minute, .tm_sec = second};
+
+	return timegm(&tm);
+}
+
+static void test_round_trip(void)
+{
+	static const char *const valid[] = {"2000-01-01T00:00:00.00", "2024-02-29T23:59:59.99", "2099-12-31T12:00:00.50",
+			"2023-07-04T00:30:15.07"};
+	pcf2131_timedata_t time;
+	char iso[PCF2131_ISO_TIME_LEN + 1];
+	uint32_t i;
+
+	for (i = 0; i < sizeof(valid) / sizeof(valid[0]); i++)
+	{
+		CHECK(parse(valid[i], mode24H, &time) == SENSOR_ERROR_NONE);
+		CHECK(PCF2131_Iso_FormatTime(&time, iso) == PCF2131_ISO_TIME_LEN);
+		CHECK(strcmp(iso, valid[i]) == 0);
+
+		/* The same instant through 12 hour mode. */
+		CHECK(parse(valid[i], mode12H, &time) == SENSOR_ERROR_NONE);
+		CHECK((time.ampm != h24) && (time.hours >= 1) && (time.hours <= 12));
+		PCF2131_Iso_FormatTime(&time, iso);
+		CHECK(strcmp(iso, valid[i]) == 0);
+	}
+
+	CHECK(PCF2131_Iso_Hours24(12, AM) == 0);
+	CHECK(PCF2131_Iso_Hours24(12, PM) == 12);
+	CHECK(PCF2131_Iso_Hours24(1, PM) == 13);
+	CHECK(PCF2131_Iso_Hours24(23, h24) == 23);
+
+	/* Space separator, Z, fraction of one and of many digits. */
+	CHECK(parse("2024-03-01 10:00:00Z", mode24H, &time) == SENSOR_ERROR_NONE);
+	CHECK(parse("2024-03-01T10:00:00.5", mode24H, &time) == SENSOR_ERROR_NONE && time.second_100th == 50);
+	CHECK(parse("2024-03-01T10:00:00.123456+00:00", mode24H, &time) == SENSOR_ERROR_NONE &&
+			time.second_100th == 12);
+	CHECK(same_utc(&time, utc_of(2024, 3, 1, 10, 0, 0)));
+}
+
+static void test_offsets(void)
+{
+	static const int32_t offsets[] = {0, 60, 120, -300, -330, 330, 345, 840, -720, 1439, -1439};
+	static const int fixed[][6] = {{2000, 1, 1, 0, 0, 0}, {2099, 12, 31, 23, 59, 59}, {2024, 2, 29, 0, 30, 0},
+			{2023, 12, 31, 23, 0, 0}, {2024, 3, 1, 0, 0, 0}, {2021, 1, 1, 4, 59, 59}};
+	pcf2131_timedata_t time;
+	char iso[64];
+	uint32_t i, j;
+	uint32_t checked = 0;
+
+	/* Boundaries: the UTC instant is inside the range, the local text may not be. */
+	for (i = 0; i < sizeof(fixed) / sizeof(fixed[0]); i++)
+	{
+		time_t utc = utc_of(fixed[i][0], fixed[i][1], fixed[i][2], fixed[i][3], fixed[i][4], fixed[i][5]);
+
+		for (j = 0; j < sizeof(offsets) / sizeof(offsets[0]); j++)
+		{
+			make_iso(iso, utc, offsets[j]);
+			if (strncmp(iso, "20", 2) != 0)
+			{
+				continue;
+			}
+			CHECK(parse(iso, mode24H, &time) == SENSOR_ERROR_NONE);
+			CHECK(same_utc(&time, utc));
+			checked++;
+		}
+	}
+
+	/* Random instants and offsets over the whole century. */
+	srand(2131);
+	for (i = 0; i < 200000; i++)
+	{
+		time_t first = utc_of(2000, 1, 1, 0, 0, 0);
+		time_t span = utc_of(2100, 1, 1, 0, 0, 0) - first;
+		time_t utc = first + (time_t)(((uint64_t)rand() << 16 ^ (uint64_t)rand()) % (uint64_t)span);
+		int32_t offset = (rand() % 2879) - 1439;
+		bool inRange;
+
+		make_iso(iso, utc, offset);
+		inRange = (strncmp(iso, "20", 2) == 0);
+		if (!inRange)
+		{
+			CHECK(parse(iso, mode24H, &time) == SENSOR_ERROR_INVALID_PARAM);
+			continue;
+		}
+		CHECK(parse(iso, (i & 1) ? mode12H : mode24H, &time) == SENSOR_ERROR_NONE);
+		CHECK(same_utc(&time, utc));
+		checked++;
+	}
+
+	/* Instants outside the century are rejected even when the local text is inside. */
+	CHECK(parse("2000-01-01T00:30:00+01:00", mode24H, &time) == SENSOR_ERROR_INVALID_PARAM);
+	CHECK(parse("2099-12-31T20:00:00-05:00", mode24H, &time) == SENSOR_ERROR_INVALID_PARAM);
+	CHECK(parse("2000-01-01T00:30:00-01:00", mode24H, &time) == SENSOR_ERROR_NONE);
+	CHECK(parse("2099-12-31T20:00:00+05:00", mode24H, &time) == SENSOR_ERROR_NONE);
+
+	printf("iso8601_test: %u offset cases checked\n", checked);
+}
+
+static void test_reject(void)
+{
+	static const char *const invalid[] = {"", "2", "20", "2024-02-30T00:00:00", "2023-02-29T00:00:00",
+			"2024-13-01T00:00:00", "2024-00-01T00:00:00", "2024-01-00T00:00:00", "2024-01-01T24:00:00",
+			"2024-01-01T00:60:00", "2024-01-01T00:00:60", "2100-01-01T00:00:00", "1999-12-31T23:59:59",
+			"2024-01-01X00:00:00", "2024-01-01T00:00:00junk", "2024-01-01T00:00:00.", "2024-01-01T00:00:00.5x",
+			"2024-01-01T00:00:00Zjunk", "2024-01-01T00:00:00+01", "2024-01-01T00:00:00+01:0",
+			"2024-01-01T00:00:00+0100", "2024-01-01T00:00:00+24:00", "2024-01-01T00:00:00+01:60",
+			"2024-01-01T00:00:00+01:00:00", "2024-01-01T00:00:00 ", "2024-01-01T00:00:00z"};
+	static const char *const full = "2024-02-29T12:34:56.789+05:30";
+	pcf2131_timedata_t time;
+	char prefix[64];
+	uint32_t i;
+
+	for (i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++)
+	{
+		CHECK(parse(invalid[i], mode24H, &time) == SENSOR_ERROR_INVALID_PARAM);
+	}
+	CHECK(PCF2131_Iso_ParseTime(NULL, mode24H, &time) == SENSOR_ERROR_INVALID_PARAM);
+	CHECK(PCF2131_Iso_ParseTime(full, mode24H, NULL) == SENSOR_ERROR_INVALID_PARAM);
+
+	/* Every prefix is either a complete time or rejected, none reads past its terminator. */
+	for (i = 0; i <= strlen(full); i++)
+	{
+		int32_t status;
+
+		memcpy(prefix, full, i);
+		prefix[i] = '\0';
+		status = parse(prefix, mode24H, &time);
+		if ((i == 19) || (i == 21) || (i == 22) || (i == 23) || (i == strlen(full)))
+		{
+			CHECK(status == SENSOR_ERROR_NONE);
+		}
+		else
+		{
+			CHECK(status == SENSOR_ERROR_INVALID_PARAM);
+		}
+	}
+	CHECK(strlen(full) <= PCF2131_ISO_INPUT_MAX_LEN);
+}
+
+int main(void)
+{
+	test_round_trip();
+	test_offsets();
+	test_reject();
+
+	printf("iso8601_test: %s\n", (s_failures == 0) ? "PASS" : "FAIL");
+	return (s_failures == 0) ? 0 : 1;
+}
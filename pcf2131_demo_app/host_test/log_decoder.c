@@ -0,0 +1,345 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file log_decoder.c
+ * @brief Host decoder of the LOG_TOKEN() records, see log_decoder.h.
+ */
+
+#include <elf.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "log_decoder.h"
+
+#define LOG_DECODER_SYNC (0xFE)
+
+static uint32_t log_word(const uint8_t *p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/* Collects the sections of a 32 or 64 bit ELF, the layouts differ but not the fields needed. */
+static int log_load_sections(log_decoder_t *pDecoder)
+{
+	const uint8_t *pImage = pDecoder->pImage;
+	const char *pNames;
+	uint64_t shoff, offset, size, addr;
+	uint32_t shnum, shstrndx, shentsize, type, name;
+	bool is64;
+
+	if ((pDecoder->imageSize < EI_NIDENT) || memcmp(pImage, ELFMAG, SELFMAG) || (pImage[EI_DATA] != ELFDATA2LSB))
+	{
+		return -1;
+	}
+	is64 = (pImage[EI_CLASS] == ELFCLASS64);
+	if (is64)
+	{
+		const Elf64_Ehdr *pEh = (const Elf64_Ehdr *)pImage;
+		shoff = pEh->e_shoff;
+		shnum = pEh->e_shnum;
+		shstrndx = pEh->e_shstrndx;
+		shentsize = pEh->e_shentsize;
+	}
+	else
+	{
+		const Elf32_Ehdr *pEh = (const Elf32_Ehdr *)pImage;
+		shoff = pEh->e_shoff;
+		shnum = pEh->e_shnum;
+		shstrndx = pEh->e_shstrndx;
+		shentsize = pEh->e_shentsize;
+	}
+	if ((shnum == 0) || (shstrndx >= shnum) || (shoff + (uint64_t)shnum * shentsize > pDecoder->imageSize))
+	{
+		return -1;
+	}
+
+	pDecoder->pSections = calloc(shnum, sizeof(log_decoder_section_t));
+	if (pDecoder->pSections == NULL)
+	{
+		return -1;
+	}
+	pNames = NULL;
+	for (int pass = 0; pass < 2; pass++)
+	{
+		for (uint32_t i = 0; i < shnum; i++)
+		{
+			const uint8_t *pSh = pImage + shoff + (uint64_t)i * shentsize;
+
+			if (is64)
+			{
+				const Elf64_Shdr *pS = (const Elf64_Shdr *)pSh;
+				type = pS->sh_type, name = pS->sh_name, addr = pS->sh_addr, offset = pS->sh_offset, size = pS->sh_size;
+			}
+			else
+			{
+				const Elf32_Shdr *pS = (const Elf32_Shdr *)pSh;
+				type = pS->sh_type, name = pS->sh_name, addr = pS->sh_addr, offset = pS->sh_offset, size = pS->sh_size;
+			}
+			if ((type == SHT_NOBITS) || (offset + size > pDecoder->imageSize))
+			{
+				continue;
+			}
+			/*! First pass: the section name table only */
+			if (pass == 0)
+			{
+				if (i == shstrndx)
+				{
+					pNames = (const char *)pImage + offset;
+				}
+				continue;
+			}
+			if ((pNames != NULL) && !strcmp(pNames + name, ".log_fmt"))
+			{
+				pDecoder->fmt = (log_decoder_section_t){.addr = addr, .size = size, .pData = pImage + offset};
+			}
+			if ((addr != 0) && (type == SHT_PROGBITS))
+			{
+				pDecoder->pSections[pDecoder->nSections++] =
+					(log_decoder_section_t){.addr = addr, .size = size, .pData = pImage + offset};
+			}
+		}
+	}
+
+	return (pDecoder->fmt.pData != NULL) ? 0 : -1;
+}
+
+int LogDecoder_Open(log_decoder_t *pDecoder, const char *pElfPath, uint32_t tickHz)
+{
+	FILE *pFile = fopen(pElfPath, "rb");
+	long size;
+
+	memset(pDecoder, 0, sizeof(*pDecoder));
+	pDecoder->tickHz = tickHz;
+	if (pFile == NULL)
+	{
+		return -1;
+	}
+	fseek(pFile, 0, SEEK_END);
+	size = ftell(pFile);
+	fseek(pFile, 0, SEEK_SET);
+	pDecoder->pImage = (size > 0) ? malloc((size_t)size) : NULL;
+	if ((pDecoder->pImage == NULL) || (fread(pDecoder->pImage, 1, (size_t)size, pFile) != (size_t)size))
+	{
+		fclose(pFile);
+		LogDecoder_Close(pDecoder);
+		return -1;
+	}
+	fclose(pFile);
+	pDecoder->imageSize = (size_t)size;
+
+	if (log_load_sections(pDecoder) != 0)
+	{
+		LogDecoder_Close(pDecoder);
+		return -1;
+	}
+	return 0;
+}
+
+void LogDecoder_Close(log_decoder_t *pDecoder)
+{
+	free(pDecoder->pSections);
+	free(pDecoder->pImage);
+	pDecoder->pSections = NULL;
+	pDecoder->pImage = NULL;
+}
+
+/* The terminated string at addr in the section, NULL if it is not there. */
+static const char *log_string_in(const log_decoder_section_t *pSection, uint64_t addr)
+{
+	if ((pSection->pData == NULL) || (addr < pSection->addr) || (addr >= pSection->addr + pSection->size))
+	{
+		return NULL;
+	}
+	if (memchr(pSection->pData + (addr - pSection->addr), '\0', pSection->addr + pSection->size - addr) == NULL)
+	{
+		return NULL;
+	}
+	return (const char *)pSection->pData + (addr - pSection->addr);
+}
+
+static const char *log_string(const log_decoder_t *pDecoder, uint32_t addr)
+{
+	const char *pStr;
+
+	for (uint32_t i = 0; i < pDecoder->nSections; i++)
+	{
+		pStr = log_string_in(&pDecoder->pSections[i], addr);
+		if (pStr != NULL)
+		{
+			return pStr;
+		}
+	}
+	return NULL;
+}
+
+int LogDecoder_Format(const log_decoder_t *pDecoder, const char *pFmt, const uint32_t *pArgs, uint32_t nArgs,
+					  char *pOut, size_t size)
+{
+	char spec[32];
+	size_t len = 0, specLen;
+	uint32_t arg = 0, value;
+	const char *pStr;
+	int n;
+
+#define LOG_APPEND(...)                                                                \
+	do                                                                                 \
+	{                                                                                  \
+		n = snprintf(pOut + len, (len < size) ? size - len : 0, __VA_ARGS__);          \
+		len += (n > 0) ? (size_t)n : 0;                                                \
+	} while (0)
+
+	while (*pFmt)
+	{
+		if (*pFmt != '%')
+		{
+			LOG_APPEND("%c", *pFmt++);
+			continue;
+		}
+		if (pFmt[1] == '%')
+		{
+			LOG_APPEND("%%");
+			pFmt += 2;
+			continue;
+		}
+
+		/*! Copy flags, width and precision, drop the length modifiers: every argument is one word */
+		specLen = 0;
+		spec[specLen++] = *pFmt++;
+		while (*pFmt && strchr("-+ #0123456789.", *pFmt) && (specLen < sizeof(spec) - 2))
+		{
+			spec[specLen++] = *pFmt++;
+		}
+		while (*pFmt && strchr("hlzjt", *pFmt))
+		{
+			pFmt++;
+		}
+		if (*pFmt == '\0')
+		{
+			break;
+		}
+		spec[specLen++] = *pFmt;
+		spec[specLen] = '\0';
+
+		if (arg >= nArgs)
+		{
+			LOG_APPEND("<missing>");
+			pFmt++;
+			continue;
+		}
+		value = pArgs[arg++];
+		switch (*pFmt++)
+		{
+		case 'd':
+		case 'i':
+			LOG_APPEND(spec, (int32_t)value);
+			break;
+		case 'u':
+		case 'x':
+		case 'X':
+		case 'o':
+			LOG_APPEND(spec, value);
+			break;
+		case 'c':
+			LOG_APPEND(spec, (int)value);
+			break;
+		case 's':
+			pStr = log_string(pDecoder, value);
+			if (pStr != NULL)
+			{
+				LOG_APPEND(spec, pStr);
+			}
+			else
+			{
+				LOG_APPEND("<string 0x%08X>", value);
+			}
+			break;
+		case 'p':
+			LOG_APPEND("0x%08X", value);
+			break;
+		default:
+			LOG_APPEND("<%s?>", spec);
+			break;
+		}
+	}
+#undef LOG_APPEND
+
+	return (int)len;
+}
+
+/* Expands one complete record. */
+static void log_expand(log_decoder_t *pDecoder, FILE *pOut)
+{
+	char text[1024];
+	uint32_t nWords = pDecoder->record[1];
+	uint32_t args[LOG_DECODER_MAX_RECORD / 4];
+	uint32_t token = log_word(&pDecoder->record[2]);
+	uint32_t stamp = log_word(&pDecoder->record[6]);
+	const char *pFmt = log_string_in(&pDecoder->fmt, token);
+
+	for (uint32_t i = 2; i < nWords; i++)
+	{
+		args[i - 2] = log_word(&pDecoder->record[2 + 4 * i]);
+	}
+
+	/*! The 32 bit time stamp wraps, extend it assuming records come more often than a wrap */
+	pDecoder->ticks += (uint32_t)(stamp - pDecoder->lastTicks);
+	if (pDecoder->records + pDecoder->badRecords == 0)
+	{
+		pDecoder->ticks = stamp;
+	}
+	pDecoder->lastTicks = stamp;
+
+	if (pFmt == NULL)
+	{
+		pDecoder->badRecords++;
+		fprintf(pOut, "<unknown log token 0x%08X>", token);
+		return;
+	}
+	pDecoder->records++;
+	LogDecoder_Format(pDecoder, pFmt, args, nWords - 2, text, sizeof(text));
+	if (pDecoder->tickHz)
+	{
+		fprintf(pOut, "[%12.6f] ", (double)pDecoder->ticks / pDecoder->tickHz);
+	}
+	fputs(text, pOut);
+}
+
+void LogDecoder_Feed(log_decoder_t *pDecoder, const uint8_t *pData, size_t length, FILE *pOut)
+{
+	for (size_t i = 0; i < length; i++)
+	{
+		if (pDecoder->recordLen == 0)
+		{
+			if (pData[i] == LOG_DECODER_SYNC)
+			{
+				pDecoder->record[pDecoder->recordLen++] = pData[i];
+			}
+			else
+			{
+				fputc(pData[i], pOut);
+			}
+			continue;
+		}
+
+		pDecoder->record[pDecoder->recordLen++] = pData[i];
+		/*! A word count out of range is not a record, pass the bytes through */
+		if ((pDecoder->recordLen == 2) &&
+			((pData[i] < 2) || (2 + 4 * (uint32_t)pData[i] > LOG_DECODER_MAX_RECORD)))
+		{
+			pDecoder->badRecords++;
+			fwrite(pDecoder->record, 1, 2, pOut);
+			pDecoder->recordLen = 0;
+			continue;
+		}
+		if ((pDecoder->recordLen > 2) && (pDecoder->recordLen == 2 + 4 * (uint32_t)pDecoder->record[1]))
+		{
+			log_expand(pDecoder, pOut);
+			pDecoder->recordLen = 0;
+		}
+	}
+}
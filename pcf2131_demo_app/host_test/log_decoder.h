@@ -0,0 +1,63 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file log_decoder.h
+ * @brief Host decoder of the LOG_TOKEN() records (utilities/log_token.h). The firmware ELF is the
+ *        dictionary: a record token is the address of its format string in the .log_fmt section, a %s
+ *        argument the address of a string in any loaded section. Console text around the records is
+ *        passed through unchanged, so a raw capture of the debug console expands to the text PRINTF()
+ *        would have sent.
+ */
+
+#ifndef LOG_DECODER_H_
+#define LOG_DECODER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/*! @brief Longest record: sync, word count, token, time stamp and LOG_TOKEN_MAX_ARGS words. */
+#define LOG_DECODER_MAX_RECORD (2 + (2 + 6) * 4)
+
+typedef struct
+{
+	uint64_t addr;
+	uint64_t size;
+	const uint8_t *pData;                            /* NULL for a section without file content. */
+} log_decoder_section_t;
+
+typedef struct
+{
+	uint8_t *pImage;                                 /* The ELF file. */
+	size_t imageSize;
+	log_decoder_section_t fmt;                       /* .log_fmt */
+	log_decoder_section_t *pSections;                /* Every section with file content. */
+	uint32_t nSections;
+	uint32_t tickHz;                                 /* Time stamp rate, 0 prints no time stamps. */
+	uint32_t lastTicks;
+	uint64_t ticks;                                  /* Time stamp extended past the 32 bit wrap. */
+	uint8_t record[LOG_DECODER_MAX_RECORD];
+	uint32_t recordLen;                              /* Bytes of a record collected so far. */
+	uint32_t records;                                /* Records expanded. */
+	uint32_t badRecords;                             /* Records with an unknown token or word count. */
+} log_decoder_t;
+
+/*! @brief Loads the dictionary from an ELF (32 or 64 bit, little endian).
+ *  @return 0, -1 if the file cannot be read or has no .log_fmt section. */
+int LogDecoder_Open(log_decoder_t *pDecoder, const char *pElfPath, uint32_t tickHz);
+
+void LogDecoder_Close(log_decoder_t *pDecoder);
+
+/*! @brief Feeds captured console bytes, records may be split across calls.
+ *         Writes the text and the expanded records to pOut. */
+void LogDecoder_Feed(log_decoder_t *pDecoder, const uint8_t *pData, size_t length, FILE *pOut);
+
+/*! @brief Expands one format string with its argument words into pOut (snprintf semantics). */
+int LogDecoder_Format(const log_decoder_t *pDecoder, const char *pFmt, const uint32_t *pArgs, uint32_t nArgs,
+					  char *pOut, size_t size);
+
+#endif /* LOG_DECODER_H_ */
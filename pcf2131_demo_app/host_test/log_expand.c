@@ -0,0 +1,63 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file log_expand.c
+ * @brief Expands a debug console capture of a LOG_TOKEN_ENABLE build into text, with the firmware ELF
+ *        as the dictionary (log_decoder.h).
+ *
+ *   log_expand [-f tick_hz] <firmware.axf> [capture]        capture defaults to stdin, e.g. a tty
+ *
+ * With -f (the core clock the systick counts at) every record is prefixed with its time in seconds.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "log_decoder.h"
+
+int main(int argc, char **argv)
+{
+	log_decoder_t decoder;
+	uint8_t buffer[4096];
+	uint32_t tickHz = 0;
+	FILE *pIn = stdin;
+	ssize_t n;
+	int arg = 1;
+
+	if ((argc > arg + 1) && !strcmp(argv[arg], "-f"))
+	{
+		tickHz = (uint32_t)strtoul(argv[arg + 1], NULL, 0);
+		arg += 2;
+	}
+	if (argc <= arg)
+	{
+		fprintf(stderr, "usage: log_expand [-f tick_hz] <firmware.axf> [capture]\n");
+		return EXIT_FAILURE;
+	}
+	if (LogDecoder_Open(&decoder, argv[arg], tickHz) != 0)
+	{
+		fprintf(stderr, "%s: cannot read, or no .log_fmt section (a LOG_TOKEN_ENABLE build?)\n", argv[arg]);
+		return EXIT_FAILURE;
+	}
+	if ((argc > arg + 1) && ((pIn = fopen(argv[arg + 1], "rb")) == NULL))
+	{
+		perror(argv[arg + 1]);
+		return EXIT_FAILURE;
+	}
+
+	/*! Unbuffered reads so a live console is expanded as it arrives */
+	while ((n = read(fileno(pIn), buffer, sizeof(buffer))) > 0)
+	{
+		LogDecoder_Feed(&decoder, buffer, (size_t)n, stdout);
+		fflush(stdout);
+	}
+
+	fprintf(stderr, "log_expand: %u records, %u bad\n", decoder.records, decoder.badRecords);
+	LogDecoder_Close(&decoder);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file log_token_test.c
+ * @brief Host test of tokenized logging end to end: LOG_TOKEN() records written by the unchanged
+ *        utilities/log_token.c, mixed with console text, are expanded by log_decoder.c with this
+ *        executable as the dictionary and must match what printf() makes of the same calls. The
+ *        capture is fed in random pieces so records split across reads. Reports the bytes saved.
+ *        Built without PIE so addresses fit the 32 bit tokens, as on the target.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "log_token.h"
+#include "log_decoder.h"
+
+static uint8_t s_wire[16384];
+static size_t s_wireLen;
+static char s_expected[16384];
+static size_t s_expectedLen;
+static size_t s_textLen;                            /* Console text bytes, the rest of s_wire are records. */
+static uint32_t s_failures;
+
+/* The asynchronous console of the target, the capture here. */
+int DbgConsole_AsyncWrite(const uint8_t *pData, uint32_t length)
+{
+	memcpy(&s_wire[s_wireLen], pData, length);
+	s_wireLen += length;
+	return (int)length;
+}
+
+static void console_text(const char *pText)
+{
+	DbgConsole_AsyncWrite((const uint8_t *)pText, (uint32_t)strlen(pText));
+	s_textLen += strlen(pText);
+	s_expectedLen += (size_t)sprintf(&s_expected[s_expectedLen], "%s", pText);
+}
+
+/* One LOG_TOKEN() call and the text printf() makes of it. */
+#define LOG_CASE(fmt, ...)                                                                       \
+	do                                                                                           \
+	{                                                                                            \
+		LOG_TOKEN(fmt, ##__VA_ARGS__);                                                           \
+		s_expectedLen += (size_t)sprintf(&s_expected[s_expectedLen], fmt, ##__VA_ARGS__);        \
+	} while (0)
+
+static void log_calls(void)
+{
+	static const char *const pDays[] = {"Sunday", "Monday"};
+
+	console_text("\r\n Enter your choice :- ");
+	LOG_CASE("\r\n Interrupt Occurred on INTA Pin....Please Clear the interrupt\r\n");
+	LOG_CASE("\r\n Time :- %02d:%02d:%02d.%02d\r\n", 23, 59, 7, 99);
+	LOG_CASE("\r\n Date :- %d/%d/20%02d\r\n", 24, 12, 31);
+	LOG_CASE(" drift %d ppb code %d, reg 0x%02X %x %u %c%%\r\n", -1250, -7, 0xA5, 0xDEADBEEF, 4000000000U, 'k');
+	LOG_CASE("%-6d|%6u|%08X\r\n", -3, 42U, 0x1234U);
+	console_text("plain PRINTF line 0xFE-free\r\n");
+
+	/*! A %s argument is the address of a string in the ELF */
+	LOG_TOKEN("\r\n Weekday :- %s\r\n", (uint32_t)(uintptr_t)pDays[1]);
+	s_expectedLen += (size_t)sprintf(&s_expected[s_expectedLen], "\r\n Weekday :- %s\r\n", pDays[1]);
+
+	/*! Extra arguments are not sent, the decoder marks the missing one */
+	LOG_TOKEN("%d %d %d %d %d %d %d\r\n", 1, 2, 3, 4, 5, 6, 7);
+	s_expectedLen += (size_t)sprintf(&s_expected[s_expectedLen], "1 2 3 4 5 6 <missing>\r\n");
+}
+
+static void check(bool cond, const char *pWhat)
+{
+	if (!cond)
+	{
+		printf("log_token_test: %s\n", pWhat);
+		s_failures++;
+	}
+}
+
+int main(void)
+{
+	log_decoder_t decoder;
+	char *pText;
+	size_t textLen, pos, piece;
+	uint32_t records;
+	FILE *pOut;
+
+	check(LogDecoder_Open(&decoder, "/proc/self/exe", 0) == 0, "no .log_fmt section in the test executable");
+
+	log_calls();
+
+	/*! Random pieces, so records split at every possible byte */
+	srand(2131);
+	pOut = open_memstream(&pText, &textLen);
+	for (pos = 0; pos < s_wireLen; pos += piece)
+	{
+		piece = 1 + (size_t)rand() % 7;
+		piece = (piece > s_wireLen - pos) ? s_wireLen - pos : piece;
+		LogDecoder_Feed(&decoder, &s_wire[pos], piece, pOut);
+	}
+	fclose(pOut);
+	records = decoder.records;
+
+	check(decoder.recordLen == 0, "a record left incomplete");
+	check(decoder.badRecords == 0, "bad records");
+	check((textLen == s_expectedLen) && !memcmp(pText, s_expected, textLen), "expansion differs from printf");
+	if ((textLen != s_expectedLen) || memcmp(pText, s_expected, textLen))
+	{
+		printf("--- expected\n%.*s\n--- decoded\n%.*s\n", (int)s_expectedLen, s_expected, (int)textLen, pText);
+	}
+	free(pText);
+
+	/*! An unknown token and a bad word count are reported, the text after them still comes through */
+	{
+		const uint8_t bad[] = {0xFE, 2, 1, 0, 0, 0, 0, 0, 0, 0, 0xFE, 99, 'o', 'k'};
+
+		pOut = open_memstream(&pText, &textLen);
+		LogDecoder_Feed(&decoder, bad, sizeof(bad), pOut);
+		fclose(pOut);
+		check(strstr(pText, "<unknown log token 0x00000001>") != NULL, "unknown token not reported");
+		check((textLen >= 2) && !memcmp(&pText[textLen - 2], "ok", 2), "text after a bad record lost");
+		check(decoder.badRecords == 2, "bad records not counted");
+		free(pText);
+	}
+
+	printf("log_token_test: %u records, %zu bytes on the wire for %zu bytes of text (%.1fx)\n", records,
+		   s_wireLen - s_textLen, s_expectedLen - s_textLen,
+		   (double)(s_expectedLen - s_textLen) / (double)(s_wireLen - s_textLen));
+	printf("log_token_test: %s\n", s_failures ? "FAIL" : "PASS");
+	LogDecoder_Close(&decoder);
+	return s_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file loopback_serial.c
+ * @brief Host stand-in for the debug console UART, see loopback_serial.h.
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "loopback_serial.h"
+#include "debug_console_async.h"
+
+typedef struct
+{
+	uint8_t data[LOOPBACK_DEPTH];
+	uint32_t head;
+	uint32_t tail;
+	pthread_cond_t cond;
+} loopback_queue_t;
+
+static pthread_mutex_t s_lock = PTHREAD_MUTEX_INITIALIZER;
+static loopback_queue_t s_toDevice = {.cond = PTHREAD_COND_INITIALIZER};
+static loopback_queue_t s_toHost = {.cond = PTHREAD_COND_INITIALIZER};
+
+/* Waits on the queue condition, until the absolute deadline when there is one. */
+static int loopback_wait(loopback_queue_t *pQueue, const struct timespec *pDeadline)
+{
+	if (pDeadline == NULL)
+	{
+		return pthread_cond_wait(&pQueue->cond, &s_lock);
+	}
+	return pthread_cond_timedwait(&pQueue->cond, &s_lock, pDeadline);
+}
+
+static void loopback_put(loopback_queue_t *pQueue, uint8_t byte)
+{
+	while (pQueue->head - pQueue->tail == LOOPBACK_DEPTH)
+	{
+		loopback_wait(pQueue, NULL);
+	}
+	pQueue->data[pQueue->head++ % LOOPBACK_DEPTH] = byte;
+	pthread_cond_broadcast(&pQueue->cond);
+}
+
+static int loopback_get(loopback_queue_t *pQueue, const struct timespec *pDeadline)
+{
+	int byte;
+
+	while (pQueue->head == pQueue->tail)
+	{
+		if (ETIMEDOUT == loopback_wait(pQueue, pDeadline))
+		{
+			return -1;
+		}
+	}
+	byte = pQueue->data[pQueue->tail++ % LOOPBACK_DEPTH];
+	pthread_cond_broadcast(&pQueue->cond);
+	return byte;
+}
+
+void Loopback_Reset(void)
+{
+	pthread_mutex_lock(&s_lock);
+	s_toDevice.head = s_toDevice.tail = 0;
+	s_toHost.head = s_toHost.tail = 0;
+	pthread_cond_broadcast(&s_toDevice.cond);
+	pthread_cond_broadcast(&s_toHost.cond);
+	pthread_mutex_unlock(&s_lock);
+}
+
+int Loopback_Write(void *ctx, const uint8_t *pData, size_t length)
+{
+	pthread_mutex_lock(&s_lock);
+	for (size_t i = 0; i < length; i++)
+	{
+		loopback_put(&s_toDevice, pData[i]);
+	}
+	pthread_mutex_unlock(&s_lock);
+	return (int)length;
+}
+
+int Loopback_Read(void *ctx, uint8_t *pData, size_t length, int timeout_ms)
+{
+	struct timespec deadline;
+	size_t i;
+	int byte;
+
+	if (timeout_ms >= 0)
+	{
+		clock_gettime(CLOCK_REALTIME, &deadline);
+		deadline.tv_sec += timeout_ms / 1000;
+		deadline.tv_nsec += (timeout_ms % 1000) * 1000000L;
+		if (deadline.tv_nsec >= 1000000000L)
+		{
+			deadline.tv_sec++;
+			deadline.tv_nsec -= 1000000000L;
+		}
+	}
+
+	pthread_mutex_lock(&s_lock);
+	for (i = 0; i < length; i++)
+	{
+		byte = loopback_get(&s_toHost, (timeout_ms >= 0) ? &deadline : NULL);
+		if (byte < 0)
+		{
+			break;
+		}
+		pData[i] = (uint8_t)byte;
+	}
+	pthread_mutex_unlock(&s_lock);
+	return (int)i;
+}
+
+/* Device side, the firmware PUTCHAR/GETCHAR. */
+int DbgConsole_AsyncPutchar(int ch)
+{
+	pthread_mutex_lock(&s_lock);
+	loopback_put(&s_toHost, (uint8_t)ch);
+	pthread_mutex_unlock(&s_lock);
+	return 1;
+}
+
+int DbgConsole_Getchar(void)
+{
+	int byte;
+
+	pthread_mutex_lock(&s_lock);
+	byte = loopback_get(&s_toDevice, NULL);
+	pthread_mutex_unlock(&s_lock);
+	return byte;
+}
+
+bool DbgConsole_AsyncRxReady(void)
+{
+	bool ready;
+
+	pthread_mutex_lock(&s_lock);
+	ready = (s_toDevice.head != s_toDevice.tail);
+	pthread_mutex_unlock(&s_lock);
+	return ready;
+}
+
+void DbgConsole_AsyncFlush(void)
+{
+}
@@ -0,0 +1,34 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file loopback_serial.h
+ * @brief Host stand-in for the debug console UART: two byte queues between the device side
+ *        (DbgConsole_AsyncPutchar()/DbgConsole_Getchar()/DbgConsole_AsyncRxReady(), so PUTCHAR/GETCHAR of
+ *        the firmware) and the host side (Loopback_Write()/Loopback_Read(), a pcf2131_client_t transport).
+ *        Either side may run on its own thread, a read blocks until the bytes arrive or its timeout expires.
+ */
+
+#ifndef LOOPBACK_SERIAL_H_
+#define LOOPBACK_SERIAL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*! @brief Bytes buffered per direction, a writer blocks while its queue is full. */
+#define LOOPBACK_DEPTH (4096)
+
+/*! @brief Empties both directions. */
+void Loopback_Reset(void);
+
+/*! @brief Host side: queues bytes to the device, returns the number written. */
+int Loopback_Write(void *ctx, const uint8_t *pData, size_t length);
+
+/*! @brief Host side: reads exactly length bytes from the device.
+ *  @return length, or the bytes read so far when timeout_ms expired (a negative timeout waits forever). */
+int Loopback_Read(void *ctx, uint8_t *pData, size_t length, int timeout_ms);
+
+#endif /* LOOPBACK_SERIAL_H_ */
@@ -0,0 +1,673 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file mock_bus.c
+ * @brief Host stand-in for the CMSIS bus drivers and the LPI2C master, see mock_bus.h.
+ */
+
+#include <string.h>
+
+#include "issdk_hal.h"
+#include "gpio_driver.h"
+#include "mock_bus.h"
+#include "pcf2131_drv.h"
+#include "register_io_i2c.h"
+#include "register_io_spi.h"
+
+/* Systick jump per read while a transfer is stuck, the deadline of the layer expires within a few polls. */
+#define MOCK_BUS_WARP_US (1000U)
+/* MTDR between two command words, the register is write only on the device. */
+#define MOCK_LPI2C_MTDR_EMPTY (0xFFFFFFFFU)
+/* LPI2C MTDR commands. */
+#define MOCK_LPI2C_CMD_TRANSMIT (0x0U)
+#define MOCK_LPI2C_CMD_STOP (0x2U)
+#define MOCK_LPI2C_CMD_START (0x4U)
+/* Transfer statuses of the profile faults without a CMSIS equivalent. */
+#define MOCK_BUS_ABORT (ARM_DRIVER_ERROR_SPECIFIC - 1)
+#define MOCK_BUS_CORRUPT (ARM_DRIVER_ERROR_SPECIFIC - 2)
+#define MOCK_BUS_SPURIOUS (ARM_DRIVER_ERROR_SPECIFIC - 3)
+
+/* The signal event handlers of bus 0 in register_io_i2c.c and register_io_spi.c. */
+void I2C0_SignalEvent_t(uint32_t event);
+void SPI0_SignalEvent_t(uint32_t event);
+/* The GPIO driver the SPI register I/O drives the slave select with. */
+extern GENERIC_DRIVER_GPIO *pDspiGpioDriver;
+
+uint8_t g_Mock_Regs[MOCK_BUS_REG_COUNT];
+LPI2C_Type g_Mock_LPI2C0 = {.MTDR = MOCK_LPI2C_MTDR_EMPTY};
+LPSPI_Type g_Mock_LPSPI0;
+
+static registerIoCount_t s_count;
+static uint32_t s_failAfter;
+static uint32_t s_failCount;
+static int32_t s_failStatus;
+static bool s_profileSet;
+static mock_bus_profile_t s_profile;
+static mock_bus_stats_t s_stats;
+static uint32_t s_random;
+static mock_bus_device_t s_device;
+static void *s_deviceCtx;
+/* A transfer waits for an abort or a bus clear that never completes by itself. */
+static bool s_stuck;
+/* The register pointer of the device, set by the first byte written after the address. */
+static uint8_t s_pointer;
+
+static ARM_I2C_SignalEvent_t s_i2cEvent = I2C0_SignalEvent_t;
+static ARM_SPI_SignalEvent_t s_spiEvent = SPI0_SignalEvent_t;
+
+/* The LPI2C master: a transfer from START to STOP, its data collected until the STOP writes it. */
+static struct
+{
+	bool busy;    /* START sent, no STOP yet. */
+	bool nack;    /* The slave did not acknowledge, the rest of the transfer is ignored. */
+	uint32_t length;
+	uint8_t data[1 + 256];
+} s_lpi2c;
+
+/* The SPI slave: the command byte starts a transaction, the data behind it follows the pointer. */
+static struct
+{
+	bool selected; /* CE is low. */
+	bool command;  /* The command byte is in, the direction and pointer are set. */
+	bool read;
+	int32_t fault; /* Status of the transaction, drawn at the slave select. */
+} s_spi;
+
+static void mock_gpio_set(pinID_t aPinId);
+static void mock_gpio_clr(pinID_t aPinId);
+static void mock_gpio_toggle(pinID_t aPinId);
+
+/* The slave select driver of the SPI register I/O, the PCF2131 CE pin is active low. */
+static GENERIC_DRIVER_GPIO s_mockGpio = {
+	.set_pin = mock_gpio_set,
+	.clr_pin = mock_gpio_clr,
+	.toggle_pin = mock_gpio_toggle,
+};
+
+void Mock_Bus_Reset(void)
+{
+	memset(g_Mock_Regs, 0, sizeof(g_Mock_Regs));
+	memset(&s_count, 0, sizeof(s_count));
+	memset(&s_lpi2c, 0, sizeof(s_lpi2c));
+	memset(&s_spi, 0, sizeof(s_spi));
+	g_Mock_LPI2C0.MCR = LPI2C_MCR_MEN_MASK;
+	g_Mock_LPI2C0.MSR = 0;
+	g_Mock_LPI2C0.MTDR = MOCK_LPI2C_MTDR_EMPTY;
+	s_failAfter = 0;
+	s_failCount = 0;
+	s_profileSet = false;
+	s_device = NULL;
+	s_stuck = false;
+	s_pointer = 0;
+	HOST_SystickWarp(0);
+	Register_I2C_ClearCount(0);
+	Register_SPI_ClearCount(0);
+	pDspiGpioDriver = &s_mockGpio;
+}
+
+void Mock_Bus_SetDevice(mock_bus_device_t device, void *ctx)
+{
+	s_device = device;
+	s_deviceCtx = ctx;
+}
+
+void Mock_Bus_Fail(uint32_t after, uint32_t count, int32_t status)
+{
+	s_failAfter = after;
+	s_failCount = count;
+	s_failStatus = status;
+}
+
+void Mock_Bus_SetProfile(const mock_bus_profile_t *pProfile, uint32_t seed)
+{
+	s_profileSet = (pProfile != NULL);
+	if (s_profileSet)
+	{
+		s_profile = *pProfile;
+	}
+	s_random = seed ? seed : 1U;
+	memset(&s_stats, 0, sizeof(s_stats));
+}
+
+void Mock_Bus_GetStats(mock_bus_stats_t *pStats)
+{
+	*pStats = s_stats;
+}
+
+bool Mock_Bus_FaultPending(void)
+{
+	return s_failCount != 0;
+}
+
+void Mock_Bus_GetCount(registerIoCount_t *pCount)
+{
+	*pCount = s_count;
+}
+
+/* xorshift32, the fault sequence of a profile. */
+static uint32_t mock_random(void)
+{
+	s_random ^= s_random << 13;
+	s_random ^= s_random >> 17;
+	s_random ^= s_random << 5;
+	return s_random;
+}
+
+/* Draws the fault of a transfer from the profile. */
+static int32_t mock_profile_fault(void)
+{
+	static const int32_t status[MOCK_BUS_FAULT_COUNT] = {ARM_DRIVER_ERROR, MOCK_BUS_ABORT, ARM_DRIVER_ERROR_TIMEOUT,
+			MOCK_BUS_CORRUPT, MOCK_BUS_SPURIOUS};
+	uint32_t draw = mock_random() % 1000U;
+	uint8_t fault;
+
+	s_stats.transfers++;
+	for (fault = 0; fault < MOCK_BUS_FAULT_COUNT; fault++)
+	{
+		if (draw < s_profile.rate[fault])
+		{
+			s_stats.injected[fault]++;
+			return status[fault];
+		}
+		draw -= s_profile.rate[fault];
+	}
+	return ARM_DRIVER_OK;
+}
+
+/* Counts one bus transfer and returns its status from the fault schedule or the profile. */
+static int32_t mock_transfer(void)
+{
+	s_count.transfers++;
+
+	if (s_failCount == 0)
+	{
+		return s_profileSet ? mock_profile_fault() : ARM_DRIVER_OK;
+	}
+	if (s_failAfter)
+	{
+		s_failAfter--;
+		return ARM_DRIVER_OK;
+	}
+	s_failCount--;
+	return s_failStatus;
+}
+
+/* The data of a transfer with this status reaches the device, a corrupt or spurious receive excepted. */
+static bool mock_delivered(int32_t status)
+{
+	return (ARM_DRIVER_OK == status) || (MOCK_BUS_CORRUPT == status) || (MOCK_BUS_SPURIOUS == status);
+}
+
+/* Flips one bit of the received bytes. */
+static void mock_corrupt(uint8_t *pData, uint32_t length)
+{
+	if (length != 0)
+	{
+		pData[mock_random() % length] ^= (uint8_t)(1U << (mock_random() % 8U));
+	}
+}
+
+/* The transfer never completes, time flies until the layer gives up on it. */
+static void mock_stick(void)
+{
+	s_stuck = true;
+	HOST_SystickWarp(MOCK_BUS_WARP_US);
+}
+
+static void mock_unstick(void)
+{
+	s_stuck = false;
+	HOST_SystickWarp(0);
+}
+
+/* The register pointer wraps at the end of the map as on the device. */
+static int32_t mock_read(uint8_t length, uint8_t *pOut)
+{
+	int32_t status = ARM_DRIVER_OK;
+
+	if (length == 0)
+	{
+		return ARM_DRIVER_OK;
+	}
+	if (s_device != NULL)
+	{
+		status = s_device(s_deviceCtx, false, s_pointer, length, pOut);
+	}
+	else
+	{
+		for (uint32_t i = 0; i < length; i++)
+		{
+			pOut[i] = g_Mock_Regs[(uint8_t)(s_pointer + i)];
+		}
+	}
+	s_pointer += length;
+	return status;
+}
+
+static int32_t mock_write(const uint8_t *pIn, uint8_t length)
+{
+	int32_t status = ARM_DRIVER_OK;
+
+	if (length == 0)
+	{
+		return ARM_DRIVER_OK;
+	}
+	if (s_device != NULL)
+	{
+		status = s_device(s_deviceCtx, true, s_pointer, length, (uint8_t *)pIn);
+	}
+	else
+	{
+		for (uint32_t i = 0; i < length; i++)
+		{
+			g_Mock_Regs[(uint8_t)(s_pointer + i)] = pIn[i];
+		}
+	}
+	s_pointer += length;
+	return status;
+}
+
+/*******************************************************************************
+ * CMSIS I2C: every MasterTransmit()/MasterReceive() is a transfer, the first byte written sets the pointer.
+ ******************************************************************************/
+static int32_t mock_i2c_initialize(ARM_I2C_SignalEvent_t cb_event)
+{
+	s_i2cEvent = cb_event;
+	return ARM_DRIVER_OK;
+}
+
+static int32_t mock_i2c_uninitialize(void)
+{
+	return ARM_DRIVER_OK;
+}
+
+static int32_t mock_i2c_power_control(ARM_POWER_STATE state)
+{
+	return ARM_DRIVER_OK;
+}
+
+/* Ends a started transfer with its status from the fault schedule, or leaves it stuck. */
+static int32_t mock_i2c_end(int32_t status)
+{
+	if (ARM_DRIVER_ERROR_TIMEOUT == status)
+	{
+		mock_stick();
+		return ARM_DRIVER_OK;
+	}
+	if (ARM_DRIVER_ERROR == status)
+	{
+		s_i2cEvent(ARM_I2C_EVENT_TRANSFER_DONE | ARM_I2C_EVENT_TRANSFER_INCOMPLETE | ARM_I2C_EVENT_ADDRESS_NACK);
+		return ARM_DRIVER_OK;
+	}
+	if (MOCK_BUS_ABORT == status)
+	{
+		s_i2cEvent(ARM_I2C_EVENT_TRANSFER_DONE | ARM_I2C_EVENT_TRANSFER_INCOMPLETE);
+		return ARM_DRIVER_OK;
+	}
+	if (mock_delivered(status))
+	{
+		s_i2cEvent(ARM_I2C_EVENT_TRANSFER_DONE);
+		return ARM_DRIVER_OK;
+	}
+	return status;
+}
+
+static int32_t mock_i2c_master_transmit(uint32_t addr, const uint8_t *data, uint32_t num, bool xfer_pending)
+{
+	int32_t status, result;
+
+	if (s_stuck)
+	{
+		return ARM_DRIVER_ERROR_BUSY;
+	}
+	status = mock_transfer();
+	s_count.bytes += num;
+	if (mock_delivered(status) && (num != 0))
+	{
+		s_pointer = data[0];
+		result = mock_write(data + 1, (uint8_t)(num - 1));
+		status = (ARM_DRIVER_OK != result) ? result : status;
+	}
+	return mock_i2c_end(status);
+}
+
+static int32_t mock_i2c_master_receive(uint32_t addr, uint8_t *data, uint32_t num, bool xfer_pending)
+{
+	int32_t status, result;
+
+	if (s_stuck)
+	{
+		return ARM_DRIVER_ERROR_BUSY;
+	}
+	status = mock_transfer();
+	s_count.bytes += num;
+	if ((ARM_DRIVER_OK == status) || (MOCK_BUS_CORRUPT == status))
+	{
+		result = mock_read((uint8_t)num, data);
+		if (MOCK_BUS_CORRUPT == status)
+		{
+			mock_corrupt(data, num);
+		}
+		status = (ARM_DRIVER_OK != result) ? result : status;
+	}
+	return mock_i2c_end(status);
+}
+
+static int32_t mock_i2c_control(uint32_t control, uint32_t arg)
+{
+	if (ARM_I2C_ABORT_TRANSFER == control)
+	{
+		mock_unstick();
+	}
+	return ARM_DRIVER_OK;
+}
+
+static ARM_I2C_STATUS mock_i2c_get_status(void)
+{
+	ARM_I2C_STATUS status = {.busy = s_stuck};
+
+	return status;
+}
+
+ARM_DRIVER_I2C Mock_I2C_Driver = {
+	.Initialize = mock_i2c_initialize,
+	.Uninitialize = mock_i2c_uninitialize,
+	.PowerControl = mock_i2c_power_control,
+	.MasterTransmit = mock_i2c_master_transmit,
+	.MasterReceive = mock_i2c_master_receive,
+	.Control = mock_i2c_control,
+	.GetStatus = mock_i2c_get_status,
+};
+
+/*******************************************************************************
+ * LPI2C master: the words written to MTDR go out at the next status access, a START is a transfer.
+ ******************************************************************************/
+/* Puts the pending command word on the bus and applies a FIFO reset. */
+static void mock_lpi2c_latch(LPI2C_Type *base)
+{
+	uint32_t word = base->MTDR;
+	int32_t status;
+
+	/* A transmit FIFO reset drops the word not yet sent */
+	if (base->MCR & LPI2C_MCR_RTF_MASK)
+	{
+		word = MOCK_LPI2C_MTDR_EMPTY;
+		base->MTDR = MOCK_LPI2C_MTDR_EMPTY;
+	}
+	base->MCR &= ~(LPI2C_MCR_RRF_MASK | LPI2C_MCR_RTF_MASK);
+	if (MOCK_LPI2C_MTDR_EMPTY == word)
+	{
+		return;
+	}
+	base->MTDR = MOCK_LPI2C_MTDR_EMPTY;
+
+	switch ((word & LPI2C_MTDR_CMD_MASK) >> LPI2C_MTDR_CMD_SHIFT)
+	{
+		case MOCK_LPI2C_CMD_START:
+			s_lpi2c.busy = true;
+			s_lpi2c.nack = false;
+			s_lpi2c.length = 0;
+			status = mock_transfer();
+			if (ARM_DRIVER_ERROR_TIMEOUT == status)
+			{
+				mock_stick();
+			}
+			else if (MOCK_BUS_ABORT == status)
+			{
+				/* Arbitration lost, the master leaves the bus */
+				s_lpi2c.nack = true;
+				s_lpi2c.busy = false;
+				base->MSR |= LPI2C_MSR_ALF_MASK;
+			}
+			else if (MOCK_BUS_SPURIOUS == status)
+			{
+				/* A stale STOP detect, the write still goes out at its STOP */
+				base->MSR |= LPI2C_MSR_SDF_MASK;
+			}
+			else if (!mock_delivered(status))
+			{
+				/* The master sends the STOP of a NACK by itself */
+				s_lpi2c.nack = true;
+				s_lpi2c.busy = false;
+				base->MSR |= LPI2C_MSR_NDF_MASK | LPI2C_MSR_SDF_MASK;
+			}
+			break;
+		case MOCK_LPI2C_CMD_TRANSMIT:
+			if (s_lpi2c.busy && (s_lpi2c.length < sizeof(s_lpi2c.data)))
+			{
+				s_lpi2c.data[s_lpi2c.length++] = (uint8_t)word;
+				s_count.bytes++;
+			}
+			break;
+		case MOCK_LPI2C_CMD_STOP:
+			if (!s_lpi2c.busy || s_stuck)
+			{
+				break;
+			}
+			s_lpi2c.busy = false;
+			if (s_lpi2c.length != 0)
+			{
+				s_pointer = s_lpi2c.data[0];
+				mock_write(s_lpi2c.data + 1, (uint8_t)(s_lpi2c.length - 1));
+			}
+			base->MSR |= LPI2C_MSR_SDF_MASK;
+			break;
+		default:
+			base->MSR |= LPI2C_MSR_FEF_MASK;
+			break;
+	}
+}
+
+uint32_t LPI2C_MasterGetStatusFlags(LPI2C_Type *base)
+{
+	mock_lpi2c_latch(base);
+	return base->MSR | (s_lpi2c.busy ? (LPI2C_MSR_MBF_MASK | LPI2C_MSR_BBF_MASK) : 0U);
+}
+
+void LPI2C_MasterClearStatusFlags(LPI2C_Type *base, uint32_t statusMask)
+{
+	mock_lpi2c_latch(base);
+	base->MSR &= ~(statusMask & (uint32_t)kLPI2C_MasterClearFlags);
+}
+
+/* The simulated bus takes every word at once, the transmit FIFO is always empty. */
+void LPI2C_MasterGetFifoCounts(LPI2C_Type *base, size_t *rxCount, size_t *txCount)
+{
+	mock_lpi2c_latch(base);
+	if (NULL != txCount)
+	{
+		*txCount = 0;
+	}
+	if (NULL != rxCount)
+	{
+		*rxCount = 0;
+	}
+}
+
+status_t LPI2C_MasterCheckAndClearError(LPI2C_Type *base, uint32_t status)
+{
+	status_t result = kStatus_Success;
+
+	status &= (uint32_t)kLPI2C_MasterErrorFlags;
+	if (0U != status)
+	{
+		if (0U != (status & (uint32_t)kLPI2C_MasterPinLowTimeoutFlag))
+		{
+			result = kStatus_LPI2C_PinLowTimeout;
+		}
+		else if (0U != (status & (uint32_t)kLPI2C_MasterArbitrationLostFlag))
+		{
+			result = kStatus_LPI2C_ArbitrationLost;
+		}
+		else if (0U != (status & (uint32_t)kLPI2C_MasterNackDetectFlag))
+		{
+			result = kStatus_LPI2C_Nak;
+		}
+		else
+		{
+			result = kStatus_LPI2C_FifoError;
+		}
+		LPI2C_MasterClearStatusFlags(base, status);
+		base->MCR |= LPI2C_MCR_RRF_MASK | LPI2C_MCR_RTF_MASK;
+	}
+
+	return result;
+}
+
+/* Clocking SCL frees a stuck slave and the STOP behind it ends the transfer. */
+void BOARD_I2C_BusClear(uint8_t deviceInstance)
+{
+	mock_unstick();
+	s_lpi2c.busy = false;
+}
+
+/*******************************************************************************
+ * CMSIS SPI: a transaction runs while CE is low, the first byte is the command.
+ ******************************************************************************/
+static void mock_gpio_clr(pinID_t aPinId)
+{
+	s_spi.selected = true;
+	s_spi.command = false;
+	s_spi.fault = mock_transfer();
+}
+
+static void mock_gpio_set(pinID_t aPinId)
+{
+	s_spi.selected = false;
+}
+
+static void mock_gpio_toggle(pinID_t aPinId)
+{
+	if (s_spi.selected)
+	{
+		mock_gpio_set(aPinId);
+	}
+	else
+	{
+		mock_gpio_clr(aPinId);
+	}
+}
+
+static int32_t mock_spi_initialize(ARM_SPI_SignalEvent_t cb_event)
+{
+	s_spiEvent = cb_event;
+	return ARM_DRIVER_OK;
+}
+
+static int32_t mock_spi_uninitialize(void)
+{
+	return ARM_DRIVER_OK;
+}
+
+static int32_t mock_spi_power_control(ARM_POWER_STATE state)
+{
+	return ARM_DRIVER_OK;
+}
+
+/* Clocks num bytes: out is shifted out (NULL for don't care), in gets the bytes of a read (NULL to drop them). */
+static int32_t mock_spi_clock(const uint8_t *out, uint8_t *in, uint32_t num)
+{
+	int32_t status = s_spi.fault;
+	int32_t result = ARM_DRIVER_OK;
+
+	if (s_stuck)
+	{
+		return ARM_DRIVER_ERROR_BUSY;
+	}
+	s_count.bytes += num;
+	if (mock_delivered(status) && s_spi.selected && (num != 0))
+	{
+		if (!s_spi.command)
+		{
+			s_spi.command = true;
+			s_spi.read = (out != NULL) && (out[0] & PCF2131_SPI_RD_CMD);
+			s_pointer = (out != NULL) ? (out[0] & PCF2131_SPI_WR_CMD) : 0;
+			out = (out != NULL) ? out + PCF2131_SPI_CMD_LEN : NULL;
+			in = (in != NULL) ? in + PCF2131_SPI_CMD_LEN : NULL;
+			num -= PCF2131_SPI_CMD_LEN;
+		}
+		if (s_spi.read && (in != NULL) && (MOCK_BUS_SPURIOUS != status))
+		{
+			result = mock_read((uint8_t)num, in);
+			if ((MOCK_BUS_CORRUPT == status) && (num != 0))
+			{
+				/* One flipped bit per transaction */
+				mock_corrupt(in, num);
+				s_spi.fault = ARM_DRIVER_OK;
+			}
+		}
+		else if (!s_spi.read && (out != NULL))
+		{
+			result = mock_write(out, (uint8_t)num);
+		}
+		status = (ARM_DRIVER_OK != result) ? result : status;
+	}
+
+	if (ARM_DRIVER_ERROR_TIMEOUT == status)
+	{
+		mock_stick();
+		return ARM_DRIVER_OK;
+	}
+	if (ARM_DRIVER_ERROR == status)
+	{
+		s_spiEvent(ARM_SPI_EVENT_DATA_LOST);
+		return ARM_DRIVER_OK;
+	}
+	if (MOCK_BUS_ABORT == status)
+	{
+		s_spiEvent(ARM_SPI_EVENT_MODE_FAULT);
+		return ARM_DRIVER_OK;
+	}
+	if (mock_delivered(status))
+	{
+		s_spiEvent(ARM_SPI_EVENT_TRANSFER_COMPLETE);
+		return ARM_DRIVER_OK;
+	}
+	return status;
+}
+
+static int32_t mock_spi_send(const void *data, uint32_t num)
+{
+	return mock_spi_clock(data, NULL, num);
+}
+
+static int32_t mock_spi_receive(void *data, uint32_t num)
+{
+	return mock_spi_clock(NULL, data, num);
+}
+
+static int32_t mock_spi_transfer(const void *data_out, void *data_in, uint32_t num)
+{
+	return mock_spi_clock(data_out, data_in, num);
+}
+
+static int32_t mock_spi_control(uint32_t control, uint32_t arg)
+{
+	if (ARM_SPI_ABORT_TRANSFER == control)
+	{
+		mock_unstick();
+	}
+	return ARM_DRIVER_OK;
+}
+
+static ARM_SPI_STATUS mock_spi_get_status(void)
+{
+	ARM_SPI_STATUS status = {.busy = s_stuck};
+
+	return status;
+}
+
+ARM_DRIVER_SPI Mock_SPI_Driver = {
+	.Initialize = mock_spi_initialize,
+	.Uninitialize = mock_spi_uninitialize,
+	.PowerControl = mock_spi_power_control,
+	.Send = mock_spi_send,
+	.Receive = mock_spi_receive,
+	.Transfer = mock_spi_transfer,
+	.Control = mock_spi_control,
+	.GetStatus = mock_spi_get_status,
+};
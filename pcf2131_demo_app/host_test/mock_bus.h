@@ -0,0 +1,103 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file mock_bus.h
+ * @brief Host stand-in for the CMSIS I2C and SPI drivers and the LPI2C master below the register I/O layer, with
+ *        a simulated PCF2131 register map on the bus. The real register_io_i2c.c and register_io_spi.c run on
+ *        top of it, FIFO block writes, in place and started transfers, deadlines and recovery included.
+ *        Transfers complete at once, the signal event handler of bus 0 is called before the start returns.
+ *
+ *        The simulated bus counts what reaches it: an I2C MasterTransmit()/MasterReceive() or an LPI2C START
+ *        is one transfer, an SPI transaction is one transfer from slave select to deselect. A fault free run
+ *        so counts the same as Register_x_GetCount(): an I2C register read is two transfers (offset, then the
+ *        data after a repeated START), a write or block write one transfer of offset and data, every SPI
+ *        access one transfer of the command byte and the data. A masked write reads the register first.
+ *
+ *        Transfers can be made to fail on a schedule. ARM_DRIVER_ERROR NACKs the transfer (I2C, LPI2C) or loses
+ *        its data (SPI), ARM_DRIVER_ERROR_TIMEOUT leaves it stuck and warps the systick until the deadline of
+ *        the layer expires, any other status is returned by the CMSIS start call (the LPI2C NACKs it). A failed
+ *        transfer does not reach the registers. A device stand-in (Mock_Bus_SetDevice()) may answer the
+ *        register transactions in place of the register map.
+ *
+ *        A fault profile (Mock_Bus_SetProfile()) fails transfers at random instead, with a seeded sequence:
+ *        NACK and stuck as above, a transfer aborted after its start (arbitration lost on the LPI2C, a mode
+ *        fault on SPI), a bit flipped in the received data, or a completion event before the data arrived.
+ */
+
+#ifndef MOCK_BUS_H_
+#define MOCK_BUS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "Driver_I2C.h"
+#include "Driver_SPI.h"
+#include "sensor_drv.h"
+
+/*! @brief Size of the simulated register space, the whole 8-bit offset range. */
+#define MOCK_BUS_REG_COUNT (256)
+
+/*! @brief CMSIS drivers to put in the sensor handle, bus 0. Control() accepts any bus speed. */
+extern ARM_DRIVER_I2C Mock_I2C_Driver;
+extern ARM_DRIVER_SPI Mock_SPI_Driver;
+
+/*! @brief The simulated registers, tests may read and poke them directly. */
+extern uint8_t g_Mock_Regs[MOCK_BUS_REG_COUNT];
+
+/*! @brief The faults of a profile, at most one per transfer. */
+typedef enum
+{
+	MOCK_BUS_FAULT_NACK = 0, /* The transfer ends with a NACK (I2C) or lost data (SPI). */
+	MOCK_BUS_FAULT_ABORT,    /* The transfer ends right after its start, nothing reaches the registers. */
+	MOCK_BUS_FAULT_STUCK,    /* The completion never arrives. */
+	MOCK_BUS_FAULT_CORRUPT,  /* One received bit is flipped, receive transfers only. */
+	MOCK_BUS_FAULT_SPURIOUS, /* The completion is signaled before the data: a read returns the buffer as it was. */
+	MOCK_BUS_FAULT_COUNT,
+} mock_bus_fault_t;
+
+/*! @brief A fault profile, the probability of each fault per transfer in 1/1000. */
+typedef struct
+{
+	const char *name;
+	uint16_t rate[MOCK_BUS_FAULT_COUNT];
+} mock_bus_profile_t;
+
+/*! @brief The transfers and the faults injected since the profile was set. */
+typedef struct
+{
+	uint32_t transfers;
+	uint32_t injected[MOCK_BUS_FAULT_COUNT];
+} mock_bus_stats_t;
+
+/*! @brief A device stand-in: fills pData on a read, gets the written values on a write, returns the status. */
+typedef int32_t (*mock_bus_device_t)(void *ctx, bool write, uint8_t offset, uint8_t length, uint8_t *pData);
+
+/*! @brief Clears the registers, the counters of the bus and of the register I/O layer, any fault schedule or
+ *         profile and the device stand-in, and puts the simulated slave select in front of the SPI register I/O. */
+void Mock_Bus_Reset(void);
+
+/*! @brief Lets the next `after` transfers pass, then fails `count` transfers with `status`. */
+void Mock_Bus_Fail(uint32_t after, uint32_t count, int32_t status);
+
+/*! @brief Sets the fault profile, NULL to stop injecting, and clears the statistics. The same seed repeats the
+ *         same faults. A scheduled failure (Mock_Bus_Fail()) takes precedence over the profile. */
+void Mock_Bus_SetProfile(const mock_bus_profile_t *pProfile, uint32_t seed);
+
+/*! @brief Transfers and injected faults since the profile was set. */
+void Mock_Bus_GetStats(mock_bus_stats_t *pStats);
+
+/*! @brief Answers the register transactions with device instead of the register map, NULL for the map.
+ *         A transfer failed by the fault schedule does not reach the device. */
+void Mock_Bus_SetDevice(mock_bus_device_t device, void *ctx);
+
+/*! @brief True while the fault schedule has failures left, so the run ended before reaching them. */
+bool Mock_Bus_FaultPending(void);
+
+/*! @brief Transfers and bytes that reached the bus since the last reset. */
+void Mock_Bus_GetCount(registerIoCount_t *pCount);
+
+#endif /* MOCK_BUS_H_ */
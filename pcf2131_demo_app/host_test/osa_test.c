@@ -0,0 +1,249 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file osa_test.c
+ * @brief Host test of the OS hooks of the register I/O layer on the OS abstraction layer (register_io_osa.c),
+ *        built with REGISTER_IO_OSA_ENABLE on the pthread port (shim/fsl_os_abstraction_pthread.c). Threads
+ *        with their own handle on the same bus write and read back their own registers: a device stand-in
+ *        that takes its time must never see two transactions at once and every thread must read back what it
+ *        wrote. Then the completion wait: it blocks until the signal, without spinning, ends at the deadline
+ *        without one, is not ended by a give without the completion, and the lock nests.
+ */
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "mock_bus.h"
+#include "pcf2131.h"
+#include "pcf2131_drv.h"
+#include "register_io_os.h"
+
+#define CHECK(cond)                                                              \
+	do                                                                           \
+	{                                                                            \
+		if (!(cond))                                                             \
+		{                                                                        \
+			printf("osa_test: %s:%d: %s\n", __FILE__, __LINE__, #cond);          \
+			s_failures++;                                                        \
+		}                                                                        \
+	} while (0)
+
+/* Threads sharing bus 0, the round trips each, the registers each owns (below 0x80 for the SPI address). */
+#define OSA_TEST_THREADS (4U)
+#define OSA_TEST_ROUNDS (200U)
+#define OSA_TEST_LENGTH (8U)
+#define OSA_TEST_BASE (0x40U)
+
+/* A completion given this long after the wait started, and the deadline of the unsignaled waits. */
+#define OSA_TEST_SIGNAL_MS (20U)
+#define OSA_TEST_TIMEOUT_US (20000U)
+
+typedef struct
+{
+	pcf2131_sensorhandle_t rtc;
+	uint32_t slaveSelect;
+	uint8_t index;
+	uint32_t mismatches;
+	uint32_t errors;
+} osa_worker_t;
+
+#if (I2C_ENABLE)
+extern registerOsBus_t g_I2C_Os[];
+#define OSA_TEST_BUS (&g_I2C_Os[0])
+#else
+extern registerOsBus_t g_SPI_Os[];
+#define OSA_TEST_BUS (&g_SPI_Os[0])
+#endif
+
+static osa_worker_t s_workers[OSA_TEST_THREADS];
+static uint8_t s_deviceRegs[MOCK_BUS_REG_COUNT];
+static atomic_uint s_inside;
+static atomic_uint s_overlaps;
+static atomic_uint s_transactions;
+static volatile bool s_done;
+static uint32_t s_failures;
+
+/* A slow device: any other transaction arriving while one is in progress is an overlap. */
+static int32_t slow_device(void *ctx, bool write, uint8_t offset, uint8_t length, uint8_t *pData)
+{
+	if (atomic_fetch_add(&s_inside, 1) != 0)
+	{
+		atomic_fetch_add(&s_overlaps, 1);
+	}
+	atomic_fetch_add(&s_transactions, 1);
+	usleep(20);
+	if (write)
+	{
+		memcpy(&s_deviceRegs[offset], pData, length);
+	}
+	else
+	{
+		memcpy(pData, &s_deviceRegs[offset], length);
+	}
+	atomic_fetch_sub(&s_inside, 1);
+
+	return ARM_DRIVER_OK;
+}
+
+static void *worker(void *arg)
+{
+	osa_worker_t *pWorker = arg;
+	uint8_t offset = OSA_TEST_BASE + pWorker->index * OSA_TEST_LENGTH;
+	uint8_t out[PCF2131_BUF_HEADROOM + OSA_TEST_LENGTH], in[PCF2131_BUF_HEADROOM + OSA_TEST_LENGTH];
+	uint32_t round, i;
+
+	for (round = 0; round < OSA_TEST_ROUNDS; round++)
+	{
+		for (i = 0; i < OSA_TEST_LENGTH; i++)
+		{
+			out[PCF2131_BUF_HEADROOM + i] = (uint8_t)(pWorker->index * 64U + round + i);
+		}
+		if ((SENSOR_ERROR_NONE != PCF2131_WriteInPlace(&pWorker->rtc, offset, OSA_TEST_LENGTH, out)) ||
+			(SENSOR_ERROR_NONE != PCF2131_ReadInPlace(&pWorker->rtc, offset, OSA_TEST_LENGTH, in)))
+		{
+			pWorker->errors++;
+		}
+		else if (0 != memcmp(&in[PCF2131_BUF_HEADROOM], &out[PCF2131_BUF_HEADROOM], OSA_TEST_LENGTH))
+		{
+			pWorker->mismatches++;
+		}
+	}
+
+	return NULL;
+}
+
+/* Transfers of several threads on one bus are serialized by the bus mutex. */
+static void test_serialized(void)
+{
+	pthread_t threads[OSA_TEST_THREADS];
+	uint32_t t, mismatches = 0, errors = 0;
+
+	Mock_Bus_Reset();
+	for (t = 0; t < OSA_TEST_THREADS; t++)
+	{
+		s_workers[t].index = (uint8_t)t;
+#if (I2C_ENABLE)
+		CHECK(PCF2131_Initialize(&s_workers[t].rtc, &Mock_I2C_Driver, 0, 0x53) == SENSOR_ERROR_NONE);
+#else
+		CHECK(PCF2131_Initialize(&s_workers[t].rtc, &Mock_SPI_Driver, 0, &s_workers[t].slaveSelect) ==
+			  SENSOR_ERROR_NONE);
+#endif
+	}
+	Mock_Bus_SetDevice(slow_device, NULL);
+
+	for (t = 0; t < OSA_TEST_THREADS; t++)
+	{
+		CHECK(pthread_create(&threads[t], NULL, worker, &s_workers[t]) == 0);
+	}
+	for (t = 0; t < OSA_TEST_THREADS; t++)
+	{
+		pthread_join(threads[t], NULL);
+		mismatches += s_workers[t].mismatches;
+		errors += s_workers[t].errors;
+	}
+	Mock_Bus_SetDevice(NULL, NULL);
+
+	printf("osa_test: %u threads, %u transactions, %u overlapping, %u errors, %u read back wrong\n", OSA_TEST_THREADS,
+		   atomic_load(&s_transactions), atomic_load(&s_overlaps), errors, mismatches);
+	CHECK(atomic_load(&s_transactions) >= OSA_TEST_THREADS * OSA_TEST_ROUNDS * 2U);
+	CHECK(atomic_load(&s_overlaps) == 0);
+	CHECK((errors == 0) && (mismatches == 0));
+}
+
+static uint64_t now_us(clockid_t clock)
+{
+	struct timespec ts;
+
+	clock_gettime(clock, &ts);
+	return (uint64_t)ts.tv_sec * 1000000U + (uint64_t)ts.tv_nsec / 1000U;
+}
+
+/* The "ISR": completes the transfer after OSA_TEST_SIGNAL_MS, or only gives the semaphore. */
+static void *signaler(void *arg)
+{
+	bool complete = *(bool *)arg;
+
+	usleep(OSA_TEST_SIGNAL_MS * 1000U);
+	if (complete)
+	{
+		s_done = true;
+	}
+	Register_OS_Signal(OSA_TEST_BUS);
+
+	return NULL;
+}
+
+static void test_wait(void)
+{
+	pthread_t thread;
+	uint64_t start, cpu;
+	bool complete;
+
+	/* The objects of the bus exist once it was taken. */
+	CHECK(Register_OS_Lock(OSA_TEST_BUS) == ARM_DRIVER_OK);
+	Register_OS_Unlock(OSA_TEST_BUS);
+
+	/* Blocks until the completion, the thread sleeps meanwhile */
+	s_done = false;
+	complete = true;
+	start = now_us(CLOCK_MONOTONIC);
+	cpu = now_us(CLOCK_THREAD_CPUTIME_ID);
+	CHECK(pthread_create(&thread, NULL, signaler, &complete) == 0);
+	CHECK(Register_OS_Wait(OSA_TEST_BUS, &s_done, 0) == ARM_DRIVER_OK);
+	cpu = now_us(CLOCK_THREAD_CPUTIME_ID) - cpu;
+	start = now_us(CLOCK_MONOTONIC) - start;
+	pthread_join(thread, NULL);
+	printf("osa_test: signaled wait %u us, %u us on the CPU\n", (uint32_t)start, (uint32_t)cpu);
+	CHECK(s_done);
+	CHECK(start >= (OSA_TEST_SIGNAL_MS - 5U) * 1000U);
+	CHECK(cpu < start / 4U);
+
+	/* No completion, the deadline ends the wait */
+	s_done = false;
+	start = now_us(CLOCK_MONOTONIC);
+	CHECK(Register_OS_Wait(OSA_TEST_BUS, &s_done, OSA_TEST_TIMEOUT_US) == ARM_DRIVER_ERROR_TIMEOUT);
+	start = now_us(CLOCK_MONOTONIC) - start;
+	CHECK(start >= OSA_TEST_TIMEOUT_US);
+
+	/* A give without the completion, as left by an aborted transfer, does not end the wait early */
+	s_done = false;
+	complete = false;
+	start = now_us(CLOCK_MONOTONIC);
+	CHECK(pthread_create(&thread, NULL, signaler, &complete) == 0);
+	CHECK(Register_OS_Wait(OSA_TEST_BUS, &s_done, 2U * OSA_TEST_TIMEOUT_US) == ARM_DRIVER_ERROR_TIMEOUT);
+	start = now_us(CLOCK_MONOTONIC) - start;
+	pthread_join(thread, NULL);
+	CHECK(start >= 2U * OSA_TEST_TIMEOUT_US);
+
+	/* A completion already in place returns at once */
+	s_done = true;
+	CHECK(Register_OS_Wait(OSA_TEST_BUS, &s_done, OSA_TEST_TIMEOUT_US) == ARM_DRIVER_OK);
+}
+
+/* The register I/O takes the bus again inside a locked section (a masked write reads first). */
+static void test_nested(void)
+{
+	CHECK(Register_OS_Lock(OSA_TEST_BUS) == ARM_DRIVER_OK);
+	CHECK(Register_OS_Lock(OSA_TEST_BUS) == ARM_DRIVER_OK);
+	Register_OS_Unlock(OSA_TEST_BUS);
+	Register_OS_Unlock(OSA_TEST_BUS);
+}
+
+int main(void)
+{
+	test_serialized();
+	test_wait();
+	test_nested();
+
+	printf("osa_test: %s\n", s_failures ? "FAIL" : "PASS");
+	return s_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
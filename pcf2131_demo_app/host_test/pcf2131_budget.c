@@ -0,0 +1,810 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pcf2131_budget.c
+ * @brief Bus transaction budgets of the PCF2131 driver APIs. Costs compose from a few transactions: an I2C
+ *        register read is two transfers (offset, then the data behind a repeated START), an I2C write or block
+ *        write one transfer of offset and data, any SPI access one transfer of the command byte and the data.
+ *        A masked write reads the register first, the time, alarm and timestamp reads add a Control_1 read for
+ *        the hour mode.
+ */
+
+#include <string.h>
+
+#include "mock_bus.h"
+#include "pcf2131.h"
+#include "pcf2131_aging.h"
+#include "pcf2131_budget.h"
+#include "pcf2131_link.h"
+#include "pcf2131_poll.h"
+#include "pcf2131_snapshot.h"
+#include "pcf2131_timepub.h"
+
+/* Budget of an API on each bus: transfers and bytes on SPI, then on I2C. */
+#if (I2C_ENABLE)
+#define PCF2131_BUDGET(spiTransfers, spiBytes, i2cTransfers, i2cBytes) (i2cTransfers), (i2cBytes)
+#else
+#define PCF2131_BUDGET(spiTransfers, spiBytes, i2cTransfers, i2cBytes) (spiTransfers), (spiBytes)
+#endif
+
+/* Bytes of the in place transfers. */
+#define PCF2131_BUDGET_INPLACE_LENGTH (4)
+
+static const registerreadlist_t s_timeData[] = {
+	{.readFrom = PCF2131_100TH_SECOND, .numBytes = PCF2131_TIME_SIZE_BYTE}, __END_READ_DATA__};
+
+static const registerreadlist_t s_alarmData[] = {
+	{.readFrom = PCF2131_SECOND_ALARM, .numBytes = PCF2131_ALARM_TIME_SIZE_BYTE}, __END_READ_DATA__};
+
+static const registerreadlist_t s_tsData[] = {
+	{.readFrom = PCF2131_TIMESTAMP1_SECONDS, .numBytes = PCF2131_TS_SIZE_BYTE}, __END_READ_DATA__};
+
+/* A plain write and a masked one. */
+static const registerwritelist_t s_config[] = {
+	{PCF2131_AGING_OFFSET, 0x08, 0x00},
+	{PCF2131_CTRL1, PCF2131_CTRL1_MI_MASK, PCF2131_CTRL1_MI_MASK},
+	__END_WRITE_DATA__};
+
+static const pcf2131_timedata_t s_time = {.second_100th = 0x50, .second = 12, .minutes = 34, .hours = 10,
+										  .days = 21, .weekdays = Friday, .months = 6, .years = 24, .ampm = h24};
+
+static pcf2131_alarmdata_t s_alarm = {.second = 30, .minutes = 15, .hours = 8, .days = 3, .weekdays = Monday,
+									  .ampm = h24};
+
+static uint8_t s_buffer[PCF2131_BUF_HEADROOM + PCF2131_BUDGET_INPLACE_LENGTH];
+static pcf2131_snapshot_t s_snapshot;
+static pcf2131_drift_t s_drift;
+static pcf2131_timepub_t s_pub;
+static uint32_t s_pin;
+#if (I2C_ENABLE)
+static const uint16_t s_address = 0x53;
+#else
+static uint32_t s_slaveSelect;
+#endif
+
+/* The stand-in timer of the external clock test mode. */
+static void budget_timer_start(void)
+{
+}
+
+static int32_t budget_timer_clock(uint32_t freq, uint32_t edges)
+{
+	return 0;
+}
+
+static void budget_timer_stop(void)
+{
+}
+
+static const pcf2131_extclk_t s_timer = {budget_timer_start, budget_timer_clock, budget_timer_stop};
+
+int32_t PCF2131_Budget_Init(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	memset(pSensorHandle, 0, sizeof(*pSensorHandle));
+#if (I2C_ENABLE)
+	return PCF2131_Initialize(pSensorHandle, &Mock_I2C_Driver, 0, s_address);
+#else
+	return PCF2131_Initialize(pSensorHandle, &Mock_SPI_Driver, 0, &s_slaveSelect);
+#endif
+}
+
+/* Runs a started transfer or polled operation to its end. */
+static int32_t budget_finish(pcf2131_sensorhandle_t *pSensorHandle, int32_t status,
+							 int32_t (*poll)(pcf2131_sensorhandle_t *pSensorHandle))
+{
+	while (SENSOR_ERROR_NONE == status)
+	{
+		status = poll(pSensorHandle);
+		if (SENSOR_ERROR_BUSY != status)
+		{
+			return status;
+		}
+		status = SENSOR_ERROR_NONE;
+	}
+
+	return status;
+}
+
+/* Setups */
+
+static int32_t budget_begin(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	int32_t status = PCF2131_Begin(pSensorHandle);
+
+	if (SENSOR_ERROR_NONE == status)
+	{
+		status = PCF2131_SecInt_Enable(pSensorHandle, IntA);
+	}
+	if (SENSOR_ERROR_NONE == status)
+	{
+		status = PCF2131_MinInt_Enable(pSensorHandle, IntA);
+	}
+	if (SENSOR_ERROR_NONE == status)
+	{
+		status = PCF2131_AlarmInt_Enable(pSensorHandle, IntA, A_Seconds);
+	}
+
+	return status;
+}
+
+/* A snapshot of the configured map to restore, then settings moved away from it. */
+static int32_t budget_moved(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	memcpy(s_snapshot.reg, g_Mock_Regs, PCF2131_REG_MAP_SIZE);
+	g_Mock_Regs[PCF2131_CTRL1] ^= PCF2131_CTRL1_SI_MASK;
+	g_Mock_Regs[PCF2131_CLKOUT_CTL] = clkout1Hz;
+	g_Mock_Regs[PCF2131_INT_A_MASK1] = 0x3F;
+	g_Mock_Regs[PCF2131_INT_A_MASK2] = 0x0F;
+
+	return SENSOR_ERROR_NONE;
+}
+
+static int32_t budget_watchdog(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_Watchdog_Config(pSensorHandle, wdClk4Hz, 8);
+}
+
+static int32_t budget_piggyback(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	int32_t status = PCF2131_Watchdog_Config(pSensorHandle, wdClk4Hz, 8);
+
+	return (SENSOR_ERROR_NONE != status) ? status : PCF2131_Watchdog_Piggyback(pSensorHandle, true);
+}
+
+static int32_t budget_exttest(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_ExtTest_Enable(pSensorHandle, NULL, &s_timer);
+}
+
+/* Drift samples over a day, the RTC 10 ms a day fast. */
+static int32_t budget_drift(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	pcf2131_timedata_t time = s_time;
+	int64_t ref_ms = 0;
+	int32_t status = SENSOR_ERROR_NONE;
+	uint8_t i;
+
+	PCF2131_Drift_Init(&s_drift, 86400, NULL);
+	for (i = 0; (i < PCF2131_DRIFT_MIN_SAMPLES) && (SENSOR_ERROR_NONE == status); i++)
+	{
+		time.days = (uint8_t)(s_time.days + i);
+		time.second_100th = i;
+		status = PCF2131_Drift_AddSample(&s_drift, ref_ms, &time);
+		ref_ms += 86400000;
+	}
+
+	return status;
+}
+
+/* Initialization and bus access */
+
+static int32_t budget_initialize(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_Budget_Init(pSensorHandle);
+}
+
+static int32_t budget_set_idle_task(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	PCF2131_SetIdleTask(pSensorHandle, NULL, NULL);
+	return SENSOR_ERROR_NONE;
+}
+
+static int32_t budget_set_timeout(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	PCF2131_SetTimeout(pSensorHandle, PCF2131_BUS_TIMEOUT_US);
+	return SENSOR_ERROR_NONE;
+}
+
+static int32_t budget_set_arbiter(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	PCF2131_SetArbiter(pSensorHandle, NULL);
+	return SENSOR_ERROR_NONE;
+}
+
+static int32_t budget_set_bus_speed(pcf2131_sensorhandle_t *pSensorHandle)
+{
+#if (I2C_ENABLE)
+	return PCF2131_SetBusSpeed(pSensorHandle, ARM_I2C_BUS_SPEED_FAST);
+#else
+	return PCF2131_SetBusSpeed(pSensorHandle, 1000000);
+#endif
+}
+
+static int32_t budget_bus_count(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	registerIoCount_t count;
+
+	PCF2131_GetBusCount(pSensorHandle, &count);
+	PCF2131_ClearBusCount(pSensorHandle);
+	return SENSOR_ERROR_NONE;
+}
+
+static int32_t budget_bcd(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return (BcdToDecimal(DecimaltoBcd(59)) == 59) ? SENSOR_ERROR_NONE : SENSOR_ERROR_INVALID_PARAM;
+}
+
+#if !(I2C_ENABLE)
+/* The SPI command formatting, called by the register I/O layer. */
+static int32_t budget_preprocess(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	uint8_t cmd[PCF2131_SPI_CMD_LEN + 1], value = 0;
+	spiCmdParams_t cmdParams = {.pWriteBuffer = cmd};
+
+	PCF2131_ReadPreprocess(&cmdParams, PCF2131_CTRL1, 1);
+	PCF2131_WritePreprocess(&cmdParams, PCF2131_CTRL1, 1, &value);
+	return SENSOR_ERROR_NONE;
+}
+#endif
+
+static int32_t budget_configure(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_Configure(pSensorHandle, s_config);
+}
+
+static int32_t budget_read_in_place(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_ReadInPlace(pSensorHandle, PCF2131_CTRL1, PCF2131_BUDGET_INPLACE_LENGTH, s_buffer);
+}
+
+static int32_t budget_write_in_place(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	memcpy(&s_buffer[PCF2131_BUF_HEADROOM], &g_Mock_Regs[PCF2131_INT_A_MASK1], PCF2131_BUDGET_INPLACE_LENGTH);
+	return PCF2131_WriteInPlace(pSensorHandle, PCF2131_INT_A_MASK1, PCF2131_BUDGET_INPLACE_LENGTH, s_buffer);
+}
+
+static int32_t budget_start_read_in_place(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return budget_finish(pSensorHandle,
+			PCF2131_StartReadInPlace(pSensorHandle, PCF2131_CTRL1, PCF2131_BUDGET_INPLACE_LENGTH, s_buffer),
+			PCF2131_PollTransfer);
+}
+
+static int32_t budget_start_write_in_place(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	memcpy(&s_buffer[PCF2131_BUF_HEADROOM], &g_Mock_Regs[PCF2131_INT_A_MASK1], PCF2131_BUDGET_INPLACE_LENGTH);
+	return budget_finish(pSensorHandle,
+			PCF2131_StartWriteInPlace(pSensorHandle, PCF2131_INT_A_MASK1, PCF2131_BUDGET_INPLACE_LENGTH, s_buffer),
+			PCF2131_PollTransfer);
+}
+
+static int32_t budget_poll_transfer(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_PollTransfer(pSensorHandle);
+}
+
+static int32_t budget_begin_only(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_Begin(pSensorHandle);
+}
+
+static int32_t budget_commit(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_Commit(pSensorHandle);
+}
+
+static int32_t budget_abort(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_Abort(pSensorHandle);
+}
+
+static int32_t budget_deinit(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_Deinit(pSensorHandle);
+}
+
+/* Time, mode and reset */
+
+static int32_t budget_rtc_start(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_Rtc_Start(pSensorHandle);
+}
+
+static int32_t budget_rtc_stop(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_Rtc_Stop(pSensorHandle);
+}
+
+static int32_t budget_sw_rst(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_SwRst(pSensorHandle, CPR);
+}
+
+static int32_t budget_get_time(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	pcf2131_timedata_t time;
+
+	return PCF2131_GetTime(pSensorHandle, s_timeData, &time);
+}
+
+static int32_t budget_set_time(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	pcf2131_timedata_t time = s_time;
+
+	return PCF2131_SetTime(pSensorHandle, &time);
+}
+
+static int32_t budget_mode_set(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_12h_24h_Mode_Set(pSensorHandle, mode12H);
+}
+
+static int32_t budget_mode_get(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	Mode12h_24h mode;
+
+	return PCF2131_12h_24h_Mode_Get(pSensorHandle, &mode);
+}
+
+static int32_t budget_sec100th_set(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_Sec100TH_Mode(pSensorHandle, s100thDisable);
+}
+
+static int32_t budget_sec100th_get(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	S100thMode mode;
+
+	return PCF2131_Sec100TH_Mode_Get(pSensorHandle, &mode);
+}
+
+/* Minute and second interrupts */
+
+static int32_t budget_sec_int_enable(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_SecInt_Enable(pSensorHandle, IntB);
+}
+
+static int32_t budget_sec_int_disable(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_SecInt_Disable(pSensorHandle);
+}
+
+static int32_t budget_check_min_sec_int(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	IntState state;
+
+	return PCF2131_Check_MinSecInt(pSensorHandle, &state);
+}
+
+static int32_t budget_clear_min_sec_int(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_Clear_MinSecInt(pSensorHandle);
+}
+
+static int32_t budget_min_int_enable(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_MinInt_Enable(pSensorHandle, IntB);
+}
+
+static int32_t budget_min_int_disable(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_MinInt_Disable(pSensorHandle);
+}
+
+/* Timestamps */
+
+static int32_t budget_timestamp_on(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_TimeStamp_On(pSensorHandle, sw2Ts);
+}
+
+static int32_t budget_timestamp_off(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_TimeStamp_Off(pSensorHandle, sw1Ts);
+}
+
+static int32_t budget_get_ts(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	pcf2131_timestamp_t ts;
+
+	return PCF2131_GetTs(pSensorHandle, s_tsData, sw1Ts, &ts);
+}
+
+static int32_t budget_ts_int_enable(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_SW_TsInt_Enable(pSensorHandle, sw2Ts, IntA);
+}
+
+static int32_t budget_ts_int_disable(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_SW_TsInt_Disable(pSensorHandle, sw1Ts);
+}
+
+static int32_t budget_clear_ts_int(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_Clear_SW_TsInt(pSensorHandle, sw1Ts);
+}
+
+static int32_t budget_check_ts_int(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	IntState state;
+
+	return PCF2131_Check_SW_TsInt(pSensorHandle, sw1Ts, &state);
+}
+
+/* Alarm */
+
+static int32_t budget_clear_alarm_int(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_Clear_AlarmInt(pSensorHandle);
+}
+
+static int32_t budget_check_alarm_int(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	IntState state;
+
+	return PCF2131_Check_AlarmInt(pSensorHandle, &state);
+}
+
+static int32_t budget_alarm_int_enable(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_AlarmInt_Enable(pSensorHandle, IntA, A_Minute);
+}
+
+static int32_t budget_alarm_int_disable(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_AlarmInt_Disable(pSensorHandle);
+}
+
+static int32_t budget_get_alarm_time(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	pcf2131_alarmdata_t alarm;
+
+	return PCF2131_GetAlarmTime(pSensorHandle, s_alarmData, &alarm);
+}
+
+static int32_t budget_set_alarm_time(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	pcf2131_alarmdata_t alarm = s_alarm;
+
+	return PCF2131_SetAlarmTime(pSensorHandle, &alarm);
+}
+
+/* Battery */
+
+static int32_t budget_bat_so_ts(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_Bat_SwitchOverTS(pSensorHandle, SoTsEnable);
+}
+
+static int32_t budget_bat_so_ts_disable(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_Bat_SwitchOverTS_Disable(pSensorHandle);
+}
+
+static int32_t budget_bat_so_ts_enable(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_Bat_SwitchOverTS_Enable(pSensorHandle, IntA);
+}
+
+static int32_t budget_clear_so_int(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_Clear_SwitchOverInt(pSensorHandle);
+}
+
+static int32_t budget_check_so_int(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	IntStatus status;
+
+	return PCF2131_Check_SwitchOverInt(pSensorHandle, &status);
+}
+
+static int32_t budget_bat_so_int(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_Bat_SwitchOverInt(pSensorHandle, intEnable);
+}
+
+static int32_t budget_check_low_bat_enable(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_Check_LowBatStatusEnable(pSensorHandle);
+}
+
+static int32_t budget_check_low_bat(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	IntStatus status;
+
+	return PCF2131_Check_LowBatStatus(pSensorHandle, &status);
+}
+
+static int32_t budget_low_bat_int(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_LowBatInt(pSensorHandle, lbIntEnable);
+}
+
+/* Watchdog */
+
+static int32_t budget_watchdog_config(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_Watchdog_Config(pSensorHandle, wdClk4Hz, 8);
+}
+
+static int32_t budget_watchdog_enable(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_Watchdog_Enable(pSensorHandle);
+}
+
+static int32_t budget_watchdog_disable(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_Watchdog_Disable(pSensorHandle);
+}
+
+static int32_t budget_watchdog_kick(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_Watchdog_Kick(pSensorHandle);
+}
+
+static int32_t budget_watchdog_piggyback(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_Watchdog_Piggyback(pSensorHandle, true);
+}
+
+/* A burst read with the piggyback kick on. */
+static int32_t budget_piggyback_read(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return budget_get_time(pSensorHandle);
+}
+
+static int32_t budget_watchdog_int_enable(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_WatchdogInt_Enable(pSensorHandle, IntA);
+}
+
+static int32_t budget_watchdog_int_disable(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_WatchdogInt_Disable(pSensorHandle);
+}
+
+static int32_t budget_check_watchdog_int(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	IntState state;
+
+	return PCF2131_Check_WatchdogInt(pSensorHandle, &state);
+}
+
+/* CLKOUT, external clock test mode and aging offset */
+
+static int32_t budget_clkout_set(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_ClkOut_Set(pSensorHandle, clkout1024Hz);
+}
+
+static int32_t budget_clkout_calibrate(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	int32_t ppm;
+
+	return PCF2131_ClkOut_Calibrate(pSensorHandle, &s_pin, 4, &ppm);
+}
+
+static int32_t budget_exttest_enable(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_ExtTest_Enable(pSensorHandle, NULL, &s_timer);
+}
+
+static int32_t budget_exttest_clock(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_ExtTest_Clock(pSensorHandle, 1, 1, NULL);
+}
+
+static int32_t budget_exttest_disable(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_ExtTest_Disable(pSensorHandle);
+}
+
+static int32_t budget_aging_set(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_AgingOffset_Set(pSensorHandle, 0x0A);
+}
+
+static int32_t budget_aging_get(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	uint8_t code;
+
+	return PCF2131_AgingOffset_Get(pSensorHandle, &code);
+}
+
+/* Snapshot, polled operations, link, aging and time publication */
+
+static int32_t budget_snapshot(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	static pcf2131_snapshot_t snapshot;
+
+	return PCF2131_Snapshot(pSensorHandle, &snapshot);
+}
+
+static int32_t budget_restore(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_Restore(pSensorHandle, &s_snapshot, NULL);
+}
+
+static int32_t budget_start_set_time(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return budget_finish(pSensorHandle, PCF2131_Start_SetTime(pSensorHandle, &s_time), PCF2131_Poll);
+}
+
+static int32_t budget_start_get_time(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	static pcf2131_timedata_t time;
+
+	return budget_finish(pSensorHandle, PCF2131_Start_GetTime(pSensorHandle, &time), PCF2131_Poll);
+}
+
+static int32_t budget_start_configure(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return budget_finish(pSensorHandle, PCF2131_Start_Configure(pSensorHandle, s_config), PCF2131_Poll);
+}
+
+static int32_t budget_start_sec_int_enable(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return budget_finish(pSensorHandle, PCF2131_Start_SecInt_Enable(pSensorHandle, IntB), PCF2131_Poll);
+}
+
+static int32_t budget_start_min_int_enable(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return budget_finish(pSensorHandle, PCF2131_Start_MinInt_Enable(pSensorHandle, IntB), PCF2131_Poll);
+}
+
+static int32_t budget_start_snapshot(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	static pcf2131_snapshot_t snapshot;
+
+	return budget_finish(pSensorHandle, PCF2131_Start_Snapshot(pSensorHandle, &snapshot), PCF2131_Poll);
+}
+
+static int32_t budget_poll(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	return PCF2131_Poll(pSensorHandle);
+}
+
+/* A fault while probing a faster rate shows in the rate selected, not in the status: a fallback is reported
+ * as a read error here. */
+#if (I2C_ENABLE)
+static int32_t budget_negotiate(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	int32_t status = PCF2131_I2C_Negotiate(pSensorHandle, 2, NULL);
+
+	if ((SENSOR_ERROR_NONE == status) && (pSensorHandle->busSpeed != ARM_I2C_BUS_SPEED_FAST_PLUS))
+	{
+		status = SENSOR_ERROR_READ;
+	}
+
+	return status;
+}
+#else
+static int32_t budget_spi_tune(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	static const uint32_t rates[] = {1000000, 4000000};
+	const pcf2131_spitune_t tune = {.pRates = rates, .nRates = 2, .trials = 2, .maxErrors = 0, .log = NULL};
+	uint32_t baud = 0;
+	int32_t status = PCF2131_SPI_Tune(pSensorHandle, &tune, &baud);
+
+	if ((SENSOR_ERROR_NONE == status) && (baud != rates[1]))
+	{
+		status = SENSOR_ERROR_READ;
+	}
+
+	return status;
+}
+#endif
+
+static int32_t budget_drift_commit(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	uint8_t code;
+
+	return PCF2131_Drift_Commit(pSensorHandle, &s_drift, &code);
+}
+
+static int32_t budget_timepub_update(pcf2131_sensorhandle_t *pSensorHandle)
+{
+	PCF2131_TimePub_Init(&s_pub);
+	return PCF2131_TimePub_Update(pSensorHandle, s_timeData, &s_pub);
+}
+
+const pcf2131_budget_t g_Pcf2131_Budgets[] = {
+	/* Initialization and bus access */
+	{"Initialize", NULL, budget_initialize, PCF2131_BUDGET(0, 0, 0, 0)},
+	{"SetIdleTask", NULL, budget_set_idle_task, PCF2131_BUDGET(0, 0, 0, 0)},
+	{"SetTimeout", NULL, budget_set_timeout, PCF2131_BUDGET(0, 0, 0, 0)},
+	{"SetArbiter", NULL, budget_set_arbiter, PCF2131_BUDGET(0, 0, 0, 0)},
+	{"SetBusSpeed", NULL, budget_set_bus_speed, PCF2131_BUDGET(0, 0, 0, 0)},
+	{"GetBusCount/ClearBusCount", NULL, budget_bus_count, PCF2131_BUDGET(0, 0, 0, 0)},
+	{"DecimaltoBcd/BcdToDecimal", NULL, budget_bcd, PCF2131_BUDGET(0, 0, 0, 0)},
+#if !(I2C_ENABLE)
+	{"ReadPreprocess/WritePreprocess", NULL, budget_preprocess, PCF2131_BUDGET(0, 0, 0, 0)},
+#endif
+	{"Configure", NULL, budget_configure, PCF2131_BUDGET(3, 6, 4, 6)},
+	{"ReadInPlace", NULL, budget_read_in_place, PCF2131_BUDGET(1, 5, 2, 5)},
+	{"WriteInPlace", NULL, budget_write_in_place, PCF2131_BUDGET(1, 5, 1, 5)},
+	{"StartReadInPlace", NULL, budget_start_read_in_place, PCF2131_BUDGET(1, 5, 2, 5)},
+	{"StartWriteInPlace", NULL, budget_start_write_in_place, PCF2131_BUDGET(1, 5, 1, 5)},
+	{"PollTransfer", NULL, budget_poll_transfer, PCF2131_BUDGET(0, 0, 0, 0)},
+	{"Begin", NULL, budget_begin_only, PCF2131_BUDGET(0, 0, 0, 0)},
+	{"Commit", budget_begin, budget_commit, PCF2131_BUDGET(6, 22, 7, 20)},
+	{"Abort", budget_begin, budget_abort, PCF2131_BUDGET(0, 0, 0, 0)},
+	{"Deinit", NULL, budget_deinit, PCF2131_BUDGET(2, 4, 3, 4)},
+	/* Time, mode and reset */
+	{"Rtc_Start", NULL, budget_rtc_start, PCF2131_BUDGET(2, 4, 3, 4)},
+	{"Rtc_Stop", NULL, budget_rtc_stop, PCF2131_BUDGET(2, 4, 3, 4)},
+	{"SwRst", NULL, budget_sw_rst, PCF2131_BUDGET(2, 4, 3, 4)},
+	{"GetTime", NULL, budget_get_time, PCF2131_BUDGET(2, 11, 4, 11)},
+	{"SetTime", NULL, budget_set_time, PCF2131_BUDGET(16, 32, 24, 32)},
+	{"12h_24h_Mode_Set", NULL, budget_mode_set, PCF2131_BUDGET(2, 4, 3, 4)},
+	{"12h_24h_Mode_Get", NULL, budget_mode_get, PCF2131_BUDGET(1, 2, 2, 2)},
+	{"Sec100TH_Mode", NULL, budget_sec100th_set, PCF2131_BUDGET(2, 4, 3, 4)},
+	{"Sec100TH_Mode_Get", NULL, budget_sec100th_get, PCF2131_BUDGET(1, 2, 2, 2)},
+	/* Minute and second interrupts */
+	{"SecInt_Enable", NULL, budget_sec_int_enable, PCF2131_BUDGET(4, 8, 6, 8)},
+	{"SecInt_Disable", NULL, budget_sec_int_disable, PCF2131_BUDGET(6, 12, 9, 12)},
+	{"Check_MinSecInt", NULL, budget_check_min_sec_int, PCF2131_BUDGET(1, 2, 2, 2)},
+	{"Clear_MinSecInt", NULL, budget_clear_min_sec_int, PCF2131_BUDGET(2, 4, 3, 4)},
+	{"MinInt_Enable", NULL, budget_min_int_enable, PCF2131_BUDGET(4, 8, 6, 8)},
+	{"MinInt_Disable", NULL, budget_min_int_disable, PCF2131_BUDGET(6, 12, 3, 4)},
+	/* Timestamps */
+	{"TimeStamp_On", NULL, budget_timestamp_on, PCF2131_BUDGET(2, 4, 3, 4)},
+	{"TimeStamp_Off", NULL, budget_timestamp_off, PCF2131_BUDGET(2, 4, 3, 4)},
+	{"GetTs", NULL, budget_get_ts, PCF2131_BUDGET(2, 9, 4, 9)},
+	{"SW_TsInt_Enable", NULL, budget_ts_int_enable, PCF2131_BUDGET(4, 8, 6, 8)},
+	{"SW_TsInt_Disable", NULL, budget_ts_int_disable, PCF2131_BUDGET(6, 12, 9, 12)},
+	{"Clear_SW_TsInt", NULL, budget_clear_ts_int, PCF2131_BUDGET(2, 4, 3, 4)},
+	{"Check_SW_TsInt", NULL, budget_check_ts_int, PCF2131_BUDGET(1, 2, 2, 2)},
+	/* Alarm */
+	{"Clear_AlarmInt", NULL, budget_clear_alarm_int, PCF2131_BUDGET(2, 4, 3, 4)},
+	{"Check_AlarmInt", NULL, budget_check_alarm_int, PCF2131_BUDGET(1, 2, 2, 2)},
+	{"AlarmInt_Enable", NULL, budget_alarm_int_enable, PCF2131_BUDGET(12, 24, 18, 24)},
+	{"AlarmInt_Disable", NULL, budget_alarm_int_disable, PCF2131_BUDGET(6, 12, 3, 4)},
+	{"GetAlarmTime", NULL, budget_get_alarm_time, PCF2131_BUDGET(2, 8, 4, 8)},
+	{"SetAlarmTime", NULL, budget_set_alarm_time, PCF2131_BUDGET(10, 20, 15, 20)},
+	/* Battery */
+	{"Bat_SwitchOverTS", NULL, budget_bat_so_ts, PCF2131_BUDGET(2, 4, 3, 4)},
+	{"Bat_SwitchOverTS_Disable", NULL, budget_bat_so_ts_disable, PCF2131_BUDGET(2, 4, 3, 4)},
+	{"Bat_SwitchOverTS_Enable", NULL, budget_bat_so_ts_enable, PCF2131_BUDGET(2, 4, 3, 4)},
+	{"Clear_SwitchOverInt", NULL, budget_clear_so_int, PCF2131_BUDGET(2, 4, 3, 4)},
+	{"Check_SwitchOverInt", NULL, budget_check_so_int, PCF2131_BUDGET(1, 2, 2, 2)},
+	{"Bat_SwitchOverInt", NULL, budget_bat_so_int, PCF2131_BUDGET(2, 4, 3, 4)},
+	{"Check_LowBatStatusEnable", NULL, budget_check_low_bat_enable, PCF2131_BUDGET(2, 4, 3, 4)},
+	{"Check_LowBatStatus", NULL, budget_check_low_bat, PCF2131_BUDGET(1, 2, 2, 2)},
+	{"LowBatInt", NULL, budget_low_bat_int, PCF2131_BUDGET(2, 4, 3, 4)},
+	/* Watchdog */
+	{"Watchdog_Config", NULL, budget_watchdog_config, PCF2131_BUDGET(2, 4, 3, 4)},
+	{"Watchdog_Enable", budget_watchdog, budget_watchdog_enable, PCF2131_BUDGET(1, 3, 1, 3)},
+	{"Watchdog_Disable", budget_watchdog, budget_watchdog_disable, PCF2131_BUDGET(1, 2, 1, 2)},
+	{"Watchdog_Kick", budget_watchdog, budget_watchdog_kick, PCF2131_BUDGET(1, 2, 1, 2)},
+	{"Watchdog_Piggyback", budget_watchdog, budget_watchdog_piggyback, PCF2131_BUDGET(0, 0, 0, 0)},
+	{"GetTime, piggyback kick", budget_piggyback, budget_piggyback_read, PCF2131_BUDGET(3, 13, 5, 13)},
+	{"WatchdogInt_Enable", NULL, budget_watchdog_int_enable, PCF2131_BUDGET(2, 4, 3, 4)},
+	{"WatchdogInt_Disable", NULL, budget_watchdog_int_disable, PCF2131_BUDGET(4, 8, 6, 8)},
+	{"Check_WatchdogInt", NULL, budget_check_watchdog_int, PCF2131_BUDGET(1, 2, 2, 2)},
+	/* CLKOUT, external clock test mode and aging offset */
+	{"ClkOut_Set", NULL, budget_clkout_set, PCF2131_BUDGET(2, 4, 3, 4)},
+	{"ClkOut_Calibrate", NULL, budget_clkout_calibrate, PCF2131_BUDGET(3, 6, 4, 6)},
+	{"ExtTest_Enable", NULL, budget_exttest_enable, PCF2131_BUDGET(2, 4, 3, 4)},
+	{"ExtTest_Clock", budget_exttest, budget_exttest_clock, PCF2131_BUDGET(0, 0, 0, 0)},
+	{"ExtTest_Disable", budget_exttest, budget_exttest_disable, PCF2131_BUDGET(2, 4, 3, 4)},
+	{"AgingOffset_Set", NULL, budget_aging_set, PCF2131_BUDGET(1, 2, 1, 2)},
+	{"AgingOffset_Get", NULL, budget_aging_get, PCF2131_BUDGET(1, 2, 2, 2)},
+	/* Snapshot and restore */
+	{"Snapshot", NULL, budget_snapshot, PCF2131_BUDGET(1, 56, 2, 56)},
+	{"Restore", budget_moved, budget_restore, PCF2131_BUDGET(4, 63, 5, 63)},
+	/* Polled operations */
+	{"Start_SetTime", NULL, budget_start_set_time, PCF2131_BUDGET(2, 18, 3, 18)},
+	{"Start_GetTime", NULL, budget_start_get_time, PCF2131_BUDGET(1, 15, 2, 15)},
+	{"Start_Configure", NULL, budget_start_configure, PCF2131_BUDGET(3, 6, 4, 6)},
+	{"Start_SecInt_Enable", NULL, budget_start_sec_int_enable, PCF2131_BUDGET(4, 8, 6, 8)},
+	{"Start_MinInt_Enable", NULL, budget_start_min_int_enable, PCF2131_BUDGET(4, 8, 6, 8)},
+	{"Start_Snapshot", NULL, budget_start_snapshot, PCF2131_BUDGET(1, 56, 2, 56)},
+	{"Poll", NULL, budget_poll, PCF2131_BUDGET(0, 0, 0, 0)},
+	/* Link, aging and time publication */
+#if (I2C_ENABLE)
+	{"I2C_Negotiate", NULL, budget_negotiate, PCF2131_BUDGET(0, 0, 12, 54)},
+#else
+	{"SPI_Tune", NULL, budget_spi_tune, PCF2131_BUDGET(14, 84, 0, 0)},
+#endif
+	{"Drift_Commit", budget_drift, budget_drift_commit, PCF2131_BUDGET(1, 2, 2, 2)},
+	{"TimePub_Update", NULL, budget_timepub_update, PCF2131_BUDGET(2, 11, 4, 11)},
+};
+
+const uint32_t g_Pcf2131_BudgetCount = sizeof(g_Pcf2131_Budgets) / sizeof(g_Pcf2131_Budgets[0]);
@@ -0,0 +1,38 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pcf2131_budget.h
+ * @brief Bus transaction budgets of the PCF2131 driver APIs for the host tests: every function of
+ *        pcf2131_drv.h, the snapshot, polled, link, aging and time publication APIs, with the transfers
+ *        and bytes each may put on the bus of the build (SPI or I2C). An API without bus traffic has a
+ *        budget of zero. The entries run on a fresh handle over the simulated register map (mock_bus.h).
+ */
+
+#ifndef PCF2131_BUDGET_H_
+#define PCF2131_BUDGET_H_
+
+#include <stdint.h>
+
+#include "pcf2131_drv.h"
+
+typedef struct
+{
+	const char *name;                                         /* API, without the PCF2131_ prefix. */
+	int32_t (*setup)(pcf2131_sensorhandle_t *pSensorHandle);  /* State the API needs, not budgeted, or NULL. */
+	int32_t (*run)(pcf2131_sensorhandle_t *pSensorHandle);    /* The API, run to its end. */
+	uint16_t transfers;                                       /* Budget on the bus of the build. */
+	uint16_t bytes;
+} pcf2131_budget_t;
+
+/*! @brief The budget table and its length. */
+extern const pcf2131_budget_t g_Pcf2131_Budgets[];
+extern const uint32_t g_Pcf2131_BudgetCount;
+
+/*! @brief Initializes pSensorHandle on bus 0 of the simulated bus, with no bus traffic. */
+int32_t PCF2131_Budget_Init(pcf2131_sensorhandle_t *pSensorHandle);
+
+#endif /* PCF2131_BUDGET_H_ */
@@ -0,0 +1,135 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pcf2131_cli.c
+ * @brief Command line front end of the client library for a board in protocol mode
+ *        (menu option of the demo that calls PCF2131_Proto_Run()).
+ *
+ *   pcf2131_cli <tty> [-b baud] ping | time | settime <iso> | read <offset> <length> | bench <ops> | exit
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "pcf2131_client.h"
+
+static int usage(void)
+{
+	fprintf(stderr, "usage: pcf2131_cli <tty> [-b baud] ping | time | settime <iso> | read <offset> <length> |"
+					" bench <ops> | exit\n");
+	return EXIT_FAILURE;
+}
+
+/* Runs batches of GET_TIME until ops have been answered, prints the rate. */
+static int bench(pcf2131_client_t *pClient, long ops)
+{
+	pcf2131_client_rsp_t rsp;
+	struct timespec start, end;
+	long done = 0;
+	int n;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	while (done < ops)
+	{
+		PCF2131_Client_Begin(pClient);
+		while ((done + pClient->ops < ops) && (PCF2131_Client_Add(pClient, PCF2131_PROTO_GET_TIME, NULL, 0) >= 0))
+		{
+		}
+		n = PCF2131_Client_Send(pClient);
+		for (int i = 0; i < n; i++)
+		{
+			if ((PCF2131_Client_Receive(pClient, &rsp) != 0) || (rsp.status != 0))
+			{
+				fprintf(stderr, "GET_TIME %ld failed\n", done + i);
+				return EXIT_FAILURE;
+			}
+		}
+		done += n;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	printf("%ld GET_TIME in %.3f s, %.0f ops/s\n", ops,
+		   (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9,
+		   ops / ((end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9));
+	return EXIT_SUCCESS;
+}
+
+int main(int argc, char **argv)
+{
+	pcf2131_client_t client;
+	pcf2131_client_rsp_t rsp;
+	uint8_t regs[PCF2131_PROTO_MAX_DATA];
+	char iso[PCF2131_CLIENT_MAX_PAYLOAD];
+	uint32_t baud = 115200;
+	int arg = 2;
+	int status;
+
+	if (argc < 3)
+	{
+		return usage();
+	}
+	if (!strcmp(argv[arg], "-b") && (argc > arg + 2))
+	{
+		baud = (uint32_t)strtoul(argv[arg + 1], NULL, 0);
+		arg += 2;
+	}
+	if (PCF2131_Client_OpenTty(&client, argv[1], baud) != 0)
+	{
+		perror(argv[1]);
+		return EXIT_FAILURE;
+	}
+
+	if (!strcmp(argv[arg], "ping"))
+	{
+		status = PCF2131_Client_Call(&client, PCF2131_PROTO_PING, NULL, 0, &rsp);
+	}
+	else if (!strcmp(argv[arg], "time"))
+	{
+		status = PCF2131_Client_GetTimeIso(&client, iso, sizeof(iso));
+		if (status == 0)
+		{
+			printf("%s\n", iso);
+		}
+	}
+	else if (!strcmp(argv[arg], "settime") && (argc > arg + 1))
+	{
+		status = PCF2131_Client_SetTimeIso(&client, argv[arg + 1]);
+	}
+	else if (!strcmp(argv[arg], "read") && (argc > arg + 2))
+	{
+		uint8_t offset = (uint8_t)strtoul(argv[arg + 1], NULL, 0);
+		uint8_t length = (uint8_t)strtoul(argv[arg + 2], NULL, 0);
+
+		status = (length <= sizeof(regs)) ? PCF2131_Client_ReadReg(&client, offset, length, regs) : -1;
+		for (int i = 0; (status == 0) && (i < length); i++)
+		{
+			printf("0x%02X: 0x%02X\n", offset + i, regs[i]);
+		}
+	}
+	else if (!strcmp(argv[arg], "bench") && (argc > arg + 1))
+	{
+		status = bench(&client, strtol(argv[arg + 1], NULL, 0));
+	}
+	else if (!strcmp(argv[arg], "exit"))
+	{
+		status = PCF2131_Client_Call(&client, PCF2131_PROTO_EXIT, NULL, 0, &rsp);
+	}
+	else
+	{
+		PCF2131_Client_CloseTty(&client);
+		return usage();
+	}
+
+	if (status != 0)
+	{
+		fprintf(stderr, "%s: %s %d\n", argv[arg], (status < 0) ? "no response, transport error" : "status", status);
+	}
+	PCF2131_Client_CloseTty(&client);
+	return (status == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,364 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pcf2131_client.c
+ * @brief Linux client of the PCF2131 demo framed binary protocol, see pcf2131_client.h.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "pcf2131_client.h"
+
+uint16_t PCF2131_Client_Crc16(uint16_t crc, const uint8_t *pData, size_t length)
+{
+	while (length--)
+	{
+		crc ^= (uint16_t)(*pData++) << 8;
+		for (int bit = 0; bit < 8; bit++)
+		{
+			crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+		}
+	}
+
+	return crc;
+}
+
+size_t PCF2131_Client_EncodeFrame(uint8_t sof, const uint8_t *pPayload, uint8_t length, uint8_t *pOut)
+{
+	uint16_t crc = PCF2131_Client_Crc16(PCF2131_Client_Crc16(0xFFFF, &length, 1), pPayload, length);
+
+	pOut[0] = sof;
+	pOut[1] = length;
+	memcpy(&pOut[2], pPayload, length);
+	pOut[2 + length] = crc & 0xFF;
+	pOut[3 + length] = crc >> 8;
+
+	return (size_t)length + 4;
+}
+
+int PCF2131_Client_DecodeFrame(const uint8_t *pFrame, size_t size, uint8_t *pSof, const uint8_t **ppPayload,
+							   uint8_t *pLength)
+{
+	uint16_t crc;
+
+	if ((size < 4) || (size != (size_t)pFrame[1] + 4))
+	{
+		return -1;
+	}
+	crc = PCF2131_Client_Crc16(0xFFFF, &pFrame[1], (size_t)pFrame[1] + 1);
+	if ((pFrame[size - 2] != (crc & 0xFF)) || (pFrame[size - 1] != (crc >> 8)))
+	{
+		return -1;
+	}
+
+	*pSof = pFrame[0];
+	*ppPayload = &pFrame[2];
+	*pLength = pFrame[1];
+	return 0;
+}
+
+int PCF2131_Client_DecodeResponse(const uint8_t *pPayload, uint8_t length, pcf2131_client_rsp_t *pRsp)
+{
+	if (length < PCF2131_CLIENT_RSP_HEADER)
+	{
+		return -1;
+	}
+
+	pRsp->seq = pPayload[0];
+	pRsp->index = pPayload[1];
+	pRsp->opcode = pPayload[2];
+	pRsp->status = (int8_t)pPayload[3];
+	pRsp->length = length - PCF2131_CLIENT_RSP_HEADER;
+	memcpy(pRsp->data, &pPayload[PCF2131_CLIENT_RSP_HEADER], pRsp->length);
+	return 0;
+}
+
+void PCF2131_Client_Init(pcf2131_client_t *pClient, pcf2131_client_write_t write, pcf2131_client_read_t read,
+						 void *ctx)
+{
+	memset(pClient, 0, sizeof(*pClient));
+	pClient->write = write;
+	pClient->read = read;
+	pClient->ctx = ctx;
+	pClient->timeout_ms = PCF2131_CLIENT_TIMEOUT_MS;
+}
+
+/*******************************************************************************
+ * Serial tty transport
+ ******************************************************************************/
+static int client_tty_write(void *ctx, const uint8_t *pData, size_t length)
+{
+	int fd = (int)(intptr_t)ctx;
+	size_t done = 0;
+	ssize_t n;
+
+	while (done < length)
+	{
+		n = write(fd, pData + done, length - done);
+		if (n < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			return -1;
+		}
+		done += (size_t)n;
+	}
+
+	return (int)done;
+}
+
+static int client_tty_read(void *ctx, uint8_t *pData, size_t length, int timeout_ms)
+{
+	struct pollfd pfd = {.fd = (int)(intptr_t)ctx, .events = POLLIN};
+	size_t done = 0;
+	ssize_t n;
+
+	while (done < length)
+	{
+		if (poll(&pfd, 1, timeout_ms) <= 0)
+		{
+			break;
+		}
+		n = read(pfd.fd, pData + done, length - done);
+		if (n <= 0)
+		{
+			break;
+		}
+		done += (size_t)n;
+	}
+
+	return (int)done;
+}
+
+static speed_t client_tty_speed(uint32_t baud)
+{
+	switch (baud)
+	{
+	case 9600: return B9600;
+	case 19200: return B19200;
+	case 38400: return B38400;
+	case 57600: return B57600;
+	case 230400: return B230400;
+	case 460800: return B460800;
+	case 921600: return B921600;
+	default: return B115200;
+	}
+}
+
+int PCF2131_Client_OpenTty(pcf2131_client_t *pClient, const char *pPath, uint32_t baud)
+{
+	struct termios tio;
+	int fd = open(pPath, O_RDWR | O_NOCTTY);
+
+	if (fd < 0)
+	{
+		return -1;
+	}
+	if (tcgetattr(fd, &tio) < 0)
+	{
+		close(fd);
+		return -1;
+	}
+	cfmakeraw(&tio);
+	tio.c_cflag |= CLOCAL | CREAD;
+	tio.c_cc[VMIN] = 1;
+	tio.c_cc[VTIME] = 0;
+	cfsetispeed(&tio, client_tty_speed(baud));
+	cfsetospeed(&tio, client_tty_speed(baud));
+	if (tcsetattr(fd, TCSANOW, &tio) < 0)
+	{
+		close(fd);
+		return -1;
+	}
+	tcflush(fd, TCIOFLUSH);
+
+	PCF2131_Client_Init(pClient, client_tty_write, client_tty_read, (void *)(intptr_t)fd);
+	return 0;
+}
+
+void PCF2131_Client_CloseTty(pcf2131_client_t *pClient)
+{
+	close((int)(intptr_t)pClient->ctx);
+}
+
+/*******************************************************************************
+ * Batches
+ ******************************************************************************/
+void PCF2131_Client_Begin(pcf2131_client_t *pClient)
+{
+	pClient->seq++;
+	pClient->payload[0] = pClient->seq;
+	pClient->length = 1;
+	pClient->ops = 0;
+}
+
+int PCF2131_Client_Add(pcf2131_client_t *pClient, uint8_t opcode, const uint8_t *pArgs, uint8_t argLen)
+{
+	if ((size_t)pClient->length + 2 + argLen > PCF2131_CLIENT_MAX_PAYLOAD)
+	{
+		return -1;
+	}
+
+	pClient->payload[pClient->length++] = opcode;
+	pClient->payload[pClient->length++] = argLen;
+	if (argLen)
+	{
+		memcpy(&pClient->payload[pClient->length], pArgs, argLen);
+	}
+	pClient->length += argLen;
+	return pClient->ops++;
+}
+
+int PCF2131_Client_Send(pcf2131_client_t *pClient)
+{
+	uint8_t frame[PCF2131_CLIENT_MAX_PAYLOAD + 4];
+	size_t size = PCF2131_Client_EncodeFrame(PCF2131_PROTO_SOF_REQ, pClient->payload, pClient->length, frame);
+
+	if (pClient->write(pClient->ctx, frame, size) != (int)size)
+	{
+		return -1;
+	}
+	return pClient->ops;
+}
+
+int PCF2131_Client_ReadFrame(pcf2131_client_t *pClient, uint8_t *pSof, uint8_t *pPayload, uint8_t *pLength)
+{
+	uint8_t frame[PCF2131_CLIENT_MAX_PAYLOAD + 4];
+	const uint8_t *pDecoded;
+
+	/*! Resynchronize on a start byte, anything else (console text) is skipped */
+	do
+	{
+		if (pClient->read(pClient->ctx, &frame[0], 1, pClient->timeout_ms) != 1)
+		{
+			return -1;
+		}
+	} while ((frame[0] != PCF2131_PROTO_SOF_RSP) && (frame[0] != PCF2131_PROTO_SOF_TLM) &&
+			 (frame[0] != PCF2131_PROTO_SOF_TRACE));
+
+	if (pClient->read(pClient->ctx, &frame[1], 1, pClient->timeout_ms) != 1)
+	{
+		return -1;
+	}
+	if (pClient->read(pClient->ctx, &frame[2], (size_t)frame[1] + 2, pClient->timeout_ms) != frame[1] + 2)
+	{
+		return -1;
+	}
+	if (PCF2131_Client_DecodeFrame(frame, (size_t)frame[1] + 4, pSof, &pDecoded, pLength) != 0)
+	{
+		return -1;
+	}
+
+	memcpy(pPayload, pDecoded, *pLength);
+	return 0;
+}
+
+int PCF2131_Client_Receive(pcf2131_client_t *pClient, pcf2131_client_rsp_t *pRsp)
+{
+	uint8_t payload[PCF2131_CLIENT_MAX_PAYLOAD];
+	uint8_t sof, length;
+
+	do
+	{
+		if (PCF2131_Client_ReadFrame(pClient, &sof, payload, &length) != 0)
+		{
+			return -1;
+		}
+	} while (sof != PCF2131_PROTO_SOF_RSP);
+
+	return PCF2131_Client_DecodeResponse(payload, length, pRsp);
+}
+
+int PCF2131_Client_Call(pcf2131_client_t *pClient, uint8_t opcode, const uint8_t *pArgs, uint8_t argLen,
+						pcf2131_client_rsp_t *pRsp)
+{
+	PCF2131_Client_Begin(pClient);
+	if ((PCF2131_Client_Add(pClient, opcode, pArgs, argLen) < 0) || (PCF2131_Client_Send(pClient) != 1))
+	{
+		return -1;
+	}
+	/*! A stale response of an earlier batch is dropped */
+	do
+	{
+		if (PCF2131_Client_Receive(pClient, pRsp) != 0)
+		{
+			return -1;
+		}
+	} while (pRsp->seq != pClient->seq);
+
+	return (pRsp->index == PCF2131_CLIENT_BAD_FRAME) ? -1 : pRsp->status;
+}
+
+/*******************************************************************************
+ * Operations
+ ******************************************************************************/
+int PCF2131_Client_ReadReg(pcf2131_client_t *pClient, uint8_t offset, uint8_t length, uint8_t *pOut)
+{
+	pcf2131_client_rsp_t rsp;
+	uint8_t args[2] = {offset, length};
+	int status = PCF2131_Client_Call(pClient, PCF2131_PROTO_READ_REG, args, sizeof(args), &rsp);
+
+	if (status == 0)
+	{
+		if (rsp.length != length)
+		{
+			return -1;
+		}
+		memcpy(pOut, rsp.data, length);
+	}
+	return status;
+}
+
+int PCF2131_Client_WriteReg(pcf2131_client_t *pClient, uint8_t offset, const uint8_t *pValues, uint8_t length)
+{
+	pcf2131_client_rsp_t rsp;
+	uint8_t args[PCF2131_CLIENT_MAX_PAYLOAD];
+
+	if (length > PCF2131_CLIENT_MAX_PAYLOAD - 4)
+	{
+		return -1;
+	}
+	args[0] = offset;
+	memcpy(&args[1], pValues, length);
+	return PCF2131_Client_Call(pClient, PCF2131_PROTO_WRITE_REG, args, length + 1, &rsp);
+}
+
+int PCF2131_Client_GetTimeIso(pcf2131_client_t *pClient, char *pIso, size_t size)
+{
+	pcf2131_client_rsp_t rsp;
+	int status = PCF2131_Client_Call(pClient, PCF2131_PROTO_GET_TIME_ISO, NULL, 0, &rsp);
+
+	if (status == 0)
+	{
+		if (rsp.length >= size)
+		{
+			return -1;
+		}
+		memcpy(pIso, rsp.data, rsp.length);
+		pIso[rsp.length] = '\0';
+	}
+	return status;
+}
+
+int PCF2131_Client_SetTimeIso(pcf2131_client_t *pClient, const char *pIso)
+{
+	pcf2131_client_rsp_t rsp;
+	size_t length = strlen(pIso);
+
+	if (length > PCF2131_CLIENT_MAX_PAYLOAD - 4)
+	{
+		return -1;
+	}
+	return PCF2131_Client_Call(pClient, PCF2131_PROTO_SET_TIME_ISO, (const uint8_t *)pIso, (uint8_t)length, &rsp);
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pcf2131_client.h
+ * @brief Linux client of the PCF2131 demo framed binary protocol (source/pcf2131_proto.h).
+ *        Operations are queued into a batch, sent as one request frame, and the responses are read back
+ *        one frame per operation as the board runs them. The byte transport is pluggable: a serial tty
+ *        (PCF2131_Client_OpenTty()) on a rig, the loopback stand-in (loopback_serial.h) in the host tests.
+ */
+
+#ifndef PCF2131_CLIENT_H_
+#define PCF2131_CLIENT_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "pcf2131_proto.h"
+
+/*! @brief Longest frame payload, the length field is one byte. */
+#define PCF2131_CLIENT_MAX_PAYLOAD (255)
+
+/*! @brief Response header: sequence number, operation index, opcode, status. */
+#define PCF2131_CLIENT_RSP_HEADER (4)
+
+/*! @brief Operation index of the response to a bad CRC or malformed batch. */
+#define PCF2131_CLIENT_BAD_FRAME (0xFF)
+
+/*! @brief Default response timeout. */
+#define PCF2131_CLIENT_TIMEOUT_MS (1000)
+
+/*! @brief Transport: writes length bytes, returns the number written or < 0 on error. */
+typedef int (*pcf2131_client_write_t)(void *ctx, const uint8_t *pData, size_t length);
+
+/*! @brief Transport: reads exactly length bytes, returns fewer (or < 0) on timeout or error. */
+typedef int (*pcf2131_client_read_t)(void *ctx, uint8_t *pData, size_t length, int timeout_ms);
+
+typedef struct
+{
+	pcf2131_client_write_t write;
+	pcf2131_client_read_t read;
+	void *ctx;
+	int timeout_ms;
+	uint8_t seq;                                     /* Sequence number of the batch being built. */
+	uint8_t ops;                                     /* Operations in the batch. */
+	uint8_t length;                                  /* Batch payload length, the sequence number included. */
+	uint8_t payload[PCF2131_CLIENT_MAX_PAYLOAD];
+} pcf2131_client_t;
+
+/*! @brief One decoded response frame. */
+typedef struct
+{
+	uint8_t seq;
+	uint8_t index;                                   /* Operation index in its batch, PCF2131_CLIENT_BAD_FRAME. */
+	uint8_t opcode;
+	int8_t status;                                   /* SENSOR_ERROR_* */
+	uint8_t length;                                  /* Data length. */
+	uint8_t data[PCF2131_CLIENT_MAX_PAYLOAD - PCF2131_CLIENT_RSP_HEADER];
+} pcf2131_client_rsp_t;
+
+/*! @brief CRC-16/CCITT-FALSE step, start with 0xFFFF. */
+uint16_t PCF2131_Client_Crc16(uint16_t crc, const uint8_t *pData, size_t length);
+
+/*! @brief Encodes a frame into pOut (length + 4 bytes), returns its size. */
+size_t PCF2131_Client_EncodeFrame(uint8_t sof, const uint8_t *pPayload, uint8_t length, uint8_t *pOut);
+
+/*! @brief Decodes a whole frame.
+ *  @return 0 with the start byte, payload pointer and length, -1 if the size or CRC is wrong. */
+int PCF2131_Client_DecodeFrame(const uint8_t *pFrame, size_t size, uint8_t *pSof, const uint8_t **ppPayload,
+							   uint8_t *pLength);
+
+/*! @brief Decodes a response payload. Returns 0, -1 if it is shorter than the header. */
+int PCF2131_Client_DecodeResponse(const uint8_t *pPayload, uint8_t length, pcf2131_client_rsp_t *pRsp);
+
+/*! @brief Sets up a client on a transport. */
+void PCF2131_Client_Init(pcf2131_client_t *pClient, pcf2131_client_write_t write, pcf2131_client_read_t read,
+						 void *ctx);
+
+/*! @brief Opens a serial tty (raw 8N1) as the transport. Returns 0, -1 with errno set on error. */
+int PCF2131_Client_OpenTty(pcf2131_client_t *pClient, const char *pPath, uint32_t baud);
+
+/*! @brief Closes a tty opened by PCF2131_Client_OpenTty(). */
+void PCF2131_Client_CloseTty(pcf2131_client_t *pClient);
+
+/*! @brief Starts a new batch with the next sequence number. */
+void PCF2131_Client_Begin(pcf2131_client_t *pClient);
+
+/*! @brief Queues an operation. Returns its index in the batch, -1 when the frame is full. */
+int PCF2131_Client_Add(pcf2131_client_t *pClient, uint8_t opcode, const uint8_t *pArgs, uint8_t argLen);
+
+/*! @brief Sends the batch. Returns the number of operations (responses to expect), -1 on error. */
+int PCF2131_Client_Send(pcf2131_client_t *pClient);
+
+/*! @brief Reads the next frame of any kind (responses, telemetry, trace chunks).
+ *  @return 0, -1 on timeout or CRC error. pPayload must hold PCF2131_CLIENT_MAX_PAYLOAD bytes. */
+int PCF2131_Client_ReadFrame(pcf2131_client_t *pClient, uint8_t *pSof, uint8_t *pPayload, uint8_t *pLength);
+
+/*! @brief Reads the next response, frames of other kinds are skipped. Returns 0, -1 on timeout. */
+int PCF2131_Client_Receive(pcf2131_client_t *pClient, pcf2131_client_rsp_t *pRsp);
+
+/*! @brief Runs one operation as a batch of its own.
+ *  @return The operation status (SENSOR_ERROR_*), -1 on a transport or framing error. */
+int PCF2131_Client_Call(pcf2131_client_t *pClient, uint8_t opcode, const uint8_t *pArgs, uint8_t argLen,
+						pcf2131_client_rsp_t *pRsp);
+
+/*! @brief Reads length registers from offset into pOut. Returns as PCF2131_Client_Call(). */
+int PCF2131_Client_ReadReg(pcf2131_client_t *pClient, uint8_t offset, uint8_t length, uint8_t *pOut);
+
+/*! @brief Writes length registers from offset. Returns as PCF2131_Client_Call(). */
+int PCF2131_Client_WriteReg(pcf2131_client_t *pClient, uint8_t offset, const uint8_t *pValues, uint8_t length);
+
+/*! @brief Reads the time as YYYY-MM-DDThh:mm:ss.cc into pIso (24 bytes). Returns as PCF2131_Client_Call(). */
+int PCF2131_Client_GetTimeIso(pcf2131_client_t *pClient, char *pIso, size_t size);
+
+/*! @brief Sets the time from an ISO 8601 string. Returns as PCF2131_Client_Call(). */
+int PCF2131_Client_SetTimeIso(pcf2131_client_t *pClient, const char *pIso);
+
+#endif /* PCF2131_CLIENT_H_ */
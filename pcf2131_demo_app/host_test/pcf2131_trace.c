@@ -0,0 +1,186 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file pcf2131_trace.c
+ * @brief Decodes a register transaction trace of the demo (bus trace menu option) and replays it into the
+ *        driver on the simulated bus (trace_decoder.h, trace_replay.h).
+ *
+ *   pcf2131_trace [-b baud] [-t timeout_ms] [-o trace.bin] decode | replay <tty | trace.bin>
+ *
+ * A tty input collects the trace frames the demo sends, until none arrives for the timeout (default 5000 ms,
+ * start the tool before stopping the capture), -o saves the raw trace. Any other input is a raw trace file.
+ * The replay drives the driver variant of the build (BUS), each record through PCF2131_ReadInPlace() or
+ * PCF2131_WriteInPlace(), and prints the records whose transaction did not match.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "mock_bus.h"
+#include "trace_replay.h"
+
+/* A capture buffer of the demo is much smaller. */
+#define TRACE_TOOL_MAX_SIZE (1024 * 1024)
+
+static int usage(void)
+{
+	fprintf(stderr, "usage: pcf2131_trace [-b baud] [-t timeout_ms] [-o trace.bin] decode | replay"
+					" <tty | trace.bin>\n");
+	return EXIT_FAILURE;
+}
+
+/* Reads the trace from a tty (trace frames) or a raw file. Returns its size, -1 on error. */
+static long load(const char *pPath, uint32_t baud, int timeout_ms, uint8_t *pTrace)
+{
+	pcf2131_client_t client;
+	FILE *pIn;
+	long size;
+
+	if ((pIn = fopen(pPath, "rb")) == NULL)
+	{
+		perror(pPath);
+		return -1;
+	}
+	if (!isatty(fileno(pIn)))
+	{
+		size = (long)fread(pTrace, 1, TRACE_TOOL_MAX_SIZE, pIn);
+		fclose(pIn);
+		return size;
+	}
+	fclose(pIn);
+
+	if (PCF2131_Client_OpenTty(&client, pPath, baud) != 0)
+	{
+		perror(pPath);
+		return -1;
+	}
+	client.timeout_ms = timeout_ms;
+	size = Trace_Decoder_Receive(&client, pTrace, TRACE_TOOL_MAX_SIZE);
+	PCF2131_Client_CloseTty(&client);
+	if (size < 0)
+	{
+		fprintf(stderr, "%s: trace larger than %d bytes\n", pPath, TRACE_TOOL_MAX_SIZE);
+	}
+	return size;
+}
+
+static int decode(const uint8_t *pTrace, size_t size)
+{
+	trace_decoder_t decoder;
+	trace_record_t record;
+	char line[TRACE_DECODER_MAX_LINE];
+	uint32_t failed = 0;
+	int result;
+
+	Trace_Decoder_Init(&decoder, pTrace, size);
+	while ((result = Trace_Decoder_Next(&decoder, &record)) == 1)
+	{
+		Trace_Decoder_Format(&record, line, sizeof(line));
+		printf("%s\n", line);
+		failed += (record.pPayload == NULL);
+	}
+	if (result != 0)
+	{
+		fprintf(stderr, "bad record at byte %zu of %zu\n", decoder.pos, size);
+	}
+
+	printf("%u records, %u failed, %.6f s\n", decoder.records, failed, decoder.time_us / 1e6);
+	return (result == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static void replay_log(void *ctx, const trace_record_t *pRecord, int32_t status, const uint8_t *pValues,
+					   bool diverged)
+{
+	char line[TRACE_DECODER_MAX_LINE];
+
+	if (diverged)
+	{
+		Trace_Decoder_Format(pRecord, line, sizeof(line));
+		printf("%s  DIVERGES, status %d\n", line, (int)status);
+	}
+}
+
+static int replay(const uint8_t *pTrace, size_t size)
+{
+	pcf2131_sensorhandle_t rtc;
+	trace_replay_stats_t stats;
+
+	Mock_Bus_Reset();
+#if (I2C_ENABLE)
+	PCF2131_Initialize(&rtc, &Mock_I2C_Driver, 0, 0x53);
+#else
+	static uint32_t slaveSelect;
+	PCF2131_Initialize(&rtc, &Mock_SPI_Driver, 0, &slaveSelect);
+#endif
+	if ((size > 0) && (((pTrace[0] & REGISTER_TRACE_I2C) != 0) != (I2C_ENABLE != 0)))
+	{
+		printf("note: %s trace replayed into the %s driver\n", (pTrace[0] & REGISTER_TRACE_I2C) ? "I2C" : "SPI",
+			   I2C_ENABLE ? "I2C" : "SPI");
+	}
+	if (Trace_Replay_Run(&rtc, pTrace, size, replay_log, NULL, &stats) != 0)
+	{
+		fprintf(stderr, "bad record in the trace, decode it for the position\n");
+		return EXIT_FAILURE;
+	}
+
+	printf("%u records, %u replayed, %u failures reproduced, %u divergences\n", stats.records, stats.replayed,
+		   stats.failures, stats.divergences);
+	return (stats.divergences == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int main(int argc, char **argv)
+{
+	static uint8_t trace[TRACE_TOOL_MAX_SIZE];
+	const char *pSave = NULL;
+	uint32_t baud = 115200;
+	int timeout_ms = 5000;
+	FILE *pOut;
+	long size;
+	int arg = 1;
+
+	while ((argc > arg + 1) && (argv[arg][0] == '-'))
+	{
+		if (!strcmp(argv[arg], "-b"))
+		{
+			baud = (uint32_t)strtoul(argv[arg + 1], NULL, 0);
+		}
+		else if (!strcmp(argv[arg], "-t"))
+		{
+			timeout_ms = atoi(argv[arg + 1]);
+		}
+		else if (!strcmp(argv[arg], "-o"))
+		{
+			pSave = argv[arg + 1];
+		}
+		else
+		{
+			return usage();
+		}
+		arg += 2;
+	}
+	if ((argc != arg + 2) || (strcmp(argv[arg], "decode") && strcmp(argv[arg], "replay")))
+	{
+		return usage();
+	}
+	if ((size = load(argv[arg + 1], baud, timeout_ms, trace)) < 0)
+	{
+		return EXIT_FAILURE;
+	}
+	if (pSave != NULL)
+	{
+		if (((pOut = fopen(pSave, "wb")) == NULL) || (fwrite(trace, 1, (size_t)size, pOut) != (size_t)size))
+		{
+			perror(pSave);
+			return EXIT_FAILURE;
+		}
+		fclose(pOut);
+	}
+
+	return !strcmp(argv[arg], "decode") ? decode(trace, (size_t)size) : replay(trace, (size_t)size);
+}
@@ -0,0 +1,237 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file proto_test.c
+ * @brief Host test of the framed binary protocol (source/pcf2131_proto.c) end to end: the firmware
+ *        PCF2131_Proto_Run() serves the unchanged driver on the simulated register map (mock_bus.h) from
+ *        a device thread, the Linux client library (pcf2131_client.h) talks to it through the loopback
+ *        serial port. Checks frame encoding, every response path, and reports the operation rate.
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "mock_bus.h"
+#include "loopback_serial.h"
+#include "pcf2131_client.h"
+
+#define PROTO_BENCH_OPS (20000)
+
+#define CHECK(cond)                                                              \
+	do                                                                           \
+	{                                                                            \
+		if (!(cond))                                                             \
+		{                                                                        \
+			printf("proto_test: %s:%d: %s\n", __FILE__, __LINE__, #cond);        \
+			s_failures++;                                                        \
+		}                                                                        \
+	} while (0)
+
+static pcf2131_sensorhandle_t s_rtc;
+static uint32_t s_failures;
+static pcf2131_client_t s_client;
+
+static void *device_thread(void *arg)
+{
+	PCF2131_Proto_Run(&s_rtc);
+	return NULL;
+}
+
+static double elapsed_s(const struct timespec *pStart)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec - pStart->tv_sec) + (now.tv_nsec - pStart->tv_nsec) / 1e9;
+}
+
+/* Client side frame coding, no device involved. */
+static void test_frames(void)
+{
+	const uint8_t check[] = "123456789";
+	uint8_t payload[3] = {7, PCF2131_PROTO_PING, 0};
+	uint8_t frame[PCF2131_CLIENT_MAX_PAYLOAD + 4];
+	const uint8_t *pDecoded;
+	uint8_t sof, length;
+	size_t size;
+
+	/*! The CRC-16/CCITT-FALSE check value */
+	CHECK(PCF2131_Client_Crc16(0xFFFF, check, 9) == 0x29B1);
+
+	size = PCF2131_Client_EncodeFrame(PCF2131_PROTO_SOF_REQ, payload, sizeof(payload), frame);
+	CHECK(size == sizeof(payload) + 4);
+	CHECK(PCF2131_Client_DecodeFrame(frame, size, &sof, &pDecoded, &length) == 0);
+	CHECK((sof == PCF2131_PROTO_SOF_REQ) && (length == sizeof(payload)) && !memcmp(pDecoded, payload, length));
+
+	/*! Every single bit flip is caught, and a truncated frame */
+	for (size_t bit = 8; bit < size * 8; bit++)
+	{
+		frame[bit / 8] ^= 1U << (bit % 8);
+		CHECK(PCF2131_Client_DecodeFrame(frame, size, &sof, &pDecoded, &length) != 0);
+		frame[bit / 8] ^= 1U << (bit % 8);
+	}
+	CHECK(PCF2131_Client_DecodeFrame(frame, size - 1, &sof, &pDecoded, &length) != 0);
+}
+
+static void test_operations(void)
+{
+	pcf2131_client_rsp_t rsp;
+	uint8_t values[4] = {0x11, 0x22, 0x33, 0x44};
+	uint8_t regs[4];
+	uint8_t time[9] = {25, 30, 45, 13, 17, 5, 5, 24, h24};
+	char iso[PCF2131_CLIENT_MAX_PAYLOAD];
+
+	CHECK(PCF2131_Client_Call(&s_client, PCF2131_PROTO_PING, NULL, 0, &rsp) == 0);
+	CHECK((rsp.index == 0) && (rsp.opcode == PCF2131_PROTO_PING) && (rsp.length == 0));
+
+	CHECK(PCF2131_Client_WriteReg(&s_client, PCF2131_SECOND_ALARM, values, sizeof(values)) == 0);
+	CHECK(!memcmp(&g_Mock_Regs[PCF2131_SECOND_ALARM], values, sizeof(values)));
+	CHECK(PCF2131_Client_ReadReg(&s_client, PCF2131_SECOND_ALARM, sizeof(regs), regs) == 0);
+	CHECK(!memcmp(regs, values, sizeof(values)));
+
+	CHECK(PCF2131_Client_Call(&s_client, PCF2131_PROTO_SET_TIME, time, sizeof(time), &rsp) == 0);
+	CHECK(PCF2131_Client_Call(&s_client, PCF2131_PROTO_GET_TIME, NULL, 0, &rsp) == 0);
+	CHECK((rsp.length == sizeof(time)) && !memcmp(rsp.data, time, sizeof(time)));
+
+	CHECK(PCF2131_Client_SetTimeIso(&s_client, "2031-12-24T23:59:58.50") == 0);
+	CHECK(PCF2131_Client_GetTimeIso(&s_client, iso, sizeof(iso)) == 0);
+	CHECK(!strcmp(iso, "2031-12-24T23:59:58.50"));
+	/*! The offset is applied, the RTC keeps UTC, trailing text is refused */
+	CHECK(PCF2131_Client_SetTimeIso(&s_client, "2032-01-01T01:29:58.123-05:30") == 0);
+	CHECK(PCF2131_Client_GetTimeIso(&s_client, iso, sizeof(iso)) == 0);
+	CHECK(!strcmp(iso, "2032-01-01T06:59:58.12"));
+	CHECK(PCF2131_Client_SetTimeIso(&s_client, "2032-01-01T01:29:58 junk") == SENSOR_ERROR_INVALID_PARAM);
+
+	/*! Argument errors are answered per operation */
+	values[0] = PCF2131_REG_MAP_SIZE;
+	values[1] = 1;
+	CHECK(PCF2131_Client_Call(&s_client, PCF2131_PROTO_READ_REG, values, 2, &rsp) == SENSOR_ERROR_INVALID_PARAM);
+	CHECK(PCF2131_Client_Call(&s_client, 0x6E, NULL, 0, &rsp) == SENSOR_ERROR_INVALID_PARAM);
+
+	/*! A bus error reaches the client as the operation status */
+	Mock_Bus_Fail(0, 1, ARM_DRIVER_ERROR);
+	CHECK(PCF2131_Client_Call(&s_client, PCF2131_PROTO_GET_TIME, NULL, 0, &rsp) > SENSOR_ERROR_NONE);
+	CHECK(PCF2131_Client_Call(&s_client, PCF2131_PROTO_GET_TIME, NULL, 0, &rsp) == 0);
+}
+
+static void test_bad_frames(void)
+{
+	pcf2131_client_rsp_t rsp;
+	uint8_t payload[5] = {0x42, PCF2131_PROTO_PING, 0, PCF2131_PROTO_PING, 3};
+	uint8_t frame[PCF2131_CLIENT_MAX_PAYLOAD + 4];
+	size_t size;
+
+	/*! Bad CRC, after console noise the device has to resynchronize on */
+	size = PCF2131_Client_EncodeFrame(PCF2131_PROTO_SOF_REQ, payload, 3, frame);
+	frame[size - 1] ^= 0x80;
+	Loopback_Write(NULL, (const uint8_t *)"\r\n> 12", 6);
+	Loopback_Write(NULL, frame, size);
+	CHECK(PCF2131_Client_Receive(&s_client, &rsp) == 0);
+	CHECK((rsp.seq == 0x42) && (rsp.index == PCF2131_CLIENT_BAD_FRAME) && (rsp.opcode == 0) &&
+		  (rsp.status == SENSOR_ERROR_INVALID_PARAM));
+
+	/*! Malformed batch: the first operation runs, the overrunning one is refused */
+	size = PCF2131_Client_EncodeFrame(PCF2131_PROTO_SOF_REQ, payload, sizeof(payload), frame);
+	Loopback_Write(NULL, frame, size);
+	CHECK(PCF2131_Client_Receive(&s_client, &rsp) == 0);
+	CHECK((rsp.index == 0) && (rsp.opcode == PCF2131_PROTO_PING) && (rsp.status == 0));
+	CHECK(PCF2131_Client_Receive(&s_client, &rsp) == 0);
+	CHECK((rsp.seq == 0x42) && (rsp.index == PCF2131_CLIENT_BAD_FRAME));
+
+	/*! The client still works afterwards */
+	CHECK(PCF2131_Client_Call(&s_client, PCF2131_PROTO_PING, NULL, 0, &rsp) == 0);
+}
+
+/* A full frame of operations, answered in order. */
+static void test_batch(void)
+{
+	pcf2131_client_rsp_t rsp;
+	uint8_t args[2] = {PCF2131_100TH_SECOND, PCF2131_TIME_SIZE_BYTE};
+	int ops = 0;
+
+	PCF2131_Client_Begin(&s_client);
+	while (PCF2131_Client_Add(&s_client, (ops & 1) ? PCF2131_PROTO_READ_REG : PCF2131_PROTO_PING, args,
+							  (ops & 1) ? sizeof(args) : 0) >= 0)
+	{
+		ops++;
+	}
+	CHECK(PCF2131_Client_Send(&s_client) == ops);
+	for (int i = 0; i < ops; i++)
+	{
+		CHECK(PCF2131_Client_Receive(&s_client, &rsp) == 0);
+		CHECK((rsp.seq == s_client.seq) && (rsp.index == i) && (rsp.status == 0));
+		CHECK(rsp.length == ((i & 1) ? PCF2131_TIME_SIZE_BYTE : 0));
+	}
+	printf("proto_test: batch of %d operations in one %u byte frame\n", ops, s_client.length + 4U);
+}
+
+/* Operations per second, one per frame and batched GET_TIME. */
+static void test_rate(void)
+{
+	pcf2131_client_rsp_t rsp;
+	struct timespec start;
+	double single, batched;
+	int ops;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (int i = 0; i < PROTO_BENCH_OPS / 10; i++)
+	{
+		CHECK(PCF2131_Client_Call(&s_client, PCF2131_PROTO_GET_TIME, NULL, 0, &rsp) == 0);
+	}
+	single = (PROTO_BENCH_OPS / 10) / elapsed_s(&start);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (int done = 0; done < PROTO_BENCH_OPS; done += ops)
+	{
+		PCF2131_Client_Begin(&s_client);
+		while (PCF2131_Client_Add(&s_client, PCF2131_PROTO_GET_TIME, NULL, 0) >= 0)
+		{
+		}
+		ops = PCF2131_Client_Send(&s_client);
+		for (int i = 0; i < ops; i++)
+		{
+			CHECK((PCF2131_Client_Receive(&s_client, &rsp) == 0) && (rsp.status == 0));
+		}
+	}
+	batched = PROTO_BENCH_OPS / elapsed_s(&start);
+
+	printf("proto_test: GET_TIME %.0f ops/s one per frame, %.0f ops/s batched (loopback, no UART)\n", single,
+		   batched);
+}
+
+int main(void)
+{
+	pthread_t device;
+	pcf2131_client_rsp_t rsp;
+
+	Mock_Bus_Reset();
+	Loopback_Reset();
+#if (I2C_ENABLE)
+	CHECK(PCF2131_Initialize(&s_rtc, &Mock_I2C_Driver, 0, 0x53) == SENSOR_ERROR_NONE);
+#else
+	static uint32_t slaveSelect;
+	CHECK(PCF2131_Initialize(&s_rtc, &Mock_SPI_Driver, 0, &slaveSelect) == SENSOR_ERROR_NONE);
+#endif
+	PCF2131_Client_Init(&s_client, Loopback_Write, Loopback_Read, NULL);
+	pthread_create(&device, NULL, device_thread, NULL);
+
+	test_frames();
+	test_operations();
+	test_bad_frames();
+	test_batch();
+	test_rate();
+
+	/*! EXIT ends PCF2131_Proto_Run() */
+	CHECK(PCF2131_Client_Call(&s_client, PCF2131_PROTO_EXIT, NULL, 0, &rsp) == 0);
+	pthread_join(device, NULL);
+
+	printf("proto_test: %s\n", s_failures ? "FAIL" : "PASS");
+	return s_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
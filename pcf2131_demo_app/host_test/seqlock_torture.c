@@ -0,0 +1,264 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file seqlock_torture.c
+ * @brief Host torture test and contention benchmark of the PCF2131 published time (pcf2131_timepub.c).
+ *        One writer thread publishes a time derived from a counter as fast as it can while 1 to
+ *        SEQLOCK_MAX_READERS reader threads (other cores) copy it. Every copy must be self consistent:
+ *        each field and the epoch value derive from the same counter, and no reader may go back in time.
+ *        Each reader count runs twice: free running for the contention figures, then as torture with
+ *        a fast timer signal on every thread. On the readers it preempts the copy at random points, on
+ *        the writer its handler reads like an ISR on the updating core. A test that hangs (an ISR reader
+ *        spinning on an update it interrupted) is killed by the SEQLOCK_WATCHDOG_S alarm.
+ */
+
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "fsl_common.h"
+#include "pcf2131_timepub.h"
+#include "pcf2131_aging.h"
+
+#define SEQLOCK_MAX_READERS (16)
+#define SEQLOCK_RUN_MS      (300)
+#define SEQLOCK_TICK_NS     (20000)
+#define SEQLOCK_WATCHDOG_S  (60)
+
+typedef struct
+{
+	uint64_t reads;
+	uint64_t torn;
+	uint64_t backwards;
+	int64_t last_ms;
+} tally_t;
+
+typedef struct
+{
+	pthread_t thread;
+	bool torture;
+	uint32_t tick_ns;
+	uint32_t updates;
+	tally_t tally;
+} worker_t;
+
+static pcf2131_timepub_t s_pub;
+static volatile bool s_stop;
+static tally_t s_isr;
+
+/* Bus APIs the modules under test link against, this test publishes without reading the RTC. */
+int32_t PCF2131_GetTime(pcf2131_sensorhandle_t *pSensorHandle, const registerreadlist_t *pcf2131timedata,
+		pcf2131_timedata_t *time)
+{
+	return SENSOR_ERROR_INIT;
+}
+
+int32_t PCF2131_AgingOffset_Get(pcf2131_sensorhandle_t *pSensorHandle, uint8_t *pCode)
+{
+	return SENSOR_ERROR_INIT;
+}
+
+int32_t PCF2131_AgingOffset_Set(pcf2131_sensorhandle_t *pSensorHandle, uint8_t code)
+{
+	return SENSOR_ERROR_INIT;
+}
+
+/* A valid 24h time for counter n (in 100th of a second), every field changes with n. */
+static void time_from_count(uint32_t n, pcf2131_timedata_t *time)
+{
+	uint32_t s = n / 100;
+
+	time->second_100th = n % 100;
+	time->second = s % 60;
+	time->minutes = (s / 60) % 60;
+	time->hours = (s / 3600) % 24;
+	time->days = 1 + (s / 86400) % 28;
+	time->weekdays = (s / 86400) % 7;
+	time->months = 1 + (s / (86400 * 28)) % 12;
+	time->years = (s / (86400 * 28 * 12)) % 100;
+	time->ampm = h24;
+}
+
+/* One read of the publication, checked against the counter derivation. */
+static void read_once(tally_t *pTally)
+{
+	pcf2131_timedata_t time;
+	int64_t epoch_ms;
+
+	if (!PCF2131_TimePub_Read(&s_pub, &time, &epoch_ms))
+	{
+		return;
+	}
+	pTally->reads++;
+	if ((epoch_ms != PCF2131_TimeToMs(&time)) || (time.weekdays != (time.days - 1) % 7))
+	{
+		pTally->torn++;
+	}
+	if (epoch_ms < pTally->last_ms)
+	{
+		pTally->backwards++;
+	}
+	pTally->last_ms = epoch_ms;
+}
+
+/* Timer signal on a reader: give the CPU away wherever the reader happens to be. */
+static void preempt_handler(int sig)
+{
+	sched_yield();
+}
+
+/* Timer signal on the writer: an ISR reading on the updating core. */
+static void isr_handler(int sig)
+{
+	read_once(&s_isr);
+}
+
+/* Starts a periodic timer signal on the calling thread, returns the timer or NULL. */
+static timer_t *start_tick(timer_t *pTimer, int sig, uint32_t tick_ns)
+{
+	struct sigevent sev = {0};
+	struct itimerspec its = {0};
+
+	sev.sigev_notify = SIGEV_THREAD_ID;
+	sev.sigev_signo = sig;
+	sev._sigev_un._tid = (pid_t)syscall(SYS_gettid);
+	if (timer_create(CLOCK_MONOTONIC, &sev, pTimer) != 0)
+	{
+		return NULL;
+	}
+	its.it_value.tv_nsec = tick_ns;
+	its.it_interval.tv_nsec = tick_ns;
+	timer_settime(*pTimer, 0, &its, NULL);
+
+	return pTimer;
+}
+
+static void *writer(void *arg)
+{
+	worker_t *pWriter = (worker_t *)arg;
+	pcf2131_timedata_t time;
+	timer_t timer, *pTimer = NULL;
+	uint32_t n = 1;
+
+	if (pWriter->torture)
+	{
+		pTimer = start_tick(&timer, SIGUSR2, pWriter->tick_ns);
+	}
+	while (!s_stop)
+	{
+		time_from_count(n++, &time);
+		PCF2131_TimePub_Publish(&s_pub, &time);
+	}
+	if (pTimer)
+	{
+		timer_delete(*pTimer);
+	}
+	pWriter->updates = n - 1;
+
+	return NULL;
+}
+
+static void *reader(void *arg)
+{
+	worker_t *pReader = (worker_t *)arg;
+	timer_t timer, *pTimer = NULL;
+
+	if (pReader->torture)
+	{
+		pTimer = start_tick(&timer, SIGUSR1, pReader->tick_ns);
+	}
+	while (!s_stop)
+	{
+		read_once(&pReader->tally);
+	}
+	if (pTimer)
+	{
+		timer_delete(*pTimer);
+	}
+
+	return NULL;
+}
+
+static void sleep_ms(uint32_t ms)
+{
+	struct timespec ts = {.tv_sec = ms / 1000, .tv_nsec = (long)(ms % 1000) * 1000000L};
+
+	while (nanosleep(&ts, &ts) != 0)
+	{
+	}
+}
+
+/* Runs one writer against nReaders readers, returns the number of bad copies. */
+static uint64_t run(int nReaders, bool torture)
+{
+	worker_t readers[SEQLOCK_MAX_READERS] = {0};
+	worker_t writerWorker = {.torture = torture, .tick_ns = SEQLOCK_TICK_NS + 3000};
+	tally_t sum = {0};
+	int i;
+
+	PCF2131_TimePub_Init(&s_pub);
+	memset(&s_isr, 0, sizeof(s_isr));
+	s_stop = false;
+	for (i = 0; i < nReaders; i++)
+	{
+		readers[i].torture = torture;
+		readers[i].tick_ns = SEQLOCK_TICK_NS * nReaders + 1000 * i;
+		pthread_create(&readers[i].thread, NULL, reader, &readers[i]);
+	}
+	pthread_create(&writerWorker.thread, NULL, writer, &writerWorker);
+	sleep_ms(SEQLOCK_RUN_MS);
+	s_stop = true;
+	pthread_join(writerWorker.thread, NULL);
+	for (i = 0; i < nReaders; i++)
+	{
+		pthread_join(readers[i].thread, NULL);
+		sum.reads += readers[i].tally.reads;
+		sum.torn += readers[i].tally.torn;
+		sum.backwards += readers[i].tally.backwards;
+	}
+
+	printf("%-8s %2d readers: %9u updates %10llu reads %6.2f Mreads/s/reader  torn %llu  backwards %llu",
+			torture ? "torture" : "contend", nReaders, writerWorker.updates, (unsigned long long)sum.reads,
+			(double)sum.reads / nReaders / (SEQLOCK_RUN_MS * 1000.0), (unsigned long long)sum.torn,
+			(unsigned long long)sum.backwards);
+	if (torture)
+	{
+		printf("  isr reads %llu torn %llu", (unsigned long long)s_isr.reads,
+				(unsigned long long)(s_isr.torn + s_isr.backwards));
+	}
+	printf("\n");
+
+	return sum.torn + sum.backwards + s_isr.torn + s_isr.backwards;
+}
+
+int main(void)
+{
+	struct sigaction sa = {0};
+	uint64_t bad = 0;
+	int nReaders;
+
+	sa.sa_handler = preempt_handler;
+	sigaction(SIGUSR1, &sa, NULL);
+	sa.sa_handler = isr_handler;
+	sigaction(SIGUSR2, &sa, NULL);
+	alarm(SEQLOCK_WATCHDOG_S);
+
+	for (nReaders = 1; nReaders <= SEQLOCK_MAX_READERS; nReaders *= 2)
+	{
+		bad += run(nReaders, false);
+		bad += run(nReaders, true);
+	}
+	printf("seqlock_torture: %s\n", bad ? "FAIL" : "PASS");
+
+	return bad ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,31 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file debug_console_async.h
+ * @brief Host stand-in for the asynchronous debug console. PUTCHAR and GETCHAR go to the host test
+ *        (a loopback serial port), PRINTF to stdout. It has the include guard of the real header, so a
+ *        source next to the real one (utilities/) takes this one when it is force included first.
+ */
+
+#ifndef __DEBUG_CONSOLE_ASYNC_H__
+#define __DEBUG_CONSOLE_ASYNC_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+int DbgConsole_AsyncPutchar(int ch);
+int DbgConsole_AsyncWrite(const uint8_t *pData, uint32_t length);
+int DbgConsole_Getchar(void);
+bool DbgConsole_AsyncRxReady(void);
+void DbgConsole_AsyncFlush(void);
+
+#define PRINTF  printf
+#define PUTCHAR DbgConsole_AsyncPutchar
+#define GETCHAR DbgConsole_Getchar
+
+#endif /* __DEBUG_CONSOLE_ASYNC_H__ */
@@ -0,0 +1,25 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file fsl_clock.h
+ * @brief Host stand-in for the SDK clock driver, only the clock gates the driver sources under test open.
+ */
+
+#ifndef _FSL_CLOCK_H_
+#define _FSL_CLOCK_H_
+
+#include "fsl_common.h"
+
+typedef enum
+{
+	kCLOCK_Mailbox,
+} clock_ip_name_t;
+
+/*! Nothing to gate on the host. */
+void CLOCK_EnableClock(clock_ip_name_t clk);
+
+#endif /* _FSL_CLOCK_H_ */
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file fsl_common.h
+ * @brief Host stand-in for the SDK fsl_common.h, only what the driver sources under test use.
+ *        Interrupts are modelled by POSIX signals: DisableGlobalIRQ() blocks every signal of the calling
+ *        thread, so a signal handler plays an ISR on the same core and another thread plays the other core.
+ */
+
+#ifndef _FSL_COMMON_H_
+#define _FSL_COMMON_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define COUNT_TO_USEC(count, clockFreqInHz) (uint64_t)((uint64_t)(count)*1000000U / (clockFreqInHz))
+#define USEC_TO_COUNT(us, clockFreqInHz) (uint64_t)(((uint64_t)(us) * (clockFreqInHz)) / 1000000U)
+
+#define __DMB() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __DSB() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __NOP() do { } while (0)
+
+typedef int32_t status_t;
+
+enum
+{
+	kStatus_Success = 0,
+	kStatus_Fail = 1,
+};
+
+typedef enum
+{
+	kCLOCK_CoreSysClk,
+} clock_name_t;
+
+/*! Host "core clock", the rate BOARD_SystickGetTicks() counts at. */
+uint32_t CLOCK_GetFreq(clock_name_t name);
+
+/*! Host only: every read of the systick jumps step_us ahead of the host clock from now on, 0 stops it.
+ *  The simulated bus lets a stuck transfer run into its deadline at once with it. */
+void HOST_SystickWarp(uint32_t step_us);
+
+uint32_t DisableGlobalIRQ(void);
+void EnableGlobalIRQ(uint32_t primask);
+
+/*******************************************************************************
+ * Device: the inter-core MAILBOX of the MCXN947, for the dual-core service (rtc/pcf2131_ipc.c).
+ * The registers are plain memory, IRQSET keeps what was written: a simulated core takes its doorbell
+ * with an atomic exchange of its IRQSET, as its mailbox interrupt.
+ ******************************************************************************/
+typedef struct
+{
+	struct
+	{
+		volatile uint32_t IRQ;
+		volatile uint32_t IRQSET;
+		volatile uint32_t IRQCLR;
+		uint8_t RESERVED_0[4];
+	} MBOXIRQ[2];
+} MAILBOX_Type;
+
+extern MAILBOX_Type g_Host_Mailbox;
+
+#define MAILBOX (&g_Host_Mailbox)
+
+typedef enum
+{
+	MAILBOX_IRQn = 120,
+} IRQn_Type;
+
+#define SDK_ISR_EXIT_BARRIER __DSB()
+
+status_t EnableIRQ(IRQn_Type interrupt);
+
+#endif /* _FSL_COMMON_H_ */
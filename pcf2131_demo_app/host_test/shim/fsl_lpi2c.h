@@ -0,0 +1,91 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file fsl_lpi2c.h
+ * @brief Host stand-in for the SDK LPI2C master driver, only what the FIFO block write of register_io_i2c.c
+ *        uses. The registers and the bit masks are those of the device, the functions are simulated in
+ *        mock_bus.c: a command word written to MTDR goes out on the simulated bus at the next status read,
+ *        as the register I/O layer reads the status before every word it writes.
+ */
+
+#ifndef _FSL_LPI2C_H_
+#define _FSL_LPI2C_H_
+
+#include "fsl_common.h"
+
+/*! @brief The LPI2C master registers. */
+typedef struct
+{
+	volatile uint32_t MCR;  /* Master control. */
+	volatile uint32_t MSR;  /* Master status, the flags are cleared by writing 1. */
+	volatile uint32_t MTDR; /* Master transmit data, a command in bits 10:8 and a byte. */
+} LPI2C_Type;
+
+extern LPI2C_Type g_Mock_LPI2C0;
+
+#define LPI2C0 (&g_Mock_LPI2C0)
+#define LPI2C_BASE_PTRS {LPI2C0}
+
+#define FSL_FEATURE_LPI2C_FIFO_SIZEn(x) (4)
+
+#define LPI2C_MCR_MEN_MASK (0x1U)
+#define LPI2C_MCR_RTF_MASK (0x100U)
+#define LPI2C_MCR_RRF_MASK (0x200U)
+
+#define LPI2C_MSR_TDF_MASK (0x1U)
+#define LPI2C_MSR_RDF_MASK (0x2U)
+#define LPI2C_MSR_EPF_MASK (0x100U)
+#define LPI2C_MSR_SDF_MASK (0x200U)
+#define LPI2C_MSR_NDF_MASK (0x400U)
+#define LPI2C_MSR_ALF_MASK (0x800U)
+#define LPI2C_MSR_FEF_MASK (0x1000U)
+#define LPI2C_MSR_PLTF_MASK (0x2000U)
+#define LPI2C_MSR_DMF_MASK (0x4000U)
+#define LPI2C_MSR_MBF_MASK (0x1000000U)
+#define LPI2C_MSR_BBF_MASK (0x2000000U)
+
+#define LPI2C_MTDR_CMD_MASK (0x700U)
+#define LPI2C_MTDR_CMD_SHIFT (8U)
+#define LPI2C_MTDR_CMD(x) (((uint32_t)(((uint32_t)(x)) << LPI2C_MTDR_CMD_SHIFT)) & LPI2C_MTDR_CMD_MASK)
+
+enum
+{
+	kStatus_LPI2C_Nak = 1402,
+	kStatus_LPI2C_FifoError = 1403,
+	kStatus_LPI2C_ArbitrationLost = 1405,
+	kStatus_LPI2C_PinLowTimeout = 1406,
+};
+
+enum _lpi2c_master_flags
+{
+	kLPI2C_MasterTxReadyFlag = LPI2C_MSR_TDF_MASK,
+	kLPI2C_MasterRxReadyFlag = LPI2C_MSR_RDF_MASK,
+	kLPI2C_MasterEndOfPacketFlag = LPI2C_MSR_EPF_MASK,
+	kLPI2C_MasterStopDetectFlag = LPI2C_MSR_SDF_MASK,
+	kLPI2C_MasterNackDetectFlag = LPI2C_MSR_NDF_MASK,
+	kLPI2C_MasterArbitrationLostFlag = LPI2C_MSR_ALF_MASK,
+	kLPI2C_MasterFifoErrFlag = LPI2C_MSR_FEF_MASK,
+	kLPI2C_MasterPinLowTimeoutFlag = LPI2C_MSR_PLTF_MASK,
+	kLPI2C_MasterDataMatchFlag = LPI2C_MSR_DMF_MASK,
+	kLPI2C_MasterBusyFlag = LPI2C_MSR_MBF_MASK,
+	kLPI2C_MasterBusBusyFlag = LPI2C_MSR_BBF_MASK,
+
+	kLPI2C_MasterClearFlags = kLPI2C_MasterEndOfPacketFlag | kLPI2C_MasterStopDetectFlag |
+							  kLPI2C_MasterNackDetectFlag | kLPI2C_MasterArbitrationLostFlag |
+							  kLPI2C_MasterFifoErrFlag | kLPI2C_MasterPinLowTimeoutFlag | kLPI2C_MasterDataMatchFlag,
+	kLPI2C_MasterErrorFlags = kLPI2C_MasterNackDetectFlag | kLPI2C_MasterArbitrationLostFlag |
+							  kLPI2C_MasterFifoErrFlag | kLPI2C_MasterPinLowTimeoutFlag,
+};
+
+uint32_t LPI2C_MasterGetStatusFlags(LPI2C_Type *base);
+void LPI2C_MasterClearStatusFlags(LPI2C_Type *base, uint32_t statusMask);
+void LPI2C_MasterGetFifoCounts(LPI2C_Type *base, size_t *rxCount, size_t *txCount);
+
+/*! @brief Returns the status of the worst error in status and clears the errors and the FIFOs as the SDK does. */
+status_t LPI2C_MasterCheckAndClearError(LPI2C_Type *base, uint32_t status);
+
+#endif /* _FSL_LPI2C_H_ */
@@ -0,0 +1,61 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file fsl_os_abstraction.h
+ * @brief Host stand-in for the SDK OS abstraction layer (component/osa), only what register_io_osa.c uses.
+ *        The names and the semantics are those of the SDK, the port is shim/fsl_os_abstraction_pthread.c:
+ *        a recursive priority inheritance pthread mutex, a POSIX semaphore and a global critical section.
+ */
+
+#ifndef _FSL_OS_ABSTRACTION_H_
+#define _FSL_OS_ABSTRACTION_H_
+
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdint.h>
+
+typedef enum _osa_status
+{
+	KOSA_StatusSuccess = 0,
+	KOSA_StatusError = 1,
+	KOSA_StatusTimeout = 2,
+	KOSA_StatusIdle = 3,
+} osa_status_t;
+
+typedef void *osa_mutex_handle_t;
+typedef void *osa_semaphore_handle_t;
+
+#define osaWaitForever_c ((uint32_t)(-1))
+
+#define OSA_MUTEX_HANDLE_SIZE (sizeof(pthread_mutex_t))
+#define OSA_SEM_HANDLE_SIZE (sizeof(sem_t))
+
+/* 64 bit words, as the pthread objects need their alignment on the host. */
+#define OSA_MUTEX_HANDLE_DEFINE(name) uint64_t name[(OSA_MUTEX_HANDLE_SIZE + sizeof(uint64_t) - 1U) / sizeof(uint64_t)]
+#define OSA_SEMAPHORE_HANDLE_DEFINE(name) \
+	uint64_t name[(OSA_SEM_HANDLE_SIZE + sizeof(uint64_t) - 1U) / sizeof(uint64_t)]
+
+#define OSA_SR_ALLOC() uint32_t osaCurrentSr = 0U;
+#define OSA_ENTER_CRITICAL() OSA_EnterCritical(&osaCurrentSr)
+#define OSA_EXIT_CRITICAL() OSA_ExitCritical(osaCurrentSr)
+
+void OSA_EnterCritical(uint32_t *sr);
+void OSA_ExitCritical(uint32_t sr);
+
+osa_status_t OSA_MutexCreate(osa_mutex_handle_t mutexHandle);
+osa_status_t OSA_MutexLock(osa_mutex_handle_t mutexHandle, uint32_t millisec);
+osa_status_t OSA_MutexUnlock(osa_mutex_handle_t mutexHandle);
+osa_status_t OSA_MutexDestroy(osa_mutex_handle_t mutexHandle);
+
+osa_status_t OSA_SemaphoreCreate(osa_semaphore_handle_t semaphoreHandle, uint32_t initValue);
+osa_status_t OSA_SemaphoreWait(osa_semaphore_handle_t semaphoreHandle, uint32_t millisec);
+osa_status_t OSA_SemaphorePost(osa_semaphore_handle_t semaphoreHandle);
+osa_status_t OSA_SemaphoreDestroy(osa_semaphore_handle_t semaphoreHandle);
+
+uint32_t OSA_TimeGetMsec(void);
+
+#endif /* _FSL_OS_ABSTRACTION_H_ */
@@ -0,0 +1,152 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file fsl_os_abstraction_pthread.c
+ * @brief Host port of the SDK OS abstraction subset of fsl_os_abstraction.h on POSIX threads. The mutex is
+ *        recursive with priority inheritance as the RTOS ports, the semaphore is a POSIX semaphore whose
+ *        post may be called from a signal handler, the stand-in for an ISR.
+ */
+
+/* PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP */
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <time.h>
+
+#include "fsl_os_abstraction.h"
+
+static pthread_mutex_t s_critical = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+
+/*! Takes the global critical section, nested calls from one thread are allowed. */
+void OSA_EnterCritical(uint32_t *sr)
+{
+	pthread_mutex_lock(&s_critical);
+	*sr = 0U;
+}
+
+void OSA_ExitCritical(uint32_t sr)
+{
+	pthread_mutex_unlock(&s_critical);
+}
+
+osa_status_t OSA_MutexCreate(osa_mutex_handle_t mutexHandle)
+{
+	pthread_mutexattr_t attr;
+	osa_status_t status = KOSA_StatusError;
+
+	if ((0 == pthread_mutexattr_init(&attr)) && (0 == pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE)) &&
+		(0 == pthread_mutexattr_setprotocol(&attr, PTHREAD_PRIO_INHERIT)) &&
+		(0 == pthread_mutex_init((pthread_mutex_t *)mutexHandle, &attr)))
+	{
+		status = KOSA_StatusSuccess;
+	}
+	pthread_mutexattr_destroy(&attr);
+
+	return status;
+}
+
+/* The absolute CLOCK_REALTIME time millisec from now, for the timed waits. */
+static void osa_deadline(struct timespec *pDeadline, uint32_t millisec)
+{
+	clock_gettime(CLOCK_REALTIME, pDeadline);
+	pDeadline->tv_sec += millisec / 1000U;
+	pDeadline->tv_nsec += (long)(millisec % 1000U) * 1000000L;
+	if (pDeadline->tv_nsec >= 1000000000L)
+	{
+		pDeadline->tv_sec++;
+		pDeadline->tv_nsec -= 1000000000L;
+	}
+}
+
+osa_status_t OSA_MutexLock(osa_mutex_handle_t mutexHandle, uint32_t millisec)
+{
+	struct timespec deadline;
+	int result;
+
+	if (osaWaitForever_c == millisec)
+	{
+		result = pthread_mutex_lock((pthread_mutex_t *)mutexHandle);
+	}
+	else
+	{
+		osa_deadline(&deadline, millisec);
+		result = pthread_mutex_timedlock((pthread_mutex_t *)mutexHandle, &deadline);
+	}
+
+	return (0 == result) ? KOSA_StatusSuccess : ((ETIMEDOUT == result) ? KOSA_StatusTimeout : KOSA_StatusError);
+}
+
+osa_status_t OSA_MutexUnlock(osa_mutex_handle_t mutexHandle)
+{
+	return (0 == pthread_mutex_unlock((pthread_mutex_t *)mutexHandle)) ? KOSA_StatusSuccess : KOSA_StatusError;
+}
+
+osa_status_t OSA_MutexDestroy(osa_mutex_handle_t mutexHandle)
+{
+	return (0 == pthread_mutex_destroy((pthread_mutex_t *)mutexHandle)) ? KOSA_StatusSuccess : KOSA_StatusError;
+}
+
+osa_status_t OSA_SemaphoreCreate(osa_semaphore_handle_t semaphoreHandle, uint32_t initValue)
+{
+	return (0 == sem_init((sem_t *)semaphoreHandle, 0, initValue)) ? KOSA_StatusSuccess : KOSA_StatusError;
+}
+
+/*! Waits for the semaphore, a signal interrupting the wait restarts it. */
+osa_status_t OSA_SemaphoreWait(osa_semaphore_handle_t semaphoreHandle, uint32_t millisec)
+{
+	struct timespec deadline;
+	int result;
+
+	if (osaWaitForever_c == millisec)
+	{
+		do
+		{
+			result = sem_wait((sem_t *)semaphoreHandle);
+		} while ((0 != result) && (EINTR == errno));
+	}
+	else if (0U == millisec)
+	{
+		result = sem_trywait((sem_t *)semaphoreHandle);
+		if ((0 != result) && (EAGAIN == errno))
+		{
+			return KOSA_StatusTimeout;
+		}
+	}
+	else
+	{
+		osa_deadline(&deadline, millisec);
+		do
+		{
+			result = sem_timedwait((sem_t *)semaphoreHandle, &deadline);
+		} while ((0 != result) && (EINTR == errno));
+	}
+
+	if (0 == result)
+	{
+		return KOSA_StatusSuccess;
+	}
+	return (ETIMEDOUT == errno) ? KOSA_StatusTimeout : KOSA_StatusError;
+}
+
+/*! Gives the semaphore, sem_post() is async-signal-safe. */
+osa_status_t OSA_SemaphorePost(osa_semaphore_handle_t semaphoreHandle)
+{
+	return (0 == sem_post((sem_t *)semaphoreHandle)) ? KOSA_StatusSuccess : KOSA_StatusError;
+}
+
+osa_status_t OSA_SemaphoreDestroy(osa_semaphore_handle_t semaphoreHandle)
+{
+	return (0 == sem_destroy((sem_t *)semaphoreHandle)) ? KOSA_StatusSuccess : KOSA_StatusError;
+}
+
+uint32_t OSA_TimeGetMsec(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint32_t)((uint64_t)now.tv_sec * 1000U + (uint64_t)now.tv_nsec / 1000000U);
+}
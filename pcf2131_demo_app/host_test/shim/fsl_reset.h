@@ -0,0 +1,25 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file fsl_reset.h
+ * @brief Host stand-in for the SDK reset driver, only the peripherals the driver sources under test reset.
+ */
+
+#ifndef _FSL_RESET_H_
+#define _FSL_RESET_H_
+
+#include "fsl_common.h"
+
+typedef enum
+{
+	kMAILBOX_RST_SHIFT_RSTn,
+} SYSCON_RSTn_t;
+
+/*! Clears the registers of the peripheral. */
+void RESET_PeripheralReset(SYSCON_RSTn_t peripheral);
+
+#endif /* _FSL_RESET_H_ */
@@ -0,0 +1,21 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file gpio_driver.h
+ * @brief Host stand-in for the KSDK GPIO driver, pins are simulated in host_shim.c.
+ */
+
+#ifndef __DRIVER_GPIO_H__
+#define __DRIVER_GPIO_H__
+
+#include "Driver_Common.h"
+#include "Driver_GPIO.h"
+#include "fsl_common.h"
+
+extern GENERIC_DRIVER_GPIO Driver_GPIO_KSDK;
+
+#endif /* __DRIVER_GPIO_H__ */
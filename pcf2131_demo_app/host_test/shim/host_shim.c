@@ -0,0 +1,160 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file host_shim.c
+ * @brief Host implementation of the MCU services stood in by the shim headers.
+ */
+
+#include <pthread.h>
+#include <signal.h>
+#include <time.h>
+
+#include "fsl_clock.h"
+#include "fsl_common.h"
+#include "fsl_reset.h"
+#include "gpio_driver.h"
+#include "systick_utils.h"
+
+static __thread sigset_t s_irqMask;
+static __thread uint32_t s_irqDepth;
+
+/*! Masks the "interrupts" (signals) of the calling thread, nested calls keep them masked. */
+uint32_t DisableGlobalIRQ(void)
+{
+	sigset_t all;
+
+	if (s_irqDepth == 0)
+	{
+		sigfillset(&all);
+		pthread_sigmask(SIG_BLOCK, &all, &s_irqMask);
+	}
+
+	return s_irqDepth++;
+}
+
+/*! Unmasks the "interrupts" again when the outermost DisableGlobalIRQ() is undone. */
+void EnableGlobalIRQ(uint32_t primask)
+{
+	s_irqDepth = primask;
+	if (s_irqDepth == 0)
+	{
+		pthread_sigmask(SIG_SETMASK, &s_irqMask, NULL);
+	}
+}
+
+/*******************************************************************************
+ * Clock and systick, the host monotonic clock counted at HOST_CORE_FREQ.
+ ******************************************************************************/
+#define HOST_CORE_FREQ (100000000U)
+
+uint32_t CLOCK_GetFreq(clock_name_t name)
+{
+	return HOST_CORE_FREQ;
+}
+
+uint32_t BOARD_SystickGetCoreFreq(void)
+{
+	return HOST_CORE_FREQ;
+}
+
+/* Ticks the clock is ahead of the host clock, and the jump per read while warping. */
+static uint64_t s_warpTicks;
+static uint64_t s_warpStep;
+
+void HOST_SystickWarp(uint32_t step_us)
+{
+	__atomic_store_n(&s_warpStep, USEC_TO_COUNT(step_us, HOST_CORE_FREQ), __ATOMIC_RELAXED);
+}
+
+uint64_t BOARD_SystickGetTicks(void)
+{
+	struct timespec now;
+	uint64_t warp = __atomic_add_fetch(&s_warpTicks, __atomic_load_n(&s_warpStep, __ATOMIC_RELAXED), __ATOMIC_RELAXED);
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t)now.tv_sec * HOST_CORE_FREQ + (uint64_t)now.tv_nsec * (HOST_CORE_FREQ / 1000000U) / 1000U + warp;
+}
+
+void BOARD_SystickStart(int32_t *pStart)
+{
+	*pStart = (int32_t)BOARD_SystickGetTicks();
+}
+
+int32_t BOARD_SystickElapsedTicks(int32_t *pStart)
+{
+	return (int32_t)((uint32_t)BOARD_SystickGetTicks() - (uint32_t)*pStart);
+}
+
+uint32_t BOARD_SystickElapsedTime_us(int32_t *pStart)
+{
+	return (uint32_t)COUNT_TO_USEC(BOARD_SystickElapsedTicks(pStart), HOST_CORE_FREQ);
+}
+
+void BOARD_SystickSetClockCorrection(int32_t ppm)
+{
+}
+
+void BOARD_DELAY_ms(uint32_t delay_ms)
+{
+	struct timespec delay = {.tv_sec = delay_ms / 1000U, .tv_nsec = (delay_ms % 1000U) * 1000000L};
+
+	nanosleep(&delay, NULL);
+}
+
+/*******************************************************************************
+ * GPIO, every pin reads back alternately low and high so edge waits (CLKOUT) end.
+ ******************************************************************************/
+static void host_pin_init(pinID_t aPinId, gpio_direction_t dir, void *apPinConfig, gpio_isr_handler_t aIsrHandler,
+						  void *apUserData)
+{
+}
+
+static void host_pin_op(pinID_t aPinId)
+{
+}
+
+static void host_pin_write(pinID_t aPinId, uint8_t aValue)
+{
+}
+
+static uint32_t host_pin_read(pinID_t aPinId)
+{
+	static __thread uint32_t level;
+
+	return level ^= 1U;
+}
+
+GENERIC_DRIVER_GPIO Driver_GPIO_KSDK = {
+	.pin_init = host_pin_init,
+	.set_pin = host_pin_op,
+	.clr_pin = host_pin_op,
+	.toggle_pin = host_pin_op,
+	.write_pin = host_pin_write,
+	.read_pin = host_pin_read,
+};
+
+/*******************************************************************************
+ * The inter-core mailbox, plain memory (see fsl_common.h).
+ ******************************************************************************/
+MAILBOX_Type g_Host_Mailbox;
+
+status_t EnableIRQ(IRQn_Type interrupt)
+{
+	return kStatus_Success;
+}
+
+void CLOCK_EnableClock(clock_ip_name_t clk)
+{
+}
+
+void RESET_PeripheralReset(SYSCON_RSTn_t peripheral)
+{
+	if (kMAILBOX_RST_SHIFT_RSTn == peripheral)
+	{
+		memset((void *)&g_Host_Mailbox, 0, sizeof(g_Host_Mailbox));
+	}
+}
@@ -0,0 +1,39 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file issdk_hal.h
+ * @brief Host stand-in for the board HAL wrapper: one LPI2C and one LPSPI instance, bus 0 of the register I/O
+ *        layer, and the bus clear of the board. The peripherals and the bus clear are simulated in mock_bus.c.
+ */
+
+#ifndef __ISSDK_HAL_H__
+#define __ISSDK_HAL_H__
+
+#include "fsl_common.h"
+#include "fsl_lpi2c.h"
+#include "Driver_I2C.h"
+#include "Driver_SPI.h"
+
+/*! @brief The LPSPI registers are not touched by the register I/O layer, only its base pointers are. */
+typedef struct
+{
+	volatile uint32_t CR;
+} LPSPI_Type;
+
+extern LPSPI_Type g_Mock_LPSPI0;
+
+#define LPSPI0 (&g_Mock_LPSPI0)
+#define LPSPI_BASE_PTRS {LPSPI0}
+
+/*! @brief Bus 0 of the register I/O layer, with its signal event handlers. */
+#define I2C0 LPI2C0
+#define SPI0 LPSPI0
+
+/*! @brief Clocks SCL until a slave holding SDA low lets go, then sends a STOP. */
+void BOARD_I2C_BusClear(uint8_t deviceInstance);
+
+#endif // __ISSDK_HAL_H__
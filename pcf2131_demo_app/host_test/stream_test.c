@@ -0,0 +1,210 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file stream_test.c
+ * @brief Host test of the telemetry stream (source/pcf2131_stream.c): PCF2131_Stream_Run() runs on a device
+ *        thread on the simulated register map, the test pokes the registers, triggers records with
+ *        PCF2131_Stream_Notify() as the pin interrupt does and decodes them from the loopback serial port.
+ *        Checks keyframes and deltas, that every set timestamp flag is reported with its capture and then
+ *        cleared, repeated captures on the same input, and a failed clear being reported again.
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mock_bus.h"
+#include "loopback_serial.h"
+#include "pcf2131_client.h"
+#include "pcf2131_stream.h"
+
+#define CHECK(cond)                                                              \
+	do                                                                           \
+	{                                                                            \
+		if (!(cond))                                                             \
+		{                                                                        \
+			printf("stream_test: %s:%d: %s\n", __FILE__, __LINE__, #cond);       \
+			s_failures++;                                                        \
+		}                                                                        \
+	} while (0)
+
+/* Bus transfers of a record before the flag clear: the register block and one capture. */
+#if (I2C_ENABLE)
+#define STREAM_TEST_XFERS_BEFORE_CLEAR (4)
+#else
+#define STREAM_TEST_XFERS_BEFORE_CLEAR (2)
+#endif
+
+typedef struct
+{
+	uint16_t seq;
+	uint16_t mask;
+	uint8_t ts;
+	uint8_t regs[PCF2131_CTRL_TIME_SIZE_BYTE];
+	uint8_t captures[4][PCF2131_TS_SIZE_BYTE];
+} stream_record_t;
+
+static const uint8_t s_tsReg[4] = {
+	PCF2131_TIMESTAMP1_SECONDS, PCF2131_TIMESTAMP2_SECONDS, PCF2131_TIMESTAMP3_SECONDS, PCF2131_TIMESTAMP4_SECONDS};
+static const uint8_t s_tsFlag[4] = {
+	PCF2131_CTRL4_TSF1_MASK, PCF2131_CTRL4_TSF2_MASK, PCF2131_CTRL4_TSF3_MASK, PCF2131_CTRL4_TSF4_MASK};
+
+static pcf2131_sensorhandle_t s_rtc;
+static pcf2131_streamstats_t s_stats;
+static pcf2131_client_t s_client;
+static uint8_t s_regs[PCF2131_CTRL_TIME_SIZE_BYTE];   /* Register block rebuilt from the records. */
+static uint32_t s_failures;
+
+static void *device_thread(void *arg)
+{
+	const pcf2131_streamcfg_t config = {.period_ms = 0, .keyframeInterval = 8};
+
+	CHECK(PCF2131_Stream_Run(&s_rtc, &config, &s_stats) == SENSOR_ERROR_NONE);
+	return NULL;
+}
+
+/* Triggers one record and decodes it, the register block is rebuilt as a host would. */
+static int next_record(stream_record_t *pRecord)
+{
+	uint8_t payload[PCF2131_CLIENT_MAX_PAYLOAD];
+	uint8_t sof, length, pos = 7, i;
+
+	/*! Notify does nothing until the device thread has started the stream */
+	while (!PCF2131_Stream_Notify())
+	{
+		sched_yield();
+	}
+	if ((PCF2131_Client_ReadFrame(&s_client, &sof, payload, &length) != 0) || (sof != PCF2131_PROTO_SOF_TLM) ||
+			(length < 7))
+	{
+		return -1;
+	}
+	pRecord->seq = (uint16_t)(payload[0] | (payload[1] << 8));
+	pRecord->mask = (uint16_t)(payload[4] | (payload[5] << 8));
+	pRecord->ts = payload[6];
+	for (i = 0; i < PCF2131_CTRL_TIME_SIZE_BYTE; i++)
+	{
+		if (pRecord->mask & (1U << i))
+		{
+			s_regs[i] = payload[pos++];
+		}
+	}
+	memcpy(pRecord->regs, s_regs, sizeof(s_regs));
+	for (i = 0; i < 4; i++)
+	{
+		if (pRecord->ts & (1U << i))
+		{
+			memcpy(pRecord->captures[i], &payload[pos], PCF2131_TS_SIZE_BYTE);
+			pos += PCF2131_TS_SIZE_BYTE;
+		}
+	}
+
+	return (pos == length) ? 0 : -1;
+}
+
+/* A capture on input i as the RTC makes it: registers loaded, then the flag set. */
+static void capture(uint8_t i, uint8_t second)
+{
+	uint8_t j;
+
+	for (j = 0; j < PCF2131_TS_SIZE_BYTE; j++)
+	{
+		g_Mock_Regs[s_tsReg[i] + j] = (uint8_t)(second + j);
+	}
+	g_Mock_Regs[PCF2131_CTRL4] |= s_tsFlag[i];
+}
+
+static void test_stream(void)
+{
+	stream_record_t record;
+	uint16_t seq = 0;
+	uint8_t i;
+
+	/*! The first record is a keyframe without captures */
+	g_Mock_Regs[PCF2131_SECOND] = 0x10;
+	CHECK(next_record(&record) == 0);
+	CHECK((record.seq == seq++) && (record.mask & PCF2131_STREAM_KEYFRAME) && (record.ts == 0));
+	CHECK(!memcmp(record.regs, g_Mock_Regs, PCF2131_CTRL_TIME_SIZE_BYTE));
+
+	/*! A delta carries only the changed register */
+	g_Mock_Regs[PCF2131_SECOND] = 0x11;
+	CHECK(next_record(&record) == 0);
+	CHECK((record.seq == seq++) && (record.mask == (1U << PCF2131_SECOND)));
+	CHECK(record.regs[PCF2131_SECOND] == 0x11);
+
+	/*! A capture is reported once with its registers and the flag is cleared */
+	capture(0, 0x20);
+	CHECK(next_record(&record) == 0);
+	CHECK((record.seq == seq++) && (record.ts == 0x01));
+	CHECK(!memcmp(record.captures[0], &g_Mock_Regs[s_tsReg[0]], PCF2131_TS_SIZE_BYTE));
+	CHECK((record.regs[PCF2131_CTRL4] & s_tsFlag[0]) && !(g_Mock_Regs[PCF2131_CTRL4] & s_tsFlag[0]));
+	CHECK(next_record(&record) == 0);
+	CHECK((record.seq == seq++) && (record.ts == 0) && !(record.regs[PCF2131_CTRL4] & s_tsFlag[0]));
+
+	/*! Each new capture on the same input is reported, the flag is set again only after the clear */
+	for (i = 0; i < 3; i++)
+	{
+		capture(0, (uint8_t)(0x30 + i));
+		CHECK(next_record(&record) == 0);
+		CHECK((record.seq == seq++) && (record.ts == 0x01) && (record.captures[0][0] == 0x30 + i));
+	}
+
+	/*! Several inputs in one record, all cleared by one write */
+	capture(1, 0x40);
+	capture(3, 0x50);
+	CHECK(next_record(&record) == 0);
+	CHECK((record.seq == seq++) && (record.ts == 0x0A) && (record.captures[1][0] == 0x40) &&
+			(record.captures[3][0] == 0x50));
+	CHECK((g_Mock_Regs[PCF2131_CTRL4] & 0xF0) == 0);
+
+	/*! A failed clear leaves the flag set and the capture is sent again, nothing is lost */
+	capture(2, 0x60);
+	Mock_Bus_Fail(STREAM_TEST_XFERS_BEFORE_CLEAR, 1, ARM_DRIVER_ERROR);
+	CHECK(next_record(&record) == 0);
+	CHECK((record.seq == seq++) && (record.ts == 0x04) && (g_Mock_Regs[PCF2131_CTRL4] & s_tsFlag[2]));
+	CHECK(next_record(&record) == 0);
+	CHECK((record.seq == seq++) && (record.ts == 0x04) && (record.captures[2][0] == 0x60));
+	CHECK(!(g_Mock_Regs[PCF2131_CTRL4] & s_tsFlag[2]));
+
+	/*! A failed register read is a record without registers, the flags are left alone */
+	capture(0, 0x70);
+	Mock_Bus_Fail(0, 1, ARM_DRIVER_ERROR);
+	CHECK(next_record(&record) == 0);
+	CHECK((record.seq == seq++) && (record.mask == PCF2131_STREAM_READ_ERROR) && (record.ts == 0));
+	CHECK(next_record(&record) == 0);
+	CHECK((record.seq == seq++) && (record.ts == 0x01) && (record.captures[0][0] == 0x70));
+}
+
+int main(void)
+{
+	pthread_t device;
+
+	Mock_Bus_Reset();
+	Loopback_Reset();
+#if (I2C_ENABLE)
+	CHECK(PCF2131_Initialize(&s_rtc, &Mock_I2C_Driver, 0, 0x53) == SENSOR_ERROR_NONE);
+#else
+	static uint32_t slaveSelect;
+	CHECK(PCF2131_Initialize(&s_rtc, &Mock_SPI_Driver, 0, &slaveSelect) == SENSOR_ERROR_NONE);
+#endif
+	PCF2131_Client_Init(&s_client, Loopback_Write, Loopback_Read, NULL);
+	pthread_create(&device, NULL, device_thread, NULL);
+
+	test_stream();
+
+	/*! Any character ends the stream */
+	Loopback_Write(NULL, (const uint8_t *)"q", 1);
+	pthread_join(device, NULL);
+	CHECK(s_stats.captures == 9);
+	CHECK((s_stats.readErrors == 1) && (s_stats.clearErrors == 1));
+
+	printf("stream_test: %u records, %u bytes, %u captures\n", s_stats.records, s_stats.bytes, s_stats.captures);
+	printf("stream_test: %s\n", s_failures ? "FAIL" : "PASS");
+	return s_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file trace_decoder.c
+ * @brief Host decoder of the register transaction traces, see trace_decoder.h.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "trace_decoder.h"
+
+/* A 32 bit varint takes at most 5 bytes, the last with 4 bits. */
+#define TRACE_DECODER_VARINT_MAX (5)
+
+static int trace_varint(trace_decoder_t *pDecoder, size_t *pPos, uint32_t *pValue)
+{
+	uint32_t value = 0, i;
+	uint8_t byte;
+
+	for (i = 0; i < TRACE_DECODER_VARINT_MAX; i++)
+	{
+		if (*pPos >= pDecoder->size)
+		{
+			return -1;
+		}
+		byte = pDecoder->pTrace[(*pPos)++];
+		value |= (uint32_t)(byte & 0x7F) << (7 * i);
+		if (!(byte & 0x80))
+		{
+			if ((i == TRACE_DECODER_VARINT_MAX - 1) && (byte > 0x0F))
+			{
+				return -1;
+			}
+			*pValue = value;
+			return 0;
+		}
+	}
+
+	return -1;
+}
+
+void Trace_Decoder_Init(trace_decoder_t *pDecoder, const uint8_t *pTrace, size_t size)
+{
+	memset(pDecoder, 0, sizeof(*pDecoder));
+	pDecoder->pTrace = pTrace;
+	pDecoder->size = size;
+}
+
+int Trace_Decoder_Next(trace_decoder_t *pDecoder, trace_record_t *pRecord)
+{
+	size_t pos = pDecoder->pos;
+
+	if (pos == pDecoder->size)
+	{
+		return 0;
+	}
+	if (pos + 3 > pDecoder->size)
+	{
+		return -1;
+	}
+	pRecord->flags = pDecoder->pTrace[pos];
+	pRecord->offset = pDecoder->pTrace[pos + 1];
+	pRecord->length = pDecoder->pTrace[pos + 2];
+	pos += 3;
+	if ((trace_varint(pDecoder, &pos, &pRecord->gap_us) != 0) ||
+			(trace_varint(pDecoder, &pos, &pRecord->duration_us) != 0))
+	{
+		return -1;
+	}
+
+	/*! A failed transaction has no payload */
+	pRecord->pPayload = NULL;
+	if (!(pRecord->flags & REGISTER_TRACE_FAILED))
+	{
+		if (pos + pRecord->length > pDecoder->size)
+		{
+			return -1;
+		}
+		pRecord->pPayload = &pDecoder->pTrace[pos];
+		pos += pRecord->length;
+	}
+
+	pDecoder->time_us += pRecord->gap_us;
+	pRecord->start_us = pDecoder->time_us;
+	pRecord->index = pDecoder->records++;
+	pDecoder->pos = pos;
+	return 1;
+}
+
+int Trace_Decoder_Format(const trace_record_t *pRecord, char *pOut, size_t size)
+{
+	size_t n;
+	uint32_t i;
+
+	n = (size_t)snprintf(pOut, size, "%5u %10.6f s +%-6u %-5s %s%u 0x%02X %3u %6u us", pRecord->index,
+			pRecord->start_us / 1e6, pRecord->gap_us, (pRecord->flags & REGISTER_TRACE_WRITE) ? "write" : "read",
+			(pRecord->flags & REGISTER_TRACE_I2C) ? "I2C" : "SPI", pRecord->flags >> 3, pRecord->offset,
+			pRecord->length, pRecord->duration_us);
+	if (pRecord->pPayload == NULL)
+	{
+		return (int)n + snprintf(pOut + ((n < size) ? n : size), (n < size) ? size - n : 0, "  FAILED");
+	}
+	for (i = 0; i < pRecord->length; i++)
+	{
+		n += (size_t)snprintf(pOut + ((n < size) ? n : size), (n < size) ? size - n : 0, "%s%02X",
+				(i == 0) ? "  " : " ", pRecord->pPayload[i]);
+	}
+
+	return (int)n;
+}
+
+int Trace_Decoder_Receive(pcf2131_client_t *pClient, uint8_t *pTrace, size_t size)
+{
+	uint8_t payload[PCF2131_CLIENT_MAX_PAYLOAD];
+	uint8_t sof, length;
+	size_t total = 0;
+
+	while (PCF2131_Client_ReadFrame(pClient, &sof, payload, &length) == 0)
+	{
+		if (sof != PCF2131_PROTO_SOF_TRACE)
+		{
+			continue;
+		}
+		if (total + length > size)
+		{
+			return -1;
+		}
+		memcpy(&pTrace[total], payload, length);
+		total += length;
+	}
+
+	return (int)total;
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file trace_decoder.h
+ * @brief Host decoder of the register transaction traces (interfaces/register_io_trace.h). The demo sends a
+ *        capture as frames with start byte PCF2131_PROTO_SOF_TRACE, Trace_Decoder_Receive() collects them from
+ *        a client transport and Trace_Decoder_Next() walks the records of the reassembled trace.
+ */
+
+#ifndef TRACE_DECODER_H_
+#define TRACE_DECODER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "pcf2131_client.h"
+#include "register_io_trace.h"
+
+/*! @brief Longest line of Trace_Decoder_Format(): the fields and the largest payload in hex. */
+#define TRACE_DECODER_MAX_LINE (80 + 3 * 255)
+
+/*! @brief One decoded record. */
+typedef struct
+{
+	uint32_t index;                                  /* Record number from 0. */
+	uint8_t flags;                                   /* REGISTER_TRACE_x and the device instance. */
+	uint8_t offset;
+	uint8_t length;
+	uint32_t gap_us;                                 /* From the start of the previous record. */
+	uint32_t duration_us;
+	uint64_t start_us;                               /* From the capture start, the sum of the gaps. */
+	const uint8_t *pPayload;                         /* Into the trace, NULL for a failed transaction. */
+} trace_record_t;
+
+typedef struct
+{
+	const uint8_t *pTrace;
+	size_t size;
+	size_t pos;                                      /* Start of the next record. */
+	uint32_t records;                                /* Records decoded so far. */
+	uint64_t time_us;                                /* Start of the last record. */
+} trace_decoder_t;
+
+/*! @brief Starts decoding a trace, it must stay valid while records are used. */
+void Trace_Decoder_Init(trace_decoder_t *pDecoder, const uint8_t *pTrace, size_t size);
+
+/*! @brief Decodes the next record.
+ *  @return 1 with the record, 0 at the end of the trace, -1 on a truncated record or a varint over 32 bits.
+ *          The decoder stays at a bad record. */
+int Trace_Decoder_Next(trace_decoder_t *pDecoder, trace_record_t *pRecord);
+
+/*! @brief Formats a record as one line of text (snprintf semantics): start time, gap, direction, bus and
+ *         instance, first register, length, duration and the payload in hex. */
+int Trace_Decoder_Format(const trace_record_t *pRecord, char *pOut, size_t size);
+
+/*! @brief Collects the trace frames sent by the demo until none arrives for the client timeout. Frames of other
+ *         kinds and console text are skipped. A frame with a bad CRC ends the collection, compare the size with
+ *         the byte count the demo prints after the frames.
+ *  @return The trace size, -1 if it does not fit in size bytes. */
+int Trace_Decoder_Receive(pcf2131_client_t *pClient, uint8_t *pTrace, size_t size);
+
+#endif /* TRACE_DECODER_H_ */
@@ -0,0 +1,133 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file trace_replay.c
+ * @brief Replay of a register transaction trace into the driver, see trace_replay.h.
+ */
+
+#include <string.h>
+
+#include "mock_bus.h"
+#include "trace_replay.h"
+
+static trace_decoder_t s_decoder;
+static trace_replay_stats_t s_stats;
+
+static void trace_replay_diverge(uint32_t index)
+{
+	if (s_stats.divergences++ == 0)
+	{
+		s_stats.firstDivergence = index;
+	}
+}
+
+/* The mock bus device: the next record answers the transaction. */
+static int32_t trace_replay_device(void *ctx, bool write, uint8_t offset, uint8_t length, uint8_t *pData)
+{
+	trace_record_t record;
+
+	if (Trace_Decoder_Next(&s_decoder, &record) != 1)
+	{
+		trace_replay_diverge(s_stats.records);
+		return ARM_DRIVER_ERROR;
+	}
+	s_stats.replayed++;
+
+	if ((((record.flags & REGISTER_TRACE_WRITE) != 0) != write) || (record.offset != offset) ||
+			(record.length != length) || (write && record.pPayload && memcmp(record.pPayload, pData, length)))
+	{
+		trace_replay_diverge(record.index);
+		return ARM_DRIVER_ERROR;
+	}
+	if (record.pPayload == NULL)
+	{
+		s_stats.failures++;
+		return ARM_DRIVER_ERROR;
+	}
+	if (!write)
+	{
+		memcpy(pData, record.pPayload, length);
+	}
+
+	return ARM_DRIVER_OK;
+}
+
+int Trace_Replay_Start(const uint8_t *pTrace, size_t size)
+{
+	trace_record_t record;
+	int result;
+
+	/*! Count the records first, a bad one would only show in the middle of the replay */
+	memset(&s_stats, 0, sizeof(s_stats));
+	Trace_Decoder_Init(&s_decoder, pTrace, size);
+	while ((result = Trace_Decoder_Next(&s_decoder, &record)) == 1)
+	{
+		s_stats.records++;
+	}
+	if (result != 0)
+	{
+		return -1;
+	}
+
+	Trace_Decoder_Init(&s_decoder, pTrace, size);
+	Mock_Bus_SetDevice(trace_replay_device, NULL);
+	return 0;
+}
+
+void Trace_Replay_Stop(trace_replay_stats_t *pStats)
+{
+	Mock_Bus_SetDevice(NULL, NULL);
+	if (pStats != NULL)
+	{
+		*pStats = s_stats;
+	}
+}
+
+int Trace_Replay_Run(pcf2131_sensorhandle_t *pSensorHandle, const uint8_t *pTrace, size_t size, trace_replay_log_t log,
+					 void *ctx, trace_replay_stats_t *pStats)
+{
+	uint8_t buffer[PCF2131_BUF_HEADROOM + 255];
+	trace_decoder_t walk;
+	trace_record_t record;
+	uint32_t divergences;
+	int32_t status;
+
+	if (Trace_Replay_Start(pTrace, size) != 0)
+	{
+		return -1;
+	}
+
+	/*! The records are walked again next to the replay to drive one transaction each */
+	Trace_Decoder_Init(&walk, pTrace, size);
+	while (Trace_Decoder_Next(&walk, &record) == 1)
+	{
+		divergences = s_stats.divergences;
+		memset(buffer, 0, sizeof(buffer));
+		if (record.flags & REGISTER_TRACE_WRITE)
+		{
+			if (record.pPayload != NULL)
+			{
+				memcpy(&buffer[PCF2131_BUF_HEADROOM], record.pPayload, record.length);
+			}
+			status = PCF2131_WriteInPlace(pSensorHandle, record.offset, record.length, buffer);
+		}
+		else
+		{
+			status = PCF2131_ReadInPlace(pSensorHandle, record.offset, record.length, buffer);
+		}
+		if (log != NULL)
+		{
+			log(ctx, &record, status,
+				((SENSOR_ERROR_NONE == status) && !(record.flags & REGISTER_TRACE_WRITE)) ?
+					&buffer[PCF2131_BUF_HEADROOM] : NULL,
+				s_stats.divergences != divergences);
+		}
+	}
+
+	Trace_Replay_Stop(pStats);
+	return 0;
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file trace_replay.h
+ * @brief Replays a register transaction trace (interfaces/register_io_trace.h) into the unchanged driver on the
+ *        simulated bus (mock_bus.h), the trace standing in for the device. Every transaction the driver issues
+ *        takes the next record, which must have the same direction, first register and length, and for a write
+ *        the same values. A read is answered with the recorded values, a failed record fails the transaction
+ *        as the bus failed during the capture. Anything else is a divergence: the transaction fails and the
+ *        record is consumed, so the replay stays aligned with the trace.
+ */
+
+#ifndef TRACE_REPLAY_H_
+#define TRACE_REPLAY_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "pcf2131_drv.h"
+#include "trace_decoder.h"
+
+typedef struct
+{
+	uint32_t records;                                /* Records in the trace. */
+	uint32_t replayed;                               /* Records taken by driver transactions. */
+	uint32_t failures;                               /* Recorded bus failures reproduced. */
+	uint32_t divergences;                            /* Transactions unlike their record, or past the trace end. */
+	uint32_t firstDivergence;                        /* Index of the first one, valid with divergences != 0. */
+} trace_replay_stats_t;
+
+/*! @brief Called by Trace_Replay_Run() per record with the driver status and, for a successful read, the
+ *         values the driver returned (NULL otherwise). diverged is set when the transaction did not match. */
+typedef void (*trace_replay_log_t)(void *ctx, const trace_record_t *pRecord, int32_t status, const uint8_t *pValues,
+								   bool diverged);
+
+/*! @brief Makes the trace the device of the simulated bus until Trace_Replay_Stop(). The trace must stay valid.
+ *  @return 0, -1 if the trace has a bad record (nothing is started). */
+int Trace_Replay_Start(const uint8_t *pTrace, size_t size);
+
+/*! @brief Gives the bus back to the register map and reports the counters, pStats may be NULL. */
+void Trace_Replay_Stop(trace_replay_stats_t *pStats);
+
+/*! @brief Replays every record through the driver's raw register access, a read record with
+ *         PCF2131_ReadInPlace() and a write record with PCF2131_WriteInPlace(), so each record is exactly one
+ *         driver transaction whatever API issued it during the capture. pLog may be NULL.
+ *  @return 0, -1 if the trace has a bad record. */
+int Trace_Replay_Run(pcf2131_sensorhandle_t *pSensorHandle, const uint8_t *pTrace, size_t size, trace_replay_log_t log,
+					 void *ctx, trace_replay_stats_t *pStats);
+
+#endif /* TRACE_REPLAY_H_ */
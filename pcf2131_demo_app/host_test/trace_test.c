@@ -0,0 +1,384 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file trace_test.c
+ * @brief Host test of the bus trace tooling: a capture of driver API calls on the simulated register map with
+ *        the target trace code (interfaces/register_io_trace.c), sent as the demo sends it in trace frames among
+ *        console text and collected by trace_decoder.c from the loopback port. The decoded records must be the
+ *        transactions the register map saw, with a bus fault among them. Every truncation of the trace and
+ *        overlong varints must be reported, not read past. The same API calls replayed on an empty register
+ *        map with the trace as the device (trace_replay.c) must return the same results and consume every
+ *        record, a changed call sequence must diverge, and the record by record replay must match throughout.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "debug_console_async.h"
+#include "mock_bus.h"
+#include "loopback_serial.h"
+#include "trace_replay.h"
+
+#define CHECK(cond)                                                              \
+	do                                                                           \
+	{                                                                            \
+		if (!(cond))                                                             \
+		{                                                                        \
+			printf("trace_test: %s:%d: %s\n", __FILE__, __LINE__, #cond);        \
+			s_failures++;                                                        \
+		}                                                                        \
+	} while (0)
+
+/* The demo's capture buffer and frame chunk. */
+#define TRACE_TEST_BUFFER_SIZE (2048)
+#define TRACE_TEST_CHUNK_SIZE  (128)
+
+#define TRACE_TEST_MAX_TXNS (64)
+#define TRACE_TEST_BLOCK    (4)
+
+/* One register transaction as the register map saw it. */
+typedef struct
+{
+	bool write;
+	uint8_t offset;
+	uint8_t length;
+	uint8_t data[PCF2131_REG_MAP_SIZE];
+} trace_test_txn_t;
+
+/* The results of the API sequence, compared between the capture and the replay. */
+typedef struct
+{
+	int32_t status[9];
+	pcf2131_timedata_t time;
+	pcf2131_timedata_t faulted;
+	pcf2131_alarmdata_t alarm;
+	pcf2131_timestamp_t ts;
+	uint8_t map[PCF2131_BUF_HEADROOM + PCF2131_REG_MAP_SIZE];
+} trace_test_result_t;
+
+static const registerreadlist_t s_timeList[] = {{.readFrom = PCF2131_100TH_SECOND, .numBytes = PCF2131_TIME_SIZE_BYTE},
+		__END_READ_DATA__};
+static const registerreadlist_t s_alarmList[] = {
+		{.readFrom = PCF2131_SECOND_ALARM, .numBytes = PCF2131_ALARM_TIME_SIZE_BYTE}, __END_READ_DATA__};
+static const registerreadlist_t s_tsList[] = {
+		{.readFrom = PCF2131_TIMESTAMP2_SECONDS, .numBytes = PCF2131_TS_SIZE_BYTE}, __END_READ_DATA__};
+
+static pcf2131_sensorhandle_t s_rtc;
+static trace_test_txn_t s_txns[TRACE_TEST_MAX_TXNS];
+static uint32_t s_nTxns;
+static uint32_t s_faultAt;                           /* Transactions before the faulted one. */
+static uint32_t s_failures;
+
+static void init_rtc(void)
+{
+#if (I2C_ENABLE)
+	CHECK(PCF2131_Initialize(&s_rtc, &Mock_I2C_Driver, 0, 0x53) == SENSOR_ERROR_NONE);
+#else
+	static uint32_t slaveSelect;
+	CHECK(PCF2131_Initialize(&s_rtc, &Mock_SPI_Driver, 0, &slaveSelect) == SENSOR_ERROR_NONE);
+#endif
+}
+
+/* The register map as a device, every transaction logged. */
+static int32_t logging_device(void *ctx, bool write, uint8_t offset, uint8_t length, uint8_t *pData)
+{
+	trace_test_txn_t *pTxn = &s_txns[s_nTxns++ % TRACE_TEST_MAX_TXNS];
+	uint32_t i;
+
+	for (i = 0; i < length; i++)
+	{
+		if (write)
+		{
+			g_Mock_Regs[(uint8_t)(offset + i)] = pData[i];
+		}
+		else
+		{
+			pData[i] = g_Mock_Regs[(uint8_t)(offset + i)];
+		}
+	}
+	pTxn->write = write;
+	pTxn->offset = offset;
+	pTxn->length = length;
+	memcpy(pTxn->data, pData, length);
+	return ARM_DRIVER_OK;
+}
+
+/* The API calls of the capture, from the given step. With fault the bus fails the first transfer of the second
+ * GetTime, during the replay the trace brings the failure. */
+static void run_apis(trace_test_result_t *pResult, uint32_t step, bool fault)
+{
+	pcf2131_timedata_t time = {.second_100th = 25, .second = 5, .minutes = 4, .hours = 13, .days = 29, .weekdays = 4,
+			.months = 2, .years = 24, .ampm = h24};
+	pcf2131_alarmdata_t alarm = {.second = 30, .minutes = 15, .hours = 7, .days = 1, .weekdays = 2, .ampm = AM};
+	uint8_t block[PCF2131_BUF_HEADROOM + TRACE_TEST_BLOCK] = {0, 0x2E, 0x0C, 0x3F, 0x0F};
+
+	memset(pResult, 0, sizeof(*pResult));
+	if (step == 0)
+	{
+		pResult->status[0] = PCF2131_SetTime(&s_rtc, &time);
+	}
+	pResult->status[1] = PCF2131_12h_24h_Mode_Set(&s_rtc, mode12H);
+	pResult->status[2] = PCF2131_GetTime(&s_rtc, s_timeList, &pResult->time);
+	pResult->status[3] = PCF2131_SetAlarmTime(&s_rtc, &alarm);
+	pResult->status[4] = PCF2131_GetAlarmTime(&s_rtc, s_alarmList, &pResult->alarm);
+	pResult->status[5] = PCF2131_GetTs(&s_rtc, s_tsList, sw2Ts, &pResult->ts);
+	s_faultAt = s_nTxns;
+	if (fault)
+	{
+		Mock_Bus_Fail(0, 1, ARM_DRIVER_ERROR);
+	}
+	pResult->status[6] = PCF2131_GetTime(&s_rtc, s_timeList, &pResult->faulted);
+	pResult->status[7] = PCF2131_WriteInPlace(&s_rtc, PCF2131_INT_A_MASK1, TRACE_TEST_BLOCK, block);
+	pResult->status[8] = PCF2131_ReadInPlace(&s_rtc, 0, PCF2131_REG_MAP_SIZE, pResult->map);
+}
+
+/* The decoded records are the logged transactions with the failed read of the faulted GetTime at s_faultAt,
+ * in time order within the capture. */
+static void check_records(const uint8_t *pTrace, uint32_t size, uint64_t elapsed_us)
+{
+	trace_decoder_t decoder;
+	trace_record_t record;
+	const trace_test_txn_t *pTxn;
+	uint32_t n = 0;
+
+	Trace_Decoder_Init(&decoder, pTrace, size);
+	while (Trace_Decoder_Next(&decoder, &record) == 1)
+	{
+		CHECK((record.index == n) && ((record.flags >> 3) == 0));
+		CHECK(((record.flags & REGISTER_TRACE_I2C) != 0) == (I2C_ENABLE != 0));
+		if (n == s_faultAt)
+		{
+			CHECK((record.flags & REGISTER_TRACE_FAILED) && (record.pPayload == NULL));
+			CHECK(!(record.flags & REGISTER_TRACE_WRITE) && (record.offset == s_timeList[0].readFrom) &&
+					(record.length == s_timeList[0].numBytes));
+		}
+		else
+		{
+			pTxn = &s_txns[(n < s_faultAt) ? n : n - 1];
+			CHECK(!(record.flags & REGISTER_TRACE_FAILED) && (record.pPayload != NULL));
+			CHECK((((record.flags & REGISTER_TRACE_WRITE) != 0) == pTxn->write) && (record.offset == pTxn->offset) &&
+					(record.length == pTxn->length));
+			CHECK((record.pPayload != NULL) && !memcmp(record.pPayload, pTxn->data, record.length));
+		}
+		CHECK(record.start_us + record.duration_us <= elapsed_us + 1);
+		n++;
+	}
+	CHECK((n == s_nTxns + 1) && (decoder.pos == size));
+}
+
+/* Captures the API sequence on a register map with a valid date and a timestamp, returns the trace size. */
+static uint32_t capture(uint8_t *pTrace, trace_test_result_t *pResult)
+{
+	registerTraceStats_t stats;
+	struct timespec start, end;
+	uint64_t elapsed_us;
+	uint8_t i;
+
+	Mock_Bus_Reset();
+	g_Mock_Regs[PCF2131_DAY] = 0x01;
+	g_Mock_Regs[PCF2131_MONTH] = 0x01;
+	for (i = 0; i < PCF2131_TS_SIZE_BYTE; i++)
+	{
+		g_Mock_Regs[PCF2131_TIMESTAMP2_SECONDS + i] = (uint8_t)(0x11 + i);
+	}
+	init_rtc();
+	Mock_Bus_SetDevice(logging_device, NULL);
+	s_nTxns = 0;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	Register_Trace_Start(pTrace, TRACE_TEST_BUFFER_SIZE);
+	run_apis(pResult, 0, true);
+	Register_Trace_Stop(&stats);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	Mock_Bus_SetDevice(NULL, NULL);
+	elapsed_us = (uint64_t)(end.tv_sec - start.tv_sec) * 1000000U + (uint64_t)(end.tv_nsec - start.tv_nsec) / 1000U;
+
+	/*! Every API succeeded but the faulted one, the trace holds every transaction and the failed one */
+	for (i = 0; i < 9; i++)
+	{
+		CHECK((pResult->status[i] == SENSOR_ERROR_NONE) == (i != 6));
+	}
+	CHECK(s_nTxns <= TRACE_TEST_MAX_TXNS);
+	CHECK((stats.dropped == 0) && (stats.records == s_nTxns + 1));
+	check_records(pTrace, stats.length, elapsed_us);
+
+	printf("trace_test: %u API calls, %u records, %u trace bytes\n", 9, stats.records, stats.length);
+	return stats.length;
+}
+
+/* Console text of the device side. */
+static void console(const char *pText)
+{
+	while (*pText != '\0')
+	{
+		PUTCHAR(*pText++);
+	}
+}
+
+/* The trace sent as the demo sends it, with console text and a telemetry frame in between, and collected back. */
+static void test_transport(const uint8_t *pTrace, uint32_t size)
+{
+	static const char text[] = "\r\n Sent trace bytes\r\n";
+	static const uint8_t tlm[] = {0x01, 0x02, 0x03};
+	uint8_t received[TRACE_TEST_BUFFER_SIZE + 1];
+	pcf2131_client_t client;
+	uint32_t sent, chunk;
+
+	Loopback_Reset();
+	PCF2131_Client_Init(&client, Loopback_Write, Loopback_Read, NULL);
+	client.timeout_ms = 50;
+	console(text);
+	for (sent = 0; sent < size; sent += chunk)
+	{
+		chunk = (size - sent > TRACE_TEST_CHUNK_SIZE) ? TRACE_TEST_CHUNK_SIZE : size - sent;
+		PCF2131_Proto_SendFrame(PCF2131_PROTO_SOF_TRACE, &pTrace[sent], (uint8_t)chunk);
+		PCF2131_Proto_SendFrame(PCF2131_PROTO_SOF_TLM, tlm, sizeof(tlm));
+	}
+	console(text);
+
+	CHECK(Trace_Decoder_Receive(&client, received, sizeof(received)) == (int)size);
+	CHECK(!memcmp(received, pTrace, size));
+
+	/*! A trace larger than the buffer is reported */
+	Loopback_Reset();
+	PCF2131_Proto_SendFrame(PCF2131_PROTO_SOF_TRACE, pTrace, TRACE_TEST_CHUNK_SIZE);
+	CHECK(Trace_Decoder_Receive(&client, received, TRACE_TEST_CHUNK_SIZE - 1) == -1);
+}
+
+/* Decodes a copy of exactly size bytes. Returns the records, -1 - records on a bad record. */
+static int decode_copy(const uint8_t *pTrace, size_t size, trace_record_t *pLast)
+{
+	uint8_t *pCopy = malloc(size ? size : 1);
+	trace_decoder_t decoder;
+	trace_record_t record;
+	int result;
+
+	memcpy(pCopy, pTrace, size);
+	Trace_Decoder_Init(&decoder, pCopy, size);
+	while ((result = Trace_Decoder_Next(&decoder, &record)) == 1)
+	{
+		if (pLast != NULL)
+		{
+			*pLast = record;
+			pLast->pPayload = NULL;
+		}
+	}
+	free(pCopy);
+
+	return (result == 0) ? (int)decoder.records : -1 - (int)decoder.records;
+}
+
+static void test_malformed(const uint8_t *pTrace, uint32_t size)
+{
+	/* flags, offset, length 1, gap, duration, one payload byte. */
+	static const uint8_t longVarint[] = {0x00, 0x10, 0x01, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00, 0xAA};
+	static const uint8_t wideVarint[] = {0x00, 0x10, 0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0x1F, 0x00, 0xAA};
+	static const uint8_t maxVarint[] = {0x00, 0x10, 0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F, 0x00, 0xAA};
+	trace_decoder_t decoder;
+	trace_record_t record;
+	size_t boundary[TRACE_TEST_MAX_TXNS + 2];
+	uint32_t nBoundaries = 0, length, b = 0;
+	int result;
+
+	/*! Every prefix of the trace: complete records up to a boundary, a bad record in between */
+	Trace_Decoder_Init(&decoder, pTrace, size);
+	boundary[nBoundaries++] = 0;
+	while ((Trace_Decoder_Next(&decoder, &record) == 1) && (nBoundaries < TRACE_TEST_MAX_TXNS + 2))
+	{
+		boundary[nBoundaries++] = decoder.pos;
+	}
+	for (length = 0; length <= size; length++)
+	{
+		while ((b + 1 < nBoundaries) && (boundary[b + 1] <= length))
+		{
+			b++;
+		}
+		result = decode_copy(pTrace, length, NULL);
+		CHECK(result == ((boundary[b] == length) ? (int)b : -1 - (int)b));
+	}
+
+	CHECK(decode_copy(longVarint, sizeof(longVarint), NULL) == -1);
+	CHECK(decode_copy(wideVarint, sizeof(wideVarint), NULL) == -1);
+	CHECK((decode_copy(maxVarint, sizeof(maxVarint), &record) == 1) && (record.gap_us == UINT32_MAX));
+	CHECK(Trace_Replay_Start(pTrace, size - 1) == -1);
+}
+
+static void test_replay(const uint8_t *pTrace, uint32_t size, const trace_test_result_t *pCaptured)
+{
+	trace_test_result_t replayed;
+	trace_replay_stats_t stats;
+	uint32_t i;
+
+	/*! The same calls on an empty register map, the trace answers them and brings the bus fault */
+	Mock_Bus_Reset();
+	init_rtc();
+	CHECK(Trace_Replay_Start(pTrace, size) == 0);
+	run_apis(&replayed, 0, false);
+	Trace_Replay_Stop(&stats);
+	CHECK(!memcmp(&replayed, pCaptured, sizeof(replayed)));
+	CHECK((stats.replayed == stats.records) && (stats.records == s_nTxns + 1));
+	CHECK((stats.failures == 1) && (stats.divergences == 0));
+	for (i = 0; i < PCF2131_REG_MAP_SIZE; i++)
+	{
+		CHECK(g_Mock_Regs[i] == 0);
+	}
+	printf("trace_test: replay: %u records, %u replayed, %u failure, %u divergences\n", stats.records,
+		   stats.replayed, stats.failures, stats.divergences);
+
+	/*! Without the SetTime the first transaction is not the recorded one */
+	init_rtc();
+	CHECK(Trace_Replay_Start(pTrace, size) == 0);
+	run_apis(&replayed, 1, false);
+	Trace_Replay_Stop(&stats);
+	CHECK((stats.divergences > 0) && (stats.firstDivergence == 0));
+	CHECK(memcmp(&replayed, pCaptured, sizeof(replayed)));
+}
+
+static uint32_t s_logged, s_logDiverged;
+
+static void replay_log(void *ctx, const trace_record_t *pRecord, int32_t status, const uint8_t *pValues,
+					   bool diverged)
+{
+	s_logged++;
+	s_logDiverged += diverged;
+	CHECK((SENSOR_ERROR_NONE == status) == (pRecord->pPayload != NULL));
+	if (!(pRecord->flags & REGISTER_TRACE_WRITE) && (pRecord->pPayload != NULL))
+	{
+		CHECK((pValues != NULL) && !memcmp(pValues, pRecord->pPayload, pRecord->length));
+	}
+}
+
+static void test_replay_run(const uint8_t *pTrace, uint32_t size)
+{
+	trace_replay_stats_t stats;
+
+	/*! Each record as one raw access, whatever API issued it */
+	Mock_Bus_Reset();
+	init_rtc();
+	CHECK(Trace_Replay_Run(&s_rtc, pTrace, size, replay_log, NULL, &stats) == 0);
+	CHECK((s_logged == stats.records) && (s_logDiverged == 0));
+	CHECK((stats.replayed == stats.records) && (stats.failures == 1) && (stats.divergences == 0));
+	CHECK(Trace_Replay_Run(&s_rtc, pTrace, size - 1, NULL, NULL, &stats) == -1);
+}
+
+int main(void)
+{
+	static uint8_t trace[TRACE_TEST_BUFFER_SIZE];
+	trace_test_result_t captured;
+	uint32_t size;
+
+	size = capture(trace, &captured);
+	test_transport(trace, size);
+	test_malformed(trace, size);
+	test_replay(trace, size, &captured);
+	test_replay_run(trace, size);
+
+	printf("trace_test: %s\n", s_failures ? "FAIL" : "PASS");
+	return s_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}